@@ -32,10 +32,20 @@ layout(set = 0, binding = 0, std140) uniform UniformCamera
     QECameraData cameraData;
 };
 
+#ifdef QE_BINDLESS_MATERIALS
+// Registro del draw en QE_MaterialTable (set 4); el set 0 lo comparten todos los materiales
+layout(std430, push_constant) uniform PushConstants
+{
+    layout(offset = 64) uint QE_MaterialIndex;
+} constants;
+
+#define uboMaterial QE_Materials[constants.QE_MaterialIndex]
+#else
 layout(set = 0, binding = 1, std140) uniform UniformMaterial
 {
     QEPBRMaterialData uboMaterial;
 };
+#endif
 
 layout(set = 0, binding = 2) uniform UniformManagerLight
 {
@@ -62,7 +72,9 @@ layout(set = 0, binding = 6) readonly buffer Tiles
     uint tiles[];
 };
 
+#ifndef QE_BINDLESS_MATERIALS
 layout(set = 0, binding = 7) uniform sampler2D texSampler[QE_NUM_TEX];
+#endif
 
 layout(set = 0, binding = 8) uniform ScreenData 
 {
@@ -70,7 +82,13 @@ layout(set = 0, binding = 8) uniform ScreenData
     uvec2 tileCount;
 } screenData;
 
-layout(set = 1, binding = 0) uniform samplerCube QE_PointShadowCubemaps[10];
+// Atlas de point lights: una capa por cara del cubo, un tile por luz
+layout(set = 1, binding = 0) uniform sampler2DArray QE_PointShadowAtlas;
+
+layout(set = 1, binding = 1) readonly buffer pointAtlasRects
+{
+    vec4 QE_PointShadowAtlasRect[];
+};
 
 layout(set = 2, binding = 0) uniform sampler2DArray QE_DirectionalShadowmaps[10];
 
@@ -84,18 +102,27 @@ layout (set = 2, binding = 2) readonly buffer cascadeViewProjs
     mat4 QE_CascadeViewProj[];
 };
 
-layout(set = 3, binding = 0) uniform sampler2D QE_SpotShadowmaps[10];
+layout(set = 3, binding = 0) uniform sampler2D QE_SpotShadowAtlas;
+
+struct QESpotShadowData
+{
+    mat4 viewProj;
+    vec4 atlasRect;
+};
 
-layout (set = 3, binding = 1) readonly buffer spotViewProjs
+layout (set = 3, binding = 1) readonly buffer spotShadowData
 {
-    mat4 QE_SpotViewProj[];
+    QESpotShadowData QE_SpotShadow[];
 };
 
 void main()
 {
-    vec4 base = QE_GetBaseColorAlpha(uboMaterial, texSampler, fs_in.TexCoords);
+    vec4 base = QE_GetBaseColorAlpha(uboMaterial, QE_MATERIAL_TEXTURES, fs_in.TexCoords);
+#if !defined(QE_MATERIAL_VARIANT) || defined(QE_ALPHA_MASK)
+    // Sin discard en las variantes opacas: el driver mantiene el early depth test
     if (QE_ShouldDiscardAlpha(uboMaterial, base))
         discard;
+#endif
         
     vec4 pos_camera_space = cameraData.view * vec4(fs_in.FragPos, 1.0);
     float z_far = cameraData.cameraParams[1];
@@ -122,7 +149,7 @@ void main()
     float shininess = uboMaterial.Shininess;
 
     vec3 N_coat = normalize(fs_in.Normal);
-    vec3 N_base = QE_GetNormal(uboMaterial, texSampler, fs_in.TexCoords, fs_in.Normal, fs_in.TBN);
+    vec3 N_base = QE_GetNormal(uboMaterial, QE_MATERIAL_TEXTURES, fs_in.TexCoords, fs_in.Normal, fs_in.TBN);
 
     float clearcoat = saturate(uboMaterial.Clearcoat);
     float coatRough = clamp(uboMaterial.ClearcoatRoughness, 0.03, 1.0);
@@ -130,11 +157,11 @@ void main()
     vec3 albedoColor = base.rgb;
     float alpha = QE_GetEffectiveAlpha(uboMaterial, base);
 
-    vec3 emissiveColor = QE_GetEmissiveColor(uboMaterial, texSampler, fs_in.TexCoords);
+    vec3 emissiveColor = QE_GetEmissiveColor(uboMaterial, QE_MATERIAL_TEXTURES, fs_in.TexCoords);
 
-    float roughness = QE_GetRoughness(uboMaterial, texSampler, fs_in.TexCoords);
-    float metallic = QE_GetMetallic(uboMaterial, texSampler, fs_in.TexCoords);
-    float ao = QE_GetAO(uboMaterial, texSampler, fs_in.TexCoords);
+    float roughness = QE_GetRoughness(uboMaterial, QE_MATERIAL_TEXTURES, fs_in.TexCoords);
+    float metallic = QE_GetMetallic(uboMaterial, QE_MATERIAL_TEXTURES, fs_in.TexCoords);
+    float ao = QE_GetAO(uboMaterial, QE_MATERIAL_TEXTURES, fs_in.TexCoords);
     vec3 result = QE_ComputeAmbientPBR(uboMaterial, albedoColor, metallic, ao);
 
     vec3 resultPoint = vec3(0.0);
@@ -158,7 +185,8 @@ void main()
                         lights[gli], fragPos, N_base, N_coat, V,
                         albedoColor, metallic, roughness,
                         clearcoat, coatRough,
-                        QE_PointShadowCubemaps[nonuniformEXT(lights[gli].idxShadowMap)]
+                        QE_PointShadowAtlas,
+                        QE_PointShadowAtlasRect[lights[gli].idxShadowMap]
                     );
                 }
                 else if (lights[gli].lightType == DIRECTIONAL_LIGHT || lights[gli].lightType == SUN_LIGHT)
@@ -183,7 +211,7 @@ void main()
                         lights[gli], fragPos, N_base, N_coat, V,
                         albedoColor, metallic, roughness,
                         clearcoat, coatRough,
-                        uboMaterial.AlphaMode,
+                        QE_MATERIAL_ALPHA_MODE(uboMaterial),
                         QE_DirectionalShadowmaps[nonuniformEXT(si)],
                         splits, viewDepth,
                         vp0, vp1, c0, c1
@@ -197,9 +225,10 @@ void main()
                         lights[gli], fragPos, N_base, N_coat, V,
                         albedoColor, metallic, roughness,
                         clearcoat, coatRough,
-                        uboMaterial.AlphaMode,
-                        QE_SpotShadowmaps[nonuniformEXT(si)],
-                        QE_SpotViewProj[si]
+                        QE_MATERIAL_ALPHA_MODE(uboMaterial),
+                        QE_SpotShadowAtlas,
+                        QE_SpotShadow[si].viewProj,
+                        QE_SpotShadow[si].atlasRect
                     );
                 }
             }
@@ -15,7 +15,8 @@ vec3 ComputePointLightPBR(
     float roughness,
     float clearcoat,
     float clearcoatRoughness,
-    samplerCube shadowCube
+    sampler2DArray shadowAtlas,
+    vec4 atlasRect
 ){
     vec3 lightVec = light.position - fragPosWorld;
     float dist = length(lightVec);
@@ -24,7 +25,7 @@ vec3 ComputePointLightPBR(
     float attenuation = 1.0 / (light.constant + light.linear * dist + light.quadratic * (dist * dist));
     vec3 radiance = light.diffuse;
 
-    float visibility = GetCMVisibility(shadowCube, -lightVec, dist);
+    float visibility = GetCMVisibility(shadowAtlas, atlasRect, -lightVec, dist, light.radius);
 
     vec3 brdfBase = BRDF_CookTorrance(N_base, V, L, baseColor, metallic, roughness);
     vec3 brdfCoat = BRDF_Clearcoat(N_coat, V, L, clearcoat, clearcoatRoughness);
@@ -86,8 +87,9 @@ vec3 ComputeSpotLightPBR(
     float clearcoat,
     float clearcoatRoughness,
     uint materialAlphaMode,
-    sampler2D shadowMap,
-    mat4 viewProj
+    sampler2D shadowAtlas,
+    mat4 viewProj,
+    vec4 atlasRect
 ){
     vec3 lightVec = light.position - fragPosWorld;
     float dist = length(lightVec);
@@ -100,7 +102,7 @@ vec3 ComputeSpotLightPBR(
     float intensity = clamp((theta - light.outerCutoff) / eps, 0.0, 1.0);
 
     vec3 radiance = light.diffuse;
-    float visibility = GetSpotVisibility(shadowMap, fragPosWorld, viewProj, materialAlphaMode);
+    float visibility = GetSpotVisibility(shadowAtlas, atlasRect, fragPosWorld, viewProj, materialAlphaMode);
 
     vec3 brdfBase = BRDF_CookTorrance(N_base, V, L, baseColor, metallic, roughness);
     vec3 brdfCoat = BRDF_Clearcoat(N_coat, V, L, clearcoat, clearcoatRoughness);
@@ -50,9 +50,78 @@ struct QEPBRMaterialData
     float AlphaCutoff;  // tÃ­pico 0.5
 };
 
+// Ruta bindless (QEBindlessMaterials): tabla de materiales indexada por el id del push constant y
+// un unico array de texturas; los idx* del registro ya son indices globales del array.
+#ifdef QE_BINDLESS_MATERIALS
+#ifndef QE_BINDLESS_SET
+#define QE_BINDLESS_SET 4
+#endif
+
+layout(std430, set = QE_BINDLESS_SET, binding = 0) readonly buffer QE_MaterialTable
+{
+    QEPBRMaterialData QE_Materials[];
+};
+
+layout(set = QE_BINDLESS_SET, binding = 1) uniform sampler2D QE_BindlessTextures[];
+
+#define QE_MATERIAL_TEXTURES_PARAM int QE_UnusedTextures
+#define QE_MATERIAL_TEXTURES 0
+#define QE_TEXTURE(textures, idx) QE_BindlessTextures[nonuniformEXT(idx)]
+#else
+#define QE_MATERIAL_TEXTURES_PARAM sampler2D texSampler[QE_NUM_TEX]
+#define QE_MATERIAL_TEXTURES texSampler
+#define QE_TEXTURE(textures, idx) textures[nonuniformEXT(idx)]
+#endif
+
+// Variantes por material (QEShaderVariantCache): las keywords fijan que slots pueden tener textura
+// y el modo alfa, y las ramas del resto desaparecen al compilar. texMask sigue filtrando las
+// texturas que aun no son residentes.
+#ifdef QE_MATERIAL_VARIANT
+#ifdef QE_TEX_BASECOLOR
+#define QE_VARIANT_BIT_BASECOLOR (1u << QE_SLOT_BASECOLOR)
+#else
+#define QE_VARIANT_BIT_BASECOLOR 0u
+#endif
+#ifdef QE_TEX_NORMAL
+#define QE_VARIANT_BIT_NORMAL (1u << QE_SLOT_NORMAL)
+#else
+#define QE_VARIANT_BIT_NORMAL 0u
+#endif
+#ifdef QE_TEX_METALLIC
+#define QE_VARIANT_BIT_METALLIC (1u << QE_SLOT_METALLIC)
+#else
+#define QE_VARIANT_BIT_METALLIC 0u
+#endif
+#ifdef QE_TEX_ROUGHNESS
+#define QE_VARIANT_BIT_ROUGHNESS (1u << QE_SLOT_ROUGHNESS)
+#else
+#define QE_VARIANT_BIT_ROUGHNESS 0u
+#endif
+#ifdef QE_TEX_AO
+#define QE_VARIANT_BIT_AO (1u << QE_SLOT_AO)
+#else
+#define QE_VARIANT_BIT_AO 0u
+#endif
+#ifdef QE_TEX_EMISSIVE
+#define QE_VARIANT_BIT_EMISSIVE (1u << QE_SLOT_EMISSIVE)
+#else
+#define QE_VARIANT_BIT_EMISSIVE 0u
+#endif
+#define QE_VARIANT_TEXMASK (QE_VARIANT_BIT_BASECOLOR | QE_VARIANT_BIT_NORMAL | QE_VARIANT_BIT_METALLIC | \
+                            QE_VARIANT_BIT_ROUGHNESS | QE_VARIANT_BIT_AO | QE_VARIANT_BIT_EMISSIVE)
+#ifdef QE_ALPHA_MASK
+#define QE_MATERIAL_ALPHA_MODE(mat) 1u
+#else
+#define QE_MATERIAL_ALPHA_MODE(mat) 0u
+#endif
+#else
+#define QE_VARIANT_TEXMASK 0xFFFFFFFFu
+#define QE_MATERIAL_ALPHA_MODE(mat) ((mat).AlphaMode)
+#endif
+
 bool QE_HasTex(uint mask, uint slot)
 {
-    return (mask & (1u << slot)) != 0u;
+    return (mask & QE_VARIANT_TEXMASK & (1u << slot)) != 0u;
 }
 
 float QE_ReadChan(vec4 t, uint ch)
@@ -70,74 +139,74 @@ float QE_GetEffectiveAlpha(QEPBRMaterialData mat, vec4 baseColor)
 }
 
 // --- Sampling helpers ---
-vec3 QE_GetBaseColor(QEPBRMaterialData mat, sampler2D texSampler[QE_NUM_TEX], vec2 uv)
+vec3 QE_GetBaseColor(QEPBRMaterialData mat, QE_MATERIAL_TEXTURES_PARAM, vec2 uv)
 {
     vec3 c = mat.Diffuse.rgb;
     if (QE_HasTex(mat.texMask, QE_SLOT_BASECOLOR))
-        c = texture(texSampler[nonuniformEXT(mat.idxDiffuse)], uv).rgb;
+        c = texture(QE_TEXTURE(texSampler, mat.idxDiffuse), uv).rgb;
 
     return c;
 }
 
-vec4 QE_GetBaseColorAlpha(QEPBRMaterialData mat, sampler2D texSampler[QE_NUM_TEX], vec2 uv)
+vec4 QE_GetBaseColorAlpha(QEPBRMaterialData mat, QE_MATERIAL_TEXTURES_PARAM, vec2 uv)
 {
     vec4 c = mat.Diffuse;
 
     if (QE_HasTex(mat.texMask, QE_SLOT_BASECOLOR))
-        c = texture(texSampler[nonuniformEXT(mat.idxDiffuse)], uv);
+        c = texture(QE_TEXTURE(texSampler, mat.idxDiffuse), uv);
 
     return c;
 }
 
-float QE_GetMetallic(QEPBRMaterialData mat, sampler2D texSampler[QE_NUM_TEX], vec2 uv)
+float QE_GetMetallic(QEPBRMaterialData mat, QE_MATERIAL_TEXTURES_PARAM, vec2 uv)
 {
     float m = mat.Metallic;
     if (QE_HasTex(mat.texMask, QE_SLOT_METALLIC))
     {
-        vec4 t = texture(texSampler[nonuniformEXT(mat.idxMetallic)], uv);
+        vec4 t = texture(QE_TEXTURE(texSampler, mat.idxMetallic), uv);
         m = QE_ReadChan(t, mat.metallicChan);
     }
     return QE_Saturate(m);
 }
 
-float QE_GetRoughness(QEPBRMaterialData mat, sampler2D texSampler[QE_NUM_TEX], vec2 uv)
+float QE_GetRoughness(QEPBRMaterialData mat, QE_MATERIAL_TEXTURES_PARAM, vec2 uv)
 {
     float r = mat.Roughness;
     if (QE_HasTex(mat.texMask, QE_SLOT_ROUGHNESS))
     {
-        vec4 t = texture(texSampler[nonuniformEXT(mat.idxRoughness)], uv);
+        vec4 t = texture(QE_TEXTURE(texSampler, mat.idxRoughness), uv);
         r = QE_ReadChan(t, mat.roughnessChan);
     }
     // mÃ­nimo para estabilidad GGX
     return clamp(r, 0.045, 1.0);
 }
 
-float QE_GetAO(QEPBRMaterialData mat, sampler2D texSampler[QE_NUM_TEX], vec2 uv)
+float QE_GetAO(QEPBRMaterialData mat, QE_MATERIAL_TEXTURES_PARAM, vec2 uv)
 {
     float ao = mat.AO;
     if (QE_HasTex(mat.texMask, QE_SLOT_AO))
     {
-        vec4 t = texture(texSampler[nonuniformEXT(mat.idxAO)], uv);
+        vec4 t = texture(QE_TEXTURE(texSampler, mat.idxAO), uv);
         ao = QE_ReadChan(t, mat.aoChan);
     }
     return QE_Saturate(ao);
 }
 
-vec3 QE_GetEmissiveColor(QEPBRMaterialData mat, sampler2D texSampler[QE_NUM_TEX], vec2 uv)
+vec3 QE_GetEmissiveColor(QEPBRMaterialData mat, QE_MATERIAL_TEXTURES_PARAM, vec2 uv)
 {
     vec3 e = mat.Emissive.rgb;
     if (QE_HasTex(mat.texMask, QE_SLOT_EMISSIVE))
-        e = texture(texSampler[nonuniformEXT(mat.idxEmissive)], uv).rgb;
+        e = texture(QE_TEXTURE(texSampler, mat.idxEmissive), uv).rgb;
     return e;
 }
 
-vec3 QE_GetNormal(QEPBRMaterialData mat, sampler2D texSampler[QE_NUM_TEX], vec2 uv, vec3 normalWS, mat3 TBN)
+vec3 QE_GetNormal(QEPBRMaterialData mat, QE_MATERIAL_TEXTURES_PARAM, vec2 uv, vec3 normalWS, mat3 TBN)
 {
     vec3 N = normalize(normalWS);
 
     if (QE_HasTex(mat.texMask, QE_SLOT_NORMAL))
     {
-        vec3 nTS = texture(texSampler[nonuniformEXT(mat.idxNormal)], uv).xyz;
+        vec3 nTS = texture(QE_TEXTURE(texSampler, mat.idxNormal), uv).xyz;
         nTS = nTS * 2.0 - 1.0;
         nTS.xy *= mat.BumpScaling;
         nTS = normalize(nTS);
@@ -166,7 +235,7 @@ float QE_GetClearcoatRoughness(QEPBRMaterialData mat, vec2 uv)
 
 bool QE_ShouldDiscardAlpha(QEPBRMaterialData mat, vec4 baseColor)
 {
-    return (mat.AlphaMode == 1u) && (QE_GetEffectiveAlpha(mat, baseColor) < mat.AlphaCutoff);
+    return (QE_MATERIAL_ALPHA_MODE(mat) == 1u) && (QE_GetEffectiveAlpha(mat, baseColor) < mat.AlphaCutoff);
 }
 
 #endif // QE_PBR_MATERIAL_GLSL
@@ -28,7 +28,8 @@ vec3 ComputePointLight(
     vec3 specColor,
     vec3 emissive,
     float shininess,
-    samplerCube shadowCube
+    sampler2DArray shadowAtlas,
+    vec4 atlasRect
 ){
     vec3 lightVec = light.position - fragPosWorld;
     float dist = length(lightVec);
@@ -37,7 +38,7 @@ vec3 ComputePointLight(
     float attenuation = 1.0 / (light.constant + light.linear * dist + light.quadratic * (dist * dist));
 
     vec3 direct = ComputeBlinnPhong(L, N, V, light.diffuse, light.specular, albedo, specColor, shininess) * attenuation;
-    float visibility = GetCMVisibility(shadowCube, -lightVec, dist);
+    float visibility = GetCMVisibility(shadowAtlas, atlasRect, -lightVec, dist, light.radius);
 
     return direct * visibility + emissive;
 }
@@ -126,18 +126,61 @@ float GetCSMVisibility(
     return mix(sh0, sh1, t);
 }
 
-float GetCMVisibility(samplerCube cubeMap, vec3 lightVec, float currentDepth)
+// Seleccion de cara y coordenadas (s, t) segun la tabla de cubemaps de Vulkan.
+// Devuelve (s, t, cara) con s, t en [0, 1]; la cara coincide con la capa del atlas de point lights.
+vec3 QE_CubeDirToFaceUV(vec3 dir)
 {
+    vec3 a = abs(dir);
+    float ma;
+    vec2 sc;
+    float face;
+
+    if (a.x >= a.y && a.x >= a.z)
+    {
+        ma = a.x;
+        face = (dir.x > 0.0) ? 0.0 : 1.0;
+        sc = (dir.x > 0.0) ? vec2(-dir.z, -dir.y) : vec2(dir.z, -dir.y);
+    }
+    else if (a.y >= a.z)
+    {
+        ma = a.y;
+        face = (dir.y > 0.0) ? 2.0 : 3.0;
+        sc = (dir.y > 0.0) ? vec2(dir.x, dir.z) : vec2(dir.x, -dir.z);
+    }
+    else
+    {
+        ma = a.z;
+        face = (dir.z > 0.0) ? 4.0 : 5.0;
+        sc = (dir.z > 0.0) ? vec2(dir.x, -dir.y) : vec2(-dir.x, -dir.y);
+    }
+
+    return vec3(0.5 * (sc / max(ma, 1e-6) + 1.0), face);
+}
+
+// atlasRect = (offset.xy, scale.zw) del tile de la luz en UV del atlas; scale 0 => sin sombra.
+// El atlas guarda distancia lineal normalizada por el radio de la luz.
+float GetCMVisibility(sampler2DArray shadowAtlas, vec4 atlasRect, vec3 lightVec, float currentDepth, float lightRadius)
+{
+    if (atlasRect.z <= 0.0)
+        return 1.0;
+
     const int samples = 20;
     float bias = 0.01;
-    float texelAngular = 1.0 / float(textureSize(cubeMap, 0).x);
+    float tileTexels = max(atlasRect.z * float(textureSize(shadowAtlas, 0).x), 1.0);
+    float texelAngular = 1.0 / tileTexels;
     float diskRadius = texelAngular * currentDepth * 2.0;
+
+    // Margen de medio texel para que el filtrado no lea del tile vecino
+    float margin = 0.5 / tileTexels;
     float litCount = 0.0;
 
     for (int i = 0; i < samples; ++i)
     {
         vec3 sampleDir = lightVec + sampleOffsetDirections[i] * diskRadius;
-        float closestDepth = texture(cubeMap, sampleDir).r;
+        vec3 faceUV = QE_CubeDirToFaceUV(sampleDir);
+        vec2 uv = atlasRect.xy + clamp(faceUV.xy, vec2(margin), vec2(1.0 - margin)) * atlasRect.zw;
+
+        float closestDepth = texture(shadowAtlas, vec3(uv, faceUV.z)).r * lightRadius;
         litCount += (currentDepth <= closestDepth + bias) ? 1.0 : 0.0;
     }
 
@@ -145,7 +188,7 @@ float GetCMVisibility(samplerCube cubeMap, vec3 lightVec, float currentDepth)
     return mix(SHADOW_OPACITY, 1.0, visibility);
 }
 
-float ComputeSpotTextureProj(sampler2D shadowMap, vec4 shadowCoord, vec2 offset)
+float ComputeSpotTextureProj(sampler2D shadowAtlas, vec4 atlasRect, vec4 shadowCoord, vec2 offset)
 {
     if (shadowCoord.w <= 0.0)
         return 1.0;
@@ -156,16 +199,21 @@ float ComputeSpotTextureProj(sampler2D shadowMap, vec4 shadowCoord, vec2 offset)
         return 1.0;
 
     const float bias = 0.0015;
-    float closest = texture(shadowMap, shadowCoord.st + offset).r;
+
+    // Las coordenadas del tile se recortan con medio texel de margen antes de pasar al atlas
+    float margin = 0.5 / max(atlasRect.z * float(textureSize(shadowAtlas, 0).x), 1.0);
+    vec2 uv = clamp(shadowCoord.st + offset, vec2(margin), vec2(1.0 - margin));
+    float closest = texture(shadowAtlas, atlasRect.xy + uv * atlasRect.zw).r;
 
     return (closest < shadowCoord.z - bias) ? SHADOW_OPACITY : 1.0;
 }
 
-float ComputeSpotFilterPCF(sampler2D shadowMap, vec4 shadowCoord)
+float ComputeSpotFilterPCF(sampler2D shadowAtlas, vec4 atlasRect, vec4 shadowCoord)
 {
-    ivec2 texDim = textureSize(shadowMap, 0);
-    float dx = 1.25 / float(texDim.x);
-    float dy = 1.25 / float(texDim.y);
+    // Offsets en UV del tile, no del atlas completo
+    vec2 tileDim = max(atlasRect.zw * vec2(textureSize(shadowAtlas, 0)), vec2(1.0));
+    float dx = 1.25 / tileDim.x;
+    float dy = 1.25 / tileDim.y;
 
     float sum = 0.0;
     int count = 0;
@@ -174,7 +222,7 @@ float ComputeSpotFilterPCF(sampler2D shadowMap, vec4 shadowCoord)
     {
         for (int y = -1; y <= 1; ++y)
         {
-            sum += ComputeSpotTextureProj(shadowMap, shadowCoord, vec2(dx * x, dy * y));
+            sum += ComputeSpotTextureProj(shadowAtlas, atlasRect, shadowCoord, vec2(dx * x, dy * y));
             count++;
         }
     }
@@ -182,8 +230,11 @@ float ComputeSpotFilterPCF(sampler2D shadowMap, vec4 shadowCoord)
     return sum / float(count);
 }
 
-float GetSpotVisibility(sampler2D shadowMap, vec3 fragPosWorld, mat4 viewProj, uint materialAlphaMode)
+float GetSpotVisibility(sampler2D shadowAtlas, vec4 atlasRect, vec3 fragPosWorld, mat4 viewProj, uint materialAlphaMode)
 {
+    if (atlasRect.z <= 0.0)
+        return 1.0;
+
     vec4 shadowCoord = (biasMat * viewProj) * vec4(fragPosWorld, 1.0);
     if (shadowCoord.w <= 0.0)
         return 1.0;
@@ -192,7 +243,7 @@ float GetSpotVisibility(sampler2D shadowMap, vec3 fragPosWorld, mat4 viewProj, u
     if (materialAlphaMode == 1u)
         shadowCoord.z -= 0.0025;
 
-    return ComputeSpotFilterPCF(shadowMap, shadowCoord);
+    return ComputeSpotFilterPCF(shadowAtlas, atlasRect, shadowCoord);
 }
 
 #endif
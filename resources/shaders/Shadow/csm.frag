@@ -2,10 +2,16 @@
 #extension GL_EXT_nonuniform_qualifier : require
 
 #include "../Includes/QECommon.glsl"
+#define QE_BINDLESS_SET 1
 #include "../Includes/PBR/QEPBRMaterial.glsl"
 
 layout(location = 0) in vec2 inTexCoord;
 
+#ifdef QE_BINDLESS_MATERIALS
+layout(location = 3) flat in uint inMaterialIndex;
+
+#define uboMaterial QE_Materials[inMaterialIndex]
+#else
 layout(set = 1, binding = 0, std140) uniform UniformCamera
 {
     QECameraData cameraData;
@@ -48,10 +54,11 @@ layout(set = 1, binding = 8) uniform ScreenData
     uvec2 tilePixelSize;
     uvec2 tileCount;
 } screenData;
+#endif
 
 void main()
 {
-    vec4 base = QE_GetBaseColorAlpha(uboMaterial, texSampler, inTexCoord);
+    vec4 base = QE_GetBaseColorAlpha(uboMaterial, QE_MATERIAL_TEXTURES, inTexCoord);
     if (QE_ShouldDiscardAlpha(uboMaterial, base))
         discard;
 }
@@ -13,6 +13,7 @@ layout(push_constant) uniform PushConsts
 {
 	mat4 model;
 	uint cascadeIndex;
+	uint materialIndex;
 } constants;
 
 layout (set = 0, binding = 0) uniform CSMUniform
@@ -20,13 +21,21 @@ layout (set = 0, binding = 0) uniform CSMUniform
 	mat4[CSM_COUNT] cascadeViewProj;
 } csm;
 
+#ifndef QE_BINDLESS_MATERIALS
 layout(set = 1, binding = 0, std140) uniform UniformCamera
 {
     QECameraData cameraData;
 };
+#else
+// El set 1 es la tabla bindless; el fragment shader lee el material con este indice
+layout (location = 3) flat out uint outMaterialIndex;
+#endif
 
 void main()
 {
 	outTexCoord = inTexCoord;
+#ifdef QE_BINDLESS_MATERIALS
+	outMaterialIndex = constants.materialIndex;
+#endif
 	gl_Position =  csm.cascadeViewProj[constants.cascadeIndex] * constants.model * vec4(inPosition.xyz, 1.0);
 }
@@ -2,14 +2,18 @@
 #extension GL_EXT_nonuniform_qualifier : require
 
 #include "../Includes/QECommon.glsl"
+#define QE_BINDLESS_SET 1
 #include "../Includes/PBR/QEPBRMaterial.glsl"
 
-layout(location = 0) out float color;
-
 layout (location = 0) in vec4 inPosition;
-layout (location = 1) in vec3 inLightPosition;
+layout (location = 1) in vec4 inLightPosition;
 layout (location = 2) in vec2 inTexCoord;
 
+#ifdef QE_BINDLESS_MATERIALS
+layout(location = 3) flat in uint inMaterialIndex;
+
+#define uboMaterial QE_Materials[inMaterialIndex]
+#else
 layout(set = 1, binding = 0, std140) uniform UniformCamera
 {
     QECameraData cameraData;
@@ -52,13 +56,15 @@ layout(set = 1, binding = 8) uniform ScreenData
     uvec2 tilePixelSize;
     uvec2 tileCount;
 } screenData;
+#endif
 
 void main() 
 {	
-	vec4 base = QE_GetBaseColorAlpha(uboMaterial, texSampler, inTexCoord);
+	vec4 base = QE_GetBaseColorAlpha(uboMaterial, QE_MATERIAL_TEXTURES, inTexCoord);
 	if (QE_ShouldDiscardAlpha(uboMaterial, base))
 		discard;
 
-	vec3 lightVec = inPosition.xyz - inLightPosition;
-	color = length(lightVec);
+	// Distancia lineal normalizada al radio: el atlas de point lights es solo profundidad
+	vec3 lightVec = inPosition.xyz - inLightPosition.xyz;
+	gl_FragDepth = clamp(length(lightVec) / inLightPosition.w, 0.0, 1.0);
 }
@@ -7,25 +7,31 @@ layout (location = 0) in vec4 inPosition;
 layout (location = 2) in vec2 inTexCoord;
 
 layout (location = 0) out vec4 outPosition;
-layout (location = 1) out vec3 outLightPosition;
+layout (location = 1) out vec4 outLightPosition;
 layout (location = 2) out vec2 outTexCoord;
 
 layout(set = 0, binding = 0) uniform PointLightCameraUniform
 {
 	mat4 projection;
-	vec4 lightPos;
+	vec4 lightPos; // w = far plane (radio de la luz)
 } plData;
 
+#ifndef QE_BINDLESS_MATERIALS
 layout(set = 1, binding = 0, std140) uniform UniformCamera
 {
     QECameraData cameraData;
 };
+#else
+// El set 1 es la tabla bindless; el fragment shader lee el material con este indice
+layout (location = 3) flat out uint outMaterialIndex;
+#endif
 
 layout(std430, push_constant) uniform PushConstants
 {
 	mat4 model;
 	mat4 lightModel;
 	mat4 view;
+	uint materialIndex;
 } constants;
 
 void main() 
@@ -33,6 +39,9 @@ void main()
     gl_Position = plData.projection * constants.view * constants.lightModel * inPosition;
 
     outPosition = constants.model * inPosition;	
-	outLightPosition = plData.lightPos.xyz; 
+	outLightPosition = plData.lightPos;
     outTexCoord = inTexCoord;
+#ifdef QE_BINDLESS_MATERIALS
+    outMaterialIndex = constants.materialIndex;
+#endif
 }
@@ -0,0 +1,63 @@
+#version 450
+#extension GL_ARB_separate_shader_objects : enable
+#extension GL_ARB_shader_viewport_layer_array : require
+
+#include "../Includes/QECommon.glsl"
+
+layout (location = 0) in vec4 inPosition;
+layout (location = 2) in vec2 inTexCoord;
+
+layout (location = 0) out vec4 outPosition;
+layout (location = 1) out vec4 outLightPosition;
+layout (location = 2) out vec2 outTexCoord;
+
+layout(set = 0, binding = 0) uniform PointLightCameraUniform
+{
+	mat4 projection;
+	vec4 lightPos; // w = far plane (radio de la luz)
+} plData;
+
+#ifndef QE_BINDLESS_MATERIALS
+layout(set = 1, binding = 0, std140) uniform UniformCamera
+{
+    QECameraData cameraData;
+};
+#else
+// El set 1 es la tabla bindless; el fragment shader lee el material con este indice
+layout (location = 3) flat out uint outMaterialIndex;
+#endif
+
+// faces.x = numero de caras, faces.y = indices de cara empaquetados en 3 bits por instancia, faces.z = indice de material
+layout(std430, push_constant) uniform PushConstants
+{
+	mat4 model;
+	mat4 lightModel;
+	uvec4 faces;
+} constants;
+
+// Mismas matrices que OmniShadowResources::GetCubeFaceViewMatrix
+const mat4 QE_CubeFaceViews[6] = mat4[]
+(
+    mat4(vec4(0.0, 0.0, -1.0, 0.0), vec4(0.0, -1.0, 0.0, 0.0), vec4(-1.0, 0.0, 0.0, 0.0), vec4(0.0, 0.0, 0.0, 1.0)), // +X
+    mat4(vec4(0.0, 0.0, 1.0, 0.0), vec4(0.0, -1.0, 0.0, 0.0), vec4(1.0, 0.0, 0.0, 0.0), vec4(0.0, 0.0, 0.0, 1.0)),  // -X
+    mat4(vec4(1.0, 0.0, 0.0, 0.0), vec4(0.0, 0.0, -1.0, 0.0), vec4(0.0, 1.0, 0.0, 0.0), vec4(0.0, 0.0, 0.0, 1.0)),  // +Y
+    mat4(vec4(1.0, 0.0, 0.0, 0.0), vec4(0.0, 0.0, 1.0, 0.0), vec4(0.0, -1.0, 0.0, 0.0), vec4(0.0, 0.0, 0.0, 1.0)),  // -Y
+    mat4(vec4(1.0, 0.0, 0.0, 0.0), vec4(0.0, -1.0, 0.0, 0.0), vec4(0.0, 0.0, -1.0, 0.0), vec4(0.0, 0.0, 0.0, 1.0)), // +Z
+    mat4(vec4(-1.0, 0.0, 0.0, 0.0), vec4(0.0, -1.0, 0.0, 0.0), vec4(0.0, 0.0, 1.0, 0.0), vec4(0.0, 0.0, 0.0, 1.0))  // -Z
+);
+
+void main() 
+{
+    // Una instancia por cara visible: la cara se escribe en gl_Layer (capa del atlas de point lights)
+    uint face = (constants.faces.y >> (3u * uint(gl_InstanceIndex))) & 7u;
+    gl_Layer = int(face);
+
+    gl_Position = plData.projection * QE_CubeFaceViews[face] * constants.lightModel * inPosition;
+
+    outPosition = constants.model * inPosition;	
+	outLightPosition = plData.lightPos;
+    outTexCoord = inTexCoord;
+#ifdef QE_BINDLESS_MATERIALS
+    outMaterialIndex = constants.faces.z;
+#endif
+}
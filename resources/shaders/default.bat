@@ -1,4 +1,5 @@
 C:/VulkanSDK/1.3.268.0/Bin/glslc.exe -I Shaders Default/default.vert -o Default/default_vert.spv
 C:/VulkanSDK/1.3.268.0/Bin/glslc.exe -I Shaders Default/default.frag -o Default/default_frag.spv
+C:/VulkanSDK/1.3.268.0/Bin/glslc.exe -I Shaders -DQE_BINDLESS_MATERIALS Default/default.frag -o Default/default_bindless_frag.spv
 
 pause
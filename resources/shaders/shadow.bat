@@ -1,5 +1,11 @@
 C:/VulkanSDK/1.3.268.0/Bin/glslc.exe Shadow/omni_shadow.vert -o Shadow/omni_shadow_vert.spv
 C:/VulkanSDK/1.3.268.0/Bin/glslc.exe Shadow/omni_shadow.frag -o Shadow/omni_shadow_frag.spv
+C:/VulkanSDK/1.3.268.0/Bin/glslc.exe Shadow/omni_shadow_layered.vert -o Shadow/omni_shadow_layered_vert.spv
 C:/VulkanSDK/1.3.268.0/Bin/glslc.exe Shadow/csm.vert -o Shadow/csm_vert.spv
 C:/VulkanSDK/1.3.268.0/Bin/glslc.exe Shadow/csm.frag -o Shadow/csm_frag.spv
+C:/VulkanSDK/1.3.268.0/Bin/glslc.exe -DQE_BINDLESS_MATERIALS Shadow/omni_shadow.vert -o Shadow/omni_shadow_bindless_vert.spv
+C:/VulkanSDK/1.3.268.0/Bin/glslc.exe -DQE_BINDLESS_MATERIALS Shadow/omni_shadow.frag -o Shadow/omni_shadow_bindless_frag.spv
+C:/VulkanSDK/1.3.268.0/Bin/glslc.exe -DQE_BINDLESS_MATERIALS Shadow/omni_shadow_layered.vert -o Shadow/omni_shadow_layered_bindless_vert.spv
+C:/VulkanSDK/1.3.268.0/Bin/glslc.exe -DQE_BINDLESS_MATERIALS Shadow/csm.vert -o Shadow/csm_bindless_vert.spv
+C:/VulkanSDK/1.3.268.0/Bin/glslc.exe -DQE_BINDLESS_MATERIALS Shadow/csm.frag -o Shadow/csm_bindless_frag.spv
 pause
@@ -0,0 +1,629 @@
+#include "QEBenchmarkApp.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <glm/gtc/matrix_inverse.hpp>
+
+#include <Logging/QELogMacros.h>
+#include <GameObjectManager.h>
+#include <QEGeometryComponent.h>
+#include <QEGeometryResourceCache.h>
+#include <Light.h>
+#include <QETextureStreamer.h>
+#include <QEKtxTranscodeCache.h>
+#include <ShadowCacheManager.h>
+#include <ShadowCasterCulling.h>
+
+namespace
+{
+    struct SeriesSummary
+    {
+        double Avg = 0.0;
+        double Min = 0.0;
+        double Max = 0.0;
+        double P50 = 0.0;
+        double P95 = 0.0;
+        double P99 = 0.0;
+    };
+
+    SeriesSummary Summarize(std::vector<double> values)
+    {
+        SeriesSummary summary;
+        if (values.empty())
+            return summary;
+
+        std::sort(values.begin(), values.end());
+
+        double total = 0.0;
+        for (double value : values)
+        {
+            total += value;
+        }
+
+        // Percentil por rango mas cercano
+        auto percentile = [&values](double p)
+            {
+                const size_t rank = static_cast<size_t>(std::ceil(p * values.size()));
+                return values[std::clamp<size_t>(rank, 1, values.size()) - 1];
+            };
+
+        summary.Avg = total / values.size();
+        summary.Min = values.front();
+        summary.Max = values.back();
+        summary.P50 = percentile(0.50);
+        summary.P95 = percentile(0.95);
+        summary.P99 = percentile(0.99);
+        return summary;
+    }
+
+    void WriteSummary(std::ofstream& out, const char* name, const SeriesSummary& s, bool last)
+    {
+        out << "    \"" << name << "\": { "
+            << "\"avg\": " << s.Avg << ", "
+            << "\"min\": " << s.Min << ", "
+            << "\"max\": " << s.Max << ", "
+            << "\"p50\": " << s.P50 << ", "
+            << "\"p95\": " << s.P95 << ", "
+            << "\"p99\": " << s.P99 << " }"
+            << (last ? "\n" : ",\n");
+    }
+
+    void WriteMeshStats(std::ofstream& out, const char* name, const QEMeshOptimizationStats& s)
+    {
+        out << "\"" << name << "\": { "
+            << "\"acmr\": " << s.Acmr() << ", "
+            << "\"atvr\": " << s.Atvr() << ", "
+            << "\"overdraw\": " << s.Overdraw() << ", "
+            << "\"overfetch\": " << s.Overfetch() << ", "
+            << "\"vertices\": " << s.Vertices << ", "
+            << "\"triangles\": " << s.Triangles << " }";
+    }
+
+    // Cargas en caliente de --scene-scale, en paralelo y en serie
+    constexpr uint32_t SCALED_LOAD_RUNS = 3;
+
+    template<typename T>
+    bool HasComponentInTree(const std::shared_ptr<QEGameObject>& gameObject)
+    {
+        if (!gameObject)
+            return false;
+
+        for (const auto& component : gameObject->GetComponents())
+        {
+            if (std::dynamic_pointer_cast<T>(component))
+                return true;
+        }
+
+        for (const auto& child : gameObject->GetChildren())
+        {
+            if (HasComponentInTree<T>(child))
+                return true;
+        }
+
+        return false;
+    }
+
+    std::string EscapeJson(const std::string& value)
+    {
+        std::string result;
+        result.reserve(value.size());
+        for (char c : value)
+        {
+            if (c == '"' || c == '\\')
+                result.push_back('\\');
+            result.push_back(c);
+        }
+        return result;
+    }
+}
+
+QEBenchmarkApp::QEBenchmarkApp(const QEBenchmarkOptions& options)
+    : options(options)
+{
+    if (!options.Windowed)
+    {
+        this->SetHeadless(options.Width, options.Height);
+    }
+}
+
+void QEBenchmarkApp::OnInitialize()
+{
+    Timer::getInstance()->SetSimulatedFrameDelta(options.FrameDelta);
+
+    const float duration = options.Frames * options.FrameDelta;
+
+    if (!options.CameraPathFile.empty())
+    {
+        if (!cameraPath.LoadFromFile(options.CameraPathFile))
+        {
+            QE_LOG_WARN_CAT("Benchmark", "Falling back to the default orbit camera path");
+        }
+    }
+
+    if (cameraPath.Empty())
+    {
+        glm::vec3 boundsMin(-5.0f), boundsMax(5.0f);
+        QERaycastSystem::getInstance()->GetSceneBounds(boundsMin, boundsMax);
+        cameraPath.BuildOrbit(boundsMin, boundsMax, duration);
+    }
+
+    samples.reserve(options.Frames);
+
+    if (options.MeshStats)
+    {
+        CollectMeshStats();
+    }
+
+    if (options.SceneLoadIterations > 0)
+    {
+        MeasureSceneLoad();
+    }
+
+    if (options.SceneScale > 0)
+    {
+        MeasureScaledSceneLoad();
+    }
+
+    if (options.RaycastRays > 0)
+    {
+        MeasureRaycasts();
+    }
+
+    QE_LOG_INFO_CAT_F("Benchmark", "Running {} frames ({} warmup) at {}x{} ({})",
+        options.Frames, options.WarmupFrames, options.Width, options.Height,
+        IsHeadless() ? "headless" : "windowed");
+}
+
+void QEBenchmarkApp::OnShutdown()
+{
+    Timer::getInstance()->SetSimulatedFrameDelta(0.0f);
+
+    if (samples.size() < options.Frames)
+    {
+        QE_LOG_WARN_CAT_F("Benchmark", "Benchmark stopped after {} of {} measured frames", samples.size(), options.Frames);
+    }
+
+    succeeded = WriteResults();
+}
+
+void QEBenchmarkApp::OnFrameStart()
+{
+    // Los tiempos y contadores del frame anterior ya estan completos al empezar el siguiente
+    if (frameIndex > 0)
+    {
+        SampleLastFrame();
+    }
+
+    if (samples.size() >= options.Frames)
+    {
+        RequestClose();
+    }
+
+    ++frameIndex;
+}
+
+void QEBenchmarkApp::OnEndFrame()
+{
+    ApplyCameraPath();
+}
+
+void QEBenchmarkApp::SampleLastFrame()
+{
+    const uint32_t frame = frameIndex - 1;
+    if (frame < options.WarmupFrames || samples.size() >= options.Frames)
+        return;
+
+    QEBenchmarkFrameSample sample;
+    sample.Frame = frame - options.WarmupFrames;
+    sample.Timings = GetLastFrameTimings();
+
+    const ShadowCacheFrameStats& cacheStats = ShadowCacheManager::getInstance()->GetFrameStats();
+    sample.ShadowViewsRendered = cacheStats.RenderedViews;
+    sample.ShadowViewsSkipped = cacheStats.SkippedViews;
+
+    const ShadowCullingFrameStats& cullingStats = ShadowCasterCulling::getInstance()->GetFrameStats();
+    sample.ShadowCasterTests = cullingStats.CasterTests;
+    sample.ShadowCastersVisible = cullingStats.VisibleCasters;
+    sample.ShadowCastersCulled = cullingStats.CulledCasters;
+
+    sample.DirectionalLights = static_cast<uint32_t>(lightManager->GetDirectionalLights().size());
+    sample.PointLights = static_cast<uint32_t>(lightManager->GetPointLights().size());
+    sample.SpotLights = static_cast<uint32_t>(lightManager->GetSpotLights().size());
+    sample.SyncedBodies = static_cast<uint32_t>(physicsModule->GetLastSyncedBodyCount());
+
+    const QETextureStreamingStats& streamingStats = QETextureStreamer::getInstance()->GetStats();
+    sample.TextureUploads = streamingStats.UploadsLastFrame;
+    sample.TextureUploadBytes = streamingStats.BytesLastFrame;
+    sample.TexturesPending = streamingStats.Pending;
+    sample.TextureStreamingMs = streamingStats.UpdateMsLastFrame;
+
+    const QETextureResidencyStats& residencyStats = QETextureStreamer::getInstance()->GetResidencyStats();
+    sample.TextureResidentBytes = residencyStats.ResidentBytes;
+    sample.TexturesBudgetLimited = residencyStats.BudgetLimited;
+
+    samples.push_back(sample);
+}
+
+void QEBenchmarkApp::ApplyCameraPath()
+{
+    auto activeCamera = cameraContext->ActiveCamera();
+    if (!activeCamera || !activeCamera->Owner)
+        return;
+
+    auto transform = activeCamera->Owner->GetComponent<QETransform>();
+    if (!transform)
+        return;
+
+    const float time = frameIndex * options.FrameDelta;
+    glm::mat4 cameraWorld = glm::inverse(cameraPath.Evaluate(time));
+
+    if (auto parent = transform->GetParent())
+    {
+        cameraWorld = glm::inverse(parent->GetWorldMatrix()) * cameraWorld;
+    }
+
+    transform->SetFromMatrix(cameraWorld);
+}
+
+void QEBenchmarkApp::CollectMeshStats()
+{
+    const QEMeshOptimizationSettings defaults{};
+
+    for (const auto& resource : QEGeometryResourceCache::GetLiveResources())
+    {
+        QEBenchmarkMeshSample sample;
+        sample.Name = resource->Mesh.Name;
+        sample.Current = QEMeshOptimizer::Analyze(resource->Mesh);
+
+        // Sobre una copia: el benchmark no cambia lo que se dibuja
+        QEMesh optimized = resource->Mesh;
+        for (QEMeshData& data : optimized.MeshData)
+        {
+            QEMeshOptimizer::Optimize(data, defaults);
+        }
+        sample.Optimized = QEMeshOptimizer::Analyze(optimized);
+
+        QE_LOG_INFO_CAT_F("Benchmark", "Mesh {}: {} (optimized: ACMR {:.3f}, ATVR {:.3f}, overdraw {:.3f})",
+            sample.Name, sample.Current.ToString(), sample.Optimized.Acmr(), sample.Optimized.Atvr(), sample.Optimized.Overdraw());
+
+        meshSamples.push_back(std::move(sample));
+    }
+}
+
+void QEBenchmarkApp::MeasureSceneLoad()
+{
+    // Materiales y atmosfera del archivo; los objetos, los ya cargados (con sus materiales resueltos)
+    QESceneContent content;
+    content.Atmosphere = scene.atmosphereDto;
+    if (!QEScene::ReadSceneFile(scene.GetSceneFilePath(), content))
+    {
+        QE_LOG_WARN_CAT("Benchmark", "Skipping the scene load benchmark: the scene file could not be read");
+        return;
+    }
+    content.GameObjects = gameObjectManager->GetSerializableRootGameObjects();
+
+    const std::filesystem::path basePath = options.OutputPath.parent_path() / options.OutputPath.stem();
+    sceneLoad.YamlPath = std::filesystem::path(basePath).concat("_scene_yaml.qescene");
+    sceneLoad.BinaryPath = std::filesystem::path(basePath).concat("_scene_binary.qescene");
+    sceneLoad.RootObjects = content.GameObjects.size();
+
+    if (!QEScene::WriteSceneFile(sceneLoad.YamlPath, QESceneFormat::Yaml, content) ||
+        !QEScene::WriteSceneFile(sceneLoad.BinaryPath, QESceneFormat::Binary, content))
+    {
+        QE_LOG_WARN_CAT("Benchmark", "Skipping the scene load benchmark: the scene copies could not be written");
+        return;
+    }
+
+    std::error_code ec;
+    sceneLoad.YamlBytes = std::filesystem::file_size(sceneLoad.YamlPath, ec);
+    sceneLoad.BinaryBytes = std::filesystem::file_size(sceneLoad.BinaryPath, ec);
+
+    // Alternando formatos: los dos archivos con la cache del sistema igual de caliente
+    auto measure = [](const std::filesystem::path& path)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            QESceneContent decoded;
+            QEScene::ReadSceneFile(path, decoded);
+            return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        };
+
+    for (uint32_t i = 0; i < options.SceneLoadIterations; ++i)
+    {
+        sceneLoad.YamlMs.push_back(measure(sceneLoad.YamlPath));
+        sceneLoad.BinaryMs.push_back(measure(sceneLoad.BinaryPath));
+    }
+
+    QE_LOG_INFO_CAT_F("Benchmark", "Scene load: YAML {:.3f} ms ({} bytes), binary {:.3f} ms ({} bytes), {} iterations",
+        Summarize(sceneLoad.YamlMs).P50, sceneLoad.YamlBytes, Summarize(sceneLoad.BinaryMs).P50, sceneLoad.BinaryBytes,
+        options.SceneLoadIterations);
+}
+
+void QEBenchmarkApp::MeasureScaledSceneLoad()
+{
+    const std::filesystem::path originalPath = scene.GetSceneFilePath();
+
+    QESceneContent content;
+    content.Atmosphere = scene.atmosphereDto;
+    if (!QEScene::ReadSceneFile(originalPath, content))
+    {
+        QE_LOG_WARN_CAT("Benchmark", "Skipping the scaled scene load: the scene file could not be read");
+        return;
+    }
+
+    // Copias de los objetos con geometria; camaras y luces solo las de la escena original
+    for (uint32_t copy = 1; copy < options.SceneScale; ++copy)
+    {
+        QESceneContent copyContent;
+        if (!QEScene::ReadSceneFile(originalPath, copyContent))
+            break;
+
+        for (const auto& root : copyContent.GameObjects)
+        {
+            if (HasComponentInTree<QEGeometryComponent>(root) &&
+                !HasComponentInTree<QECamera>(root) &&
+                !HasComponentInTree<QELight>(root))
+            {
+                content.GameObjects.push_back(root);
+            }
+        }
+    }
+
+    const std::filesystem::path basePath = options.OutputPath.parent_path() / options.OutputPath.stem();
+    scaledLoad.Path = std::filesystem::path(basePath).concat("_scene_x" + std::to_string(options.SceneScale) + ".qescene");
+    scaledLoad.Scale = options.SceneScale;
+    scaledLoad.RootObjects = content.GameObjects.size();
+
+    if (!QEScene::WriteSceneFile(scaledLoad.Path, scene.format, content))
+    {
+        QE_LOG_WARN_CAT("Benchmark", "Skipping the scaled scene load: the scene copy could not be written");
+        return;
+    }
+    content.GameObjects.clear();
+
+    auto measure = [this](const std::filesystem::path& path)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            LoadSceneFromPath(path);
+            return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        };
+
+    try
+    {
+        scaledLoad.ColdMs = measure(scaledLoad.Path);
+        scaledLoad.ColdStats = QESceneLoader::GetLastStats();
+
+        for (uint32_t i = 0; i < SCALED_LOAD_RUNS; ++i)
+        {
+            scaledLoad.WarmMs.push_back(measure(scaledLoad.Path));
+        }
+        scaledLoad.WarmStats = QESceneLoader::GetLastStats();
+
+        QESceneLoader::Parallel = false;
+        for (uint32_t i = 0; i < SCALED_LOAD_RUNS; ++i)
+        {
+            scaledLoad.SerialMs.push_back(measure(scaledLoad.Path));
+        }
+        QESceneLoader::Parallel = true;
+
+        // Los frames se miden sobre la escena original
+        LoadSceneFromPath(originalPath);
+    }
+    catch (const std::exception& e)
+    {
+        QESceneLoader::Parallel = true;
+        QE_LOG_ERROR_CAT_F("Benchmark", "Scaled scene load failed ({})", e.what());
+        throw;
+    }
+
+    QE_LOG_INFO_CAT_F("Benchmark", "Scene x{} ({} roots, {} meshes): cold {:.1f} ms, warm {:.1f} ms, warm serial {:.1f} ms",
+        scaledLoad.Scale, scaledLoad.RootObjects, scaledLoad.ColdStats.Meshes, scaledLoad.ColdMs,
+        Summarize(scaledLoad.WarmMs).P50, Summarize(scaledLoad.SerialMs).P50);
+}
+
+void QEBenchmarkApp::MeasureRaycasts()
+{
+    // Sobre la escena ya cargada, antes del primer frame medido
+    raycast = QERaycastSystem::getInstance()->RunBenchmark(options.RaycastRays, options.RaycastBruteForceRays);
+    raycastSceneEntries = QERaycastSystem::getInstance()->GetSceneEntryCount();
+
+    if (raycast.Rays == 0)
+    {
+        QE_LOG_WARN_CAT("Benchmark", "Skipping the raycast benchmark: the scene has no geometry");
+        return;
+    }
+
+    QE_LOG_INFO_CAT_F("Benchmark", "Raycasts ({} entries): BVH {:.0f} rays/s, brute force {:.0f} rays/s, {} hits, {} mismatched",
+        raycastSceneEntries, raycast.BVHRaysPerSecond, raycast.BruteForceRaysPerSecond, raycast.Hits, raycast.MismatchedHits);
+}
+
+bool QEBenchmarkApp::WriteResults() const
+{
+    std::ofstream out(options.OutputPath);
+    if (!out)
+    {
+        QE_LOG_ERROR_CAT_F("Benchmark", "Could not write benchmark results to '{}'", options.OutputPath.string());
+        return false;
+    }
+
+    std::vector<double> frameMs, updateMs, physicsMs, renderCpuMs, gpuMs, computeGpuMs;
+    for (const auto& sample : samples)
+    {
+        frameMs.push_back(sample.Timings.FrameMs);
+        updateMs.push_back(sample.Timings.UpdateMs);
+        physicsMs.push_back(sample.Timings.PhysicsMs);
+        renderCpuMs.push_back(sample.Timings.RenderCpuMs);
+        gpuMs.push_back(sample.Timings.GpuMs);
+        computeGpuMs.push_back(sample.Timings.ComputeGpuMs);
+    }
+
+    out << "{\n";
+    out << "  \"scene\": \"" << EscapeJson(options.ScenePath.generic_string()) << "\",\n";
+    out << "  \"width\": " << options.Width << ",\n";
+    out << "  \"height\": " << options.Height << ",\n";
+    out << "  \"headless\": " << (IsHeadless() ? "true" : "false") << ",\n";
+    out << "  \"warmupFrames\": " << options.WarmupFrames << ",\n";
+    out << "  \"frames\": " << samples.size() << ",\n";
+    out << "  \"framesInFlight\": " << MAX_FRAMES_IN_FLIGHT << ",\n";
+    out << "  \"timeToFirstFrameMs\": " << GetTimeToFirstFrameMs() << ",\n";
+
+    // Tirones: frames por encima del doble de la mediana (con --warmup 0 incluye la carga)
+    const SeriesSummary frameSummary = Summarize(frameMs);
+    const size_t hitches = std::count_if(frameMs.begin(), frameMs.end(), [&frameSummary](double ms)
+        {
+            return ms > 2.0 * frameSummary.P50;
+        });
+    out << "  \"hitches\": " << hitches << ",\n";
+
+    out << "  \"summary\": {\n";
+    WriteSummary(out, "frameMs", frameSummary, false);
+    WriteSummary(out, "updateMs", Summarize(updateMs), false);
+    WriteSummary(out, "physicsMs", Summarize(physicsMs), false);
+    WriteSummary(out, "renderCpuMs", Summarize(renderCpuMs), false);
+    WriteSummary(out, "gpuMs", Summarize(gpuMs), false);
+    WriteSummary(out, "computeGpuMs", Summarize(computeGpuMs), true);
+    out << "  },\n";
+
+    const QETextureStreamingStats& streaming = QETextureStreamer::getInstance()->GetStats();
+    out << "  \"textureStreaming\": { "
+        << "\"requested\": " << streaming.Requested << ", "
+        << "\"resident\": " << streaming.Resident << ", "
+        << "\"failed\": " << streaming.Failed << ", "
+        << "\"pending\": " << streaming.Pending << ", "
+        << "\"bytesUploaded\": " << streaming.BytesUploaded << ", "
+        << "\"maxUpdateMs\": " << streaming.MaxUpdateMs << ", "
+        << "\"allResidentMs\": " << streaming.AllResidentMs << " },\n";
+
+    const QETextureResidencyStats& residency = QETextureStreamer::getInstance()->GetResidencyStats();
+    out << "  \"textureResidency\": { "
+        << "\"budgetBytes\": " << residency.BudgetBytes << ", "
+        << "\"residentBytes\": " << residency.ResidentBytes << ", "
+        << "\"desiredBytes\": " << residency.DesiredBytes << ", "
+        << "\"budgetLimited\": " << residency.BudgetLimited << ", "
+        << "\"streamIns\": " << streaming.StreamIns << ", "
+        << "\"evictions\": " << streaming.Evictions << ", "
+        << "\"mipsStreamedIn\": " << streaming.MipsStreamedIn << ", "
+        << "\"mipsEvicted\": " << streaming.MipsEvicted << ", "
+        << "\"evictedBytes\": " << streaming.EvictedBytes << " },\n";
+
+    const QEKtxTranscodeCacheStats transcodeCache = QEKtxTranscodeCache::GetStats();
+    out << "  \"ktxTranscodeCache\": { "
+        << "\"hits\": " << transcodeCache.Hits << ", "
+        << "\"misses\": " << transcodeCache.Misses << ", "
+        << "\"writes\": " << transcodeCache.Writes << ", "
+        << "\"bytesMapped\": " << transcodeCache.BytesMapped << ", "
+        << "\"transcodeMs\": " << transcodeCache.TranscodeMs << " },\n";
+
+    if (!meshSamples.empty())
+    {
+        QEMeshOptimizationStats totalCurrent;
+        QEMeshOptimizationStats totalOptimized;
+
+        out << "  \"meshes\": [\n";
+        for (size_t i = 0; i < meshSamples.size(); ++i)
+        {
+            const auto& m = meshSamples[i];
+            totalCurrent.Accumulate(m.Current);
+            totalOptimized.Accumulate(m.Optimized);
+
+            out << "    { \"name\": \"" << EscapeJson(m.Name) << "\", ";
+            WriteMeshStats(out, "current", m.Current);
+            out << ", ";
+            WriteMeshStats(out, "optimized", m.Optimized);
+            out << " }" << (i + 1 < meshSamples.size() ? ",\n" : "\n");
+        }
+        out << "  ],\n";
+
+        out << "  \"meshTotals\": { ";
+        WriteMeshStats(out, "current", totalCurrent);
+        out << ", ";
+        WriteMeshStats(out, "optimized", totalOptimized);
+        out << " },\n";
+    }
+
+    if (!sceneLoad.YamlMs.empty())
+    {
+        out << "  \"sceneLoad\": {\n";
+        out << "    \"iterations\": " << sceneLoad.YamlMs.size() << ",\n";
+        out << "    \"rootObjects\": " << sceneLoad.RootObjects << ",\n";
+        out << "    \"yamlBytes\": " << sceneLoad.YamlBytes << ",\n";
+        out << "    \"binaryBytes\": " << sceneLoad.BinaryBytes << ",\n";
+        WriteSummary(out, "yamlMs", Summarize(sceneLoad.YamlMs), false);
+        WriteSummary(out, "binaryMs", Summarize(sceneLoad.BinaryMs), true);
+        out << "  },\n";
+    }
+
+    if (scaledLoad.Scale > 0 && !scaledLoad.WarmMs.empty())
+    {
+        auto writeLoadStats = [&out](const char* name, const QESceneLoadStats& stats)
+            {
+                out << "    \"" << name << "\": { "
+                    << "\"workers\": " << stats.Workers << ", "
+                    << "\"materialFiles\": " << stats.MaterialFiles << ", "
+                    << "\"meshes\": " << stats.Meshes << ", "
+                    << "\"meshReferences\": " << stats.MeshReferences << ", "
+                    << "\"reusedMeshes\": " << stats.ReusedMeshes << ", "
+                    << "\"uploadBatches\": " << stats.UploadBatches << ", "
+                    << "\"materialsMs\": " << stats.MaterialsMs << ", "
+                    << "\"meshesMs\": " << stats.MeshesMs << ", "
+                    << "\"totalMs\": " << stats.TotalMs << " },\n";
+            };
+
+        out << "  \"scaledSceneLoad\": {\n";
+        out << "    \"scale\": " << scaledLoad.Scale << ",\n";
+        out << "    \"rootObjects\": " << scaledLoad.RootObjects << ",\n";
+        out << "    \"coldMs\": " << scaledLoad.ColdMs << ",\n";
+        writeLoadStats("coldGraph", scaledLoad.ColdStats);
+        writeLoadStats("warmGraph", scaledLoad.WarmStats);
+        WriteSummary(out, "warmMs", Summarize(scaledLoad.WarmMs), false);
+        WriteSummary(out, "warmSerialMs", Summarize(scaledLoad.SerialMs), true);
+        out << "  },\n";
+    }
+
+    if (raycast.Rays > 0)
+    {
+        out << "  \"raycast\": { "
+            << "\"sceneEntries\": " << raycastSceneEntries << ", "
+            << "\"rays\": " << raycast.Rays << ", "
+            << "\"hits\": " << raycast.Hits << ", "
+            << "\"bvhRaysPerSecond\": " << raycast.BVHRaysPerSecond << ", "
+            << "\"bruteForceRays\": " << std::min(options.RaycastBruteForceRays, raycast.Rays) << ", "
+            << "\"bruteForceRaysPerSecond\": " << raycast.BruteForceRaysPerSecond << ", "
+            << "\"mismatchedHits\": " << raycast.MismatchedHits << " },\n";
+    }
+
+    out << "  \"perFrame\": [\n";
+    for (size_t i = 0; i < samples.size(); ++i)
+    {
+        const auto& s = samples[i];
+        out << "    { \"frame\": " << s.Frame
+            << ", \"frameMs\": " << s.Timings.FrameMs
+            << ", \"updateMs\": " << s.Timings.UpdateMs
+            << ", \"physicsMs\": " << s.Timings.PhysicsMs
+            << ", \"renderCpuMs\": " << s.Timings.RenderCpuMs
+            << ", \"gpuMs\": " << s.Timings.GpuMs
+            << ", \"computeGpuMs\": " << s.Timings.ComputeGpuMs
+            << ", \"shadowViewsRendered\": " << s.ShadowViewsRendered
+            << ", \"shadowViewsSkipped\": " << s.ShadowViewsSkipped
+            << ", \"shadowCasterTests\": " << s.ShadowCasterTests
+            << ", \"shadowCastersVisible\": " << s.ShadowCastersVisible
+            << ", \"shadowCastersCulled\": " << s.ShadowCastersCulled
+            << ", \"directionalLights\": " << s.DirectionalLights
+            << ", \"pointLights\": " << s.PointLights
+            << ", \"spotLights\": " << s.SpotLights
+            << ", \"syncedBodies\": " << s.SyncedBodies
+            << ", \"textureUploads\": " << s.TextureUploads
+            << ", \"textureUploadBytes\": " << s.TextureUploadBytes
+            << ", \"texturesPending\": " << s.TexturesPending
+            << ", \"textureStreamingMs\": " << s.TextureStreamingMs
+            << ", \"textureResidentBytes\": " << s.TextureResidentBytes
+            << ", \"texturesBudgetLimited\": " << s.TexturesBudgetLimited
+            << " }" << (i + 1 < samples.size() ? ",\n" : "\n");
+    }
+    out << "  ]\n";
+    out << "}\n";
+
+    QE_LOG_INFO_CAT_F("Benchmark", "Wrote {} frames to '{}'", samples.size(), options.OutputPath.string());
+    return true;
+}
@@ -0,0 +1,122 @@
+#pragma once
+
+#include "QEBaseApp.h"
+#include "QEBenchmarkCameraPath.h"
+#include <QEMeshOptimizer.h>
+#include <QERaycastSystem.h>
+#include <QESceneLoader.h>
+
+#include <filesystem>
+#include <string>
+#include <vector>
+
+struct QEBenchmarkOptions
+{
+    std::filesystem::path ProjectPath;
+    std::filesystem::path ScenePath;        // Vacio: escena por defecto del proyecto
+    std::filesystem::path CameraPathFile;   // Vacio: orbita alrededor de la escena
+    std::filesystem::path OutputPath = "benchmark_results.json";
+    uint32_t Frames = 600;
+    uint32_t WarmupFrames = 60;
+    uint32_t Width = 1280;
+    uint32_t Height = 720;
+    float FrameDelta = 1.0f / 60.0f;        // Paso de simulacion fijo: misma escena en cada frame medido
+    bool Windowed = false;
+    bool MeshStats = false;                 // ACMR/ATVR/overdraw de las mallas cargadas, actuales y optimizadas
+    uint32_t SceneLoadIterations = 0;       // >0: decodifica la escena en YAML y en binario N veces
+    uint32_t SceneScale = 0;                // >0: carga completa de la escena repetida N veces, en frio y en caliente
+    uint32_t RaycastRays = 0;               // >0: rayos/s contra la escena con BVH y por fuerza bruta
+    uint32_t RaycastBruteForceRays = 1000;  // Rayos de la pasada por fuerza bruta (los primeros de los N)
+};
+
+struct QEBenchmarkFrameSample
+{
+    uint32_t Frame = 0;
+    QEFrameTimings Timings{};
+
+    uint32_t ShadowViewsRendered = 0;
+    uint32_t ShadowViewsSkipped = 0;
+    uint32_t ShadowCasterTests = 0;
+    uint32_t ShadowCastersVisible = 0;
+    uint32_t ShadowCastersCulled = 0;
+    uint32_t DirectionalLights = 0;
+    uint32_t PointLights = 0;
+    uint32_t SpotLights = 0;
+    uint32_t SyncedBodies = 0;
+
+    uint32_t TextureUploads = 0;
+    uint64_t TextureUploadBytes = 0;
+    uint32_t TexturesPending = 0;
+    double TextureStreamingMs = 0.0;
+    uint64_t TextureResidentBytes = 0;
+    uint32_t TexturesBudgetLimited = 0;
+};
+
+struct QEBenchmarkMeshSample
+{
+    std::string Name;
+    QEMeshOptimizationStats Current;
+    QEMeshOptimizationStats Optimized;      // Lo que daria la optimizacion de importacion por defecto
+};
+
+struct QEBenchmarkSceneLoad
+{
+    std::filesystem::path YamlPath;
+    std::filesystem::path BinaryPath;
+    uint64_t YamlBytes = 0;
+    uint64_t BinaryBytes = 0;
+    size_t RootObjects = 0;
+    std::vector<double> YamlMs;
+    std::vector<double> BinaryMs;
+};
+
+/// Carga completa (LoadSceneFromPath) de la escena con sus objetos con geometria repetidos Scale veces.
+/// La primera carga del proceso es la fria; las siguientes, en paralelo y en serie, van en caliente.
+struct QEBenchmarkScaledLoad
+{
+    std::filesystem::path Path;
+    uint32_t Scale = 0;
+    size_t RootObjects = 0;
+    double ColdMs = 0.0;
+    QESceneLoadStats ColdStats;
+    std::vector<double> WarmMs;
+    QESceneLoadStats WarmStats;
+    std::vector<double> SerialMs;
+};
+
+/// Carga una escena, recorre un camino de camara durante N frames (tras un calentamiento)
+/// y vuelca los tiempos de CPU/GPU y contadores de cada frame a un JSON.
+class QEBenchmarkApp : public QEBaseApp
+{
+public:
+    explicit QEBenchmarkApp(const QEBenchmarkOptions& options);
+
+    bool Succeeded() const { return succeeded; }
+
+protected:
+    void OnInitialize() override;
+    void OnShutdown() override;
+    void OnFrameStart() override;
+    void OnEndFrame() override;
+
+private:
+    void SampleLastFrame();
+    void ApplyCameraPath();
+    void CollectMeshStats();
+    void MeasureSceneLoad();
+    void MeasureScaledSceneLoad();
+    void MeasureRaycasts();
+    bool WriteResults() const;
+
+private:
+    QEBenchmarkOptions options;
+    QEBenchmarkCameraPath cameraPath;
+    std::vector<QEBenchmarkFrameSample> samples;
+    std::vector<QEBenchmarkMeshSample> meshSamples;
+    QEBenchmarkSceneLoad sceneLoad;
+    QEBenchmarkScaledLoad scaledLoad;
+    QERaycastBenchmarkResult raycast;
+    uint32_t raycastSceneEntries = 0;
+    uint32_t frameIndex = 0;
+    bool succeeded = false;
+};
@@ -0,0 +1,118 @@
+#include "QEBenchmarkCameraPath.h"
+
+#include <algorithm>
+#include <cmath>
+#include <glm/gtc/constants.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <yaml-cpp/yaml.h>
+#include <glm_yaml_conversions.h>
+#include <Logging/QELogMacros.h>
+
+namespace
+{
+    glm::vec3 CatmullRom(const glm::vec3& p0, const glm::vec3& p1, const glm::vec3& p2, const glm::vec3& p3, float t)
+    {
+        const float t2 = t * t;
+        const float t3 = t2 * t;
+        return 0.5f * ((2.0f * p1) +
+            (-p0 + p2) * t +
+            (2.0f * p0 - 5.0f * p1 + 4.0f * p2 - p3) * t2 +
+            (-p0 + 3.0f * p1 - 3.0f * p2 + p3) * t3);
+    }
+}
+
+bool QEBenchmarkCameraPath::LoadFromFile(const std::filesystem::path& path)
+{
+    YAML::Node root;
+    try
+    {
+        root = YAML::LoadFile(path.string());
+    }
+    catch (const std::exception& e)
+    {
+        QE_LOG_ERROR_CAT_F("Benchmark", "Could not read camera path '{}': {}", path.string(), e.what());
+        return false;
+    }
+
+    keys.clear();
+    loop = root["Loop"] ? root["Loop"].as<bool>() : false;
+
+    for (const auto& node : root["Keyframes"])
+    {
+        QEBenchmarkCameraKey key;
+        key.Time = node["Time"].as<float>();
+        key.Position = node["Position"].as<glm::vec3>();
+        key.Target = node["Target"].as<glm::vec3>();
+        keys.push_back(key);
+    }
+
+    std::sort(keys.begin(), keys.end(), [](const auto& a, const auto& b) { return a.Time < b.Time; });
+
+    if (keys.empty())
+    {
+        QE_LOG_ERROR_CAT_F("Benchmark", "Camera path '{}' has no keyframes", path.string());
+        return false;
+    }
+
+    return true;
+}
+
+void QEBenchmarkCameraPath::BuildOrbit(const glm::vec3& boundsMin, const glm::vec3& boundsMax, float duration, uint32_t keyCount)
+{
+    keys.clear();
+    loop = true;
+
+    const glm::vec3 center = (boundsMin + boundsMax) * 0.5f;
+    const float radius = std::max(glm::length(boundsMax - boundsMin) * 0.5f, 1.0f);
+    const float distance = radius * 1.5f;
+    keyCount = std::max(keyCount, 4u);
+
+    for (uint32_t i = 0; i <= keyCount; ++i)
+    {
+        const float angle = glm::two_pi<float>() * static_cast<float>(i) / static_cast<float>(keyCount);
+
+        QEBenchmarkCameraKey key;
+        key.Time = duration * static_cast<float>(i) / static_cast<float>(keyCount);
+        key.Position = center + glm::vec3(std::cos(angle) * distance, radius * 0.5f, std::sin(angle) * distance);
+        key.Target = center;
+        keys.push_back(key);
+    }
+}
+
+glm::mat4 QEBenchmarkCameraPath::Evaluate(float time) const
+{
+    if (keys.empty())
+        return glm::mat4(1.0f);
+
+    const float duration = GetDuration();
+    if (loop && duration > 0.0f)
+    {
+        time = std::fmod(time, duration);
+    }
+    time = std::clamp(time, keys.front().Time, keys.back().Time);
+
+    size_t segment = 0;
+    while (segment + 2 < keys.size() && keys[segment + 1].Time < time)
+    {
+        ++segment;
+    }
+
+    const size_t i1 = segment;
+    const size_t i2 = std::min(segment + 1, keys.size() - 1);
+    const size_t i0 = i1 > 0 ? i1 - 1 : i1;
+    const size_t i3 = std::min(i2 + 1, keys.size() - 1);
+
+    const float span = keys[i2].Time - keys[i1].Time;
+    const float t = span > 0.0f ? (time - keys[i1].Time) / span : 0.0f;
+
+    const glm::vec3 position = CatmullRom(keys[i0].Position, keys[i1].Position, keys[i2].Position, keys[i3].Position, t);
+    const glm::vec3 target = CatmullRom(keys[i0].Target, keys[i1].Target, keys[i2].Target, keys[i3].Target, t);
+
+    // Evita una vista degenerada si el objetivo cae encima de la camara o en la vertical
+    glm::vec3 forward = target - position;
+    if (glm::length(forward) < 1e-4f)
+        forward = glm::vec3(0.0f, 0.0f, -1.0f);
+    const glm::vec3 up = std::fabs(glm::normalize(forward).y) > 0.999f ? glm::vec3(0.0f, 0.0f, 1.0f) : glm::vec3(0.0f, 1.0f, 0.0f);
+
+    return glm::lookAt(position, position + forward, up);
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <filesystem>
+#include <vector>
+#include <glm/glm.hpp>
+
+struct QEBenchmarkCameraKey
+{
+    float Time = 0.0f;
+    glm::vec3 Position = glm::vec3(0.0f);
+    glm::vec3 Target = glm::vec3(0.0f, 0.0f, -1.0f);
+};
+
+/// Recorrido de camara del benchmark: keyframes (tiempo, posicion, objetivo) interpolados
+/// con Catmull-Rom. Formato YAML:
+///   Loop: true
+///   Keyframes:
+///     - { Time: 0.0, Position: [0, 2, 8], Target: [0, 0, 0] }
+class QEBenchmarkCameraPath
+{
+private:
+    std::vector<QEBenchmarkCameraKey> keys;
+    bool loop = false;
+
+public:
+    bool LoadFromFile(const std::filesystem::path& path);
+    /// Orbita alrededor de la caja de la escena que dura duration segundos.
+    void BuildOrbit(const glm::vec3& boundsMin, const glm::vec3& boundsMax, float duration, uint32_t keyCount = 16);
+
+    bool Empty() const { return keys.empty(); }
+    float GetDuration() const { return keys.empty() ? 0.0f : keys.back().Time; }
+
+    /// Vista (world -> camera) en el instante time.
+    glm::mat4 Evaluate(float time) const;
+};
@@ -0,0 +1,253 @@
+#include "QEBenchmarkApp.h"
+
+#include <QEProjectManager.h>
+#include <QEProjectModuleLoader.h>
+#include <QEShaderCompiler.h>
+#include <QEShaderVariantCache.h>
+#include <Logging/QELogMacros.h>
+
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <string>
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+namespace
+{
+    void PrintUsage()
+    {
+        std::cout
+            << "Usage: QuarantineBenchmark <projectPath> [options]\n"
+            << "       QuarantineBenchmark --compile-shaders <shaderFolder> [--force] [--workers <N>] [--project <projectPath>]\n"
+            << "  --scene <path>         Scene to load (default: project default scene)\n"
+            << "  --frames <N>           Measured frames (default: 600)\n"
+            << "  --warmup <N>           Frames discarded before measuring (default: 60)\n"
+            << "  --width <W>            Render width (default: 1280)\n"
+            << "  --height <H>           Render height (default: 720)\n"
+            << "  --delta <seconds>      Fixed simulation step per frame (default: 1/60)\n"
+            << "  --camera-path <file>   YAML camera keyframes (default: orbit around the scene)\n"
+            << "  --output <file.json>   Results file (default: benchmark_results.json)\n"
+            << "  --windowed             Render to a window instead of offscreen\n"
+            << "  --mesh-stats           Report ACMR/ATVR/overdraw of loaded meshes, current and optimized\n"
+            << "  --scene-load <N>       Decode the loaded scene N times as YAML and as binary .qescene\n"
+            << "  --scene-scale <N>      Load the scene with its meshes repeated N times, cold and warm\n"
+            << "  --raycast <N>          Cast N random rays at the scene through the BVH and report rays/s\n"
+            << "  --raycast-brute <N>    Rays of the raycast run repeated without BVH (default: 1000, 0 = skip)\n";
+    }
+
+    // Compila los jobs de <shaderFolder>/ShaderBuild.yaml y mide el build completo. Con --project
+    // anade las variantes de shader que usan los materiales del proyecto (ShaderVariants.yaml)
+    int RunShaderBuild(int argc, char** argv)
+    {
+        if (argc < 3)
+        {
+            PrintUsage();
+            return -1;
+        }
+
+        const std::filesystem::path shaderFolder = std::filesystem::absolute(argv[2]);
+        bool force = false;
+        uint32_t workers = 0;
+        std::filesystem::path projectPath;
+        for (int i = 3; i < argc; ++i)
+        {
+            const std::string arg = argv[i];
+            if (arg == "--force")
+            {
+                force = true;
+            }
+            else if (arg == "--workers" && (i + 1) < argc)
+            {
+                workers = static_cast<uint32_t>(std::stoul(argv[++i]));
+            }
+            else if (arg == "--project" && (i + 1) < argc)
+            {
+                projectPath = std::filesystem::absolute(argv[++i]);
+            }
+            else
+            {
+                PrintUsage();
+                return -1;
+            }
+        }
+
+        auto jobs = QE::QEShaderCompiler::LoadBuildManifest(shaderFolder);
+        if (!projectPath.empty())
+        {
+            const auto keywordSets = QE::QEShaderVariantCache::CollectProjectKeywords(projectPath);
+            const auto variantJobs = QE::QEShaderVariantCache::PrepareVariantBuild(shaderFolder, keywordSets);
+            jobs.insert(jobs.end(), variantJobs.begin(), variantJobs.end());
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        const auto results = QE::QEShaderCompiler::CompileBatch(jobs, nullptr, force, workers);
+        const double totalMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        size_t failed = 0;
+        for (size_t i = 0; i < results.size(); ++i)
+        {
+            const char* status = results[i].Status == QE::QEShaderCompileStatus::Compiled ? "compiled"
+                : results[i].Status == QE::QEShaderCompileStatus::UpToDate ? "up to date"
+                : "FAILED";
+            if (results[i].Status == QE::QEShaderCompileStatus::Failed)
+                ++failed;
+
+            std::cout << "  " << jobs[i].Output.lexically_relative(shaderFolder).generic_string()
+                << ": " << status << " (" << results[i].Milliseconds << " ms)\n";
+        }
+
+        std::cout << jobs.size() << " shaders in " << totalMs << " ms ("
+            << (QE::QEShaderCompiler::HasLibraryBackend() ? "shaderc" : "glslc") << ")\n";
+
+        return failed == 0 ? 0 : 1;
+    }
+
+    bool ParseArguments(int argc, char** argv, QEBenchmarkOptions& options)
+    {
+        if (argc < 2)
+            return false;
+
+        options.ProjectPath = argv[1];
+
+        for (int i = 2; i < argc; ++i)
+        {
+            const std::string arg = argv[i];
+            const bool hasValue = (i + 1) < argc;
+
+            if (arg == "--windowed")
+            {
+                options.Windowed = true;
+            }
+            else if (arg == "--mesh-stats")
+            {
+                options.MeshStats = true;
+            }
+            else if (!hasValue)
+            {
+                std::cerr << "Missing value for '" << arg << "'\n";
+                return false;
+            }
+            else if (arg == "--scene")          options.ScenePath = argv[++i];
+            else if (arg == "--frames")         options.Frames = static_cast<uint32_t>(std::stoul(argv[++i]));
+            else if (arg == "--warmup")         options.WarmupFrames = static_cast<uint32_t>(std::stoul(argv[++i]));
+            else if (arg == "--width")          options.Width = static_cast<uint32_t>(std::stoul(argv[++i]));
+            else if (arg == "--height")         options.Height = static_cast<uint32_t>(std::stoul(argv[++i]));
+            else if (arg == "--delta")          options.FrameDelta = std::stof(argv[++i]);
+            else if (arg == "--camera-path")    options.CameraPathFile = argv[++i];
+            else if (arg == "--output")         options.OutputPath = argv[++i];
+            else if (arg == "--scene-load")     options.SceneLoadIterations = static_cast<uint32_t>(std::stoul(argv[++i]));
+            else if (arg == "--scene-scale")    options.SceneScale = static_cast<uint32_t>(std::stoul(argv[++i]));
+            else if (arg == "--raycast")        options.RaycastRays = static_cast<uint32_t>(std::stoul(argv[++i]));
+            else if (arg == "--raycast-brute")  options.RaycastBruteForceRays = static_cast<uint32_t>(std::stoul(argv[++i]));
+            else
+            {
+                std::cerr << "Unknown option '" << arg << "'\n";
+                return false;
+            }
+        }
+
+        return options.Frames > 0 && options.Width > 0 && options.Height > 0 && options.FrameDelta > 0.0f;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    if (argc >= 2 && std::string(argv[1]) == "--compile-shaders")
+    {
+        try
+        {
+            return RunShaderBuild(argc, argv);
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << e.what() << '\n';
+            return -1;
+        }
+    }
+
+    QEBenchmarkOptions options;
+    try
+    {
+        if (!ParseArguments(argc, argv, options))
+        {
+            PrintUsage();
+            return -1;
+        }
+    }
+    catch (const std::exception&)
+    {
+        PrintUsage();
+        return -1;
+    }
+
+    // Rutas relativas respecto al directorio de invocacion, antes de cambiar el working directory
+    options.ProjectPath = std::filesystem::absolute(options.ProjectPath);
+    options.OutputPath = std::filesystem::absolute(options.OutputPath);
+    if (!options.ScenePath.empty())
+        options.ScenePath = std::filesystem::absolute(options.ScenePath);
+    if (!options.CameraPathFile.empty())
+        options.CameraPathFile = std::filesystem::absolute(options.CameraPathFile);
+
+#ifdef _WIN32
+    wchar_t pathBuf[MAX_PATH];
+    DWORD len = GetModuleFileNameW(nullptr, pathBuf, MAX_PATH);
+    if (len == 0 || len == MAX_PATH)
+    {
+        QE_LOG_ERROR_CAT("Execution", "Error resolving the path to the exe file");
+        return -1;
+    }
+
+    std::error_code ec;
+    std::filesystem::current_path(std::filesystem::path(pathBuf).parent_path(), ec);
+    if (ec)
+    {
+        QE_LOG_ERROR_CAT_F("Execution", "Could not switch the working directory: {}", ec.message());
+        return -1;
+    }
+#endif
+
+    if (!QE::QEProjectManager::SetCurrentProjectPath(options.ProjectPath))
+    {
+        QE_LOG_ERROR_CAT_F("Execution", "Could not open project '{}'", options.ProjectPath.string());
+        return -1;
+    }
+
+    std::string projectModuleLoadError;
+    const bool projectModuleLoaded = QE::QEProjectModuleLoader::LoadForProject(options.ProjectPath, &projectModuleLoadError);
+    if (!projectModuleLoaded && !projectModuleLoadError.empty())
+    {
+        QE_LOG_WARN_CAT_F("Execution", "{}", projectModuleLoadError);
+    }
+
+    QE::QEScene scene{};
+    const bool sceneLoaded = options.ScenePath.empty()
+        ? QE::QEProjectManager::InitializeDefaultQEScene(scene)
+        : QE::QEProjectManager::InitializeQEScene(scene, options.ScenePath);
+
+    if (!sceneLoaded)
+    {
+        QE_LOG_ERROR_CAT_F("Execution", "Could not initialize scene for project '{}'", options.ProjectPath.string());
+        if (projectModuleLoaded)
+        {
+            QE::QEProjectModuleLoader::Unload();
+        }
+        return -1;
+    }
+
+    bool succeeded = false;
+    {
+        QEBenchmarkApp app(options);
+        app.Run(scene);
+        succeeded = app.Succeeded();
+    }
+
+    if (projectModuleLoaded)
+    {
+        QE::QEProjectModuleLoader::Unload();
+    }
+
+    return succeeded ? 0 : 1;
+}
@@ -16,6 +16,7 @@ struct EditorContext
     bool ShowViewport = true;
     bool ShowConsole = true;
     bool ShowContentBrowser = true;
+    bool ShowRenderStats = false;
     bool ShowEditorGrid = true;
     bool ShowColliderDebug = false;
     bool ShowCullingAABBDebug = false;
@@ -30,6 +30,7 @@
 #include "Panels/MaterialEditorPanel.h"
 #include "Panels/ShaderEditorPanel.h"
 #include "Panels/QETextureViewerPanel.h"
+#include "Panels/RenderStatsPanel.h"
 #include "Rendering/EditorViewportResources.h"
 #include "Runtime/QEEditorRuntimeBridge.h"
 #include <QEProjectManager.h>
@@ -468,6 +469,9 @@ void QEEditorApp::CreatePanels()
         editorContext.get(),
         editorConsole.get()));
 
+    panels.emplace_back(std::make_unique<RenderStatsPanel>(
+        editorContext.get()));
+
     auto viewportPanelLocal = std::make_unique<ViewportPanel>(
         editorContext.get(),
         viewportResources.get(),
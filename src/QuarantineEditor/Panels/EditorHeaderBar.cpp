@@ -90,6 +90,7 @@ void EditorHeaderBar::DrawWindowMenu()
         ImGui::MenuItem("Viewport", nullptr, &editorContext->ShowViewport);
         ImGui::MenuItem("Console", nullptr, &editorContext->ShowConsole);
         ImGui::MenuItem("Content Browser", nullptr, &editorContext->ShowContentBrowser);
+        ImGui::MenuItem("Render Stats", nullptr, &editorContext->ShowRenderStats);
         ImGui::EndMenu();
     }
 }
@@ -869,7 +869,7 @@ void InspectorPanel::Draw()
     bool isActive = gameObject->QEActive;
     if (ImGui::Checkbox("Active", &isActive))
     {
-        gameObject->QEActive = isActive;
+        gameObject->SetActive(isActive);
     }
 
     if (!gameObject->IsActiveInHierarchy() && gameObject->QEActive)
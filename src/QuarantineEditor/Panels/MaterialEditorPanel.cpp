@@ -219,7 +219,7 @@ void MaterialEditorPanel::Draw()
 void MaterialEditorPanel::DrawToolbar()
 {
     ImGui::Text("Material: %s", _material->Name.c_str());
-    ImGui::Text("Shader: %s", _material->shader ? _material->shader->shaderNameID.c_str() : "None");
+    ImGui::Text("Shader: %s", _material->GetBaseShader() ? _material->GetBaseShader()->shaderNameID.c_str() : "None");
 
     const std::string shaderAssetLabel = _material->GetShaderAssetPath().empty()
         ? "Legacy runtime shader"
@@ -143,7 +143,7 @@ void MaterialInspectorPanel::DrawMaterialEntry(
 
     ImGui::PushID(materialIndex);
 
-    const std::string shaderName = material->shader ? material->shader->shaderNameID : "None";
+    const std::string shaderName = material->GetBaseShader() ? material->GetBaseShader()->shaderNameID : "None";
     const bool useCopy = gameObject->IsMaterialUsingCopy(static_cast<size_t>(materialIndex));
     const auto& bindings = gameObject->GetMaterialBindings();
     const std::string sourceName =
@@ -0,0 +1,207 @@
+#include "RenderStatsPanel.h"
+
+#include <imgui.h>
+
+#include <QuarantineEditor/Core/EditorContext.h>
+#include <ShadowAtlasManager.h>
+#include <ShadowCacheManager.h>
+#include <ShadowCasterCulling.h>
+#include <LightManager.h>
+#include <QEOcclusionCulling.h>
+#include <QEMeshletCulling.h>
+
+RenderStatsPanel::RenderStatsPanel(EditorContext* editorContext)
+    : _editorContext(editorContext)
+{
+}
+
+void RenderStatsPanel::Draw()
+{
+    if (!_editorContext || !_editorContext->ShowRenderStats)
+        return;
+
+    if (!ImGui::Begin("Render Stats", &_editorContext->ShowRenderStats))
+    {
+        ImGui::End();
+        return;
+    }
+
+    ImGui::Text("FPS: %.1f (%.2f ms)", ImGui::GetIO().Framerate, 1000.0f / ImGui::GetIO().Framerate);
+
+    DrawShadowCacheSection();
+    DrawShadowAtlasSection();
+    DrawOcclusionSection();
+    DrawMeshletSection();
+    DrawRaycastSection();
+
+    ImGui::End();
+}
+
+void RenderStatsPanel::DrawShadowCacheSection()
+{
+    if (!ImGui::CollapsingHeader("Shadows", ImGuiTreeNodeFlags_DefaultOpen))
+        return;
+
+    auto* shadowCacheManager = ShadowCacheManager::getInstance();
+    const ShadowCacheFrameStats& stats = shadowCacheManager->GetFrameStats();
+
+    ImGui::Checkbox("Shadow caching", &shadowCacheManager->Enabled);
+    ImGui::SameLine();
+    ImGui::Checkbox("Static layer", &shadowCacheManager->StaticLayerEnabled);
+
+    int softBudget = static_cast<int>(shadowCacheManager->MaxSoftViewUpdatesPerFrame);
+    if (ImGui::SliderInt("Views per frame", &softBudget, 1, 32))
+    {
+        shadowCacheManager->MaxSoftViewUpdatesPerFrame = static_cast<uint32_t>(softBudget);
+    }
+
+    int alwaysUpdated = static_cast<int>(shadowCacheManager->AlwaysUpdatedCascades);
+    if (ImGui::SliderInt("Always updated cascades", &alwaysUpdated, 0, static_cast<int>(SHADOW_MAP_CASCADE_COUNT)))
+    {
+        shadowCacheManager->AlwaysUpdatedCascades = static_cast<uint32_t>(alwaysUpdated);
+    }
+
+    ImGui::Separator();
+
+    if (ImGui::BeginTable("ShadowCacheStats", 2, ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersInnerV))
+    {
+        auto row = [](const char* label, uint64_t value)
+            {
+                ImGui::TableNextRow();
+                ImGui::TableSetColumnIndex(0);
+                ImGui::TextUnformatted(label);
+                ImGui::TableSetColumnIndex(1);
+                ImGui::Text("%llu", static_cast<unsigned long long>(value));
+            };
+
+        row("Shadow views", stats.TotalViews);
+        row("Rendered", stats.RenderedViews);
+        row("Skipped (cached)", stats.SkippedViews);
+        row("Deferred (budget)", stats.DeferredViews);
+        row("Static layer rebuilds", stats.StaticLayerRebuilds);
+        row("Static casters", stats.StaticCasters);
+        row("Dynamic casters", stats.DynamicCasters);
+        row("Static cache (MB)", stats.StaticCacheBytes / (1024ull * 1024ull));
+
+        ImGui::EndTable();
+    }
+
+    auto* casterCulling = ShadowCasterCulling::getInstance();
+    const ShadowCullingFrameStats& cullingStats = casterCulling->GetFrameStats();
+
+    ImGui::Checkbox("Per-view caster culling", &casterCulling->Enabled);
+    ImGui::Text("Casters drawn: %u  culled: %u", cullingStats.VisibleCasters, cullingStats.CulledCasters);
+}
+
+void RenderStatsPanel::DrawShadowAtlasSection()
+{
+    if (!ImGui::CollapsingHeader("Shadow Atlas", ImGuiTreeNodeFlags_DefaultOpen))
+        return;
+
+    const ShadowAtlasFrameStats& stats = ShadowAtlasManager::getInstance()->GetFrameStats();
+
+    ImGui::Text("Spot atlas: %u tiles (%.0f%%)", stats.SpotTiles, stats.SpotUsage * 100.0f);
+    ImGui::Text("Point atlas: %u tiles (%.0f%%)", stats.PointTiles, stats.PointUsage * 100.0f);
+    ImGui::Text("Atlas memory: %.1f MB", static_cast<double>(stats.AtlasBytes) / (1024.0 * 1024.0));
+    ImGui::Text("Reallocations: %u  Repacks: %u", stats.Reallocations, stats.Repacks);
+    ImGui::Text("Unshadowed lights: %u", stats.UnshadowedLights);
+
+    auto* lightManager = LightManager::getInstance();
+    const bool layeredAvailable = lightManager->GetOmniShadowLayeredPipelineModule() != nullptr;
+
+    ImGui::BeginDisabled(!layeredAvailable);
+    ImGui::Checkbox("Single-pass point shadows", &lightManager->UseLayeredPointShadows);
+    ImGui::EndDisabled();
+    if (!layeredAvailable)
+    {
+        ImGui::TextDisabled("Requires VK_EXT_shader_viewport_index_layer");
+    }
+}
+
+void RenderStatsPanel::DrawOcclusionSection()
+{
+    if (!ImGui::CollapsingHeader("Occlusion Culling", ImGuiTreeNodeFlags_DefaultOpen))
+        return;
+
+    auto* occlusionCulling = QEOcclusionCulling::getInstance();
+    const QEOcclusionFrameStats& stats = occlusionCulling->GetFrameStats();
+
+    ImGui::Checkbox("Occlusion culling", &occlusionCulling->Enabled);
+
+    int occluderBudget = static_cast<int>(occlusionCulling->MaxOccluderTriangles);
+    if (ImGui::SliderInt("Occluder triangles", &occluderBudget, 1000, 1000000))
+    {
+        occlusionCulling->MaxOccluderTriangles = static_cast<uint32_t>(occluderBudget);
+    }
+
+    ImGui::Text("Instances culled: %u / %u", stats.CulledInstances, stats.TestedInstances);
+    ImGui::Text("Triangles culled: %llu / %llu",
+        static_cast<unsigned long long>(stats.CulledTriangles),
+        static_cast<unsigned long long>(stats.TestedTriangles));
+    ImGui::Text("Occluders: %u (%llu tris)",
+        stats.Occluders,
+        static_cast<unsigned long long>(stats.OccluderTriangles));
+    ImGui::Text("Phase 1: %u (hidden next frame: %u)  Phase 2: %u (recovered: %u)",
+        stats.Phase1Instances,
+        stats.HiddenNextFrame,
+        stats.Phase2Instances,
+        stats.Phase2Recovered);
+    ImGui::Text("CPU: %.2f ms", stats.CullMs);
+}
+
+void RenderStatsPanel::DrawMeshletSection()
+{
+    if (!ImGui::CollapsingHeader("Meshlet Culling"))
+        return;
+
+    auto* meshletCulling = QEMeshletCulling::getInstance();
+    const QEMeshletFrameStats& stats = meshletCulling->GetFrameStats();
+
+    ImGui::Checkbox("Frustum", &meshletCulling->FrustumCulling);
+    ImGui::SameLine();
+    ImGui::Checkbox("Cone", &meshletCulling->ConeCulling);
+    ImGui::SameLine();
+    ImGui::Checkbox("Hi-Z", &meshletCulling->HiZCulling);
+
+    ImGui::Checkbox("LOD selection", &meshletCulling->LodSelection);
+    ImGui::SliderFloat("LOD error (px)", &meshletCulling->LodErrorPixels, 0.25f, 8.0f, "%.2f");
+    ImGui::Checkbox("CPU validation", &meshletCulling->CpuValidation);
+
+    ImGui::Text("Instances: %u  Meshlets: %u", stats.Instances, stats.SelectedMeshlets);
+    ImGui::Text("LOD 0/1/2/3: %u / %u / %u / %u",
+        stats.LodHistogram[0], stats.LodHistogram[1], stats.LodHistogram[2], stats.LodHistogram[3]);
+    ImGui::Text("GPU culled: frustum %u  cone %u  hi-z %u / %u",
+        stats.Gpu.FrustumCulled, stats.Gpu.ConeCulled, stats.Gpu.HiZCulled, stats.Gpu.Tested);
+
+    if (meshletCulling->CpuValidation)
+    {
+        ImGui::Text("CPU culled: frustum %u  cone %u  hi-z %u / %u",
+            stats.Cpu.FrustumCulled, stats.Cpu.ConeCulled, stats.Cpu.HiZCulled, stats.Cpu.Tested);
+        ImGui::Text("CPU/GPU mismatches: %u", stats.CpuGpuMismatches);
+    }
+}
+
+void RenderStatsPanel::DrawRaycastSection()
+{
+    if (!ImGui::CollapsingHeader("Raycasts"))
+        return;
+
+    auto* raycastSystem = QERaycastSystem::getInstance();
+
+    ImGui::Text("Scene entries: %u  Top BVH: %.1f KB",
+        raycastSystem->GetSceneEntryCount(),
+        static_cast<double>(raycastSystem->GetSceneBVHMemorySize()) / 1024.0);
+
+    if (ImGui::Button("Run raycast benchmark"))
+    {
+        _raycastBenchmark = raycastSystem->RunBenchmark(100000, 1000);
+    }
+
+    if (_raycastBenchmark.Rays == 0)
+        return;
+
+    ImGui::Text("Rays: %u  Hits: %u", _raycastBenchmark.Rays, _raycastBenchmark.Hits);
+    ImGui::Text("BVH: %.0f rays/s", _raycastBenchmark.BVHRaysPerSecond);
+    ImGui::Text("Brute force: %.0f rays/s", _raycastBenchmark.BruteForceRaysPerSecond);
+    ImGui::Text("Mismatched hits: %u", _raycastBenchmark.MismatchedHits);
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "IEditorPanel.h"
+#include <QERaycastSystem.h>
+
+class EditorContext;
+
+class RenderStatsPanel : public IEditorPanel
+{
+public:
+    explicit RenderStatsPanel(EditorContext* editorContext);
+
+    void Draw() override;
+    const char* GetName() const override { return "Render Stats"; }
+
+private:
+    void DrawShadowCacheSection();
+    void DrawShadowAtlasSection();
+    void DrawOcclusionSection();
+    void DrawMeshletSection();
+    void DrawRaycastSection();
+
+private:
+    EditorContext* _editorContext = nullptr;
+    QERaycastBenchmarkResult _raycastBenchmark{};
+};
@@ -109,6 +109,7 @@ void EditorViewportResources::CleanupImages()
     {
         vkDestroyImage(deviceModule->device, resolveImage, nullptr);
         resolveImage = VK_NULL_HANDLE;
+        renderTarget.ColorImage = VK_NULL_HANDLE;
     }
 
     if (resolveMemory != VK_NULL_HANDLE)
@@ -252,6 +253,7 @@ void EditorViewportResources::CreateImages()
             VK_SAMPLE_COUNT_1_BIT);
 
         resolveImage = resolveTexture.image;
+        renderTarget.ColorImage = resolveImage;
         resolveMemory = resolveTexture.deviceMemory;
         resolveTexture.image = VK_NULL_HANDLE;
         resolveTexture.deviceMemory = VK_NULL_HANDLE;
@@ -160,6 +160,7 @@ void MaterialPreviewRenderer::SetMaterial(const std::shared_ptr<QEMaterial>& mat
         dto.UpdateTexturePaths(resolvedMaterialPath.parent_path());
 
         _previewMaterial = std::make_shared<QEMaterial>(_material->shader, dto);
+        _previewMaterial->UsePrivateDescriptor();
 
         if (_previewMaterial->descriptor)
         {
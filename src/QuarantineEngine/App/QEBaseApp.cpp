@@ -15,6 +15,13 @@
 #include <OmniShadowResources.h>
 #include <QERuntimeMode.h>
 #include <CullingSceneManager.h>
+#include <QEMeshletCulling.h>
+#include <chrono>
+#include <QEDeferredDeletionQueue.h>
+#include <QETextureStreamer.h>
+#include <QEBindlessMaterials.h>
+#include <QEShaderVariantCache.h>
+#include <QEKtxTranscodeCache.h>
 
 QEBaseApp::QEBaseApp()
 {
@@ -33,6 +40,8 @@ QEBaseApp::QEBaseApp()
 void QEBaseApp::Run(QEScene scene)
 {
     this->scene = scene;
+    this->runStart = std::chrono::steady_clock::now();
+    this->timeToFirstFrameMs = 0.0;
 
     InitWindow();
     initVulkan();
@@ -45,21 +54,42 @@ void QEBaseApp::Run(QEScene scene)
     cleanUp();
 }
 
+void QEBaseApp::SetHeadless(uint32_t width, uint32_t height)
+{
+    this->headless = true;
+    this->headlessExtent = { width, height };
+}
+
 void QEBaseApp::InitWindow()
 {
     this->mainWindow = GUIWindow::getInstance();
+
+    if (this->headless)
+    {
+        if (!this->mainWindow->initHeadless(static_cast<int>(headlessExtent.width), static_cast<int>(headlessExtent.height)))
+            throw std::runtime_error("failed to initialize headless window!");
+        return;
+    }
+
     this->mainWindow->init();
 }
 
 void QEBaseApp::initVulkan()
 {
     vulkanInstance.debug_level = DEBUG_LEVEL::ONLY_ERROR;
-    vulkanInstance.createInstance();
+    vulkanInstance.createInstance(this->headless);
     layerExtensionModule.setupDebugMessenger(vulkanInstance.getInstance(), vulkanInstance.debug_level);
-    windowSurface.createSurface(vulkanInstance.getInstance(), mainWindow->getWindow());
+    if (!this->headless)
+    {
+        windowSurface.createSurface(vulkanInstance.getInstance(), mainWindow->getWindow());
+    }
     deviceModule->pickPhysicalDevice(vulkanInstance.getInstance(), windowSurface.getSurface());
     deviceModule->createLogicalDevice(windowSurface.getSurface(), *queueModule);
 
+    this->deletionQueue = QEDeferredDeletionQueue::getInstance();
+    this->deletionQueue->Initialize(deviceModule->device, MAX_FRAMES_IN_FLIGHT);
+    this->deletionQueue->ValidationEnabled = enableValidationLayers;
+
     //Inicializamos el CommandPool Module
     commandPoolModule = CommandPoolModule::getInstance();
     commandPoolModule->ClearColor = glm::vec3(0.0f);
@@ -67,12 +97,22 @@ void QEBaseApp::initVulkan()
     //Inicializamos el Swapchain Module
     swapchainModule = SwapChainModule::getInstance();
     swapchainModule->InitializeScreenDataResources();
-    swapchainModule->createSwapChain(windowSurface.getSurface(), mainWindow->getWindow());
+    if (this->headless)
+    {
+        swapchainModule->CreateHeadless(this->headlessExtent, VK_FORMAT_B8G8R8A8_SRGB);
+    }
+    else
+    {
+        swapchainModule->createSwapChain(windowSurface.getSurface(), mainWindow->getWindow());
+    }
 
     //Creamos el Command pool module y los Command buffers
     commandPoolModule->createCommandPool(windowSurface.getSurface());
     commandPoolModule->createCommandBuffers();
 
+    this->gpuProfiler = QEGpuProfiler::getInstance();
+    this->gpuProfiler->Initialize(deviceModule, MAX_FRAMES_IN_FLIGHT);
+
     //Creamos el antialiasing module
     antialiasingModule = AntiAliasingModule::getInstance();
     antialiasingModule->createColorResources();
@@ -85,9 +125,6 @@ void QEBaseApp::initVulkan()
     renderPassModule = RenderPassModule::getInstance();
     renderPassModule->CreateRenderPass(swapchainModule->swapChainImageFormat, depthBufferModule->findDepthFormat(), *antialiasingModule->msaaSamples);
     renderPassModule->CreateDirShadowRenderPass(CSMResources::GetSupportedShadowFormat(deviceModule));
-    renderPassModule->CreateOmniShadowRenderPass(
-        OmniShadowResources::GetSupportedColorFormat(deviceModule),
-        OmniShadowResources::GetSupportedDepthFormat(deviceModule));
 
     renderPassModule->CreateViewportRenderPass(
         swapchainModule->swapChainImageFormat,
@@ -97,8 +134,12 @@ void QEBaseApp::initVulkan()
     //Registramos el default render pass
     this->graphicsPipelineManager->RegisterDefaultRenderPass(renderPassModule->DefaultRenderPass);
 
-    //Creamos el frame buffer
+    //Creamos el frame buffer (en headless no hay imagenes de swapchain: el destino es offscreen)
     framebufferModule.createFramebuffer(renderPassModule->DefaultRenderPass);
+    if (this->headless)
+    {
+        offscreenTarget.Create(deviceModule, renderPassModule, headlessExtent.width, headlessExtent.height);
+    }
 
     BufferManageModule::commandPool = this->commandPoolModule->getCommandPool();
     BufferManageModule::computeCommandPool = this->commandPoolModule->getComputeCommandPool();
@@ -107,13 +148,15 @@ void QEBaseApp::initVulkan()
     QEGeometryComponent::deviceModule_ptr = this->deviceModule;
     TextureManagerModule::queueModule = this->queueModule;
     CustomTexture::commandPool = commandPoolModule->getCommandPool();
-    OmniShadowResources::commandPool = commandPoolModule->getCommandPool();
     CSMResources::commandPool = commandPoolModule->getCommandPool();
-    OmniShadowResources::queueModule = this->queueModule;
     CSMResources::queueModule = this->queueModule;
 
     // INIT ------------------------- Managers -------------------------------
     this->cameraContext = QECameraContext::getInstance();
+    if (this->headless)
+    {
+        this->cameraContext->SetRenderTargetOverride(&offscreenTarget.GetRenderTarget());
+    }
     QERuntimeMode::getInstance()->SetGameplayEnabled(true);
 
     if (auto cullingSceneManager = CullingSceneManager::getInstance())
@@ -123,6 +166,8 @@ void QEBaseApp::initVulkan()
 
     this->shaderManager = ShaderManager::getInstance();
     this->textureManager = TextureManager::getInstance();
+    QETextureStreamer::getInstance()->Initialize();
+    QEBindlessMaterials::getInstance()->Initialize();
     this->lightManager = LightManager::getInstance();
     this->materialManager = MaterialManager::getInstance();
     this->materialManager->InitializeMaterialManager();
@@ -144,7 +189,10 @@ void QEBaseApp::initVulkan()
 
 void QEBaseApp::loadScene(QEScene& scene)
 {
-    scene.DeserializeScene();
+    scene.DeserializeScene([this](float progress, const std::string& stage, const std::string& message)
+        {
+            OnSceneLoadProgress(progress, stage, message);
+        });
     physicsModule->SetGravity(scene.physicsGravity);
 
     OnBeforeSceneActivated();
@@ -161,8 +209,10 @@ void QEBaseApp::loadScene(QEScene& scene)
 
     lightManager->AddDirShadowMapShader(materialManager->GetCSMShader());
     lightManager->AddOmniShadowMapShader(materialManager->GetOmniShadowMappingShader());
+    lightManager->AddOmniShadowLayeredShader(materialManager->GetOmniShadowLayeredShader());
 
     gameObjectManager->StartQEGameObjects();
+    scene.ReleasePreloadedGeometry();
 
     atmosphereSystem = AtmosphereSystem::getInstance();
     atmosphereSystem->LoadAtmosphereDto(scene.atmosphereDto);
@@ -176,6 +226,7 @@ bool QEBaseApp::LoadSceneFromPath(const std::filesystem::path& scenePath)
     }
 
     vkDeviceWaitIdle(deviceModule->device);
+    this->deletionQueue->OnDeviceIdle();
 
     UnloadCurrentScene();
 
@@ -249,8 +300,16 @@ void QEBaseApp::OnMainViewportResized(uint32_t width, uint32_t height)
 
 void QEBaseApp::mainLoop()
 {
-    while (!glfwWindowShouldClose(mainWindow->getWindow()))
+    using Clock = std::chrono::high_resolution_clock;
+    auto elapsedMs = [](Clock::time_point from, Clock::time_point to)
+        {
+            return std::chrono::duration<double, std::milli>(to - from).count();
+        };
+
+    while (!this->closeRequested && (this->headless || !glfwWindowShouldClose(mainWindow->getWindow())))
     {
+        const auto frameStart = Clock::now();
+
         glfwPollEvents();
 
         OnFrameStart();
@@ -258,6 +317,16 @@ void QEBaseApp::mainLoop()
         Timer::getInstance()->UpdateDeltaTime();
         uint32_t currentFrame = (uint32_t)synchronizationModule.GetCurrentFrame();
 
+        // El slot se espera antes de que update escriba sus UBOs; la CPU sigue hasta
+        // MAX_FRAMES_IN_FLIGHT - 1 frames por delante de la GPU.
+        synchronizationModule.waitForFrameSlot();
+        this->gpuProfiler->CollectFrame(currentFrame);
+
+        // Texturas subidas -> descriptores del material; el grafico espera (ya alcanzado) a esas copias
+        auto textureStreamer = QETextureStreamer::getInstance();
+        textureStreamer->Update();
+        synchronizationModule.setTransferWait(textureStreamer->GetTimeline(), textureStreamer->GetCompletedValue());
+
         this->debugSystem->ClearLines();
 
         // Start GameObjects
@@ -267,9 +336,11 @@ void QEBaseApp::mainLoop()
         OnBeginFrame();
 
         // PHYSICS
+        const auto physicsStart = Clock::now();
         int physicsSteps = Timer::getInstance()->ComputeFixedSteps();
-        for (int i = 0; i < physicsSteps; ++i)
-            physicsModule->ComputePhysics(Timer::getInstance()->FixedDelta);
+        physicsModule->ComputeFixedSteps(physicsSteps, Timer::getInstance()->FixedDelta);
+        physicsModule->ApplyInterpolatedTransforms(Timer::RenderAlpha);
+        const auto physicsEnd = Clock::now();
 
         // UPDATE GameObjects after UI/input so editor controllers consume fresh ImGui state.
         this->gameObjectManager->UpdateQEGameObjects();
@@ -297,11 +368,32 @@ void QEBaseApp::mainLoop()
         // UPDATE DEBUG BUFFERS
         this->debugSystem->UpdateGraphicBuffers();
 
+        const auto renderStart = Clock::now();
         this->computeFrame(currentFrame);
         this->drawFrame(currentFrame);
+        const auto frameEnd = Clock::now();
+
+        if (this->timeToFirstFrameMs == 0.0)
+        {
+            this->timeToFirstFrameMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - this->runStart).count();
+
+            // Con streaming el resumen sale cuando termina la tanda de texturas
+            if (!QETextureStreamer::getInstance()->IsStreamingEnabled())
+            {
+                QEKtxTranscodeCache::LogStats();
+            }
+        }
+
+        this->lastFrameTimings.FrameMs = elapsedMs(frameStart, frameEnd);
+        this->lastFrameTimings.PhysicsMs = elapsedMs(physicsStart, physicsEnd);
+        this->lastFrameTimings.UpdateMs = elapsedMs(frameStart, renderStart) - this->lastFrameTimings.PhysicsMs;
+        this->lastFrameTimings.RenderCpuMs = elapsedMs(renderStart, frameEnd);
+        this->lastFrameTimings.GpuMs = this->gpuProfiler->GetLastGpuFrameMs();
+        this->lastFrameTimings.ComputeGpuMs = this->gpuProfiler->GetLastQueueBusyMs(QEGpuQueue::Compute);
     }
 
     vkDeviceWaitIdle(deviceModule->device);
+    this->deletionQueue->OnDeviceIdle();
 }
 
 void QEBaseApp::cleanUp()
@@ -327,15 +419,30 @@ void QEBaseApp::cleanUp()
         cullingSceneManager->ResetSceneState();
     }
     this->debugSystem->Cleanup();
+    QEMeshletCulling::getInstance()->Cleanup();
+    QEMeshletCulling::ResetInstance();
 
     this->lightManager->CleanShadowMapResources();
+    this->synchronizationModule.setTransferWait(VK_NULL_HANDLE, 0);
+    QETextureStreamer::getInstance()->Cleanup();
+    QETextureStreamer::ResetInstance();
     this->textureManager->Clean();
 
     this->shaderManager->CleanDescriptorSetLayouts();
+    QEBindlessMaterials::getInstance()->Cleanup();
+    QEBindlessMaterials::ResetInstance();
+
+    this->offscreenTarget.Cleanup();
+    this->gpuProfiler->Cleanup();
+    this->gpuProfiler->ResetInstance();
+    this->gpuProfiler = nullptr;
 
     this->synchronizationModule.cleanup();
     this->commandPoolModule->cleanup();
 
+    this->deletionQueue->Shutdown();
+    this->deletionQueue = nullptr;
+
     this->deviceModule->cleanup();
 
     if (enableValidationLayers)
@@ -343,7 +450,10 @@ void QEBaseApp::cleanUp()
         this->layerExtensionModule.DestroyDebugUtilsMessengerEXT(vulkanInstance.getInstance(), nullptr);
     }
 
-    this->windowSurface.cleanUp(vulkanInstance.getInstance());
+    if (!this->headless)
+    {
+        this->windowSurface.cleanUp(vulkanInstance.getInstance());
+    }
     this->vulkanInstance.destroyInstance();
 
     glfwDestroyWindow(mainWindow->getWindow());
@@ -407,6 +517,7 @@ void QEBaseApp::cleanManagers()
     this->materialManager->CleanLastResources();
     this->materialManager->ResetInstance();
     this->materialManager = nullptr;
+    QEShaderVariantCache::ResetInstance();
 
     this->shaderManager->CleanLastResources();
     this->shaderManager->ResetInstance();
@@ -454,23 +565,31 @@ void QEBaseApp::computeFrame(uint32_t currentFrame)
 {
     if (this->isRender)
     {
-        synchronizationModule.synchronizeWaitComputeFences();
+        synchronizationModule.waitForComputeSlot();
 
         this->cameraContext->UpdateActiveCameraGPUData(currentFrame);
 
         this->particleSystemManager->UpdateParticleSystems();
 
+        // Se consulta antes de grabar: DispatchCommandBuffer limpia el flag Compute
+        const bool waitPreviousGraphics = this->computeNodeManager->HasPendingOnDemandWork();
+
         commandPoolModule->recordComputeCommandBuffer(
             commandPoolModule->getComputeCommandBuffer(currentFrame));
 
         synchronizationModule.submitComputeCommandBuffer(
-            commandPoolModule->getComputeCommandBuffer(currentFrame));
+            commandPoolModule->getComputeCommandBuffer(currentFrame),
+            waitPreviousGraphics);
     }
 }
 
 void QEBaseApp::drawFrame(uint32_t currentFrame)
 {
-    synchronizationModule.synchronizeWaitFences();
+    if (this->headless)
+    {
+        this->drawHeadlessFrame(currentFrame);
+        return;
+    }
 
     VkResult result = vkAcquireNextImageKHR(
         deviceModule->device,
@@ -483,7 +602,7 @@ void QEBaseApp::drawFrame(uint32_t currentFrame)
     resizeSwapchain(result, ERROR_RESIZE::SWAPCHAIN_ERROR);
 
     this->cameraContext->UpdateActiveCameraGPUData(currentFrame);
-    this->materialManager->UpdateUniforms();
+    this->materialManager->UpdateUniforms(currentFrame);
 
     commandPoolModule->Render(
         &framebufferModule,
@@ -498,8 +617,7 @@ void QEBaseApp::drawFrame(uint32_t currentFrame)
         });
 
     synchronizationModule.submitCommandBuffer(
-        commandPoolModule->getCommandBuffer(currentFrame),
-        this->isRender);
+        commandPoolModule->getCommandBuffer(currentFrame));
 
     result = synchronizationModule.presentSwapchain(
         swapchainModule->getSwapchain(),
@@ -509,6 +627,30 @@ void QEBaseApp::drawFrame(uint32_t currentFrame)
     this->isRender = true;
 }
 
+void QEBaseApp::drawHeadlessFrame(uint32_t currentFrame)
+{
+    this->cameraContext->UpdateActiveCameraGPUData(currentFrame);
+    this->materialManager->UpdateUniforms(currentFrame);
+
+    commandPoolModule->Render(
+        nullptr,
+        &offscreenTarget.GetRenderTarget(),
+        [this](VkCommandBuffer& commandBuffer, uint32_t currentFrame)
+        {
+            RecordAdditionalScenePass(commandBuffer, currentFrame);
+        },
+        [this](VkCommandBuffer& commandBuffer, uint32_t currentFrame)
+        {
+            RecordAdditionalOverlayPass(commandBuffer, currentFrame);
+        });
+
+    synchronizationModule.submitHeadlessCommandBuffer(
+        commandPoolModule->getCommandBuffer(currentFrame));
+
+    synchronizationModule.advanceFrame();
+    this->isRender = true;
+}
+
 void QEBaseApp::resizeSwapchain(VkResult result, ERROR_RESIZE errorResize)
 {
     if (errorResize == ERROR_RESIZE::SWAPCHAIN_ERROR)
@@ -541,6 +683,7 @@ void QEBaseApp::recreateSwapchain()
     mainWindow->checkMinimize();
 
     vkDeviceWaitIdle(deviceModule->device);
+    this->deletionQueue->OnDeviceIdle();
 
     cleanUpSwapchain();
     swapchainModule->createSwapChain(windowSurface.getSurface(), mainWindow->getWindow());
@@ -560,9 +703,6 @@ void QEBaseApp::recreateSwapchain()
         *antialiasingModule->msaaSamples);
 
     renderPassModule->CreateDirShadowRenderPass(CSMResources::GetSupportedShadowFormat(deviceModule));
-    renderPassModule->CreateOmniShadowRenderPass(
-        OmniShadowResources::GetSupportedColorFormat(deviceModule),
-        OmniShadowResources::GetSupportedDepthFormat(deviceModule));
     renderPassModule->CreateViewportRenderPass(
         swapchainModule->swapChainImageFormat,
         depthBufferModule->findDepthFormat(),
@@ -4,6 +4,7 @@
 #define GLFW_INCLUDE_VULKAN
 
 #include <windows.h>
+#include <chrono>
 #include <memory>
 #include <GLFW/glfw3.h>
 #include <vulkan/vulkan.hpp>
@@ -52,6 +53,9 @@
 #include <QEScene.h>
 #include <QECameraContext.h>
 #include <CullingSceneManager.h>
+#include <QEOffscreenRenderTarget.h>
+#include <QEGpuProfiler.h>
+#include <QEDeferredDeletionQueue.h>
 
 enum class ERROR_RESIZE
 {
@@ -61,6 +65,19 @@ enum class ERROR_RESIZE
 
 class QERenderTarget;
 
+/// Tiempos del ultimo frame en milisegundos. GpuMs (cola grafica) y ComputeGpuMs (cola de compute)
+/// corresponden al frame que reutilizo este slot (MAX_FRAMES_IN_FLIGHT frames antes) porque se leen
+/// sin bloquear tras esperarlo.
+struct QEFrameTimings
+{
+    double FrameMs = 0.0;
+    double UpdateMs = 0.0;
+    double PhysicsMs = 0.0;
+    double RenderCpuMs = 0.0;
+    double GpuMs = 0.0;
+    double ComputeGpuMs = 0.0;
+};
+
 class QEBaseApp
 {
 public:
@@ -69,6 +86,12 @@ public:
 
     void Run(QEScene scene);
 
+    /// Renderiza a un destino offscreen sin superficie ni swapchain. Llamar antes de Run.
+    void SetHeadless(uint32_t width, uint32_t height);
+    bool IsHeadless() const { return headless; }
+    /// Termina el bucle principal al acabar el frame actual.
+    void RequestClose() { closeRequested = true; }
+
 protected:
     virtual void OnInitialize() {}
     virtual void OnShutdown() {}
@@ -80,6 +103,8 @@ protected:
     virtual void OnPreCleanup() {}
     virtual void OnSwapchainRecreated() {}
     virtual void OnBeforeSceneActivated() {}
+    /// Progreso de QESceneLoader durante la carga de la escena (hilo principal).
+    virtual void OnSceneLoadProgress(float, const std::string&, const std::string&) {}
     virtual void OnMainViewportResized(uint32_t width, uint32_t height);
     virtual void RecordAdditionalScenePass(VkCommandBuffer&, uint32_t) {}
     virtual void RecordAdditionalOverlayPass(VkCommandBuffer&, uint32_t) {}
@@ -88,6 +113,10 @@ protected:
     void UnloadCurrentScene();
     void LoadCurrentScene();
 
+    const QEFrameTimings& GetLastFrameTimings() const { return lastFrameTimings; }
+    /// Desde Run() hasta terminar de enviar el primer frame (las texturas pueden seguir en streaming).
+    double GetTimeToFirstFrameMs() const { return timeToFirstFrameMs; }
+
 private:
     void InitWindow();
     void initVulkan();
@@ -95,6 +124,7 @@ private:
     void mainLoop();
     void computeFrame(uint32_t currentFrame);
     void drawFrame(uint32_t currentFrame);
+    void drawHeadlessFrame(uint32_t currentFrame);
     void cleanUp();
     void cleanUpSwapchain();
     void cleanManagers();
@@ -123,6 +153,16 @@ protected:
     QEDebugSystem* debugSystem;
     bool isRender = false;
 
+    bool headless = false;
+    bool closeRequested = false;
+    VkExtent2D headlessExtent{ 1280, 720 };
+    QEOffscreenRenderTarget offscreenTarget;
+    QEGpuProfiler* gpuProfiler{};
+    QEDeferredDeletionQueue* deletionQueue{};
+    QEFrameTimings lastFrameTimings{};
+    std::chrono::steady_clock::time_point runStart{};
+    double timeToFirstFrameMs = 0.0;
+
     QEScene     scene;
 
     QECameraContext* cameraContext{};
@@ -146,6 +186,7 @@ namespace QE
 {
     using ::ERROR_RESIZE;
     using ::QERenderTarget;
+    using ::QEFrameTimings;
     using ::QEBaseApp;
 } // namespace QE
 // QE namespace aliases
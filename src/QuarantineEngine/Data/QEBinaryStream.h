@@ -0,0 +1,140 @@
+#pragma once
+
+#ifndef QE_BINARY_STREAM_H
+#define QE_BINARY_STREAM_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+/// Escritura de datos binarios en memoria (little endian, sin alineacion). El archivo se escribe
+/// de una vez al terminar; Patch rellena tamanos que solo se conocen despues de escribir el bloque.
+class QEBinaryWriter
+{
+private:
+    std::vector<uint8_t> buffer;
+
+public:
+    template<typename T>
+    void Write(const T& value)
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "QEBinaryWriter::Write requires a trivially copyable type");
+        WriteBytes(&value, sizeof(T));
+    }
+
+    void WriteBytes(const void* data, size_t size)
+    {
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+        buffer.insert(buffer.end(), bytes, bytes + size);
+    }
+
+    void WriteString(std::string_view value)
+    {
+        Write(static_cast<uint32_t>(value.size()));
+        WriteBytes(value.data(), value.size());
+    }
+
+    template<typename T>
+    void Patch(size_t offset, const T& value)
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "QEBinaryWriter::Patch requires a trivially copyable type");
+        memcpy(buffer.data() + offset, &value, sizeof(T));
+    }
+
+    size_t Size() const { return buffer.size(); }
+    const uint8_t* Data() const { return buffer.data(); }
+    void Reserve(size_t size) { buffer.reserve(size); }
+};
+
+/// Lectura sobre un bloque ya cargado (normalmente un QEMappedFile). Nunca lee fuera del bloque:
+/// cualquier lectura que no cabe devuelve false y deja el lector en estado de error.
+class QEBinaryReader
+{
+private:
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+    size_t position = 0;
+    bool failed = false;
+
+public:
+    QEBinaryReader() = default;
+    QEBinaryReader(const uint8_t* data, size_t size) : data(data), size(size) {}
+
+    template<typename T>
+    bool Read(T& value)
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "QEBinaryReader::Read requires a trivially copyable type");
+        return ReadBytes(&value, sizeof(T));
+    }
+
+    bool ReadBytes(void* out, size_t count)
+    {
+        if (!Ensure(count))
+            return false;
+
+        memcpy(out, data + position, count);
+        position += count;
+        return true;
+    }
+
+    bool ReadString(std::string& value)
+    {
+        uint32_t length = 0;
+        if (!Read(length) || !Ensure(length))
+            return false;
+
+        value.assign(reinterpret_cast<const char*>(data + position), length);
+        position += length;
+        return true;
+    }
+
+    /// Sublector de 'count' bytes desde la posicion actual; este lector salta el bloque.
+    bool ReadBlock(size_t count, QEBinaryReader& out)
+    {
+        if (!Ensure(count))
+            return false;
+
+        out = QEBinaryReader(data + position, count);
+        position += count;
+        return true;
+    }
+
+    bool Skip(size_t count)
+    {
+        if (!Ensure(count))
+            return false;
+
+        position += count;
+        return true;
+    }
+
+    size_t Position() const { return position; }
+    size_t Remaining() const { return size - position; }
+    bool AtEnd() const { return position == size; }
+    bool Failed() const { return failed; }
+
+private:
+    bool Ensure(size_t count)
+    {
+        if (failed || count > size - position)
+        {
+            failed = true;
+            return false;
+        }
+        return true;
+    }
+};
+
+
+
+namespace QE
+{
+    using ::QEBinaryWriter;
+    using ::QEBinaryReader;
+} // namespace QE
+// QE namespace aliases
+#endif // !QE_BINARY_STREAM_H
@@ -0,0 +1,258 @@
+#include "QEContentIndex.h"
+#include <format>
+#include <fstream>
+#include <mutex>
+#include <unordered_map>
+#include <yaml-cpp/yaml.h>
+#include <QEMappedFile.h>
+#include <Helpers/HashHelpers.h>
+#include <Logging/QELogMacros.h>
+
+bool QEContentIndex::Enabled = true;
+
+namespace
+{
+    constexpr int INDEX_VERSION = 1;
+    constexpr const char* ASSETS_FOLDER_NAME = "QEAssets";     // QEProjectManager::GetAssetsFolderPath()
+
+    std::mutex indexMutex;
+    fs::path loadedProject;
+    bool dirty = false;
+    std::unordered_map<uint64_t, QEContentEntry> textures;
+    std::unordered_map<uint64_t, QEContentEntry> materials;
+
+    std::unordered_map<uint64_t, QEContentEntry>& EntriesOf(QEContentKind kind)
+    {
+        return kind == QEContentKind::Texture ? textures : materials;
+    }
+
+    void ReadEntries(const YAML::Node& node, std::unordered_map<uint64_t, QEContentEntry>& entries)
+    {
+        if (!node || !node.IsSequence())
+            return;
+
+        for (const auto& item : node)
+        {
+            if (!item["Hash"] || !item["Path"])
+                continue;
+
+            QEContentEntry entry;
+            entry.Path = item["Path"].as<std::string>();
+            entry.Name = item["Name"] ? item["Name"].as<std::string>() : "";
+            entry.Size = item["Size"] ? item["Size"].as<uint64_t>() : 0;
+            entries[std::stoull(item["Hash"].as<std::string>(), nullptr, 16)] = entry;
+        }
+    }
+
+    bool IsProject(const fs::path& projectPath)
+    {
+        return !projectPath.empty() && fs::exists(projectPath);
+    }
+
+    // Mismas reglas que QEProjectManager::ResolveProjectPath y ToProjectRelativePath
+    fs::path ResolvePath(const fs::path& projectPath, const fs::path& path)
+    {
+        if (path.is_absolute())
+            return path.lexically_normal();
+
+        return (projectPath / path).lexically_normal();
+    }
+
+    std::string ToRelativePath(const fs::path& projectPath, const fs::path& path)
+    {
+        std::error_code ec;
+        const fs::path relative = fs::relative(path, projectPath, ec);
+        if (ec)
+            return path.lexically_normal().generic_string();
+
+        return relative.lexically_normal().generic_string();
+    }
+
+    YAML::Node WriteEntries(const std::unordered_map<uint64_t, QEContentEntry>& entries, bool withName)
+    {
+        YAML::Node node(YAML::NodeType::Sequence);
+        for (const auto& [hash, entry] : entries)
+        {
+            YAML::Node item;
+            item["Hash"] = std::format("{:016x}", hash);
+            if (withName)
+                item["Name"] = entry.Name;
+            item["Path"] = entry.Path;
+            item["Size"] = entry.Size;
+            node.push_back(item);
+        }
+        return node;
+    }
+}
+
+fs::path QEContentIndex::GetIndexPath(const fs::path& projectPath)
+{
+    if (!IsProject(projectPath))
+        return {};
+
+    return projectPath / ASSETS_FOLDER_NAME / INDEX_FILE;
+}
+
+void QEContentIndex::EnsureLoaded(const fs::path& projectPath)
+{
+    if (projectPath == loadedProject)
+        return;
+
+    loadedProject = projectPath;
+    dirty = false;
+    textures.clear();
+    materials.clear();
+
+    const fs::path indexPath = GetIndexPath(projectPath);
+    if (indexPath.empty() || !fs::exists(indexPath))
+        return;
+
+    try
+    {
+        YAML::Node root = YAML::LoadFile(indexPath.string());
+        if (!root["Version"] || root["Version"].as<int>() != INDEX_VERSION)
+            return;
+
+        ReadEntries(root["Textures"], textures);
+        ReadEntries(root["Materials"], materials);
+    }
+    catch (const std::exception& e)
+    {
+        // Sin indice solo se pierde la deduplicacion de las siguientes importaciones
+        QE_LOG_WARN_CAT_F("QEContentIndex", "Ignoring unreadable content index {}: {}", indexPath.string(), e.what());
+        textures.clear();
+        materials.clear();
+    }
+}
+
+bool QEContentIndex::Find(const fs::path& projectPath, QEContentKind kind, uint64_t hash, QEContentEntry& out)
+{
+    if (!Enabled || !IsProject(projectPath))
+        return false;
+
+    std::lock_guard<std::mutex> lock(indexMutex);
+    EnsureLoaded(projectPath);
+
+    auto& entries = EntriesOf(kind);
+    auto it = entries.find(hash);
+    if (it == entries.end())
+        return false;
+
+    if (!fs::exists(ResolvePath(projectPath, it->second.Path)))
+    {
+        entries.erase(it);
+        dirty = true;
+        return false;
+    }
+
+    out = it->second;
+    return true;
+}
+
+void QEContentIndex::Register(const fs::path& projectPath, QEContentKind kind, uint64_t hash, const fs::path& assetPath, const std::string& name)
+{
+    if (!Enabled || !IsProject(projectPath))
+        return;
+
+    std::error_code ec;
+    const uint64_t size = fs::file_size(assetPath, ec);
+    if (ec)
+        return;
+
+    std::lock_guard<std::mutex> lock(indexMutex);
+    EnsureLoaded(projectPath);
+
+    QEContentEntry entry;
+    entry.Path = ToRelativePath(projectPath, assetPath);
+    entry.Name = name;
+    entry.Size = size;
+    EntriesOf(kind)[hash] = entry;
+    dirty = true;
+}
+
+fs::path QEContentIndex::FindMaterialByName(const fs::path& projectPath, const std::string& name)
+{
+    if (!IsProject(projectPath))
+        return {};
+
+    std::lock_guard<std::mutex> lock(indexMutex);
+    EnsureLoaded(projectPath);
+
+    for (const auto& [hash, entry] : materials)
+    {
+        if (entry.Name != name)
+            continue;
+
+        const fs::path path = ResolvePath(projectPath, entry.Path);
+        if (fs::exists(path))
+            return path;
+    }
+
+    return {};
+}
+
+bool QEContentIndex::Save()
+{
+    std::lock_guard<std::mutex> lock(indexMutex);
+    if (!dirty || loadedProject.empty())
+        return true;
+
+    const fs::path indexPath = GetIndexPath(loadedProject);
+    if (indexPath.empty())
+        return false;
+
+    YAML::Node root;
+    root["Version"] = INDEX_VERSION;
+    root["Textures"] = WriteEntries(textures, false);
+    root["Materials"] = WriteEntries(materials, true);
+
+    std::error_code ec;
+    fs::create_directories(indexPath.parent_path(), ec);
+
+    const fs::path tempPath = fs::path(indexPath).concat(".tmp");
+    {
+        std::ofstream file(tempPath, std::ios::trunc);
+        if (!file.is_open())
+        {
+            QE_LOG_ERROR_CAT_F("QEContentIndex", "Could not write the content index {}", indexPath.string());
+            return false;
+        }
+
+        YAML::Emitter out;
+        out << root;
+        file << out.c_str();
+    }
+
+    fs::rename(tempPath, indexPath, ec);
+    if (ec)
+    {
+        fs::remove(tempPath, ec);
+        QE_LOG_ERROR_CAT_F("QEContentIndex", "Could not replace the content index {}", indexPath.string());
+        return false;
+    }
+
+    dirty = false;
+    return true;
+}
+
+bool QEContentIndex::HashFile(const fs::path& path, uint64_t& outHash, uint64_t& outSize)
+{
+    QEMappedFile file;
+    if (!file.Open(path))
+        return false;
+
+    outHash = QEHelper::HashBytes(file.Data(), file.Size());
+    outSize = static_cast<uint64_t>(file.Size());
+    return true;
+}
+
+bool QEContentIndex::HashTextureSource(const fs::path& sourcePath, uint32_t semantic, uint32_t colorSpace, uint64_t& outHash)
+{
+    uint64_t sourceSize = 0;
+    if (!HashFile(sourcePath, outHash, sourceSize))
+        return false;
+
+    const uint32_t settingsKey[2] = { semantic, colorSpace };
+    outHash = QEHelper::HashBytes(settingsKey, sizeof(settingsKey), outHash);
+    return true;
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#ifndef QE_CONTENT_INDEX_H
+#define QE_CONTENT_INDEX_H
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+
+namespace fs = std::filesystem;
+
+enum class QEContentKind : uint8_t
+{
+    Texture,
+    Material
+};
+
+struct QEContentEntry
+{
+    std::string Path;               // Relativa al proyecto
+    std::string Name;               // Solo materiales
+    uint64_t Size = 0;
+};
+
+/// Indice por contenido de los assets importados en el proyecto: el hash de la textura fuente (con su
+/// semantica y espacio de color) o del bloque de parametros de un material apunta al asset ya generado,
+/// para que los modelos que lo repiten lo compartan en disco y en GPU. Se guarda en
+/// <proyecto>/QEAssets/ContentIndex.qeindex; las entradas cuyo archivo ya no existe se descartan al buscarlas.
+class QEContentIndex
+{
+public:
+    static constexpr const char* INDEX_FILE = "ContentIndex.qeindex";
+
+    static bool Enabled;
+
+    /// Las operaciones reciben la carpeta del proyecto (QEProjectManager::GetCurrentProjectPath());
+    /// el indice cargado se cambia cuando cambia el proyecto.
+    static fs::path GetIndexPath(const fs::path& projectPath);
+
+    static bool Find(const fs::path& projectPath, QEContentKind kind, uint64_t hash, QEContentEntry& out);
+    static void Register(const fs::path& projectPath, QEContentKind kind, uint64_t hash, const fs::path& assetPath, const std::string& name = "");
+    /// Material compartido que no esta en la carpeta Materials del modelo; vacio si no hay ninguno.
+    static fs::path FindMaterialByName(const fs::path& projectPath, const std::string& name);
+    static bool Save();
+
+    /// false si el archivo no existe o esta vacio.
+    static bool HashFile(const fs::path& path, uint64_t& outHash, uint64_t& outSize);
+    /// Hash de una textura fuente con su semantica (TEXTURE_TYPE) y espacio de color (QEColorSpace):
+    /// el mismo archivo genera KTX2 distintos segun ambos.
+    static bool HashTextureSource(const fs::path& sourcePath, uint32_t semantic, uint32_t colorSpace, uint64_t& outHash);
+
+private:
+    static void EnsureLoaded(const fs::path& projectPath);
+};
+
+
+
+namespace QE
+{
+    using ::QEContentKind;
+    using ::QEContentEntry;
+    using ::QEContentIndex;
+} // namespace QE
+// QE namespace aliases
+#endif // !QE_CONTENT_INDEX_H
@@ -0,0 +1,48 @@
+#pragma once
+
+#ifndef QE_MAPPED_FILE_H
+#define QE_MAPPED_FILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+
+/// Archivo mapeado en memoria de solo lectura. Movible, no copiable; se desmapea al destruirse.
+class QEMappedFile
+{
+private:
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+#ifdef _WIN32
+    void* fileHandle = nullptr;
+    void* mappingHandle = nullptr;
+#else
+    int fileDescriptor = -1;
+#endif
+
+public:
+    QEMappedFile() = default;
+    ~QEMappedFile();
+
+    QEMappedFile(const QEMappedFile&) = delete;
+    QEMappedFile& operator=(const QEMappedFile&) = delete;
+    QEMappedFile(QEMappedFile&& other) noexcept;
+    QEMappedFile& operator=(QEMappedFile&& other) noexcept;
+
+    /// false si no existe, esta vacio o no se puede mapear.
+    bool Open(const std::filesystem::path& path);
+    void Close();
+
+    bool IsOpen() const { return data != nullptr; }
+    const uint8_t* Data() const { return data; }
+    size_t Size() const { return size; }
+};
+
+
+
+namespace QE
+{
+    using ::QEMappedFile;
+} // namespace QE
+// QE namespace aliases
+#endif // !QE_MAPPED_FILE_H
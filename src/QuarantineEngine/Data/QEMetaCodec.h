@@ -0,0 +1,415 @@
+#pragma once
+
+#ifndef QE_META_CODEC_H
+#define QE_META_CODEC_H
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
+#include <yaml-cpp/yaml.h>
+#include <QEBinaryStream.h>
+#include <Helpers/HashHelpers.h>
+
+// Metadatos de campos y su serializacion (YAML y .qescene binario), sin tipos del motor.
+// Reflectable.h registra los codecs de glm, Jolt y los enums y define las macros de componentes.
+
+struct SerializableComponent
+{
+    virtual ~SerializableComponent() = default;
+    virtual const std::string& getTypeName() const = 0;
+    virtual struct QEMetaType* meta() const = 0;
+    virtual bool IsSerializable() const { return true; }
+};
+
+struct QEMetaField
+{
+    std::string name;
+    std::type_index type;
+    size_t offset;
+};
+
+// Codificacion de un campo en el .qescene binario; describe los datos, no el tipo C++
+// (glm::vec3 y JPH::Vec3 son Vec3, los enums se guardan como Int/UInt igual que en YAML)
+enum class QEFieldKind : uint32_t
+{
+    Unsupported = 0,
+    Int = 1,
+    UInt = 2,
+    Bool = 3,
+    Float = 4,
+    String = 5,
+    Vec2 = 6,
+    Vec3 = 7,
+    Vec4 = 8,
+    Quat = 9,
+    Mat4 = 10,
+    StringList = 11,
+    YamlText = 12,
+};
+
+struct QEFieldCodec
+{
+    QEFieldKind kind = QEFieldKind::Unsupported;
+    YAML::Node (*toYaml)(const void* field) = nullptr;
+    void (*fromYaml)(const YAML::Node& node, void* field) = nullptr;
+    void (*toBinary)(QEBinaryWriter& out, const void* field) = nullptr;
+    bool (*fromBinary)(QEBinaryReader& in, void* field) = nullptr;
+};
+
+namespace QEFieldCodecs
+{
+    // Stored: tipo con el que se escribe (los enums como int/uint32)
+    template<typename T, typename Stored = T>
+    YAML::Node ValueToYaml(const void* field)
+    {
+        return YAML::Node(static_cast<Stored>(*static_cast<const T*>(field)));
+    }
+
+    template<typename T, typename Stored = T>
+    void ValueFromYaml(const YAML::Node& node, void* field)
+    {
+        *static_cast<T*>(field) = static_cast<T>(node.as<Stored>());
+    }
+
+    template<typename T, typename Stored = T>
+    void PodToBinary(QEBinaryWriter& out, const void* field)
+    {
+        out.Write(static_cast<Stored>(*static_cast<const T*>(field)));
+    }
+
+    template<typename T, typename Stored = T>
+    bool PodFromBinary(QEBinaryReader& in, void* field)
+    {
+        Stored value{};
+        if (!in.Read(value))
+            return false;
+
+        *static_cast<T*>(field) = static_cast<T>(value);
+        return true;
+    }
+
+    inline void StringToBinary(QEBinaryWriter& out, const void* field)
+    {
+        out.WriteString(*static_cast<const std::string*>(field));
+    }
+
+    inline bool StringFromBinary(QEBinaryReader& in, void* field)
+    {
+        return in.ReadString(*static_cast<std::string*>(field));
+    }
+
+    inline void StringListToBinary(QEBinaryWriter& out, const void* field)
+    {
+        const auto& values = *static_cast<const std::vector<std::string>*>(field);
+        out.Write(static_cast<uint32_t>(values.size()));
+        for (const auto& value : values)
+            out.WriteString(value);
+    }
+
+    inline bool StringListFromBinary(QEBinaryReader& in, void* field)
+    {
+        uint32_t count = 0;
+        if (!in.Read(count) || count > in.Remaining() / sizeof(uint32_t))
+            return false;
+
+        std::vector<std::string> values(count);
+        for (auto& value : values)
+        {
+            if (!in.ReadString(value))
+                return false;
+        }
+
+        *static_cast<std::vector<std::string>*>(field) = std::move(values);
+        return true;
+    }
+
+    // Tipos con conversion YAML propia (estados y transiciones de animacion): texto YAML dentro del binario
+    template<typename T>
+    void YamlTextToBinary(QEBinaryWriter& out, const void* field)
+    {
+        YAML::Emitter emitter;
+        emitter << YAML::Node(*static_cast<const T*>(field));
+        out.WriteString(emitter.c_str());
+    }
+
+    template<typename T>
+    bool YamlTextFromBinary(QEBinaryReader& in, void* field)
+    {
+        std::string text;
+        if (!in.ReadString(text))
+            return false;
+
+        *static_cast<T*>(field) = YAML::Load(text).as<T>();
+        return true;
+    }
+
+    template<typename T, typename Stored = T>
+    QEFieldCodec Pod(QEFieldKind kind)
+    {
+        return { kind, &ValueToYaml<T, Stored>, &ValueFromYaml<T, Stored>, &PodToBinary<T, Stored>, &PodFromBinary<T, Stored> };
+    }
+
+    template<typename T>
+    QEFieldCodec YamlText()
+    {
+        return { QEFieldKind::YamlText, &ValueToYaml<T>, &ValueFromYaml<T>, &YamlTextToBinary<T>, &YamlTextFromBinary<T> };
+    }
+
+    /// Codecs de los tipos de C++ basicos; Reflectable.h anade los del motor (glm, Jolt, enums).
+    inline std::unordered_map<std::type_index, QEFieldCodec> MakePrimitiveCodecs()
+    {
+        std::unordered_map<std::type_index, QEFieldCodec> codecs;
+        codecs.emplace(typeid(int), Pod<int>(QEFieldKind::Int));
+        codecs.emplace(typeid(uint32_t), Pod<uint32_t>(QEFieldKind::UInt));
+        codecs.emplace(typeid(bool), QEFieldCodec{ QEFieldKind::Bool, &ValueToYaml<bool>, &ValueFromYaml<bool>, &PodToBinary<bool, uint8_t>, &PodFromBinary<bool, uint8_t> });
+        codecs.emplace(typeid(float), Pod<float>(QEFieldKind::Float));
+        codecs.emplace(typeid(std::string), QEFieldCodec{ QEFieldKind::String, &ValueToYaml<std::string>, &ValueFromYaml<std::string>, &StringToBinary, &StringFromBinary });
+        codecs.emplace(typeid(std::vector<std::string>), QEFieldCodec{ QEFieldKind::StringList, &ValueToYaml<std::vector<std::string>>, &ValueFromYaml<std::vector<std::string>>, &StringListToBinary, &StringListFromBinary });
+        return codecs;
+    }
+}
+
+inline std::unordered_map<std::type_index, QEFieldCodec>& getFieldCodecRegistry()
+{
+    static std::unordered_map<std::type_index, QEFieldCodec> registry = QEFieldCodecs::MakePrimitiveCodecs();
+    return registry;
+}
+
+/// Codec para un tipo de campo propio (p. ej. desde el modulo de un proyecto). Registrar antes de
+/// crear la primera instancia del componente que lo usa.
+inline void registerFieldCodec(std::type_index type, const QEFieldCodec& codec)
+{
+    getFieldCodecRegistry()[type] = codec;
+}
+
+inline const QEFieldCodec* findFieldCodec(std::type_index type)
+{
+    auto& registry = getFieldCodecRegistry();
+    auto it = registry.find(type);
+    return it != registry.end() ? &it->second : nullptr;
+}
+
+// Campo con su codec ya resuelto; nullptr si el tipo no tiene codec
+struct QEMetaCodecField
+{
+    std::string name;
+    size_t offset = 0;
+    uint64_t nameHash = 0;
+    const QEFieldCodec* codec = nullptr;
+};
+
+/// Campos de un tipo con su codec y el hash de su layout. Inmutable una vez construida: si se
+/// registran campos nuevos se construye otra tabla y la anterior sigue viva mientras alguien la use.
+struct QEMetaCodecTable
+{
+    std::vector<QEMetaCodecField> fields;
+    uint64_t layoutHash = 0;
+    size_t fieldCount = 0;
+};
+
+inline std::mutex& getMetaCodecMutex()
+{
+    static std::mutex mutex;
+    return mutex;
+}
+
+struct QEMetaType
+{
+    std::string typeName;
+    std::vector<QEMetaField> fields;
+    QEMetaType* base = nullptr;
+
+    // Cache de codecFields(): campos de la base y propios, con su codec
+    mutable std::shared_ptr<const QEMetaCodecTable> codecTable;
+
+    void addField(const std::string& name, std::type_index type, size_t offset)
+    {
+        std::lock_guard<std::mutex> lock(getMetaCodecMutex());
+        fields.push_back({ name, type, offset });
+    }
+
+    std::vector<QEMetaField> allFields() const {
+        if (!base) return fields;
+        auto v = base->allFields();
+        v.insert(v.end(), fields.begin(), fields.end());
+        return v;
+    }
+
+    size_t fieldCount() const
+    {
+        return fields.size() + (base ? base->fieldCount() : 0);
+    }
+
+    /// Tabla de campos para serializar, resuelta una vez por tipo (se rehace si se registran campos nuevos).
+    /// Se devuelve por shared_ptr: quien la usa la mantiene viva aunque otro hilo la rehaga.
+    std::shared_ptr<const QEMetaCodecTable> codecFields() const
+    {
+        std::lock_guard<std::mutex> lock(getMetaCodecMutex());
+        const size_t count = fieldCount();
+        if (codecTable && codecTable->fieldCount == count)
+            return codecTable;
+
+        auto table = std::make_shared<QEMetaCodecTable>();
+        table->fields.reserve(count);
+        table->fieldCount = count;
+        for (const auto& field : allFields())
+        {
+            QEMetaCodecField entry;
+            entry.name = field.name;
+            entry.offset = field.offset;
+            entry.nameHash = QEHelper::HashBytes(field.name.data(), field.name.size());
+            entry.codec = findFieldCodec(field.type);
+            table->fields.push_back(entry);
+
+            if (entry.codec)
+            {
+                const uint64_t layout[2] = { entry.nameHash, static_cast<uint64_t>(entry.codec->kind) };
+                table->layoutHash = QEHelper::HashBytes(layout, sizeof(layout), table->layoutHash);
+            }
+        }
+
+        codecTable = table;
+        return codecTable;
+    }
+
+    /// Hash de los nombres y codificaciones de los campos binarios, en orden.
+    uint64_t layoutHash() const
+    {
+        return codecFields()->layoutHash;
+    }
+};
+
+inline std::unordered_map<std::string, QEMetaType*>& getMetaRegistry()
+{
+    static std::unordered_map<std::string, QEMetaType*> registry;
+    return registry;
+}
+
+inline void registerMetaType(const std::string& name, QEMetaType* meta)
+{
+    getMetaRegistry()[name] = meta;
+}
+
+
+inline QEMetaType* getMetaType(const std::string& name)
+{
+    auto it = getMetaRegistry().find(name);
+    return it != getMetaRegistry().end() ? it->second : nullptr;
+}
+
+inline YAML::Node serializeComponent(const SerializableComponent* comp)
+{
+    YAML::Node node;
+    node["type"] = comp->getTypeName();
+    const auto table = comp->meta()->codecFields();
+    for (const auto& field : table->fields) {
+        const void* fieldPtr = reinterpret_cast<const char*>(comp) + field.offset;
+        if (field.codec) {
+            node[field.name] = field.codec->toYaml(fieldPtr);
+        }
+        else {
+            node[field.name] = "<unsupported type>";
+        }
+    }
+    return node;
+}
+
+inline void deserializeComponent(SerializableComponent* comp, const YAML::Node& node)
+{
+    const auto table = comp->meta()->codecFields();
+    for (const auto& field : table->fields) {
+        if (!field.codec) continue;
+        const YAML::Node value = node[field.name];
+        if (!value) continue;
+        field.codec->fromYaml(value, reinterpret_cast<char*>(comp) + field.offset);
+    }
+}
+
+/// Campos de 'comp' en binario: hash del layout, numero de campos y por cada campo
+/// (hash del nombre, codificacion, tamano, datos). El tamano permite saltar campos desconocidos.
+inline void serializeComponentBinary(const SerializableComponent* comp, QEBinaryWriter& out)
+{
+    const auto table = comp->meta()->codecFields();
+    out.Write(table->layoutHash);
+
+    const size_t countOffset = out.Size();
+    uint32_t count = 0;
+    out.Write(count);
+
+    for (const auto& field : table->fields) {
+        if (!field.codec) continue;
+
+        out.Write(field.nameHash);
+        out.Write(static_cast<uint32_t>(field.codec->kind));
+        const size_t sizeOffset = out.Size();
+        out.Write(uint32_t(0));
+        field.codec->toBinary(out, reinterpret_cast<const char*>(comp) + field.offset);
+        out.Patch(sizeOffset, static_cast<uint32_t>(out.Size() - sizeOffset - sizeof(uint32_t)));
+        ++count;
+    }
+
+    out.Patch(countOffset, count);
+}
+
+/// Inverso de serializeComponentBinary. Con el mismo layout los campos se leen en orden; si el
+/// componente ha cambiado se buscan por hash del nombre y se saltan los que no existen o cambiaron de tipo.
+inline bool deserializeComponentBinary(SerializableComponent* comp, QEBinaryReader& in)
+{
+    const auto table = comp->meta()->codecFields();
+    const auto& fields = table->fields;
+
+    uint64_t layoutHash = 0;
+    uint32_t count = 0;
+    if (!in.Read(layoutHash) || !in.Read(count))
+        return false;
+
+    const bool sameLayout = layoutHash == table->layoutHash;
+    size_t cursor = 0;
+
+    for (uint32_t i = 0; i < count; ++i) {
+        uint64_t nameHash = 0;
+        uint32_t kind = 0;
+        uint32_t size = 0;
+        QEBinaryReader value;
+        if (!in.Read(nameHash) || !in.Read(kind) || !in.Read(size) || !in.ReadBlock(size, value))
+            return false;
+
+        const QEMetaCodecField* field = nullptr;
+        if (sameLayout) {
+            while (cursor < fields.size() && !fields[cursor].codec) ++cursor;
+            if (cursor < fields.size()) field = &fields[cursor++];
+        }
+        else {
+            for (const auto& candidate : fields) {
+                if (candidate.nameHash == nameHash) { field = &candidate; break; }
+            }
+        }
+
+        if (!field || !field->codec || field->nameHash != nameHash || static_cast<uint32_t>(field->codec->kind) != kind)
+            continue;
+
+        if (!field->codec->fromBinary(value, reinterpret_cast<char*>(comp) + field->offset))
+            return false;
+    }
+
+    return true;
+}
+
+
+
+namespace QE
+{
+    using ::SerializableComponent;
+    using ::QEMetaField;
+    using ::QEFieldKind;
+    using ::QEFieldCodec;
+    using ::QEMetaCodecField;
+    using ::QEMetaCodecTable;
+    using ::QEMetaType;
+} // namespace QE
+// QE namespace aliases
+#endif // !QE_META_CODEC_H
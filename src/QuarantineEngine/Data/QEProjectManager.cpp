@@ -82,6 +82,14 @@ fs::path QEProjectManager::GetCurrentProjectPath()
     return CURRENT_PROJECT_PATH;
 }
 
+fs::path QEProjectManager::GetCacheFolderPath()
+{
+    if (!HasCurrentProject())
+        return {};
+
+    return CURRENT_PROJECT_PATH / CACHE_FOLDER;
+}
+
 fs::path QEProjectManager::GetScenesFolderPath()
 {
     return CURRENT_PROJECT_PATH / SCENE_FOLDER;
@@ -363,7 +371,8 @@ bool QEProjectManager::CreateYamlScene(const std::string& sceneName)
 bool QEProjectManager::ImportMeshFile(
     const fs::path& inputFile,
     const fs::path& targetFolder,
-    const QEImportProgressCallback& onProgress)
+    const QEImportProgressCallback& onProgress,
+    const QEMeshOptimizationSettings& optimization)
 {
     if (!fs::exists(inputFile))
     {
@@ -409,7 +418,8 @@ bool QEProjectManager::ImportMeshFile(
         outputMaterialFolderPath.string(),
         outputTextureFolderPath.string(),
         outputAnimationFolderPath.string(),
-        onProgress
+        onProgress,
+        optimization
     );
 }
 
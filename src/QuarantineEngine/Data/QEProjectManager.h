@@ -6,6 +6,7 @@
 #include <string>
 #include <functional>
 #include <QEScene.h>
+#include <QEMeshOptimizer.h>
 
 using QEImportProgressCallback = std::function<void(float, const std::string&, const std::string&)>;
 
@@ -18,6 +19,7 @@ const static std::string MESH_FOLDER = "Meshes";
 const static std::string TEXTURE_FOLDER = "Textures";
 const static std::string MATERIAL_FOLDER = "Materials";
 const static std::string ANIMATION_FOLDER = "Animations";
+const static std::string CACHE_FOLDER = "QECache";
 
 namespace fs = std::filesystem;
 class QEProjectManager
@@ -37,13 +39,16 @@ public:
     static bool ImportMeshFile(
         const fs::path& inputFile,
         const fs::path& targetFolder,
-        const QEImportProgressCallback& onProgress = nullptr);
+        const QEImportProgressCallback& onProgress = nullptr,
+        const QEMeshOptimizationSettings& optimization = {});
     static bool ImportTextureFile(
         const fs::path& inputFile,
         const fs::path& targetFolder,
         const QEImportProgressCallback& onProgress = nullptr);
     static bool ImportAnimationFile(const fs::path& inputFile, const fs::path& folderPath);
     static fs::path GetMaterialFolderPath();
+    /// Datos derivados que se pueden regenerar (vacio sin proyecto).
+    static fs::path GetCacheFolderPath();
 
     static fs::path GetCurrentProjectPath();
 
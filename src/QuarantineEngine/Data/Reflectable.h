@@ -2,6 +2,7 @@
 #ifndef QE_REFLECTABLE
 #define QE_REFLECTABLE
 
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <unordered_map>
@@ -10,65 +11,56 @@
 #include <yaml-cpp/yaml.h>
 #include "glm_yaml_conversions.h"
 #include <memory>
+#include <mutex>
 #include <iostream>
 #include <PhysicsTypes.h>
 #include <LightType.h>
 #include <AtmosphereType.h>
 #include <AnimationYamlHelper.h>
-
-struct SerializableComponent
-{
-    virtual ~SerializableComponent() = default;
-    virtual const std::string& getTypeName() const = 0;
-    virtual struct QEMetaType* meta() const = 0;
-    virtual bool IsSerializable() const { return true; }
-};
+#include <QEMetaCodec.h>
 
 class QEGameComponent; // forward
 
-struct QEMetaField
-{
-    std::string name;
-    std::type_index type;
-    size_t offset;
-};
-
-struct QEMetaType
+namespace QEFieldCodecs
 {
-    std::string typeName;
-    std::vector<QEMetaField> fields;
-    QEMetaType* base = nullptr;
-
-    void addField(const std::string& name, std::type_index type, size_t offset)
+    // JPH::Vec3 lleva un cuarto componente interno: se guardan solo x, y, z
+    inline void JoltVec3ToBinary(QEBinaryWriter& out, const void* field)
     {
-        fields.push_back({ name, type, offset });
+        const auto& v = *static_cast<const JPH::Vec3*>(field);
+        out.Write(glm::vec3(v.GetX(), v.GetY(), v.GetZ()));
     }
 
-    std::vector<QEMetaField> allFields() const {
-        if (!base) return fields;
-        auto v = base->allFields();
-        v.insert(v.end(), fields.begin(), fields.end());
-        return v;
-    }
-};
+    inline bool JoltVec3FromBinary(QEBinaryReader& in, void* field)
+    {
+        glm::vec3 v;
+        if (!in.Read(v))
+            return false;
 
-inline std::unordered_map<std::string, QEMetaType*>& getMetaRegistry()
-{
-    static std::unordered_map<std::string, QEMetaType*> registry;
-    return registry;
-}
+        *static_cast<JPH::Vec3*>(field) = JPH::Vec3(v.x, v.y, v.z);
+        return true;
+    }
 
-inline void registerMetaType(const std::string& name, QEMetaType* meta)
-{
-    getMetaRegistry()[name] = meta;
+    inline bool RegisterEngineCodecs()
+    {
+        registerFieldCodec(typeid(glm::vec2), Pod<glm::vec2>(QEFieldKind::Vec2));
+        registerFieldCodec(typeid(glm::vec3), Pod<glm::vec3>(QEFieldKind::Vec3));
+        registerFieldCodec(typeid(JPH::Vec3), QEFieldCodec{ QEFieldKind::Vec3, &ValueToYaml<JPH::Vec3>, &ValueFromYaml<JPH::Vec3>, &JoltVec3ToBinary, &JoltVec3FromBinary });
+        registerFieldCodec(typeid(glm::vec4), Pod<glm::vec4>(QEFieldKind::Vec4));
+        registerFieldCodec(typeid(glm::quat), Pod<glm::quat>(QEFieldKind::Quat));
+        registerFieldCodec(typeid(glm::mat4), Pod<glm::mat4>(QEFieldKind::Mat4));
+        registerFieldCodec(typeid(PhysicBodyType), Pod<PhysicBodyType, int>(QEFieldKind::Int));
+        registerFieldCodec(typeid(CollisionFlag), Pod<CollisionFlag, int>(QEFieldKind::Int));
+        registerFieldCodec(typeid(LightType), Pod<LightType, uint32_t>(QEFieldKind::UInt));
+        registerFieldCodec(typeid(AtmosphereType), Pod<AtmosphereType, uint32_t>(QEFieldKind::UInt));
+        registerFieldCodec(typeid(AnimationState), YamlText<AnimationState>());
+        registerFieldCodec(typeid(std::vector<AnimationState>), YamlText<std::vector<AnimationState>>());
+        registerFieldCodec(typeid(std::vector<QETransition>), YamlText<std::vector<QETransition>>());
+        return true;
+    }
 }
 
-
-inline QEMetaType* getMetaType(const std::string& name)
-{
-    auto it = getMetaRegistry().find(name);
-    return it != getMetaRegistry().end() ? it->second : nullptr;
-}
+// Definida antes que cualquier componente de cada TU: sus codecs estan antes del primer codecFields()
+inline const bool qeEngineFieldCodecsRegistered = QEFieldCodecs::RegisterEngineCodecs();
 
 inline std::unordered_map<std::string, std::function<std::unique_ptr<class QEGameComponent>()>>& getFactoryRegistry()
 {
@@ -76,172 +68,6 @@ inline std::unordered_map<std::string, std::function<std::unique_ptr<class QEGam
     return registry;
 }
 
-inline YAML::Node serializeComponent(const SerializableComponent* comp)
-{
-    YAML::Node node;
-    node["type"] = comp->getTypeName();
-    QEMetaType* meta = comp->meta();
-    for (const auto& field : meta->allFields()) {
-        void* fieldPtr = (void*)((char*)comp + field.offset);
-        if (field.type == typeid(int)) {
-            node[field.name] = *(int*)fieldPtr;
-        }
-        else if (field.type == typeid(uint32_t)) {
-            node[field.name] = *(uint32_t*)fieldPtr;
-        }
-        else if (field.type == typeid(bool)) {
-            node[field.name] = *(bool*)fieldPtr;
-        }
-        else if (field.type == typeid(float)) {
-            node[field.name] = *(float*)fieldPtr;
-        }
-        else if (field.type == typeid(std::string)) {
-            node[field.name] = *(std::string*)fieldPtr;
-        }
-        else if (field.type == typeid(glm::vec2)) {
-            auto v = *reinterpret_cast<glm::vec2*>(fieldPtr);
-            node[field.name] = v;
-        }
-        else if (field.type == typeid(glm::vec3)) {
-            auto v = *reinterpret_cast<glm::vec3*>(fieldPtr);
-            node[field.name] = v;
-        }
-        else if (field.type == typeid(JPH::Vec3)) {
-            auto v = *reinterpret_cast<JPH::Vec3*>(fieldPtr);
-            node[field.name] = v;
-        }
-        else if (field.type == typeid(glm::vec4)) {
-            auto v = *reinterpret_cast<glm::vec4*>(fieldPtr);
-            node[field.name] = v;
-        }
-        else if (field.type == typeid(glm::quat)) {
-            auto v = *reinterpret_cast<glm::quat*>(fieldPtr);
-            node[field.name] = v;
-        }
-        else if (field.type == typeid(glm::mat4)) {
-            auto v = *reinterpret_cast<glm::mat4*>(fieldPtr);
-            node[field.name] = v;
-        }
-        else if (field.type == typeid(std::vector<std::string>)) {
-            auto& vec = *reinterpret_cast<const std::vector<std::string>*>(fieldPtr);
-            node[field.name] = vec;  // usa convert<vector<string>>::encode
-        }
-        else if (field.type == typeid(PhysicBodyType)) {
-            auto v = *reinterpret_cast<PhysicBodyType*>(fieldPtr);
-            node[field.name] = static_cast<int>(v);
-        }
-        else if (field.type == typeid(CollisionFlag)) {
-            auto v = *reinterpret_cast<CollisionFlag*>(fieldPtr);
-            node[field.name] = static_cast<int>(v);
-        }
-        else if (field.type == typeid(LightType)) {
-            auto v = *reinterpret_cast<LightType*>(fieldPtr);
-            node[field.name] = static_cast<uint32_t>(v);
-        }
-        else if (field.type == typeid(AtmosphereType)) {
-            auto v = *reinterpret_cast<AtmosphereType*>(fieldPtr);
-            node[field.name] = static_cast<uint32_t>(v);
-        }
-        else if (field.type == typeid(AnimationState)) {
-            auto& animState = *reinterpret_cast<const AnimationState*>(fieldPtr);
-            node[field.name] = animState;
-        }
-        else if (field.type == typeid(std::vector<AnimationState>)) {
-            auto& vec = *reinterpret_cast<const std::vector<AnimationState>*>(fieldPtr);
-            node[field.name] = vec;
-        }
-        else if (field.type == typeid(std::vector<QETransition>)) {
-            auto& vec = *reinterpret_cast<const std::vector<QETransition>*>(fieldPtr);
-            node[field.name] = vec;
-        }
-        else {
-            node[field.name] = "<unsupported type>";
-        }
-    }
-    return node;
-}
-
-inline void deserializeComponent(SerializableComponent* comp, const YAML::Node& node)
-{
-    QEMetaType* meta = comp->meta();
-    for (const auto& field : meta->allFields()) {
-        void* fieldPtr = (void*)((char*)comp + field.offset);
-        if (!node[field.name]) continue;
-        if (field.type == typeid(int)) {
-            *(int*)fieldPtr = node[field.name].as<int>();
-        }
-        else if (field.type == typeid(uint32_t)) {
-            *(uint32_t*)fieldPtr = node[field.name].as<uint32_t>();
-        }
-        else if (field.type == typeid(bool)) {
-            *(bool*)fieldPtr = node[field.name].as<bool>();
-        }
-        else if (field.type == typeid(float)) {
-            *(float*)fieldPtr = node[field.name].as<float>();
-        }
-        else if (field.type == typeid(std::string)) {
-            *(std::string*)fieldPtr = node[field.name].as<std::string>();
-        }
-        else if (field.type == typeid(glm::vec2)) {
-            *reinterpret_cast<glm::vec2*>(fieldPtr) = node[field.name].as<glm::vec2>();
-        }
-        else if (field.type == typeid(glm::vec3)) {
-            *reinterpret_cast<glm::vec3*>(fieldPtr) = node[field.name].as<glm::vec3>();
-        }
-        else if (field.type == typeid(JPH::Vec3)) {
-            *reinterpret_cast<JPH::Vec3*>(fieldPtr) = node[field.name].as<JPH::Vec3>();
-        }
-        else if (field.type == typeid(glm::vec4)) {
-            *reinterpret_cast<glm::vec4*>(fieldPtr) = node[field.name].as<glm::vec4>();
-        }
-        else if (field.type == typeid(glm::quat)) {
-            *reinterpret_cast<glm::quat*>(fieldPtr) = node[field.name].as<glm::quat>();
-        }
-        else if (field.type == typeid(glm::mat4)) {
-            *reinterpret_cast<glm::mat4*>(fieldPtr) = node[field.name].as<glm::mat4>();
-        }
-        else if (field.type == typeid(std::vector<std::string>)) {
-            *reinterpret_cast<std::vector<std::string>*>(fieldPtr) = node[field.name].as<std::vector<std::string>>();
-        }
-        else if (field.type == typeid(PhysicBodyType))
-        {
-            int ival = node[field.name].as<int>();
-            auto v = static_cast<PhysicBodyType>(ival);
-            *reinterpret_cast<PhysicBodyType*>(fieldPtr) = v;
-        }
-        else if (field.type == typeid(CollisionFlag))
-        {
-            int ival = node[field.name].as<int>();
-            auto v = static_cast<CollisionFlag>(ival);
-            *reinterpret_cast<CollisionFlag*>(fieldPtr) = v;
-        }
-        else if (field.type == typeid(LightType))
-        {
-            uint32_t ival = node[field.name].as<uint32_t>();
-            auto v = static_cast<LightType>(ival);
-            *reinterpret_cast<LightType*>(fieldPtr) = v;
-        }
-        else if (field.type == typeid(AtmosphereType))
-        {
-            uint32_t ival = node[field.name].as<uint32_t>();
-            auto v = static_cast<AtmosphereType>(ival);
-            *reinterpret_cast<AtmosphereType*>(fieldPtr) = v;
-        }
-        else if (field.type == typeid(AnimationState))
-        {
-            *reinterpret_cast<AnimationState*>(fieldPtr) = node[field.name].as<AnimationState>();
-        }
-        else if (field.type == typeid(std::vector<AnimationState>))
-        {
-            *reinterpret_cast<std::vector<AnimationState>*>(fieldPtr) = node[field.name].as<std::vector<AnimationState>>();
-        }
-        else if (field.type == typeid(std::vector<QETransition>))
-        {
-            *reinterpret_cast<std::vector<QETransition>*>(fieldPtr) = node[field.name].as<std::vector<QETransition>>();
-        }
-    }
-}
-
 // --- BASE ---
 #define REFLECTABLE_COMPONENT(Type)                                \
     using Self = Type;                                             \
@@ -275,7 +101,9 @@ inline void deserializeComponent(SerializableComponent* comp, const YAML::Node&
     Type Name; \
     struct AutoField_##Name { \
         AutoField_##Name() { \
-            Self::staticMeta()->addField(#Name, typeid(Type), offsetof(Self, Name)); \
+            /* una vez por tipo, no por instancia */ \
+            static const bool registered = (Self::staticMeta()->addField(#Name, typeid(Type), offsetof(Self, Name)), true); \
+            (void)registered; \
         } \
     } _autoField_##Name;
 
@@ -314,10 +142,7 @@ YAML::Node importFromFile(const std::string& filename);
 
 namespace QE
 {
-    using ::SerializableComponent;
     using ::QEGameComponent;
-    using ::QEMetaField;
-    using ::QEMetaType;
 } // namespace QE
 // QE namespace aliases
 #endif // !QE_REFLECTABLE
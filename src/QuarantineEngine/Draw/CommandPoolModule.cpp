@@ -5,6 +5,9 @@
 
 #include <backends/imgui_impl_vulkan.h>
 #include <SynchronizationModule.h>
+#include <ShadowCasterCulling.h>
+#include <QEGpuProfiler.h>
+#include <ShadowAtlasManager.h>
 
 CommandPoolModule::CommandPoolModule()
 {
@@ -15,6 +18,7 @@ CommandPoolModule::CommandPoolModule()
     computeNodeManager = ComputeNodeManager::getInstance();
     cullingSceneManager = CullingSceneManager::getInstance();
     lightManager = LightManager::getInstance();
+    shadowCacheManager = ShadowCacheManager::getInstance();
     renderPassModule = RenderPassModule::getInstance();
     atmosphereSystem = AtmosphereSystem::getInstance();
     debugSystem = QEDebugSystem::getInstance();
@@ -43,6 +47,8 @@ void CommandPoolModule::createCommandPool(VkSurfaceKHR& surface)
     if (vkCreateCommandPool(deviceModule->device, &computePoolInfo, nullptr, &computeCommandPool) != VK_SUCCESS) {
         throw std::runtime_error("failed to create compute command pool!");
     }
+
+    this->transientPool.Initialize(deviceModule);
 }
 
 void CommandPoolModule::createCommandBuffers()
@@ -242,27 +248,37 @@ void CommandPoolModule::setDirectionalShadowRenderPass(std::shared_ptr<VkRenderP
     auto pipeline = lightManager->GetCSMPipelineModule()->pipeline;
     auto pipelineLayout = lightManager->GetCSMPipelineModule()->pipelineLayout;
 
+    auto csmResources = dirLight->shadowMappingResourcesPtr;
+
     for (uint32_t cascadeIndex = 0; cascadeIndex < SHADOW_MAP_CASCADE_COUNT; cascadeIndex++)
     {
-        renderPassInfo.framebuffer =
-            dirLight->shadowMappingResourcesPtr->CascadeResourcesPtr->at(cascadeIndex).frameBuffer;
-
-        vkCmdBeginRenderPass(commandBuffers[iCBuffer], &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
-        vkCmdBindPipeline(commandBuffers[iCBuffer], VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
+        renderPassInfo.framebuffer = csmResources->CascadeResourcesPtr->at(cascadeIndex).frameBuffer;
 
-        vkCmdBindDescriptorSets(
+        this->recordCachedShadowView(
             commandBuffers[iCBuffer],
-            VK_PIPELINE_BIND_POINT_GRAPHICS,
-            pipelineLayout,
-            0,
-            1,
-            &descriptorSet,
-            0,
-            nullptr);
-
-        this->gameObjectManager->CSMCommand(commandBuffers[iCBuffer], iCBuffer, pipelineLayout, cascadeIndex);
-
-        vkCmdEndRenderPass(commandBuffers[iCBuffer]);
+            this->shadowCacheManager->GetDirectionalAction(idDirlight, cascadeIndex),
+            renderPassInfo,
+            *this->renderPassModule->DirShadowMappingLoadRenderPass,
+            [&](ShadowCasterLayer layer)
+            {
+                vkCmdBindPipeline(commandBuffers[iCBuffer], VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
+
+                vkCmdBindDescriptorSets(
+                    commandBuffers[iCBuffer],
+                    VK_PIPELINE_BIND_POINT_GRAPHICS,
+                    pipelineLayout,
+                    0,
+                    1,
+                    &descriptorSet,
+                    0,
+                    nullptr);
+
+                this->gameObjectManager->CSMCommand(
+                    commandBuffers[iCBuffer], iCBuffer, pipelineLayout, cascadeIndex,
+                    ShadowCasterCulling::getInstance()->GetDirectionalCasters(idDirlight, cascadeIndex), layer);
+            },
+            [&]() { csmResources->StoreStaticLayer(commandBuffers[iCBuffer], cascadeIndex); },
+            [&]() { csmResources->RestoreStaticLayer(commandBuffers[iCBuffer], cascadeIndex); });
     }
 }
 
@@ -293,23 +309,22 @@ void CommandPoolModule::setOmniShadowRenderPass(std::shared_ptr<VkRenderPass> re
     if (descriptorSet == VK_NULL_HANDLE)
         return;
 
-    uint32_t size = pointLight->shadowMappingResourcesPtr->TextureSize;
+    // Sin tile en el atlas la luz no proyecta sombra este frame
+    if (!pointLight->shadowMappingResourcesPtr->HasAtlasTile())
+        return;
+
+    const VkRect2D scissor = pointLight->shadowMappingResourcesPtr->GetAtlasRegion();
     auto depthBiasConstant = pointLight->shadowMappingResourcesPtr->DepthBiasConstant;
     auto depthBiasSlope = pointLight->shadowMappingResourcesPtr->DepthBiasSlope;
 
     VkViewport viewport{};
-    viewport.x = 0.0f;
-    viewport.y = 0.0f;
-    viewport.width = (float)size;
-    viewport.height = (float)size;
+    viewport.x = static_cast<float>(scissor.offset.x);
+    viewport.y = static_cast<float>(scissor.offset.y);
+    viewport.width = static_cast<float>(scissor.extent.width);
+    viewport.height = static_cast<float>(scissor.extent.height);
     viewport.minDepth = 0.0f;
     viewport.maxDepth = 1.0f;
 
-    VkRect2D scissor{};
-    scissor.offset = { 0, 0 };
-    scissor.extent.width = size;
-    scissor.extent.height = size;
-
     vkCmdSetViewport(commandBuffers[iCBuffer], 0, 1, &viewport);
     vkCmdSetScissor(commandBuffers[iCBuffer], 0, 1, &scissor);
 
@@ -318,6 +333,21 @@ void CommandPoolModule::setOmniShadowRenderPass(std::shared_ptr<VkRenderPass> re
     vkCmdSetDepthWriteEnable(commandBuffers[iCBuffer], true);
     vkCmdSetFrontFace(commandBuffers[iCBuffer], VK_FRONT_FACE_CLOCKWISE);
 
+    if (lightManager->IsLayeredPointShadowActive() && pointLight->shadowMappingResourcesPtr->GetLayeredFramebuffer() != VK_NULL_HANDLE)
+    {
+        // Las caras que reconstruyen su cache estatica necesitan su propio pase (clear + copia intermedia)
+        for (uint32_t faceId = 0; faceId < 6; faceId++)
+        {
+            if (this->shadowCacheManager->GetPointAction(idPointlight, faceId) == ShadowViewAction::RebuildStatic)
+            {
+                this->updateCubeMapFace(faceId, renderPass, idPointlight, commandBuffers[iCBuffer], iCBuffer);
+            }
+        }
+
+        this->updateCubeMapLayered(idPointlight, commandBuffers[iCBuffer], iCBuffer);
+        return;
+    }
+
     for (uint32_t faceId = 0; faceId < 6; faceId++)
     {
         this->updateCubeMapFace(faceId, renderPass, idPointlight, commandBuffers[iCBuffer], iCBuffer);
@@ -348,30 +378,28 @@ void CommandPoolModule::setSpotShadowRenderPass(std::shared_ptr<VkRenderPass> re
     if (descriptorSet == VK_NULL_HANDLE)
         return;
 
-    uint32_t size = spotLight->shadowMappingResourcesPtr->TextureSize;
+    // Sin tile en el atlas la luz no proyecta sombra este frame
+    if (!spotLight->shadowMappingResourcesPtr->HasAtlasTile())
+        return;
+
+    const VkRect2D scissor = spotLight->shadowMappingResourcesPtr->GetAtlasRegion();
     auto depthBiasConstant = spotLight->shadowMappingResourcesPtr->DepthBiasConstant;
     auto depthBiasSlope = spotLight->shadowMappingResourcesPtr->DepthBiasSlope;
 
     VkViewport viewport{};
-    viewport.x = 0.0f;
-    viewport.y = 0.0f;
-    viewport.width = static_cast<float>(size);
-    viewport.height = static_cast<float>(size);
+    viewport.x = static_cast<float>(scissor.offset.x);
+    viewport.y = static_cast<float>(scissor.offset.y);
+    viewport.width = static_cast<float>(scissor.extent.width);
+    viewport.height = static_cast<float>(scissor.extent.height);
     viewport.minDepth = 0.0f;
     viewport.maxDepth = 1.0f;
 
-    VkRect2D scissor{};
-    scissor.offset = { 0, 0 };
-    scissor.extent.width = size;
-    scissor.extent.height = size;
-
+    // El clear del render pass solo afecta al renderArea: el resto del atlas se conserva
     VkRenderPassBeginInfo renderPassInfo{};
     renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
     renderPassInfo.renderPass = *renderPass;
-    renderPassInfo.framebuffer = spotLight->shadowMappingResourcesPtr->frameBuffer;
-    renderPassInfo.renderArea.offset = { 0, 0 };
-    renderPassInfo.renderArea.extent.width = size;
-    renderPassInfo.renderArea.extent.height = size;
+    renderPassInfo.framebuffer = spotLight->shadowMappingResourcesPtr->GetFramebuffer();
+    renderPassInfo.renderArea = scissor;
 
     VkClearValue clearValues{};
     clearValues.depthStencil = { 1.0f, 0 };
@@ -389,79 +417,192 @@ void CommandPoolModule::setSpotShadowRenderPass(std::shared_ptr<VkRenderPass> re
     auto pipeline = lightManager->GetCSMPipelineModule()->pipeline;
     auto pipelineLayout = lightManager->GetCSMPipelineModule()->pipelineLayout;
 
-    vkCmdBeginRenderPass(commandBuffers[iCBuffer], &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
-    vkCmdBindPipeline(commandBuffers[iCBuffer], VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
-    vkCmdBindDescriptorSets(
-        commandBuffers[iCBuffer],
-        VK_PIPELINE_BIND_POINT_GRAPHICS,
-        pipelineLayout,
-        0,
-        1,
-        &descriptorSet,
-        0,
-        nullptr);
+    auto spotResources = spotLight->shadowMappingResourcesPtr;
 
-    this->gameObjectManager->CSMCommand(commandBuffers[iCBuffer], iCBuffer, pipelineLayout, 0);
-
-    vkCmdEndRenderPass(commandBuffers[iCBuffer]);
+    this->recordCachedShadowView(
+        commandBuffers[iCBuffer],
+        this->shadowCacheManager->GetSpotAction(idSpotlight),
+        renderPassInfo,
+        *this->renderPassModule->DirShadowMappingLoadRenderPass,
+        [&](ShadowCasterLayer layer)
+        {
+            vkCmdBindPipeline(commandBuffers[iCBuffer], VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
+            vkCmdBindDescriptorSets(
+                commandBuffers[iCBuffer],
+                VK_PIPELINE_BIND_POINT_GRAPHICS,
+                pipelineLayout,
+                0,
+                1,
+                &descriptorSet,
+                0,
+                nullptr);
+
+            this->gameObjectManager->CSMCommand(
+                commandBuffers[iCBuffer], iCBuffer, pipelineLayout, 0,
+                ShadowCasterCulling::getInstance()->GetSpotCasters(idSpotlight), layer);
+        },
+        [&]() { spotResources->StoreStaticLayer(commandBuffers[iCBuffer]); },
+        [&]() { spotResources->RestoreStaticLayer(commandBuffers[iCBuffer]); });
 }
 
 void CommandPoolModule::updateCubeMapFace(uint32_t faceIdx, std::shared_ptr<VkRenderPass> renderPass, uint32_t idPointlight, VkCommandBuffer commandBuffer, uint32_t iCBuffer)
 {
-    VkClearValue clearValues[2];
-    clearValues[0].color = { { 0.0f, 0.0f, 0.0f, 1.0f } };
-    clearValues[1].depthStencil = { 1.0f, 0 };
+    const ShadowViewAction action = this->shadowCacheManager->GetPointAction(idPointlight, faceIdx);
+    if (action == ShadowViewAction::Skip)
+        return;
+
+    VkClearValue clearValues{};
+    clearValues.depthStencil = { 1.0f, 0 };
 
     auto pointLight = this->lightManager->GetPointLights().at(idPointlight);
-    uint32_t size = pointLight->shadowMappingResourcesPtr->TextureSize;
+    auto omniResources = pointLight->shadowMappingResourcesPtr;
 
+    // Cada cara es una capa del atlas de point lights; el tile es el mismo en las seis
     VkRenderPassBeginInfo renderPassInfo{};
     renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
     renderPassInfo.renderPass = *renderPass;
-    renderPassInfo.framebuffer = pointLight->shadowMappingResourcesPtr->CubemapFacesFrameBuffers[faceIdx];
-    renderPassInfo.renderArea.offset = { 0, 0 };
-    renderPassInfo.renderArea.extent.width = size;
-    renderPassInfo.renderArea.extent.height = size;
-    renderPassInfo.clearValueCount = 2;
-    renderPassInfo.pClearValues = clearValues;
+    renderPassInfo.framebuffer = omniResources->GetFramebuffer(faceIdx);
+    renderPassInfo.renderArea = omniResources->GetAtlasRegion();
+    renderPassInfo.clearValueCount = 1;
+    renderPassInfo.pClearValues = &clearValues;
 
-    glm::mat4 viewMatrix = glm::mat4(1.0f);
-    switch (faceIdx)
-    {
-    case 0: // POSITIVE_X
-        viewMatrix = glm::rotate(viewMatrix, glm::radians(90.0f), glm::vec3(0.0f, 1.0f, 0.0f));
-        viewMatrix = glm::rotate(viewMatrix, glm::radians(180.0f), glm::vec3(1.0f, 0.0f, 0.0f));
-        break;
-    case 1:	// NEGATIVE_X
-        viewMatrix = glm::rotate(viewMatrix, glm::radians(-90.0f), glm::vec3(0.0f, 1.0f, 0.0f));
-        viewMatrix = glm::rotate(viewMatrix, glm::radians(180.0f), glm::vec3(1.0f, 0.0f, 0.0f));
-        break;
-    case 2:	// POSITIVE_Y
-        viewMatrix = glm::rotate(viewMatrix, glm::radians(-90.0f), glm::vec3(1.0f, 0.0f, 0.0f));
-        break;
-    case 3:	// NEGATIVE_Y
-        viewMatrix = glm::rotate(viewMatrix, glm::radians(90.0f), glm::vec3(1.0f, 0.0f, 0.0f));
-        break;
-    case 4:	// POSITIVE_Z
-        viewMatrix = glm::rotate(viewMatrix, glm::radians(180.0f), glm::vec3(1.0f, 0.0f, 0.0f));
-        break;
-    case 5:	// NEGATIVE_Z
-        viewMatrix = glm::rotate(viewMatrix, glm::radians(180.0f), glm::vec3(0.0f, 0.0f, 1.0f));
-        break;
-    }
+    const glm::mat4 viewMatrix = OmniShadowResources::GetCubeFaceViewMatrix(faceIdx);
+    const glm::vec3 lightPosition = pointLight->transform->GetWorldPosition();
 
     auto pipeline = lightManager->GetOmniShadowPipelineModule()->pipeline;
     auto pipelineLayout = lightManager->GetOmniShadowPipelineModule()->pipelineLayout;
 
+    this->recordCachedShadowView(
+        commandBuffer,
+        action,
+        renderPassInfo,
+        *this->renderPassModule->DirShadowMappingLoadRenderPass,
+        [&](ShadowCasterLayer layer)
+        {
+            vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
+            vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, 0, 1, &lightManager->GetPointShadowDescriptors()->offscreenDescriptorSets[iCBuffer][idPointlight], 0, NULL);
+
+            this->gameObjectManager->OmniShadowCommand(
+                commandBuffers[iCBuffer], iCBuffer, pipelineLayout, viewMatrix, lightPosition,
+                ShadowCasterCulling::getInstance()->GetPointCasters(idPointlight, faceIdx), layer);
+        },
+        [&]() { omniResources->StoreStaticLayer(commandBuffer, faceIdx); },
+        [&]() { omniResources->RestoreStaticLayer(commandBuffer, faceIdx); });
+}
+
+void CommandPoolModule::updateCubeMapLayered(uint32_t idPointlight, VkCommandBuffer commandBuffer, uint32_t iCBuffer)
+{
+    uint32_t fullMask = 0;
+    uint32_t compositeMask = 0;
+    for (uint32_t faceIdx = 0; faceIdx < 6; ++faceIdx)
+    {
+        const ShadowViewAction action = this->shadowCacheManager->GetPointAction(idPointlight, faceIdx);
+        if (action == ShadowViewAction::RenderFull)
+            fullMask |= 1u << faceIdx;
+        else if (action == ShadowViewAction::CompositeDynamic)
+            compositeMask |= 1u << faceIdx;
+    }
+
+    if ((fullMask | compositeMask) == 0)
+        return;
+
+    auto pointLight = this->lightManager->GetPointLights().at(idPointlight);
+    auto omniResources = pointLight->shadowMappingResourcesPtr;
+    const VkRect2D region = omniResources->GetAtlasRegion();
+
+    for (uint32_t faceIdx = 0; faceIdx < 6; ++faceIdx)
+    {
+        if (compositeMask & (1u << faceIdx))
+        {
+            omniResources->RestoreStaticLayer(commandBuffer, faceIdx);
+        }
+    }
+
+    // Pase LOAD sobre las 6 capas: solo se limpian las caras que se redibujan enteras
+    VkRenderPassBeginInfo renderPassInfo{};
+    renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+    renderPassInfo.renderPass = *this->renderPassModule->DirShadowMappingLoadRenderPass;
+    renderPassInfo.framebuffer = omniResources->GetLayeredFramebuffer();
+    renderPassInfo.renderArea = region;
+
     vkCmdBeginRenderPass(commandBuffer, &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
+
+    if (fullMask != 0)
+    {
+        VkClearAttachment clearAttachment{};
+        clearAttachment.aspectMask = VK_IMAGE_ASPECT_DEPTH_BIT;
+        clearAttachment.clearValue.depthStencil = { 1.0f, 0 };
+
+        std::vector<VkClearRect> clearRects;
+        for (uint32_t faceIdx = 0; faceIdx < 6; ++faceIdx)
+        {
+            if (fullMask & (1u << faceIdx))
+            {
+                clearRects.push_back({ region, faceIdx, 1 });
+            }
+        }
+
+        vkCmdClearAttachments(commandBuffer, 1, &clearAttachment, static_cast<uint32_t>(clearRects.size()), clearRects.data());
+    }
+
+    auto pipeline = lightManager->GetOmniShadowLayeredPipelineModule()->pipeline;
+    auto pipelineLayout = lightManager->GetOmniShadowLayeredPipelineModule()->pipelineLayout;
+
     vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
     vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, 0, 1, &lightManager->GetPointShadowDescriptors()->offscreenDescriptorSets[iCBuffer][idPointlight], 0, NULL);
 
-    this->gameObjectManager->OmniShadowCommand(commandBuffers[iCBuffer], iCBuffer, pipelineLayout, viewMatrix, pointLight->transform->GetWorldPosition());
+    this->gameObjectManager->OmniShadowLayeredCommand(
+        commandBuffer, iCBuffer, pipelineLayout, pointLight->transform->GetWorldPosition(),
+        ShadowCasterCulling::getInstance()->GetPointCasterMasks(idPointlight), fullMask, compositeMask);
 
     vkCmdEndRenderPass(commandBuffer);
 }
 
+void CommandPoolModule::recordCachedShadowView(
+    VkCommandBuffer commandBuffer,
+    ShadowViewAction action,
+    VkRenderPassBeginInfo renderPassInfo,
+    VkRenderPass loadRenderPass,
+    const std::function<void(ShadowCasterLayer)>& drawCasters,
+    const std::function<void()>& storeStaticLayer,
+    const std::function<void()>& restoreStaticLayer)
+{
+    switch (action)
+    {
+    case ShadowViewAction::Skip:
+        return;
+
+    case ShadowViewAction::RebuildStatic:
+        vkCmdBeginRenderPass(commandBuffer, &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
+        drawCasters(ShadowCasterLayer::Static);
+        vkCmdEndRenderPass(commandBuffer);
+
+        storeStaticLayer();
+
+        renderPassInfo.renderPass = loadRenderPass;
+        vkCmdBeginRenderPass(commandBuffer, &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
+        drawCasters(ShadowCasterLayer::Dynamic);
+        vkCmdEndRenderPass(commandBuffer);
+        return;
+
+    case ShadowViewAction::CompositeDynamic:
+        restoreStaticLayer();
+
+        renderPassInfo.renderPass = loadRenderPass;
+        vkCmdBeginRenderPass(commandBuffer, &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
+        drawCasters(ShadowCasterLayer::Dynamic);
+        vkCmdEndRenderPass(commandBuffer);
+        return;
+
+    default:
+    case ShadowViewAction::RenderFull:
+        vkCmdBeginRenderPass(commandBuffer, &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
+        drawCasters(ShadowCasterLayer::All);
+        vkCmdEndRenderPass(commandBuffer);
+        return;
+    }
+}
+
 void CommandPoolModule::Render(
     FramebufferModule* framebufferModule,
     const QERenderTarget* extraRenderTarget,
@@ -483,45 +624,237 @@ void CommandPoolModule::Render(
         throw std::runtime_error("failed to begin recording command buffer!");
     }
 
-    for (uint32_t idDirLight = 0; idDirLight < this->lightManager->GetDirectionalLights().size(); idDirLight++)
+    QEGpuProfiler::getInstance()->BeginFrame(cmd, currentFrame);
+
+    this->buildFrameGraph(framebufferModule, extraRenderTarget, extraScenePass, extraOverlayPass, currentFrame);
+    this->renderGraph.Compile([this](const QERGImageDesc& desc) { return this->transientPool.GetRequirements(desc); });
+    this->transientPool.Realize(this->renderGraph);
+    this->renderGraph.Execute(cmd);
+
+    QEGpuProfiler::getInstance()->EndFrame(cmd, currentFrame);
+
+    if (vkEndCommandBuffer(cmd) != VK_SUCCESS)
+    {
+        throw std::runtime_error("failed to record command buffer!");
+    }
+}
+
+void CommandPoolModule::buildFrameGraph(
+    FramebufferModule* framebufferModule,
+    const QERenderTarget* extraRenderTarget,
+    const std::function<void(VkCommandBuffer&, uint32_t)>& extraScenePass,
+    const std::function<void(VkCommandBuffer&, uint32_t)>& extraOverlayPass,
+    uint32_t currentFrame)
+{
+    QERenderGraph& graph = this->renderGraph;
+    graph.Reset();
+
+    // Los mapas de sombra viven en DEPTH_STENCIL_READ_ONLY; DirShadowMappingRenderPass ya sincroniza
+    // la lectura del frame anterior y deja la escritura visible para el fragment shader
+    const QERGImageState shadowState{
+        VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL,
+        VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+        VK_ACCESS_SHADER_READ_BIT };
+
+    auto shadowWrite = [](QERGResourceId resource)
+        {
+            QERGAccess access = QERGAccess::ReadWrite(
+                resource,
+                VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL,
+                VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT,
+                VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT);
+            access.AcquireStages = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+            access.AcquireAccess = VK_ACCESS_SHADER_READ_BIT;
+            access.ReleaseStages = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+            access.ReleaseAccess = VK_ACCESS_SHADER_READ_BIT;
+            return access;
+        };
+
+    auto shadowRead = [](QERGResourceId resource)
+        {
+            return QERGAccess::Read(
+                resource,
+                VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL,
+                VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+                VK_ACCESS_SHADER_READ_BIT);
+        };
+
+    // Destino de color de un render pass con initialLayout UNDEFINED
+    auto colorTargetWrite = [](QERGResourceId resource, VkImageLayout finalLayout)
+        {
+            QERGAccess access = QERGAccess::Overwrite(
+                resource,
+                VK_IMAGE_LAYOUT_UNDEFINED,
+                VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+                VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT);
+            access.FinalLayout = finalLayout;
+            access.AcquireStages = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT;
+            return access;
+        };
+
+    std::vector<QERGResourceId> shadowMaps;
+
+    std::vector<QERGResourceId> csmMaps;
+    const auto& dirLights = this->lightManager->GetDirectionalLights();
+    for (uint32_t idDirLight = 0; idDirLight < dirLights.size() && idDirLight < MAX_NUM_DIR_LIGHTS; idDirLight++)
     {
-        this->setDirectionalShadowRenderPass(this->renderPassModule->DirShadowMappingRenderPass, idDirLight, currentFrame);
+        const auto& dirLight = dirLights[idDirLight];
+        if (!dirLight || !dirLight->shadowMappingResourcesPtr)
+            continue;
+
+        QERGImageDesc desc{};
+        desc.Format = dirLight->shadowMappingResourcesPtr->shadowFormat;
+        desc.Extent = { CSMResources::TextureSize, CSMResources::TextureSize };
+        desc.Layers = SHADOW_MAP_CASCADE_COUNT;
+        desc.Aspect = VK_IMAGE_ASPECT_DEPTH_BIT;
+        if (CSMResources::HasStencilComponent(desc.Format))
+            desc.Aspect |= VK_IMAGE_ASPECT_STENCIL_BIT;
+
+        csmMaps.push_back(graph.ImportImage("CSM", dirLight->shadowMappingResourcesPtr->GetImage(), desc, shadowState));
     }
 
-    for (uint32_t idPointLight = 0; idPointLight < this->lightManager->GetPointLights().size(); idPointLight++)
+    auto importAtlas = [&](const char* name, const std::shared_ptr<ShadowAtlasResources>& atlas)
+        {
+            if (!atlas)
+                return QE_RG_INVALID_RESOURCE;
+
+            QERGImageDesc desc{};
+            desc.Format = atlas->GetFormat();
+            desc.Extent = { atlas->GetAtlasSize(), atlas->GetAtlasSize() };
+            desc.Layers = atlas->GetLayerCount();
+            desc.Aspect = atlas->GetAspectMask();
+            return graph.ImportImage(name, atlas->GetImage(), desc, shadowState);
+        };
+
+    auto shadowAtlasManager = ShadowAtlasManager::getInstance();
+    const QERGResourceId pointAtlas = importAtlas("PointShadowAtlas", shadowAtlasManager->GetPointAtlas());
+    const QERGResourceId spotAtlas = importAtlas("SpotShadowAtlas", shadowAtlasManager->GetSpotAtlas());
+
+    const uint32_t csmPass = graph.AddPass("DirectionalShadows", [this, currentFrame](VkCommandBuffer, const QERenderGraph&)
+        {
+            for (uint32_t idDirLight = 0; idDirLight < this->lightManager->GetDirectionalLights().size(); idDirLight++)
+            {
+                this->setDirectionalShadowRenderPass(this->renderPassModule->DirShadowMappingRenderPass, idDirLight, currentFrame);
+            }
+        });
+    for (QERGResourceId csm : csmMaps)
     {
-        this->setOmniShadowRenderPass(this->renderPassModule->OmniShadowMappingRenderPass, idPointLight, currentFrame);
+        graph.Use(csmPass, shadowWrite(csm));
+        shadowMaps.push_back(csm);
     }
 
-    for (uint32_t idSpotLight = 0; idSpotLight < this->lightManager->GetSpotLights().size(); idSpotLight++)
+    if (pointAtlas != QE_RG_INVALID_RESOURCE)
     {
-        this->setSpotShadowRenderPass(this->renderPassModule->DirShadowMappingRenderPass, idSpotLight, currentFrame);
+        const uint32_t pointPass = graph.AddPass("PointShadows", [this, currentFrame](VkCommandBuffer, const QERenderGraph&)
+            {
+                for (uint32_t idPointLight = 0; idPointLight < this->lightManager->GetPointLights().size(); idPointLight++)
+                {
+                    this->setOmniShadowRenderPass(this->renderPassModule->DirShadowMappingRenderPass, idPointLight, currentFrame);
+                }
+            });
+        graph.Use(pointPass, shadowWrite(pointAtlas));
+        shadowMaps.push_back(pointAtlas);
     }
 
+    if (spotAtlas != QE_RG_INVALID_RESOURCE)
+    {
+        const uint32_t spotPass = graph.AddPass("SpotShadows", [this, currentFrame](VkCommandBuffer, const QERenderGraph&)
+            {
+                for (uint32_t idSpotLight = 0; idSpotLight < this->lightManager->GetSpotLights().size(); idSpotLight++)
+                {
+                    this->setSpotShadowRenderPass(this->renderPassModule->DirShadowMappingRenderPass, idSpotLight, currentFrame);
+                }
+            });
+        graph.Use(spotPass, shadowWrite(spotAtlas));
+        shadowMaps.push_back(spotAtlas);
+    }
+
+    QERGImageDesc swapchainDesc{};
+    swapchainDesc.Format = swapchainModule->swapChainImageFormat;
+    swapchainDesc.Extent = swapchainModule->swapChainExtent;
+
+    // La espera del semaforo de adquisicion ocurre en COLOR_ATTACHMENT_OUTPUT
+    const QERGImageState acquiredState{ VK_IMAGE_LAYOUT_UNDEFINED, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, 0 };
+    auto importBackbuffer = [&]()
+        {
+            return graph.ImportImage(
+                "Backbuffer",
+                swapchainModule->swapChainImages[swapchainModule->currentImage],
+                swapchainDesc,
+                acquiredState,
+                true,
+                VK_IMAGE_LAYOUT_PRESENT_SRC_KHR);
+        };
+
     const bool hasEditorViewport = (extraRenderTarget != nullptr && extraRenderTarget->Valid());
 
     if (hasEditorViewport)
     {
-        this->RenderSceneToTarget(*extraRenderTarget, currentFrame, extraScenePass);
+        const bool hasSwapchain = framebufferModule != nullptr;
+
+        QERGImageDesc viewportDesc{};
+        viewportDesc.Format = swapchainModule->swapChainImageFormat;
+        viewportDesc.Extent = extraRenderTarget->Extent;
+
+        // Con UI lo ultimo que hizo la imagen fue ser muestreada por ImGui; sin UI (headless), su propio resolve
+        const QERGImageState viewportState = hasSwapchain ?
+            QERGImageState{ VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT } :
+            QERGImageState{ VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT };
+
+        const QERGResourceId viewportColor = graph.ImportImage(
+            "ViewportColor", extraRenderTarget->ColorImage, viewportDesc, viewportState, !hasSwapchain);
+
+        const uint32_t scenePass = graph.AddPass("SceneViewport",
+            [this, extraRenderTarget, &extraScenePass, currentFrame](VkCommandBuffer, const QERenderGraph&)
+            {
+                this->RenderSceneToTarget(*extraRenderTarget, currentFrame, extraScenePass);
+            });
+        for (QERGResourceId shadowMap : shadowMaps)
+        {
+            graph.Use(scenePass, shadowRead(shadowMap));
+        }
+        graph.Use(scenePass, colorTargetWrite(viewportColor, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL));
 
         if (extraOverlayPass)
         {
-            extraOverlayPass(commandBuffers[currentFrame], currentFrame);
+            graph.AddPass("EditorOverlay", [this, &extraOverlayPass, currentFrame](VkCommandBuffer, const QERenderGraph&)
+                {
+                    extraOverlayPass(commandBuffers[currentFrame], currentFrame);
+                }, true);
         }
 
-        this->setSwapchainImGuiRenderPass(framebufferModule->swapChainFramebuffers[swapchainModule->currentImage], currentFrame);
-    }
-    else
-    {
-        this->setCustomRenderPass(
-            framebufferModule->swapChainFramebuffers[swapchainModule->currentImage],
-            currentFrame,
-            extraScenePass);
+        // Sin framebufferModule (headless) no hay imagen de swapchain sobre la que pintar la UI
+        if (hasSwapchain)
+        {
+            const QERGResourceId backbuffer = importBackbuffer();
+            const uint32_t imguiPass = graph.AddPass("ImGui", [this, framebufferModule, currentFrame](VkCommandBuffer, const QERenderGraph&)
+                {
+                    this->setSwapchainImGuiRenderPass(framebufferModule->swapChainFramebuffers[swapchainModule->currentImage], currentFrame);
+                });
+            graph.Use(imguiPass, QERGAccess::Read(
+                viewportColor,
+                VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+                VK_ACCESS_SHADER_READ_BIT));
+            graph.Use(imguiPass, colorTargetWrite(backbuffer, VK_IMAGE_LAYOUT_PRESENT_SRC_KHR));
+        }
     }
-
-    if (vkEndCommandBuffer(cmd) != VK_SUCCESS)
+    else if (framebufferModule != nullptr)
     {
-        throw std::runtime_error("failed to record command buffer!");
+        const QERGResourceId backbuffer = importBackbuffer();
+        const uint32_t scenePass = graph.AddPass("Scene",
+            [this, framebufferModule, &extraScenePass, currentFrame](VkCommandBuffer, const QERenderGraph&)
+            {
+                this->setCustomRenderPass(
+                    framebufferModule->swapChainFramebuffers[swapchainModule->currentImage],
+                    currentFrame,
+                    extraScenePass);
+            });
+        for (QERGResourceId shadowMap : shadowMaps)
+        {
+            graph.Use(scenePass, shadowRead(shadowMap));
+        }
+        graph.Use(scenePass, colorTargetWrite(backbuffer, VK_IMAGE_LAYOUT_PRESENT_SRC_KHR));
     }
 }
 
@@ -596,7 +929,9 @@ void CommandPoolModule::recordComputeCommandBuffer(VkCommandBuffer commandBuffer
         throw std::runtime_error("failed to begin recording compute command buffer!");
     }
 
+    QEGpuProfiler::getInstance()->BeginFrame(commandBuffer, (uint32_t)currentFrame, QEGpuQueue::Compute);
     computeNodeManager->RecordComputeNodes(commandBuffer, (uint32_t)currentFrame);
+    QEGpuProfiler::getInstance()->EndFrame(commandBuffer, (uint32_t)currentFrame, QEGpuQueue::Compute);
 
     if (vkEndCommandBuffer(commandBuffer) != VK_SUCCESS) {
         throw std::runtime_error("failed to record compute command buffer!");
@@ -605,6 +940,7 @@ void CommandPoolModule::recordComputeCommandBuffer(VkCommandBuffer commandBuffer
 
 void CommandPoolModule::cleanup()
 {
+    this->transientPool.Cleanup();
     vkDestroyCommandPool(deviceModule->device, computeCommandPool, nullptr);
     vkDestroyCommandPool(deviceModule->device, commandPool, nullptr);
 }
@@ -16,6 +16,8 @@
 #include <DebugSystem/QEDebugSystem.h>
 #include <QESingleton.h>
 #include <QERenderTarget.h>
+#include <QERenderGraph.h>
+#include <QERenderGraphTransientPool.h>
 
 class CommandPoolModule : public QESingleton<CommandPoolModule>
 {
@@ -27,6 +29,7 @@ private:
     ComputeNodeManager*             computeNodeManager;
     CullingSceneManager*            cullingSceneManager;
     LightManager*                   lightManager;
+    ShadowCacheManager*             shadowCacheManager;
     RenderPassModule*               renderPassModule;
     AtmosphereSystem*               atmosphereSystem;
     QEDebugSystem*                  debugSystem;
@@ -36,6 +39,9 @@ private:
     std::vector<VkCommandBuffer>    commandBuffers;
     std::vector<VkCommandBuffer>    computeCommandBuffers;
 
+    QERenderGraph                   renderGraph;
+    QERenderGraphTransientPool      transientPool;
+
 public:
     glm::vec3 ClearColor;
 
@@ -49,6 +55,21 @@ private:
     void setOmniShadowRenderPass(std::shared_ptr<VkRenderPass> renderPass, uint32_t idPointlight, uint32_t iCBuffer);
     void setSpotShadowRenderPass(std::shared_ptr<VkRenderPass> renderPass, uint32_t idSpotlight, uint32_t iCBuffer);
     void updateCubeMapFace(uint32_t faceIdx, std::shared_ptr<VkRenderPass> renderPass, uint32_t idPointlight, VkCommandBuffer commandBuffer, uint32_t iCBuffer);
+    void updateCubeMapLayered(uint32_t idPointlight, VkCommandBuffer commandBuffer, uint32_t iCBuffer);
+    void recordCachedShadowView(
+        VkCommandBuffer commandBuffer,
+        ShadowViewAction action,
+        VkRenderPassBeginInfo renderPassInfo,
+        VkRenderPass loadRenderPass,
+        const std::function<void(ShadowCasterLayer)>& drawCasters,
+        const std::function<void()>& storeStaticLayer,
+        const std::function<void()>& restoreStaticLayer);
+    void buildFrameGraph(
+        FramebufferModule* framebufferModule,
+        const QERenderTarget* extraRenderTarget,
+        const std::function<void(VkCommandBuffer&, uint32_t)>& extraScenePass,
+        const std::function<void(VkCommandBuffer&, uint32_t)>& extraOverlayPass,
+        uint32_t currentFrame);
 public:
     CommandPoolModule();
 
@@ -59,6 +80,7 @@ public:
     uint32_t                        getNumCommandBuffers() { return static_cast<uint32_t>(this->commandBuffers.size()); }
     VkCommandBuffer&                getCommandBuffer(uint32_t idx) { return this->commandBuffers.at(idx); }
     VkCommandBuffer&                getComputeCommandBuffer(uint32_t idx) { return this->computeCommandBuffers.at(idx); }
+    const QERenderGraph&            getRenderGraph() const { return this->renderGraph; }
 
     void createCommandPool(VkSurfaceKHR& surface);
     void createCommandBuffers();
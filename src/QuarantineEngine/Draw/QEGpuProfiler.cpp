@@ -0,0 +1,97 @@
+#include "QEGpuProfiler.h"
+
+#include <stdexcept>
+#include <DeviceModule.h>
+
+void QEGpuProfiler::Initialize(DeviceModule* deviceModule, uint32_t framesInFlight)
+{
+    this->deviceModule = deviceModule;
+    this->framesInFlight = framesInFlight;
+    this->pendingFrames.assign(framesInFlight * QUEUE_COUNT, false);
+    for (double& busyMs : this->lastBusyMs)
+    {
+        busyMs = 0.0;
+    }
+
+    const VkPhysicalDeviceLimits& limits = deviceModule->physicalDeviceProps.limits;
+    if (!limits.timestampComputeAndGraphics || limits.timestampPeriod <= 0.0f)
+        return;
+
+    this->timestampPeriod = limits.timestampPeriod;
+
+    VkQueryPoolCreateInfo queryPoolInfo{};
+    queryPoolInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+    queryPoolInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+    queryPoolInfo.queryCount = framesInFlight * QUEUE_COUNT * 2;
+
+    if (vkCreateQueryPool(deviceModule->device, &queryPoolInfo, nullptr, &queryPool) != VK_SUCCESS)
+    {
+        throw std::runtime_error("failed to create GPU timestamp query pool!");
+    }
+}
+
+void QEGpuProfiler::Cleanup()
+{
+    if (queryPool != VK_NULL_HANDLE && deviceModule != nullptr)
+    {
+        vkDestroyQueryPool(deviceModule->device, queryPool, nullptr);
+    }
+
+    queryPool = VK_NULL_HANDLE;
+    deviceModule = nullptr;
+    pendingFrames.clear();
+}
+
+void QEGpuProfiler::BeginFrame(VkCommandBuffer commandBuffer, uint32_t frame, QEGpuQueue queue)
+{
+    if (queryPool == VK_NULL_HANDLE || frame >= framesInFlight)
+        return;
+
+    const uint32_t firstQuery = FirstQuery(frame, queue);
+    vkCmdResetQueryPool(commandBuffer, queryPool, firstQuery, 2);
+    vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, queryPool, firstQuery);
+}
+
+void QEGpuProfiler::EndFrame(VkCommandBuffer commandBuffer, uint32_t frame, QEGpuQueue queue)
+{
+    if (queryPool == VK_NULL_HANDLE || frame >= framesInFlight)
+        return;
+
+    vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, queryPool, FirstQuery(frame, queue) + 1);
+    pendingFrames[frame * QUEUE_COUNT + static_cast<uint32_t>(queue)] = true;
+}
+
+void QEGpuProfiler::CollectFrame(uint32_t frame)
+{
+    if (queryPool == VK_NULL_HANDLE || frame >= framesInFlight)
+        return;
+
+    for (uint32_t queue = 0; queue < QUEUE_COUNT; ++queue)
+    {
+        const uint32_t pendingIndex = frame * QUEUE_COUNT + queue;
+        if (!pendingFrames[pendingIndex])
+            continue;
+
+        uint64_t timestamps[2] = { 0, 0 };
+        const VkResult result = vkGetQueryPoolResults(
+            deviceModule->device,
+            queryPool,
+            FirstQuery(frame, static_cast<QEGpuQueue>(queue)),
+            2,
+            sizeof(timestamps),
+            timestamps,
+            sizeof(uint64_t),
+            VK_QUERY_RESULT_64_BIT);
+
+        // VK_NOT_READY: el frame aun no ha terminado, se reintenta en la siguiente vuelta
+        if (result != VK_SUCCESS)
+            continue;
+
+        pendingFrames[pendingIndex] = false;
+
+        if (timestamps[1] >= timestamps[0])
+        {
+            lastBusyMs[queue] = static_cast<double>(timestamps[1] - timestamps[0]) * timestampPeriod * 1e-6;
+        }
+    }
+}
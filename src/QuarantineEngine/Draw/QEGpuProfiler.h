@@ -0,0 +1,67 @@
+#pragma once
+#ifndef QE_GPU_PROFILER_H
+#define QE_GPU_PROFILER_H
+
+#include <vulkan/vulkan.h>
+#include <vector>
+#include <QESingleton.h>
+
+class DeviceModule;
+
+enum class QEGpuQueue : uint32_t
+{
+    Graphics = 0,
+    Compute = 1,
+    Count = 2
+};
+
+/// Tiempo de GPU por frame y por cola mediante timestamps (un par de consultas por cola y frame en vuelo).
+/// El resultado de un frame se recoge cuando ya se ha esperado su slot, asi nunca bloquea.
+class QEGpuProfiler : public QESingleton<QEGpuProfiler>
+{
+private:
+    friend class QESingleton<QEGpuProfiler>;
+
+    static constexpr uint32_t QUEUE_COUNT = static_cast<uint32_t>(QEGpuQueue::Count);
+
+    DeviceModule* deviceModule = nullptr;
+    VkQueryPool queryPool = VK_NULL_HANDLE;
+    float timestampPeriod = 0.0f;       // Nanosegundos por tick
+    uint32_t framesInFlight = 0;
+    std::vector<bool> pendingFrames;    // [frame * QUEUE_COUNT + queue]
+    double lastBusyMs[QUEUE_COUNT] = {};
+
+private:
+    uint32_t FirstQuery(uint32_t frame, QEGpuQueue queue) const
+    {
+        return (frame * QUEUE_COUNT + static_cast<uint32_t>(queue)) * 2;
+    }
+
+public:
+    QEGpuProfiler() = default;
+
+    void Initialize(DeviceModule* deviceModule, uint32_t framesInFlight);
+    void Cleanup();
+
+    bool IsSupported() const { return queryPool != VK_NULL_HANDLE; }
+
+    /// Primer y ultimo comando del command buffer del frame en esa cola.
+    void BeginFrame(VkCommandBuffer commandBuffer, uint32_t frame, QEGpuQueue queue = QEGpuQueue::Graphics);
+    void EndFrame(VkCommandBuffer commandBuffer, uint32_t frame, QEGpuQueue queue = QEGpuQueue::Graphics);
+    /// Llamar despues de esperar el slot del frame: lee sus timestamps si estan disponibles.
+    void CollectFrame(uint32_t frame);
+
+    double GetLastGpuFrameMs() const { return lastBusyMs[static_cast<uint32_t>(QEGpuQueue::Graphics)]; }
+    /// Tiempo ocupado de cada cola en su ultimo frame medido.
+    double GetLastQueueBusyMs(QEGpuQueue queue) const { return lastBusyMs[static_cast<uint32_t>(queue)]; }
+};
+
+
+
+namespace QE
+{
+    using ::QEGpuQueue;
+    using ::QEGpuProfiler;
+} // namespace QE
+// QE namespace aliases
+#endif // !QE_GPU_PROFILER_H
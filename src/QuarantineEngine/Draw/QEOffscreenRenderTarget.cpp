@@ -0,0 +1,167 @@
+#include "QEOffscreenRenderTarget.h"
+
+#include <stdexcept>
+#include <DeviceModule.h>
+#include <RenderPassModule.h>
+#include <TextureManagerModule.h>
+#include <SwapChainModule.h>
+#include <DepthBufferModule.h>
+#include <Helpers/QEMemoryTrack.h>
+
+void QEOffscreenRenderTarget::Create(DeviceModule* deviceModule, RenderPassModule* renderPassModule, uint32_t width, uint32_t height)
+{
+    this->Cleanup();
+
+    this->deviceModule = deviceModule;
+    this->renderPassModule = renderPassModule;
+
+    renderTarget.RenderPass = *renderPassModule->ViewportRenderPass;
+    renderTarget.Extent = { width, height };
+
+    CreateImages();
+    CreateFramebuffer();
+}
+
+void QEOffscreenRenderTarget::Cleanup()
+{
+    if (deviceModule == nullptr)
+        return;
+
+    VkDevice device = deviceModule->device;
+
+    if (renderTarget.Framebuffer != VK_NULL_HANDLE)
+        vkDestroyFramebuffer(device, renderTarget.Framebuffer, nullptr);
+
+    const VkImageView views[] = { resolveImageView, msaaColorImageView, depthImageView };
+    for (VkImageView view : views)
+    {
+        if (view != VK_NULL_HANDLE)
+            vkDestroyImageView(device, view, nullptr);
+    }
+
+    const VkImage images[] = { resolveImage, msaaColorImage, depthImage };
+    for (VkImage image : images)
+    {
+        if (image != VK_NULL_HANDLE)
+            vkDestroyImage(device, image, nullptr);
+    }
+
+    const VkDeviceMemory memories[] = { resolveMemory, msaaColorMemory, depthMemory };
+    for (VkDeviceMemory memory : memories)
+    {
+        if (memory != VK_NULL_HANDLE)
+            QE_FREE_MEMORY(device, memory, "QEOffscreenRenderTarget::Cleanup");
+    }
+
+    *this = QEOffscreenRenderTarget();
+}
+
+VkImageView QEOffscreenRenderTarget::CreateView(VkImage image, VkFormat format, VkImageAspectFlags aspect)
+{
+    VkImageViewCreateInfo viewInfo{};
+    viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+    viewInfo.image = image;
+    viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+    viewInfo.format = format;
+    viewInfo.subresourceRange.aspectMask = aspect;
+    viewInfo.subresourceRange.baseMipLevel = 0;
+    viewInfo.subresourceRange.levelCount = 1;
+    viewInfo.subresourceRange.baseArrayLayer = 0;
+    viewInfo.subresourceRange.layerCount = 1;
+
+    VkImageView view = VK_NULL_HANDLE;
+    if (vkCreateImageView(deviceModule->device, &viewInfo, nullptr, &view) != VK_SUCCESS)
+    {
+        throw std::runtime_error("failed to create offscreen render target image view!");
+    }
+    return view;
+}
+
+void QEOffscreenRenderTarget::CreateImages()
+{
+    const uint32_t width = renderTarget.Extent.width;
+    const uint32_t height = renderTarget.Extent.height;
+
+    const VkFormat colorFormat = SwapChainModule::getInstance()->swapChainImageFormat;
+    const VkFormat depthFormat = DepthBufferModule::getInstance()->findDepthFormat();
+    const VkSampleCountFlagBits msaaSamples = *deviceModule->getMsaaSamples();
+
+    // 1) COLOR MSAA
+    {
+        TextureManagerModule colorTexture;
+        colorTexture.createImage(
+            width, height, colorFormat,
+            VK_IMAGE_TILING_OPTIMAL,
+            VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT | VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT,
+            VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+            1, 1, msaaSamples);
+
+        msaaColorImage = colorTexture.image;
+        msaaColorMemory = colorTexture.deviceMemory;
+        colorTexture.image = VK_NULL_HANDLE;
+        colorTexture.deviceMemory = VK_NULL_HANDLE;
+
+        msaaColorImageView = CreateView(msaaColorImage, colorFormat, VK_IMAGE_ASPECT_COLOR_BIT);
+    }
+
+    // 2) DEPTH MSAA
+    {
+        TextureManagerModule depthTexture;
+        depthTexture.createImage(
+            width, height, depthFormat,
+            VK_IMAGE_TILING_OPTIMAL,
+            VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT,
+            VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+            1, 1, msaaSamples);
+
+        depthImage = depthTexture.image;
+        depthMemory = depthTexture.deviceMemory;
+        depthTexture.image = VK_NULL_HANDLE;
+        depthTexture.deviceMemory = VK_NULL_HANDLE;
+
+        depthImageView = CreateView(depthImage, depthFormat, VK_IMAGE_ASPECT_DEPTH_BIT);
+    }
+
+    // 3) RESOLVE: TRANSFER_SRC para poder volcar capturas del benchmark
+    {
+        TextureManagerModule resolveTexture;
+        resolveTexture.createImage(
+            width, height, colorFormat,
+            VK_IMAGE_TILING_OPTIMAL,
+            VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT,
+            VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+            1, 1, VK_SAMPLE_COUNT_1_BIT);
+
+        resolveImage = resolveTexture.image;
+        renderTarget.ColorImage = resolveImage;
+        resolveMemory = resolveTexture.deviceMemory;
+        resolveTexture.image = VK_NULL_HANDLE;
+        resolveTexture.deviceMemory = VK_NULL_HANDLE;
+
+        resolveImageView = CreateView(resolveImage, colorFormat, VK_IMAGE_ASPECT_COLOR_BIT);
+    }
+}
+
+void QEOffscreenRenderTarget::CreateFramebuffer()
+{
+    VkImageView attachments[] =
+    {
+        msaaColorImageView,
+        depthImageView,
+        resolveImageView
+    };
+
+    VkFramebufferCreateInfo framebufferInfo{};
+    framebufferInfo.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
+    framebufferInfo.renderPass = renderTarget.RenderPass;
+    framebufferInfo.attachmentCount = 3;
+    framebufferInfo.pAttachments = attachments;
+    framebufferInfo.width = renderTarget.Extent.width;
+    framebufferInfo.height = renderTarget.Extent.height;
+    framebufferInfo.layers = 1;
+
+    if (vkCreateFramebuffer(deviceModule->device, &framebufferInfo, nullptr, &renderTarget.Framebuffer) != VK_SUCCESS)
+    {
+        throw std::runtime_error("failed to create offscreen framebuffer!");
+    }
+}
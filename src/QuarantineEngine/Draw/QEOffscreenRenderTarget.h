@@ -0,0 +1,56 @@
+#pragma once
+#ifndef QE_OFFSCREEN_RENDER_TARGET_H
+#define QE_OFFSCREEN_RENDER_TARGET_H
+
+#include <vulkan/vulkan.h>
+#include <QERenderTarget.h>
+
+class DeviceModule;
+class RenderPassModule;
+
+/// Destino de render sin swapchain (modo headless). Mismo layout que el viewport del editor:
+/// color MSAA + depth MSAA + resolve, compatible con ViewportRenderPass.
+class QEOffscreenRenderTarget
+{
+public:
+    QEOffscreenRenderTarget() = default;
+
+    void Create(DeviceModule* deviceModule, RenderPassModule* renderPassModule, uint32_t width, uint32_t height);
+    void Cleanup();
+
+    bool IsValid() const { return renderTarget.Valid(); }
+    const QERenderTarget& GetRenderTarget() const { return renderTarget; }
+    VkImage GetResolveImage() const { return resolveImage; }
+
+private:
+    void CreateImages();
+    void CreateFramebuffer();
+    VkImageView CreateView(VkImage image, VkFormat format, VkImageAspectFlags aspect);
+
+private:
+    DeviceModule* deviceModule = nullptr;
+    RenderPassModule* renderPassModule = nullptr;
+
+    QERenderTarget renderTarget{};
+
+    VkImage msaaColorImage = VK_NULL_HANDLE;
+    VkDeviceMemory msaaColorMemory = VK_NULL_HANDLE;
+    VkImageView msaaColorImageView = VK_NULL_HANDLE;
+
+    VkImage depthImage = VK_NULL_HANDLE;
+    VkDeviceMemory depthMemory = VK_NULL_HANDLE;
+    VkImageView depthImageView = VK_NULL_HANDLE;
+
+    VkImage resolveImage = VK_NULL_HANDLE;
+    VkDeviceMemory resolveMemory = VK_NULL_HANDLE;
+    VkImageView resolveImageView = VK_NULL_HANDLE;
+};
+
+
+
+namespace QE
+{
+    using ::QEOffscreenRenderTarget;
+} // namespace QE
+// QE namespace aliases
+#endif // !QE_OFFSCREEN_RENDER_TARGET_H
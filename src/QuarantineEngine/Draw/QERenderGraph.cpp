@@ -0,0 +1,673 @@
+#include "QERenderGraph.h"
+
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+
+namespace
+{
+    constexpr VkAccessFlags WRITE_ACCESS_MASK =
+        VK_ACCESS_SHADER_WRITE_BIT |
+        VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT |
+        VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT |
+        VK_ACCESS_TRANSFER_WRITE_BIT |
+        VK_ACCESS_HOST_WRITE_BIT |
+        VK_ACCESS_MEMORY_WRITE_BIT;
+
+    constexpr VkPipelineStageFlags TOP_OF_PIPE_STAGE = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+    constexpr VkPipelineStageFlags BOTTOM_OF_PIPE_STAGE = VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
+
+    // Estado simulado de un recurso durante la deduccion de barreras
+    struct SimState
+    {
+        VkImageLayout Layout = VK_IMAGE_LAYOUT_UNDEFINED;
+        VkPipelineStageFlags WriteStages = 0;   // Escritura pendiente de hacer visible
+        VkAccessFlags WriteAccess = 0;
+        VkPipelineStageFlags ReadStages = 0;    // Lecturas desde esa escritura (riesgo WAR)
+        VkPipelineStageFlags VisibleStages = 0; // Etapas que ya ven la escritura
+        VkAccessFlags VisibleAccess = 0;
+    };
+
+    void HashValue(uint64_t& hash, uint64_t value)
+    {
+        // FNV-1a sobre los 8 bytes del valor
+        for (int i = 0; i < 8; ++i)
+        {
+            hash ^= (value >> (i * 8)) & 0xFFu;
+            hash *= 1099511628211ull;
+        }
+    }
+
+    void HashString(uint64_t& hash, const std::string& value)
+    {
+        for (char c : value)
+        {
+            hash ^= static_cast<uint8_t>(c);
+            hash *= 1099511628211ull;
+        }
+        HashValue(hash, value.size());
+    }
+
+    VkDeviceSize AlignUp(VkDeviceSize value, VkDeviceSize alignment)
+    {
+        if (alignment <= 1)
+            return value;
+        return (value + alignment - 1) / alignment * alignment;
+    }
+
+    bool LifetimesOverlap(const QERGAliasRequest& a, const QERGAliasRequest& b)
+    {
+        return !(a.LastPass < b.FirstPass || b.LastPass < a.FirstPass);
+    }
+
+    uint32_t BytesPerTexel(VkFormat format)
+    {
+        switch (format)
+        {
+        case VK_FORMAT_R8_UNORM:
+            return 1;
+        case VK_FORMAT_R16_SFLOAT:
+        case VK_FORMAT_D16_UNORM:
+            return 2;
+        case VK_FORMAT_R32G32B32A32_SFLOAT:
+            return 16;
+        case VK_FORMAT_R16G16B16A16_SFLOAT:
+        case VK_FORMAT_R32G32_SFLOAT:
+        case VK_FORMAT_D32_SFLOAT_S8_UINT:
+            return 8;
+        default:
+            return 4;
+        }
+    }
+}
+
+QERGAccess QERGAccess::Read(QERGResourceId resource, VkImageLayout layout, VkPipelineStageFlags stages, VkAccessFlags access)
+{
+    QERGAccess result{};
+    result.Resource = resource;
+    result.Layout = layout;
+    result.Stages = stages;
+    result.Access = access;
+    return result;
+}
+
+QERGAccess QERGAccess::ReadWrite(QERGResourceId resource, VkImageLayout layout, VkPipelineStageFlags stages, VkAccessFlags access)
+{
+    QERGAccess result = Read(resource, layout, stages, access);
+    result.Write = true;
+    return result;
+}
+
+QERGAccess QERGAccess::Overwrite(QERGResourceId resource, VkImageLayout layout, VkPipelineStageFlags stages, VkAccessFlags access)
+{
+    QERGAccess result = ReadWrite(resource, layout, stages, access);
+    result.Discard = true;
+    return result;
+}
+
+bool QERGAliasingPlan::Overlaps(uint32_t a, uint32_t b, const std::vector<QERGAliasRequest>& requests) const
+{
+    if (a == b || Placements[a].Block != Placements[b].Block)
+        return false;
+
+    const VkDeviceSize aBegin = Placements[a].Offset;
+    const VkDeviceSize aEnd = aBegin + requests[a].Requirements.Size;
+    const VkDeviceSize bBegin = Placements[b].Offset;
+    const VkDeviceSize bEnd = bBegin + requests[b].Requirements.Size;
+    return aBegin < bEnd && bBegin < aEnd;
+}
+
+void QERenderGraph::Reset()
+{
+    resources.clear();
+    passes.clear();
+}
+
+QERGResourceId QERenderGraph::ImportImage(const std::string& name, VkImage image, const QERGImageDesc& desc,
+    const QERGImageState& initialState, bool output, VkImageLayout finalLayout)
+{
+    QERGResource resource{};
+    resource.Name = name;
+    resource.Desc = desc;
+    resource.Imported = true;
+    resource.Output = output;
+    resource.Image = image;
+    resource.InitialState = initialState;
+    resource.FinalLayout = finalLayout;
+    resources.push_back(resource);
+    return static_cast<QERGResourceId>(resources.size() - 1);
+}
+
+QERGResourceId QERenderGraph::CreateTransientImage(const std::string& name, const QERGImageDesc& desc)
+{
+    QERGResource resource{};
+    resource.Name = name;
+    resource.Desc = desc;
+    resources.push_back(resource);
+    return static_cast<QERGResourceId>(resources.size() - 1);
+}
+
+uint32_t QERenderGraph::AddPass(const std::string& name, QERGExecuteFn execute, bool sideEffects)
+{
+    QERGPass pass{};
+    pass.Name = name;
+    pass.SideEffects = sideEffects;
+    pass.Execute = std::move(execute);
+    passes.push_back(std::move(pass));
+    return static_cast<uint32_t>(passes.size() - 1);
+}
+
+void QERenderGraph::Use(uint32_t pass, const QERGAccess& access)
+{
+    if (pass >= passes.size() || access.Resource >= resources.size())
+    {
+        throw std::runtime_error("render graph: invalid pass or resource!");
+    }
+
+    // Un recurso aparece una sola vez por pase: se combinan los usos
+    for (QERGAccess& existing : passes[pass].Accesses)
+    {
+        if (existing.Resource != access.Resource)
+            continue;
+
+        if (existing.Layout != access.Layout)
+        {
+            throw std::runtime_error("render graph: pass '" + passes[pass].Name + "' uses '" +
+                resources[access.Resource].Name + "' with two different layouts!");
+        }
+
+        existing.Discard = (existing.Write && existing.Discard) && (access.Write && access.Discard);
+        existing.Write = existing.Write || access.Write;
+        existing.Stages |= access.Stages;
+        existing.Access |= access.Access;
+        existing.AcquireStages |= access.AcquireStages;
+        existing.AcquireAccess |= access.AcquireAccess;
+        existing.ReleaseStages |= access.ReleaseStages;
+        existing.ReleaseAccess |= access.ReleaseAccess;
+        if (access.FinalLayout != VK_IMAGE_LAYOUT_UNDEFINED)
+            existing.FinalLayout = access.FinalLayout;
+        return;
+    }
+
+    passes[pass].Accesses.push_back(access);
+}
+
+uint64_t QERenderGraph::ComputeSignature() const
+{
+    uint64_t hash = 14695981039346656037ull;
+
+    HashValue(hash, resources.size());
+    for (const QERGResource& resource : resources)
+    {
+        HashString(hash, resource.Name);
+        HashValue(hash, resource.Desc.Format);
+        HashValue(hash, (uint64_t(resource.Desc.Extent.width) << 32) | resource.Desc.Extent.height);
+        HashValue(hash, resource.Desc.Layers);
+        HashValue(hash, resource.Desc.Samples);
+        HashValue(hash, resource.Desc.Usage);
+        HashValue(hash, resource.Desc.Aspect);
+        HashValue(hash, (resource.Imported ? 1u : 0u) | (resource.Output ? 2u : 0u));
+        HashValue(hash, resource.InitialState.Layout);
+        HashValue(hash, resource.InitialState.Stages);
+        HashValue(hash, resource.InitialState.Access);
+        HashValue(hash, resource.FinalLayout);
+    }
+
+    HashValue(hash, passes.size());
+    for (const QERGPass& pass : passes)
+    {
+        HashString(hash, pass.Name);
+        HashValue(hash, pass.SideEffects ? 1u : 0u);
+        for (const QERGAccess& access : pass.Accesses)
+        {
+            HashValue(hash, access.Resource);
+            HashValue(hash, (uint64_t(access.Layout) << 32) | access.FinalLayout);
+            HashValue(hash, (uint64_t(access.Stages) << 32) | access.Access);
+            HashValue(hash, (access.Write ? 1u : 0u) | (access.Discard ? 2u : 0u));
+            HashValue(hash, (uint64_t(access.AcquireStages) << 32) | access.AcquireAccess);
+            HashValue(hash, (uint64_t(access.ReleaseStages) << 32) | access.ReleaseAccess);
+        }
+    }
+
+    return hash;
+}
+
+std::vector<bool> QERenderGraph::CullPasses() const
+{
+    std::vector<bool> alive(passes.size(), false);
+    std::vector<bool> needed(resources.size(), false);
+
+    for (size_t i = 0; i < resources.size(); ++i)
+    {
+        needed[i] = resources[i].Output;
+    }
+
+    // Recorrido inverso: un pase vive si tiene efectos laterales o escribe algo que se necesita despues
+    for (size_t p = passes.size(); p-- > 0;)
+    {
+        const QERGPass& pass = passes[p];
+
+        bool live = pass.SideEffects;
+        for (const QERGAccess& access : pass.Accesses)
+        {
+            live = live || (access.Write && needed[access.Resource]);
+        }
+
+        if (!live)
+            continue;
+
+        alive[p] = true;
+
+        // Una escritura que descarta el contenido corta la cadena hacia escritores anteriores
+        for (const QERGAccess& access : pass.Accesses)
+        {
+            if (access.Write && access.Discard)
+                needed[access.Resource] = false;
+        }
+
+        for (const QERGAccess& access : pass.Accesses)
+        {
+            if (!access.Write || !access.Discard)
+                needed[access.Resource] = true;
+        }
+    }
+
+    return alive;
+}
+
+void QERenderGraph::ComputeLifetimes()
+{
+    lifetimes.assign(resources.size(), QERGResourceLifetime{});
+
+    for (uint32_t i = 0; i < compiledPasses.size(); ++i)
+    {
+        for (const QERGAccess& access : passes[compiledPasses[i].PassIndex].Accesses)
+        {
+            QERGResourceLifetime& lifetime = lifetimes[access.Resource];
+            lifetime.FirstPass = std::min(lifetime.FirstPass, i);
+            lifetime.LastPass = std::max(lifetime.LastPass, i);
+        }
+    }
+}
+
+void QERenderGraph::BuildAliasing(const RequirementsFn& requirements)
+{
+    aliasedResources.clear();
+    aliasRequests.clear();
+
+    for (QERGResourceId id = 0; id < resources.size(); ++id)
+    {
+        if (resources[id].Imported || !lifetimes[id].Used())
+            continue;
+
+        QERGAliasRequest request{};
+        request.Requirements = requirements ? requirements(resources[id].Desc) : EstimateRequirements(resources[id].Desc);
+        request.FirstPass = lifetimes[id].FirstPass;
+        request.LastPass = lifetimes[id].LastPass;
+
+        aliasedResources.push_back(id);
+        aliasRequests.push_back(request);
+    }
+
+    aliasingPlan = PlanAliasing(aliasRequests);
+}
+
+void QERenderGraph::DeriveBarriers()
+{
+    std::vector<SimState> states(resources.size());
+
+    // Ultimo uso de cada transitorio: al reutilizar su memoria (siguiente frame o recurso con alias)
+    // hay que esperar a que termine
+    std::vector<VkPipelineStageFlags> endStages(resources.size(), 0);
+    std::vector<VkAccessFlags> endWriteAccess(resources.size(), 0);
+    for (const QERGCompiledPass& compiledPass : compiledPasses)
+    {
+        for (const QERGAccess& access : passes[compiledPass.PassIndex].Accesses)
+        {
+            endStages[access.Resource] = access.Stages;
+            if (access.Write)
+                endWriteAccess[access.Resource] = access.Access & WRITE_ACCESS_MASK;
+        }
+    }
+
+    for (QERGResourceId id = 0; id < resources.size(); ++id)
+    {
+        const QERGResource& resource = resources[id];
+        SimState& state = states[id];
+
+        if (resource.Imported)
+        {
+            state.Layout = resource.InitialState.Layout;
+            if (resource.InitialState.Access & WRITE_ACCESS_MASK)
+            {
+                state.WriteStages = resource.InitialState.Stages;
+                state.WriteAccess = resource.InitialState.Access & WRITE_ACCESS_MASK;
+            }
+            else
+            {
+                state.ReadStages = resource.InitialState.Stages;
+            }
+        }
+    }
+
+    for (uint32_t i = 0; i < aliasedResources.size(); ++i)
+    {
+        SimState& state = states[aliasedResources[i]];
+        for (uint32_t j = 0; j < aliasedResources.size(); ++j)
+        {
+            if (i == j || aliasingPlan.Overlaps(i, j, aliasRequests))
+            {
+                state.WriteStages |= endStages[aliasedResources[j]];
+                state.WriteAccess |= endWriteAccess[aliasedResources[j]];
+            }
+        }
+    }
+
+    for (QERGCompiledPass& compiledPass : compiledPasses)
+    {
+        compiledPass.Barriers.clear();
+
+        for (const QERGAccess& access : passes[compiledPass.PassIndex].Accesses)
+        {
+            SimState& state = states[access.Resource];
+
+            const bool layoutChange = access.Layout != VK_IMAGE_LAYOUT_UNDEFINED && access.Layout != state.Layout;
+
+            VkPipelineStageFlags srcStages = 0;
+            VkAccessFlags srcAccess = 0;
+            bool needsBarrier = layoutChange;
+
+            // RAW / WAW: escritura pendiente que este acceso aun no ve
+            if (state.WriteStages != 0)
+            {
+                const bool visible = !layoutChange &&
+                    (access.Stages & ~state.VisibleStages) == 0 &&
+                    (access.Access & ~state.VisibleAccess) == 0;
+                const bool acquired = !layoutChange &&
+                    (state.WriteStages & ~access.AcquireStages) == 0 &&
+                    (state.WriteAccess & ~access.AcquireAccess) == 0;
+                // Cadena release -> acquire entre dos render passes (p.ej. sombras sobre el mismo atlas)
+                const bool chained = !layoutChange && (state.VisibleStages & access.AcquireStages) != 0;
+
+                if (!visible && !acquired && !chained)
+                {
+                    srcStages |= state.WriteStages;
+                    srcAccess |= state.WriteAccess;
+                    needsBarrier = true;
+                }
+            }
+
+            // WAR: basta con dependencia de ejecucion
+            if ((access.Write || layoutChange) && state.ReadStages != 0)
+            {
+                const bool acquired = !layoutChange && (state.ReadStages & ~access.AcquireStages) == 0;
+                if (!acquired)
+                {
+                    srcStages |= state.ReadStages;
+                    needsBarrier = true;
+                }
+            }
+
+            if (needsBarrier)
+            {
+                QERGImageBarrier barrier{};
+                barrier.Resource = access.Resource;
+                barrier.OldLayout = (layoutChange && access.Discard) ? VK_IMAGE_LAYOUT_UNDEFINED : state.Layout;
+                barrier.NewLayout = layoutChange ? access.Layout : state.Layout;
+                barrier.SrcStages = srcStages != 0 ? srcStages : TOP_OF_PIPE_STAGE;
+                barrier.DstStages = access.Stages;
+                barrier.SrcAccess = srcAccess;
+                barrier.DstAccess = access.Access;
+                compiledPass.Barriers.push_back(barrier);
+            }
+
+            if (access.Write)
+            {
+                const VkAccessFlags writeAccess = access.Access & WRITE_ACCESS_MASK;
+                state.WriteStages = access.Stages;
+                state.WriteAccess = writeAccess != 0 ? writeAccess : access.Access;
+                state.ReadStages = 0;
+                state.VisibleStages = access.ReleaseStages;
+                state.VisibleAccess = access.ReleaseAccess;
+            }
+            else
+            {
+                state.ReadStages |= access.Stages;
+                state.VisibleStages |= access.Stages;
+                state.VisibleAccess |= access.Access;
+            }
+
+            if (access.FinalLayout != VK_IMAGE_LAYOUT_UNDEFINED)
+                state.Layout = access.FinalLayout;
+            else if (access.Layout != VK_IMAGE_LAYOUT_UNDEFINED)
+                state.Layout = access.Layout;
+        }
+    }
+
+    finalBarriers.clear();
+    for (QERGResourceId id = 0; id < resources.size(); ++id)
+    {
+        const QERGResource& resource = resources[id];
+        const SimState& state = states[id];
+
+        if (!resource.Imported || resource.FinalLayout == VK_IMAGE_LAYOUT_UNDEFINED || resource.FinalLayout == state.Layout)
+            continue;
+
+        QERGImageBarrier barrier{};
+        barrier.Resource = id;
+        barrier.OldLayout = state.Layout;
+        barrier.NewLayout = resource.FinalLayout;
+        barrier.SrcStages = (state.WriteStages | state.ReadStages) != 0 ? (state.WriteStages | state.ReadStages) : TOP_OF_PIPE_STAGE;
+        barrier.DstStages = BOTTOM_OF_PIPE_STAGE;
+        barrier.SrcAccess = state.WriteAccess;
+        finalBarriers.push_back(barrier);
+    }
+}
+
+void QERenderGraph::Compile(const RequirementsFn& requirements)
+{
+    const uint64_t signature = ComputeSignature();
+    if (compiled && signature == compiledSignature)
+        return;
+
+    const std::vector<bool> alive = CullPasses();
+
+    compiledPasses.clear();
+    for (uint32_t p = 0; p < passes.size(); ++p)
+    {
+        if (alive[p])
+        {
+            QERGCompiledPass compiledPass{};
+            compiledPass.PassIndex = p;
+            compiledPasses.push_back(compiledPass);
+        }
+    }
+
+    ComputeLifetimes();
+    BuildAliasing(requirements);
+    DeriveBarriers();
+
+    compiledSignature = signature;
+    compiled = true;
+}
+
+void QERenderGraph::BindTransient(QERGResourceId resource, VkImage image, VkImageView view)
+{
+    resources.at(resource).Image = image;
+    resources.at(resource).View = view;
+}
+
+uint32_t QERenderGraph::GetBarrierCount() const
+{
+    size_t count = finalBarriers.size();
+    for (const QERGCompiledPass& compiledPass : compiledPasses)
+    {
+        count += compiledPass.Barriers.size();
+    }
+    return static_cast<uint32_t>(count);
+}
+
+QERGAliasingPlan QERenderGraph::PlanAliasing(const std::vector<QERGAliasRequest>& requests)
+{
+    QERGAliasingPlan plan{};
+    plan.Placements.resize(requests.size());
+
+    std::vector<uint32_t> order(requests.size());
+    std::iota(order.begin(), order.end(), 0u);
+    std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b)
+        {
+            return requests[a].Requirements.Size > requests[b].Requirements.Size;
+        });
+
+    std::vector<uint32_t> placed;
+    std::vector<std::pair<VkDeviceSize, VkDeviceSize>> occupied;
+
+    for (uint32_t index : order)
+    {
+        const QERGAliasRequest& request = requests[index];
+        const VkDeviceSize size = request.Requirements.Size;
+        const VkDeviceSize alignment = request.Requirements.Alignment;
+
+        plan.RequestedBytes += size;
+
+        for (uint32_t block = 0; block < plan.Blocks.size() && plan.Placements[index].Block == UINT32_MAX; ++block)
+        {
+            QERGAliasBlock& aliasBlock = plan.Blocks[block];
+            if ((aliasBlock.MemoryTypeBits & request.Requirements.MemoryTypeBits) == 0)
+                continue;
+
+            // Rangos del bloque ocupados por recursos vivos a la vez que este
+            occupied.clear();
+            for (uint32_t other : placed)
+            {
+                if (plan.Placements[other].Block == block && LifetimesOverlap(request, requests[other]))
+                {
+                    const VkDeviceSize begin = plan.Placements[other].Offset;
+                    occupied.emplace_back(begin, begin + requests[other].Requirements.Size);
+                }
+            }
+            std::sort(occupied.begin(), occupied.end());
+
+            VkDeviceSize offset = 0;
+            for (const auto& range : occupied)
+            {
+                if (AlignUp(offset, alignment) + size <= range.first)
+                    break;
+                offset = std::max(offset, range.second);
+            }
+            offset = AlignUp(offset, alignment);
+
+            if (offset + size <= aliasBlock.Size)
+            {
+                plan.Placements[index].Block = block;
+                plan.Placements[index].Offset = offset;
+                aliasBlock.MemoryTypeBits &= request.Requirements.MemoryTypeBits;
+            }
+        }
+
+        if (plan.Placements[index].Block == UINT32_MAX)
+        {
+            QERGAliasBlock block{};
+            block.Size = size;
+            block.MemoryTypeBits = request.Requirements.MemoryTypeBits;
+            plan.Blocks.push_back(block);
+
+            plan.Placements[index].Block = static_cast<uint32_t>(plan.Blocks.size() - 1);
+            plan.Placements[index].Offset = 0;
+        }
+
+        placed.push_back(index);
+    }
+
+    for (const QERGAliasBlock& block : plan.Blocks)
+    {
+        plan.AllocatedBytes += block.Size;
+    }
+
+    return plan;
+}
+
+QERGMemoryRequirements QERenderGraph::EstimateRequirements(const QERGImageDesc& desc)
+{
+    QERGMemoryRequirements requirements{};
+    requirements.Alignment = 65536;
+    requirements.Size = AlignUp(
+        VkDeviceSize(desc.Extent.width) * desc.Extent.height * desc.Layers *
+        static_cast<VkDeviceSize>(desc.Samples) * BytesPerTexel(desc.Format),
+        requirements.Alignment);
+    return requirements;
+}
+
+void QERenderGraph::Execute(VkCommandBuffer commandBuffer) const
+{
+    std::vector<VkImageMemoryBarrier> imageBarriers;
+
+    auto recordBarriers = [&](const std::vector<QERGImageBarrier>& barriers)
+        {
+            if (barriers.empty())
+                return;
+
+            imageBarriers.clear();
+            VkMemoryBarrier memoryBarrier{};
+            memoryBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+            bool hasMemoryBarrier = false;
+
+            VkPipelineStageFlags srcStages = 0;
+            VkPipelineStageFlags dstStages = 0;
+
+            for (const QERGImageBarrier& barrier : barriers)
+            {
+                srcStages |= barrier.SrcStages;
+                dstStages |= barrier.DstStages;
+
+                const QERGResource& resource = resources[barrier.Resource];
+
+                // Sin cambio de layout basta con una barrera global
+                if (barrier.OldLayout == barrier.NewLayout || resource.Image == VK_NULL_HANDLE)
+                {
+                    memoryBarrier.srcAccessMask |= barrier.SrcAccess;
+                    memoryBarrier.dstAccessMask |= barrier.DstAccess;
+                    hasMemoryBarrier = true;
+                    continue;
+                }
+
+                VkImageMemoryBarrier imageBarrier{};
+                imageBarrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+                imageBarrier.oldLayout = barrier.OldLayout;
+                imageBarrier.newLayout = barrier.NewLayout;
+                imageBarrier.srcAccessMask = barrier.SrcAccess;
+                imageBarrier.dstAccessMask = barrier.DstAccess;
+                imageBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+                imageBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+                imageBarrier.image = resource.Image;
+                imageBarrier.subresourceRange.aspectMask = resource.Desc.Aspect;
+                imageBarrier.subresourceRange.baseMipLevel = 0;
+                imageBarrier.subresourceRange.levelCount = VK_REMAINING_MIP_LEVELS;
+                imageBarrier.subresourceRange.baseArrayLayer = 0;
+                imageBarrier.subresourceRange.layerCount = VK_REMAINING_ARRAY_LAYERS;
+                imageBarriers.push_back(imageBarrier);
+            }
+
+            vkCmdPipelineBarrier(
+                commandBuffer,
+                srcStages != 0 ? srcStages : TOP_OF_PIPE_STAGE,
+                dstStages != 0 ? dstStages : BOTTOM_OF_PIPE_STAGE,
+                0,
+                hasMemoryBarrier ? 1u : 0u, hasMemoryBarrier ? &memoryBarrier : nullptr,
+                0, nullptr,
+                static_cast<uint32_t>(imageBarriers.size()), imageBarriers.data());
+        };
+
+    for (const QERGCompiledPass& compiledPass : compiledPasses)
+    {
+        recordBarriers(compiledPass.Barriers);
+
+        const QERGPass& pass = passes[compiledPass.PassIndex];
+        if (pass.Execute)
+        {
+            pass.Execute(commandBuffer, *this);
+        }
+    }
+
+    recordBarriers(finalBarriers);
+}
@@ -0,0 +1,234 @@
+#pragma once
+
+#ifndef QE_RENDER_GRAPH_H
+#define QE_RENDER_GRAPH_H
+
+#include <vulkan/vulkan.h>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+using QERGResourceId = uint32_t;
+constexpr QERGResourceId QE_RG_INVALID_RESOURCE = UINT32_MAX;
+
+struct QERGImageDesc
+{
+    VkFormat Format = VK_FORMAT_UNDEFINED;
+    VkExtent2D Extent{ 0, 0 };
+    uint32_t Layers = 1;
+    VkSampleCountFlagBits Samples = VK_SAMPLE_COUNT_1_BIT;
+    VkImageUsageFlags Usage = 0;
+    VkImageAspectFlags Aspect = VK_IMAGE_ASPECT_COLOR_BIT;
+};
+
+/// Estado de una imagen entre pases: layout y ultimo acceso conocido.
+struct QERGImageState
+{
+    VkImageLayout Layout = VK_IMAGE_LAYOUT_UNDEFINED;
+    VkPipelineStageFlags Stages = 0;
+    VkAccessFlags Access = 0;
+};
+
+/// Uso de una imagen dentro de un pase. Los pases que usan un VkRenderPass describen aqui lo que
+/// ya hace el propio render pass (initialLayout/finalLayout y dependencias EXTERNAL) para que el
+/// grafo no repita barreras que el driver ya aplica.
+struct QERGAccess
+{
+    QERGResourceId Resource = QE_RG_INVALID_RESOURCE;
+    VkImageLayout Layout = VK_IMAGE_LAYOUT_UNDEFINED;       // Layout esperado al empezar el pase
+    VkImageLayout FinalLayout = VK_IMAGE_LAYOUT_UNDEFINED;  // Layout al acabar (UNDEFINED = Layout)
+    VkPipelineStageFlags Stages = 0;
+    VkAccessFlags Access = 0;
+    bool Write = false;
+    bool Discard = false;                                   // El pase no lee el contenido previo (clear/DONT_CARE)
+
+    // Dependencia EXTERNAL -> subpass 0 del render pass (ambito de origen que ya sincroniza)
+    VkPipelineStageFlags AcquireStages = 0;
+    VkAccessFlags AcquireAccess = 0;
+    // Dependencia subpass -> EXTERNAL (consumidores que ya ven el resultado sin barrera)
+    VkPipelineStageFlags ReleaseStages = 0;
+    VkAccessFlags ReleaseAccess = 0;
+
+    static QERGAccess Read(QERGResourceId resource, VkImageLayout layout, VkPipelineStageFlags stages, VkAccessFlags access);
+    static QERGAccess ReadWrite(QERGResourceId resource, VkImageLayout layout, VkPipelineStageFlags stages, VkAccessFlags access);
+    static QERGAccess Overwrite(QERGResourceId resource, VkImageLayout layout, VkPipelineStageFlags stages, VkAccessFlags access);
+};
+
+struct QERGImageBarrier
+{
+    QERGResourceId Resource = QE_RG_INVALID_RESOURCE;
+    VkImageLayout OldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    VkImageLayout NewLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    VkPipelineStageFlags SrcStages = 0;
+    VkPipelineStageFlags DstStages = 0;
+    VkAccessFlags SrcAccess = 0;
+    VkAccessFlags DstAccess = 0;
+};
+
+struct QERGMemoryRequirements
+{
+    VkDeviceSize Size = 0;
+    VkDeviceSize Alignment = 1;
+    uint32_t MemoryTypeBits = UINT32_MAX;
+};
+
+/// Entrada del planificador de aliasing: [FirstPass, LastPass] en orden de ejecucion.
+struct QERGAliasRequest
+{
+    QERGMemoryRequirements Requirements;
+    uint32_t FirstPass = 0;
+    uint32_t LastPass = 0;
+};
+
+struct QERGAliasBlock
+{
+    VkDeviceSize Size = 0;
+    uint32_t MemoryTypeBits = UINT32_MAX;
+};
+
+struct QERGAliasingPlan
+{
+    struct Placement
+    {
+        uint32_t Block = UINT32_MAX;
+        VkDeviceSize Offset = 0;
+    };
+
+    std::vector<Placement> Placements;  // Una por peticion, mismo orden
+    std::vector<QERGAliasBlock> Blocks;
+    VkDeviceSize RequestedBytes = 0;    // Suma sin aliasing
+    VkDeviceSize AllocatedBytes = 0;    // Suma de bloques
+
+    /// true si a y b comparten algun byte de memoria.
+    bool Overlaps(uint32_t a, uint32_t b, const std::vector<QERGAliasRequest>& requests) const;
+};
+
+class QERenderGraph;
+using QERGExecuteFn = std::function<void(VkCommandBuffer, const QERenderGraph&)>;
+
+struct QERGPass
+{
+    std::string Name;
+    std::vector<QERGAccess> Accesses;
+    bool SideEffects = false;   // Se ejecuta aunque nadie consuma lo que escribe (UI, readbacks, previews)
+    QERGExecuteFn Execute;
+};
+
+struct QERGResource
+{
+    std::string Name;
+    QERGImageDesc Desc;
+    bool Imported = false;
+    bool Output = false;                                    // Sus escritores nunca se descartan
+    VkImage Image = VK_NULL_HANDLE;
+    VkImageView View = VK_NULL_HANDLE;
+    QERGImageState InitialState;                            // Solo importados
+    VkImageLayout FinalLayout = VK_IMAGE_LAYOUT_UNDEFINED;  // Importados: layout exigido al acabar (UNDEFINED = el que quede)
+};
+
+struct QERGResourceLifetime
+{
+    uint32_t FirstPass = UINT32_MAX;    // Indices en CompiledPasses
+    uint32_t LastPass = 0;
+    bool Used() const { return FirstPass != UINT32_MAX; }
+};
+
+struct QERGCompiledPass
+{
+    uint32_t PassIndex = 0;
+    std::vector<QERGImageBarrier> Barriers;     // Se emiten en un solo vkCmdPipelineBarrier antes del pase
+};
+
+/// Grafo de pases de un frame. Los pases se declaran en orden de envio con los recursos que leen y
+/// escriben; Compile() descarta los que no contribuyen a ninguna salida, calcula la vida de cada
+/// recurso transitorio, deduce las barreras minimas entre pases y planifica el aliasing de memoria
+/// de los transitorios cuyas vidas no se solapan. Compile() no llama a Vulkan: se puede ejecutar y
+/// comprobar en CPU. Execute() graba barreras y pases en el command buffer.
+class QERenderGraph
+{
+public:
+    using RequirementsFn = std::function<QERGMemoryRequirements(const QERGImageDesc&)>;
+
+private:
+    std::vector<QERGResource> resources;
+    std::vector<QERGPass> passes;
+
+    std::vector<QERGCompiledPass> compiledPasses;
+    std::vector<QERGImageBarrier> finalBarriers;
+    std::vector<QERGResourceLifetime> lifetimes;
+    std::vector<QERGResourceId> aliasedResources;   // Transitorios vivos, en el orden de aliasRequests
+    std::vector<QERGAliasRequest> aliasRequests;
+    QERGAliasingPlan aliasingPlan;
+    uint64_t compiledSignature = 0;
+    bool compiled = false;
+
+private:
+    uint64_t ComputeSignature() const;
+    std::vector<bool> CullPasses() const;
+    void ComputeLifetimes();
+    void BuildAliasing(const RequirementsFn& requirements);
+    void DeriveBarriers();
+
+public:
+    QERenderGraph() = default;
+
+    /// Vacia pases y recursos conservando el plan compilado (se reutiliza si el grafo no cambia).
+    void Reset();
+
+    QERGResourceId ImportImage(const std::string& name, VkImage image, const QERGImageDesc& desc,
+        const QERGImageState& initialState, bool output = false, VkImageLayout finalLayout = VK_IMAGE_LAYOUT_UNDEFINED);
+    QERGResourceId CreateTransientImage(const std::string& name, const QERGImageDesc& desc);
+
+    uint32_t AddPass(const std::string& name, QERGExecuteFn execute, bool sideEffects = false);
+    void Use(uint32_t pass, const QERGAccess& access);
+
+    /// Sin requirements usa EstimateRequirements (pruebas en CPU).
+    void Compile(const RequirementsFn& requirements = nullptr);
+    void Execute(VkCommandBuffer commandBuffer) const;
+
+    /// Imagen real de un transitorio (la asigna QERenderGraphTransientPool tras Compile).
+    void BindTransient(QERGResourceId resource, VkImage image, VkImageView view);
+
+    VkImage GetImage(QERGResourceId resource) const { return resources[resource].Image; }
+    VkImageView GetImageView(QERGResourceId resource) const { return resources[resource].View; }
+
+    const std::vector<QERGResource>& GetResources() const { return resources; }
+    const std::vector<QERGPass>& GetPasses() const { return passes; }
+    const std::vector<QERGCompiledPass>& GetCompiledPasses() const { return compiledPasses; }
+    const std::vector<QERGImageBarrier>& GetFinalBarriers() const { return finalBarriers; }
+    const std::vector<QERGResourceLifetime>& GetLifetimes() const { return lifetimes; }
+    const std::vector<QERGResourceId>& GetAliasedResources() const { return aliasedResources; }
+    const std::vector<QERGAliasRequest>& GetAliasRequests() const { return aliasRequests; }
+    const QERGAliasingPlan& GetAliasingPlan() const { return aliasingPlan; }
+    uint64_t GetSignature() const { return compiledSignature; }
+    uint32_t GetCulledPassCount() const { return static_cast<uint32_t>(passes.size() - compiledPasses.size()); }
+    uint32_t GetBarrierCount() const;
+
+    /// Asignacion greedy por tamano decreciente: cada peticion ocupa el primer hueco alineado de un
+    /// bloque compatible que no pise a otra peticion con vida solapada.
+    static QERGAliasingPlan PlanAliasing(const std::vector<QERGAliasRequest>& requests);
+    static QERGMemoryRequirements EstimateRequirements(const QERGImageDesc& desc);
+};
+
+
+
+namespace QE
+{
+    using ::QERGResourceId;
+    using ::QERGImageDesc;
+    using ::QERGImageState;
+    using ::QERGAccess;
+    using ::QERGImageBarrier;
+    using ::QERGMemoryRequirements;
+    using ::QERGAliasRequest;
+    using ::QERGAliasBlock;
+    using ::QERGAliasingPlan;
+    using ::QERGPass;
+    using ::QERGResource;
+    using ::QERGResourceLifetime;
+    using ::QERGCompiledPass;
+    using ::QERenderGraph;
+} // namespace QE
+// QE namespace aliases
+#endif // !QE_RENDER_GRAPH_H
@@ -0,0 +1,179 @@
+#include "QERenderGraphTransientPool.h"
+
+#include <stdexcept>
+#include <DeviceModule.h>
+#include <ImageMemoryTools.h>
+#include <Helpers/QEMemoryTrack.h>
+#include <Logging/QELogMacros.h>
+
+uint64_t QERenderGraphTransientPool::HashDesc(const QERGImageDesc& desc)
+{
+    uint64_t hash = 14695981039346656037ull;
+    const uint64_t values[] = {
+        static_cast<uint64_t>(desc.Format),
+        (uint64_t(desc.Extent.width) << 32) | desc.Extent.height,
+        desc.Layers,
+        static_cast<uint64_t>(desc.Samples),
+        desc.Usage,
+        desc.Aspect
+    };
+
+    for (uint64_t value : values)
+    {
+        hash ^= value;
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+void QERenderGraphTransientPool::Initialize(DeviceModule* deviceModule)
+{
+    this->deviceModule = deviceModule;
+}
+
+void QERenderGraphTransientPool::Cleanup()
+{
+    Release();
+    requirementsCache.clear();
+    deviceModule = nullptr;
+}
+
+VkImage QERenderGraphTransientPool::CreateImage(const QERGImageDesc& desc) const
+{
+    VkImageCreateInfo imageInfo{};
+    imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+    imageInfo.imageType = VK_IMAGE_TYPE_2D;
+    imageInfo.extent = { desc.Extent.width, desc.Extent.height, 1 };
+    imageInfo.mipLevels = 1;
+    imageInfo.arrayLayers = desc.Layers;
+    imageInfo.format = desc.Format;
+    imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+    imageInfo.usage = desc.Usage;
+    imageInfo.samples = desc.Samples;
+    imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+    VkImage image = VK_NULL_HANDLE;
+    if (vkCreateImage(deviceModule->device, &imageInfo, nullptr, &image) != VK_SUCCESS)
+    {
+        throw std::runtime_error("failed to create render graph transient image!");
+    }
+    return image;
+}
+
+QERGMemoryRequirements QERenderGraphTransientPool::GetRequirements(const QERGImageDesc& desc)
+{
+    const uint64_t key = HashDesc(desc);
+    auto it = requirementsCache.find(key);
+    if (it != requirementsCache.end())
+        return it->second;
+
+    // Imagen temporal solo para consultar: nunca llega a la GPU, se destruye en el momento
+    VkImage image = CreateImage(desc);
+    VkMemoryRequirements memRequirements{};
+    vkGetImageMemoryRequirements(deviceModule->device, image, &memRequirements);
+    vkDestroyImage(deviceModule->device, image, nullptr);
+
+    QERGMemoryRequirements requirements{};
+    requirements.Size = memRequirements.size;
+    requirements.Alignment = memRequirements.alignment;
+    requirements.MemoryTypeBits = memRequirements.memoryTypeBits;
+
+    requirementsCache[key] = requirements;
+    return requirements;
+}
+
+void QERenderGraphTransientPool::Release()
+{
+    if (!deviceModule)
+        return;
+
+    for (Allocation& allocation : allocations)
+    {
+        QE_DEFER_DESTROY(deviceModule->device, allocation.View, vkDestroyImageView, "QERenderGraphTransientPool::Release");
+        QE_DEFER_DESTROY(deviceModule->device, allocation.Image, vkDestroyImage, "QERenderGraphTransientPool::Release");
+    }
+    allocations.clear();
+
+    for (VkDeviceMemory& block : blocks)
+    {
+        QE_FREE_MEMORY(deviceModule->device, block, "QERenderGraphTransientPool::Release");
+    }
+    blocks.clear();
+
+    allocatedBytes = 0;
+    realizedSignature = 0;
+}
+
+void QERenderGraphTransientPool::Realize(QERenderGraph& graph)
+{
+    const std::vector<QERGResourceId>& aliased = graph.GetAliasedResources();
+    const QERGAliasingPlan& plan = graph.GetAliasingPlan();
+
+    uint64_t signature = 14695981039346656037ull;
+    for (uint32_t i = 0; i < aliased.size(); ++i)
+    {
+        signature ^= HashDesc(graph.GetResources()[aliased[i]].Desc);
+        signature *= 1099511628211ull;
+        signature ^= (uint64_t(plan.Placements[i].Block) << 40) ^ plan.Placements[i].Offset;
+        signature *= 1099511628211ull;
+    }
+
+    if (aliased.empty())
+    {
+        Release();
+        return;
+    }
+
+    if (signature != realizedSignature || allocations.size() != aliased.size())
+    {
+        Release();
+
+        blocks.resize(plan.Blocks.size(), VK_NULL_HANDLE);
+        for (size_t b = 0; b < plan.Blocks.size(); ++b)
+        {
+            VkMemoryAllocateInfo allocInfo{};
+            allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+            allocInfo.allocationSize = plan.Blocks[b].Size;
+            allocInfo.memoryTypeIndex = IMT::findMemoryType(
+                plan.Blocks[b].MemoryTypeBits,
+                VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                deviceModule->physicalDevice);
+
+            if (vkAllocateMemory(deviceModule->device, &allocInfo, nullptr, &blocks[b]) != VK_SUCCESS)
+            {
+                throw std::runtime_error("failed to allocate render graph transient memory!");
+            }
+            QE_TRACK_MEMORY_ALLOCATION(blocks[b], "QERenderGraphTransientPool::Realize");
+        }
+
+        allocations.resize(aliased.size());
+        for (uint32_t i = 0; i < aliased.size(); ++i)
+        {
+            const QERGImageDesc& desc = graph.GetResources()[aliased[i]].Desc;
+
+            allocations[i].Image = CreateImage(desc);
+            vkBindImageMemory(deviceModule->device, allocations[i].Image, blocks[plan.Placements[i].Block], plan.Placements[i].Offset);
+
+            allocations[i].View = IMT::createImageView(
+                deviceModule->device,
+                allocations[i].Image,
+                desc.Layers > 1 ? VK_IMAGE_VIEW_TYPE_2D_ARRAY : VK_IMAGE_VIEW_TYPE_2D,
+                desc.Format,
+                desc.Aspect,
+                1,
+                desc.Layers);
+        }
+
+        allocatedBytes = plan.AllocatedBytes;
+        realizedSignature = signature;
+
+        QE_LOG_INFO_CAT_F("RenderGraph", "Transient attachments: {} images, {} blocks, {} KB (unaliased {} KB)",
+            aliased.size(), plan.Blocks.size(), plan.AllocatedBytes / 1024, plan.RequestedBytes / 1024);
+    }
+
+    for (uint32_t i = 0; i < aliased.size(); ++i)
+    {
+        graph.BindTransient(aliased[i], allocations[i].Image, allocations[i].View);
+    }
+}
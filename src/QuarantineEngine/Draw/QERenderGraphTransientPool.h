@@ -0,0 +1,59 @@
+#pragma once
+
+#ifndef QE_RENDER_GRAPH_TRANSIENT_POOL_H
+#define QE_RENDER_GRAPH_TRANSIENT_POOL_H
+
+#include <vulkan/vulkan.h>
+#include <unordered_map>
+#include <vector>
+#include <QERenderGraph.h>
+
+class DeviceModule;
+
+/// Memoria de los recursos transitorios del grafo. Crea un VkDeviceMemory por bloque del plan de
+/// aliasing y enlaza cada imagen a su offset. Las imagenes se conservan mientras el grafo compilado
+/// no cambie; si cambia se liberan con la cola de destruccion diferida.
+class QERenderGraphTransientPool
+{
+private:
+    struct Allocation
+    {
+        VkImage Image = VK_NULL_HANDLE;
+        VkImageView View = VK_NULL_HANDLE;
+    };
+
+    DeviceModule* deviceModule = nullptr;
+    std::vector<VkDeviceMemory> blocks;
+    std::vector<Allocation> allocations;        // Mismo orden que QERenderGraph::GetAliasedResources
+    std::unordered_map<uint64_t, QERGMemoryRequirements> requirementsCache;
+    uint64_t realizedSignature = 0;
+    VkDeviceSize allocatedBytes = 0;
+
+private:
+    static uint64_t HashDesc(const QERGImageDesc& desc);
+    VkImage CreateImage(const QERGImageDesc& desc) const;
+    void Release();
+
+public:
+    QERenderGraphTransientPool() = default;
+
+    void Initialize(DeviceModule* deviceModule);
+    void Cleanup();
+
+    /// Requisitos reales de memoria de una descripcion (se consultan una vez por descripcion).
+    QERGMemoryRequirements GetRequirements(const QERGImageDesc& desc);
+
+    /// Crea (si hace falta) la memoria del plan compilado y asigna imagen/vista a cada transitorio.
+    void Realize(QERenderGraph& graph);
+
+    VkDeviceSize GetAllocatedBytes() const { return allocatedBytes; }
+};
+
+
+
+namespace QE
+{
+    using ::QERenderGraphTransientPool;
+} // namespace QE
+// QE namespace aliases
+#endif // !QE_RENDER_GRAPH_TRANSIENT_POOL_H
@@ -7,6 +7,7 @@ struct QERenderTarget
     VkFramebuffer Framebuffer = VK_NULL_HANDLE;
     VkRenderPass RenderPass = VK_NULL_HANDLE;
     VkExtent2D Extent{ 0, 0 };
+    VkImage ColorImage = VK_NULL_HANDLE;    // Resolve: lo leen los pases posteriores
 
     bool Valid() const
     {
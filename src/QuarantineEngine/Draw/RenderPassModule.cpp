@@ -7,7 +7,7 @@ RenderPassModule::RenderPassModule()
 
     this->DefaultRenderPass = std::make_shared<VkRenderPass>();
     this->DirShadowMappingRenderPass = std::make_shared<VkRenderPass>();
-    this->OmniShadowMappingRenderPass = std::make_shared<VkRenderPass>();
+    this->DirShadowMappingLoadRenderPass = std::make_shared<VkRenderPass>();
     this->ViewportRenderPass = std::make_shared<VkRenderPass>();
 }
 
@@ -20,7 +20,7 @@ void RenderPassModule::cleanup()
 {
     vkDestroyRenderPass(device_ptr->device, *DefaultRenderPass, nullptr);
     vkDestroyRenderPass(device_ptr->device, *DirShadowMappingRenderPass, nullptr);
-    vkDestroyRenderPass(device_ptr->device, *OmniShadowMappingRenderPass, nullptr);
+    vkDestroyRenderPass(device_ptr->device, *DirShadowMappingLoadRenderPass, nullptr);
     vkDestroyRenderPass(device_ptr->device, *ViewportRenderPass, nullptr);
 }
 
@@ -155,80 +155,13 @@ void RenderPassModule::CreateDirShadowRenderPass(VkFormat shadowFormat)
     {
         throw std::runtime_error("failed to create directional shadow render pass!");
     }
-}
-
-void RenderPassModule::CreateOmniShadowRenderPass(VkFormat shadowFormat, VkFormat shadowDepthFormat)
-{
-    VkAttachmentDescription attachmentsDescription[2]{};
-
-    attachmentsDescription[0].format = shadowFormat;
-    attachmentsDescription[0].samples = VK_SAMPLE_COUNT_1_BIT;
-    attachmentsDescription[0].loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
-    attachmentsDescription[0].storeOp = VK_ATTACHMENT_STORE_OP_STORE;
-    attachmentsDescription[0].stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
-    attachmentsDescription[0].stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
-    attachmentsDescription[0].initialLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-    attachmentsDescription[0].finalLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-
-    // Depth attachment
-    attachmentsDescription[1].format = shadowDepthFormat;
-    attachmentsDescription[1].samples = VK_SAMPLE_COUNT_1_BIT;
-    attachmentsDescription[1].loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
-    attachmentsDescription[1].storeOp = VK_ATTACHMENT_STORE_OP_STORE;
-    attachmentsDescription[1].stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
-    attachmentsDescription[1].stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
-    attachmentsDescription[1].initialLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
-    attachmentsDescription[1].finalLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
-
-    VkAttachmentReference colorReference = {};
-    colorReference.attachment = 0;
-    colorReference.layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
-
-    VkAttachmentReference depthReference = {};
-    depthReference.attachment = 1;
-    depthReference.layout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
-
-    VkSubpassDescription subpass = {};
-    subpass.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
-    subpass.colorAttachmentCount = 1;
-    subpass.pColorAttachments = &colorReference;
-    subpass.pDepthStencilAttachment = &depthReference;
-
-    std::array<VkSubpassDependency, 2> dependencies{};
 
-    dependencies[0].srcSubpass = VK_SUBPASS_EXTERNAL;
-    dependencies[0].dstSubpass = 0;
-    dependencies[0].srcStageMask = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
-    dependencies[0].dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT;
-    dependencies[0].srcAccessMask = VK_ACCESS_SHADER_READ_BIT;
-    dependencies[0].dstAccessMask =
-        VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT |
-        VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT |
-        VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
-    dependencies[0].dependencyFlags = VK_DEPENDENCY_BY_REGION_BIT;
-
-    dependencies[1].srcSubpass = 0;
-    dependencies[1].dstSubpass = VK_SUBPASS_EXTERNAL;
-    dependencies[1].srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
-    dependencies[1].dstStageMask = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
-    dependencies[1].srcAccessMask =
-        VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT |
-        VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
-    dependencies[1].dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
-    dependencies[1].dependencyFlags = VK_DEPENDENCY_BY_REGION_BIT;
-
-    VkRenderPassCreateInfo renderPassInfo{};
-    renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
-    renderPassInfo.attachmentCount = 2;
-    renderPassInfo.pAttachments = attachmentsDescription;
-    renderPassInfo.subpassCount = 1;
-    renderPassInfo.pSubpasses = &subpass;
-    renderPassInfo.dependencyCount = static_cast<uint32_t>(dependencies.size());
-    renderPassInfo.pDependencies = dependencies.data();
+    // Misma estructura (compatible con los framebuffers existentes) pero conservando el contenido
+    attachmentDescription.loadOp = VK_ATTACHMENT_LOAD_OP_LOAD;
 
-    if (vkCreateRenderPass(device_ptr->device, &renderPassInfo, nullptr, OmniShadowMappingRenderPass.get()) != VK_SUCCESS)
+    if (vkCreateRenderPass(device_ptr->device, &renderPassInfo, nullptr, DirShadowMappingLoadRenderPass.get()) != VK_SUCCESS)
     {
-        throw std::runtime_error("failed to create omni shadow render pass!");
+        throw std::runtime_error("failed to create directional shadow load render pass!");
     }
 }
 
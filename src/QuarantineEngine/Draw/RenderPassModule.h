@@ -14,7 +14,8 @@ private:
 public:
     std::shared_ptr<VkRenderPass>   DefaultRenderPass;
     std::shared_ptr<VkRenderPass>   DirShadowMappingRenderPass;
-    std::shared_ptr<VkRenderPass>   OmniShadowMappingRenderPass;
+    // Variantes con LOAD para componer casters dinamicos sobre la capa estatica cacheada
+    std::shared_ptr<VkRenderPass>   DirShadowMappingLoadRenderPass;
     std::shared_ptr<VkRenderPass>   ViewportRenderPass;
 
 public:
@@ -24,7 +25,6 @@ public:
     void cleanup();
     void CreateRenderPass(VkFormat swapchainFormat, VkFormat depthFormat, VkSampleCountFlagBits msaaSamples);
     void CreateDirShadowRenderPass(VkFormat shadowFormat);
-    void CreateOmniShadowRenderPass(VkFormat shadowFormat, VkFormat shadowDepthFormat);
     void CreateViewportRenderPass(VkFormat colorFormat, VkFormat depthFormat, VkSampleCountFlagBits msaaSamples);
 };
 
@@ -1,5 +1,6 @@
 #include "SynchronizationModule.h"
 #include <stdexcept>
+#include <QEDeferredDeletionQueue.h>
 
 size_t SynchronizationModule::currentFrame = 0;
 
@@ -7,33 +8,49 @@ void SynchronizationModule::createSyncObjects()
 {
     imageAvailableSemaphores.resize(MAX_FRAMES_IN_FLIGHT);
     renderFinishedSemaphores.resize(MAX_FRAMES_IN_FLIGHT);
-    inFlightFences.resize(MAX_FRAMES_IN_FLIGHT);
-
-    computeInFlightFences.resize(MAX_FRAMES_IN_FLIGHT);
-    computeFinishedSemaphores.resize(MAX_FRAMES_IN_FLIGHT);
 
     VkSemaphoreCreateInfo semaphoreInfo{};
     semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
 
-    VkFenceCreateInfo fenceInfo{};
-    fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
-    fenceInfo.flags = VK_FENCE_CREATE_SIGNALED_BIT;
-
     for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++)
     {
         if (vkCreateSemaphore(deviceModule->device, &semaphoreInfo, nullptr, &imageAvailableSemaphores[i]) != VK_SUCCESS ||
-            vkCreateSemaphore(deviceModule->device, &semaphoreInfo, nullptr, &renderFinishedSemaphores[i]) != VK_SUCCESS ||
-            vkCreateFence(deviceModule->device, &fenceInfo, nullptr, &inFlightFences[i]) != VK_SUCCESS)
+            vkCreateSemaphore(deviceModule->device, &semaphoreInfo, nullptr, &renderFinishedSemaphores[i]) != VK_SUCCESS)
         {
             throw std::runtime_error("failed to create semaphores!");
         }
+    }
 
-        if (vkCreateSemaphore(deviceModule->device, &semaphoreInfo, nullptr, &computeFinishedSemaphores[i]) != VK_SUCCESS ||
-            vkCreateFence(deviceModule->device, &fenceInfo, nullptr, &computeInFlightFences[i]) != VK_SUCCESS)
-        {
-            throw std::runtime_error("failed to create compute synchronization objects for a frame!");
-        }
+    graphicsTimeline = createTimelineSemaphore();
+    computeTimeline = createTimelineSemaphore();
+
+    graphicsTimelineValue = 0;
+    computeTimelineValue = 0;
+    for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++)
+    {
+        frameGraphicsValues[i] = 0;
+        frameComputeValues[i] = 0;
+    }
+}
+
+VkSemaphore SynchronizationModule::createTimelineSemaphore()
+{
+    VkSemaphoreTypeCreateInfo typeInfo{};
+    typeInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO;
+    typeInfo.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+    typeInfo.initialValue = 0;
+
+    VkSemaphoreCreateInfo semaphoreInfo{};
+    semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+    semaphoreInfo.pNext = &typeInfo;
+
+    VkSemaphore semaphore = VK_NULL_HANDLE;
+    if (vkCreateSemaphore(deviceModule->device, &semaphoreInfo, nullptr, &semaphore) != VK_SUCCESS)
+    {
+        throw std::runtime_error("failed to create timeline semaphore!");
     }
+
+    return semaphore;
 }
 
 void SynchronizationModule::cleanup()
@@ -42,61 +59,148 @@ void SynchronizationModule::cleanup()
     {
         vkDestroySemaphore(deviceModule->device, renderFinishedSemaphores[i], nullptr);
         vkDestroySemaphore(deviceModule->device, imageAvailableSemaphores[i], nullptr);
-        vkDestroySemaphore(deviceModule->device, computeFinishedSemaphores[i], nullptr);
-        vkDestroyFence(deviceModule->device, inFlightFences[i], nullptr);
-        vkDestroyFence(deviceModule->device, computeInFlightFences[i], nullptr);
     }
-}
 
-void SynchronizationModule::submitCommandBuffer(VkCommandBuffer& commandBuffer, bool isRendered)
-{
-    VkSubmitInfo submitInfo{};
-    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    vkDestroySemaphore(deviceModule->device, graphicsTimeline, nullptr);
+    vkDestroySemaphore(deviceModule->device, computeTimeline, nullptr);
+    graphicsTimeline = VK_NULL_HANDLE;
+    computeTimeline = VK_NULL_HANDLE;
 
-    waitSemaphores = &imageAvailableSemaphores[currentFrame];
+    // El timeline de transferencia es del streamer
+    transferTimeline = VK_NULL_HANDLE;
+    transferWaitValue = 0;
+}
 
+void SynchronizationModule::submitGraphics(VkCommandBuffer& commandBuffer, bool present)
+{
+    // Los valores de los semaforos binarios se ignoran, pero los arrays deben tener la misma longitud
+    VkSemaphore waitSemaphores[3];
+    uint64_t waitValues[3];
+    VkPipelineStageFlags waitStages[3];
+    uint32_t waitCount = 0;
 
-    VkSemaphore firstWaitSemaphores[] = { imageAvailableSemaphores[currentFrame] };
-    VkSemaphore waitSemaphores[] = {computeFinishedSemaphores[currentFrame], imageAvailableSemaphores[currentFrame]};
+    if (present)
+    {
+        waitSemaphores[waitCount] = imageAvailableSemaphores[currentFrame];
+        waitValues[waitCount] = 0;
+        waitStages[waitCount] = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+        ++waitCount;
+    }
 
-    VkPipelineStageFlags waitStages[] = { VK_PIPELINE_STAGE_VERTEX_INPUT_BIT, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT };
-    if (isRendered)
+    if (computeSubmitted)
     {
-        submitInfo.pWaitSemaphores = waitSemaphores;
-        submitInfo.waitSemaphoreCount = 2;
+        waitSemaphores[waitCount] = computeTimeline;
+        waitValues[waitCount] = frameComputeValues[currentFrame];
+        waitStages[waitCount] = VK_PIPELINE_STAGE_VERTEX_INPUT_BIT;
+        ++waitCount;
     }
-    else
+
+    if (transferTimeline != VK_NULL_HANDLE && transferWaitValue > 0)
     {
-        submitInfo.pWaitSemaphores = firstWaitSemaphores;
-        submitInfo.waitSemaphoreCount = 1;
+        waitSemaphores[waitCount] = transferTimeline;
+        waitValues[waitCount] = transferWaitValue;
+        waitStages[waitCount] = VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+        ++waitCount;
     }
-    submitInfo.pWaitDstStageMask = waitStages;
 
+    const uint64_t signalValue = ++graphicsTimelineValue;
+
+    VkSemaphore signalSemaphoreArray[2] = { graphicsTimeline, renderFinishedSemaphores[currentFrame] };
+    uint64_t signalValues[2] = { signalValue, 0 };
+    const uint32_t signalCount = present ? 2 : 1;
+
+    VkTimelineSemaphoreSubmitInfo timelineInfo{};
+    timelineInfo.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+    timelineInfo.waitSemaphoreValueCount = waitCount;
+    timelineInfo.pWaitSemaphoreValues = waitValues;
+    timelineInfo.signalSemaphoreValueCount = signalCount;
+    timelineInfo.pSignalSemaphoreValues = signalValues;
+
+    VkSubmitInfo submitInfo{};
+    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    submitInfo.pNext = &timelineInfo;
+    submitInfo.waitSemaphoreCount = waitCount;
+    submitInfo.pWaitSemaphores = waitSemaphores;
+    submitInfo.pWaitDstStageMask = waitStages;
     submitInfo.commandBufferCount = 1;
     submitInfo.pCommandBuffers = &commandBuffer;
+    submitInfo.signalSemaphoreCount = signalCount;
+    submitInfo.pSignalSemaphores = signalSemaphoreArray;
 
-    signalSemaphores = &renderFinishedSemaphores[currentFrame];
-    submitInfo.signalSemaphoreCount = 1;
-    submitInfo.pSignalSemaphores = signalSemaphores;
-
-    if (vkQueueSubmit(queueModule->graphicsQueue, 1, &submitInfo, inFlightFences[currentFrame]) != VK_SUCCESS) {
+    if (vkQueueSubmit(queueModule->graphicsQueue, 1, &submitInfo, VK_NULL_HANDLE) != VK_SUCCESS) {
         throw std::runtime_error("failed to submit draw command buffer!");
     }
+
+    frameGraphicsValues[currentFrame] = signalValue;
+    computeSubmitted = false;
+    signalSemaphores = &renderFinishedSemaphores[currentFrame];
+
+    QEDeferredDeletionQueue::getInstance()->OnFrameSubmitted(static_cast<uint32_t>(currentFrame), graphicsTimeline, signalValue);
+}
+
+void SynchronizationModule::setTransferWait(VkSemaphore timeline, uint64_t value)
+{
+    transferTimeline = timeline;
+    transferWaitValue = value;
+}
+
+void SynchronizationModule::submitCommandBuffer(VkCommandBuffer& commandBuffer)
+{
+    this->submitGraphics(commandBuffer, true);
 }
 
-void SynchronizationModule::submitComputeCommandBuffer(VkCommandBuffer& commandBuffer)
+void SynchronizationModule::submitComputeCommandBuffer(VkCommandBuffer& commandBuffer, bool waitPreviousGraphics)
 {
+    VkSemaphore waitSemaphores[2];
+    uint64_t waitValues[2];
+    VkPipelineStageFlags waitStages[2];
+    uint32_t waitCount = 0;
+
+    // Orden y visibilidad respecto al compute anterior (buffers de dependencia entre frames)
+    if (computeTimelineValue > 0)
+    {
+        waitSemaphores[waitCount] = computeTimeline;
+        waitValues[waitCount] = computeTimelineValue;
+        waitStages[waitCount] = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+        ++waitCount;
+    }
+
+    // WAR: el ultimo frame grafico de este slot aun puede estar leyendo sus buffers
+    const uint64_t graphicsValue = waitPreviousGraphics ? graphicsTimelineValue : frameGraphicsValues[currentFrame];
+    if (graphicsValue > 0)
+    {
+        waitSemaphores[waitCount] = graphicsTimeline;
+        waitValues[waitCount] = graphicsValue;
+        waitStages[waitCount] = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+        ++waitCount;
+    }
+
+    const uint64_t signalValue = ++computeTimelineValue;
+
+    VkTimelineSemaphoreSubmitInfo timelineInfo{};
+    timelineInfo.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+    timelineInfo.waitSemaphoreValueCount = waitCount;
+    timelineInfo.pWaitSemaphoreValues = waitValues;
+    timelineInfo.signalSemaphoreValueCount = 1;
+    timelineInfo.pSignalSemaphoreValues = &signalValue;
+
     VkSubmitInfo submitInfo{};
     submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-
+    submitInfo.pNext = &timelineInfo;
+    submitInfo.waitSemaphoreCount = waitCount;
+    submitInfo.pWaitSemaphores = waitSemaphores;
+    submitInfo.pWaitDstStageMask = waitStages;
     submitInfo.commandBufferCount = 1;
     submitInfo.pCommandBuffers = &commandBuffer;
     submitInfo.signalSemaphoreCount = 1;
-    submitInfo.pSignalSemaphores = &computeFinishedSemaphores[currentFrame];
+    submitInfo.pSignalSemaphores = &computeTimeline;
 
-    if (vkQueueSubmit(queueModule->computeQueue, 1, &submitInfo, computeInFlightFences[currentFrame]) != VK_SUCCESS) {
+    if (vkQueueSubmit(queueModule->computeQueue, 1, &submitInfo, VK_NULL_HANDLE) != VK_SUCCESS) {
         throw std::runtime_error("failed to submit compute command buffer!");
     };
+
+    frameComputeValues[currentFrame] = signalValue;
+    computeSubmitted = true;
 }
 
 VkResult SynchronizationModule::presentSwapchain(VkSwapchainKHR& swapChain, const uint32_t& imageIdx)
@@ -120,22 +224,47 @@ VkResult SynchronizationModule::presentSwapchain(VkSwapchainKHR& swapChain, cons
     return result;
 }
 
+void SynchronizationModule::submitHeadlessCommandBuffer(VkCommandBuffer& commandBuffer)
+{
+    this->submitGraphics(commandBuffer, false);
+}
+
+void SynchronizationModule::advanceFrame()
+{
+    currentFrame = (currentFrame + 1) % MAX_FRAMES_IN_FLIGHT;
+}
+
 SynchronizationModule::SynchronizationModule()
 {
     deviceModule = DeviceModule::getInstance();
     queueModule = QueueModule::getInstance();
 }
 
-void SynchronizationModule::synchronizeWaitFences()
+void SynchronizationModule::waitTimeline(VkSemaphore timeline, uint64_t value)
+{
+    if (value == 0)
+        return;
+
+    VkSemaphoreWaitInfo waitInfo{};
+    waitInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+    waitInfo.semaphoreCount = 1;
+    waitInfo.pSemaphores = &timeline;
+    waitInfo.pValues = &value;
+
+    vkWaitSemaphores(deviceModule->device, &waitInfo, UINT64_MAX);
+}
+
+void SynchronizationModule::waitForFrameSlot()
 {
-    vkWaitForFences(deviceModule->device, 1, &inFlightFences[currentFrame], VK_TRUE, UINT64_MAX);
-    vkResetFences(deviceModule->device, 1, &inFlightFences[currentFrame]);
+    this->waitTimeline(graphicsTimeline, frameGraphicsValues[currentFrame]);
+
+    // Libera lo que solo usaba este frame y aplica las escrituras de descriptores pendientes del slot
+    QEDeferredDeletionQueue::getInstance()->OnFrameCompleted(static_cast<uint32_t>(currentFrame));
 }
 
-void SynchronizationModule::synchronizeWaitComputeFences()
+void SynchronizationModule::waitForComputeSlot()
 {
-    vkWaitForFences(deviceModule->device, 1, &computeInFlightFences[currentFrame], VK_TRUE, UINT64_MAX);
-    vkResetFences(deviceModule->device, 1, &computeInFlightFences[currentFrame]);
+    this->waitTimeline(computeTimeline, frameComputeValues[currentFrame]);
 }
 
 size_t SynchronizationModule::GetCurrentFrame()
@@ -7,8 +7,19 @@
 #include "QueueModule.h"
 #include "DeviceModule.h"
 
-const int MAX_FRAMES_IN_FLIGHT = 2;
+// Configurable desde CMake con QE_MAX_FRAMES_IN_FLIGHT (2 o 3)
+#ifndef QE_MAX_FRAMES_IN_FLIGHT
+#define QE_MAX_FRAMES_IN_FLIGHT 2
+#endif
+
+const int MAX_FRAMES_IN_FLIGHT = QE_MAX_FRAMES_IN_FLIGHT;
+static_assert(MAX_FRAMES_IN_FLIGHT >= 2 && MAX_FRAMES_IN_FLIGHT <= 3, "QE_MAX_FRAMES_IN_FLIGHT must be 2 or 3");
 
+/// Planificador de frames con timeline semaphores. Cada envio de grafico y de compute incrementa
+/// el valor de su timeline; un slot se reutiliza cuando la GPU ha alcanzado el valor de su ultimo
+/// frame. El compute del frame N+1 va en la cola de async compute y solo espera (en GPU) al
+/// grafico que uso por ultima vez los buffers de su slot, asi se solapa con el render del frame N.
+/// Los semaforos binarios quedan solo para adquirir y presentar imagenes del swapchain.
 class SynchronizationModule
 {
 public:
@@ -18,28 +29,48 @@ private:
     static size_t               currentFrame;
     std::vector<VkSemaphore>    imageAvailableSemaphores;
     std::vector<VkSemaphore>    renderFinishedSemaphores;
-    std::vector<VkFence>        inFlightFences;
-    VkSemaphore*                waitSemaphores;
     VkSemaphore*                signalSemaphores;
 
-    std::vector<VkFence>        computeInFlightFences;
-    std::vector<VkSemaphore>    computeFinishedSemaphores;
+    VkSemaphore                 graphicsTimeline = VK_NULL_HANDLE;
+    VkSemaphore                 computeTimeline = VK_NULL_HANDLE;
+    uint64_t                    graphicsTimelineValue = 0;
+    uint64_t                    computeTimelineValue = 0;
+    uint64_t                    frameGraphicsValues[MAX_FRAMES_IN_FLIGHT] = {};
+    uint64_t                    frameComputeValues[MAX_FRAMES_IN_FLIGHT] = {};
+    bool                        computeSubmitted = false;
+    VkSemaphore                 transferTimeline = VK_NULL_HANDLE;
+    uint64_t                    transferWaitValue = 0;
+
+private:
+    VkSemaphore createTimelineSemaphore();
+    void waitTimeline(VkSemaphore timeline, uint64_t value);
+    void submitGraphics(VkCommandBuffer& commandBuffer, bool present);
 
 public:
     SynchronizationModule();
     VkSemaphore getImageAvailableSemaphore() { return imageAvailableSemaphores[currentFrame]; };
     void createSyncObjects();
     void cleanup();
-    void submitCommandBuffer(VkCommandBuffer& commandBuffer, bool isRendered);
-    void submitComputeCommandBuffer(VkCommandBuffer& commandBuffer);
+    void submitCommandBuffer(VkCommandBuffer& commandBuffer);
+    /// waitPreviousGraphics: el compute escribe recursos que no son por slot (p.ej. LUTs bajo demanda)
+    /// y debe esperar tambien al ultimo frame grafico enviado.
+    void submitComputeCommandBuffer(VkCommandBuffer& commandBuffer, bool waitPreviousGraphics);
     VkResult presentSwapchain(VkSwapchainKHR& swapChain, const uint32_t& imageIdx);
-    void synchronizeWaitFences();
-    void synchronizeWaitComputeFences();
+    // Modo headless: sin imagen de swapchain que esperar ni que presentar
+    void submitHeadlessCommandBuffer(VkCommandBuffer& commandBuffer);
+    void advanceFrame();
+    /// Espera (CPU) a que la GPU termine el ultimo frame que uso este slot. Llamar al inicio del frame,
+    /// antes de escribir sus UBOs o grabar sus command buffers.
+    void waitForFrameSlot();
+    /// Espera a que termine el ultimo compute del slot antes de regrabar su command buffer.
+    void waitForComputeSlot();
+    /// Subidas de la cola de transferencia que el grafico debe ver (texturas en streaming). El valor
+    /// ya suele estar alcanzado al enviar: la espera solo da la dependencia de memoria entre colas.
+    void setTransferWait(VkSemaphore timeline, uint64_t value);
     static size_t GetCurrentFrame();
 };
 
 
-
 namespace QE
 {
     using ::SynchronizationModule;
@@ -81,6 +81,36 @@ bool GUIWindow::init(bool fullScreen)
     return true;
 }
 
+bool GUIWindow::initHeadless(int width, int height)
+{
+    glfwSetErrorCallback(glfw_error_callback);
+
+    // La plataforma nula no necesita servidor grafico; la ventana solo existe para el input y ImGui
+    glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL);
+    if (!glfwInit())
+        return false;
+
+    this->width = width;
+    this->height = height;
+    title = "Vulkan Quarantine Engine (headless)";
+
+    glfwWindowHint(GLFW_CLIENT_API, GLFW_NO_API);
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+
+    window = glfwCreateWindow(width, height, title.c_str(), nullptr, nullptr);
+    if (!window)
+    {
+        glfwTerminate();
+        return false;
+    }
+
+    glfwSetWindowUserPointer(window, this);
+
+    setupImgui();
+
+    return true;
+}
+
 void GUIWindow::renderGUIWindow()
 {
     renderMainWindow();
@@ -47,6 +47,8 @@ public:
 public:
     GUIWindow();
     bool init(bool fullScreen = false);
+    /// Ventana oculta sin superficie (plataforma nula de GLFW) para renderizar offscreen.
+    bool initHeadless(int width, int height);
     void renderGUIWindow();
     void renderMainWindow();
     GLFWwindow* getWindow();
@@ -1,4 +1,5 @@
 #include "ComputePipelineModule.h"
+#include <Helpers/QEMemoryTrack.h>
 
 void ComputePipelineModule::CompileComputePipeline(std::vector<VkPipelineShaderStageCreateInfo> shaderInfo, std::vector<VkDescriptorSetLayout> descriptorLayouts)
 {
@@ -27,6 +28,6 @@ void ComputePipelineModule::CompileComputePipeline(std::vector<VkPipelineShaderS
 
 void ComputePipelineModule::cleanup(VkPipeline pipeline, VkPipelineLayout pipelineLayout)
 {
-    vkDestroyPipeline(deviceModule->device, pipeline, nullptr);
-    vkDestroyPipelineLayout(deviceModule->device, pipelineLayout, nullptr);
+    QE_DEFER_DESTROY(deviceModule->device, pipeline, vkDestroyPipeline, "ComputePipelineModule::cleanup");
+    QE_DEFER_DESTROY(deviceModule->device, pipelineLayout, vkDestroyPipelineLayout, "ComputePipelineModule::cleanup");
 }
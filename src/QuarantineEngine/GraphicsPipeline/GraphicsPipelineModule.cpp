@@ -1,4 +1,6 @@
 #include "GraphicsPipelineModule.h"
+#include <Helpers/QEMemoryTrack.h>
+#include <QEBindlessMaterials.h>
 #include <UBO.h>
 
 GraphicsPipelineModule::GraphicsPipelineModule() : PipelineModule()
@@ -119,6 +121,14 @@ void GraphicsPipelineModule::CompileGraphicsPipeline(std::vector<VkPipelineShade
     pushConstantInfo.stageFlags = VK_SHADER_STAGE_ALL;
     pushConstantInfo.offset = 0;
     pushConstantInfo.size = sizeof(PushConstantStruct);
+    for (const auto& stage : shaderInfo)
+    {
+        if (stage.stage == VK_SHADER_STAGE_TASK_BIT_EXT || stage.stage == VK_SHADER_STAGE_MESH_BIT_EXT)
+        {
+            pushConstantInfo.size = sizeof(PushConstantMeshletStruct);
+            break;
+        }
+    }
 
     VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
     pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
@@ -130,6 +140,8 @@ void GraphicsPipelineModule::CompileGraphicsPipeline(std::vector<VkPipelineShade
     if (vkCreatePipelineLayout(deviceModule->device, &pipelineLayoutInfo, nullptr, &this->pipelineLayout) != VK_SUCCESS) {
         throw std::runtime_error("failed to create pipeline layout!");
     }
+    if (auto* bindlessMaterials = QEBindlessMaterials::getInstance())
+        bindlessMaterials->RegisterPipelineLayout(this->pipelineLayout, descriptorLayouts);
 
     VkGraphicsPipelineCreateInfo pipelineInfo{};
     pipelineInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
@@ -156,8 +168,10 @@ void GraphicsPipelineModule::CompileGraphicsPipeline(std::vector<VkPipelineShade
 
 void GraphicsPipelineModule::cleanup(VkPipeline pipeline, VkPipelineLayout pipelineLayout)
 {
-    vkDestroyPipeline(deviceModule->device, pipeline, nullptr);
-    vkDestroyPipelineLayout(deviceModule->device, pipelineLayout, nullptr);
+    if (auto* bindlessMaterials = QEBindlessMaterials::getInstance())
+        bindlessMaterials->UnregisterPipelineLayout(pipelineLayout);
+    QE_DEFER_DESTROY(deviceModule->device, pipeline, vkDestroyPipeline, "GraphicsPipelineModule::cleanup");
+    QE_DEFER_DESTROY(deviceModule->device, pipelineLayout, vkDestroyPipelineLayout, "GraphicsPipelineModule::cleanup");
 }
 
 void GraphicsPipelineModule::updatePolygonMode(PolygonRenderType polygonType)
@@ -1,4 +1,6 @@
 #include "PipelineModule.h"
+#include <Helpers/QEMemoryTrack.h>
+#include <QEBindlessMaterials.h>
 
 PipelineModule::PipelineModule()
 {
@@ -26,13 +28,13 @@ void PipelineModule::CleanPipelineData()
 {
     if (this->pipeline != VK_NULL_HANDLE)
     {
-        vkDestroyPipeline(deviceModule->device, this->pipeline, nullptr);
-        this->pipeline = VK_NULL_HANDLE;
+        QE_DEFER_DESTROY(deviceModule->device, this->pipeline, vkDestroyPipeline, "PipelineModule::CleanPipelineData");
     }
 
     if (this->pipelineLayout != VK_NULL_HANDLE)
     {
-        vkDestroyPipelineLayout(deviceModule->device, this->pipelineLayout, nullptr);
-        this->pipelineLayout = VK_NULL_HANDLE;
+        if (auto* bindlessMaterials = QEBindlessMaterials::getInstance())
+            bindlessMaterials->UnregisterPipelineLayout(this->pipelineLayout);
+        QE_DEFER_DESTROY(deviceModule->device, this->pipelineLayout, vkDestroyPipelineLayout, "PipelineModule::CleanPipelineData");
     }
 }
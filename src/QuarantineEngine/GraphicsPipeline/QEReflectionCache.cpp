@@ -0,0 +1,337 @@
+#include "QEReflectionCache.h"
+#include <fstream>
+#include <string>
+#include <Helpers/HashHelpers.h>
+#include <Logging/QELogMacros.h>
+
+std::mutex QEReflectionCache::cacheMutex;
+std::unordered_map<uint64_t, ReflectShader> QEReflectionCache::loadedStages;
+
+namespace
+{
+    struct CacheHeader
+    {
+        uint32_t Magic = 0;
+        uint32_t Version = 0;
+        uint64_t CodeHash = 0;
+    };
+
+    // Flags y tamanos del stage, en bloque
+    struct CacheStageInfo
+    {
+        uint32_t Stage = 0;
+        uint32_t Set = 0;
+        uint32_t BindingCount = 0;
+        uint32_t BindlessMaterialSet = 0;
+        uint64_t MaterialBufferSize = 0;
+        uint64_t AnimationBufferSize = 0;
+        uint32_t InputStrideSize = 0;
+        uint8_t IsAnimationShader = 0;
+        uint8_t IsUBOMaterial = 0;
+        uint8_t IsUboAnimation = 0;
+        uint8_t HasPointShadows = 0;
+        uint8_t HasDirectionalShadows = 0;
+        uint8_t HasSpotShadows = 0;
+        uint8_t HasBindlessMaterials = 0;
+        uint8_t Padding = 0;
+    };
+
+    struct CacheBinding
+    {
+        uint32_t Stage = 0;
+        uint32_t Set = 0;
+        uint32_t Binding = 0;
+        uint32_t Type = 0;
+        uint32_t ArraySize = 0;
+    };
+
+    template<typename T>
+    void WritePod(std::ofstream& file, const T& value)
+    {
+        file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    template<typename T>
+    bool ReadPod(std::ifstream& file, T& value)
+    {
+        file.read(reinterpret_cast<char*>(&value), sizeof(T));
+        return static_cast<bool>(file);
+    }
+
+    void WriteString(std::ofstream& file, const std::string& value)
+    {
+        WritePod(file, static_cast<uint32_t>(value.size()));
+        file.write(value.data(), static_cast<std::streamsize>(value.size()));
+    }
+
+    bool ReadString(std::ifstream& file, std::string& value)
+    {
+        uint32_t size = 0;
+        if (!ReadPod(file, size) || size > (1u << 16))
+            return false;
+
+        value.resize(size);
+        file.read(value.data(), size);
+        return static_cast<bool>(file);
+    }
+
+    void WriteBinding(std::ofstream& file, const DescriptorBindingReflect& binding)
+    {
+        CacheBinding data;
+        data.Stage = binding.stage;
+        data.Set = binding.set;
+        data.Binding = binding.binding;
+        data.Type = static_cast<uint32_t>(binding.type);
+        data.ArraySize = binding.arraySize;
+        WritePod(file, data);
+        WriteString(file, binding.name);
+    }
+
+    bool ReadBinding(std::ifstream& file, DescriptorBindingReflect& binding)
+    {
+        CacheBinding data;
+        if (!ReadPod(file, data) || !ReadString(file, binding.name))
+            return false;
+
+        binding.stage = data.Stage;
+        binding.set = data.Set;
+        binding.binding = data.Binding;
+        binding.type = static_cast<VkDescriptorType>(data.Type);
+        binding.arraySize = data.ArraySize;
+        return true;
+    }
+
+    template<typename T, typename ReadItem>
+    bool ReadList(std::ifstream& file, std::vector<T>& out, ReadItem readItem)
+    {
+        uint32_t count = 0;
+        if (!ReadPod(file, count) || count > (1u << 16))
+            return false;
+
+        out.resize(count);
+        for (auto& item : out)
+        {
+            if (!readItem(item))
+                return false;
+        }
+        return true;
+    }
+}
+
+fs::path QEReflectionCache::GetCachePath(const fs::path& spvPath)
+{
+    fs::path cachePath = spvPath;
+    cachePath += CACHE_EXTENSION;
+    return cachePath;
+}
+
+uint64_t QEReflectionCache::HashCode(const VkShaderModuleCreateInfo& createInfo)
+{
+    return QEHelper::HashBytes(createInfo.pCode, createInfo.codeSize);
+}
+
+bool QEReflectionCache::Save(const fs::path& cachePath, uint64_t codeHash, const ReflectShader& stage)
+{
+    if (stage.descriptorSetReflect.size() != 1)
+        return false;
+
+    fs::path tempPath = cachePath;
+    tempPath += ".tmp";
+
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (!file.is_open())
+        {
+            QE_LOG_WARN_CAT_F("QEReflectionCache", "Could not write reflection cache {}", cachePath.string());
+            return false;
+        }
+
+        CacheHeader header;
+        header.Magic = CACHE_MAGIC;
+        header.Version = CACHE_VERSION;
+        header.CodeHash = codeHash;
+        WritePod(file, header);
+
+        const DescriptorSetReflect& setReflect = stage.descriptorSetReflect.front();
+
+        CacheStageInfo info;
+        info.Stage = setReflect.stage;
+        info.Set = setReflect.set;
+        info.BindingCount = setReflect.bindingCount;
+        info.BindlessMaterialSet = stage.BindlessMaterialSet;
+        info.MaterialBufferSize = stage.materialBufferSize;
+        info.AnimationBufferSize = stage.animationBufferSize;
+        info.InputStrideSize = stage.inputStrideSize;
+        info.IsAnimationShader = stage.isAnimationShader;
+        info.IsUBOMaterial = stage.isUBOMaterial;
+        info.IsUboAnimation = stage.isUboAnimation;
+        info.HasPointShadows = stage.HasPointShadows;
+        info.HasDirectionalShadows = stage.HasDirectionalShadows;
+        info.HasSpotShadows = stage.HasSpotShadows;
+        info.HasBindlessMaterials = stage.HasBindlessMaterials;
+        WritePod(file, info);
+
+        WritePod(file, static_cast<uint32_t>(setReflect.bindings.size()));
+        for (const auto& binding : setReflect.bindings)
+            WriteBinding(file, binding);
+
+        uint32_t bindingCount = 0;
+        for (const auto& [set, setBindings] : stage.bindings)
+            bindingCount += static_cast<uint32_t>(setBindings.size());
+
+        WritePod(file, bindingCount);
+        for (const auto& [set, setBindings] : stage.bindings)
+        {
+            for (const auto& [binding, bindingReflect] : setBindings)
+                WriteBinding(file, bindingReflect);
+        }
+
+        WritePod(file, static_cast<uint32_t>(stage.materialUBOMembers.size()));
+        for (const auto& member : stage.materialUBOMembers)
+        {
+            WriteString(file, member.name);
+            WritePod(file, member.offset);
+            WritePod(file, member.size);
+        }
+
+        WritePod(file, static_cast<uint32_t>(stage.animationUBOComponents.size()));
+        for (const auto& component : stage.animationUBOComponents)
+            WriteString(file, component);
+
+        WritePod(file, static_cast<uint32_t>(stage.inputVariables.size()));
+        for (const auto& input : stage.inputVariables)
+        {
+            WritePod(file, input.location);
+            WritePod(file, input.size);
+            WritePod(file, static_cast<uint32_t>(input.format));
+            WriteString(file, input.name);
+            WriteString(file, input.type);
+        }
+
+        if (!file)
+        {
+            QE_LOG_WARN_CAT_F("QEReflectionCache", "Could not write reflection cache {}", cachePath.string());
+            return false;
+        }
+    }
+
+    std::error_code ec;
+    fs::rename(tempPath, cachePath, ec);
+    if (ec)
+    {
+        fs::remove(tempPath, ec);
+        QE_LOG_WARN_CAT_F("QEReflectionCache", "Could not replace reflection cache {}", cachePath.string());
+        return false;
+    }
+
+    return true;
+}
+
+bool QEReflectionCache::Load(const fs::path& cachePath, uint64_t codeHash, ReflectShader& outStage)
+{
+    std::ifstream file(cachePath, std::ios::binary);
+    if (!file.is_open())
+        return false;
+
+    CacheHeader header;
+    if (!ReadPod(file, header) ||
+        header.Magic != CACHE_MAGIC ||
+        header.Version != CACHE_VERSION ||
+        header.CodeHash != codeHash)
+    {
+        return false;
+    }
+
+    CacheStageInfo info;
+    if (!ReadPod(file, info))
+        return false;
+
+    ReflectShader stage;
+
+    DescriptorSetReflect setReflect{};
+    setReflect.stage = info.Stage;
+    setReflect.set = info.Set;
+    setReflect.bindingCount = info.BindingCount;
+    if (!ReadList(file, setReflect.bindings, [&file](DescriptorBindingReflect& binding) { return ReadBinding(file, binding); }))
+        return false;
+    stage.descriptorSetReflect.push_back(std::move(setReflect));
+
+    std::vector<DescriptorBindingReflect> bindings;
+    if (!ReadList(file, bindings, [&file](DescriptorBindingReflect& binding) { return ReadBinding(file, binding); }))
+        return false;
+    for (const auto& binding : bindings)
+        stage.bindings[binding.set].emplace(binding.binding, binding);
+
+    const bool membersRead = ReadList(file, stage.materialUBOMembers, [&file](ReflectedMember& member)
+        {
+            return ReadString(file, member.name) && ReadPod(file, member.offset) && ReadPod(file, member.size);
+        });
+    if (!membersRead)
+        return false;
+
+    if (!ReadList(file, stage.animationUBOComponents, [&file](std::string& component) { return ReadString(file, component); }))
+        return false;
+
+    const bool inputsRead = ReadList(file, stage.inputVariables, [&file](InputVars& input)
+        {
+            uint32_t format = 0;
+            if (!ReadPod(file, input.location) || !ReadPod(file, input.size) || !ReadPod(file, format))
+                return false;
+            input.format = static_cast<VkFormat>(format);
+            return ReadString(file, input.name) && ReadString(file, input.type);
+        });
+    if (!inputsRead)
+        return false;
+
+    stage.BindlessMaterialSet = info.BindlessMaterialSet;
+    stage.materialBufferSize = info.MaterialBufferSize;
+    stage.animationBufferSize = info.AnimationBufferSize;
+    stage.inputStrideSize = info.InputStrideSize;
+    stage.isAnimationShader = info.IsAnimationShader != 0;
+    stage.isUBOMaterial = info.IsUBOMaterial != 0;
+    stage.isUboAnimation = info.IsUboAnimation != 0;
+    stage.HasPointShadows = info.HasPointShadows != 0;
+    stage.HasDirectionalShadows = info.HasDirectionalShadows != 0;
+    stage.HasSpotShadows = info.HasSpotShadows != 0;
+    stage.HasBindlessMaterials = info.HasBindlessMaterials != 0;
+    stage.isShaderReflected = true;
+
+    outStage = std::move(stage);
+    return true;
+}
+
+ReflectShader QEReflectionCache::LoadOrReflect(const VkShaderModuleCreateInfo& createInfo, const fs::path& spvPath)
+{
+    const uint64_t codeHash = HashCode(createInfo);
+
+    {
+        std::lock_guard<std::mutex> lock(cacheMutex);
+        auto it = loadedStages.find(codeHash);
+        if (it != loadedStages.end())
+            return it->second;
+    }
+
+    ReflectShader stage;
+    const fs::path cachePath = GetCachePath(spvPath);
+    if (spvPath.empty() || !Load(cachePath, codeHash, stage))
+    {
+        stage = ReflectShader();
+        stage.PerformReflect(createInfo);
+
+        // Modulo nuevo o recompilado: se guarda para la proxima carga
+        if (!spvPath.empty())
+        {
+            Save(cachePath, codeHash, stage);
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    loadedStages.emplace(codeHash, stage);
+    return stage;
+}
+
+void QEReflectionCache::Clear()
+{
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    loadedStages.clear();
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#ifndef QE_REFLECTION_CACHE_H
+#define QE_REFLECTION_CACHE_H
+
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <unordered_map>
+#include <ReflectShader.h>
+
+namespace fs = std::filesystem;
+
+/// Reflexion SPIR-V de cada stage guardada junto a su modulo (Default/default_frag.spv ->
+/// Default/default_frag.spv.reflect). Guarda los bindings de los descriptor sets, los miembros del UBO
+/// de material y de animacion, los flags de sombras/bindless y las entradas del vertex shader, asi
+/// crear un ShaderModule no pasa por SPIRV-Reflect. La cabecera lleva el hash del contenido del .spv:
+/// si el modulo cambia se vuelve a reflejar y se reescribe.
+/// Los stages ya cargados se reutilizan en memoria (varios shaders comparten el mismo .spv).
+class QEReflectionCache
+{
+private:
+    static constexpr uint32_t CACHE_MAGIC = 0x46524551;     // "QERF"
+    static constexpr uint32_t CACHE_VERSION = 1;
+
+    static std::mutex cacheMutex;
+    static std::unordered_map<uint64_t, ReflectShader> loadedStages;
+
+public:
+    static constexpr const char* CACHE_EXTENSION = ".reflect";
+
+    static fs::path GetCachePath(const fs::path& spvPath);
+    static uint64_t HashCode(const VkShaderModuleCreateInfo& createInfo);
+
+    static bool Save(const fs::path& cachePath, uint64_t codeHash, const ReflectShader& stage);
+    static bool Load(const fs::path& cachePath, uint64_t codeHash, ReflectShader& outStage);
+
+    /// Reflexion de un solo stage: de memoria, de la cache del .spv o de SPIRV-Reflect (y se guarda).
+    static ReflectShader LoadOrReflect(const VkShaderModuleCreateInfo& createInfo, const fs::path& spvPath);
+
+    static void Clear();
+};
+
+
+
+namespace QE
+{
+    using ::QEReflectionCache;
+} // namespace QE
+// QE namespace aliases
+#endif // !QE_REFLECTION_CACHE_H
@@ -3,7 +3,9 @@
 #include <cassert>
 #include <thread>
 #include <algorithm>
+#include <cstring>
 #include <Logging/QELogMacros.h>
+#include <QEReflectionCache.h>
 
 static VkDescriptorType ToVkDescriptorType(SpvReflectDescriptorType t) {
     switch (t) {
@@ -798,7 +800,7 @@ void ReflectShader::CheckShadowMaps(SpvReflectDescriptorSet* set)
     {
         if (set->bindings[b]->name != NULL)
         {
-            if (strcmp(set->bindings[b]->name, "QE_PointShadowCubemaps") == 0)
+            if (strcmp(set->bindings[b]->name, "QE_PointShadowAtlas") == 0)
             {
                 this->HasPointShadows = true;
             }
@@ -806,7 +808,7 @@ void ReflectShader::CheckShadowMaps(SpvReflectDescriptorSet* set)
             {
                 this->HasDirectionalShadows = true;
             }
-            else if (strcmp(set->bindings[b]->name, "QE_SpotShadowmaps") == 0)
+            else if (strcmp(set->bindings[b]->name, "QE_SpotShadowAtlas") == 0)
             {
                 this->HasSpotShadows = true;
             }
@@ -814,6 +816,23 @@ void ReflectShader::CheckShadowMaps(SpvReflectDescriptorSet* set)
     }
 }
 
+void ReflectShader::CheckBindlessMaterials(SpvReflectDescriptorSet* set)
+{
+    for (uint32_t b = 0; b < set->binding_count; b++)
+    {
+        const SpvReflectDescriptorBinding* binding = set->bindings[b];
+        if (!binding || !binding->type_description || !binding->type_description->type_name)
+            continue;
+
+        // La tabla de QEBindlessMaterials marca el set que usa su layout global
+        if (strcmp(binding->type_description->type_name, "QE_MaterialTable") == 0)
+        {
+            this->HasBindlessMaterials = true;
+            this->BindlessMaterialSet = set->set;
+        }
+    }
+}
+
 DescriptorBindingReflect ReflectShader::GetDescriptorBinding(const SpvReflectDescriptorBinding& obj, bool write_set)
 {
     DescriptorBindingReflect descriptor{};
@@ -950,6 +969,7 @@ void ReflectShader::PerformReflect(VkShaderModuleCreateInfo createInfo)
         this->CheckUBOMaterial(p_set);
         this->CheckUBOAnimation(p_set);
         this->CheckShadowMaps(p_set);
+        this->CheckBindlessMaterials(p_set);
         auto p_set2 = spvReflectGetDescriptorSet(&module, p_set->set, &result);
         assert(result == SPV_REFLECT_RESULT_SUCCESS);
         assert(p_set == p_set2);
@@ -1003,3 +1023,66 @@ void ReflectShader::PerformReflect(VkShaderModuleCreateInfo createInfo)
     spvReflectDestroyShaderModule(&module);
     this->isShaderReflected = true;
 }
+
+void ReflectShader::PerformReflect(VkShaderModuleCreateInfo createInfo, const std::string& spvPath)
+{
+    this->Merge(QEReflectionCache::LoadOrReflect(createInfo, spvPath));
+}
+
+void ReflectShader::Merge(const ReflectShader& stage)
+{
+    // Mismo resultado que reflejar los stages uno detras de otro sobre este objeto
+    this->descriptorSetReflect.insert(this->descriptorSetReflect.end(), stage.descriptorSetReflect.begin(), stage.descriptorSetReflect.end());
+
+    for (const auto& [set, setBindings] : stage.bindings)
+    {
+        auto& setMap = this->bindings[set];
+        for (const auto& [binding, bindingReflect] : setBindings)
+        {
+            auto it = setMap.find(binding);
+            if (it == setMap.end())
+            {
+                setMap.emplace(binding, bindingReflect);
+            }
+            else
+            {
+                it->second.stage |= bindingReflect.stage;
+            }
+        }
+    }
+
+    if (!this->isUBOMaterial && stage.isUBOMaterial)
+    {
+        this->isUBOMaterial = true;
+        this->materialBufferSize = stage.materialBufferSize;
+        this->materialUBOMembers = stage.materialUBOMembers;
+    }
+
+    if (!this->isUboAnimation && stage.isUboAnimation)
+    {
+        this->isUboAnimation = true;
+        this->animationBufferSize = stage.animationBufferSize;
+        this->animationUBOComponents.insert(this->animationUBOComponents.end(), stage.animationUBOComponents.begin(), stage.animationUBOComponents.end());
+    }
+
+    this->HasPointShadows |= stage.HasPointShadows;
+    this->HasDirectionalShadows |= stage.HasDirectionalShadows;
+    this->HasSpotShadows |= stage.HasSpotShadows;
+
+    if (stage.HasBindlessMaterials)
+    {
+        this->HasBindlessMaterials = true;
+        this->BindlessMaterialSet = stage.BindlessMaterialSet;
+    }
+
+    const bool isVertexStage = !stage.descriptorSetReflect.empty() &&
+        (stage.descriptorSetReflect.front().stage & VK_SHADER_STAGE_VERTEX_BIT) != 0;
+    if (isVertexStage)
+    {
+        this->inputVariables = stage.inputVariables;
+        this->inputStrideSize += stage.inputStrideSize;
+        this->isAnimationShader = stage.isAnimationShader;
+    }
+
+    this->isShaderReflected = this->isShaderReflected || stage.isShaderReflected;
+}
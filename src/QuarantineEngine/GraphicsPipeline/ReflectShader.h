@@ -87,6 +87,8 @@ public:
     bool HasPointShadows = false;
     bool HasDirectionalShadows = false;
     bool HasSpotShadows = false;
+    bool HasBindlessMaterials = false;
+    uint32_t BindlessMaterialSet = 0;
     std::vector<ReflectedMember> materialUBOMembers;
     std::vector<std::string> animationUBOComponents;
     VkDeviceSize materialBufferSize = 0;
@@ -113,11 +115,16 @@ private:
     void CheckUBOMaterial(SpvReflectDescriptorSet* set);
     void CheckUBOAnimation(SpvReflectDescriptorSet* set);
     void CheckShadowMaps(SpvReflectDescriptorSet* set);
+    void CheckBindlessMaterials(SpvReflectDescriptorSet* set);
     void RemoveInputNativeVariables();
 public:
     ReflectShader();
     void Output(VkShaderModuleCreateInfo createInfo);
     void PerformReflect(VkShaderModuleCreateInfo createInfo);
+    /// Igual, pero con la reflexion de QEReflectionCache si el .spv no ha cambiado desde la ultima vez.
+    void PerformReflect(VkShaderModuleCreateInfo createInfo, const std::string& spvPath);
+    /// Anade la reflexion de un stage (un ReflectShader con un solo PerformReflect) a la del shader.
+    void Merge(const ReflectShader& stage);
 };
 
 
@@ -4,6 +4,7 @@
 #include <stdexcept>
 #include <cstddef>
 #include <Vertex.h>
+#include <QEBindlessMaterials.h>
 
 ShaderModule::ShaderModule(std::string shaderId)
 {
@@ -156,9 +157,14 @@ void ShaderModule::createMeshShaderModule(const std::string& filename_task, cons
 
 void ShaderModule::CleanDescriptorSetLayout()
 {
+    auto* bindlessMaterials = QEBindlessMaterials::getInstance();
+    const VkDescriptorSetLayout bindlessLayout = bindlessMaterials ? bindlessMaterials->GetSetLayout() : VK_NULL_HANDLE;
+
     for (uint32_t i = 0; i < this->descriptorSetLayouts.size(); i++)
     {
-        vkDestroyDescriptorSetLayout(deviceModule->device, this->descriptorSetLayouts.at(i), nullptr);
+        // El layout bindless es global y lo destruye QEBindlessMaterials
+        if (this->descriptorSetLayouts.at(i) != bindlessLayout)
+            vkDestroyDescriptorSetLayout(deviceModule->device, this->descriptorSetLayouts.at(i), nullptr);
         this->descriptorSetLayouts.at(i) = VK_NULL_HANDLE;
     }
 }
@@ -231,7 +237,7 @@ VkPipelineShaderStageCreateInfo ShaderModule::createShader(VkDevice& device, con
     createInfo.codeSize = code.size();
     createInfo.pCode = reinterpret_cast<const uint32_t*>(code.data());
 
-    this->reflectShader.PerformReflect(createInfo);
+    this->reflectShader.PerformReflect(createInfo, filename);
 
     VkPipelineShaderStageCreateInfo shaderStageInfo{};
     shaderStageInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
@@ -320,6 +326,18 @@ void ShaderModule::CreateDescriptorSetLayout()
             continue;
         }
 
+        if (this->reflectShader.HasBindlessMaterials && idSet == static_cast<int>(this->reflectShader.BindlessMaterialSet))
+        {
+            auto* bindlessMaterials = QEBindlessMaterials::getInstance();
+            if (bindlessMaterials == nullptr || !bindlessMaterials->IsAvailable())
+                throw std::runtime_error("shader " + this->shaderNameID + " uses bindless materials but descriptor indexing is not available!");
+
+            this->descriptorSetLayouts.at(countSet) = bindlessMaterials->GetSetLayout();
+            countSet++;
+            idSet++;
+            continue;
+        }
+
         std::vector<VkDescriptorSetLayoutBinding> bindings{};
         for (auto reflectLayotBinding : this->reflectShader.bindings[idSet])
         {
@@ -1,4 +1,6 @@
 #include "ShadowPipelineModule.h"
+#include <Helpers/QEMemoryTrack.h>
+#include <QEBindlessMaterials.h>
 #include <CSMResources.h>
 
 ShadowPipelineModule::ShadowPipelineModule()
@@ -141,6 +143,8 @@ void ShadowPipelineModule::CompileDirectionalShadowPipeline(std::vector<VkPipeli
     if (vkCreatePipelineLayout(deviceModule->device, &pipelineLayoutInfo, nullptr, &this->pipelineLayout) != VK_SUCCESS) {
         throw std::runtime_error("failed to create pipeline layout!");
     }
+    if (auto* bindlessMaterials = QEBindlessMaterials::getInstance())
+        bindlessMaterials->RegisterPipelineLayout(this->pipelineLayout, descriptorLayouts);
 
     VkGraphicsPipelineCreateInfo pipelineInfo{};
     pipelineInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
@@ -218,20 +222,12 @@ void ShadowPipelineModule::CompileOmniShadowPipeline(std::vector<VkPipelineShade
     multisampling.alphaToCoverageEnable = VK_FALSE; // Optional
     multisampling.alphaToOneEnable = VK_FALSE; // Optional
 
-    VkPipelineColorBlendAttachmentState colorBlendAttachment{};
-    colorBlendAttachment.colorWriteMask = 0xf;
-    colorBlendAttachment.blendEnable = VK_FALSE;
-    colorBlendAttachment.srcColorBlendFactor = VK_BLEND_FACTOR_SRC_ALPHA;
-    colorBlendAttachment.dstColorBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
-    colorBlendAttachment.colorBlendOp = VK_BLEND_OP_ADD;
-    colorBlendAttachment.srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE;
-    colorBlendAttachment.dstAlphaBlendFactor = VK_BLEND_FACTOR_ZERO;
-    colorBlendAttachment.alphaBlendOp = VK_BLEND_OP_ADD;
-
+    // Solo profundidad: la distancia lineal a la luz se escribe en gl_FragDepth
     VkPipelineColorBlendStateCreateInfo colorBlending{};
     colorBlending.sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
-    colorBlending.attachmentCount = 1;
-    colorBlending.pAttachments = &colorBlendAttachment;
+    colorBlending.logicOpEnable = VK_FALSE;
+    colorBlending.attachmentCount = 0;
+    colorBlending.pAttachments = nullptr;
 
     std::vector<VkDynamicState> dynamicStates = {
         VK_DYNAMIC_STATE_VIEWPORT,
@@ -276,6 +272,8 @@ void ShadowPipelineModule::CompileOmniShadowPipeline(std::vector<VkPipelineShade
     if (vkCreatePipelineLayout(deviceModule->device, &pipelineLayoutInfo, nullptr, &this->pipelineLayout) != VK_SUCCESS) {
         throw std::runtime_error("failed to create pipeline layout!");
     }
+    if (auto* bindlessMaterials = QEBindlessMaterials::getInstance())
+        bindlessMaterials->RegisterPipelineLayout(this->pipelineLayout, descriptorLayouts);
 
     VkGraphicsPipelineCreateInfo pipelineInfo{};
     pipelineInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
@@ -303,6 +301,8 @@ void ShadowPipelineModule::CompileOmniShadowPipeline(std::vector<VkPipelineShade
 
 void ShadowPipelineModule::cleanup(VkPipeline pipeline, VkPipelineLayout pipelineLayout)
 {
-    vkDestroyPipeline(deviceModule->device, pipeline, nullptr);
-    vkDestroyPipelineLayout(deviceModule->device, pipelineLayout, nullptr);
+    if (auto* bindlessMaterials = QEBindlessMaterials::getInstance())
+        bindlessMaterials->UnregisterPipelineLayout(pipelineLayout);
+    QE_DEFER_DESTROY(deviceModule->device, pipeline, vkDestroyPipeline, "ShadowPipelineModule::cleanup");
+    QE_DEFER_DESTROY(deviceModule->device, pipelineLayout, vkDestroyPipelineLayout, "ShadowPipelineModule::cleanup");
 }
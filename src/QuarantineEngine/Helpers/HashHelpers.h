@@ -0,0 +1,33 @@
+#pragma once
+
+#ifndef HASH_HELPERS
+#define HASH_HELPERS
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace QEHelper
+{
+    // FNV-1a por palabras de 64 bits; el seed permite encadenar varios bloques en una misma clave
+    inline uint64_t HashBytes(const void* data, size_t size, uint64_t seed = 0)
+    {
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+        uint64_t hash = 0xCBF29CE484222325ull ^ seed ^ size;
+        size_t i = 0;
+        for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t))
+        {
+            uint64_t word = 0;
+            memcpy(&word, bytes + i, sizeof(word));
+            hash = (hash ^ word) * 0x100000001B3ull;
+            hash ^= hash >> 29;
+        }
+        for (; i < size; ++i)
+        {
+            hash = (hash ^ bytes[i]) * 0x100000001B3ull;
+        }
+        return hash;
+    }
+}
+
+#endif // !HASH_HELPERS
@@ -1,6 +1,7 @@
 #pragma once
 #include <vulkan/vulkan.h>
 #include <Logging/QELogMacros.h>
+#include <QEDeferredDeletionQueue.h>
 
 #include <unordered_map>
 #include <string>
@@ -109,11 +110,16 @@ inline void QEDestroyBufferTracked(
     buffer = VK_NULL_HANDLE;
 }
 
+// Liberacion diferida hasta que ningun frame en vuelo use el recurso (ver QEDeferredDeletionQueue)
 #define QE_FREE_MEMORY(device, memory, owner) \
-    QEFreeMemoryTracked(device, memory, owner, __FILE__, __LINE__)
+    QEDeferredDeletionQueue::getInstance()->FreeMemory(device, memory, owner, __FILE__, __LINE__)
 
 #define QE_DESTROY_BUFFER(device, buffer, owner) \
-    QEDestroyBufferTracked(device, buffer, owner, __FILE__, __LINE__)
+    QEDeferredDeletionQueue::getInstance()->DestroyBuffer(device, buffer, owner, __FILE__, __LINE__)
+
+// Cualquier otro handle: QE_DEFER_DESTROY(device, image, vkDestroyImage, "Owner")
+#define QE_DEFER_DESTROY(device, handle, destroyFn, owner) \
+    QEDeferredDeletionQueue::getInstance()->DestroyHandle(device, handle, destroyFn, owner, __FILE__, __LINE__)
 
 #define QE_TRACK_MEMORY_ALLOCATION(memory, owner) \
     QETrackMemoryAllocation(memory, owner, __FILE__, __LINE__)
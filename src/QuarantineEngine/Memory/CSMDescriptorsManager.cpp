@@ -1,6 +1,7 @@
 #include "CSMDescriptorsManager.h"
 #include "SynchronizationModule.h"
 #include <Helpers/QEMemoryTrack.h>
+#include <QEDeferredDeletionQueue.h>
 
 CSMDescriptorsManager::CSMDescriptorsManager()
 {
@@ -46,13 +47,11 @@ void CSMDescriptorsManager::AddDirLightResources(
         return;
     }
 
-    WaitForGpuIdle();
-
     AllocateOffscreenDescriptorSetForLight(newLightIndex);
 
     if (this->renderDescriptorSets[0] != VK_NULL_HANDLE)
     {
-        UpdateRenderDescriptorSets();
+        ScheduleRenderDescriptorSetsUpdate();
     }
 }
 
@@ -61,8 +60,6 @@ void CSMDescriptorsManager::DeleteDirLightResources(int idPos)
     if (idPos < 0 || static_cast<uint32_t>(idPos) >= this->_numDirLights)
         return;
 
-    WaitForGpuIdle();
-
     this->csmOffscreenUBOs.erase(this->csmOffscreenUBOs.begin() + idPos);
     this->_imageViews.erase(this->_imageViews.begin() + idPos);
     this->_samplers.erase(this->_samplers.begin() + idPos);
@@ -86,7 +83,7 @@ void CSMDescriptorsManager::DeleteDirLightResources(int idPos)
 
     if (this->renderDescriptorSets[0] != VK_NULL_HANDLE)
     {
-        UpdateRenderDescriptorSets();
+        ScheduleRenderDescriptorSetsUpdate();
     }
 }
 
@@ -359,16 +356,18 @@ void CSMDescriptorsManager::CreateOffscreenDescriptorSet()
 
 void CSMDescriptorsManager::ResetSceneState()
 {
-    WaitForGpuIdle();
-
+    // Los frames en vuelo aun pueden usar los sets actuales: los pools se retiran por la cola
+    // de destruccion diferida y la escena nueva reserva sus sets en pools vacios
     if (this->offscreenDescriptorPool != VK_NULL_HANDLE)
     {
-        vkResetDescriptorPool(deviceModule->device, this->offscreenDescriptorPool, 0);
+        QE_DEFER_DESTROY(deviceModule->device, this->offscreenDescriptorPool, vkDestroyDescriptorPool, "CSMDescriptorsManager::ResetSceneState");
+        this->CreateOffscreenDescriptorPool();
     }
 
     if (this->renderDescriptorPool != VK_NULL_HANDLE)
     {
-        vkResetDescriptorPool(deviceModule->device, this->renderDescriptorPool, 0);
+        QE_DEFER_DESTROY(deviceModule->device, this->renderDescriptorPool, vkDestroyDescriptorPool, "CSMDescriptorsManager::ResetSceneState");
+        this->CreateRenderDescriptorPool();
     }
 
     _numDirLights = 0;
@@ -520,48 +519,58 @@ void CSMDescriptorsManager::AllocateOffscreenDescriptorSetForLight(uint32_t ligh
 
 void CSMDescriptorsManager::UpdateRenderDescriptorSets()
 {
-    for (size_t frame = 0; frame < MAX_FRAMES_IN_FLIGHT; ++frame)
+    for (uint32_t frame = 0; frame < MAX_FRAMES_IN_FLIGHT; ++frame)
     {
-        if (this->renderDescriptorSets[frame] == VK_NULL_HANDLE)
-            continue;
-
-        std::array<VkWriteDescriptorSet, 3> descriptorWrites{};
-
-        this->SetCSMDescriptorWrite(
-            descriptorWrites[0],
-            this->renderDescriptorSets[frame],
-            VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-            0);
+        this->UpdateRenderDescriptorSet(frame);
+    }
+}
 
-        this->SetRenderDescriptorWrite(
-            descriptorWrites[1],
-            this->renderDescriptorSets[frame],
-            VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
-            1,
-            this->csmRenderSplitBuffer.uniformBuffers[frame],
-            this->csmSplitDataBufferSize);
-
-        this->SetRenderDescriptorWrite(
-            descriptorWrites[2],
-            this->renderDescriptorSets[frame],
-            VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
-            2,
-            this->csmRenderViewProjBuffer.uniformBuffers[frame],
-            this->csmViewProjDataBufferSize);
-
-        vkUpdateDescriptorSets(
-            deviceModule->device,
-            static_cast<uint32_t>(descriptorWrites.size()),
-            descriptorWrites.data(),
-            0,
-            nullptr);
+void CSMDescriptorsManager::ScheduleRenderDescriptorSetsUpdate()
+{
+    // Cada set se reescribe cuando el frame que lo usa ha terminado, sin parar la GPU
+    auto deletionQueue = QEDeferredDeletionQueue::getInstance();
+    for (uint32_t frame = 0; frame < MAX_FRAMES_IN_FLIGHT; ++frame)
+    {
+        deletionQueue->RunWhenSlotIdle(frame, [this, frame]()
+            {
+                this->UpdateRenderDescriptorSet(frame);
+            });
     }
 }
 
-void CSMDescriptorsManager::WaitForGpuIdle() const
+void CSMDescriptorsManager::UpdateRenderDescriptorSet(uint32_t frame)
 {
-    if (!deviceModule)
+    if (this->renderDescriptorSets[frame] == VK_NULL_HANDLE)
         return;
 
-    vkDeviceWaitIdle(deviceModule->device);
+    std::array<VkWriteDescriptorSet, 3> descriptorWrites{};
+
+    this->SetCSMDescriptorWrite(
+        descriptorWrites[0],
+        this->renderDescriptorSets[frame],
+        VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+        0);
+
+    this->SetRenderDescriptorWrite(
+        descriptorWrites[1],
+        this->renderDescriptorSets[frame],
+        VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
+        1,
+        this->csmRenderSplitBuffer.uniformBuffers[frame],
+        this->csmSplitDataBufferSize);
+
+    this->SetRenderDescriptorWrite(
+        descriptorWrites[2],
+        this->renderDescriptorSets[frame],
+        VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+        2,
+        this->csmRenderViewProjBuffer.uniformBuffers[frame],
+        this->csmViewProjDataBufferSize);
+
+    vkUpdateDescriptorSets(
+        deviceModule->device,
+        static_cast<uint32_t>(descriptorWrites.size()),
+        descriptorWrites.data(),
+        0,
+        nullptr);
 }
@@ -7,8 +7,9 @@
 #include <DeviceModule.h>
 #include <CSMResources.h>
 #include <ShaderModule.h>
+#include <SynchronizationModule.h>
 
-constexpr uint32_t                  NUM_CSM_SETS = 2;
+constexpr uint32_t                  NUM_CSM_SETS = MAX_FRAMES_IN_FLIGHT;
 constexpr uint32_t                  NUM_CSM_PASSES = 2;
 constexpr uint32_t                  MAX_NUM_DIR_LIGHTS = 10;
 
@@ -64,7 +65,7 @@ public:
 
     void AllocateOffscreenDescriptorSetForLight(uint32_t lightIndex);
     void UpdateRenderDescriptorSets();
-    void WaitForGpuIdle() const;
+    void ScheduleRenderDescriptorSetsUpdate();
 
 private:
     void CreateOffscreenDescriptorPool();
@@ -72,6 +73,7 @@ private:
     void SetOffscreenDescriptorWrite(VkWriteDescriptorSet& descriptorWrite, VkDescriptorSet descriptorSet, VkDescriptorType descriptorType, uint32_t binding, VkBuffer buffer, VkDeviceSize bufferSize);
     void CreateRenderDescriptorPool();
     void CreateRenderDescriptorSet();
+    void UpdateRenderDescriptorSet(uint32_t frame);
     VkDescriptorSetLayout CreateRenderDescriptorSetLayout();
     void SetRenderDescriptorWrite(VkWriteDescriptorSet& descriptorWrite, VkDescriptorSet descriptorSet, VkDescriptorType descriptorType, uint32_t binding, VkBuffer buffer, VkDeviceSize bufferSize);
     void SetCSMDescriptorWrite(VkWriteDescriptorSet& descriptorWrite, VkDescriptorSet descriptorSet, VkDescriptorType descriptorType, uint32_t binding);
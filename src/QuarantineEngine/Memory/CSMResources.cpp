@@ -155,7 +155,8 @@ void CSMResources::CreateCSMResources(std::shared_ptr<VkRenderPass> renderPass)
         this->TextureSize,
         this->shadowFormat,
         VK_IMAGE_TILING_OPTIMAL,
-        VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
+        VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT |
+        VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT,
         1);
 
     this->TransitionImageLayout(
@@ -206,6 +207,35 @@ void CSMResources::UpdateOffscreenUBOShadowMap()
     vkUnmapMemory(this->deviceModule->device, this->OffscreenShadowMapUBO->uniformBuffersMemory[currentFrame]);
 }
 
+void CSMResources::StoreStaticLayer(VkCommandBuffer commandBuffer, uint32_t cascadeIndex)
+{
+    if (this->staticLayerCache == nullptr)
+    {
+        VkImageAspectFlags aspectMask = VK_IMAGE_ASPECT_DEPTH_BIT;
+        if (HasStencilComponent(this->shadowFormat))
+        {
+            aspectMask |= VK_IMAGE_ASPECT_STENCIL_BIT;
+        }
+
+        this->staticLayerCache = std::make_shared<ShadowStaticLayerCache>(this->shadowFormat, aspectMask, this->TextureSize, SHADOW_MAP_CASCADE_COUNT);
+    }
+
+    this->staticLayerCache->Store(commandBuffer, this->CSMImage, VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL, cascadeIndex, cascadeIndex);
+}
+
+void CSMResources::RestoreStaticLayer(VkCommandBuffer commandBuffer, uint32_t cascadeIndex)
+{
+    if (this->staticLayerCache == nullptr)
+        return;
+
+    this->staticLayerCache->Restore(commandBuffer, this->CSMImage, VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL, cascadeIndex, cascadeIndex);
+}
+
+VkDeviceSize CSMResources::GetStaticLayerCacheSize() const
+{
+    return this->staticLayerCache ? this->staticLayerCache->GetAllocationSize() : 0;
+}
+
 void CSMResources::TransitionImageLayout(VkDevice device, VkImage& newImage, VkFormat format, VkImageLayout oldLayout, VkImageLayout newLayout, uint32_t layerCount)
 {
     VkCommandBuffer commandBuffer = beginSingleTimeCommands(device, commandPool);
@@ -245,6 +275,12 @@ void CSMResources::TransitionImageLayout(VkDevice device, VkImage& newImage, VkF
 
 void CSMResources::Cleanup()
 {
+    if (this->staticLayerCache != nullptr)
+    {
+        this->staticLayerCache->Cleanup();
+        this->staticLayerCache = nullptr;
+    }
+
     for (int i = 0; i < MAX_FRAMES_IN_FLIGHT; i++)
     {
         if (this->OffscreenShadowMapUBO != nullptr)
@@ -256,15 +292,15 @@ void CSMResources::Cleanup()
 
     if (this->CSMSampler != VK_NULL_HANDLE)
     {
-        vkDestroySampler(this->deviceModule->device, this->CSMSampler, nullptr);
+        QE_DEFER_DESTROY(this->deviceModule->device, this->CSMSampler, vkDestroySampler, "CSMResources::Cleanup");
     }
     if (this->CSMImageView != VK_NULL_HANDLE)
     {
-        vkDestroyImageView(deviceModule->device, CSMImageView, nullptr);
+        QE_DEFER_DESTROY(deviceModule->device, CSMImageView, vkDestroyImageView, "CSMResources::Cleanup");
     }
     if (this->CSMImage != VK_NULL_HANDLE)
     {
-        vkDestroyImage(deviceModule->device, this->CSMImage, nullptr);
+        QE_DEFER_DESTROY(deviceModule->device, this->CSMImage, vkDestroyImage, "CSMResources::Cleanup");
     }
     if (this->CSMImageMemory != VK_NULL_HANDLE)
     {
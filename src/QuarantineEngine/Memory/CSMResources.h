@@ -6,6 +6,7 @@
 #include <vulkan/vulkan.hpp>
 #include <DeviceModule.h>
 #include <SwapChainModule.h>
+#include <ShadowStaticLayerCache.h>
 
 constexpr uint32_t  SHADOW_MAP_CASCADE_COUNT = 4;
 
@@ -31,6 +32,9 @@ private:
     VkImage CSMImage = VK_NULL_HANDLE;
     VkDeviceMemory CSMImageMemory = { VK_NULL_HANDLE };
 
+    // Capa estatica cacheada por cascada
+    std::shared_ptr<ShadowStaticLayerCache> staticLayerCache = nullptr;
+
 public:
     static QueueModule* queueModule;
     static VkCommandPool commandPool;
@@ -55,6 +59,10 @@ public:
     CSMResources();
     CSMResources(std::shared_ptr<VkRenderPass> renderPass);
     void UpdateOffscreenUBOShadowMap();
+    void StoreStaticLayer(VkCommandBuffer commandBuffer, uint32_t cascadeIndex);
+    void RestoreStaticLayer(VkCommandBuffer commandBuffer, uint32_t cascadeIndex);
+    VkDeviceSize GetStaticLayerCacheSize() const;
+    VkImage GetImage() const { return this->CSMImage; }
     static VkFormat GetSupportedShadowFormat(DeviceModule* deviceModule);
     static bool HasStencilComponent(VkFormat format);
     static void TransitionImageLayout(VkDevice device, VkImage& newImage, VkFormat format, VkImageLayout oldLayout, VkImageLayout newLayout, uint32_t layerCount = SHADOW_MAP_CASCADE_COUNT);
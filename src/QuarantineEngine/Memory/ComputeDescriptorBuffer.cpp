@@ -422,8 +422,7 @@ void ComputeDescriptorBuffer::Cleanup()
 
     if (this->descriptorPool != VK_NULL_HANDLE)
     {
-        vkDestroyDescriptorPool(deviceModule->device, this->descriptorPool, nullptr);
-        this->descriptorPool = VK_NULL_HANDLE;
+        QE_DEFER_DESTROY(deviceModule->device, this->descriptorPool, vkDestroyDescriptorPool, "ComputeDescriptorBuffer::Cleanup");
     }
 
     for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++)
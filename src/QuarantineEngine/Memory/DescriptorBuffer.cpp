@@ -1,6 +1,7 @@
 #include "DescriptorBuffer.h"
 #include "SynchronizationModule.h"
 #include <QECameraContext.h>
+#include <QEMeshletCulling.h>
 #include <Helpers/QEMemoryTrack.h>
 
 DescriptorBuffer::DescriptorBuffer()
@@ -167,7 +168,8 @@ void DescriptorBuffer::StartResources(std::shared_ptr<ShaderModule> shader_ptr)
             this->ssboSize["IndexBuffer"] = VkDeviceSize(0);
             this->numSSBOs++;
         }
-        else if (br.name == "LightSSBO" || br.name == "LightIndices" || br.name == "ZBins" || br.name == "Tiles")
+        else if (br.name == "LightSSBO" || br.name == "LightIndices" || br.name == "ZBins" || br.name == "Tiles" ||
+            br.name == "MeshletCulling")
         {
             this->numSSBOs++;
         }
@@ -385,6 +387,11 @@ std::vector<VkWriteDescriptorSet> DescriptorBuffer::GetDescriptorWrites(std::sha
         {
             pushSSBO(dstBinding, this->ssboData["IndexBuffer"]->uniformBuffers[frameIdx], this->ssboSize["IndexBuffer"]);
         }
+        else if (br.name == "MeshletCulling")
+        {
+            auto meshletCulling = QEMeshletCulling::getInstance();
+            pushSSBO(dstBinding, meshletCulling->GetBuffer(frameIdx), meshletCulling->GetBufferSize());
+        }
         else if (br.name == "ParticleSSBO")
         {
             pushSSBO(dstBinding, this->ssboData["ParticleSSBO"]->uniformBuffers[frameIdx], this->ssboSize["ParticleSSBO"]);
@@ -450,31 +457,33 @@ void DescriptorBuffer::RefreshDescriptorSets(std::shared_ptr<ShaderModule> shade
 
     // Editor-side material changes can arrive while descriptor sets from
     // previous frames are still referenced by pending command buffers.
-    // Since these refreshes are infrequent and interactive, we prefer a
-    // conservative sync point over updating sets that are still in flight.
-    vkDeviceWaitIdle(deviceModule->device);
+    // Each frame's set is rewritten once its fence has been waited on.
+    std::weak_ptr<DescriptorBuffer> weakThis = this->weak_from_this();
+    auto deletionQueue = QEDeferredDeletionQueue::getInstance();
 
-    for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++)
+    for (uint32_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++)
     {
-        std::vector<VkWriteDescriptorSet> descriptorWrites{};
-        descriptorWrites = this->GetDescriptorWrites(shader_ptr, (uint32_t)i);
-        vkUpdateDescriptorSets(deviceModule->device, static_cast<uint32_t>(descriptorWrites.size()), descriptorWrites.data(), 0, nullptr);
+        deletionQueue->RunWhenSlotIdle(i, [weakThis, shader_ptr, i]()
+            {
+                auto self = weakThis.lock();
+                if (!self || i >= self->descriptorSets.size())
+                    return;
+
+                std::vector<VkWriteDescriptorSet> descriptorWrites = self->GetDescriptorWrites(shader_ptr, i);
+                vkUpdateDescriptorSets(self->deviceModule->device, static_cast<uint32_t>(descriptorWrites.size()), descriptorWrites.data(), 0, nullptr);
+            });
     }
 }
 
 void DescriptorBuffer::CleanDescriptorSetPool()
 {
-    vkDestroyDescriptorPool(deviceModule->device, this->descriptorPool, nullptr);
+    QE_DEFER_DESTROY(deviceModule->device, this->descriptorPool, vkDestroyDescriptorPool, "DescriptorBuffer::CleanDescriptorSetPool");
     this->descriptorSets.clear();
 }
 
 void DescriptorBuffer::Cleanup()
 {
-    if (deviceModule)
-    {
-        vkDeviceWaitIdle(deviceModule->device);
-    }
-
+    // Pool y buffers se liberan cuando terminan los frames que aun los usan
     this->CleanDescriptorSetPool();
 
     for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++)
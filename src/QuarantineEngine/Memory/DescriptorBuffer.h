@@ -12,7 +12,7 @@
 
 class LightManager;
 
-class DescriptorBuffer
+class DescriptorBuffer : public std::enable_shared_from_this<DescriptorBuffer>
 {
 private:
     DeviceModule*   deviceModule = nullptr;
@@ -20,7 +20,7 @@ private:
     SwapChainModule* swapChainModule = nullptr;
     std::shared_ptr<Meshlet> meshlets_ptr = nullptr;
 
-    VkDescriptorPool                descriptorPool;
+    VkDescriptorPool                descriptorPool = VK_NULL_HANDLE;
 
     uint32_t    numUBOs = 0;
     uint32_t    numSSBOs = 0;
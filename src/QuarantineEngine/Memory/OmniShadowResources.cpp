@@ -1,414 +1,153 @@
 #include "OmniShadowResources.h"
-#include "ImageMemoryTools.h"
-#include "FrameBufferModule.h"
 #include <SynchronizationModule.h>
-#include <SyncTool.h>
 #include <Helpers/QEMemoryTrack.h>
-
-QueueModule* OmniShadowResources::queueModule;
-VkCommandPool OmniShadowResources::commandPool;
-uint32_t OmniShadowResources::TextureSize;
+#include <glm/gtc/matrix_transform.hpp>
 
 OmniShadowResources::OmniShadowResources()
 {
-    this->TextureSize = 2048;
     this->deviceModule = DeviceModule::getInstance();
     this->swapchainModule = SwapChainModule::getInstance();
-    this->shadowFormat = GetSupportedColorFormat(this->deviceModule);
-    this->framebufferDepthFormat = GetSupportedDepthFormat(this->deviceModule);
 
     this->shadowMapUBO = std::make_shared<UniformBufferObject>();
     this->shadowMapUBO->CreateUniformBuffer(sizeof(OmniShadowUniform), MAX_FRAMES_IN_FLIGHT, *deviceModule);
 }
 
-OmniShadowResources::OmniShadowResources(std::shared_ptr<VkRenderPass> renderPass) : OmniShadowResources()
+void OmniShadowResources::SetAtlasTile(std::shared_ptr<ShadowAtlasResources> atlasResources, const ShadowAtlasTile& tile)
 {
-    this->CreateOmniShadowMapResources(renderPass);
+    // La cache estatica copia el tile completo: si cambia de tamano hay que recrearla
+    if (this->staticLayerCache != nullptr && this->staticLayerCache->GetTextureSize() != tile.Size)
+    {
+        this->ReleaseStaticLayerCache();
+    }
+
+    this->atlas = atlasResources;
+    this->atlasTile = tile;
 }
 
-VkImage OmniShadowResources::CreateFramebufferDepthImage(VkDeviceMemory& deviceImageMemory)
+void OmniShadowResources::ClearAtlasTile()
 {
-    VkImage resultImage = {};
-    // Color attachment
-    VkImageCreateInfo imageCreateInfo = {};
-    imageCreateInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
-    imageCreateInfo.imageType = VK_IMAGE_TYPE_2D;
-    imageCreateInfo.format = this->shadowFormat;
-    imageCreateInfo.extent.width = this->TextureSize;
-    imageCreateInfo.extent.height = this->TextureSize;
-    imageCreateInfo.extent.depth = 1;
-    imageCreateInfo.mipLevels = 1;
-    imageCreateInfo.arrayLayers = 1;
-    imageCreateInfo.samples = VK_SAMPLE_COUNT_1_BIT;
-    imageCreateInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
-    imageCreateInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-    imageCreateInfo.usage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
-    imageCreateInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
-    imageCreateInfo.format = this->framebufferDepthFormat;
-    imageCreateInfo.usage = VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT;
-
-    vkCreateImage(this->deviceModule->device, &imageCreateInfo, nullptr, &resultImage);
-
-    VkMemoryRequirements memReqs;
-    vkGetImageMemoryRequirements(this->deviceModule->device, resultImage, &memReqs);
-
-    VkMemoryAllocateInfo memAlloc{};
-    memAlloc.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-    memAlloc.allocationSize = memReqs.size;
-    memAlloc.memoryTypeIndex = IMT::findMemoryType(memReqs.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, deviceModule->physicalDevice);
-    vkAllocateMemory(this->deviceModule->device, &memAlloc, nullptr, &deviceImageMemory);
-    QE_TRACK_MEMORY_ALLOCATION(deviceImageMemory, "OmniShadowResources::AllocateImage");
-    vkBindImageMemory(this->deviceModule->device, resultImage, deviceImageMemory, 0);
-
-    return resultImage;
+    this->atlas = nullptr;
+    this->atlasTile = {};
 }
 
-VkImageView OmniShadowResources::CreateImageView(VkDevice device, VkImage image, VkFormat format, VkImageAspectFlags aspectFlags, uint32_t mipLevels)
+VkRect2D OmniShadowResources::GetAtlasRegion() const
 {
-    VkImageViewCreateInfo viewInfo{};
-    viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
-    viewInfo.image = image;
-    viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
-    viewInfo.format = format;
-    viewInfo.components = {
-        VK_COMPONENT_SWIZZLE_IDENTITY,
-        VK_COMPONENT_SWIZZLE_IDENTITY,
-        VK_COMPONENT_SWIZZLE_IDENTITY,
-        VK_COMPONENT_SWIZZLE_IDENTITY
-    };
-    viewInfo.subresourceRange.aspectMask = aspectFlags;
-    viewInfo.subresourceRange.baseMipLevel = 0;
-    viewInfo.subresourceRange.levelCount = mipLevels;
-    viewInfo.subresourceRange.baseArrayLayer = 0;
-    viewInfo.subresourceRange.layerCount = 1;
-
-    VkImageView imageView;
-    if (vkCreateImageView(device, &viewInfo, nullptr, &imageView) != VK_SUCCESS) {
-        throw std::runtime_error("failed to create texture image view!");
-    }
-
-    return imageView;
+    VkRect2D region{};
+    region.offset = { static_cast<int32_t>(this->atlasTile.X), static_cast<int32_t>(this->atlasTile.Y) };
+    region.extent = { this->atlasTile.Size, this->atlasTile.Size };
+    return region;
 }
 
-VkImage OmniShadowResources::AllocateCubemapImage(VkDevice device, VkPhysicalDevice physicalDevice, VkDeviceMemory& mapMemory, uint32_t pixelSize, VkFormat format, VkImageTiling tiling, VkImageUsageFlags usage, VkMemoryPropertyFlags properties, VkSampleCountFlagBits numSamples)
+glm::vec4 OmniShadowResources::GetAtlasRect() const
 {
-    VkImage result;
-
-    VkImageCreateInfo imageInfo{};
-    imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
-    imageInfo.imageType = VK_IMAGE_TYPE_2D;
-    imageInfo.extent = { pixelSize, pixelSize, 1 };
-    imageInfo.mipLevels = 1;
-    imageInfo.arrayLayers = 6;
-    imageInfo.format = format;
-    imageInfo.tiling = tiling;
-    imageInfo.usage = usage;
-    imageInfo.samples = numSamples;
-    imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
-    imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-    imageInfo.flags = VK_IMAGE_CREATE_CUBE_COMPATIBLE_BIT;
-
-    if (vkCreateImage(device, &imageInfo, nullptr, &result) != VK_SUCCESS) {
-        throw std::runtime_error("failed to create cube map image!");
-    }
-
-    VkMemoryRequirements memRequirements;
-    vkGetImageMemoryRequirements(device, result, &memRequirements);
+    if (!this->HasAtlasTile())
+        return glm::vec4(0.0f);
 
-    VkMemoryAllocateInfo allocInfo{};
-    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-    allocInfo.allocationSize = memRequirements.size;
-    allocInfo.memoryTypeIndex = IMT::findMemoryType(memRequirements.memoryTypeBits, properties, physicalDevice);
-
-    if (vkAllocateMemory(device, &allocInfo, nullptr, &mapMemory) != VK_SUCCESS) {
-        throw std::runtime_error("failed to allocate cube map image memory!");
-    }
-    QE_TRACK_MEMORY_ALLOCATION(mapMemory, "OmniShadowResources::AllocateCubemapImage");
-
-    vkBindImageMemory(device, result, mapMemory, 0);
-
-    return result;
+    const float invAtlasSize = 1.0f / static_cast<float>(this->atlas->GetAtlasSize());
+    return glm::vec4(
+        this->atlasTile.X * invAtlasSize,
+        this->atlasTile.Y * invAtlasSize,
+        this->atlasTile.Size * invAtlasSize,
+        this->atlasTile.Size * invAtlasSize);
 }
 
-VkImageView OmniShadowResources::CreateCubemapImageView(VkDevice device, VkImage& image, VkFormat format, VkImageAspectFlags aspectFlags, uint32_t mipLevels)
+VkFramebuffer OmniShadowResources::GetFramebuffer(uint32_t faceIdx) const
 {
-    VkImageView resultImageView = {};
-
-    VkImageViewCreateInfo viewInfo{};
-    viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
-    viewInfo.image = image;
-    viewInfo.viewType = VK_IMAGE_VIEW_TYPE_CUBE;
-    viewInfo.format = format;
-    viewInfo.components = {
-        VK_COMPONENT_SWIZZLE_IDENTITY,
-        VK_COMPONENT_SWIZZLE_IDENTITY,
-        VK_COMPONENT_SWIZZLE_IDENTITY,
-        VK_COMPONENT_SWIZZLE_IDENTITY
-    };
-
-    viewInfo.subresourceRange.aspectMask = aspectFlags;
-    viewInfo.subresourceRange.baseMipLevel = 0;
-    viewInfo.subresourceRange.levelCount = mipLevels;
-    viewInfo.subresourceRange.baseArrayLayer = 0;
-    viewInfo.subresourceRange.layerCount = 6;
-
-    if (vkCreateImageView(device, &viewInfo, nullptr, &resultImageView) != VK_SUCCESS) {
-        throw std::runtime_error("failed to create cubemap texture image view!");
-    }
-
-    return resultImageView;
+    return this->HasAtlasTile() ? this->atlas->GetFramebuffer(faceIdx) : VK_NULL_HANDLE;
 }
 
-std::array<VkImageView, 6> OmniShadowResources::CreateCubemapFacesImageView(VkDevice device, VkImage image, VkFormat format, VkImageAspectFlags aspectFlags, uint32_t mipLevels)
+VkFramebuffer OmniShadowResources::GetLayeredFramebuffer() const
 {
-    VkImageViewCreateInfo viewInfo{};
-    viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
-    viewInfo.image = image;
-    viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
-    viewInfo.format = format;
-    viewInfo.components = {
-        VK_COMPONENT_SWIZZLE_IDENTITY,
-        VK_COMPONENT_SWIZZLE_IDENTITY,
-        VK_COMPONENT_SWIZZLE_IDENTITY,
-        VK_COMPONENT_SWIZZLE_IDENTITY
-    };
-
-    viewInfo.subresourceRange.aspectMask = aspectFlags;
-    viewInfo.subresourceRange.baseMipLevel = 0;
-    viewInfo.subresourceRange.levelCount = mipLevels;
-    viewInfo.subresourceRange.baseArrayLayer = 0;
-    viewInfo.subresourceRange.layerCount = 1;
-
-    std::array<VkImageView, 6> shadowCubeMapFaceImageViews{};
-
-    for (uint32_t i = 0; i < 6; i++)
-    {
-        viewInfo.subresourceRange.baseArrayLayer = i;
-
-        if (vkCreateImageView(device, &viewInfo, nullptr, &shadowCubeMapFaceImageViews[i]) != VK_SUCCESS)
-        {
-            std::string error = std::string("failed to create cubemap texture[%u] image view!", i);
-            throw std::runtime_error(error);
-        }
-    }
-
-    return shadowCubeMapFaceImageViews;
+    return this->HasAtlasTile() ? this->atlas->GetLayeredFramebuffer() : VK_NULL_HANDLE;
 }
 
-VkSampler OmniShadowResources::CreateCubemapSampler(VkDevice device)
+void OmniShadowResources::UpdateUBOShadowMap(OmniShadowUniform omniParameters)
 {
-    VkSampler resultSampler;
-
-    VkSamplerCreateInfo samplerInfo{};
-    samplerInfo.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
-    samplerInfo.magFilter = VK_FILTER_LINEAR;
-    samplerInfo.minFilter = VK_FILTER_LINEAR;
-    samplerInfo.mipmapMode = VK_SAMPLER_MIPMAP_MODE_LINEAR;
-    samplerInfo.addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
-    samplerInfo.addressModeV = samplerInfo.addressModeU;
-    samplerInfo.addressModeW = samplerInfo.addressModeU;
-    samplerInfo.compareOp = VK_COMPARE_OP_NEVER;
-    samplerInfo.mipLodBias = 0.0f;
-    samplerInfo.maxAnisotropy = 1.0f;
-    samplerInfo.minLod = 0.0f;
-    samplerInfo.maxLod = 1.0f;
-    samplerInfo.borderColor = VK_BORDER_COLOR_FLOAT_OPAQUE_WHITE;
-
-    if (vkCreateSampler(device, &samplerInfo, nullptr, &resultSampler))
-    {
-        throw std::runtime_error("failed to create omni shadow texture sampler!");
-    }
-
-    return resultSampler;
+    const uint32_t currentFrame = static_cast<uint32_t>(SynchronizationModule::GetCurrentFrame());
+    void* data;
+    vkMapMemory(this->deviceModule->device, this->shadowMapUBO->uniformBuffersMemory[currentFrame], 0, sizeof(OmniShadowUniform), 0, &data);
+    memcpy(data, &omniParameters, sizeof(OmniShadowUniform));
+    vkUnmapMemory(this->deviceModule->device, this->shadowMapUBO->uniformBuffersMemory[currentFrame]);
 }
 
-VkFormat OmniShadowResources::GetSupportedColorFormat(DeviceModule* deviceModule)
+glm::mat4 OmniShadowResources::GetCubeFaceViewMatrix(uint32_t faceIdx)
 {
-    auto format = deviceModule->findSupportedFormat(
-        {
-            VK_FORMAT_R32_SFLOAT,
-            VK_FORMAT_R16_SFLOAT
-        },
-        VK_IMAGE_TILING_OPTIMAL,
-        VK_FORMAT_FEATURE_COLOR_ATTACHMENT_BIT | VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT);
-
-    if (format == VK_FORMAT_UNDEFINED)
+    glm::mat4 viewMatrix = glm::mat4(1.0f);
+    switch (faceIdx)
     {
-        throw std::runtime_error("failed to find a supported color format for omni shadows!");
+    case 0: // POSITIVE_X
+        viewMatrix = glm::rotate(viewMatrix, glm::radians(90.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+        viewMatrix = glm::rotate(viewMatrix, glm::radians(180.0f), glm::vec3(1.0f, 0.0f, 0.0f));
+        break;
+    case 1:	// NEGATIVE_X
+        viewMatrix = glm::rotate(viewMatrix, glm::radians(-90.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+        viewMatrix = glm::rotate(viewMatrix, glm::radians(180.0f), glm::vec3(1.0f, 0.0f, 0.0f));
+        break;
+    case 2:	// POSITIVE_Y
+        viewMatrix = glm::rotate(viewMatrix, glm::radians(-90.0f), glm::vec3(1.0f, 0.0f, 0.0f));
+        break;
+    case 3:	// NEGATIVE_Y
+        viewMatrix = glm::rotate(viewMatrix, glm::radians(90.0f), glm::vec3(1.0f, 0.0f, 0.0f));
+        break;
+    case 4:	// POSITIVE_Z
+        viewMatrix = glm::rotate(viewMatrix, glm::radians(180.0f), glm::vec3(1.0f, 0.0f, 0.0f));
+        break;
+    case 5:	// NEGATIVE_Z
+        viewMatrix = glm::rotate(viewMatrix, glm::radians(180.0f), glm::vec3(0.0f, 0.0f, 1.0f));
+        break;
     }
 
-    return format;
+    return viewMatrix;
 }
 
-VkFormat OmniShadowResources::GetSupportedDepthFormat(DeviceModule* deviceModule)
+void OmniShadowResources::StoreStaticLayer(VkCommandBuffer commandBuffer, uint32_t faceIdx)
 {
-    auto format = deviceModule->findSupportedFormat(
-        {
-            VK_FORMAT_D32_SFLOAT,
-            VK_FORMAT_D24_UNORM_S8_UINT,
-            VK_FORMAT_D32_SFLOAT_S8_UINT,
-            VK_FORMAT_D16_UNORM
-        },
-        VK_IMAGE_TILING_OPTIMAL,
-        VK_FORMAT_FEATURE_DEPTH_STENCIL_ATTACHMENT_BIT);
+    if (!this->HasAtlasTile())
+        return;
 
-    if (format == VK_FORMAT_UNDEFINED)
+    if (this->staticLayerCache == nullptr)
     {
-        throw std::runtime_error("failed to find a supported depth format for omni shadows!");
+        this->staticLayerCache = std::make_shared<ShadowStaticLayerCache>(this->atlas->GetFormat(), this->atlas->GetAspectMask(), this->atlasTile.Size, 6);
     }
 
-    return format;
+    const VkRect2D region = this->GetAtlasRegion();
+    this->staticLayerCache->Store(commandBuffer, this->atlas->GetImage(), VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL, faceIdx, faceIdx, region.offset);
 }
 
-bool OmniShadowResources::HasStencilComponent(VkFormat format)
+void OmniShadowResources::RestoreStaticLayer(VkCommandBuffer commandBuffer, uint32_t faceIdx)
 {
-    return format == VK_FORMAT_D32_SFLOAT_S8_UINT || format == VK_FORMAT_D24_UNORM_S8_UINT;
+    if (this->staticLayerCache == nullptr || !this->HasAtlasTile())
+        return;
+
+    const VkRect2D region = this->GetAtlasRegion();
+    this->staticLayerCache->Restore(commandBuffer, this->atlas->GetImage(), VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL, faceIdx, faceIdx, region.offset);
 }
 
-void OmniShadowResources::TransitionMultiImagesLayout(VkDevice device, VkImage& newImage, VkImageLayout oldLayout, VkImageLayout newLayout, VkImageSubresourceRange subresourceRange)
+VkDeviceSize OmniShadowResources::GetStaticLayerCacheSize() const
 {
-    VkCommandBuffer commandBuffer = beginSingleTimeCommands(device, commandPool);
-    VkImageMemoryBarrier barrier{};
-    barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-    barrier.oldLayout = oldLayout;
-    barrier.newLayout = newLayout;
-    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-    barrier.image = newImage;
-    barrier.subresourceRange = subresourceRange;
-    barrier.srcAccessMask = 0; // TODO
-    barrier.dstAccessMask = 0; // TODO
-
-    VkPipelineStageFlags sourceStage;
-    VkPipelineStageFlags destinationStage;
-
-    if (oldLayout == VK_IMAGE_LAYOUT_UNDEFINED && newLayout == VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL) {
-        barrier.srcAccessMask = 0;
-        barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-
-        sourceStage = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
-        destinationStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
-    }
-    else if (oldLayout == VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL && newLayout == VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL) {
-        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-        barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
-
-        sourceStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
-        destinationStage = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
-    }
-    else if (oldLayout == VK_IMAGE_LAYOUT_UNDEFINED && newLayout == VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL) {
-        barrier.srcAccessMask = 0;
-        barrier.dstAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
-
-        sourceStage = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
-        destinationStage = VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT;
-    }
-    else if (oldLayout == VK_IMAGE_LAYOUT_UNDEFINED && newLayout == VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL)
-    {
-        barrier.srcAccessMask = 0;
-        barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
-
-        sourceStage = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
-        destinationStage = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
-    }
-    else {
-        throw std::invalid_argument("unsupported layout transition!");
-    }
-
-    vkCmdPipelineBarrier(
-        commandBuffer,
-        sourceStage, destinationStage,
-        0,
-        0, nullptr,
-        0, nullptr,
-        1, &barrier
-    );
-
-    endSingleTimeCommands(device, queueModule->graphicsQueue, commandPool, commandBuffer);
+    return this->staticLayerCache ? this->staticLayerCache->GetAllocationSize() : 0;
 }
 
-void OmniShadowResources::CreateOmniShadowMapResources(std::shared_ptr<VkRenderPass> renderPass)
+void OmniShadowResources::ReleaseStaticLayerCache()
 {
-    //Cubemap images
-    this->cubemapImage = this->AllocateCubemapImage(
-        deviceModule->device,
-        deviceModule->physicalDevice,
-        this->cubemapMemory,
-        this->TextureSize,
-        this->shadowFormat,
-        VK_IMAGE_TILING_OPTIMAL,
-        VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
-        1);
-
-    VkImageSubresourceRange subresourceRange = {};
-    subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-    subresourceRange.baseMipLevel = 0;
-    subresourceRange.levelCount = 1;
-    subresourceRange.layerCount = 6;
-    this->TransitionMultiImagesLayout(this->deviceModule->device, this->cubemapImage, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, subresourceRange);
-
-    this->CubemapSampler = this->CreateCubemapSampler(this->deviceModule->device);
-    this->CubemapImageView = this->CreateCubemapImageView(this->deviceModule->device, this->cubemapImage, this->shadowFormat, VK_IMAGE_ASPECT_COLOR_BIT);
-    this->cubemapFacesImageViews = this->CreateCubemapFacesImageView(this->deviceModule->device, this->cubemapImage, this->shadowFormat, VK_IMAGE_ASPECT_COLOR_BIT);
+    if (this->staticLayerCache == nullptr)
+        return;
 
-    //FRAMEBUFFER OFFSCREEN
-    //Depth images
-    this->framebufferDepthImage = this->CreateFramebufferDepthImage(this->framebufferDepthImageMemory);
-
-    VkImageSubresourceRange subresourceRangeDepth = {};
-    subresourceRangeDepth.aspectMask = VK_IMAGE_ASPECT_DEPTH_BIT;
-    if (HasStencilComponent(this->framebufferDepthFormat))
-    {
-        subresourceRangeDepth.aspectMask |= VK_IMAGE_ASPECT_STENCIL_BIT;
-    }
-    subresourceRangeDepth.baseMipLevel = 0;
-    subresourceRangeDepth.levelCount = 1;
-    subresourceRangeDepth.baseArrayLayer = 0;
-    subresourceRangeDepth.layerCount = 1;
-    this->TransitionMultiImagesLayout(this->deviceModule->device, this->framebufferDepthImage, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL, subresourceRangeDepth);
-
-    this->framebufferDepthImageView = this->CreateImageView(
-        this->deviceModule->device,
-        this->framebufferDepthImage,
-        this->framebufferDepthFormat,
-        subresourceRangeDepth.aspectMask);
-
-    //Framebuffers
-    this->PrepareFramebuffers(renderPass, this->framebufferDepthImageView, this->cubemapFacesImageViews);
+    // La imagen se libera cuando terminen los frames en vuelo que aun copian desde ella
+    this->staticLayerCache->Cleanup();
+    this->staticLayerCache = nullptr;
 }
 
-void OmniShadowResources::PrepareFramebuffers(std::shared_ptr<VkRenderPass> renderPass, VkImageView depthView, std::array<VkImageView, 6> cubemapView)
+void OmniShadowResources::Cleanup()
 {
-    VkImageView attachments[2];
-    attachments[1] = depthView;
-
-    VkFramebufferCreateInfo fbufCreateInfo = {};
-    fbufCreateInfo.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
-    fbufCreateInfo.renderPass = *renderPass;
-    fbufCreateInfo.attachmentCount = 2;
-    fbufCreateInfo.pAttachments = attachments;
-    fbufCreateInfo.width = this->TextureSize;
-    fbufCreateInfo.height = this->TextureSize;
-    fbufCreateInfo.layers = 1;
-
-    for (uint32_t i = 0; i < 6; i++)
+    if (this->staticLayerCache != nullptr)
     {
-        attachments[0] = cubemapView[i];
-        vkCreateFramebuffer(this->deviceModule->device, &fbufCreateInfo, nullptr, &this->CubemapFacesFrameBuffers[i]);
+        this->staticLayerCache->Cleanup();
+        this->staticLayerCache = nullptr;
     }
-}
 
-void OmniShadowResources::UpdateUBOShadowMap(OmniShadowUniform omniParameters)
-{
-    const uint32_t currentFrame = static_cast<uint32_t>(SynchronizationModule::GetCurrentFrame());
-    void* data;
-    vkMapMemory(this->deviceModule->device, this->shadowMapUBO->uniformBuffersMemory[currentFrame], 0, sizeof(OmniShadowUniform), 0, &data);
-    memcpy(data, &omniParameters, sizeof(OmniShadowUniform));
-    vkUnmapMemory(this->deviceModule->device, this->shadowMapUBO->uniformBuffersMemory[currentFrame]);
-}
+    this->ClearAtlasTile();
 
-void OmniShadowResources::Cleanup()
-{
     for (int i = 0; i < MAX_FRAMES_IN_FLIGHT; i++)
     {
         if (this->shadowMapUBO != nullptr)
@@ -417,40 +156,4 @@ void OmniShadowResources::Cleanup()
             QE_FREE_MEMORY(deviceModule->device, this->shadowMapUBO->uniformBuffersMemory[i], "OmniShadowResources::Cleanup");
         }
     }
-
-    if (this->CubemapSampler != VK_NULL_HANDLE)
-    {
-        vkDestroySampler(this->deviceModule->device, this->CubemapSampler, nullptr);
-    }
-    if (this->CubemapImageView != VK_NULL_HANDLE)
-    {
-        vkDestroyImageView(deviceModule->device, CubemapImageView, nullptr);
-    }
-    if (this->cubemapImage != VK_NULL_HANDLE)
-    {
-        vkDestroyImage(deviceModule->device, this->cubemapImage, nullptr);
-    }
-    if (this->cubemapMemory != VK_NULL_HANDLE)
-    {
-        QE_FREE_MEMORY(deviceModule->device, cubemapMemory, "OmniShadowResources::Cleanup");
-    }
-
-    if (this->framebufferDepthImageView != VK_NULL_HANDLE)
-    {
-        vkDestroyImageView(deviceModule->device, framebufferDepthImageView, nullptr);
-    }
-    if (this->framebufferDepthImage != VK_NULL_HANDLE)
-    {
-        vkDestroyImage(deviceModule->device, this->framebufferDepthImage, nullptr);
-    }
-    if (this->framebufferDepthImageMemory != VK_NULL_HANDLE)
-    {
-        QE_FREE_MEMORY(deviceModule->device, framebufferDepthImageMemory, "OmniShadowResources::Cleanup");
-    }
-
-    for (uint32_t i = 0; i < 6; i++)
-    {
-        vkDestroyImageView(deviceModule->device, this->cubemapFacesImageViews[i], nullptr);
-        vkDestroyFramebuffer(this->deviceModule->device, this->CubemapFacesFrameBuffers[i], nullptr);
-    }
 }
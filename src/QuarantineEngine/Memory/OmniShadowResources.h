@@ -6,6 +6,9 @@
 #include <vulkan/vulkan.hpp>
 #include <DeviceModule.h>
 #include <SwapChainModule.h>
+#include <ShadowStaticLayerCache.h>
+#include <ShadowAtlasResources.h>
+#include <ShadowAtlasAllocator.h>
 
 
 class OmniShadowResources
@@ -13,57 +16,43 @@ class OmniShadowResources
 private:
     DeviceModule* deviceModule;
     SwapChainModule* swapchainModule = nullptr;
-    VkFormat framebufferDepthFormat = VK_FORMAT_UNDEFINED;
 
-    // Shadow Render Image
-    VkImage cubemapImage = VK_NULL_HANDLE;
-    VkDeviceMemory cubemapMemory = { VK_NULL_HANDLE };
+    // Tile asignado en el atlas de point lights: la misma region en las seis capas (una por cara)
+    std::shared_ptr<ShadowAtlasResources> atlas = nullptr;
+    ShadowAtlasTile atlasTile{};
 
-    // Offscreen shadow image
-    VkImage framebufferDepthImage = VK_NULL_HANDLE;
-    VkImageView framebufferDepthImageView = VK_NULL_HANDLE;
-    VkDeviceMemory framebufferDepthImageMemory = { VK_NULL_HANDLE };
+    // Capa estatica por cara
+    std::shared_ptr<ShadowStaticLayerCache> staticLayerCache = nullptr;
 
-    std::array<VkImageView, 6> cubemapFacesImageViews = { VK_NULL_HANDLE };
+    void ReleaseStaticLayerCache();
 
 public:
-    static QueueModule* queueModule;
-    static VkCommandPool commandPool;
-    static uint32_t TextureSize;
-    VkFormat shadowFormat;
-
     float DepthBiasConstant = 0.10f;
     float DepthBiasSlope = 0.50f;
 
 public:
     std::shared_ptr<UniformBufferObject> shadowMapUBO = nullptr;
-    std::array<VkFramebuffer, 6> CubemapFacesFrameBuffers = { VK_NULL_HANDLE };
-    VkImageView CubemapImageView = VK_NULL_HANDLE;
-    VkSampler CubemapSampler = VK_NULL_HANDLE;
-
-private:
-    std::array<VkImageView, 6> CreateCubemapFacesImageView(VkDevice device, VkImage image, VkFormat format, VkImageAspectFlags aspectFlags, uint32_t mipLevels = 1);
-
-    VkImage CreateFramebufferDepthImage(VkDeviceMemory& deviceMemory);
-    VkImageView CreateImageView(VkDevice device, VkImage image, VkFormat format, VkImageAspectFlags aspectFlags, uint32_t mipLevels = 1);
-
-    void CreateOmniShadowMapResources(std::shared_ptr<VkRenderPass> renderPass);
-    void PrepareFramebuffers(std::shared_ptr<VkRenderPass> renderPass, VkImageView depthView, std::array<VkImageView, 6> cubemapView);
-
 
 public:
     OmniShadowResources();
-    OmniShadowResources(std::shared_ptr<VkRenderPass> renderPass);
     void UpdateUBOShadowMap(OmniShadowUniform omniParameters);
 
-    static VkFormat GetSupportedColorFormat(DeviceModule* deviceModule);
-    static VkFormat GetSupportedDepthFormat(DeviceModule* deviceModule);
-    static bool HasStencilComponent(VkFormat format);
-    static VkSampler CreateCubemapSampler(VkDevice device);
-    static VkImageView CreateCubemapImageView(VkDevice device, VkImage& image, VkFormat format, VkImageAspectFlags aspectFlags, uint32_t mipLevels = 1);
-    static VkImage AllocateCubemapImage(VkDevice device, VkPhysicalDevice physicalDevice, VkDeviceMemory& mapMemory, uint32_t pixelSize,
-        VkFormat format, VkImageTiling tiling, VkImageUsageFlags usage, VkMemoryPropertyFlags properties, VkSampleCountFlagBits numSamples = VK_SAMPLE_COUNT_1_BIT);
-    static void TransitionMultiImagesLayout(VkDevice device, VkImage& newImage, VkImageLayout oldLayout, VkImageLayout newLayout, VkImageSubresourceRange subresourceRange);
+    void SetAtlasTile(std::shared_ptr<ShadowAtlasResources> atlasResources, const ShadowAtlasTile& tile);
+    void ClearAtlasTile();
+    bool HasAtlasTile() const { return this->atlas != nullptr && this->atlasTile.Valid(); }
+    const ShadowAtlasTile& GetAtlasTile() const { return this->atlasTile; }
+    VkRect2D GetAtlasRegion() const;
+    /// xy = offset UV del tile, zw = escala UV. Cero si la luz no tiene tile.
+    glm::vec4 GetAtlasRect() const;
+    VkFramebuffer GetFramebuffer(uint32_t faceIdx) const;
+    /// Framebuffer de 6 capas para el pase unico con gl_Layer.
+    VkFramebuffer GetLayeredFramebuffer() const;
+
+    void StoreStaticLayer(VkCommandBuffer commandBuffer, uint32_t faceIdx);
+    void RestoreStaticLayer(VkCommandBuffer commandBuffer, uint32_t faceIdx);
+    VkDeviceSize GetStaticLayerCacheSize() const;
+
+    static glm::mat4 GetCubeFaceViewMatrix(uint32_t faceIdx);
 
     void Cleanup();
 };
@@ -1,9 +1,10 @@
 #include "PointShadowDescriptorsManager.h"
 #include "SynchronizationModule.h"
-#include <OmniShadowResources.h>
+#include <ImageMemoryTools.h>
+#include <CSMResources.h>
 #include <Helpers/QEMemoryTrack.h>
 #include <stdexcept>
-#include <QueueModule.h>
+#include <ShadowAtlasManager.h>
 
 PointShadowDescriptorsManager::PointShadowDescriptorsManager()
 {
@@ -11,14 +12,14 @@ PointShadowDescriptorsManager::PointShadowDescriptorsManager()
 
     this->CreateOffscreenDescriptorPool();
     this->CreateRenderDescriptorPool();
+
+    this->pointAtlasRectBufferSize = sizeof(glm::vec4) * MAX_NUM_POINT_LIGHTS;
+    this->pointAtlasRectBuffer.CreateSSBO(this->pointAtlasRectBufferSize, MAX_FRAMES_IN_FLIGHT, *deviceModule);
 }
 
-void PointShadowDescriptorsManager::AddPointLightResources(
-    std::shared_ptr<UniformBufferObject> shadowMapUBO,
-    VkImageView imageView,
-    VkSampler sampler)
+void PointShadowDescriptorsManager::AddPointLightResources(std::shared_ptr<UniformBufferObject> shadowMapUBO)
 {
-    if (!shadowMapUBO || imageView == VK_NULL_HANDLE || sampler == VK_NULL_HANDLE)
+    if (!shadowMapUBO)
         return;
 
     if (this->_numPointLights >= MAX_NUM_POINT_LIGHTS)
@@ -27,21 +28,12 @@ void PointShadowDescriptorsManager::AddPointLightResources(
     const uint32_t newLightIndex = this->_numPointLights;
 
     this->shadowMapUBOs.push_back(shadowMapUBO);
-    this->_imageViews.push_back(imageView);
-    this->_samplers.push_back(sampler);
     this->_numPointLights++;
 
     if (this->offscreenDescriptorSetLayout == VK_NULL_HANDLE)
         return;
 
-    WaitForGpuIdle();
-
     this->AllocateOffscreenDescriptorSetForLight(newLightIndex);
-
-    if (this->renderDescriptorSets[0] != VK_NULL_HANDLE)
-    {
-        this->UpdateRenderDescriptorSets();
-    }
 }
 
 void PointShadowDescriptorsManager::DeletePointLightResources(int idPos)
@@ -49,11 +41,13 @@ void PointShadowDescriptorsManager::DeletePointLightResources(int idPos)
     if (idPos < 0 || static_cast<uint32_t>(idPos) >= this->_numPointLights)
         return;
 
-    WaitForGpuIdle();
-
     this->shadowMapUBOs.erase(this->shadowMapUBOs.begin() + idPos);
-    this->_imageViews.erase(this->_imageViews.begin() + idPos);
-    this->_samplers.erase(this->_samplers.begin() + idPos);
+
+    if (idPos < static_cast<int>(this->shadowResources.size()))
+    {
+        this->shadowResources.erase(this->shadowResources.begin() + idPos);
+    }
+
     this->_numPointLights--;
 
     for (size_t frame = 0; frame < NUM_POINT_SHADOW_SETS; ++frame)
@@ -65,16 +59,45 @@ void PointShadowDescriptorsManager::DeletePointLightResources(int idPos)
 
         offscreenDescriptorSets[frame][MAX_NUM_POINT_LIGHTS - 1] = VK_NULL_HANDLE;
     }
+}
 
-    if (this->renderDescriptorSets[0] != VK_NULL_HANDLE)
+void PointShadowDescriptorsManager::BindResources(const std::shared_ptr<OmniShadowResources>& resources)
+{
+    this->shadowResources.push_back(resources);
+}
+
+void PointShadowDescriptorsManager::UpdateResources(int currentFrame)
+{
+    this->pointAtlasRectResources.clear();
+
+    // Rect a cero = la luz no tiene tile este frame y el shader la trata como sin sombra
+    for (int i = 0; i < MAX_NUM_POINT_LIGHTS; i++)
     {
-        this->UpdateRenderDescriptorSets();
+        if (i < static_cast<int>(this->shadowResources.size()) && this->shadowResources[i])
+        {
+            this->pointAtlasRectResources.push_back(this->shadowResources[i]->GetAtlasRect());
+        }
+        else
+        {
+            this->pointAtlasRectResources.push_back(glm::vec4(0.0f));
+        }
     }
+
+    void* dataRects = nullptr;
+    vkMapMemory(
+        this->deviceModule->device,
+        this->pointAtlasRectBuffer.uniformBuffersMemory[currentFrame],
+        0,
+        this->pointAtlasRectBufferSize,
+        0,
+        &dataRects);
+    memcpy(dataRects, this->pointAtlasRectResources.data(), this->pointAtlasRectBufferSize);
+    vkUnmapMemory(this->deviceModule->device, this->pointAtlasRectBuffer.uniformBuffersMemory[currentFrame]);
 }
 
 void PointShadowDescriptorsManager::InitializeDescriptorSetLayouts(std::shared_ptr<ShaderModule> offscreen_shader_ptr)
 {
-    this->CreateCubemapPlaceHolder();
+    this->CreateShadowPlaceholder();
 
     this->offscreenDescriptorSetLayout = offscreen_shader_ptr->descriptorSetLayouts.at(0);
     this->renderDescriptorSetLayout = this->CreateRenderDescriptorSetLayout();
@@ -103,14 +126,18 @@ void PointShadowDescriptorsManager::CreateOffscreenDescriptorPool()
 
 void PointShadowDescriptorsManager::CreateRenderDescriptorPool()
 {
-    VkDescriptorPoolSize renderPoolSize{};
-    renderPoolSize.type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-    renderPoolSize.descriptorCount = static_cast<uint32_t>(MAX_FRAMES_IN_FLIGHT) * MAX_NUM_POINT_LIGHTS;
+    std::array<VkDescriptorPoolSize, 2> poolSizes{};
+
+    poolSizes[0].type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    poolSizes[0].descriptorCount = static_cast<uint32_t>(MAX_FRAMES_IN_FLIGHT);
+
+    poolSizes[1].type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    poolSizes[1].descriptorCount = static_cast<uint32_t>(MAX_FRAMES_IN_FLIGHT);
 
     VkDescriptorPoolCreateInfo poolInfo{};
     poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
-    poolInfo.poolSizeCount = 1;
-    poolInfo.pPoolSizes = &renderPoolSize;
+    poolInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
+    poolInfo.pPoolSizes = poolSizes.data();
     poolInfo.maxSets = static_cast<uint32_t>(MAX_FRAMES_IN_FLIGHT);
 
     if (vkCreateDescriptorPool(this->deviceModule->device, &poolInfo, nullptr, &this->renderDescriptorPool) != VK_SUCCESS)
@@ -128,39 +155,65 @@ VkDescriptorBufferInfo PointShadowDescriptorsManager::GetBufferInfo(VkBuffer buf
     return bufferInfo;
 }
 
-void PointShadowDescriptorsManager::CreateCubemapPlaceHolder()
+void PointShadowDescriptorsManager::CreateShadowPlaceholder()
 {
-    const VkFormat shadowColorFormat = OmniShadowResources::GetSupportedColorFormat(deviceModule);
+    const VkFormat shadowFormat = CSMResources::GetSupportedShadowFormat(deviceModule);
+
+    VkImageCreateInfo imageInfo{};
+    imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+    imageInfo.imageType = VK_IMAGE_TYPE_2D;
+    imageInfo.extent = { 1, 1, 1 };
+    imageInfo.mipLevels = 1;
+    imageInfo.arrayLayers = 1;
+    imageInfo.format = shadowFormat;
+    imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+    imageInfo.usage = VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+    imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+    imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+    if (vkCreateImage(deviceModule->device, &imageInfo, nullptr, &this->placeholderImage) != VK_SUCCESS)
+    {
+        throw std::runtime_error("failed to create point placeholder image!");
+    }
 
-    this->placeholderImage = OmniShadowResources::AllocateCubemapImage(
-        deviceModule->device,
-        deviceModule->physicalDevice,
-        this->placeholderMemory,
-        1,
-        shadowColorFormat,
-        VK_IMAGE_TILING_OPTIMAL,
-        VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
-        1);
+    VkMemoryRequirements memRequirements{};
+    vkGetImageMemoryRequirements(deviceModule->device, this->placeholderImage, &memRequirements);
 
-    VkImageSubresourceRange subresourceRange{};
-    subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-    subresourceRange.baseMipLevel = 0;
-    subresourceRange.levelCount = 1;
-    subresourceRange.layerCount = 6;
+    VkMemoryAllocateInfo allocInfo{};
+    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    allocInfo.allocationSize = memRequirements.size;
+    allocInfo.memoryTypeIndex = IMT::findMemoryType(
+        memRequirements.memoryTypeBits,
+        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+        deviceModule->physicalDevice);
 
-    OmniShadowResources::TransitionMultiImagesLayout(
-        this->deviceModule->device,
+    if (vkAllocateMemory(deviceModule->device, &allocInfo, nullptr, &this->placeholderMemory) != VK_SUCCESS)
+    {
+        throw std::runtime_error("failed to allocate point placeholder image memory!");
+    }
+    QE_TRACK_MEMORY_ALLOCATION(this->placeholderMemory, "PointShadowDescriptorsManager::CreateShadowPlaceholder");
+
+    vkBindImageMemory(deviceModule->device, this->placeholderImage, this->placeholderMemory, 0);
+
+    CSMResources::TransitionImageLayout(
+        deviceModule->device,
         this->placeholderImage,
+        shadowFormat,
         VK_IMAGE_LAYOUT_UNDEFINED,
-        VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
-        subresourceRange);
+        VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL,
+        1);
 
-    this->placeholderSampler = OmniShadowResources::CreateCubemapSampler(this->deviceModule->device);
-    this->placeholderImageView = OmniShadowResources::CreateCubemapImageView(
-        this->deviceModule->device,
+    // sampler2DArray en el shader: vista 2D_ARRAY de una capa
+    this->placeholderImageView = CSMResources::CreateImageView(
+        deviceModule->device,
         this->placeholderImage,
-        shadowColorFormat,
-        VK_IMAGE_ASPECT_COLOR_BIT);
+        shadowFormat,
+        VK_IMAGE_ASPECT_DEPTH_BIT,
+        0,
+        1);
+
+    this->placeholderSampler = CSMResources::CreateCSMSampler(this->deviceModule->device);
 }
 
 void PointShadowDescriptorsManager::SetOffscreenDescriptorWrite(
@@ -184,39 +237,49 @@ void PointShadowDescriptorsManager::SetOffscreenDescriptorWrite(
     descriptorWrite.pTexelBufferView = nullptr;
 }
 
-void PointShadowDescriptorsManager::SetCubeMapDescriptorWrite(
+void PointShadowDescriptorsManager::SetAtlasDescriptorWrite(
     VkWriteDescriptorSet& descriptorWrite,
     VkDescriptorSet descriptorSet,
     VkDescriptorType descriptorType,
     uint32_t binding)
 {
-    for (uint32_t i = 0; i < MAX_NUM_POINT_LIGHTS; ++i)
-    {
-        this->renderDescriptorImageInfo[i].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+    const auto& atlas = ShadowAtlasManager::getInstance()->GetPointAtlas();
 
-        if (i < _numPointLights)
-        {
-            this->renderDescriptorImageInfo[i].imageView = _imageViews[i];
-            this->renderDescriptorImageInfo[i].sampler = _samplers[i];
-        }
-        else
-        {
-            this->renderDescriptorImageInfo[i].imageView = placeholderImageView;
-            this->renderDescriptorImageInfo[i].sampler = placeholderSampler;
-        }
-    }
+    this->renderDescriptorImageInfo.imageLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL;
+    this->renderDescriptorImageInfo.imageView = atlas ? atlas->GetImageView() : placeholderImageView;
+    this->renderDescriptorImageInfo.sampler = atlas ? atlas->GetSampler() : placeholderSampler;
 
     descriptorWrite.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
     descriptorWrite.dstSet = descriptorSet;
     descriptorWrite.dstBinding = binding;
     descriptorWrite.dstArrayElement = 0;
     descriptorWrite.descriptorType = descriptorType;
-    descriptorWrite.descriptorCount = MAX_NUM_POINT_LIGHTS;
-    descriptorWrite.pImageInfo = this->renderDescriptorImageInfo.data();
+    descriptorWrite.descriptorCount = 1;
+    descriptorWrite.pImageInfo = &this->renderDescriptorImageInfo;
     descriptorWrite.pBufferInfo = nullptr;
     descriptorWrite.pTexelBufferView = nullptr;
 }
 
+void PointShadowDescriptorsManager::SetRenderDescriptorWrite(
+    VkWriteDescriptorSet& descriptorWrite,
+    VkDescriptorSet descriptorSet,
+    VkDescriptorType descriptorType,
+    uint32_t binding,
+    VkBuffer buffer,
+    VkDeviceSize bufferSize)
+{
+    this->renderBufferInfo = GetBufferInfo(buffer, bufferSize);
+
+    descriptorWrite.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    descriptorWrite.dstSet = descriptorSet;
+    descriptorWrite.dstBinding = binding;
+    descriptorWrite.dstArrayElement = 0;
+    descriptorWrite.descriptorType = descriptorType;
+    descriptorWrite.descriptorCount = 1;
+    descriptorWrite.pImageInfo = nullptr;
+    descriptorWrite.pBufferInfo = &this->renderBufferInfo;
+}
+
 void PointShadowDescriptorsManager::CreateRenderDescriptorSet()
 {
     std::vector<VkDescriptorSetLayout> layouts(MAX_FRAMES_IN_FLIGHT, renderDescriptorSetLayout);
@@ -227,8 +290,6 @@ void PointShadowDescriptorsManager::CreateRenderDescriptorSet()
     allocInfo.descriptorSetCount = static_cast<uint32_t>(MAX_FRAMES_IN_FLIGHT);
     allocInfo.pSetLayouts = layouts.data();
 
-    this->renderDescriptorImageInfo.resize(MAX_NUM_POINT_LIGHTS);
-
     if (vkAllocateDescriptorSets(deviceModule->device, &allocInfo, this->renderDescriptorSets) != VK_SUCCESS)
     {
         throw std::runtime_error("failed to allocate render descriptor sets!");
@@ -241,17 +302,24 @@ VkDescriptorSetLayout PointShadowDescriptorsManager::CreateRenderDescriptorSetLa
 {
     VkDescriptorSetLayout resultLayout = VK_NULL_HANDLE;
 
-    VkDescriptorSetLayoutBinding binding{};
-    binding.binding = 0;
-    binding.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-    binding.descriptorCount = MAX_NUM_POINT_LIGHTS;
-    binding.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
-    binding.pImmutableSamplers = nullptr;
+    std::array<VkDescriptorSetLayoutBinding, 2> layoutBindings{};
+
+    layoutBindings[0].binding = 0;
+    layoutBindings[0].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    layoutBindings[0].descriptorCount = 1;
+    layoutBindings[0].stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
+    layoutBindings[0].pImmutableSamplers = nullptr;
+
+    layoutBindings[1].binding = 1;
+    layoutBindings[1].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    layoutBindings[1].descriptorCount = 1;
+    layoutBindings[1].stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
+    layoutBindings[1].pImmutableSamplers = nullptr;
 
     VkDescriptorSetLayoutCreateInfo layoutInfo{};
     layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
-    layoutInfo.bindingCount = 1;
-    layoutInfo.pBindings = &binding;
+    layoutInfo.bindingCount = static_cast<uint32_t>(layoutBindings.size());
+    layoutInfo.pBindings = layoutBindings.data();
 
     if (vkCreateDescriptorSetLayout(deviceModule->device, &layoutInfo, nullptr, &resultLayout) != VK_SUCCESS)
     {
@@ -310,37 +378,49 @@ void PointShadowDescriptorsManager::UpdateRenderDescriptorSets()
         if (this->renderDescriptorSets[frame] == VK_NULL_HANDLE)
             continue;
 
-        VkWriteDescriptorSet write{};
-        this->SetCubeMapDescriptorWrite(
-            write,
+        std::array<VkWriteDescriptorSet, 2> descriptorWrites{};
+
+        this->SetAtlasDescriptorWrite(
+            descriptorWrites[0],
             this->renderDescriptorSets[frame],
             VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
             0);
 
-        vkUpdateDescriptorSets(deviceModule->device, 1, &write, 0, nullptr);
+        this->SetRenderDescriptorWrite(
+            descriptorWrites[1],
+            this->renderDescriptorSets[frame],
+            VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+            1,
+            this->pointAtlasRectBuffer.uniformBuffers[frame],
+            this->pointAtlasRectBufferSize);
+
+        vkUpdateDescriptorSets(deviceModule->device, static_cast<uint32_t>(descriptorWrites.size()), descriptorWrites.data(), 0, nullptr);
     }
 }
 
 void PointShadowDescriptorsManager::ResetSceneState()
 {
-    WaitForGpuIdle();
-
+    // Los frames en vuelo aun pueden usar los sets actuales: los pools se retiran por la cola
+    // de destruccion diferida y la escena nueva reserva sus sets en pools vacios
     if (this->offscreenDescriptorPool != VK_NULL_HANDLE)
     {
-        vkResetDescriptorPool(deviceModule->device, this->offscreenDescriptorPool, 0);
+        QE_DEFER_DESTROY(deviceModule->device, this->offscreenDescriptorPool, vkDestroyDescriptorPool, "PointShadowDescriptorsManager::ResetSceneState");
+        this->CreateOffscreenDescriptorPool();
     }
 
     if (this->renderDescriptorPool != VK_NULL_HANDLE)
     {
-        vkResetDescriptorPool(deviceModule->device, this->renderDescriptorPool, 0);
+        QE_DEFER_DESTROY(deviceModule->device, this->renderDescriptorPool, vkDestroyDescriptorPool, "PointShadowDescriptorsManager::ResetSceneState");
+        this->CreateRenderDescriptorPool();
     }
 
     _numPointLights = 0;
 
     shadowMapUBOs.clear();
-    _imageViews.clear();
-    _samplers.clear();
-    renderDescriptorImageInfo.clear();
+    shadowResources.clear();
+    pointAtlasRectResources.clear();
+    renderDescriptorImageInfo = {};
+    renderBufferInfo = {};
     offscreenBufferInfo = {};
 
     for (size_t i = 0; i < NUM_POINT_SHADOW_SETS; i++)
@@ -356,6 +436,21 @@ void PointShadowDescriptorsManager::ResetSceneState()
 
 void PointShadowDescriptorsManager::Clean()
 {
+    for (int i = 0; i < MAX_FRAMES_IN_FLIGHT; i++)
+    {
+        if (this->pointAtlasRectBuffer.uniformBuffers[i] != VK_NULL_HANDLE)
+        {
+            QE_DESTROY_BUFFER(deviceModule->device, this->pointAtlasRectBuffer.uniformBuffers[i], "PointShadowDescriptorsManager::Clean");
+            this->pointAtlasRectBuffer.uniformBuffers[i] = VK_NULL_HANDLE;
+        }
+
+        if (this->pointAtlasRectBuffer.uniformBuffersMemory[i] != VK_NULL_HANDLE)
+        {
+            QE_FREE_MEMORY(deviceModule->device, this->pointAtlasRectBuffer.uniformBuffersMemory[i], "PointShadowDescriptorsManager::Clean");
+            this->pointAtlasRectBuffer.uniformBuffersMemory[i] = VK_NULL_HANDLE;
+        }
+    }
+
     if (this->offscreenDescriptorPool != VK_NULL_HANDLE)
     {
         vkDestroyDescriptorPool(deviceModule->device, this->offscreenDescriptorPool, nullptr);
@@ -400,11 +495,3 @@ void PointShadowDescriptorsManager::Clean()
 
     this->ResetSceneState();
 }
-
-void PointShadowDescriptorsManager::WaitForGpuIdle() const
-{
-    if (!deviceModule)
-        return;
-
-    vkDeviceWaitIdle(deviceModule->device);
-}
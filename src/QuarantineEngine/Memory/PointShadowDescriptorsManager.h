@@ -6,8 +6,10 @@
 #include <vulkan/vulkan.h>
 #include <DeviceModule.h>
 #include <ShaderModule.h>
+#include <OmniShadowResources.h>
+#include <SynchronizationModule.h>
 
-constexpr uint32_t NUM_POINT_SHADOW_SETS = 2;
+constexpr uint32_t NUM_POINT_SHADOW_SETS = MAX_FRAMES_IN_FLIGHT;
 constexpr uint32_t NUM_POINT_SHADOW_PASSES = 2;
 constexpr uint32_t MAX_NUM_POINT_LIGHTS = 10;
 
@@ -25,11 +27,15 @@ private:
 
     uint32_t _numPointLights = 0;
     std::vector<std::shared_ptr<UniformBufferObject>> shadowMapUBOs;
+    std::vector<std::shared_ptr<OmniShadowResources>> shadowResources;
 
-    std::vector<VkDescriptorImageInfo> renderDescriptorImageInfo;
+    // Todas las point lights comparten el atlas (una capa por cara) de ShadowAtlasManager
+    VkDescriptorImageInfo renderDescriptorImageInfo{};
+    VkDescriptorBufferInfo renderBufferInfo{};
 
-    std::vector<VkImageView> _imageViews;
-    std::vector<VkSampler> _samplers;
+    UniformBufferObject pointAtlasRectBuffer;
+    VkDeviceSize pointAtlasRectBufferSize = 0;
+    std::vector<glm::vec4> pointAtlasRectResources;
 
     VkDeviceMemory placeholderMemory = VK_NULL_HANDLE;
     VkImage placeholderImage = VK_NULL_HANDLE;
@@ -45,8 +51,10 @@ public:
 public:
     PointShadowDescriptorsManager();
 
-    void AddPointLightResources(std::shared_ptr<UniformBufferObject> shadowMapUBO, VkImageView imageView, VkSampler sampler);
+    void AddPointLightResources(std::shared_ptr<UniformBufferObject> shadowMapUBO);
     void DeletePointLightResources(int idPos);
+    void BindResources(const std::shared_ptr<OmniShadowResources>& resources);
+    void UpdateResources(int currentFrame);
     void InitializeDescriptorSetLayouts(std::shared_ptr<ShaderModule> offscreen_shader_ptr);
     void ResetSceneState();
     void Clean();
@@ -69,17 +77,24 @@ private:
         VkBuffer buffer,
         VkDeviceSize bufferSize);
 
-    void SetCubeMapDescriptorWrite(
+    void SetAtlasDescriptorWrite(
         VkWriteDescriptorSet& descriptorWrite,
         VkDescriptorSet descriptorSet,
         VkDescriptorType descriptorType,
         uint32_t binding);
 
+    void SetRenderDescriptorWrite(
+        VkWriteDescriptorSet& descriptorWrite,
+        VkDescriptorSet descriptorSet,
+        VkDescriptorType descriptorType,
+        uint32_t binding,
+        VkBuffer buffer,
+        VkDeviceSize bufferSize);
+
     VkDescriptorSetLayout CreateRenderDescriptorSetLayout();
     VkDescriptorBufferInfo GetBufferInfo(VkBuffer buffer, VkDeviceSize bufferSize);
-    void CreateCubemapPlaceHolder();
+    void CreateShadowPlaceholder();
 
-    void WaitForGpuIdle() const;
 };
 
 
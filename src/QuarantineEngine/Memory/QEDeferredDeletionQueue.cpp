@@ -0,0 +1,222 @@
+#include "QEDeferredDeletionQueue.h"
+
+#include <algorithm>
+#include <cassert>
+#include <Helpers/QEMemoryTrack.h>
+#include <Logging/QELogMacros.h>
+
+void QEDeferredDeletionQueue::Initialize(VkDevice device, uint32_t framesInFlight)
+{
+    std::lock_guard<std::recursive_mutex> lock(_mutex);
+
+    _device = device;
+    _slots.assign(framesInFlight, FrameSlot{});
+    _slotTasks.assign(framesInFlight, {});
+    _submittedSerial = 0;
+    _completedSerial = 0;
+    _deviceIdle = true;
+}
+
+void QEDeferredDeletionQueue::Shutdown()
+{
+    std::lock_guard<std::recursive_mutex> lock(_mutex);
+
+    this->OnDeviceIdle();
+    _slots.clear();
+    _slotTasks.clear();
+    _pendingHandles.clear();
+    _device = VK_NULL_HANDLE;
+}
+
+void QEDeferredDeletionQueue::OnFrameSubmitted(uint32_t slot, VkSemaphore timeline, uint64_t timelineValue)
+{
+    std::lock_guard<std::recursive_mutex> lock(_mutex);
+
+    if (slot >= _slots.size())
+        return;
+
+    ++_submittedSerial;
+    _deviceIdle = false;
+    _slots[slot].Serial = _submittedSerial;
+    _slots[slot].Timeline = timeline;
+    _slots[slot].TimelineValue = timelineValue;
+    _slots[slot].Completed = false;
+}
+
+void QEDeferredDeletionQueue::OnFrameCompleted(uint32_t slot)
+{
+    std::vector<std::function<void()>> tasks;
+    {
+        std::lock_guard<std::recursive_mutex> lock(_mutex);
+
+        if (slot >= _slots.size())
+            return;
+
+        _slots[slot].Completed = true;
+        _completedSerial = std::max(_completedSerial, _slots[slot].Serial);
+        _deviceIdle = false;
+        tasks.swap(_slotTasks[slot]);
+
+        this->Collect();
+    }
+
+    for (auto& task : tasks)
+    {
+        task();
+    }
+}
+
+void QEDeferredDeletionQueue::OnDeviceIdle()
+{
+    std::vector<std::function<void()>> tasks;
+    {
+        std::lock_guard<std::recursive_mutex> lock(_mutex);
+
+        for (size_t i = 0; i < _slots.size(); ++i)
+        {
+            _slots[i].Completed = true;
+            for (auto& task : _slotTasks[i])
+            {
+                tasks.push_back(std::move(task));
+            }
+            _slotTasks[i].clear();
+        }
+
+        _completedSerial = _submittedSerial;
+        _deviceIdle = true;
+        this->Collect();
+    }
+
+    for (auto& task : tasks)
+    {
+        task();
+    }
+}
+
+void QEDeferredDeletionQueue::Enqueue(uint64_t handle, const char* owner, const char* file, int line, std::function<void()> destroy)
+{
+    std::unique_lock<std::recursive_mutex> lock(_mutex);
+
+    if (ValidationEnabled && handle != 0)
+    {
+        auto it = _pendingHandles.find(handle);
+        if (it != _pendingHandles.end())
+        {
+            QE_LOG_ERROR_CAT_F("DeferredDeletion",
+                "[{}] handle=0x{:X} queued twice at {}:{} | already queued by [{}]",
+                owner, handle, file, line, it->second);
+            assert(false && "Vulkan handle released twice");
+            return;
+        }
+    }
+
+    if (_device == VK_NULL_HANDLE || _deviceIdle)
+    {
+        lock.unlock();
+        destroy();
+        ++_releasedCount;
+        return;
+    }
+
+    if (ValidationEnabled && handle != 0)
+    {
+        _pendingHandles[handle] = owner;
+    }
+
+    // El frame que se esta preparando aun puede grabar el recurso: se espera a su envio
+    _pending.push_back({ _submittedSerial + 1, handle, owner, file, line, std::move(destroy) });
+}
+
+void QEDeferredDeletionQueue::RunWhenSlotIdle(uint32_t slot, std::function<void()> task)
+{
+    {
+        std::lock_guard<std::recursive_mutex> lock(_mutex);
+
+        if (slot < _slots.size() && !_slots[slot].Completed)
+        {
+            _slotTasks[slot].push_back(std::move(task));
+            return;
+        }
+    }
+
+    task();
+}
+
+void QEDeferredDeletionQueue::Collect()
+{
+    while (!_pending.empty() && _pending.front().Serial <= _completedSerial)
+    {
+        PendingDeletion deletion = std::move(_pending.front());
+        _pending.pop_front();
+
+        if (ValidationEnabled)
+        {
+            this->ValidateRelease(deletion);
+            _pendingHandles.erase(deletion.Handle);
+        }
+
+        deletion.Destroy();
+        ++_releasedCount;
+    }
+}
+
+void QEDeferredDeletionQueue::ValidateRelease(const PendingDeletion& deletion) const
+{
+    // Todo slot cuyo ultimo envio es anterior o igual a la etiqueta debe haber terminado
+    for (const FrameSlot& slot : _slots)
+    {
+        if (slot.Completed || slot.Serial > deletion.Serial || slot.Timeline == VK_NULL_HANDLE)
+            continue;
+
+        uint64_t reached = 0;
+        vkGetSemaphoreCounterValue(_device, slot.Timeline, &reached);
+        if (reached < slot.TimelineValue)
+        {
+            QE_LOG_ERROR_CAT_F("DeferredDeletion",
+                "[{}] handle=0x{:X} released while frame {} may still use it (queued at {}:{})",
+                deletion.Owner, deletion.Handle, slot.Serial, deletion.File, deletion.Line);
+            assert(false && "Vulkan handle released while still in use by the GPU");
+        }
+    }
+}
+
+void QEDeferredDeletionQueue::DestroyBuffer(VkDevice device, VkBuffer& buffer, const char* owner, const char* file, int line)
+{
+    if (buffer == VK_NULL_HANDLE)
+    {
+        QE_LOG_WARN_CAT_F("VulkanFree", "[{}] vkDestroyBuffer skipped (already null) at {}:{}",
+            owner, file, line);
+        return;
+    }
+
+    VkBuffer captured = buffer;
+    buffer = VK_NULL_HANDLE;
+    Enqueue(reinterpret_cast<uint64_t>(captured), owner, file, line, [device, captured, owner, file, line]() mutable
+        {
+            QEDestroyBufferTracked(device, captured, owner, file, line);
+        });
+}
+
+void QEDeferredDeletionQueue::FreeMemory(VkDevice device, VkDeviceMemory& memory, const char* owner, const char* file, int line)
+{
+    if (memory == VK_NULL_HANDLE)
+    {
+        QE_LOG_WARN_CAT_F("VulkanFree",
+            "[{}] vkFreeMemory skipped (already null) at {}:{}",
+            owner, file, line);
+        return;
+    }
+
+    VkDeviceMemory captured = memory;
+    memory = VK_NULL_HANDLE;
+    Enqueue(reinterpret_cast<uint64_t>(captured), owner, file, line, [device, captured, owner, file, line]() mutable
+        {
+            QEFreeMemoryTracked(device, captured, owner, file, line);
+        });
+}
+
+size_t QEDeferredDeletionQueue::GetPendingCount() const
+{
+    std::lock_guard<std::recursive_mutex> lock(_mutex);
+    return _pending.size();
+}
@@ -0,0 +1,115 @@
+#pragma once
+#ifndef QE_DEFERRED_DELETION_QUEUE_H
+#define QE_DEFERRED_DELETION_QUEUE_H
+
+#include <vulkan/vulkan.h>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include <QESingleton.h>
+
+/// Destruccion diferida de recursos de GPU. Cada envio de frame recibe un serial; un recurso
+/// liberado se etiqueta con el serial del siguiente envio y se destruye cuando ese frame ya se ha
+/// esperado (la cola grafica completa en orden, asi que los anteriores tambien).
+/// Solo se destruye en el momento sin dispositivo o tras vkDeviceWaitIdle (OnDeviceIdle) mientras
+/// no se haya empezado a grabar otro frame: un frame que se esta grabando no cuenta como en vuelo.
+class QEDeferredDeletionQueue : public QESingleton<QEDeferredDeletionQueue>
+{
+private:
+    friend class QESingleton<QEDeferredDeletionQueue>;
+
+    struct PendingDeletion
+    {
+        uint64_t Serial = 0;
+        uint64_t Handle = 0;
+        const char* Owner = "";
+        const char* File = "";
+        int Line = 0;
+        std::function<void()> Destroy;
+    };
+
+    struct FrameSlot
+    {
+        uint64_t Serial = 0;
+        VkSemaphore Timeline = VK_NULL_HANDLE;
+        uint64_t TimelineValue = 0;
+        bool Completed = true;
+    };
+
+    mutable std::recursive_mutex _mutex;
+    VkDevice _device = VK_NULL_HANDLE;
+    std::vector<FrameSlot> _slots;
+    std::deque<PendingDeletion> _pending;
+    std::vector<std::vector<std::function<void()>>> _slotTasks;
+    std::unordered_map<uint64_t, const char*> _pendingHandles;     // Solo en modo validacion
+    uint64_t _submittedSerial = 0;
+    uint64_t _completedSerial = 0;
+    uint64_t _releasedCount = 0;
+    bool _deviceIdle = true;        // Initialize/OnDeviceIdle; deja de serlo al empezar a grabar un frame
+
+public:
+    /// Comprueba dobles liberaciones y que ningun recurso se destruya con un frame que lo usa aun en vuelo.
+    bool ValidationEnabled = false;
+
+private:
+    void Collect();
+    void ValidateRelease(const PendingDeletion& deletion) const;
+
+public:
+    QEDeferredDeletionQueue() = default;
+
+    void Initialize(VkDevice device, uint32_t framesInFlight);
+    /// Destruye todo lo pendiente. Solo con la GPU parada (fin de la aplicacion).
+    void Shutdown();
+
+    /// Llamar justo despues de vkQueueSubmit del frame de ese slot (timeline grafico y valor que senalara).
+    void OnFrameSubmitted(uint32_t slot, VkSemaphore timeline, uint64_t timelineValue);
+    /// Llamar justo despues de esperar el ultimo frame del slot (antes de grabar el siguiente).
+    /// A partir de aqui el frame se esta grabando y lo que se libere espera a su envio.
+    void OnFrameCompleted(uint32_t slot);
+    /// Tras vkDeviceWaitIdle: todo lo enviado ha terminado.
+    void OnDeviceIdle();
+
+    void Enqueue(uint64_t handle, const char* owner, const char* file, int line, std::function<void()> destroy);
+
+    /// Ejecuta task cuando ningun frame en vuelo usa los recursos del slot (p.ej. reescribir sus descriptor sets).
+    void RunWhenSlotIdle(uint32_t slot, std::function<void()> task);
+
+    template<typename Handle>
+    void DestroyHandle(
+        VkDevice device,
+        Handle& handle,
+        void (VKAPI_PTR* destroyFn)(VkDevice, Handle, const VkAllocationCallbacks*),
+        const char* owner,
+        const char* file,
+        int line)
+    {
+        if (handle == VK_NULL_HANDLE)
+            return;
+
+        const Handle captured = handle;
+        handle = VK_NULL_HANDLE;
+        Enqueue((uint64_t)captured, owner, file, line, [device, captured, destroyFn]()
+            {
+                destroyFn(device, captured, nullptr);
+            });
+    }
+
+    void DestroyBuffer(VkDevice device, VkBuffer& buffer, const char* owner, const char* file, int line);
+    void FreeMemory(VkDevice device, VkDeviceMemory& memory, const char* owner, const char* file, int line);
+
+    size_t GetPendingCount() const;
+    uint64_t GetReleasedCount() const { return _releasedCount; }
+};
+
+
+
+namespace QE
+{
+    using ::QEDeferredDeletionQueue;
+} // namespace QE
+// QE namespace aliases
+#endif // !QE_DEFERRED_DELETION_QUEUE_H
@@ -0,0 +1,204 @@
+#include "ShadowAtlasResources.h"
+#include <ImageMemoryTools.h>
+#include <CSMResources.h>
+#include <stdexcept>
+#include <Helpers/QEMemoryTrack.h>
+
+ShadowAtlasResources::ShadowAtlasResources(uint32_t atlasSize, uint32_t layerCount, std::shared_ptr<VkRenderPass> renderPass)
+{
+    this->deviceModule = DeviceModule::getInstance();
+    this->format = CSMResources::GetSupportedShadowFormat(this->deviceModule);
+    this->atlasSize = atlasSize;
+    this->layerCount = layerCount;
+
+    this->aspectMask = VK_IMAGE_ASPECT_DEPTH_BIT;
+    if (CSMResources::HasStencilComponent(this->format))
+    {
+        this->aspectMask |= VK_IMAGE_ASPECT_STENCIL_BIT;
+    }
+
+    this->CreateAtlasImage();
+    this->CreateFramebuffers(renderPass);
+}
+
+void ShadowAtlasResources::CreateAtlasImage()
+{
+    VkImageCreateInfo imageInfo{};
+    imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+    imageInfo.imageType = VK_IMAGE_TYPE_2D;
+    imageInfo.extent = { this->atlasSize, this->atlasSize, 1 };
+    imageInfo.mipLevels = 1;
+    imageInfo.arrayLayers = this->layerCount;
+    imageInfo.format = this->format;
+    imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+    imageInfo.usage = VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT |
+        VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+    imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+    imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+    if (vkCreateImage(deviceModule->device, &imageInfo, nullptr, &this->atlasImage) != VK_SUCCESS)
+    {
+        throw std::runtime_error("failed to create shadow atlas image!");
+    }
+
+    VkMemoryRequirements memRequirements{};
+    vkGetImageMemoryRequirements(deviceModule->device, this->atlasImage, &memRequirements);
+
+    VkMemoryAllocateInfo allocInfo{};
+    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    allocInfo.allocationSize = memRequirements.size;
+    allocInfo.memoryTypeIndex = IMT::findMemoryType(
+        memRequirements.memoryTypeBits,
+        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+        deviceModule->physicalDevice);
+
+    if (vkAllocateMemory(deviceModule->device, &allocInfo, nullptr, &this->atlasImageMemory) != VK_SUCCESS)
+    {
+        throw std::runtime_error("failed to allocate shadow atlas memory!");
+    }
+    QE_TRACK_MEMORY_ALLOCATION(this->atlasImageMemory, "ShadowAtlasResources::CreateAtlasImage");
+
+    vkBindImageMemory(deviceModule->device, this->atlasImage, this->atlasImageMemory, 0);
+    this->allocationSize = memRequirements.size;
+
+    // El atlas vive en DEPTH_STENCIL_READ_ONLY: los pases de sombra hacen clear solo del renderArea del tile
+    CSMResources::TransitionImageLayout(
+        deviceModule->device,
+        this->atlasImage,
+        this->format,
+        VK_IMAGE_LAYOUT_UNDEFINED,
+        VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL,
+        this->layerCount);
+
+    if (this->layerCount == 1)
+    {
+        this->sampledImageView = IMT::createImageView(
+            deviceModule->device,
+            this->atlasImage,
+            VK_IMAGE_VIEW_TYPE_2D,
+            this->format,
+            VK_IMAGE_ASPECT_DEPTH_BIT);
+    }
+    else
+    {
+        this->sampledImageView = CSMResources::CreateImageView(
+            deviceModule->device,
+            this->atlasImage,
+            this->format,
+            VK_IMAGE_ASPECT_DEPTH_BIT,
+            0,
+            static_cast<int>(this->layerCount));
+    }
+
+    this->sampler = CSMResources::CreateCSMSampler(deviceModule->device);
+}
+
+void ShadowAtlasResources::CreateFramebuffers(std::shared_ptr<VkRenderPass> renderPass)
+{
+    this->layerImageViews.resize(this->layerCount, VK_NULL_HANDLE);
+    this->layerFrameBuffers.resize(this->layerCount, VK_NULL_HANDLE);
+
+    for (uint32_t layer = 0; layer < this->layerCount; ++layer)
+    {
+        this->layerImageViews[layer] = CSMResources::CreateImageView(
+            deviceModule->device,
+            this->atlasImage,
+            this->format,
+            VK_IMAGE_ASPECT_DEPTH_BIT,
+            static_cast<int>(layer),
+            1);
+
+        VkFramebufferCreateInfo framebufferInfo{};
+        framebufferInfo.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
+        framebufferInfo.renderPass = *renderPass;
+        framebufferInfo.attachmentCount = 1;
+        framebufferInfo.pAttachments = &this->layerImageViews[layer];
+        framebufferInfo.width = this->atlasSize;
+        framebufferInfo.height = this->atlasSize;
+        framebufferInfo.layers = 1;
+
+        if (vkCreateFramebuffer(deviceModule->device, &framebufferInfo, nullptr, &this->layerFrameBuffers[layer]) != VK_SUCCESS)
+        {
+            throw std::runtime_error("failed to create shadow atlas framebuffer!");
+        }
+    }
+
+    if (this->layerCount <= 1)
+        return;
+
+    this->layeredImageView = CSMResources::CreateImageView(
+        deviceModule->device,
+        this->atlasImage,
+        this->format,
+        VK_IMAGE_ASPECT_DEPTH_BIT,
+        0,
+        static_cast<int>(this->layerCount));
+
+    VkFramebufferCreateInfo framebufferInfo{};
+    framebufferInfo.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
+    framebufferInfo.renderPass = *renderPass;
+    framebufferInfo.attachmentCount = 1;
+    framebufferInfo.pAttachments = &this->layeredImageView;
+    framebufferInfo.width = this->atlasSize;
+    framebufferInfo.height = this->atlasSize;
+    framebufferInfo.layers = this->layerCount;
+
+    if (vkCreateFramebuffer(deviceModule->device, &framebufferInfo, nullptr, &this->layeredFrameBuffer) != VK_SUCCESS)
+    {
+        throw std::runtime_error("failed to create layered shadow atlas framebuffer!");
+    }
+}
+
+void ShadowAtlasResources::Cleanup()
+{
+    for (auto& framebuffer : this->layerFrameBuffers)
+    {
+        if (framebuffer != VK_NULL_HANDLE)
+        {
+            QE_DEFER_DESTROY(deviceModule->device, framebuffer, vkDestroyFramebuffer, "ShadowAtlasResources::Cleanup");
+        }
+    }
+    this->layerFrameBuffers.clear();
+
+    for (auto& imageView : this->layerImageViews)
+    {
+        if (imageView != VK_NULL_HANDLE)
+        {
+            QE_DEFER_DESTROY(deviceModule->device, imageView, vkDestroyImageView, "ShadowAtlasResources::Cleanup");
+        }
+    }
+    this->layerImageViews.clear();
+
+    if (this->layeredFrameBuffer != VK_NULL_HANDLE)
+    {
+        QE_DEFER_DESTROY(deviceModule->device, this->layeredFrameBuffer, vkDestroyFramebuffer, "ShadowAtlasResources::Cleanup");
+    }
+
+    if (this->layeredImageView != VK_NULL_HANDLE)
+    {
+        QE_DEFER_DESTROY(deviceModule->device, this->layeredImageView, vkDestroyImageView, "ShadowAtlasResources::Cleanup");
+    }
+
+    if (this->sampler != VK_NULL_HANDLE)
+    {
+        QE_DEFER_DESTROY(deviceModule->device, this->sampler, vkDestroySampler, "ShadowAtlasResources::Cleanup");
+    }
+
+    if (this->sampledImageView != VK_NULL_HANDLE)
+    {
+        QE_DEFER_DESTROY(deviceModule->device, this->sampledImageView, vkDestroyImageView, "ShadowAtlasResources::Cleanup");
+    }
+
+    if (this->atlasImage != VK_NULL_HANDLE)
+    {
+        QE_DEFER_DESTROY(deviceModule->device, this->atlasImage, vkDestroyImage, "ShadowAtlasResources::Cleanup");
+    }
+
+    if (this->atlasImageMemory != VK_NULL_HANDLE)
+    {
+        QE_FREE_MEMORY(deviceModule->device, this->atlasImageMemory, "ShadowAtlasResources::Cleanup");
+    }
+
+    this->allocationSize = 0;
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#ifndef SHADOW_ATLAS_RESOURCES_H
+#define SHADOW_ATLAS_RESOURCES_H
+
+#include <vector>
+#include <vulkan/vulkan.hpp>
+#include <DeviceModule.h>
+
+/// Imagen de profundidad compartida por varias luces. Cada luz renderiza en su tile
+/// (viewport + scissor) y los shaders remapean las UV al rectangulo del tile.
+/// Spot: una capa. Point: seis capas, una por cara del cubo.
+class ShadowAtlasResources
+{
+private:
+    DeviceModule* deviceModule = nullptr;
+
+    VkImage atlasImage = VK_NULL_HANDLE;
+    VkDeviceMemory atlasImageMemory = VK_NULL_HANDLE;
+    VkImageView sampledImageView = VK_NULL_HANDLE;
+    VkSampler sampler = VK_NULL_HANDLE;
+
+    std::vector<VkImageView> layerImageViews;
+    std::vector<VkFramebuffer> layerFrameBuffers;
+
+    // Solo con varias capas: vista y framebuffer sobre todas ellas para pases con gl_Layer
+    VkImageView layeredImageView = VK_NULL_HANDLE;
+    VkFramebuffer layeredFrameBuffer = VK_NULL_HANDLE;
+
+    VkFormat format = VK_FORMAT_UNDEFINED;
+    VkImageAspectFlags aspectMask = 0;
+    uint32_t atlasSize = 0;
+    uint32_t layerCount = 0;
+    VkDeviceSize allocationSize = 0;
+
+private:
+    void CreateAtlasImage();
+    void CreateFramebuffers(std::shared_ptr<VkRenderPass> renderPass);
+
+public:
+    ShadowAtlasResources(uint32_t atlasSize, uint32_t layerCount, std::shared_ptr<VkRenderPass> renderPass);
+
+    VkImage GetImage() const { return this->atlasImage; }
+    VkImageView GetImageView() const { return this->sampledImageView; }
+    VkSampler GetSampler() const { return this->sampler; }
+    VkFramebuffer GetFramebuffer(uint32_t layer) const { return layer < this->layerFrameBuffers.size() ? this->layerFrameBuffers[layer] : VK_NULL_HANDLE; }
+    VkFramebuffer GetLayeredFramebuffer() const { return this->layeredFrameBuffer; }
+    VkFormat GetFormat() const { return this->format; }
+    VkImageAspectFlags GetAspectMask() const { return this->aspectMask; }
+    uint32_t GetAtlasSize() const { return this->atlasSize; }
+    uint32_t GetLayerCount() const { return this->layerCount; }
+    VkDeviceSize GetAllocationSize() const { return this->allocationSize; }
+
+    void Cleanup();
+};
+
+
+
+namespace QE
+{
+    using ::ShadowAtlasResources;
+} // namespace QE
+// QE namespace aliases
+#endif // !SHADOW_ATLAS_RESOURCES_H
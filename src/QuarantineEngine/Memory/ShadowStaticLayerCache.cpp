@@ -0,0 +1,208 @@
+#include "ShadowStaticLayerCache.h"
+#include <ImageMemoryTools.h>
+#include <stdexcept>
+#include <Helpers/QEMemoryTrack.h>
+
+namespace
+{
+    constexpr VkPipelineStageFlags SHADOW_ATTACHMENT_STAGES =
+        VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT |
+        VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT |
+        VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT |
+        VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+
+    constexpr VkAccessFlags SHADOW_ATTACHMENT_WRITES =
+        VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT |
+        VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+
+    constexpr VkAccessFlags SHADOW_ATTACHMENT_ACCESS =
+        VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT |
+        VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT |
+        VK_ACCESS_COLOR_ATTACHMENT_READ_BIT |
+        VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT |
+        VK_ACCESS_SHADER_READ_BIT;
+}
+
+ShadowStaticLayerCache::ShadowStaticLayerCache(VkFormat format, VkImageAspectFlags aspectMask, uint32_t textureSize, uint32_t layerCount)
+{
+    this->deviceModule = DeviceModule::getInstance();
+    this->format = format;
+    this->aspectMask = aspectMask;
+    this->textureSize = textureSize;
+    this->layerCount = layerCount;
+    this->storedLayers.assign(layerCount, false);
+
+    this->CreateCacheImage();
+}
+
+void ShadowStaticLayerCache::CreateCacheImage()
+{
+    VkImageCreateInfo imageInfo{};
+    imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+    imageInfo.imageType = VK_IMAGE_TYPE_2D;
+    imageInfo.extent = { this->textureSize, this->textureSize, 1 };
+    imageInfo.mipLevels = 1;
+    imageInfo.arrayLayers = this->layerCount;
+    imageInfo.format = this->format;
+    imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+    imageInfo.usage = VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+    imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+    imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+    if (vkCreateImage(deviceModule->device, &imageInfo, nullptr, &this->cacheImage) != VK_SUCCESS)
+    {
+        throw std::runtime_error("failed to create static shadow cache image!");
+    }
+
+    VkMemoryRequirements memRequirements{};
+    vkGetImageMemoryRequirements(deviceModule->device, this->cacheImage, &memRequirements);
+
+    VkMemoryAllocateInfo allocInfo{};
+    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    allocInfo.allocationSize = memRequirements.size;
+    allocInfo.memoryTypeIndex = IMT::findMemoryType(
+        memRequirements.memoryTypeBits,
+        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+        deviceModule->physicalDevice);
+
+    if (vkAllocateMemory(deviceModule->device, &allocInfo, nullptr, &this->cacheImageMemory) != VK_SUCCESS)
+    {
+        throw std::runtime_error("failed to allocate static shadow cache memory!");
+    }
+    QE_TRACK_MEMORY_ALLOCATION(this->cacheImageMemory, "ShadowStaticLayerCache::CreateCacheImage");
+
+    vkBindImageMemory(deviceModule->device, this->cacheImage, this->cacheImageMemory, 0);
+    this->allocationSize = memRequirements.size;
+}
+
+void ShadowStaticLayerCache::LiveImageBarrier(VkCommandBuffer commandBuffer, VkImage liveImage, uint32_t liveLayer,
+    VkImageLayout oldLayout, VkImageLayout newLayout, VkAccessFlags srcAccess, VkAccessFlags dstAccess,
+    VkPipelineStageFlags srcStage, VkPipelineStageFlags dstStage)
+{
+    VkImageMemoryBarrier barrier{};
+    barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    barrier.oldLayout = oldLayout;
+    barrier.newLayout = newLayout;
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.image = liveImage;
+    barrier.subresourceRange.aspectMask = this->aspectMask;
+    barrier.subresourceRange.baseMipLevel = 0;
+    barrier.subresourceRange.levelCount = 1;
+    barrier.subresourceRange.baseArrayLayer = liveLayer;
+    barrier.subresourceRange.layerCount = 1;
+    barrier.srcAccessMask = srcAccess;
+    barrier.dstAccessMask = dstAccess;
+
+    vkCmdPipelineBarrier(commandBuffer, srcStage, dstStage, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+}
+
+void ShadowStaticLayerCache::CacheImageBarrier(VkCommandBuffer commandBuffer, uint32_t cacheLayer,
+    VkImageLayout oldLayout, VkImageLayout newLayout, VkAccessFlags srcAccess, VkAccessFlags dstAccess)
+{
+    VkImageMemoryBarrier barrier{};
+    barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    barrier.oldLayout = oldLayout;
+    barrier.newLayout = newLayout;
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.image = this->cacheImage;
+    barrier.subresourceRange.aspectMask = this->aspectMask;
+    barrier.subresourceRange.baseMipLevel = 0;
+    barrier.subresourceRange.levelCount = 1;
+    barrier.subresourceRange.baseArrayLayer = cacheLayer;
+    barrier.subresourceRange.layerCount = 1;
+    barrier.srcAccessMask = srcAccess;
+    barrier.dstAccessMask = dstAccess;
+
+    vkCmdPipelineBarrier(
+        commandBuffer,
+        VK_PIPELINE_STAGE_TRANSFER_BIT,
+        VK_PIPELINE_STAGE_TRANSFER_BIT,
+        0, 0, nullptr, 0, nullptr, 1, &barrier);
+}
+
+void ShadowStaticLayerCache::CopyLayer(VkCommandBuffer commandBuffer, VkImage srcImage, uint32_t srcLayer, VkOffset2D srcOffset, VkImage dstImage, uint32_t dstLayer, VkOffset2D dstOffset)
+{
+    VkImageCopy region{};
+    region.srcSubresource.aspectMask = this->aspectMask;
+    region.srcSubresource.mipLevel = 0;
+    region.srcSubresource.baseArrayLayer = srcLayer;
+    region.srcSubresource.layerCount = 1;
+    region.dstSubresource = region.srcSubresource;
+    region.dstSubresource.baseArrayLayer = dstLayer;
+    region.srcOffset = { srcOffset.x, srcOffset.y, 0 };
+    region.dstOffset = { dstOffset.x, dstOffset.y, 0 };
+    region.extent = { this->textureSize, this->textureSize, 1 };
+
+    vkCmdCopyImage(
+        commandBuffer,
+        srcImage, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+        dstImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+        1, &region);
+}
+
+void ShadowStaticLayerCache::Store(VkCommandBuffer commandBuffer, VkImage liveImage, VkImageLayout liveLayout, uint32_t liveLayer, uint32_t cacheLayer, VkOffset2D liveOffset)
+{
+    if (this->cacheImage == VK_NULL_HANDLE || cacheLayer >= this->layerCount)
+        return;
+
+    this->LiveImageBarrier(commandBuffer, liveImage, liveLayer,
+        liveLayout, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+        SHADOW_ATTACHMENT_WRITES, VK_ACCESS_TRANSFER_READ_BIT,
+        SHADOW_ATTACHMENT_STAGES, VK_PIPELINE_STAGE_TRANSFER_BIT);
+
+    // La primera escritura de cada capa descarta su contenido previo.
+    this->CacheImageBarrier(commandBuffer, cacheLayer,
+        this->storedLayers[cacheLayer] ? VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL : VK_IMAGE_LAYOUT_UNDEFINED,
+        VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+        VK_ACCESS_TRANSFER_READ_BIT, VK_ACCESS_TRANSFER_WRITE_BIT);
+
+    this->CopyLayer(commandBuffer, liveImage, liveLayer, liveOffset, this->cacheImage, cacheLayer, { 0, 0 });
+
+    this->CacheImageBarrier(commandBuffer, cacheLayer,
+        VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+        VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_TRANSFER_READ_BIT);
+
+    this->LiveImageBarrier(commandBuffer, liveImage, liveLayer,
+        VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, liveLayout,
+        VK_ACCESS_TRANSFER_READ_BIT, SHADOW_ATTACHMENT_ACCESS,
+        VK_PIPELINE_STAGE_TRANSFER_BIT, SHADOW_ATTACHMENT_STAGES);
+
+    this->storedLayers[cacheLayer] = true;
+}
+
+void ShadowStaticLayerCache::Restore(VkCommandBuffer commandBuffer, VkImage liveImage, VkImageLayout liveLayout, uint32_t liveLayer, uint32_t cacheLayer, VkOffset2D liveOffset)
+{
+    // Una capa que nunca se guardo no tiene profundidad estatica valida
+    if (this->cacheImage == VK_NULL_HANDLE || cacheLayer >= this->layerCount || !this->storedLayers[cacheLayer])
+        return;
+
+    this->LiveImageBarrier(commandBuffer, liveImage, liveLayer,
+        liveLayout, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+        SHADOW_ATTACHMENT_WRITES, VK_ACCESS_TRANSFER_WRITE_BIT,
+        SHADOW_ATTACHMENT_STAGES, VK_PIPELINE_STAGE_TRANSFER_BIT);
+
+    this->CopyLayer(commandBuffer, this->cacheImage, cacheLayer, { 0, 0 }, liveImage, liveLayer, liveOffset);
+
+    this->LiveImageBarrier(commandBuffer, liveImage, liveLayer,
+        VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, liveLayout,
+        VK_ACCESS_TRANSFER_WRITE_BIT, SHADOW_ATTACHMENT_ACCESS,
+        VK_PIPELINE_STAGE_TRANSFER_BIT, SHADOW_ATTACHMENT_STAGES);
+}
+
+void ShadowStaticLayerCache::Cleanup()
+{
+    if (this->cacheImage != VK_NULL_HANDLE)
+    {
+        QE_DEFER_DESTROY(deviceModule->device, this->cacheImage, vkDestroyImage, "ShadowStaticLayerCache::Cleanup");
+    }
+    if (this->cacheImageMemory != VK_NULL_HANDLE)
+    {
+        QE_FREE_MEMORY(deviceModule->device, this->cacheImageMemory, "ShadowStaticLayerCache::Cleanup");
+    }
+
+    this->storedLayers.assign(this->layerCount, false);
+    this->allocationSize = 0;
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#ifndef SHADOW_STATIC_LAYER_CACHE_H
+#define SHADOW_STATIC_LAYER_CACHE_H
+
+#include <vector>
+#include <vulkan/vulkan.hpp>
+#include <DeviceModule.h>
+
+/// Copia GPU de la capa estatica de un shadow map.
+/// Guarda el resultado de renderizar solo los casters estaticos de cada vista (cascada,
+/// cara de cubemap o spot) para que los frames siguientes restauren esa capa y
+/// dibujen encima unicamente los casters dinamicos.
+class ShadowStaticLayerCache
+{
+private:
+    DeviceModule* deviceModule = nullptr;
+
+    VkImage cacheImage = VK_NULL_HANDLE;
+    VkDeviceMemory cacheImageMemory = VK_NULL_HANDLE;
+
+    VkFormat format = VK_FORMAT_UNDEFINED;
+    VkImageAspectFlags aspectMask = 0;
+    uint32_t textureSize = 0;
+    uint32_t layerCount = 0;
+    VkDeviceSize allocationSize = 0;
+    // Capas con contenido valido (las demas siguen en UNDEFINED)
+    std::vector<bool> storedLayers;
+
+private:
+    void CreateCacheImage();
+    void CopyLayer(VkCommandBuffer commandBuffer, VkImage srcImage, uint32_t srcLayer, VkOffset2D srcOffset, VkImage dstImage, uint32_t dstLayer, VkOffset2D dstOffset);
+    void LiveImageBarrier(VkCommandBuffer commandBuffer, VkImage liveImage, uint32_t liveLayer,
+        VkImageLayout oldLayout, VkImageLayout newLayout, VkAccessFlags srcAccess, VkAccessFlags dstAccess,
+        VkPipelineStageFlags srcStage, VkPipelineStageFlags dstStage);
+    void CacheImageBarrier(VkCommandBuffer commandBuffer, uint32_t cacheLayer,
+        VkImageLayout oldLayout, VkImageLayout newLayout, VkAccessFlags srcAccess, VkAccessFlags dstAccess);
+
+public:
+    ShadowStaticLayerCache(VkFormat format, VkImageAspectFlags aspectMask, uint32_t textureSize, uint32_t layerCount);
+
+    /// Copia liveImage[liveLayer] -> cache[cacheLayer]. liveLayout es el layout en reposo de la imagen.
+    /// liveOffset situa la region textureSize x textureSize dentro de la imagen viva (tiles de atlas).
+    void Store(VkCommandBuffer commandBuffer, VkImage liveImage, VkImageLayout liveLayout, uint32_t liveLayer, uint32_t cacheLayer, VkOffset2D liveOffset = { 0, 0 });
+    /// Copia cache[cacheLayer] -> liveImage[liveLayer] y deja la imagen lista para un pase con LOAD.
+    void Restore(VkCommandBuffer commandBuffer, VkImage liveImage, VkImageLayout liveLayout, uint32_t liveLayer, uint32_t cacheLayer, VkOffset2D liveOffset = { 0, 0 });
+
+    uint32_t GetTextureSize() const { return this->textureSize; }
+    VkDeviceSize GetAllocationSize() const { return this->allocationSize; }
+    void Cleanup();
+};
+
+
+
+namespace QE
+{
+    using ::ShadowStaticLayerCache;
+} // namespace QE
+// QE namespace aliases
+#endif // !SHADOW_STATIC_LAYER_CACHE_H
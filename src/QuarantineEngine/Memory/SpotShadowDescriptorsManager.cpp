@@ -3,6 +3,7 @@
 #include <ImageMemoryTools.h>
 #include <stdexcept>
 #include <Helpers/QEMemoryTrack.h>
+#include <ShadowAtlasManager.h>
 
 SpotShadowDescriptorsManager::SpotShadowDescriptorsManager()
 {
@@ -11,16 +12,13 @@ SpotShadowDescriptorsManager::SpotShadowDescriptorsManager()
     this->CreateOffscreenDescriptorPool();
     this->CreateRenderDescriptorPool();
 
-    this->spotViewProjDataBufferSize = sizeof(glm::mat4) * MAX_NUM_SPOT_LIGHTS;
+    this->spotViewProjDataBufferSize = sizeof(SpotShadowUniform) * MAX_NUM_SPOT_LIGHTS;
     this->spotRenderViewProjBuffer.CreateSSBO(this->spotViewProjDataBufferSize, MAX_FRAMES_IN_FLIGHT, *deviceModule);
 }
 
-void SpotShadowDescriptorsManager::AddSpotLightResources(
-    std::shared_ptr<UniformBufferObject> offscreenShadowMapUBO,
-    VkImageView imageView,
-    VkSampler sampler)
+void SpotShadowDescriptorsManager::AddSpotLightResources(std::shared_ptr<UniformBufferObject> offscreenShadowMapUBO)
 {
-    if (!offscreenShadowMapUBO || imageView == VK_NULL_HANDLE || sampler == VK_NULL_HANDLE)
+    if (!offscreenShadowMapUBO)
         return;
 
     if (this->_numSpotLights >= MAX_NUM_SPOT_LIGHTS)
@@ -29,20 +27,12 @@ void SpotShadowDescriptorsManager::AddSpotLightResources(
     const uint32_t newLightIndex = this->_numSpotLights;
 
     this->offscreenShadowMapUBOs.push_back(offscreenShadowMapUBO);
-    this->_imageViews.push_back(imageView);
-    this->_samplers.push_back(sampler);
     this->_numSpotLights++;
 
     if (this->offscreenDescriptorSetLayout == VK_NULL_HANDLE)
         return;
 
-    WaitForGpuIdle();
     this->AllocateOffscreenDescriptorSetForLight(newLightIndex);
-
-    if (this->renderDescriptorSets[0] != VK_NULL_HANDLE)
-    {
-        this->UpdateRenderDescriptorSets();
-    }
 }
 
 void SpotShadowDescriptorsManager::DeleteSpotLightResources(int idPos)
@@ -50,11 +40,7 @@ void SpotShadowDescriptorsManager::DeleteSpotLightResources(int idPos)
     if (idPos < 0 || static_cast<uint32_t>(idPos) >= this->_numSpotLights)
         return;
 
-    WaitForGpuIdle();
-
     this->offscreenShadowMapUBOs.erase(this->offscreenShadowMapUBOs.begin() + idPos);
-    this->_imageViews.erase(this->_imageViews.begin() + idPos);
-    this->_samplers.erase(this->_samplers.begin() + idPos);
 
     if (idPos < static_cast<int>(this->shadowResources.size()))
     {
@@ -72,11 +58,6 @@ void SpotShadowDescriptorsManager::DeleteSpotLightResources(int idPos)
 
         offscreenDescriptorSets[frame][MAX_NUM_SPOT_LIGHTS - 1] = VK_NULL_HANDLE;
     }
-
-    if (this->renderDescriptorSets[0] != VK_NULL_HANDLE)
-    {
-        this->UpdateRenderDescriptorSets();
-    }
 }
 
 void SpotShadowDescriptorsManager::BindResources(const std::shared_ptr<SpotShadowResources>& resources)
@@ -90,14 +71,17 @@ void SpotShadowDescriptorsManager::UpdateResources(int currentFrame)
 
     for (int i = 0; i < MAX_NUM_SPOT_LIGHTS; i++)
     {
+        SpotShadowUniform spotData{};
+        spotData.viewProj = glm::mat4(1.0f);
+
+        // atlasRect a cero = la luz no tiene tile este frame y el shader la trata como sin sombra
         if (i < static_cast<int>(this->shadowResources.size()) && this->shadowResources[i])
         {
-            this->spotViewProjDataResources.push_back(this->shadowResources[i]->ViewProjMatrix);
-        }
-        else
-        {
-            this->spotViewProjDataResources.push_back(glm::mat4(1.0f));
+            spotData.viewProj = this->shadowResources[i]->ViewProjMatrix;
+            spotData.atlasRect = this->shadowResources[i]->GetAtlasRect();
         }
+
+        this->spotViewProjDataResources.push_back(spotData);
     }
 
     void* dataViewProj = nullptr;
@@ -146,7 +130,7 @@ void SpotShadowDescriptorsManager::CreateRenderDescriptorPool()
     std::array<VkDescriptorPoolSize, 2> poolSizes{};
 
     poolSizes[0].type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-    poolSizes[0].descriptorCount = static_cast<uint32_t>(MAX_FRAMES_IN_FLIGHT) * MAX_NUM_SPOT_LIGHTS;
+    poolSizes[0].descriptorCount = static_cast<uint32_t>(MAX_FRAMES_IN_FLIGHT);
 
     poolSizes[1].type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
     poolSizes[1].descriptorCount = static_cast<uint32_t>(MAX_FRAMES_IN_FLIGHT);
@@ -258,29 +242,19 @@ void SpotShadowDescriptorsManager::SetSpotDescriptorWrite(
     VkDescriptorType descriptorType,
     uint32_t binding)
 {
-    for (uint32_t i = 0; i < MAX_NUM_SPOT_LIGHTS; ++i)
-    {
-        this->renderDescriptorImageInfo[i].imageLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL;
+    const auto& atlas = ShadowAtlasManager::getInstance()->GetSpotAtlas();
 
-        if (i < _numSpotLights)
-        {
-            this->renderDescriptorImageInfo[i].imageView = _imageViews[i];
-            this->renderDescriptorImageInfo[i].sampler = _samplers[i];
-        }
-        else
-        {
-            this->renderDescriptorImageInfo[i].imageView = placeholderImageView;
-            this->renderDescriptorImageInfo[i].sampler = placeholderSampler;
-        }
-    }
+    this->renderDescriptorImageInfo.imageLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL;
+    this->renderDescriptorImageInfo.imageView = atlas ? atlas->GetImageView() : placeholderImageView;
+    this->renderDescriptorImageInfo.sampler = atlas ? atlas->GetSampler() : placeholderSampler;
 
     descriptorWrite.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
     descriptorWrite.dstSet = descriptorSet;
     descriptorWrite.dstBinding = binding;
     descriptorWrite.dstArrayElement = 0;
     descriptorWrite.descriptorType = descriptorType;
-    descriptorWrite.descriptorCount = MAX_NUM_SPOT_LIGHTS;
-    descriptorWrite.pImageInfo = this->renderDescriptorImageInfo.data();
+    descriptorWrite.descriptorCount = 1;
+    descriptorWrite.pImageInfo = &this->renderDescriptorImageInfo;
     descriptorWrite.pBufferInfo = nullptr;
     descriptorWrite.pTexelBufferView = nullptr;
 }
@@ -315,7 +289,6 @@ void SpotShadowDescriptorsManager::CreateRenderDescriptorSet()
     allocInfo.descriptorSetCount = static_cast<uint32_t>(MAX_FRAMES_IN_FLIGHT);
     allocInfo.pSetLayouts = layouts.data();
 
-    this->renderDescriptorImageInfo.resize(MAX_NUM_SPOT_LIGHTS);
     this->renderBuffersInfo.resize(1);
 
     if (vkAllocateDescriptorSets(deviceModule->device, &allocInfo, this->renderDescriptorSets) != VK_SUCCESS)
@@ -334,7 +307,7 @@ VkDescriptorSetLayout SpotShadowDescriptorsManager::CreateRenderDescriptorSetLay
 
     layoutBindings[0].binding = 0;
     layoutBindings[0].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-    layoutBindings[0].descriptorCount = MAX_NUM_SPOT_LIGHTS;
+    layoutBindings[0].descriptorCount = 1;
     layoutBindings[0].stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
     layoutBindings[0].pImmutableSamplers = nullptr;
 
@@ -428,26 +401,26 @@ void SpotShadowDescriptorsManager::UpdateRenderDescriptorSets()
 
 void SpotShadowDescriptorsManager::ResetSceneState()
 {
-    WaitForGpuIdle();
-
+    // Los frames en vuelo aun pueden usar los sets actuales: los pools se retiran por la cola
+    // de destruccion diferida y la escena nueva reserva sus sets en pools vacios
     if (this->offscreenDescriptorPool != VK_NULL_HANDLE)
     {
-        vkResetDescriptorPool(deviceModule->device, this->offscreenDescriptorPool, 0);
+        QE_DEFER_DESTROY(deviceModule->device, this->offscreenDescriptorPool, vkDestroyDescriptorPool, "SpotShadowDescriptorsManager::ResetSceneState");
+        this->CreateOffscreenDescriptorPool();
     }
 
     if (this->renderDescriptorPool != VK_NULL_HANDLE)
     {
-        vkResetDescriptorPool(deviceModule->device, this->renderDescriptorPool, 0);
+        QE_DEFER_DESTROY(deviceModule->device, this->renderDescriptorPool, vkDestroyDescriptorPool, "SpotShadowDescriptorsManager::ResetSceneState");
+        this->CreateRenderDescriptorPool();
     }
 
     _numSpotLights = 0;
     offscreenShadowMapUBOs.clear();
     shadowResources.clear();
-    _imageViews.clear();
-    _samplers.clear();
     spotViewProjDataResources.clear();
     renderBuffersInfo.clear();
-    renderDescriptorImageInfo.clear();
+    renderDescriptorImageInfo = {};
     offscreenBufferInfo = {};
 
     for (size_t i = 0; i < NUM_SPOT_SHADOW_SETS; i++)
@@ -520,11 +493,3 @@ void SpotShadowDescriptorsManager::Clean()
         this->placeholderMemory = VK_NULL_HANDLE;
     }
 }
-
-void SpotShadowDescriptorsManager::WaitForGpuIdle() const
-{
-    if (!deviceModule)
-        return;
-
-    vkDeviceWaitIdle(deviceModule->device);
-}
@@ -7,8 +7,9 @@
 #include <DeviceModule.h>
 #include <ShaderModule.h>
 #include <SpotShadowResources.h>
+#include <SynchronizationModule.h>
 
-constexpr uint32_t NUM_SPOT_SHADOW_SETS = 2;
+constexpr uint32_t NUM_SPOT_SHADOW_SETS = MAX_FRAMES_IN_FLIGHT;
 constexpr uint32_t MAX_NUM_SPOT_LIGHTS = 10;
 
 class SpotShadowDescriptorsManager
@@ -25,15 +26,14 @@ private:
     uint32_t _numSpotLights = 0;
     std::vector<std::shared_ptr<UniformBufferObject>> offscreenShadowMapUBOs;
     std::vector<std::shared_ptr<SpotShadowResources>> shadowResources;
-    std::vector<VkImageView> _imageViews;
-    std::vector<VkSampler> _samplers;
 
-    std::vector<VkDescriptorImageInfo> renderDescriptorImageInfo;
+    // Todas las spot lights comparten el atlas de ShadowAtlasManager
+    VkDescriptorImageInfo renderDescriptorImageInfo{};
     std::vector<VkDescriptorBufferInfo> renderBuffersInfo;
 
     UniformBufferObject spotRenderViewProjBuffer;
     VkDeviceSize spotViewProjDataBufferSize = 0;
-    std::vector<glm::mat4> spotViewProjDataResources;
+    std::vector<SpotShadowUniform> spotViewProjDataResources;
 
     VkDeviceMemory placeholderMemory = VK_NULL_HANDLE;
     VkImage placeholderImage = VK_NULL_HANDLE;
@@ -49,10 +49,7 @@ public:
 public:
     SpotShadowDescriptorsManager();
 
-    void AddSpotLightResources(
-        std::shared_ptr<UniformBufferObject> offscreenShadowMapUBO,
-        VkImageView imageView,
-        VkSampler sampler);
+    void AddSpotLightResources(std::shared_ptr<UniformBufferObject> offscreenShadowMapUBO);
     void DeleteSpotLightResources(int idPos);
     void BindResources(const std::shared_ptr<SpotShadowResources>& resources);
     void UpdateResources(int currentFrame);
@@ -93,7 +90,6 @@ private:
     VkDescriptorSetLayout CreateRenderDescriptorSetLayout();
     VkDescriptorBufferInfo GetBufferInfo(VkBuffer buffer, VkDeviceSize bufferSize);
     void CreateShadowPlaceholder();
-    void WaitForGpuIdle() const;
 };
 
 
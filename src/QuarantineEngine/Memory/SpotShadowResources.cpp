@@ -1,11 +1,8 @@
 #include "SpotShadowResources.h"
-#include <ImageMemoryTools.h>
 #include <stdexcept>
 #include <Helpers/QEMemoryTrack.h>
 #include <SynchronizationModule.h>
 
-uint32_t SpotShadowResources::TextureSize = 2048;
-
 SpotShadowResources::SpotShadowResources()
 {
     this->deviceModule = DeviceModule::getInstance();
@@ -16,80 +13,48 @@ SpotShadowResources::SpotShadowResources()
     this->OffscreenShadowMapUBO->CreateUniformBuffer(sizeof(CSMUniform), MAX_FRAMES_IN_FLIGHT, *deviceModule);
 }
 
-SpotShadowResources::SpotShadowResources(std::shared_ptr<VkRenderPass> renderPass) : SpotShadowResources()
+void SpotShadowResources::SetAtlasTile(std::shared_ptr<ShadowAtlasResources> atlasResources, const ShadowAtlasTile& tile)
 {
-    this->CreateSpotShadowResources(renderPass);
+    // La cache estatica copia el tile completo: si cambia de tamano hay que recrearla
+    if (this->staticLayerCache != nullptr && this->staticLayerCache->GetTextureSize() != tile.Size)
+    {
+        this->ReleaseStaticLayerCache();
+    }
+
+    this->atlas = atlasResources;
+    this->atlasTile = tile;
 }
 
-void SpotShadowResources::CreateSpotShadowResources(std::shared_ptr<VkRenderPass> renderPass)
+void SpotShadowResources::ClearAtlasTile()
 {
-    VkImageCreateInfo imageInfo{};
-    imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
-    imageInfo.imageType = VK_IMAGE_TYPE_2D;
-    imageInfo.extent = { TextureSize, TextureSize, 1 };
-    imageInfo.mipLevels = 1;
-    imageInfo.arrayLayers = 1;
-    imageInfo.format = this->shadowFormat;
-    imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
-    imageInfo.usage = VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
-    imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
-    imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
-    imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-
-    if (vkCreateImage(deviceModule->device, &imageInfo, nullptr, &this->shadowImage) != VK_SUCCESS)
-    {
-        throw std::runtime_error("failed to create spot shadow image!");
-    }
+    this->atlas = nullptr;
+    this->atlasTile = {};
+}
 
-    VkMemoryRequirements memRequirements{};
-    vkGetImageMemoryRequirements(deviceModule->device, this->shadowImage, &memRequirements);
+VkRect2D SpotShadowResources::GetAtlasRegion() const
+{
+    VkRect2D region{};
+    region.offset = { static_cast<int32_t>(this->atlasTile.X), static_cast<int32_t>(this->atlasTile.Y) };
+    region.extent = { this->atlasTile.Size, this->atlasTile.Size };
+    return region;
+}
 
-    VkMemoryAllocateInfo allocInfo{};
-    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-    allocInfo.allocationSize = memRequirements.size;
-    allocInfo.memoryTypeIndex = IMT::findMemoryType(
-        memRequirements.memoryTypeBits,
-        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
-        deviceModule->physicalDevice);
+glm::vec4 SpotShadowResources::GetAtlasRect() const
+{
+    if (!this->HasAtlasTile())
+        return glm::vec4(0.0f);
+
+    const float invAtlasSize = 1.0f / static_cast<float>(this->atlas->GetAtlasSize());
+    return glm::vec4(
+        this->atlasTile.X * invAtlasSize,
+        this->atlasTile.Y * invAtlasSize,
+        this->atlasTile.Size * invAtlasSize,
+        this->atlasTile.Size * invAtlasSize);
+}
 
-    if (vkAllocateMemory(deviceModule->device, &allocInfo, nullptr, &this->shadowImageMemory) != VK_SUCCESS)
-    {
-        throw std::runtime_error("failed to allocate spot shadow image memory!");
-    }
-    QE_TRACK_MEMORY_ALLOCATION(this->shadowImageMemory, "SpotShadowResources::Initialize");
-
-    vkBindImageMemory(deviceModule->device, this->shadowImage, this->shadowImageMemory, 0);
-
-    CSMResources::TransitionImageLayout(
-        deviceModule->device,
-        this->shadowImage,
-        this->shadowFormat,
-        VK_IMAGE_LAYOUT_UNDEFINED,
-        VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL,
-        1);
-
-    this->ShadowImageView = IMT::createImageView(
-        deviceModule->device,
-        this->shadowImage,
-        VK_IMAGE_VIEW_TYPE_2D,
-        this->shadowFormat,
-        VK_IMAGE_ASPECT_DEPTH_BIT);
-
-    this->ShadowSampler = CSMResources::CreateCSMSampler(deviceModule->device);
-
-    VkFramebufferCreateInfo framebufferInfo{};
-    framebufferInfo.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
-    framebufferInfo.renderPass = *renderPass;
-    framebufferInfo.attachmentCount = 1;
-    framebufferInfo.pAttachments = &this->ShadowImageView;
-    framebufferInfo.width = TextureSize;
-    framebufferInfo.height = TextureSize;
-    framebufferInfo.layers = 1;
-
-    if (vkCreateFramebuffer(deviceModule->device, &framebufferInfo, nullptr, &this->frameBuffer) != VK_SUCCESS)
-    {
-        throw std::runtime_error("failed to create spot shadow framebuffer!");
-    }
+VkFramebuffer SpotShadowResources::GetFramebuffer() const
+{
+    return this->HasAtlasTile() ? this->atlas->GetFramebuffer(0) : VK_NULL_HANDLE;
 }
 
 void SpotShadowResources::UpdateOffscreenUBOShadowMap()
@@ -113,39 +78,60 @@ void SpotShadowResources::UpdateOffscreenUBOShadowMap()
     vkUnmapMemory(this->deviceModule->device, this->OffscreenShadowMapUBO->uniformBuffersMemory[currentFrame]);
 }
 
-void SpotShadowResources::Cleanup()
+void SpotShadowResources::StoreStaticLayer(VkCommandBuffer commandBuffer)
 {
-    for (int i = 0; i < MAX_FRAMES_IN_FLIGHT; i++)
-    {
-        if (this->OffscreenShadowMapUBO)
-        {
-            QE_DESTROY_BUFFER(deviceModule->device, this->OffscreenShadowMapUBO->uniformBuffers[i], "SpotShadowResources::Cleanup");
-            QE_FREE_MEMORY(deviceModule->device, this->OffscreenShadowMapUBO->uniformBuffersMemory[i], "SpotShadowResources::Cleanup");
-        }
-    }
+    if (!this->HasAtlasTile())
+        return;
 
-    if (this->frameBuffer != VK_NULL_HANDLE)
+    if (this->staticLayerCache == nullptr)
     {
-        vkDestroyFramebuffer(deviceModule->device, this->frameBuffer, nullptr);
+        this->staticLayerCache = std::make_shared<ShadowStaticLayerCache>(this->atlas->GetFormat(), this->atlas->GetAspectMask(), this->atlasTile.Size, 1);
     }
 
-    if (this->ShadowSampler != VK_NULL_HANDLE)
-    {
-        vkDestroySampler(deviceModule->device, this->ShadowSampler, nullptr);
-    }
+    const VkRect2D region = this->GetAtlasRegion();
+    this->staticLayerCache->Store(commandBuffer, this->atlas->GetImage(), VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL, 0, 0, region.offset);
+}
 
-    if (this->ShadowImageView != VK_NULL_HANDLE)
-    {
-        vkDestroyImageView(deviceModule->device, this->ShadowImageView, nullptr);
-    }
+void SpotShadowResources::RestoreStaticLayer(VkCommandBuffer commandBuffer)
+{
+    if (this->staticLayerCache == nullptr || !this->HasAtlasTile())
+        return;
+
+    const VkRect2D region = this->GetAtlasRegion();
+    this->staticLayerCache->Restore(commandBuffer, this->atlas->GetImage(), VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL, 0, 0, region.offset);
+}
+
+VkDeviceSize SpotShadowResources::GetStaticLayerCacheSize() const
+{
+    return this->staticLayerCache ? this->staticLayerCache->GetAllocationSize() : 0;
+}
+
+void SpotShadowResources::ReleaseStaticLayerCache()
+{
+    if (this->staticLayerCache == nullptr)
+        return;
+
+    // La imagen se libera cuando terminen los frames en vuelo que aun copian desde ella
+    this->staticLayerCache->Cleanup();
+    this->staticLayerCache = nullptr;
+}
 
-    if (this->shadowImage != VK_NULL_HANDLE)
+void SpotShadowResources::Cleanup()
+{
+    if (this->staticLayerCache != nullptr)
     {
-        vkDestroyImage(deviceModule->device, this->shadowImage, nullptr);
+        this->staticLayerCache->Cleanup();
+        this->staticLayerCache = nullptr;
     }
 
-    if (this->shadowImageMemory != VK_NULL_HANDLE)
+    this->ClearAtlasTile();
+
+    for (int i = 0; i < MAX_FRAMES_IN_FLIGHT; i++)
     {
-        QE_FREE_MEMORY(deviceModule->device, this->shadowImageMemory, "SpotShadowResources::Cleanup");
+        if (this->OffscreenShadowMapUBO)
+        {
+            QE_DESTROY_BUFFER(deviceModule->device, this->OffscreenShadowMapUBO->uniformBuffers[i], "SpotShadowResources::Cleanup");
+            QE_FREE_MEMORY(deviceModule->device, this->OffscreenShadowMapUBO->uniformBuffersMemory[i], "SpotShadowResources::Cleanup");
+        }
     }
 }
@@ -7,6 +7,9 @@
 #include <DeviceModule.h>
 #include <SwapChainModule.h>
 #include <CSMResources.h>
+#include <ShadowStaticLayerCache.h>
+#include <ShadowAtlasResources.h>
+#include <ShadowAtlasAllocator.h>
 
 class SpotShadowResources
 {
@@ -14,29 +17,38 @@ private:
     DeviceModule* deviceModule = nullptr;
     SwapChainModule* swapchainModule = nullptr;
 
-    VkImage shadowImage = VK_NULL_HANDLE;
-    VkDeviceMemory shadowImageMemory = VK_NULL_HANDLE;
+    // Tile asignado en el atlas de spots (ShadowAtlasManager)
+    std::shared_ptr<ShadowAtlasResources> atlas = nullptr;
+    ShadowAtlasTile atlasTile{};
 
-    void CreateSpotShadowResources(std::shared_ptr<VkRenderPass> renderPass);
+    std::shared_ptr<ShadowStaticLayerCache> staticLayerCache = nullptr;
 
-public:
-    static uint32_t TextureSize;
+    void ReleaseStaticLayerCache();
 
+public:
     VkFormat shadowFormat = VK_FORMAT_UNDEFINED;
     float DepthBiasConstant = 0.10f;
     float DepthBiasSlope = 0.50f;
 
     std::shared_ptr<UniformBufferObject> OffscreenShadowMapUBO = nullptr;
-    VkImageView ShadowImageView = VK_NULL_HANDLE;
-    VkSampler ShadowSampler = VK_NULL_HANDLE;
-    VkFramebuffer frameBuffer = VK_NULL_HANDLE;
     glm::mat4 ViewProjMatrix = glm::mat4(1.0f);
 
 public:
     SpotShadowResources();
-    SpotShadowResources(std::shared_ptr<VkRenderPass> renderPass);
+
+    void SetAtlasTile(std::shared_ptr<ShadowAtlasResources> atlasResources, const ShadowAtlasTile& tile);
+    void ClearAtlasTile();
+    bool HasAtlasTile() const { return this->atlas != nullptr && this->atlasTile.Valid(); }
+    const ShadowAtlasTile& GetAtlasTile() const { return this->atlasTile; }
+    VkRect2D GetAtlasRegion() const;
+    /// xy = offset UV del tile, zw = escala UV. Cero si la luz no tiene tile.
+    glm::vec4 GetAtlasRect() const;
+    VkFramebuffer GetFramebuffer() const;
 
     void UpdateOffscreenUBOShadowMap();
+    void StoreStaticLayer(VkCommandBuffer commandBuffer);
+    void RestoreStaticLayer(VkCommandBuffer commandBuffer);
+    VkDeviceSize GetStaticLayerCacheSize() const;
     void Cleanup();
 };
 
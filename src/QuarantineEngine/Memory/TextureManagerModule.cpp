@@ -211,12 +211,12 @@ void TextureManagerModule::cleanup()
 {
     if (this->imageView != VK_NULL_HANDLE)
     {
-        vkDestroyImageView(deviceModule->device, imageView, nullptr);
+        QE_DEFER_DESTROY(deviceModule->device, imageView, vkDestroyImageView, "TextureManagerModule::cleanup");
     }
 
     if (this->image != VK_NULL_HANDLE)
     {
-        vkDestroyImage(deviceModule->device, image, nullptr);
+        QE_DEFER_DESTROY(deviceModule->device, image, vkDestroyImage, "TextureManagerModule::cleanup");
     }
 
     if (this->deviceMemory != VK_NULL_HANDLE)
@@ -120,6 +120,18 @@ struct AnimationUniform
 struct PushConstantStruct
 {
     glm::mat4 model;
+    uint32_t materialIndex;     // Registro en QE_MaterialTable (ruta bindless)
+    uint32_t padding[3];
+};
+
+// Ruta de mesh shaders: rango de meshlets del LOD elegido
+struct PushConstantMeshletStruct
+{
+    glm::mat4 model;
+    uint32_t firstMeshlet;
+    uint32_t meshletCount;
+    uint32_t flags;         // QEMeshletCullFlags
+    uint32_t padding;
 };
 
 struct PushConstantOmniShadowStruct
@@ -127,12 +139,23 @@ struct PushConstantOmniShadowStruct
     glm::mat4 model;
     glm::mat4 lightModel;
     glm::mat4 view;
+    uint32_t materialIndex;
+    uint32_t padding[3];
+};
+
+// Variante de un solo pase: una instancia por cara; cabe en el rango de PushConstantOmniShadowStruct
+struct PushConstantOmniShadowLayeredStruct
+{
+    glm::mat4 model;
+    glm::mat4 lightModel;
+    glm::uvec4 faces;   // x = numero de caras, y = indices de cara empaquetados en 3 bits, z = indice de material
 };
 
 struct PushConstantCSMStruct
 {
     glm::mat4 model;
     uint32_t cascadeIndex;
+    uint32_t materialIndex;
 };
 
 struct PushConstantViewStruct
@@ -200,6 +223,13 @@ struct OmniShadowUniform
     glm::vec4 lightPos;
 };
 
+// Datos por spot light para muestrear el atlas de sombras
+struct SpotShadowUniform
+{
+    glm::mat4 viewProj;
+    glm::vec4 atlasRect = glm::vec4(0.0f); // xy offset UV, zw escala UV
+};
+
 const int CSM_NUM = 4;
 
 struct CSMUniform
@@ -238,13 +268,16 @@ namespace QE
     using ::NewParticleUniform;
     using ::AnimationUniform;
     using ::PushConstantStruct;
+    using ::PushConstantMeshletStruct;
     using ::PushConstantOmniShadowStruct;
+    using ::PushConstantOmniShadowLayeredStruct;
     using ::PushConstantCSMStruct;
     using ::PushConstantViewStruct;
     using ::DeltaTimeUniform;
     using ::SunUniform;
     using ::AtmosphereUniform;
     using ::OmniShadowUniform;
+    using ::SpotShadowUniform;
     using ::CSMUniform;
     using ::CascadeSplitUniform;
     using ::UniformBufferObject;
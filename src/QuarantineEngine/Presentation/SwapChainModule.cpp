@@ -78,13 +78,31 @@ void SwapChainModule::createSwapChain(VkSurfaceKHR& surface, GLFWwindow* window)
     this->UpdateScreenData();
 }
 
+void SwapChainModule::CreateHeadless(VkExtent2D extent, VkFormat format)
+{
+    numSwapChainImages = 0;
+    swapChain = VK_NULL_HANDLE;
+    swapChainImages.clear();
+    swapChainImageViews.clear();
+
+    swapChainImageFormat = format;
+    swapChainExtent = extent;
+
+    this->UpdateScreenData();
+}
+
 void SwapChainModule::cleanup()
 {
     for (auto imageView : swapChainImageViews) {
         vkDestroyImageView(deviceModule->device, imageView, nullptr);
     }
+    swapChainImageViews.clear();
 
-    vkDestroySwapchainKHR(deviceModule->device, swapChain, nullptr);
+    if (swapChain != VK_NULL_HANDLE)
+    {
+        vkDestroySwapchainKHR(deviceModule->device, swapChain, nullptr);
+        swapChain = VK_NULL_HANDLE;
+    }
 }
 
 VkSurfaceFormatKHR SwapChainModule::chooseSwapSurfaceFormat(const std::vector<VkSurfaceFormatKHR>& availableFormats)
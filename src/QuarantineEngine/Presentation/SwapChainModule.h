@@ -29,8 +29,8 @@ public:
 
 private:
     DeviceModule* deviceModule;
-    VkSwapchainKHR swapChain;
-    uint32_t numSwapChainImages;
+    VkSwapchainKHR swapChain = VK_NULL_HANDLE;
+    uint32_t numSwapChainImages = 0;
     ScreenDataUniform screenDataValues{};
     std::vector<bool> screenDataDirty;
     float currentTileSize;
@@ -39,6 +39,8 @@ private:
 public:
     SwapChainModule();
     void createSwapChain(VkSurfaceKHR& surface, GLFWwindow* window);
+    /// Modo headless: no hay swapchain, solo se fijan formato y extension del render target offscreen.
+    void CreateHeadless(VkExtent2D extent, VkFormat format);
     void cleanup();
     uint32_t getNumSwapChainImages() { return numSwapChainImages; }
     VkSwapchainKHR &getSwapchain() { return swapChain; }
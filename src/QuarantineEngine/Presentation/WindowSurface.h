@@ -9,7 +9,7 @@
 class WindowSurface
 {
 private:
-    VkSurfaceKHR surface;
+    VkSurfaceKHR surface = VK_NULL_HANDLE;
 
 public:
     void createSurface(VkInstance &instance, GLFWwindow* window);
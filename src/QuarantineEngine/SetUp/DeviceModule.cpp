@@ -1,5 +1,7 @@
 #include "DeviceModule.h"
 #include <stdexcept>
+#include <algorithm>
+#include <cstring>
 #include <map>
 #include <set>
 #include "QueueFamiliesModule.h"
@@ -66,15 +68,30 @@ void DeviceModule::createLogicalDevice(VkSurfaceKHR& surface, QueueModule& nQueu
         indices.presentFamily.value(),
         indices.computeFamily.value()
     };
-    float queuePriority = 1.0f;
+    const float queuePriorities[2] = { 1.0f, 1.0f };
+
+    // Async compute: segunda cola de la familia grafica/compute. Al ser la misma familia los
+    // recursos no necesitan transferencias de propiedad entre colas.
+    uint32_t familyCount = 0;
+    vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &familyCount, nullptr);
+    std::vector<VkQueueFamilyProperties> familyProperties(familyCount);
+    vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &familyCount, familyProperties.data());
+
+    const uint32_t computeFamily = indices.computeFamily.value();
+    const bool asyncCompute = familyProperties[computeFamily].queueCount > 1;
+
+    if (indices.transferFamily.has_value())
+    {
+        uniqueQueueFamilies.insert(indices.transferFamily.value());
+    }
 
     for (uint32_t queueFamily : uniqueQueueFamilies)
     {
         VkDeviceQueueCreateInfo q{};
         q.sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
         q.queueFamilyIndex = queueFamily;
-        q.queueCount = 1;
-        q.pQueuePriorities = &queuePriority;
+        q.queueCount = (asyncCompute && queueFamily == computeFamily) ? 2 : 1;
+        q.pQueuePriorities = queuePriorities;
         queueCreateInfos.push_back(q);
     }
 
@@ -113,15 +130,25 @@ void DeviceModule::createLogicalDevice(VkSurfaceKHR& surface, QueueModule& nQueu
     VkPhysicalDeviceBufferDeviceAddressFeatures bda{};
     bda.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_BUFFER_DEVICE_ADDRESS_FEATURES;
 
+    // Timeline semaphores (core 1.2): sincronizacion de frames entre colas
+    VkPhysicalDeviceTimelineSemaphoreFeatures timeline{};
+    timeline.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES;
+
     feats2.pNext = &bda;
     bda.pNext = &mesh;
     mesh.pNext = &storage8;
     storage8.pNext = &maintenance4;
     maintenance4.pNext = &indexing;
-    indexing.pNext = nullptr;
+    indexing.pNext = &timeline;
+    timeline.pNext = nullptr;
 
     vkGetPhysicalDeviceFeatures2(physicalDevice, &feats2);
 
+    if (!timeline.timelineSemaphore)
+    {
+        throw std::runtime_error("timeline semaphores are not supported by the selected device!");
+    }
+
     // Core features
     VkPhysicalDeviceFeatures core{};
     core.samplerAnisotropy = feats2.features.samplerAnisotropy;
@@ -184,6 +211,35 @@ void DeviceModule::createLogicalDevice(VkSurfaceKHR& surface, QueueModule& nQueu
         removeExt(VK_KHR_BUFFER_DEVICE_ADDRESS_EXTENSION_NAME);
     }
 
+    {
+        uint32_t extensionCount = 0;
+        vkEnumerateDeviceExtensionProperties(physicalDevice, nullptr, &extensionCount, nullptr);
+        std::vector<VkExtensionProperties> availableExtensions(extensionCount);
+        vkEnumerateDeviceExtensionProperties(physicalDevice, nullptr, &extensionCount, availableExtensions.data());
+
+        auto isAvailable = [&](const char* name)
+            {
+                return std::any_of(availableExtensions.begin(), availableExtensions.end(),
+                    [&](const VkExtensionProperties& extension)
+                    {
+                        return std::strcmp(extension.extensionName, name) == 0;
+                    });
+            };
+
+        // Headless: el swapchain solo se habilita si el ICD lo expone (lavapipe lo hace)
+        if (surface == VK_NULL_HANDLE && !isAvailable(VK_KHR_SWAPCHAIN_EXTENSION_NAME))
+        {
+            removeExt(VK_KHR_SWAPCHAIN_EXTENSION_NAME);
+        }
+
+        // Opcional: sombras omni en un solo pase escribiendo gl_Layer desde el vertex shader
+        this->shaderOutputLayer_supported = isAvailable(VK_EXT_SHADER_VIEWPORT_INDEX_LAYER_EXTENSION_NAME);
+        if (this->shaderOutputLayer_supported)
+        {
+            enabledExtensions.push_back(VK_EXT_SHADER_VIEWPORT_INDEX_LAYER_EXTENSION_NAME);
+        }
+    }
+
     feats2.features = core;
     feats2.pNext = &bda;
     bda.pNext = &mesh;
@@ -191,7 +247,8 @@ void DeviceModule::createLogicalDevice(VkSurfaceKHR& surface, QueueModule& nQueu
     fsr.pNext = &storage8;
     storage8.pNext = &maintenance4;
     maintenance4.pNext = &indexing;
-    indexing.pNext = nullptr;
+    indexing.pNext = &timeline;
+    timeline.pNext = nullptr;
 
     VkDeviceCreateInfo ci{};
     ci.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
@@ -222,7 +279,22 @@ void DeviceModule::createLogicalDevice(VkSurfaceKHR& surface, QueueModule& nQueu
     // --- Result Queues ---
     vkGetDeviceQueue(device, indices.graphicsFamily.value(), 0, &nQueueModule.graphicsQueue);
     vkGetDeviceQueue(device, indices.presentFamily.value(), 0, &nQueueModule.presentQueue);
-    vkGetDeviceQueue(device, indices.computeFamily.value(), 0, &nQueueModule.computeQueue);
+    vkGetDeviceQueue(device, computeFamily, asyncCompute ? 1 : 0, &nQueueModule.computeQueue);
+    nQueueModule.asyncCompute = asyncCompute;
+
+    nQueueModule.graphicsFamily = indices.graphicsFamily.value();
+    nQueueModule.dedicatedTransfer = indices.transferFamily.has_value();
+    nQueueModule.transferFamily = indices.transferFamily.value_or(nQueueModule.graphicsFamily);
+    if (nQueueModule.dedicatedTransfer)
+    {
+        vkGetDeviceQueue(device, nQueueModule.transferFamily, 0, &nQueueModule.transferQueue);
+    }
+    else
+    {
+        nQueueModule.transferQueue = nQueueModule.graphicsQueue;
+    }
+
+    queueIndices = indices;
 }
 
 
@@ -271,10 +343,11 @@ void DeviceModule::InitializeMeshShaderExtension()
 bool DeviceModule::isDeviceSuitable(VkPhysicalDevice newDevice, VkSurfaceKHR& surface) {
     QueueFamilyIndices indices = QueueFamilyIndices::findQueueFamilies(newDevice, surface);
 
-    bool extensionsSupported = checkDeviceExtensionSupport(newDevice);
+    const bool headless = surface == VK_NULL_HANDLE;
+    bool extensionsSupported = checkDeviceExtensionSupport(newDevice, !headless);
 
-    bool swapChainAdequate = false;
-    if (extensionsSupported) {
+    bool swapChainAdequate = headless;
+    if (extensionsSupported && !headless) {
         SwapChainSupportDetails swapChainSupport = SwapChainSupportDetails::querySwapChainSupport(newDevice, surface);
         swapChainAdequate = !swapChainSupport.formats.empty() && !swapChainSupport.presentModes.empty();
     }
@@ -23,6 +23,7 @@ private:
     QueueModule                         queueModule;
     bool                                bindless_supported;
     bool                                meshShader_supported;
+    bool                                shaderOutputLayer_supported = false;
 
 public:
     VkDevice                            device;
@@ -36,6 +37,8 @@ public:
     void cleanup();
     VkSampleCountFlagBits* getMsaaSamples();
     void InitializeMeshShaderExtension();
+    // gl_Layer desde el vertex shader (VK_EXT_shader_viewport_index_layer)
+    bool IsShaderOutputLayerSupported() const { return shaderOutputLayer_supported; }
 private:
     bool isDeviceSuitable(VkPhysicalDevice newDevice, VkSurfaceKHR& surface);
     VkSampleCountFlagBits getMaxUsableSampleCount();
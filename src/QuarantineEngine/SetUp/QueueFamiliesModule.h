@@ -11,6 +11,8 @@ struct QueueFamilyIndices {
     std::optional<uint32_t> graphicsFamily;
     std::optional<uint32_t> presentFamily;
     std::optional<uint32_t> computeFamily;
+    // Familia solo de transferencia (DMA); opcional, sin ella las subidas van por graphicsFamily
+    std::optional<uint32_t> transferFamily;
 
     bool isComplete()
     {
@@ -41,8 +43,16 @@ struct QueueFamilyIndices {
                 indices.computeFamily = i;
             }
 
+            // Modo headless (sin surface): no se presenta, la cola de graficos hace de present
             VkBool32 presentSupport = false;
-            vkGetPhysicalDeviceSurfaceSupportKHR(device, i, surface, &presentSupport);
+            if (surface == VK_NULL_HANDLE)
+            {
+                presentSupport = (queueFamily.queueFlags & VK_QUEUE_GRAPHICS_BIT) ? VK_TRUE : VK_FALSE;
+            }
+            else
+            {
+                vkGetPhysicalDeviceSurfaceSupportKHR(device, i, surface, &presentSupport);
+            }
 
             if (presentSupport) {
                 indices.presentFamily = i;
@@ -56,6 +66,16 @@ struct QueueFamilyIndices {
             i++;
         }
 
+        for (uint32_t family = 0; family < queueFamilyCount; ++family)
+        {
+            const VkQueueFlags flags = queueFamilies[family].queueFlags;
+            if ((flags & VK_QUEUE_TRANSFER_BIT) && !(flags & (VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT)))
+            {
+                indices.transferFamily = family;
+                break;
+            }
+        }
+
         return indices;
     }
 };
@@ -11,6 +11,13 @@ public:
     VkQueue             graphicsQueue;
     VkQueue             presentQueue;
     VkQueue             computeQueue;
+    // computeQueue es una cola distinta de graphicsQueue (misma familia)
+    bool                asyncCompute = false;
+    // transferQueue es de una familia dedicada de transferencia; si no, es graphicsQueue
+    VkQueue             transferQueue;
+    bool                dedicatedTransfer = false;
+    uint32_t            graphicsFamily = 0;
+    uint32_t            transferFamily = 0;
 public:
     static QueueModule* getInstance();
     static void ResetInstance();
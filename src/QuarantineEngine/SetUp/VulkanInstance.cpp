@@ -1,8 +1,8 @@
 #include "VulkanInstance.h"
 
-VkResult VulkanInstance::createInstance()
+VkResult VulkanInstance::createInstance(bool headless)
 {
-    if (!glfwVulkanSupported())
+    if (!headless && !glfwVulkanSupported())
     {
         printf("GLFW: Vulkan Not Supported\n");
         return VK_ERROR_INITIALIZATION_FAILED;
@@ -31,8 +31,10 @@ VkResult VulkanInstance::createInstance()
 
     auto extensions = getRequiredExtensions();
 
-    createInfo.enabledExtensionCount = static_cast<uint32_t>(instanceExtensions.size());
-    createInfo.ppEnabledExtensionNames = instanceExtensions.data();
+    // Sin ventana no se crea surface: basta con las extensiones que no son de WSI
+    const std::vector<const char*>& enabledExtensions = headless ? headlessInstanceExtensions : instanceExtensions;
+    createInfo.enabledExtensionCount = static_cast<uint32_t>(enabledExtensions.size());
+    createInfo.ppEnabledExtensionNames = enabledExtensions.data();
 
 
     VkDebugUtilsMessengerCreateInfoEXT debugCreateInfo;
@@ -14,7 +14,7 @@ public:
     DEBUG_LEVEL debug_level;
 
 public:
-    VkResult createInstance();
+    VkResult createInstance(bool headless = false);
     void destroyInstance();
     VkInstance& getInstance();
 };
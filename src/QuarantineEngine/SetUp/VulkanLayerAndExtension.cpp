@@ -42,7 +42,7 @@ bool checkValidationLayerSupport()
     return true;
 }
 
-bool checkDeviceExtensionSupport(VkPhysicalDevice device)
+bool checkDeviceExtensionSupport(VkPhysicalDevice device, bool requireSwapchain)
 {
     uint32_t extensionCount;
     vkEnumerateDeviceExtensionProperties(device, nullptr, &extensionCount, nullptr);
@@ -51,6 +51,10 @@ bool checkDeviceExtensionSupport(VkPhysicalDevice device)
     vkEnumerateDeviceExtensionProperties(device, nullptr, &extensionCount, availableExtensions.data());
 
     std::set<std::string> requiredExtensions(deviceExtensions.begin(), deviceExtensions.end());
+    if (!requireSwapchain)
+    {
+        requiredExtensions.erase(VK_KHR_SWAPCHAIN_EXTENSION_NAME);
+    }
 
     for (const auto& extension : availableExtensions) {
         requiredExtensions.erase(extension.extensionName);
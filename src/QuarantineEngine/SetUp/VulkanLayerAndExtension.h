@@ -48,8 +48,13 @@ const std::vector<const char*> instanceExtensions = {
     VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME
 };
 
+const std::vector<const char*> headlessInstanceExtensions = {
+    VK_EXT_DEBUG_UTILS_EXTENSION_NAME,
+    VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME
+};
+
 bool checkValidationLayerSupport();
-bool checkDeviceExtensionSupport(VkPhysicalDevice device);
+bool checkDeviceExtensionSupport(VkPhysicalDevice device, bool requireSwapchain = true);
 std::vector<const char*> getRequiredExtensions();
 void populateDebugMessengerCreateInfo(VkDebugUtilsMessengerCreateInfoEXT& createInfo, DEBUG_LEVEL level);
 
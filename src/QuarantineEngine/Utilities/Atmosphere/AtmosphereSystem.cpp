@@ -649,8 +649,6 @@ void AtmosphereSystem::Cleanup()
     if (!this->deviceModule || this->deviceModule->device == VK_NULL_HANDLE)
         return;
 
-    vkDeviceWaitIdle(this->deviceModule->device);
-
     this->ResourcesReady = false;
 
     if (_Mesh != nullptr)
@@ -676,11 +674,7 @@ void AtmosphereSystem::Cleanup()
         this->descriptorSets.clear();
     }
 
-    if (this->descriptorPool != VK_NULL_HANDLE)
-    {
-        vkDestroyDescriptorPool(deviceModule->device, this->descriptorPool, nullptr);
-        this->descriptorPool = VK_NULL_HANDLE;
-    }
+    QE_DEFER_DESTROY(deviceModule->device, this->descriptorPool, vkDestroyDescriptorPool, "AtmosphereSystem::Cleanup");
 
     if (this->resolutionUBO != nullptr)
     {
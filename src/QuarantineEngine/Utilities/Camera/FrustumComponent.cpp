@@ -100,3 +100,19 @@ bool FrustumComponent::isAABBInside(AABBObject& box)
 
     return true;
 }
+
+bool FrustumComponent::isSphereInside(const glm::vec3& center, float radius) const
+{
+    for (int i = 0; i < 6; i++)
+    {
+        const glm::vec3 normal = glm::vec3(this->frustumPlanes[i]);
+        const float length = glm::length(normal);
+        if (length <= 0.0f)
+            continue;
+
+        if ((glm::dot(normal, center) + this->frustumPlanes[i].w) / length < -radius)
+            return false;
+    }
+
+    return true;
+}
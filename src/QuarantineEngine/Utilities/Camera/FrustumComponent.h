@@ -22,6 +22,7 @@ public:
     FrustumComponent();
     void RecreateFrustum(glm::mat4 viewProjection);
     bool isAABBInside(AABBObject& box);
+    bool isSphereInside(const glm::vec3& center, float radius) const;
     bool IsComputeCullingActive();
     void ActivateComputeCulling(bool value);
 };
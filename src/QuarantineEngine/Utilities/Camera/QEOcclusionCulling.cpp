@@ -0,0 +1,260 @@
+#include "QEOcclusionCulling.h"
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <limits>
+#include <GameObjectManager.h>
+#include <QEGeometryComponent.h>
+#include <QEAnimationComponent.h>
+#include <QEMeshBVH.h>
+#include <QETransform.h>
+#include <RenderQueue.h>
+
+namespace
+{
+    void TransformAABB(const glm::vec3& localMin, const glm::vec3& localMax, const glm::mat4& matrix, glm::vec3& outMin, glm::vec3& outMax)
+    {
+        outMin = glm::vec3(std::numeric_limits<float>::max());
+        outMax = glm::vec3(-std::numeric_limits<float>::max());
+
+        for (uint32_t corner = 0; corner < 8; ++corner)
+        {
+            const glm::vec3 local(
+                (corner & 1) ? localMax.x : localMin.x,
+                (corner & 2) ? localMax.y : localMin.y,
+                (corner & 4) ? localMax.z : localMin.z);
+            const glm::vec3 world = glm::vec3(matrix * glm::vec4(local, 1.0f));
+            outMin = glm::min(outMin, world);
+            outMax = glm::max(outMax, world);
+        }
+    }
+
+    // Planos laterales y lejano de la matriz (validos para proyeccion [0,1] y [-1,1])
+    bool IsAABBInsideSidePlanes(const glm::mat4& viewProjection, const glm::vec3& worldMin, const glm::vec3& worldMax)
+    {
+        const glm::mat4 rows = glm::transpose(viewProjection);
+        const glm::vec4 planes[5] = {
+            rows[3] + rows[0],
+            rows[3] - rows[0],
+            rows[3] + rows[1],
+            rows[3] - rows[1],
+            rows[3] - rows[2]
+        };
+
+        for (const glm::vec4& plane : planes)
+        {
+            const glm::vec3 positive(
+                plane.x >= 0.0f ? worldMax.x : worldMin.x,
+                plane.y >= 0.0f ? worldMax.y : worldMin.y,
+                plane.z >= 0.0f ? worldMax.z : worldMin.z);
+
+            if (glm::dot(glm::vec3(plane), positive) + plane.w < 0.0f)
+                return false;
+        }
+
+        return true;
+    }
+
+    uint64_t InstanceKey(const std::string& gameObjectId, uint32_t subMeshIndex)
+    {
+        return std::hash<std::string>{}(gameObjectId) ^ (static_cast<uint64_t>(subMeshIndex) * 0x9E3779B97F4A7C15ull);
+    }
+}
+
+void QEOcclusionCulling::BuildCandidates(const glm::mat4& viewProjection, const std::vector<QEOrderRenderItem>& items)
+{
+    _candidates.assign(items.size(), Candidate{});
+
+    for (size_t i = 0; i < items.size(); ++i)
+    {
+        const QEOrderRenderItem& item = items[i];
+        Candidate& candidate = _candidates[i];
+
+        if (!item.GameObject || !item.Material)
+            continue;
+
+        // Fondo, UI, debug y editor se pintan siempre
+        if (item.RenderQueue < static_cast<unsigned int>(RenderQueue::Geometry) ||
+            item.RenderQueue >= static_cast<unsigned int>(RenderQueue::UI))
+            continue;
+
+        auto transform = item.GameObject->GetComponent<QETransform>();
+        auto geometry = item.GameObject->GetComponent<QEGeometryComponent>();
+        const QEMesh* mesh = geometry ? geometry->GetMesh() : nullptr;
+        if (!transform || !mesh || item.SubMeshIndex >= mesh->MeshData.size())
+            continue;
+
+        // El AABB del bind pose no acota la pose animada
+        if (item.GameObject->GetComponent<QEAnimationComponent>() != nullptr)
+            continue;
+
+        const QEMeshData& subMesh = mesh->MeshData[item.SubMeshIndex];
+
+        candidate.Key = InstanceKey(item.GameObject->ID(), item.SubMeshIndex);
+        candidate.SubMesh = &subMesh;
+        candidate.LocalToWorld = transform->GetWorldMatrix() * subMesh.ModelTransform;
+        candidate.Triangles = QEMeshBVH::GetTriangleCount(subMesh);
+        candidate.CameraDistanceSq = item.CameraDistanceSq;
+        candidate.Cullable = true;
+
+        TransformAABB(subMesh.BoundingBox.first, subMesh.BoundingBox.second, candidate.LocalToWorld, candidate.WorldMin, candidate.WorldMax);
+        candidate.InFrustum = IsAABBInsideSidePlanes(viewProjection, candidate.WorldMin, candidate.WorldMax);
+
+        // Solo geometria opaca sin alpha test tapa lo que hay detras
+        candidate.Occluder =
+            item.RenderQueue < static_cast<unsigned int>(RenderQueue::Transparent) &&
+            item.Material->materialData.AlphaMode == 0 &&
+            candidate.Triangles > 0 &&
+            candidate.Triangles <= MaxTrianglesPerOccluder;
+
+        auto history = _visibleLastFrame.find(candidate.Key);
+        candidate.VisibleLastFrame = (history == _visibleLastFrame.end()) || history->second;
+    }
+}
+
+void QEOcclusionCulling::RasterizeOccluder(const Candidate& candidate, const glm::mat4& viewProjection)
+{
+    const QEMeshData& subMesh = *candidate.SubMesh;
+    const glm::mat4 mvp = viewProjection * candidate.LocalToWorld;
+
+    _clipVertices.resize(subMesh.Vertices.size());
+    for (size_t v = 0; v < subMesh.Vertices.size(); ++v)
+    {
+        _clipVertices[v] = mvp * glm::vec4(glm::vec3(subMesh.Vertices[v].Position), 1.0f);
+    }
+
+    const size_t vertexCount = _clipVertices.size();
+    for (uint32_t tri = 0; tri < candidate.Triangles; ++tri)
+    {
+        size_t i0 = tri * 3 + 0;
+        size_t i1 = tri * 3 + 1;
+        size_t i2 = tri * 3 + 2;
+
+        if (!subMesh.Indices.empty())
+        {
+            i0 = subMesh.Indices[i0];
+            i1 = subMesh.Indices[i1];
+            i2 = subMesh.Indices[i2];
+        }
+
+        if (i0 >= vertexCount || i1 >= vertexCount || i2 >= vertexCount)
+            continue;
+
+        _buffer.RasterizeTriangle(_clipVertices[i0], _clipVertices[i1], _clipVertices[i2]);
+    }
+}
+
+void QEOcclusionCulling::Cull(const glm::mat4& viewProjection, const std::vector<QEOrderRenderItem>& items, std::vector<uint8_t>& outVisible)
+{
+    outVisible.assign(items.size(), 1);
+    _stats = {};
+
+    if (!Enabled)
+    {
+        _visibleLastFrame.clear();
+        return;
+    }
+
+    const auto start = std::chrono::high_resolution_clock::now();
+
+    BuildCandidates(viewProjection, items);
+
+    _buffer.Resize(BufferWidth, BufferHeight);
+    _buffer.Clear();
+
+    // Fase 1: lo visible el frame anterior se dibuja; sus oclusores, de mas cercano a mas lejano,
+    // hasta agotar el presupuesto
+    _occluderOrder.clear();
+    for (uint32_t i = 0; i < _candidates.size(); ++i)
+    {
+        const Candidate& candidate = _candidates[i];
+        if (!candidate.Cullable || !candidate.InFrustum || !candidate.VisibleLastFrame)
+            continue;
+
+        ++_stats.Phase1Instances;
+        if (candidate.Occluder)
+        {
+            _occluderOrder.push_back(i);
+        }
+    }
+
+    std::sort(_occluderOrder.begin(), _occluderOrder.end(), [this](uint32_t a, uint32_t b)
+        {
+            return _candidates[a].CameraDistanceSq < _candidates[b].CameraDistanceSq;
+        });
+
+    uint64_t triangleBudget = MaxOccluderTriangles;
+    for (uint32_t index : _occluderOrder)
+    {
+        const Candidate& candidate = _candidates[index];
+        if (candidate.Triangles > triangleBudget)
+            continue;
+
+        RasterizeOccluder(candidate, viewProjection);
+        triangleBudget -= candidate.Triangles;
+        ++_stats.Occluders;
+        _stats.OccluderTriangles += candidate.Triangles;
+    }
+
+    _buffer.BuildHiZ();
+
+    // Fase 2: lo rechazado el frame anterior se vuelve a probar contra la piramide de la fase 1
+    std::unordered_map<uint64_t, bool> visibleThisFrame;
+    visibleThisFrame.reserve(_candidates.size());
+
+    for (size_t i = 0; i < _candidates.size(); ++i)
+    {
+        const Candidate& candidate = _candidates[i];
+        if (!candidate.Cullable)
+            continue;
+
+        if (!candidate.InFrustum)
+        {
+            // El frustum ya lo descarta la GPU; no cuenta como oclusion ni ensucia el historial
+            visibleThisFrame[candidate.Key] = true;
+            continue;
+        }
+
+        ++_stats.TestedInstances;
+        _stats.TestedTriangles += candidate.Triangles;
+
+        const bool occluded = _buffer.IsAABBOccluded(candidate.WorldMin, candidate.WorldMax, viewProjection);
+        if (candidate.VisibleLastFrame)
+        {
+            // Ya dibujada en la fase 1: la prueba solo decide el frame siguiente
+            if (occluded)
+                ++_stats.HiddenNextFrame;
+        }
+        else
+        {
+            ++_stats.Phase2Instances;
+            if (occluded)
+            {
+                outVisible[i] = 0;
+                ++_stats.CulledInstances;
+                _stats.CulledTriangles += candidate.Triangles;
+            }
+            else
+            {
+                ++_stats.Phase2Recovered;
+            }
+        }
+
+        visibleThisFrame[candidate.Key] = !occluded;
+    }
+
+    // Lo que ya no esta en la escena desaparece del historial
+    _visibleLastFrame.swap(visibleThisFrame);
+
+    const auto end = std::chrono::high_resolution_clock::now();
+    _stats.CullMs = std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+void QEOcclusionCulling::ResetSceneState()
+{
+    _visibleLastFrame.clear();
+    _candidates.clear();
+    _occluderOrder.clear();
+    _clipVertices.clear();
+    _stats = {};
+}
@@ -0,0 +1,101 @@
+#pragma once
+
+#ifndef QE_OCCLUSION_CULLING_H
+#define QE_OCCLUSION_CULLING_H
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include <glm/glm.hpp>
+#include <QESingleton.h>
+#include <QESoftwareOcclusionBuffer.h>
+
+struct QEOrderRenderItem;
+struct QEMeshData;
+
+struct QEOcclusionFrameStats
+{
+    uint32_t TestedInstances = 0;       // Dentro del frustum y aptas para ocultarse
+    uint32_t CulledInstances = 0;       // No se dibujan este frame
+    uint64_t TestedTriangles = 0;
+    uint64_t CulledTriangles = 0;
+    uint32_t Phase1Instances = 0;       // Visibles el frame anterior: se dibujan sin prueba
+    uint32_t Phase2Instances = 0;       // Rechazadas el frame anterior: se vuelven a probar
+    uint32_t Phase2Recovered = 0;       // De las anteriores, las que vuelven a verse
+    uint32_t HiddenNextFrame = 0;       // De la fase 1, las que se dejaran de dibujar el frame siguiente
+    uint32_t Occluders = 0;
+    uint64_t OccluderTriangles = 0;
+    double CullMs = 0.0;
+};
+
+/// Occlusion culling de instancias de la vista principal en dos fases, en CPU.
+/// Fase 1: las instancias visibles el frame anterior se dibujan sin prueba de oclusion y las opacas
+/// se rasterizan como oclusores (mas cercanas primero, con un presupuesto de triangulos) en un buffer
+/// de profundidad de baja resolucion con la camara actual, que se reduce a una piramide Hi-Z.
+/// Fase 2: solo las rechazadas el frame anterior se vuelven a probar contra esa piramide; las que
+/// pasan se dibujan ya. Las de la fase 1 tambien se prueban, pero solo para el historial: una
+/// instancia que queda tapada se deja de dibujar el frame siguiente.
+/// Es la variante por software del esquema; no hay piramide construida en GPU a partir de la
+/// profundidad reproyectada del frame anterior ni draws indirectos (el renderer graba draws directos).
+/// Las instancias animadas nunca se ocultan ni ocultan.
+class QEOcclusionCulling : public QESingleton<QEOcclusionCulling>
+{
+private:
+    friend class QESingleton<QEOcclusionCulling>;
+
+    struct Candidate
+    {
+        uint64_t Key = 0;
+        const QEMeshData* SubMesh = nullptr;
+        glm::mat4 LocalToWorld = glm::mat4(1.0f);
+        glm::vec3 WorldMin = glm::vec3(0.0f);
+        glm::vec3 WorldMax = glm::vec3(0.0f);
+        uint32_t Triangles = 0;
+        float CameraDistanceSq = 0.0f;
+        bool Cullable = false;
+        bool Occluder = false;
+        bool InFrustum = true;
+        bool VisibleLastFrame = true;
+    };
+
+    QESoftwareOcclusionBuffer _buffer;
+    std::unordered_map<uint64_t, bool> _visibleLastFrame;
+    std::vector<Candidate> _candidates;
+    std::vector<uint32_t> _occluderOrder;
+    std::vector<glm::vec4> _clipVertices;
+    QEOcclusionFrameStats _stats;
+
+public:
+    bool Enabled = true;
+    uint32_t BufferWidth = 256;
+    uint32_t BufferHeight = 128;
+    /// Triangulos de oclusores rasterizados por frame como maximo.
+    uint32_t MaxOccluderTriangles = 150000;
+    /// Las mallas mas densas no se rasterizan (cuestan mas de lo que ocultan).
+    uint32_t MaxTrianglesPerOccluder = 20000;
+
+private:
+    void BuildCandidates(const glm::mat4& viewProjection, const std::vector<QEOrderRenderItem>& items);
+    void RasterizeOccluder(const Candidate& candidate, const glm::mat4& viewProjection);
+
+public:
+    QEOcclusionCulling() = default;
+
+    /// outVisible[i] = 0 si items[i] queda oculto. Con Enabled a false todo es visible.
+    void Cull(const glm::mat4& viewProjection, const std::vector<QEOrderRenderItem>& items, std::vector<uint8_t>& outVisible);
+
+    void ResetSceneState();
+
+    const QEOcclusionFrameStats& GetFrameStats() const { return _stats; }
+    const QESoftwareOcclusionBuffer& GetOcclusionBuffer() const { return _buffer; }
+};
+
+
+
+namespace QE
+{
+    using ::QEOcclusionFrameStats;
+    using ::QEOcclusionCulling;
+} // namespace QE
+// QE namespace aliases
+#endif // !QE_OCCLUSION_CULLING_H
@@ -0,0 +1,289 @@
+#include "QESoftwareOcclusionBuffer.h"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    inline float EdgeFunction(const glm::vec3& a, const glm::vec3& b, float px, float py)
+    {
+        return (b.x - a.x) * (py - a.y) - (b.y - a.y) * (px - a.x);
+    }
+}
+
+void QESoftwareOcclusionBuffer::Resize(uint32_t width, uint32_t height)
+{
+    width = std::max(1u, width);
+    height = std::max(1u, height);
+
+    if (this->width == width && this->height == height && !mips.empty())
+        return;
+
+    this->width = width;
+    this->height = height;
+
+    mipSizes.clear();
+    glm::uvec2 size(width, height);
+    mipSizes.push_back(size);
+    while (size.x > 1 || size.y > 1)
+    {
+        size = glm::uvec2(std::max(1u, size.x / 2), std::max(1u, size.y / 2));
+        mipSizes.push_back(size);
+    }
+
+    mips.resize(mipSizes.size());
+    for (size_t mip = 0; mip < mips.size(); ++mip)
+    {
+        mips[mip].assign(static_cast<size_t>(mipSizes[mip].x) * mipSizes[mip].y, CLEAR_DEPTH);
+    }
+}
+
+void QESoftwareOcclusionBuffer::Clear()
+{
+    for (auto& mip : mips)
+    {
+        std::fill(mip.begin(), mip.end(), CLEAR_DEPTH);
+    }
+}
+
+glm::vec3 QESoftwareOcclusionBuffer::ToScreen(const glm::vec4& clip) const
+{
+    const float invW = 1.0f / clip.w;
+    return glm::vec3(
+        (clip.x * invW * 0.5f + 0.5f) * static_cast<float>(width),
+        (clip.y * invW * 0.5f + 0.5f) * static_cast<float>(height),
+        clip.z * invW);
+}
+
+void QESoftwareOcclusionBuffer::RasterizeTriangle(const glm::vec4& c0, const glm::vec4& c1, const glm::vec4& c2)
+{
+    if (mips.empty())
+        return;
+
+    const bool in0 = c0.w >= NEAR_W;
+    const bool in1 = c1.w >= NEAR_W;
+    const bool in2 = c2.w >= NEAR_W;
+
+    if (in0 && in1 && in2)
+    {
+        RasterizeClippedTriangle(c0, c1, c2);
+        return;
+    }
+
+    if (!in0 && !in1 && !in2)
+        return;
+
+    // Sutherland-Hodgman contra el plano w = NEAR_W: como mucho 4 vertices
+    const glm::vec4 input[3] = { c0, c1, c2 };
+    glm::vec4 output[4];
+    uint32_t outputCount = 0;
+
+    for (uint32_t i = 0; i < 3; ++i)
+    {
+        const glm::vec4& current = input[i];
+        const glm::vec4& next = input[(i + 1) % 3];
+        const bool currentIn = current.w >= NEAR_W;
+        const bool nextIn = next.w >= NEAR_W;
+
+        if (currentIn)
+        {
+            output[outputCount++] = current;
+        }
+
+        if (currentIn != nextIn)
+        {
+            const float t = (NEAR_W - current.w) / (next.w - current.w);
+            output[outputCount++] = current + (next - current) * t;
+        }
+    }
+
+    for (uint32_t i = 2; i < outputCount; ++i)
+    {
+        RasterizeClippedTriangle(output[0], output[i - 1], output[i]);
+    }
+}
+
+void QESoftwareOcclusionBuffer::RasterizeClippedTriangle(const glm::vec4& c0, const glm::vec4& c1, const glm::vec4& c2)
+{
+    glm::vec3 v0 = ToScreen(c0);
+    glm::vec3 v1 = ToScreen(c1);
+    glm::vec3 v2 = ToScreen(c2);
+
+    float area = EdgeFunction(v0, v1, v2.x, v2.y);
+    if (std::abs(area) < 1e-8f)
+        return;
+
+    // Sin culling de caras: se normaliza el orden para que el area sea positiva
+    if (area < 0.0f)
+    {
+        std::swap(v1, v2);
+        area = -area;
+    }
+
+    const float fw = static_cast<float>(width);
+    const float fh = static_cast<float>(height);
+    const float minSX = std::clamp(std::min({ v0.x, v1.x, v2.x }), -1.0f, fw + 1.0f);
+    const float maxSX = std::clamp(std::max({ v0.x, v1.x, v2.x }), -1.0f, fw + 1.0f);
+    const float minSY = std::clamp(std::min({ v0.y, v1.y, v2.y }), -1.0f, fh + 1.0f);
+    const float maxSY = std::clamp(std::max({ v0.y, v1.y, v2.y }), -1.0f, fh + 1.0f);
+
+    const int32_t startX = std::max(0, static_cast<int32_t>(std::ceil(minSX - 0.5f)));
+    const int32_t endX = std::min(static_cast<int32_t>(width) - 1, static_cast<int32_t>(std::floor(maxSX - 0.5f)));
+    const int32_t startY = std::max(0, static_cast<int32_t>(std::ceil(minSY - 0.5f)));
+    const int32_t endY = std::min(static_cast<int32_t>(height) - 1, static_cast<int32_t>(std::floor(maxSY - 0.5f)));
+
+    if (startX > endX || startY > endY)
+        return;
+
+    // Incrementos de las funciones de arista por pixel en x e y
+    const float stepX0 = -(v2.y - v1.y), stepY0 = v2.x - v1.x;
+    const float stepX1 = -(v0.y - v2.y), stepY1 = v0.x - v2.x;
+    const float stepX2 = -(v1.y - v0.y), stepY2 = v1.x - v0.x;
+
+    const float invArea = 1.0f / area;
+    std::vector<float>& depth = mips[0];
+
+    const float px = static_cast<float>(startX) + 0.5f;
+    float rowW0 = EdgeFunction(v1, v2, px, static_cast<float>(startY) + 0.5f);
+    float rowW1 = EdgeFunction(v2, v0, px, static_cast<float>(startY) + 0.5f);
+    float rowW2 = EdgeFunction(v0, v1, px, static_cast<float>(startY) + 0.5f);
+
+    for (int32_t y = startY; y <= endY; ++y)
+    {
+        float w0 = rowW0;
+        float w1 = rowW1;
+        float w2 = rowW2;
+        float* row = depth.data() + static_cast<size_t>(y) * width;
+
+        for (int32_t x = startX; x <= endX; ++x)
+        {
+            if (w0 >= 0.0f && w1 >= 0.0f && w2 >= 0.0f)
+            {
+                // z/w es lineal en pantalla: interpolacion baricentrica directa
+                const float z = (w0 * v0.z + w1 * v1.z + w2 * v2.z) * invArea;
+                if (z < row[x])
+                {
+                    row[x] = z;
+                }
+            }
+
+            w0 += stepX0;
+            w1 += stepX1;
+            w2 += stepX2;
+        }
+
+        rowW0 += stepY0;
+        rowW1 += stepY1;
+        rowW2 += stepY2;
+    }
+}
+
+void QESoftwareOcclusionBuffer::BuildHiZ()
+{
+    for (size_t mip = 1; mip < mips.size(); ++mip)
+    {
+        const glm::uvec2 source = mipSizes[mip - 1];
+        const glm::uvec2 target = mipSizes[mip];
+        const std::vector<float>& src = mips[mip - 1];
+        std::vector<float>& dst = mips[mip];
+
+        for (uint32_t y = 0; y < target.y; ++y)
+        {
+            // El ultimo texel absorbe la fila/columna sobrante de un tamano impar
+            const uint32_t y0 = std::min(y * 2, source.y - 1);
+            const uint32_t y1 = (y + 1 == target.y) ? source.y - 1 : std::min(y * 2 + 1, source.y - 1);
+
+            for (uint32_t x = 0; x < target.x; ++x)
+            {
+                const uint32_t x0 = std::min(x * 2, source.x - 1);
+                const uint32_t x1 = (x + 1 == target.x) ? source.x - 1 : std::min(x * 2 + 1, source.x - 1);
+
+                float farthest = 0.0f;
+                bool first = true;
+                for (uint32_t sy = y0; sy <= y1; ++sy)
+                {
+                    for (uint32_t sx = x0; sx <= x1; ++sx)
+                    {
+                        const float value = src[static_cast<size_t>(sy) * source.x + sx];
+                        farthest = first ? value : std::max(farthest, value);
+                        first = false;
+                    }
+                }
+
+                dst[static_cast<size_t>(y) * target.x + x] = farthest;
+            }
+        }
+    }
+}
+
+bool QESoftwareOcclusionBuffer::IsAABBOccluded(const glm::vec3& worldMin, const glm::vec3& worldMax, const glm::mat4& viewProjection) const
+{
+    if (mips.empty())
+        return false;
+
+    float minSX = CLEAR_DEPTH, minSY = CLEAR_DEPTH;
+    float maxSX = -CLEAR_DEPTH, maxSY = -CLEAR_DEPTH;
+    float nearestDepth = CLEAR_DEPTH;
+
+    for (uint32_t corner = 0; corner < 8; ++corner)
+    {
+        const glm::vec4 world(
+            (corner & 1) ? worldMax.x : worldMin.x,
+            (corner & 2) ? worldMax.y : worldMin.y,
+            (corner & 4) ? worldMax.z : worldMin.z,
+            1.0f);
+
+        const glm::vec4 clip = viewProjection * world;
+        if (clip.w < NEAR_W)
+            return false;
+
+        const glm::vec3 screen = ToScreen(clip);
+        minSX = std::min(minSX, screen.x);
+        minSY = std::min(minSY, screen.y);
+        maxSX = std::max(maxSX, screen.x);
+        maxSY = std::max(maxSY, screen.y);
+        nearestDepth = std::min(nearestDepth, screen.z);
+    }
+
+    // Fuera de pantalla: es trabajo del frustum culling, no se decide aqui
+    if (maxSX < 0.0f || maxSY < 0.0f || minSX >= static_cast<float>(width) || minSY >= static_cast<float>(height))
+        return false;
+
+    const int32_t minX = std::max(0, static_cast<int32_t>(std::floor(minSX)));
+    const int32_t minY = std::max(0, static_cast<int32_t>(std::floor(minSY)));
+    const int32_t maxX = std::min(static_cast<int32_t>(width) - 1, static_cast<int32_t>(std::floor(maxSX)));
+    const int32_t maxY = std::min(static_cast<int32_t>(height) - 1, static_cast<int32_t>(std::floor(maxSY)));
+
+    return IsRectOccluded(minX, minY, maxX, maxY, nearestDepth);
+}
+
+bool QESoftwareOcclusionBuffer::IsRectOccluded(int32_t minX, int32_t minY, int32_t maxX, int32_t maxY, float nearestDepth) const
+{
+    if (mips.empty() || minX > maxX || minY > maxY)
+        return false;
+
+    // Nivel mas fino en el que el rectangulo cubre como mucho 4x4 texels
+    uint32_t mip = 0;
+    while (mip + 1 < mips.size() &&
+        (((maxX >> mip) - (minX >> mip)) >= 4 || ((maxY >> mip) - (minY >> mip)) >= 4))
+    {
+        ++mip;
+    }
+
+    const glm::uvec2 size = mipSizes[mip];
+    const uint32_t tx0 = std::min(static_cast<uint32_t>(minX >> mip), size.x - 1);
+    const uint32_t tx1 = std::min(static_cast<uint32_t>(maxX >> mip), size.x - 1);
+    const uint32_t ty0 = std::min(static_cast<uint32_t>(minY >> mip), size.y - 1);
+    const uint32_t ty1 = std::min(static_cast<uint32_t>(maxY >> mip), size.y - 1);
+
+    const std::vector<float>& level = mips[mip];
+    for (uint32_t y = ty0; y <= ty1; ++y)
+    {
+        for (uint32_t x = tx0; x <= tx1; ++x)
+        {
+            if (level[static_cast<size_t>(y) * size.x + x] >= nearestDepth)
+                return false;
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#ifndef QE_SOFTWARE_OCCLUSION_BUFFER_H
+#define QE_SOFTWARE_OCCLUSION_BUFFER_H
+
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+
+/// Buffer de profundidad de baja resolucion rasterizado en CPU y su piramide Hi-Z.
+/// La profundidad es z/w del clip space de la camara (menor = mas cerca); el convenio exacto de
+/// la proyeccion da igual mientras oclusores y pruebas usen la misma matriz. Cada texel de la
+/// piramide guarda la profundidad maxima (la mas lejana) de los texels que cubre, asi una prueba
+/// contra un nivel grueso nunca oculta algo que el nivel 0 veria.
+class QESoftwareOcclusionBuffer
+{
+private:
+    uint32_t width = 0;
+    uint32_t height = 0;
+    std::vector<std::vector<float>> mips;       // mips[0] = buffer rasterizado
+    std::vector<glm::uvec2> mipSizes;
+
+private:
+    void RasterizeClippedTriangle(const glm::vec4& c0, const glm::vec4& c1, const glm::vec4& c2);
+    glm::vec3 ToScreen(const glm::vec4& clip) const;
+
+public:
+    /// Por debajo de esta w el punto se considera en el plano del ojo o detras.
+    static constexpr float NEAR_W = 1e-4f;
+    static constexpr float CLEAR_DEPTH = 3.402823466e+38f;
+
+    QESoftwareOcclusionBuffer() = default;
+
+    void Resize(uint32_t width, uint32_t height);
+    void Clear();
+
+    /// Triangulo en clip space. Se recorta contra w = NEAR_W y se rasteriza por centros de pixel
+    /// con test LESS, sin culling de caras.
+    void RasterizeTriangle(const glm::vec4& c0, const glm::vec4& c1, const glm::vec4& c2);
+
+    /// Reduce mips[0] a la piramide completa (max de 2x2, absorbiendo la fila/columna impar).
+    void BuildHiZ();
+
+    /// true si la caja en mundo queda por completo detras de la profundidad ya rasterizada.
+    /// Cajas que cruzan el plano cercano o quedan fuera de pantalla nunca se dan por ocultas.
+    bool IsAABBOccluded(const glm::vec3& worldMin, const glm::vec3& worldMax, const glm::mat4& viewProjection) const;
+    /// Misma prueba con el rectangulo ya proyectado (pixeles de nivel 0, extremos inclusivos).
+    bool IsRectOccluded(int32_t minX, int32_t minY, int32_t maxX, int32_t maxY, float nearestDepth) const;
+
+    uint32_t GetWidth() const { return width; }
+    uint32_t GetHeight() const { return height; }
+    uint32_t GetMipCount() const { return static_cast<uint32_t>(mips.size()); }
+    glm::uvec2 GetMipSize(uint32_t mip) const { return mipSizes[mip]; }
+    float GetDepth(uint32_t mip, uint32_t x, uint32_t y) const { return mips[mip][y * mipSizes[mip].x + x]; }
+    const std::vector<float>& GetMipData(uint32_t mip) const { return mips[mip]; }
+};
+
+
+
+namespace QE
+{
+    using ::QESoftwareOcclusionBuffer;
+} // namespace QE
+// QE namespace aliases
+#endif // !QE_SOFTWARE_OCCLUSION_BUFFER_H
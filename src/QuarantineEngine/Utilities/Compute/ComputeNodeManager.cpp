@@ -88,6 +88,17 @@ void ComputeNodeManager::RecordComputeNodes(VkCommandBuffer commandBuffer, uint3
     }
 }
 
+bool ComputeNodeManager::HasPendingOnDemandWork() const
+{
+    for (const auto& it : _computeNodes)
+    {
+        if (it.second && it.second->OnDemandCompute && it.second->Compute)
+            return true;
+    }
+
+    return false;
+}
+
 void ComputeNodeManager::Cleanup()
 {
     for (auto& node : _computeNodes)
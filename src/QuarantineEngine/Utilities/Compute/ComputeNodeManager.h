@@ -37,6 +37,8 @@ public:
     void EraseComputeNodesByPrefix(const std::string& prefix);
 
     void RecordComputeNodes(VkCommandBuffer commandBuffer, uint32_t currentFrame);
+    /// Hay nodos bajo demanda que se recalculan este frame (escriben recursos que no son por frame).
+    bool HasPendingOnDemandWork() const;
     void Cleanup();
     void CleanLastResources();
 };
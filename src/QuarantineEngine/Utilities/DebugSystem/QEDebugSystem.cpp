@@ -12,10 +12,9 @@ void QEDebugSystem::createVertexBuffer(VkDeviceSize requiredBytes)
     if (requiredBytes == 0)
         return;
 
-    // Si ya existe, destruir primero (ojo sincronizaci�n si est� en uso)
+    // Si ya existe, destruir primero (se libera cuando terminen los frames que lo usan)
     if (lineVertexMemory != VK_NULL_HANDLE)
     {
-        vkDeviceWaitIdle(deviceModule_ptr->device);
         QE_DESTROY_BUFFER(deviceModule_ptr->device, lineVertexBuffer, "QEDebugSystem::createVertexBuffer");
         QE_FREE_MEMORY(deviceModule_ptr->device, lineVertexMemory, "QEDebugSystem::createVertexBuffer");
         lineVertexBuffer = VK_NULL_HANDLE;
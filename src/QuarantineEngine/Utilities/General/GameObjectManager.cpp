@@ -3,6 +3,8 @@
 #include <GameObjectDto.h>
 #include <QEMeshRenderer.h>
 #include <unordered_set>
+#include <algorithm>
+#include <cmath>
 #include <LightManager.h>
 #include <Light.h>
 #include <PointLight.h>
@@ -12,6 +14,11 @@
 #include <QECamera.h>
 #include <QECameraContext.h>
 #include <QETransform.h>
+#include <QERaycastSystem.h>
+#include <QEOcclusionCulling.h>
+#include <QEMeshletCulling.h>
+#include <QETextureStreamer.h>
+#include <QEBindlessMaterials.h>
 
 namespace
 {
@@ -19,6 +26,87 @@ namespace
     {
         return gameObject && gameObject->Name == "QECameraEditor";
     }
+
+    // Se calcula una vez por submesh: los vertices no cambian despues de cargar
+    float GetUVDensity(QEMeshData& subMesh)
+    {
+        if (subMesh.UVDensity >= 0.0f)
+            return subMesh.UVDensity;
+
+        double uvArea = 0.0;
+        double area = 0.0;
+        const size_t indexCount = subMesh.Indices.empty() ? subMesh.Vertices.size() : subMesh.Indices.size();
+        for (size_t i = 0; i + 2 < indexCount; i += 3)
+        {
+            const size_t i0 = subMesh.Indices.empty() ? i : subMesh.Indices[i];
+            const size_t i1 = subMesh.Indices.empty() ? i + 1 : subMesh.Indices[i + 1];
+            const size_t i2 = subMesh.Indices.empty() ? i + 2 : subMesh.Indices[i + 2];
+            if (i0 >= subMesh.Vertices.size() || i1 >= subMesh.Vertices.size() || i2 >= subMesh.Vertices.size())
+                continue;
+
+            const Vertex& v0 = subMesh.Vertices[i0];
+            const Vertex& v1 = subMesh.Vertices[i1];
+            const Vertex& v2 = subMesh.Vertices[i2];
+
+            const glm::vec3 e1 = glm::vec3(v1.Position - v0.Position);
+            const glm::vec3 e2 = glm::vec3(v2.Position - v0.Position);
+            area += 0.5 * glm::length(glm::cross(e1, e2));
+
+            const glm::vec2 t1 = v1.UV - v0.UV;
+            const glm::vec2 t2 = v2.UV - v0.UV;
+            uvArea += 0.5 * std::abs(t1.x * t2.y - t1.y * t2.x);
+        }
+
+        subMesh.UVDensity = (area > 0.0) ? static_cast<float>(std::sqrt(uvArea / area)) : 0.0f;
+        return subMesh.UVDensity;
+    }
+
+    // UV por pixel en pantalla del submesh; con eso el streamer sabe que mip se llega a muestrear
+    void ReportTextureDemand(const QEOrderRenderItem& item, const QECamera& camera, QETextureStreamer* streamer)
+    {
+        const auto& textures = item.Material->materialData.texture_vector;
+        if (!textures)
+            return;
+
+        auto transform = item.GameObject->GetComponent<QETransform>();
+        auto geometry = item.GameObject->GetComponent<QEGeometryComponent>();
+        if (!transform || !geometry)
+            return;
+
+        QEMesh* mesh = geometry->GetMesh();
+        if (!mesh || item.SubMeshIndex >= mesh->MeshData.size())
+            return;
+
+        QEMeshData& subMesh = mesh->MeshData[item.SubMeshIndex];
+        const float uvDensity = GetUVDensity(subMesh);
+        if (uvDensity <= 0.0f)
+            return;
+
+        const glm::mat4 world = transform->GetWorldMatrix() * subMesh.ModelTransform;
+        const float scale = std::max({ glm::length(glm::vec3(world[0])), glm::length(glm::vec3(world[1])), glm::length(glm::vec3(world[2])) });
+        if (scale <= 0.0f)
+            return;
+
+        // Distancia a la esfera que envuelve la caja: la parte mas cercana es la que pide mas detalle
+        const glm::vec3 localCenter = (subMesh.BoundingBox.first + subMesh.BoundingBox.second) * 0.5f;
+        const float radius = glm::length(subMesh.BoundingBox.second - subMesh.BoundingBox.first) * 0.5f * scale;
+        const glm::vec3 center = glm::vec3(world * glm::vec4(localCenter, 1.0f));
+        const float nearPlane = std::max(camera.CameraData->Params.x, 0.001f);
+        const float distance = std::max(glm::length(glm::vec3(camera.CameraData->Position) - center) - radius, nearPlane);
+
+        const float pixelsPerWorldUnit = camera.Height * camera.CameraData->Projection[1][1] / (2.0f * distance);
+        if (pixelsPerWorldUnit <= 0.0f)
+            return;
+
+        const float uvPerPixel = (uvDensity / scale) / pixelsPerWorldUnit;
+        for (const auto& texture : *textures)
+        {
+            if (texture)
+            {
+                streamer->ReportUsage(texture.get(), uvPerPixel);
+            }
+        }
+    }
 }
 
 std::string GameObjectManager::CheckName(std::string nameGameObject)
@@ -65,6 +153,7 @@ void GameObjectManager::RegisterSingle(std::shared_ptr<QEGameObject> go, std::st
 
     const unsigned int bucket = DecideUpdateBucket(go, 0u);
     _objectsByUpdateOrder[bucket][name] = go;
+    QEGameObject::MarkStructureChanged();
 }
 
 void GameObjectManager::UnregisterSingle(const std::shared_ptr<QEGameObject>& go)
@@ -84,6 +173,8 @@ void GameObjectManager::UnregisterSingle(const std::shared_ptr<QEGameObject>& go
                 ++it;
         }
     }
+
+    QEGameObject::MarkStructureChanged();
 }
 
 void GameObjectManager::UnregisterHierarchy(const std::shared_ptr<QEGameObject>& go)
@@ -157,16 +248,12 @@ bool GameObjectManager::RemoveGameObject(const std::shared_ptr<QEGameObject>& ob
 
     // Scene editing can delete a hierarchy while its buffers are still
     // referenced by command buffers submitted in previous frames.
-    // For this editor-side path, synchronize before releasing GPU resources.
-    if (auto* deviceModule = DeviceModule::getInstance())
-    {
-        vkDeviceWaitIdle(deviceModule->device);
-    }
-
+    // Its GPU resources go through QEDeferredDeletionQueue, so no idle wait here.
     RemoveLightsFromHierarchy(object_ptr);
 
     DestroyHierarchy(object_ptr);
     UnregisterHierarchy(object_ptr);
+    PruneShadowRenderItems();
 
     ReindexLightShadowMaps();
 
@@ -191,25 +278,54 @@ bool GameObjectManager::SetGameObjectUpdateOrder(const std::shared_ptr<QEGameObj
 void GameObjectManager::DrawCommand(VkCommandBuffer& commandBuffer, uint32_t idx)
 {
     const auto renderItems = BuildRenderItems();
+    QEBindlessMaterials::getInstance()->BeginPass();
 
-    for (const auto& item : renderItems)
+    std::vector<uint8_t> visible;
+    auto activeCamera = QECameraContext::getInstance()->ActiveCamera();
+    if (activeCamera)
     {
+        QEOcclusionCulling::getInstance()->Cull(activeCamera->CameraData->ViewProjection, renderItems, visible);
+        QEMeshletCulling::getInstance()->BeginFrame(idx, activeCamera->CameraData.get(), activeCamera->Height);
+    }
+
+    auto* textureStreamer = QETextureStreamer::getInstance();
+    const bool reportDemand = activeCamera && textureStreamer->IsStreamingEnabled() && textureStreamer->Residency.Enabled;
+
+    for (size_t i = 0; i < renderItems.size(); ++i)
+    {
+        const auto& item = renderItems[i];
         if (!item.GameObject || !item.MeshRenderer || !item.Material)
             continue;
 
+        if (!visible.empty() && !visible[i])
+            continue;
+
+        if (reportDemand)
+        {
+            ReportTextureDemand(item, *activeCamera, textureStreamer);
+        }
+
         item.MeshRenderer->SetDrawCommand(commandBuffer, idx, item.SubMeshIndex);
     }
 }
 
-void GameObjectManager::CSMCommand(VkCommandBuffer& commandBuffer, uint32_t idx, VkPipelineLayout pipelineLayout, uint32_t cascadeIndex)
+void GameObjectManager::CSMCommand(VkCommandBuffer& commandBuffer, uint32_t idx, VkPipelineLayout pipelineLayout, uint32_t cascadeIndex, const std::vector<uint32_t>& casters, ShadowCasterLayer layer)
 {
-    const auto shadowItems = BuildShadowRenderItems();
+    const auto* shadowCacheManager = ShadowCacheManager::getInstance();
+    QEBindlessMaterials::getInstance()->BeginPass();
 
-    for (const auto& item : shadowItems)
+    for (uint32_t casterIdx : casters)
     {
+        if (casterIdx >= _shadowRenderItems.size())
+            continue;
+
+        const auto& item = _shadowRenderItems[casterIdx];
         if (!item.GameObject || !item.MeshRenderer || !item.Material)
             continue;
 
+        if (!shadowCacheManager->ShouldDrawCaster(item.GameObject->ID(), layer))
+            continue;
+
         auto transform = item.GameObject->GetComponent<QETransform>();
         if (!transform)
             continue;
@@ -217,6 +333,7 @@ void GameObjectManager::CSMCommand(VkCommandBuffer& commandBuffer, uint32_t idx,
         PushConstantCSMStruct shadowParameters = {};
         shadowParameters.model = transform->GetWorldMatrix();
         shadowParameters.cascadeIndex = cascadeIndex;
+        shadowParameters.materialIndex = item.Material->GetBindlessIndex();
 
         vkCmdPushConstants(
             commandBuffer,
@@ -230,25 +347,33 @@ void GameObjectManager::CSMCommand(VkCommandBuffer& commandBuffer, uint32_t idx,
     }
 }
 
-void GameObjectManager::OmniShadowCommand(VkCommandBuffer& commandBuffer, uint32_t idx, VkPipelineLayout pipelineLayout, glm::mat4 viewParameter, glm::vec3 lightPosition)
+void GameObjectManager::OmniShadowCommand(VkCommandBuffer& commandBuffer, uint32_t idx, VkPipelineLayout pipelineLayout, glm::mat4 viewParameter, glm::vec3 lightPosition, const std::vector<uint32_t>& casters, ShadowCasterLayer layer)
 {
-    const auto shadowItems = BuildShadowRenderItems();
+    const auto* shadowCacheManager = ShadowCacheManager::getInstance();
+    const glm::mat4 translationMatrix = glm::translate(glm::mat4(1.0f), -lightPosition);
+    QEBindlessMaterials::getInstance()->BeginPass();
 
-    for (const auto& item : shadowItems)
+    for (uint32_t casterIdx : casters)
     {
+        if (casterIdx >= _shadowRenderItems.size())
+            continue;
+
+        const auto& item = _shadowRenderItems[casterIdx];
         if (!item.GameObject || !item.MeshRenderer || !item.Material)
             continue;
 
+        if (!shadowCacheManager->ShouldDrawCaster(item.GameObject->ID(), layer))
+            continue;
+
         auto transform = item.GameObject->GetComponent<QETransform>();
         if (!transform)
             continue;
 
-        glm::mat4 translationMatrix = glm::translate(glm::mat4(1.0f), -lightPosition);
-
         PushConstantOmniShadowStruct shadowParameters = {};
         shadowParameters.lightModel = translationMatrix * transform->GetWorldMatrix();
         shadowParameters.model = transform->GetWorldMatrix();
         shadowParameters.view = viewParameter;
+        shadowParameters.materialIndex = item.Material->GetBindlessIndex();
 
         vkCmdPushConstants(
             commandBuffer,
@@ -262,8 +387,85 @@ void GameObjectManager::OmniShadowCommand(VkCommandBuffer& commandBuffer, uint32
     }
 }
 
+void GameObjectManager::OmniShadowLayeredCommand(VkCommandBuffer& commandBuffer, uint32_t idx, VkPipelineLayout pipelineLayout, glm::vec3 lightPosition, const std::vector<ShadowCasterFaceMask>& casters, uint32_t fullMask, uint32_t compositeMask)
+{
+    const auto* shadowCacheManager = ShadowCacheManager::getInstance();
+    const glm::mat4 translationMatrix = glm::translate(glm::mat4(1.0f), -lightPosition);
+    QEBindlessMaterials::getInstance()->BeginPass();
+
+    for (const auto& caster : casters)
+    {
+        if (caster.Caster >= _shadowRenderItems.size())
+            continue;
+
+        const auto& item = _shadowRenderItems[caster.Caster];
+        if (!item.GameObject || !item.MeshRenderer || !item.Material)
+            continue;
+
+        uint32_t faceMask = fullMask;
+        if (compositeMask != 0 && shadowCacheManager->ShouldDrawCaster(item.GameObject->ID(), ShadowCasterLayer::Dynamic))
+        {
+            faceMask |= compositeMask;
+        }
+        faceMask &= caster.FaceMask;
+
+        if (faceMask == 0)
+            continue;
+
+        auto transform = item.GameObject->GetComponent<QETransform>();
+        if (!transform)
+            continue;
+
+        PushConstantOmniShadowLayeredStruct shadowParameters = {};
+        shadowParameters.model = transform->GetWorldMatrix();
+        shadowParameters.lightModel = translationMatrix * shadowParameters.model;
+
+        uint32_t faceCount = 0;
+        uint32_t packedFaces = 0;
+        for (uint32_t faceIdx = 0; faceIdx < 6; ++faceIdx)
+        {
+            if (faceMask & (1u << faceIdx))
+            {
+                packedFaces |= faceIdx << (3u * faceCount);
+                ++faceCount;
+            }
+        }
+        shadowParameters.faces = glm::uvec4(faceCount, packedFaces, item.Material->GetBindlessIndex(), 0u);
+
+        vkCmdPushConstants(
+            commandBuffer,
+            pipelineLayout,
+            VK_SHADER_STAGE_ALL,
+            0,
+            sizeof(PushConstantOmniShadowLayeredStruct),
+            &shadowParameters);
+
+        item.MeshRenderer->SetDrawShadowCommand(commandBuffer, idx, pipelineLayout, item.SubMeshIndex, faceCount);
+    }
+}
+
+void GameObjectManager::RefreshShadowRenderItems()
+{
+    _shadowRenderItems = BuildShadowRenderItems();
+}
+
+void GameObjectManager::PruneShadowRenderItems()
+{
+    // Los objetos ya desregistrados no deben seguir dibujandose en los pases de sombra de este frame.
+    // Se vacian en sitio para no invalidar los indices de las listas de ShadowCasterCulling.
+    for (auto& item : _shadowRenderItems)
+    {
+        if (item.GameObject && GetGameObjectById(item.GameObject->ID()) == nullptr)
+        {
+            item = {};
+        }
+    }
+}
+
 void GameObjectManager::ReleaseAllGameObjects()
 {
+    _shadowRenderItems.clear();
+
     for (const auto& bucketPair : _objectsByUpdateOrder)
     {
         const auto& bucket = bucketPair.second;
@@ -281,6 +483,9 @@ void GameObjectManager::ReleaseAllGameObjects()
 void GameObjectManager::CleanLastResources()
 {
     _objectsByUpdateOrder.clear();
+    _shadowRenderItems.clear();
+    QERaycastSystem::getInstance()->ResetSceneState();
+    QEOcclusionCulling::getInstance()->ResetSceneState();
 }
 
 std::shared_ptr<QEGameObject> GameObjectManager::GetGameObject(const std::string& name) const
@@ -300,29 +505,9 @@ std::shared_ptr<QEGameObject> GameObjectManager::GetGameObject(const std::string
 YAML::Node GameObjectManager::SerializeGameObjects() const
 {
     YAML::Node gameObjectsNode;
-    std::unordered_set<std::string> emittedRoots;
-
-    for (const auto& bucketPair : _objectsByUpdateOrder)
+    for (const auto& go : GetSerializableRootGameObjects())
     {
-        const auto& bucket = bucketPair.second;
-
-        for (const auto& kv : bucket)
-        {
-            const auto& go = kv.second;
-            if (!go)
-                continue;
-
-            if (IsEditorOnlyGameObject(go))
-                continue;
-
-            if (go->GetParent() != nullptr)
-                continue;
-
-            if (!emittedRoots.insert(go->ID()).second)
-                continue;
-
-            gameObjectsNode.push_back(go->ToYaml());
-        }
+        gameObjectsNode.push_back(go->ToYaml());
     }
 
     return gameObjectsNode;
@@ -330,10 +515,27 @@ YAML::Node GameObjectManager::SerializeGameObjects() const
 
 void GameObjectManager::DeserializeGameObjects(YAML::Node gameObjects)
 {
+    std::vector<std::shared_ptr<QEGameObject>> roots;
     for (auto gameObjectData : gameObjects)
     {
-        std::shared_ptr<QEGameObject> root = QEGameObject::FromYaml(gameObjectData);
-        if (IsEditorOnlyGameObject(root))
+        roots.push_back(QEGameObject::FromYaml(gameObjectData));
+    }
+
+    AddSceneGameObjects(roots);
+}
+
+std::vector<std::shared_ptr<QEGameObject>> GameObjectManager::GetSerializableRootGameObjects() const
+{
+    std::vector<std::shared_ptr<QEGameObject>> roots = GetRootGameObjects();
+    roots.erase(std::remove_if(roots.begin(), roots.end(), IsEditorOnlyGameObject), roots.end());
+    return roots;
+}
+
+void GameObjectManager::AddSceneGameObjects(const std::vector<std::shared_ptr<QEGameObject>>& roots)
+{
+    for (const auto& root : roots)
+    {
+        if (!root || IsEditorOnlyGameObject(root))
             continue;
         AddGameObject(root);
     }
@@ -684,11 +886,6 @@ std::vector<QEOrderRenderItem> GameObjectManager::BuildShadowRenderItems() const
 
 void GameObjectManager::ResetSceneState()
 {
-    if (auto* deviceModule = DeviceModule::getInstance())
-    {
-        vkDeviceWaitIdle(deviceModule->device);
-    }
-
     ReleaseAllGameObjects();
     CleanLastResources();
 }
@@ -8,6 +8,8 @@
 #include "QEGameObject.h"
 #include "QEMeshRenderer.h"
 #include "QESingleton.h"
+#include <ShadowCacheManager.h>
+#include <ShadowCasterCulling.h>
 #include <vector>
 
 class QELight;
@@ -29,6 +31,7 @@ private:
     friend class QESingleton<GameObjectManager>;
 
     std::unordered_map<unsigned int, std::unordered_map<std::string, std::shared_ptr<QEGameObject>>> _objectsByUpdateOrder;
+    std::vector<QEOrderRenderItem> _shadowRenderItems;
 
 private:
     std::string CheckName(std::string nameGameObject);
@@ -44,6 +47,7 @@ private:
 
     std::vector<QEOrderRenderItem> BuildRenderItems() const;
     std::vector<QEOrderRenderItem> BuildShadowRenderItems() const;
+    void PruneShadowRenderItems();
 
 public:
     GameObjectManager() = default;
@@ -57,8 +61,15 @@ public:
 
     std::shared_ptr<QEGameObject> GetGameObject(const std::string& name) const;
     void DrawCommand(VkCommandBuffer& commandBuffer, uint32_t idx);
-    void CSMCommand(VkCommandBuffer& commandBuffer, uint32_t idx, VkPipelineLayout pipelineLayout, uint32_t cascadeIndex);
-    void OmniShadowCommand(VkCommandBuffer& commandBuffer, uint32_t idx, VkPipelineLayout pipelineLayout, glm::mat4 viewParameter, glm::vec3 lightPosition);
+    // casters: indices en GetShadowRenderItems() visibles desde la vista (ShadowCasterCulling)
+    void CSMCommand(VkCommandBuffer& commandBuffer, uint32_t idx, VkPipelineLayout pipelineLayout, uint32_t cascadeIndex, const std::vector<uint32_t>& casters, ShadowCasterLayer layer = ShadowCasterLayer::All);
+    void OmniShadowCommand(VkCommandBuffer& commandBuffer, uint32_t idx, VkPipelineLayout pipelineLayout, glm::mat4 viewParameter, glm::vec3 lightPosition, const std::vector<uint32_t>& casters, ShadowCasterLayer layer = ShadowCasterLayer::All);
+    // Un draw instanciado por caster: cada instancia escribe en una cara (gl_Layer).
+    // fullMask: caras con todos los casters; compositeMask: caras que solo reciben los dinamicos.
+    void OmniShadowLayeredCommand(VkCommandBuffer& commandBuffer, uint32_t idx, VkPipelineLayout pipelineLayout, glm::vec3 lightPosition, const std::vector<ShadowCasterFaceMask>& casters, uint32_t fullMask, uint32_t compositeMask);
+
+    void RefreshShadowRenderItems();
+    const std::vector<QEOrderRenderItem>& GetShadowRenderItems() const { return _shadowRenderItems; }
 
     void ResetSceneState();
     void ReleaseAllGameObjects();
@@ -66,6 +77,10 @@ public:
 
     YAML::Node SerializeGameObjects() const;
     void DeserializeGameObjects(YAML::Node gameObjects);
+    /// Raices que se guardan en la escena (sin los objetos del editor).
+    std::vector<std::shared_ptr<QEGameObject>> GetSerializableRootGameObjects() const;
+    /// Registra las raices ya decodificadas de una escena (YAML o binaria).
+    void AddSceneGameObjects(const std::vector<std::shared_ptr<QEGameObject>>& roots);
 
     void StartQEGameObjects();
     void UpdateQEGameObjects();
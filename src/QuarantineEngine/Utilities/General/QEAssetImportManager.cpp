@@ -29,13 +29,14 @@ QEAssetImportManager::~QEAssetImportManager()
     }
 }
 
-std::shared_ptr<QEImportJob> QEAssetImportManager::EnqueueMeshImport(const std::string& sourcePath, const std::string& targetFolder)
+std::shared_ptr<QEImportJob> QEAssetImportManager::EnqueueMeshImport(const std::string& sourcePath, const std::string& targetFolder, const QEMeshOptimizationSettings& optimization)
 {
     auto job = std::make_shared<QEImportJob>();
     job->Id = _nextId.fetch_add(1, std::memory_order_relaxed);
     job->Type = QEImportJobType::Mesh;
     job->SourcePath = sourcePath;
     job->TargetFolder = targetFolder;
+    job->MeshOptimization = optimization;
     job->DisplayName = std::filesystem::path(sourcePath).filename().string();
     job->State.store(QEImportJobState::Queued, std::memory_order_relaxed);
     job->SetProgress(0.0f, "Queued", "Waiting in queue");
@@ -201,7 +202,7 @@ void QEAssetImportManager::WorkerLoop()
 
             if (job->Type == QEImportJobType::Mesh)
             {
-                QEProjectManager::ImportMeshFile(job->SourcePath, job->TargetFolder, progressCb);
+                QEProjectManager::ImportMeshFile(job->SourcePath, job->TargetFolder, progressCb, job->MeshOptimization);
                 job->SetResultPath(job->SourcePath);
             }
             else if (job->Type == QEImportJobType::Shader)
@@ -10,6 +10,7 @@
 #include <mutex>
 #include <queue>
 #include <condition_variable>
+#include <QEMeshOptimizer.h>
 
 enum class QEImportJobState
 {
@@ -42,6 +43,7 @@ struct QEImportJob
     std::string SourcePath;
     std::string DisplayName;
     std::string TargetFolder;
+    QEMeshOptimizationSettings MeshOptimization;
 
     std::atomic<QEImportJobState> State{ QEImportJobState::Queued };
     QEImportProgress Progress;
@@ -81,7 +83,8 @@ public:
 
     std::shared_ptr<QEImportJob> EnqueueMeshImport(
         const std::string& sourcePath,
-        const std::string& targetFolder);
+        const std::string& targetFolder,
+        const QEMeshOptimizationSettings& optimization = {});
     std::shared_ptr<QEImportJob> EnqueueShaderImport(
         const std::string& sourcePath,
         const std::string& targetFolder);
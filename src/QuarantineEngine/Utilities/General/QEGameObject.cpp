@@ -3,6 +3,7 @@
 #include <CullingSceneManager.h>
 #include <QEAnimationGraphAssetHelper.h>
 #include <QEProjectManager.h>
+#include <Logging/QELogMacros.h>
 #include <cctype>
 
 namespace
@@ -29,8 +30,23 @@ namespace
 
         return sanitized;
     }
+
+    // Codificacion de cada componente en el .qescene binario
+    constexpr uint8_t COMPONENT_FIELDS = 0;     // Campos REFLECT_PROPERTY
+    constexpr uint8_t COMPONENT_YAML = 1;       // Texto YAML (referencia del grafo de animacion)
+
+    void NormalizeMaterialBinding(QEGameObject::MaterialBindingInfo& binding)
+    {
+        if (binding.SourceMaterialName.empty())
+            binding.SourceMaterialName = binding.BoundMaterialName;
+
+        if (binding.BoundMaterialName.empty())
+            binding.BoundMaterialName = binding.SourceMaterialName;
+    }
 }
 
+std::atomic<uint32_t> QEGameObject::_structureVersion{ 0 };
+
 QEGameObject::QEGameObject(std::string name)
 {
     this->Name = (name.empty()) ? ID() : name;
@@ -182,6 +198,15 @@ void QEGameObject::QEDestroy()
     }
 }
 
+void QEGameObject::SetActive(bool active)
+{
+    if (QEActive == active)
+        return;
+
+    QEActive = active;
+    MarkStructureChanged();
+}
+
 bool QEGameObject::IsActiveInHierarchy() const
 {
     if (!QEActive)
@@ -265,41 +290,7 @@ std::shared_ptr<QEGameObject> QEGameObject::FromYaml(const YAML::Node& node)
     {
         for (const auto& cnode : node["components"])
         {
-            // Esperamos "type" como en serializeComponent
-            std::string typeName = cnode["type"] ? cnode["type"].as<std::string>() : "";
-            if (typeName.empty()) continue;
-
-            auto& reg = getFactoryRegistry();
-            auto it = reg.find(typeName);
-            if (it == reg.end())
-            {
-                // tipo no registrado -> lo ignoramos o avisamos
-                continue;
-            }
-
-            std::unique_ptr<QEGameComponent> uptr = it->second(); // createInstance()
-            if (!uptr) continue;
-
-            // rellena campos
-            deserializeComponent(uptr.get(), cnode);
-
-            // binario: convertir a shared_ptr y bind
-            std::shared_ptr<QEGameComponent> sptr(uptr.release());
-            sptr->BindGameObject(go.get());
-
-            if (auto animationComponent = std::dynamic_pointer_cast<QEAnimationComponent>(sptr))
-            {
-                QEAnimationGraphAssetHelper::LoadAnimationComponentFromReference(*animationComponent, cnode);
-            }
-
-            if (auto tr = std::dynamic_pointer_cast<QETransform>(sptr))
-            {
-                go->AddComponent<QETransform>(tr);
-            }
-            else
-            {
-                go->components.push_back(sptr);
-            }
+            go->AddComponentFromYaml(cnode);
         }
     }
 
@@ -319,12 +310,7 @@ std::shared_ptr<QEGameObject> QEGameObject::FromYaml(const YAML::Node& node)
                 binding.SourceMaterialName = matnode["Source"] ? matnode["Source"].as<std::string>() : "";
                 binding.BoundMaterialName = matnode["Bound"] ? matnode["Bound"].as<std::string>() : "";
                 binding.UseCopy = matnode["UseCopy"] ? matnode["UseCopy"].as<bool>() : false;
-
-                if (binding.SourceMaterialName.empty())
-                    binding.SourceMaterialName = binding.BoundMaterialName;
-
-                if (binding.BoundMaterialName.empty())
-                    binding.BoundMaterialName = binding.SourceMaterialName;
+                NormalizeMaterialBinding(binding);
             }
 
             go->materialBindings.push_back(binding);
@@ -346,6 +332,192 @@ std::shared_ptr<QEGameObject> QEGameObject::FromYaml(const YAML::Node& node)
     return go;
 }
 
+void QEGameObject::ToBinary(QEBinaryWriter& out) const
+{
+    out.WriteString(this->id);
+    out.WriteString(this->Name);
+    out.Write(static_cast<uint8_t>(this->QEActive));
+
+    const size_t countOffset = out.Size();
+    uint32_t componentCount = 0;
+    out.Write(componentCount);
+
+    for (const auto& comp : components)
+    {
+        if (!comp->IsSerializable())
+            continue;
+
+        auto* animationComponent = dynamic_cast<QEAnimationComponent*>(comp.get());
+        out.WriteString(comp->getTypeName());
+        out.Write(animationComponent ? COMPONENT_YAML : COMPONENT_FIELDS);
+
+        // Tamano del bloque: un tipo que no esta registrado al cargar se salta entero
+        const size_t sizeOffset = out.Size();
+        out.Write(uint32_t(0));
+
+        if (animationComponent)
+        {
+            YAML::Emitter emitter;
+            emitter << QEAnimationGraphAssetHelper::SerializeAnimationComponentReference(*animationComponent);
+            out.WriteString(emitter.c_str());
+        }
+        else
+        {
+            serializeComponentBinary(comp.get(), out);
+        }
+
+        out.Patch(sizeOffset, static_cast<uint32_t>(out.Size() - sizeOffset - sizeof(uint32_t)));
+        ++componentCount;
+    }
+    out.Patch(countOffset, componentCount);
+
+    out.Write(static_cast<uint32_t>(materials.size()));
+    for (size_t materialIndex = 0; materialIndex < materials.size(); ++materialIndex)
+    {
+        out.WriteString(ResolveMaterialSourceName(materialIndex));
+        out.WriteString(ResolveMaterialBindingName(materialIndex));
+        out.Write(static_cast<uint8_t>(IsMaterialUsingCopy(materialIndex)));
+    }
+
+    out.Write(static_cast<uint32_t>(childs.size()));
+    for (const auto& ch : childs)
+        ch->ToBinary(out);
+}
+
+std::shared_ptr<QEGameObject> QEGameObject::FromBinary(QEBinaryReader& in)
+{
+    std::shared_ptr<QEGameObject> go = std::make_shared<QEGameObject>();
+    go->components.clear();
+
+    uint8_t active = 1;
+    uint32_t componentCount = 0;
+    if (!in.ReadString(go->id) || !in.ReadString(go->Name) || !in.Read(active) || !in.Read(componentCount))
+        return nullptr;
+
+    go->QEActive = active != 0;
+
+    for (uint32_t i = 0; i < componentCount; ++i)
+    {
+        if (!go->AddComponentFromBinary(in))
+            return nullptr;
+    }
+
+    uint32_t materialCount = 0;
+    if (!in.Read(materialCount))
+        return nullptr;
+
+    for (uint32_t i = 0; i < materialCount; ++i)
+    {
+        MaterialBindingInfo binding;
+        uint8_t useCopy = 0;
+        if (!in.ReadString(binding.SourceMaterialName) || !in.ReadString(binding.BoundMaterialName) || !in.Read(useCopy))
+            return nullptr;
+
+        binding.UseCopy = useCopy != 0;
+        NormalizeMaterialBinding(binding);
+        go->materialBindings.push_back(binding);
+    }
+
+    uint32_t childCount = 0;
+    if (!in.Read(childCount))
+        return nullptr;
+
+    for (uint32_t i = 0; i < childCount; ++i)
+    {
+        auto child = QEGameObject::FromBinary(in);
+        if (!child)
+            return nullptr;
+
+        go->AddChild(child, /*keepWorldTransform=*/false);
+    }
+
+    return go;
+}
+
+void QEGameObject::AddComponentFromYaml(const YAML::Node& cnode)
+{
+    // Esperamos "type" como en serializeComponent
+    std::string typeName = cnode["type"] ? cnode["type"].as<std::string>() : "";
+    if (typeName.empty()) return;
+
+    auto& reg = getFactoryRegistry();
+    auto it = reg.find(typeName);
+    if (it == reg.end())
+    {
+        // tipo no registrado -> lo ignoramos o avisamos
+        return;
+    }
+
+    std::unique_ptr<QEGameComponent> uptr = it->second(); // createInstance()
+    if (!uptr) return;
+
+    // rellena campos
+    deserializeComponent(uptr.get(), cnode);
+
+    // binario: convertir a shared_ptr y bind
+    std::shared_ptr<QEGameComponent> sptr(uptr.release());
+    sptr->BindGameObject(this);
+
+    if (auto animationComponent = std::dynamic_pointer_cast<QEAnimationComponent>(sptr))
+    {
+        QEAnimationGraphAssetHelper::LoadAnimationComponentFromReference(*animationComponent, cnode);
+    }
+
+    AttachLoadedComponent(sptr);
+}
+
+bool QEGameObject::AddComponentFromBinary(QEBinaryReader& in)
+{
+    std::string typeName;
+    uint8_t encoding = 0;
+    uint32_t size = 0;
+    QEBinaryReader block;
+    if (!in.ReadString(typeName) || !in.Read(encoding) || !in.Read(size) || !in.ReadBlock(size, block))
+        return false;
+
+    if (encoding == COMPONENT_YAML)
+    {
+        std::string text;
+        if (!block.ReadString(text))
+            return false;
+
+        AddComponentFromYaml(YAML::Load(text));
+        return true;
+    }
+
+    auto& reg = getFactoryRegistry();
+    auto it = reg.find(typeName);
+    if (encoding != COMPONENT_FIELDS || it == reg.end())
+        return true;
+
+    std::unique_ptr<QEGameComponent> uptr = it->second();
+    if (!uptr)
+        return true;
+
+    if (!deserializeComponentBinary(uptr.get(), block))
+    {
+        QE_LOG_WARN_CAT_F("QEGameObject", "Skipping unreadable {} component in '{}'", typeName, this->Name);
+        return true;
+    }
+
+    std::shared_ptr<QEGameComponent> sptr(uptr.release());
+    sptr->BindGameObject(this);
+    AttachLoadedComponent(sptr);
+    return true;
+}
+
+void QEGameObject::AttachLoadedComponent(const std::shared_ptr<QEGameComponent>& component)
+{
+    if (auto tr = std::dynamic_pointer_cast<QETransform>(component))
+    {
+        AddComponent<QETransform>(tr);
+    }
+    else
+    {
+        components.push_back(component);
+    }
+}
+
 void QEGameObject::AddChild(const std::shared_ptr<QEGameObject>& child, bool keepWorldTransform)
 {
     if (!child) return;
@@ -357,6 +529,7 @@ void QEGameObject::AddChild(const std::shared_ptr<QEGameObject>& child, bool kee
 
     child->parent = this;
     childs.push_back(child);
+    MarkStructureChanged();
 
     auto transform = this->GetComponent<QETransform>();
     auto childTransform = child->GetComponent<QETransform>();
@@ -380,6 +553,7 @@ void QEGameObject::RemoveChild(const std::shared_ptr<QEGameObject>& child)
     {
         childs.erase(it, childs.end());
         child->parent = nullptr;
+        MarkStructureChanged();
 
         auto childTransform = child->GetComponent<QETransform>();
         if (childTransform)
@@ -543,6 +717,7 @@ bool QEGameObject::RemoveComponent(const std::shared_ptr<QEGameComponent>& compo
     (*it)->QEDestroy();
     (*it)->Owner = nullptr;
     components.erase(it);
+    MarkStructureChanged();
     return true;
 }
 
@@ -569,5 +744,6 @@ bool QEGameObject::RemoveComponentByType(const std::string& typeName)
     (*it)->QEDestroy();
     (*it)->Owner = nullptr;
     components.erase(it);
+    MarkStructureChanged();
     return true;
 }
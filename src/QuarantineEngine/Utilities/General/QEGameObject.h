@@ -9,7 +9,9 @@
 #include <QEMeshRenderer.h>
 #include <Material.h>
 #include <yaml-cpp/yaml.h>
+#include <QEBinaryStream.h>
 #include <string>
+#include <atomic>
 
 typedef class QEGameObject QEGameObject;
 
@@ -46,6 +48,8 @@ private:
     std::vector<std::shared_ptr<QEGameObject>> childs;
     QEGameObject* parent = nullptr;
 
+    static std::atomic<uint32_t> _structureVersion;
+
 private:
     void InitializeResources();
     void EnsureMaterialBindingIndex(size_t materialIndex);
@@ -59,11 +63,17 @@ private:
     std::string GetBoundMaterialFilePath(size_t materialIndex) const;
     void DeleteOwnedMaterialCopy(const std::string& materialPath);
 
+    void AddComponentFromYaml(const YAML::Node& node);
+    bool AddComponentFromBinary(QEBinaryReader& in);
+    void AttachLoadedComponent(const std::shared_ptr<QEGameComponent>& component);
+
 public:
     QEGameObject(std::string name = "");
     inline std::string ID() const { return id; }
     bool IsActiveSelf() const { return QEActive; }
     bool IsActiveInHierarchy() const;
+    /// Activa o desactiva el objeto y marca el cambio de estructura (ver GetStructureVersion).
+    void SetActive(bool active);
     unsigned int GetUpdateOrder() const { return UpdateOrder; }
     void SetUpdateOrder(unsigned int updateOrder) { UpdateOrder = updateOrder; }
     QEGameObject* GetParent() const { return parent; }
@@ -82,6 +92,10 @@ public:
 
     YAML::Node ToYaml() const;
     static std::shared_ptr<QEGameObject> FromYaml(const YAML::Node& node);
+    /// Mismo contenido que ToYaml para el .qescene binario; los componentes usan la tabla de codecs de Reflectable.
+    void ToBinary(QEBinaryWriter& out) const;
+    /// nullptr si el bloque esta truncado o corrupto.
+    static std::shared_ptr<QEGameObject> FromBinary(QEBinaryReader& in);
 
     void AddChild(const std::shared_ptr<QEGameObject>& child, bool keepWorldTransform);
     void RemoveChild(const std::shared_ptr<QEGameObject>& child);
@@ -427,6 +441,7 @@ public:
 
         components.push_back(component_ptr);
         component_ptr->BindGameObject(this);
+        MarkStructureChanged();
 
         if (auto transform = std::dynamic_pointer_cast<QETransform>(component_ptr))
         {
@@ -439,6 +454,12 @@ public:
     bool RemoveComponent(const std::shared_ptr<QEGameComponent>& component_ptr);
     bool RemoveComponentByType(const std::string& typeName);
 
+    /// Cambia al anadir/quitar componentes, reparentar u (des)activar un objeto (SetActive).
+    /// Permite a los componentes cachear busquedas como GetComponentInChildren.
+    /// Atomico: los hilos de carga de escenas tambien montan jerarquias.
+    static uint32_t GetStructureVersion() { return _structureVersion.load(std::memory_order_acquire); }
+    static void MarkStructureChanged() { _structureVersion.fetch_add(1, std::memory_order_acq_rel); }
+
     template<typename T>
     bool RemoveComponent()
     {
@@ -449,6 +470,7 @@ public:
                 (*it)->QEDestroy();
                 (*it)->Owner = nullptr;
                 components.erase(it);
+                MarkStructureChanged();
                 return true;
             }
         }
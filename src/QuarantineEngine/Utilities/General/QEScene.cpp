@@ -1,9 +1,164 @@
 #include "QEScene.h"
 #include <GameObjectManager.h>
+#include <QEBinaryStream.h>
+#include <QEMappedFile.h>
+#include <QESceneLoader.h>
 
 namespace
 {
     constexpr float kDefaultSceneGravity = -20.0f;
+
+    // .qescene binario: cabecera y secciones (id, tamano, datos). Una seccion desconocida se salta,
+    // asi que anadir secciones no rompe escenas guardadas; SCENE_VERSION solo cambia si cambia esta estructura.
+    constexpr uint32_t SCENE_MAGIC = 0x42534551;     // "QESB"
+    constexpr uint32_t SCENE_VERSION = 1;
+
+    enum class SceneSection : uint32_t
+    {
+        Atmosphere = 1,         // Texto YAML de AtmosphereDto
+        Physics = 2,            // Gravedad
+        Materials = 3,          // Rutas de los .qemat
+        GameObjects = 4         // Raices, ver QEGameObject::ToBinary
+    };
+
+    struct SceneHeader
+    {
+        uint32_t Magic = 0;
+        uint32_t Version = 0;
+        uint32_t SectionCount = 0;
+        uint32_t Reserved = 0;
+    };
+
+    struct SectionHeader
+    {
+        uint32_t Id = 0;
+        uint32_t Reserved = 0;
+        uint64_t Size = 0;
+    };
+
+    template<typename WriteSection>
+    void WriteSectionTo(QEBinaryWriter& out, SceneSection id, WriteSection writeSection)
+    {
+        SectionHeader header;
+        header.Id = static_cast<uint32_t>(id);
+        const size_t headerOffset = out.Size();
+        out.Write(header);
+
+        writeSection();
+
+        header.Size = out.Size() - headerOffset - sizeof(SectionHeader);
+        out.Patch(headerOffset, header);
+    }
+
+    void WriteBinaryScene(QEBinaryWriter& out, const QESceneContent& content)
+    {
+        SceneHeader header;
+        header.Magic = SCENE_MAGIC;
+        header.Version = SCENE_VERSION;
+        header.SectionCount = content.HasGravity ? 4 : 3;
+        out.Write(header);
+
+        WriteSectionTo(out, SceneSection::Atmosphere, [&]()
+            {
+                YAML::Emitter emitter;
+                emitter << SerializeAtmosphere(content.Atmosphere);
+                out.WriteString(emitter.c_str());
+            });
+
+        if (content.HasGravity)
+        {
+            WriteSectionTo(out, SceneSection::Physics, [&]() { out.Write(content.Gravity); });
+        }
+
+        WriteSectionTo(out, SceneSection::Materials, [&]()
+            {
+                out.Write(static_cast<uint32_t>(content.Materials.size()));
+                for (const auto& material : content.Materials)
+                    out.WriteString(material.as<std::string>());
+            });
+
+        WriteSectionTo(out, SceneSection::GameObjects, [&]()
+            {
+                out.Write(static_cast<uint32_t>(content.GameObjects.size()));
+                for (const auto& root : content.GameObjects)
+                    root->ToBinary(out);
+            });
+    }
+
+    bool ReadBinaryScene(QEBinaryReader& in, QESceneContent& out)
+    {
+        SceneHeader header;
+        if (!in.Read(header) || header.Magic != SCENE_MAGIC)
+            return false;
+
+        if (header.Version != SCENE_VERSION)
+        {
+            QE_LOG_ERROR_CAT_F("QEScene", "Unsupported binary scene version {} (expected {})", header.Version, SCENE_VERSION);
+            return false;
+        }
+
+        for (uint32_t i = 0; i < header.SectionCount; ++i)
+        {
+            SectionHeader section;
+            QEBinaryReader data;
+            if (!in.Read(section) || !in.ReadBlock(static_cast<size_t>(section.Size), data))
+                return false;
+
+            switch (static_cast<SceneSection>(section.Id))
+            {
+            case SceneSection::Atmosphere:
+            {
+                std::string text;
+                if (!data.ReadString(text))
+                    return false;
+                DeserializeAtmosphere(YAML::Load(text), out.Atmosphere);
+                break;
+            }
+            case SceneSection::Physics:
+                if (!data.Read(out.Gravity))
+                    return false;
+                out.HasGravity = true;
+                break;
+            case SceneSection::Materials:
+            {
+                uint32_t count = 0;
+                if (!data.Read(count))
+                    return false;
+
+                out.Materials = YAML::Node(YAML::NodeType::Sequence);
+                for (uint32_t m = 0; m < count; ++m)
+                {
+                    std::string materialPath;
+                    if (!data.ReadString(materialPath))
+                        return false;
+                    out.Materials.push_back(materialPath);
+                }
+                break;
+            }
+            case SceneSection::GameObjects:
+            {
+                uint32_t count = 0;
+                if (!data.Read(count))
+                    return false;
+
+                out.GameObjects.reserve(count);
+                for (uint32_t g = 0; g < count; ++g)
+                {
+                    auto root = QEGameObject::FromBinary(data);
+                    if (!root)
+                        return false;
+                    out.GameObjects.push_back(root);
+                }
+                break;
+            }
+            default:
+                // Seccion de una version posterior
+                break;
+            }
+        }
+
+        return true;
+    }
 }
 
 QEScene::QEScene()
@@ -37,41 +192,134 @@ bool QEScene::InitScene(fs::path scenefile)
 
 bool QEScene::SerializeScene()
 {
-    auto gameObjectManager = GameObjectManager::getInstance();
-    auto materialManager = MaterialManager::getInstance();
-    auto lightManager = LightManager::getInstance();
+    return SerializeScene(this->scenePath / this->sceneName, this->format);
+}
 
-    YAML::Node root;
-    root["AtmosphereDto"] = SerializeAtmosphere(atmosphereDto);
-    root["PhysicsSettings"]["Gravity"] = physicsGravity;
-    root["Materials"] = materialManager->SerializeMaterials();
-    root["GameObjects"] = gameObjectManager->SerializeGameObjects();
+bool QEScene::SerializeScene(const fs::path& filePath, QESceneFormat fileFormat) const
+{
+    QESceneContent content;
+    content.Atmosphere = atmosphereDto;
+    content.HasGravity = true;
+    content.Gravity = physicsGravity;
+    content.Materials = MaterialManager::getInstance()->SerializeMaterials();
+    content.GameObjects = GameObjectManager::getInstance()->GetSerializableRootGameObjects();
 
-    fs::path filePath = this->scenePath / this->sceneName;
+    return WriteSceneFile(filePath, fileFormat, content);
+}
 
+bool QEScene::WriteSceneFile(const fs::path& filePath, QESceneFormat fileFormat, const QESceneContent& content)
+{
     std::ofstream file(filePath, std::ios::binary | std::ios::trunc);
 
     if (!file.is_open())
     {
-        QE_LOG_ERROR_CAT_F("QEScene", "Error saving the scene {}", this->sceneName);
+        QE_LOG_ERROR_CAT_F("QEScene", "Error saving the scene {}", filePath.string());
         return false;
     }
 
-    file << root;
+    if (fileFormat == QESceneFormat::Binary)
+    {
+        QEBinaryWriter out;
+        WriteBinaryScene(out, content);
+        file.write(reinterpret_cast<const char*>(out.Data()), static_cast<std::streamsize>(out.Size()));
+    }
+    else
+    {
+        YAML::Node root;
+        root["AtmosphereDto"] = SerializeAtmosphere(content.Atmosphere);
+        if (content.HasGravity)
+        {
+            root["PhysicsSettings"]["Gravity"] = content.Gravity;
+        }
+        root["Materials"] = content.Materials;
+
+        YAML::Node gameObjectsNode;
+        for (const auto& go : content.GameObjects)
+        {
+            gameObjectsNode.push_back(go->ToYaml());
+        }
+        root["GameObjects"] = gameObjectsNode;
+
+        file << root;
+    }
+
     file.close();
+    return static_cast<bool>(file);
+}
+
+bool QEScene::DeserializeScene(const QEImportProgressCallback& onProgress)
+{
+    physicsGravity = kDefaultSceneGravity;
+
+    const fs::path filePath = this->scenePath / this->sceneName;
+
+    if (onProgress)
+    {
+        onProgress(0.0f, "Scene", this->sceneName);
+    }
+
+    QESceneContent content;
+    content.Atmosphere = atmosphereDto;
+    if (!ReadSceneFile(filePath, content))
+        return false;
+
+    format = content.Format;
+    atmosphereDto = content.Atmosphere;
+    if (content.HasGravity)
+    {
+        physicsGravity = content.Gravity;
+    }
 
+    preloadedGeometry = QESceneLoader::Load(content, onProgress);
     return true;
 }
 
-bool QEScene::DeserializeScene()
+void QEScene::ReleasePreloadedGeometry()
 {
-    auto gameObjectManager = GameObjectManager::getInstance();
-    auto materialManager = MaterialManager::getInstance();
+    preloadedGeometry.clear();
+}
 
-    physicsGravity = kDefaultSceneGravity;
+QESceneFormat QEScene::DetectFormat(const fs::path& filePath)
+{
+    std::ifstream file(filePath, std::ios::binary);
+    uint32_t magic = 0;
+    file.read(reinterpret_cast<char*>(&magic), sizeof(magic));
+    return (file && magic == SCENE_MAGIC) ? QESceneFormat::Binary : QESceneFormat::Yaml;
+}
 
-    namespace fs = std::filesystem;
-    const fs::path filePath = this->scenePath / this->sceneName;
+bool QEScene::ReadSceneFile(const fs::path& filePath, QESceneContent& out)
+{
+    out.Format = DetectFormat(filePath);
+    if (out.Format == QESceneFormat::Binary)
+    {
+        // Todo el archivo de una vez; las secciones se leen directamente del mapeo
+        QEMappedFile file;
+        if (!file.Open(filePath))
+        {
+            QE_LOG_ERROR_CAT_F("QEScene", "Error opening the scene {}", filePath.string());
+            return false;
+        }
+
+        bool valid = false;
+        try
+        {
+            QEBinaryReader in(file.Data(), file.Size());
+            valid = ReadBinaryScene(in, out);
+        }
+        catch (const std::exception& e)
+        {
+            // Texto YAML embebido (atmosfera, animacion) que no se puede leer
+            QE_LOG_ERROR_CAT_F("QEScene", "Invalid YAML in binary scene {} ({})", filePath.string(), e.what());
+        }
+
+        if (!valid)
+        {
+            QE_LOG_ERROR_CAT_F("QEScene", "Invalid binary scene {}", filePath.string());
+            out.GameObjects.clear();
+            return false;
+        }
+        return true;
+    }
 
     YAML::Node root;
     try
@@ -92,7 +340,7 @@ bool QEScene::DeserializeScene()
     // AtmosphereDto
     if (auto n = root["AtmosphereDto"])
     {
-        if (!DeserializeAtmosphere(n, atmosphereDto))
+        if (!DeserializeAtmosphere(n, out.Atmosphere))
         {
             QE_LOG_WARN_CAT("QEScene", "'AtmosphereDto' could not be deserialised. Using defaults.");
         }
@@ -106,7 +354,8 @@ bool QEScene::DeserializeScene()
     {
         if (auto gravityNode = n["Gravity"])
         {
-            physicsGravity = gravityNode.as<float>();
+            out.HasGravity = true;
+            out.Gravity = gravityNode.as<float>();
         }
         else
         {
@@ -120,7 +369,7 @@ bool QEScene::DeserializeScene()
 
     if (auto n = root["Materials"])
     {
-        materialManager->DeserializeMaterials(n);
+        out.Materials = n;
     }
     else
     {
@@ -129,7 +378,10 @@ bool QEScene::DeserializeScene()
 
     if (auto n = root["GameObjects"])
     {
-        gameObjectManager->DeserializeGameObjects(n);
+        for (auto gameObjectData : n)
+        {
+            out.GameObjects.push_back(QEGameObject::FromYaml(gameObjectData));
+        }
     }
     else
     {
@@ -4,21 +4,47 @@
 
 #include <QEGameObject.h>
 #include <AtmosphereDto.h>
+#include <functional>
 #include <vector>
 
 using namespace std;
 
 namespace fs = filesystem;
 
+using QEImportProgressCallback = std::function<void(float, const std::string&, const std::string&)>;
+
+struct QEGeometrySharedResource;
+
+enum class QESceneFormat : uint8_t
+{
+    Yaml,       // Texto, formato de intercambio
+    Binary      // Generado desde los metadatos REFLECT_PROPERTY, carga rapida
+};
+
+/// Contenido de un .qescene ya decodificado, antes de pasarlo a los managers.
+struct QESceneContent
+{
+    QESceneFormat Format = QESceneFormat::Yaml;
+    AtmosphereDto Atmosphere;
+    bool HasGravity = false;
+    float Gravity = 0.0f;
+    YAML::Node Materials;
+    std::vector<std::shared_ptr<QEGameObject>> GameObjects;
+};
+
 class QEScene
 {
 private:
     fs::path scenePath;
+    // Mallas subidas por QESceneLoader, vivas hasta que sus componentes arrancan
+    std::vector<std::shared_ptr<QEGeometrySharedResource>> preloadedGeometry;
 
 public:
     string sceneName;
     AtmosphereDto atmosphereDto;
     float physicsGravity = -20.0f;
+    // Formato del archivo cargado; SerializeScene() guarda en el mismo
+    QESceneFormat format = QESceneFormat::Yaml;
 
 public:
     QEScene();
@@ -26,15 +52,28 @@ public:
     ~QEScene();
     bool InitScene(fs::path filename);
     bool SerializeScene();
-    bool DeserializeScene();
+    bool SerializeScene(const fs::path& filePath, QESceneFormat fileFormat) const;
+    /// Lee el archivo y lo aplica con QESceneLoader (materiales, mallas y texturas en paralelo).
+    bool DeserializeScene(const QEImportProgressCallback& onProgress = nullptr);
+    /// Tras StartQEGameObjects: los componentes ya tienen sus mallas.
+    void ReleasePreloadedGeometry();
     fs::path GetSceneFilePath() const;
     fs::path GetSceneDirectoryPath() const;
+
+    /// Binario si el archivo empieza por la firma del formato binario; YAML en cualquier otro caso.
+    static QESceneFormat DetectFormat(const fs::path& filePath);
+    /// Decodifica el archivo (en cualquiera de los dos formatos) sin tocar los managers.
+    /// 'out.Atmosphere' se usa como base para los valores que falten.
+    static bool ReadSceneFile(const fs::path& filePath, QESceneContent& out);
+    static bool WriteSceneFile(const fs::path& filePath, QESceneFormat fileFormat, const QESceneContent& content);
 };
 
 
 
 namespace QE
 {
+    using ::QESceneFormat;
+    using ::QESceneContent;
     using ::QEScene;
 } // namespace QE
 // QE namespace aliases
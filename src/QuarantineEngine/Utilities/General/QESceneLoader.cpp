@@ -0,0 +1,341 @@
+#include "QESceneLoader.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
+
+#include <GameObjectManager.h>
+#include <Logging/QELogMacros.h>
+#include <MaterialManager.h>
+#include <MeshImporter.h>
+#include <QEGeometryComponent.h>
+#include <QEMeshGenerator.h>
+#include <QEMeshletCache.h>
+#include <QEProjectManager.h>
+
+QESceneLoadStats QESceneLoader::lastStats;
+uint32_t QESceneLoader::WorkerCount = 0;
+bool QESceneLoader::Parallel = true;
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    // Mallas construidas que se juntan antes de subirlas (cada subida espera a la cola)
+    constexpr size_t UPLOAD_BATCH_MESHES = 16;
+
+    double ElapsedMs(Clock::time_point from)
+    {
+        return std::chrono::duration<double, std::milli>(Clock::now() - from).count();
+    }
+
+    struct MaterialTask
+    {
+        std::string Path;
+        MaterialDto Dto;
+        bool Loaded = false;
+    };
+
+    struct MeshTask
+    {
+        std::string Name;
+        std::string FilePath;
+        QEGeometryBuildData Data;
+    };
+
+    /// Estado compartido entre el hilo principal y los de trabajo. Los trabajos son primero los
+    /// materiales (desbloquean antes al hilo principal) y despues las mallas.
+    struct LoadGraph
+    {
+        std::vector<MaterialTask> Materials;
+        std::vector<MeshTask> Meshes;
+
+        std::atomic<size_t> Next{ 0 };
+        std::mutex Mutex;
+        std::condition_variable Ready;
+        size_t MaterialsPending = 0;
+        size_t MeshesPending = 0;
+        std::atomic<size_t> Finished{ 0 };
+        std::deque<size_t> BuiltMeshes;         // Construidas, pendientes de subir
+
+        size_t JobCount() const { return Materials.size() + Meshes.size(); }
+    };
+
+    void CollectMeshes(
+        const std::shared_ptr<QEGameObject>& gameObject,
+        LoadGraph& graph,
+        std::unordered_set<std::string>& keys,
+        std::vector<std::shared_ptr<QEGeometrySharedResource>>& reused,
+        QESceneLoadStats& stats)
+    {
+        if (!gameObject)
+            return;
+
+        for (const auto& component : gameObject->GetComponents())
+        {
+            auto geometry = std::dynamic_pointer_cast<QEGeometryComponent>(component);
+            if (!geometry)
+                continue;
+
+            const std::string key = QEGeometryComponent::BuildResourceKey(geometry->GetMeshName(), geometry->GetMeshFilePath());
+            if (key.empty())
+                continue;
+
+            ++stats.MeshReferences;
+            if (!keys.insert(key).second)
+                continue;
+
+            // Otra escena o el editor ya la tienen en GPU
+            if (auto live = QEGeometryResourceCache::Find(key))
+            {
+                reused.push_back(std::move(live));
+                ++stats.ReusedMeshes;
+                continue;
+            }
+
+            MeshTask task;
+            task.Name = geometry->GetMeshName();
+            task.FilePath = geometry->GetMeshFilePath();
+            task.Data.Key = key;
+            graph.Meshes.push_back(std::move(task));
+        }
+
+        for (const auto& child : gameObject->GetChildren())
+        {
+            CollectMeshes(child, graph, keys, reused, stats);
+        }
+    }
+
+    void BuildMesh(MeshTask& task)
+    {
+        // Los materiales de la malla no se crean aqui: MaterialManager solo se toca en el hilo principal
+        std::unique_ptr<IQEMeshGenerator> generator = (task.FilePath == "QECore")
+            ? QEGeometryComponent::GetGenerator(task.Name, task.FilePath)
+            : std::make_unique<QEMeshGenerator>(task.FilePath, false);
+
+        if (!generator)
+            return;
+
+        task.Data.Mesh = generator->GenerateQEMesh();
+        task.Data.Meshlets = QEMeshletCache::LoadOrBuild(task.Data.Mesh);
+    }
+
+    void RunJobs(LoadGraph& graph)
+    {
+        const size_t materialCount = graph.Materials.size();
+
+        for (size_t slot = graph.Next.fetch_add(1); slot < graph.JobCount(); slot = graph.Next.fetch_add(1))
+        {
+            const bool isMaterial = slot < materialCount;
+
+            try
+            {
+                if (isMaterial)
+                {
+                    MaterialTask& task = graph.Materials[slot];
+                    task.Loaded = MaterialManager::ReadSceneMaterial(task.Path, task.Dto);
+                }
+                else
+                {
+                    BuildMesh(graph.Meshes[slot - materialCount]);
+                }
+            }
+            catch (const std::exception& e)
+            {
+                // El hilo principal sigue esperando este trabajo: se da por terminado (malla vacia)
+                QE_LOG_ERROR_CAT_F("QESceneLoader", "Scene load job failed ({})", e.what());
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(graph.Mutex);
+                if (isMaterial)
+                {
+                    --graph.MaterialsPending;
+                }
+                else
+                {
+                    --graph.MeshesPending;
+                    graph.BuiltMeshes.push_back(slot - materialCount);
+                }
+                ++graph.Finished;
+            }
+            graph.Ready.notify_one();
+        }
+    }
+}
+
+std::vector<std::shared_ptr<QEGeometrySharedResource>> QESceneLoader::Load(
+    QESceneContent& content,
+    const QEImportProgressCallback& onProgress)
+{
+    const auto start = Clock::now();
+
+    QESceneLoadStats stats;
+    LoadGraph graph;
+    std::vector<std::shared_ptr<QEGeometrySharedResource>> resources;
+
+    // Materiales de la escena, sin repetir archivos y en el orden de la lista
+    if (content.Materials && content.Materials.IsSequence())
+    {
+        std::unordered_set<std::string> paths;
+        for (const auto& materialPath : content.Materials)
+        {
+            std::string path = materialPath.as<std::string>();
+            if (!paths.insert(QEProjectManager::ResolveProjectPath(path).generic_string()).second)
+                continue;
+
+            MaterialTask task;
+            task.Path = std::move(path);
+            graph.Materials.push_back(std::move(task));
+        }
+    }
+
+    std::unordered_set<std::string> meshKeys;
+    for (const auto& root : content.GameObjects)
+    {
+        CollectMeshes(root, graph, meshKeys, resources, stats);
+    }
+
+    graph.MaterialsPending = graph.Materials.size();
+    graph.MeshesPending = graph.Meshes.size();
+    stats.MaterialFiles = static_cast<uint32_t>(graph.Materials.size());
+    stats.Meshes = static_cast<uint32_t>(graph.Meshes.size());
+
+    // Materiales + mallas construidas + mallas subidas
+    const size_t totalSteps = std::max<size_t>(1, graph.JobCount() + graph.Meshes.size());
+    size_t uploaded = 0;
+    auto report = [&](const std::string& stage, const std::string& message, size_t finished)
+        {
+            if (onProgress)
+            {
+                onProgress(static_cast<float>(finished + uploaded) / static_cast<float>(totalSteps), stage, message);
+            }
+        };
+
+    uint32_t workerCount = WorkerCount;
+    if (workerCount == 0)
+        workerCount = std::max(2u, std::thread::hardware_concurrency()) - 1;
+    workerCount = Parallel ? std::min<uint32_t>(workerCount, static_cast<uint32_t>(graph.JobCount())) : 0;
+    stats.Workers = workerCount;
+
+    std::vector<std::future<void>> workers;
+    if (workerCount == 0)
+    {
+        // Serie: todos los trabajos antes; el bucle de abajo ya no espera
+        RunJobs(graph);
+    }
+    else
+    {
+        workers.reserve(workerCount);
+        for (uint32_t i = 0; i < workerCount; ++i)
+        {
+            workers.push_back(std::async(std::launch::async, [&graph]() { RunJobs(graph); }));
+        }
+    }
+
+    auto materialManager = MaterialManager::getInstance();
+    bool materialsCreated = false;
+    size_t lastReported = SIZE_MAX;
+
+    std::unique_lock<std::mutex> lock(graph.Mutex);
+    while (true)
+    {
+        const bool materialsReady = !materialsCreated && graph.MaterialsPending == 0;
+        const bool meshesReady = materialsCreated && (graph.BuiltMeshes.size() >= UPLOAD_BATCH_MESHES || graph.MeshesPending == 0);
+
+        if (!materialsReady && !meshesReady)
+        {
+            if (graph.Finished != lastReported)
+            {
+                lastReported = graph.Finished;
+                lock.unlock();
+                report(materialsCreated ? "Meshes" : "Materials", "Loading", lastReported);
+                lock.lock();
+                continue;
+            }
+
+            graph.Ready.wait(lock);
+            continue;
+        }
+
+        if (materialsReady)
+        {
+            lock.unlock();
+
+            std::vector<MaterialDto> materialDtos;
+            materialDtos.reserve(graph.Materials.size());
+            for (auto& task : graph.Materials)
+            {
+                if (task.Loaded)
+                    materialDtos.push_back(std::move(task.Dto));
+            }
+
+            // Crea los materiales y encola sus texturas en el streamer
+            materialManager->LoadMaterialDtos(materialDtos);
+            materialsCreated = true;
+            stats.MaterialsMs = ElapsedMs(start);
+            report("Materials", std::to_string(materialDtos.size()) + " materials", graph.Finished);
+
+            lock.lock();
+            continue;
+        }
+
+        std::vector<size_t> built(graph.BuiltMeshes.begin(), graph.BuiltMeshes.end());
+        graph.BuiltMeshes.clear();
+        const bool lastBatch = graph.MeshesPending == 0;
+        lock.unlock();
+
+        if (!built.empty())
+        {
+            const std::string lastKey = graph.Meshes[built.back()].Data.Key;
+
+            std::vector<QEGeometryBuildData> batch;
+            batch.reserve(built.size());
+            for (size_t index : built)
+            {
+                MeshTask& task = graph.Meshes[index];
+                if (task.Data.Mesh.FilePath != "QECore")
+                {
+                    MeshImporter::LoadMeshMaterials(task.Data.Mesh);
+                }
+                batch.push_back(std::move(task.Data));
+            }
+
+            auto batchResources = QEGeometryResourceCache::AcquireBuilt(batch);
+            resources.insert(resources.end(), batchResources.begin(), batchResources.end());
+            ++stats.UploadBatches;
+            uploaded += built.size();
+
+            report("Meshes", lastKey, graph.Finished);
+        }
+
+        if (lastBatch)
+            break;
+
+        lock.lock();
+    }
+
+    for (auto& worker : workers)
+    {
+        worker.get();
+    }
+
+    stats.MeshesMs = ElapsedMs(start);
+
+    GameObjectManager::getInstance()->AddSceneGameObjects(content.GameObjects);
+
+    stats.TotalMs = ElapsedMs(start);
+    lastStats = stats;
+
+    report("GameObjects", "Completed", graph.JobCount());
+    QE_LOG_INFO_CAT_F("QESceneLoader", "Scene loaded in {:.1f} ms: {} materials, {} meshes ({} references, {} reused), {} upload batches, {} workers",
+        stats.TotalMs, stats.MaterialFiles, stats.Meshes, stats.MeshReferences, stats.ReusedMeshes, stats.UploadBatches, stats.Workers);
+
+    return resources;
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#ifndef QE_SCENE_LOADER_H
+#define QE_SCENE_LOADER_H
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <QEScene.h>
+#include <QEGeometryResourceCache.h>
+
+/// Contadores y tiempos de la ultima carga (log y benchmark).
+struct QESceneLoadStats
+{
+    uint32_t Workers = 0;
+    uint32_t MaterialFiles = 0;         // .qemat unicos leidos
+    uint32_t Meshes = 0;                // Mallas unicas construidas
+    uint32_t MeshReferences = 0;        // Componentes de geometria de la escena
+    uint32_t ReusedMeshes = 0;          // Ya vivas en QEGeometryResourceCache
+    uint32_t UploadBatches = 0;
+    double MaterialsMs = 0.0;           // Hasta crear los materiales (las texturas siguen en el streamer)
+    double MeshesMs = 0.0;              // Hasta subir la ultima malla
+    double TotalMs = 0.0;
+};
+
+/// Aplica una escena ya decodificada como un grafo de tareas en lugar de en serie:
+///  - Los .qemat y las mallas (importacion, animaciones y meshlets) se leen en hilos de trabajo,
+///    sin repetir rutas ni claves de malla.
+///  - Materiales -> texturas: el hilo principal crea los materiales en cuanto estan todos leidos y
+///    sus texturas entran en QETextureStreamer (decodificacion en sus hilos y subida por el staging ring)
+///    mientras las mallas se siguen construyendo.
+///  - Materiales -> mallas: los materiales que una malla referencia y no estan en la escena se crean
+///    despues de los de la escena (MeshImporter::LoadMeshMaterials).
+///  - Mallas -> GPU: las que van terminando se suben por tandas con QEGeometryResourceCache::AcquireBuilt.
+/// Al terminar pasa los objetos al GameObjectManager; sus QEGeometryComponent encuentran la malla en
+/// la cache al arrancar.
+class QESceneLoader
+{
+private:
+    static QESceneLoadStats lastStats;
+
+public:
+    // 0 = hardware_concurrency - 1
+    static uint32_t WorkerCount;
+    // false: el mismo grafo en el hilo principal (comparacion en el benchmark)
+    static bool Parallel;
+
+    /// Devuelve los recursos de geometria de la escena; hay que mantenerlos vivos hasta StartQEGameObjects.
+    static std::vector<std::shared_ptr<QEGeometrySharedResource>> Load(
+        QESceneContent& content,
+        const QEImportProgressCallback& onProgress = nullptr);
+
+    static const QESceneLoadStats& GetLastStats() { return lastStats; }
+};
+
+
+
+namespace QE
+{
+    using ::QESceneLoadStats;
+    using ::QESceneLoader;
+} // namespace QE
+// QE namespace aliases
+#endif // !QE_SCENE_LOADER_H
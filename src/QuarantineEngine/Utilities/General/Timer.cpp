@@ -1,5 +1,6 @@
 #include "Timer.h"
 #include <GLFW/glfw3.h>
+#include <QEPhysicsInterpolation.h>
 
 float Timer::DeltaTime = 0.0f;
 float Timer::FixedDelta = 0.0f;
@@ -10,6 +11,7 @@ Timer::Timer()
 {
     _frameCounter = LimitFrameCounter = 0;
     _currentFrame = 0.0f;
+    _simulatedFrameDelta = 0.0f;
     DeltaTime = _accumulator = _lastFrame = 0.0f;
     FixedDelta = 1.0f / 60.0f;
 }
@@ -21,6 +23,10 @@ void Timer::UpdateDeltaTime()
     _lastFrame = _currentFrame;
 
     DeltaTime = std::clamp(DeltaTime, 0.0f, 0.1f);
+    if (_simulatedFrameDelta > 0.0f)
+    {
+        DeltaTime = _simulatedFrameDelta;
+    }
     _frameCounter++;
     LimitFrameCounter++;
     LimitFrameCounter &= 0xFFFFFF;
@@ -28,13 +34,5 @@ void Timer::UpdateDeltaTime()
 
 int Timer::ComputeFixedSteps()
 {
-    _accumulator += DeltaTime;
-    int steps = 0;
-    while (_accumulator >= FixedDelta)
-    {
-        steps++;
-        _accumulator -= FixedDelta;
-    }
-    RenderAlpha = _accumulator / FixedDelta;
-    return steps;
+    return QEAdvanceFixedSteps(_accumulator, DeltaTime, FixedDelta, RenderAlpha);
 }
@@ -22,12 +22,15 @@ private:
     float _lastFrame;
     float _currentFrame;
     long long unsigned int _frameCounter;
+    float _simulatedFrameDelta;
 
 public:
     Timer();
     void UpdateDeltaTime();
     int ComputeFixedSteps();
     inline long long unsigned int GetFrameCount() { return _frameCounter; }
+    // > 0: DeltaTime fijo por frame en lugar del reloj real (benchmarks reproducibles)
+    inline void SetSimulatedFrameDelta(float delta) { _simulatedFrameDelta = delta; }
 };
 
 
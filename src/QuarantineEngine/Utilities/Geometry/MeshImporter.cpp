@@ -12,6 +12,10 @@
 #include <QEProjectManager.h>
 #include <Helpers/ScopedTimer.h>
 #include <QETextureImporter.h>
+#include <QEMeshletCache.h>
+#include <QEMeshOptimizer.h>
+#include <QEContentIndex.h>
+#include <Helpers/HashHelpers.h>
 
 static bool ImportMaterialTextureIfNeeded(
     std::string& sourcePath,
@@ -47,6 +51,16 @@ static bool ImportMaterialTextureIfNeeded(
     }
 }
 
+// El mismo archivo fuente genera KTX2 distintos segun su semantica y espacio de color
+static bool HashTextureSource(
+    const std::string& sourcePath,
+    TEXTURE_TYPE semantic,
+    QEColorSpace colorSpace,
+    uint64_t& outHash)
+{
+    return QEContentIndex::HashTextureSource(sourcePath, static_cast<uint32_t>(semantic), static_cast<uint32_t>(colorSpace), outHash);
+}
+
 void MeshImporter::RecreateNormals(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices)
 {
     for (size_t v = 0; v < vertices.size(); v++)
@@ -164,19 +178,35 @@ void MeshImporter::ExtractBoneWeightForVertices(QEMeshData& data, aiMesh* mesh,
 
 void MeshImporter::RemapGeometry(QEMeshData& data)
 {
-    std::vector<unsigned int> remap(data.NumIndices);
+    const size_t vertexCount = data.Vertices.size();
+    std::vector<unsigned int> remap(vertexCount);
 
     std::vector<uint32_t> resultIndices;
     std::vector<Vertex> resultVertices;
+    std::vector<AnimationVertexData> resultAnimation;
+
+    // Dos vertices solo se funden si tambien coinciden sus huesos y pesos
+    const meshopt_Stream streams[] = {
+        { data.Vertices.data(), sizeof(Vertex), sizeof(Vertex) },
+        { data.AnimationVertexData.data(), sizeof(AnimationVertexData), sizeof(AnimationVertexData) }
+    };
+    const size_t streamCount = data.AnimationVertexData.size() == vertexCount ? 2 : 1;
 
-    size_t total_vertices = meshopt_generateVertexRemap(&remap[0], &data.Indices[0], data.NumIndices, &data.Vertices[0], data.NumIndices, sizeof(Vertex));
+    size_t total_vertices = meshopt_generateVertexRemapMulti(&remap[0], &data.Indices[0], data.NumIndices, vertexCount, streams, streamCount);
 
     data.NumVertices = total_vertices;
     resultIndices.resize(data.NumIndices);
     meshopt_remapIndexBuffer(&resultIndices[0], &data.Indices[0], data.NumIndices, &remap[0]);
 
     resultVertices.resize(total_vertices);
-    meshopt_remapVertexBuffer(&resultVertices[0], &data.Vertices[0], data.NumIndices, sizeof(Vertex), &remap[0]);
+    meshopt_remapVertexBuffer(&resultVertices[0], &data.Vertices[0], vertexCount, sizeof(Vertex), &remap[0]);
+
+    if (streamCount == 2)
+    {
+        resultAnimation.resize(total_vertices);
+        meshopt_remapVertexBuffer(&resultAnimation[0], &data.AnimationVertexData[0], vertexCount, sizeof(AnimationVertexData), &remap[0]);
+        data.AnimationVertexData = resultAnimation;
+    }
 
     data.Indices = resultIndices;
     data.Vertices = resultVertices;
@@ -234,11 +264,12 @@ void MeshImporter::RecreateTangents(std::vector<Vertex>& vertices, std::vector<u
     }
 }
 
-QEMesh MeshImporter::LoadMesh(std::string path)
+QEMesh MeshImporter::LoadMesh(std::string path, bool loadMaterials, bool createMaterials)
 {
     fs::path filepath = fs::path(path);
     std::string name = filepath.stem().string();
-    fs::path matpath = filepath.parent_path().parent_path() / "Materials";
+    // Sin ruta de materiales solo se lee la geometria
+    fs::path matpath = loadMaterials ? filepath.parent_path().parent_path() / "Materials" : fs::path();
 
     QEMesh mesh;
     mesh.Name = name;
@@ -265,7 +296,7 @@ QEMesh MeshImporter::LoadMesh(std::string path)
     glm::vec3 aabbMin = glm::vec3(std::numeric_limits<float>::infinity());
 
     glm::mat4 parentTransform = glm::mat4(1.0f);
-    ProcessNode(scene->mRootNode, scene, parentTransform, mesh, matpath);
+    ProcessNode(scene->mRootNode, scene, parentTransform, mesh, matpath, createMaterials);
 
     mesh.MaterialRel.resize(mesh.MeshData.size());
     for (int i = 0; i < mesh.MeshData.size(); i++)
@@ -276,7 +307,7 @@ QEMesh MeshImporter::LoadMesh(std::string path)
     return mesh;
 }
 
-void MeshImporter::ProcessNode(aiNode* node, const aiScene* scene, glm::mat4 parentTransform, QEMesh& mesh, const fs::path& matpath)
+void MeshImporter::ProcessNode(aiNode* node, const aiScene* scene, glm::mat4 parentTransform, QEMesh& mesh, const fs::path& matpath, bool createMaterials)
 {
     glm::mat4 localTransform = GetGLMMatrix(node->mTransformation);
     glm::mat4 currentTransform = glm::identity<glm::mat4>();
@@ -288,7 +319,7 @@ void MeshImporter::ProcessNode(aiNode* node, const aiScene* scene, glm::mat4 par
         QEMeshData result = ProcessMesh(scene->mMeshes[node->mMeshes[i]], scene, mesh.BonesInfoMap);
         result.ModelTransform = currentTransform;
 
-        ProcessMaterial(scene->mMeshes[node->mMeshes[i]], scene, result, matpath);
+        ProcessMaterial(scene->mMeshes[node->mMeshes[i]], scene, result, matpath, createMaterials);
 
         mesh.MeshData.push_back(result);
     }
@@ -296,7 +327,7 @@ void MeshImporter::ProcessNode(aiNode* node, const aiScene* scene, glm::mat4 par
     // then do the same for each of its children
     for (unsigned int i = 0; i < node->mNumChildren; i++)
     {
-        ProcessNode(node->mChildren[i], scene, currentTransform, mesh, matpath);
+        ProcessNode(node->mChildren[i], scene, currentTransform, mesh, matpath, createMaterials);
     }
 }
 
@@ -461,9 +492,9 @@ glm::mat4 MeshImporter::GetGLMMatrix(aiMatrix4x4 transform)
     return result;
 }
 
-void MeshImporter::ProcessMaterial(aiMesh* mesh, const aiScene* scene, QEMeshData& meshData, const fs::path& matpath)
+void MeshImporter::ProcessMaterial(aiMesh* mesh, const aiScene* scene, QEMeshData& meshData, const fs::path& matpath, bool createMaterials)
 {
-    if (mesh->mMaterialIndex < 0)
+    if (matpath.empty() || mesh->mMaterialIndex < 0)
         return;
 
     aiMaterial* material = scene->mMaterials[mesh->mMaterialIndex];
@@ -477,43 +508,77 @@ void MeshImporter::ProcessMaterial(aiMesh* mesh, const aiScene* scene, QEMeshDat
         rawName = "";
 
     std::string materialName = rawName.C_Str();
-    std::shared_ptr<QEMaterial> mat_ptr;
 
-    auto materialManager = MaterialManager::getInstance();
+    if (createMaterials && !LoadMeshMaterial(materialName, matpath))
+        return;
 
-    if (!materialManager->Exists(materialName))
-    {
-        fs::path materialPath = matpath / (materialName + ".qemat");
+    meshData.MaterialID = materialName;
+    material = nullptr;
+}
 
-        MaterialDto matDto;
-        if (!QEMaterialYamlHelper::ReadMaterialFile(materialPath, matDto))
-        {
-            QE_LOG_ERROR_CAT_F("MeshImporter", "Error opening the material {}", materialPath.string());
-        }
-        else
-        {
-            auto shaderManager = ShaderManager::getInstance();
-            auto shader = shaderManager->GetShader(matDto.ShaderPath);
-            if (shader == nullptr)
-            {
-                QE_LOG_ERROR_CAT_F("MeshImporter", "Shader not found for material {}", materialName);
-                return;
-            }
+bool MeshImporter::LoadMeshMaterial(const std::string& materialName, const fs::path& matpath)
+{
+    auto materialManager = MaterialManager::getInstance();
 
-            matDto.UpdateTexturePaths(matpath);
+    if (materialManager->Exists(materialName))
+        return true;
 
-            mat_ptr = std::make_shared<QEMaterial>(shader, matDto);
-            materialManager->AddMaterial(mat_ptr);
-        }
+    fs::path materialPath = matpath / (materialName + ".qemat");
+    if (!fs::exists(materialPath))
+    {
+        // Material deduplicado al importar: vive en la carpeta de otro modelo
+        const fs::path sharedPath = QEContentIndex::FindMaterialByName(QEProjectManager::GetCurrentProjectPath(), materialName);
+        if (!sharedPath.empty())
+            materialPath = sharedPath;
     }
-    else
+
+    MaterialDto matDto;
+    if (!QEMaterialYamlHelper::ReadMaterialFile(materialPath, matDto))
     {
-        mat_ptr = materialManager->GetMaterial(materialName);
+        QE_LOG_ERROR_CAT_F("MeshImporter", "Error opening the material {}", materialPath.string());
+        return true;
     }
 
-    meshData.MaterialID = materialName;
-    material = nullptr;
+    auto shaderManager = ShaderManager::getInstance();
+    auto shader = shaderManager->GetShader(matDto.ShaderPath);
+    if (shader == nullptr)
+    {
+        QE_LOG_ERROR_CAT_F("MeshImporter", "Shader not found for material {}", materialName);
+        return false;
+    }
+
+    matDto.UpdateTexturePaths(materialPath.parent_path());
+
+    auto mat_ptr = std::make_shared<QEMaterial>(shader, matDto);
+    materialManager->AddMaterial(mat_ptr);
+    return true;
+}
+
+void MeshImporter::LoadMeshMaterials(QEMesh& mesh)
+{
+    const fs::path matpath = fs::path(mesh.FilePath).parent_path().parent_path() / "Materials";
+
+    std::unordered_map<std::string, bool> loaded;
+    for (size_t i = 0; i < mesh.MeshData.size(); ++i)
+    {
+        std::string& materialID = mesh.MeshData[i].MaterialID;
+        if (materialID.empty())
+            continue;
+
+        auto it = loaded.find(materialID);
+        if (it == loaded.end())
+            it = loaded.emplace(materialID, LoadMeshMaterial(materialID, matpath)).first;
+
+        // Igual que con la carga inmediata: sin shader el submesh se queda sin material
+        if (!it->second)
+        {
+            materialID.clear();
+            if (i < mesh.MaterialRel.size())
+                mesh.MaterialRel[i].clear();
+        }
+    }
 }
+
 std::string MeshImporter::GetTextureTypeName(aiTextureType type)
 {
     switch (type) {
@@ -899,6 +964,11 @@ void MeshImporter::ExtractAndUpdateMaterials(
 
     reportKtxProgress();
 
+    uint32_t sharedTextures = 0;
+    uint32_t sharedMaterials = 0;
+    uint64_t bytesSaved = 0;
+    std::unordered_set<uint64_t> countedTextures;
+
     for (unsigned int i = 0; i < scene->mNumMaterials; i++)
     {
         aiMaterial* material = scene->mMaterials[i];
@@ -997,7 +1067,23 @@ void MeshImporter::ExtractAndUpdateMaterials(
             {
                 const bool shouldImport = WouldRequireImport(src);
 
-                ImportMaterialTextureIfNeeded(src, dst, semantic, colorSpace);
+                uint64_t contentHash = 0;
+                const bool hashed = shouldImport && QEContentIndex::Enabled && HashTextureSource(src, semantic, colorSpace, contentHash);
+
+                QEContentEntry shared;
+                if (hashed && QEContentIndex::Find(QEProjectManager::GetCurrentProjectPath(), QEContentKind::Texture, contentHash, shared))
+                {
+                    dst = QEProjectManager::ResolveProjectPath(shared.Path).string();
+                    if (countedTextures.insert(contentHash).second)
+                    {
+                        ++sharedTextures;
+                        bytesSaved += shared.Size;
+                    }
+                }
+                else if (ImportMaterialTextureIfNeeded(src, dst, semantic, colorSpace) && hashed)
+                {
+                    QEContentIndex::Register(QEProjectManager::GetCurrentProjectPath(), QEContentKind::Texture, contentHash, dst);
+                }
 
                 if (shouldImport)
                 {
@@ -1015,6 +1101,36 @@ void MeshImporter::ExtractAndUpdateMaterials(
         importSlot(sourceDiskPaths[6], dto.heightTexturePath, TEXTURE_TYPE::HEIGHT_TYPE, QEColorSpace::Linear);
         importSlot(sourceDiskPaths[7], dto.specularTexturePath, TEXTURE_TYPE::SPECULAR_TYPE, QEColorSpace::Linear);
 
+        // Clave del material: todos sus parametros con las texturas ya resueltas, sin nombre ni ruta propia
+        uint64_t materialHash = 0;
+        if (QEContentIndex::Enabled)
+        {
+            MaterialDto keyDto = dto;
+            keyDto.Name.clear();
+            keyDto.FilePath.clear();
+            for (std::string* texPath : { &keyDto.diffuseTexturePath, &keyDto.normalTexturePath, &keyDto.metallicTexturePath,
+                                          &keyDto.roughnessTexturePath, &keyDto.aoTexturePath, &keyDto.emissiveTexturePath,
+                                          &keyDto.heightTexturePath, &keyDto.specularTexturePath })
+            {
+                *texPath = IsNullTex(*texPath) ? "NULL_TEXTURE" : QEProjectManager::ToProjectRelativePath(*texPath);
+            }
+
+            YAML::Emitter keyOut;
+            keyOut << QEMaterialYamlHelper::SerializeMaterialDto(keyDto);
+            materialHash = QEHelper::HashBytes(keyOut.c_str(), keyOut.size());
+
+            QEContentEntry shared;
+            if (QEContentIndex::Find(QEProjectManager::GetCurrentProjectPath(), QEContentKind::Material, materialHash, shared))
+            {
+                aiString sharedName(shared.Name);
+                material->AddProperty(&sharedName, AI_MATKEY_NAME);
+
+                ++sharedMaterials;
+                bytesSaved += shared.Size;
+                continue;
+            }
+        }
+
         dto.diffuseTexturePath = ToMaterialRelativePath(dto.diffuseTexturePath, materialPath);
         dto.normalTexturePath = ToMaterialRelativePath(dto.normalTexturePath, materialPath);
         dto.metallicTexturePath = ToMaterialRelativePath(dto.metallicTexturePath, materialPath);
@@ -1040,8 +1156,15 @@ void MeshImporter::ExtractAndUpdateMaterials(
             QE_LOG_ERROR_CAT_F("MeshImporter", "Error writing YAML content: {}", materialPath.string());
             continue;
         }
+
+        if (QEContentIndex::Enabled)
+            QEContentIndex::Register(QEProjectManager::GetCurrentProjectPath(), QEContentKind::Material, materialHash, materialPath, materialName);
     }
 
+    QEContentIndex::Save();
+    QE_LOG_INFO_CAT_F("MeshImporter", "Content dedup: {} textures and {} materials shared with the project, {:.2f} MB saved",
+        sharedTextures, sharedMaterials, static_cast<double>(bytesSaved) / (1024.0 * 1024.0));
+
     report(0.85f, "Materials", "Material generation finished");
 }
 
@@ -1085,7 +1208,8 @@ bool MeshImporter::LoadAndExportModel(
     const std::string& outputMaterialPath,
     const std::string& outputTexturePath,
     const std::string& outputAnimationPath,
-    const QEImportProgressCallback& onProgress)
+    const QEImportProgressCallback& onProgress,
+    const QEMeshOptimizationSettings& optimization)
 {
     auto report = [&](float value, const std::string& stage, const std::string& msg)
         {
@@ -1096,6 +1220,10 @@ bool MeshImporter::LoadAndExportModel(
     report(0.02f, "Loading", "Reading source model");
 
     unsigned int flags = aiProcess_EmbedTextures | aiProcess_Triangulate | aiProcess_GenNormals;
+    // Sin vertices duplicados el ACMR y el reordenado de fetch reflejan la malla real
+    if (optimization.Enabled())
+        flags |= aiProcess_JoinIdenticalVertices;
+
     Assimp::Importer importer;
     const aiScene* scene = importer.ReadFile(inputPath, flags);
 
@@ -1164,6 +1292,22 @@ bool MeshImporter::LoadAndExportModel(
 
     SanitizerHelper::SanitizeSceneNames(editableScene);
 
+    if (optimization.Enabled())
+    {
+        report(0.95f, "Mesh", "Optimizing vertex cache, overdraw and vertex fetch");
+
+        QEMeshOptimizationStats before;
+        QEMeshOptimizationStats after;
+        const uint32_t optimizedMeshes = QEMeshOptimizer::OptimizeScene(editableScene, optimization, before, after);
+
+        if (optimizedMeshes > 0)
+        {
+            QE_LOG_INFO_CAT_F("MeshImporter", "Optimized {} meshes of {}", optimizedMeshes, outputMeshPath);
+            QE_LOG_INFO_CAT_F("MeshImporter", "  before: {}", before.ToString());
+            QE_LOG_INFO_CAT_F("MeshImporter", "  after:  {}", after.ToString());
+        }
+    }
+
     if (exporter.Export(editableScene, "gltf2", outputMeshPath) != AI_SUCCESS)
     {
         QE_LOG_ERROR_CAT_F("MeshImporter", "Error exporting to glTF: {}", exporter.GetErrorString());
@@ -1174,6 +1318,17 @@ bool MeshImporter::LoadAndExportModel(
 
     AnimationImporter::DestroyScene(editableScene);
 
+    // Meshlets a partir del glTF exportado, que es exactamente lo que se cargara despues
+    report(0.97f, "Meshlets", "Building meshlets");
+    {
+        QEMesh exportedMesh = LoadMesh(outputMeshPath, false);
+        auto meshlets = QEMeshletCache::Build(exportedMesh, QEMeshletCache::Settings);
+        if (!QEMeshletCache::Save(QEMeshletCache::GetCachePath(outputMeshPath), exportedMesh, meshlets, QEMeshletCache::Settings))
+        {
+            QE_LOG_WARN_CAT_F("MeshImporter", "Meshlets for {} will be built on first load", outputMeshPath);
+        }
+    }
+
     report(1.0f, "Completed", "Import finished");
     QE_LOG_INFO_CAT_F("MeshImporter", "Successful export: {}", outputMeshPath);
     return true;
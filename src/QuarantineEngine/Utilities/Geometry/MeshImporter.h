@@ -14,6 +14,7 @@
 #include <TextureManager.h>
 #include <QEAnimationResources.h>
 #include <QEMeshData.h>
+#include <QEMeshOptimizer.h>
 #include <functional>
 
 using QEImportProgressCallback = std::function<void(float, const std::string&, const std::string&)>;
@@ -24,9 +25,11 @@ class MeshImporter
 {
 private:
     static QEMeshData ProcessMesh(aiMesh* mesh, const aiScene* scene, std::unordered_map<std::string, BoneInfo>& m_BoneInfoMap);
-    static void ProcessNode(aiNode* node, const aiScene* scene, glm::mat4 parentTransform, QEMesh& mesh, const fs::path& matpath);
+    static void ProcessNode(aiNode* node, const aiScene* scene, glm::mat4 parentTransform, QEMesh& mesh, const fs::path& matpath, bool createMaterials);
     static glm::mat4 GetGLMMatrix(aiMatrix4x4 transform);
-    static void ProcessMaterial(aiMesh* mesh, const aiScene* scene, QEMeshData& meshData, const fs::path& matpath);
+    static void ProcessMaterial(aiMesh* mesh, const aiScene* scene, QEMeshData& meshData, const fs::path& matpath, bool createMaterials);
+    /// false si el material existe pero su shader no.
+    static bool LoadMeshMaterial(const std::string& materialName, const fs::path& matpath);
     static void SetVertexBoneDataToDefault(AnimationVertexData& animData);
     static void SetVertexBoneData(AnimationVertexData& animData, int boneID, float weight);
     static void ExtractBoneWeightForVertices(QEMeshData& data, aiMesh* mesh, std::unordered_map<std::string, BoneInfo>& m_BoneInfoMap);
@@ -34,7 +37,11 @@ private:
     static void ComputeAABB(const glm::vec4 & coord, std::pair<glm::vec3, glm::vec3> &AABBData);
 
 public:
-    static QEMesh LoadMesh(std::string path);
+    /// Con loadMaterials a false no toca MaterialManager (apto para hilos de importacion).
+    /// Con createMaterials a false solo anota el MaterialID de cada submesh, sin tocar MaterialManager;
+    /// LoadMeshMaterials crea despues los que falten en el hilo principal.
+    static QEMesh LoadMesh(std::string path, bool loadMaterials = true, bool createMaterials = true);
+    static void LoadMeshMaterials(QEMesh& mesh);
     static QEMeshData LoadRawMesh(float rawData[], unsigned int numData, unsigned int offset);
     static void RecreateNormals(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices);
     static void RecreateTangents(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices);
@@ -64,7 +71,8 @@ public:
         const std::string& outputMaterialPath,
         const std::string& outputTexturePath,
         const std::string& outputAnimationPath,
-        const QEImportProgressCallback& onProgress = nullptr);
+        const QEImportProgressCallback& onProgress = nullptr,
+        const QEMeshOptimizationSettings& optimization = {});
 };
 
 
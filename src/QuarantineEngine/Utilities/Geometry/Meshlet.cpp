@@ -27,6 +27,17 @@ BoundingCone BoundingCone::GetApproximateReflexBoundingCone(
     return cone;
 }
 
+QEMeshletBuildSettings QEMeshletBuildSettings::Clamped() const
+{
+    QEMeshletBuildSettings result = *this;
+    // meshoptimizer pide un maximo de triangulos multiplo de 4
+    result.MaxTriangles = glm::clamp(this->MaxTriangles, 4u, Meshlet::MESHLET_TRIANGLE_SLOTS) & ~3u;
+    result.MaxVertices = glm::clamp(this->MaxVertices, 3u, Meshlet::MESHLET_TRIANGLE_SLOTS * 3u);
+    result.ConeWeight = glm::clamp(this->ConeWeight, 0.0f, 1.0f);
+    result.MaxLods = glm::clamp(this->MaxLods, 1u, Meshlet::MESHLET_MAX_LODS);
+    return result;
+}
+
 AxisAlignedBoundingBox::AxisAlignedBoundingBox(
     std::vector<glm::vec4*>& vertices)
 {
@@ -115,6 +126,8 @@ void Meshlet::GenerateCustomMeshlet(std::vector<Vertex>& vertices, std::vector<u
                 meshlet_normals);
 
         bounding_cone.position = glm::vec4(bounding_sphere.center, 1.0f);
+        // Mismo convenio que meshoptimizer: angle guarda el coseno de corte (1 = nunca se descarta)
+        bounding_cone.angle = bounding_cone.angle < glm::half_pi<float>() ? glm::sin(bounding_cone.angle) : 1.0f;
 
         gpuMeshlets.push_back(
             MeshletDescriptor{ .sphere = bounding_sphere,
@@ -123,25 +136,29 @@ void Meshlet::GenerateCustomMeshlet(std::vector<Vertex>& vertices, std::vector<u
 
         i_face_from += this->meshlet_primitive_count;
     }
-}
 
-void Meshlet::GenerateMeshlet(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices)
-{
-    size_t max_meshlets;
-    size_t meshlets_count;
-    std::vector<meshopt_Meshlet> meshlets;
-    std::vector<unsigned int> meshlet_vertices_indices;
-    std::vector<unsigned char> meshlet_triangles;
+    // El mesh shader lee siempre MESHLET_TRIANGLE_SLOTS primitivas por meshlet y 32 meshlets por grupo
+    this->indexData.resize(meshlet_count * MESHLET_TRIANGLE_SLOTS * 3, 0u);
+    while (this->gpuMeshlets.size() % MESHLET_GROUP_SIZE)
+    {
+        this->gpuMeshlets.push_back(MeshletDescriptor());
+        this->indexData.resize(this->indexData.size() + MESHLET_TRIANGLE_SLOTS * 3, 0u);
+    }
 
-    this->verticesData = vertices;
-    this->indexData = indices;
+    MeshletLodRange range{};
+    range.MeshletCount = static_cast<uint32_t>(this->gpuMeshlets.size());
+    range.TriangleCount = static_cast<uint32_t>(num_faces);
+    this->lods = { range };
+}
 
-    max_meshlets = meshopt_buildMeshletsBound(indices.size(), this->MAX_VERTICES, this->MAX_TRIANGLES);
-    meshlets = std::vector<meshopt_Meshlet>(max_meshlets);
-    meshlet_vertices_indices = std::vector<unsigned int>(max_meshlets * this->MAX_VERTICES);
-    meshlet_triangles = std::vector<unsigned char>(max_meshlets * this->MAX_TRIANGLES * 3);
+void Meshlet::AppendLod(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices, float error, const QEMeshletBuildSettings& settings)
+{
+    const size_t max_meshlets = meshopt_buildMeshletsBound(indices.size(), settings.MaxVertices, settings.MaxTriangles);
+    std::vector<meshopt_Meshlet> meshlets(max_meshlets);
+    std::vector<unsigned int> meshlet_vertices_indices(max_meshlets * settings.MaxVertices);
+    std::vector<unsigned char> meshlet_triangles(max_meshlets * settings.MaxTriangles * 3);
 
-    meshlets_count = meshopt_buildMeshlets(
+    const size_t meshlets_count = meshopt_buildMeshlets(
         meshlets.data(),
         meshlet_vertices_indices.data(),
         meshlet_triangles.data(),
@@ -150,11 +167,16 @@ void Meshlet::GenerateMeshlet(const std::vector<Vertex>& vertices, const std::ve
         &vertices[0].Position.x,
         vertices.size(),
         sizeof(Vertex),
-        this->MAX_VERTICES,
-        this->MAX_TRIANGLES,
-        0.5f);
+        settings.MaxVertices,
+        settings.MaxTriangles,
+        settings.ConeWeight);
     meshlets.resize(meshlets_count);
 
+    MeshletLodRange range{};
+    range.FirstMeshlet = static_cast<uint32_t>(this->gpuMeshlets.size());
+    range.TriangleCount = static_cast<uint32_t>(indices.size() / 3);
+    range.Error = error;
+
     for (size_t i = 0; i < meshlets_count; ++i)
     {
         const meshopt_Meshlet& local_meshlet = meshlets[i];
@@ -170,27 +192,93 @@ void Meshlet::GenerateMeshlet(const std::vector<Vertex>& vertices, const std::ve
 
         MeshletDescriptor newMeshlet = {};
 
-        BoundingSphere bounding_sphere{
+        newMeshlet.sphere = BoundingSphere{
             .center = glm::vec3(bounds.center[0], bounds.center[1], bounds.center[2]),
             .radius = bounds.radius
         };
 
-        BoundingCone bounding_cone
-        {
+        newMeshlet.cone = BoundingCone{
             .normal = glm::vec3(bounds.cone_axis[0], bounds.cone_axis[1], bounds.cone_axis[2]),
             .angle = bounds.cone_cutoff,
             .position = glm::vec4(bounds.cone_apex[0], bounds.cone_apex[1], bounds.cone_apex[2], 1.0f)
         };
 
-        newMeshlet.cone = bounding_cone;
-        newMeshlet.sphere = bounding_sphere;
-        newMeshlet.primitive_count = static_cast<uint16_t>(local_meshlet.triangle_count);
+        newMeshlet.primitive_count = local_meshlet.triangle_count;
 
         this->gpuMeshlets.push_back(newMeshlet);
+
+        // Indices globales de los triangulos del meshlet, rellenando hasta MESHLET_TRIANGLE_SLOTS
+        for (size_t tri = 0; tri < MESHLET_TRIANGLE_SLOTS; ++tri)
+        {
+            for (size_t corner = 0; corner < 3; ++corner)
+            {
+                uint32_t index = meshlet_vertices_indices[local_meshlet.vertex_offset];
+                if (tri < local_meshlet.triangle_count)
+                {
+                    const unsigned char local = meshlet_triangles[local_meshlet.triangle_offset + tri * 3 + corner];
+                    index = meshlet_vertices_indices[local_meshlet.vertex_offset + local];
+                }
+                this->indexData.push_back(index);
+            }
+        }
     }
 
-    while (gpuMeshlets.size() % 32)
+    while (this->gpuMeshlets.size() % MESHLET_GROUP_SIZE)
     {
-        gpuMeshlets.push_back(MeshletDescriptor());
+        this->gpuMeshlets.push_back(MeshletDescriptor());
+        this->indexData.resize(this->indexData.size() + MESHLET_TRIANGLE_SLOTS * 3, 0u);
+    }
+
+    range.MeshletCount = static_cast<uint32_t>(this->gpuMeshlets.size()) - range.FirstMeshlet;
+    this->lods.push_back(range);
+}
+
+void Meshlet::GenerateMeshlet(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices, const QEMeshletBuildSettings& buildSettings)
+{
+    const QEMeshletBuildSettings settings = buildSettings.Clamped();
+
+    this->verticesData = vertices;
+    this->indexData.clear();
+    this->gpuMeshlets.clear();
+    this->lods.clear();
+
+    if (vertices.empty() || indices.size() < 3)
+        return;
+
+    const float* positions = &vertices[0].Position.x;
+    const float meshScale = meshopt_simplifyScale(positions, vertices.size(), sizeof(Vertex));
+
+    // Cadena de LODs: cada nivel intenta quedarse con la mitad de triangulos del anterior
+    std::vector<uint32_t> lodIndices = indices;
+    float lodError = 0.0f;
+
+    for (uint32_t lod = 0; lod < settings.MaxLods; ++lod)
+    {
+        this->AppendLod(vertices, lodIndices, lodError * meshScale, settings);
+
+        const size_t targetIndexCount = (lodIndices.size() / 6) * 3;
+        if (lod + 1 == settings.MaxLods || targetIndexCount < this->MIN_LOD_TRIANGLES * 3)
+            break;
+
+        std::vector<uint32_t> simplified(lodIndices.size());
+        float error = 0.0f;
+        simplified.resize(meshopt_simplify(
+            simplified.data(),
+            lodIndices.data(),
+            lodIndices.size(),
+            positions,
+            vertices.size(),
+            sizeof(Vertex),
+            targetIndexCount,
+            this->LOD_TARGET_ERROR,
+            0,
+            &error));
+
+        // Si la simplificacion apenas reduce, los niveles siguientes no aportan nada
+        if (simplified.empty() || simplified.size() > lodIndices.size() * 85 / 100)
+            break;
+
+        lodError += error;
+        lodIndices.swap(simplified);
     }
 }
@@ -27,7 +27,31 @@ struct MeshletDescriptor
 {
     BoundingSphere sphere;
     BoundingCone cone;
-    uint16_t primitive_count;
+    uint32_t primitive_count;   // 0 = relleno hasta completar el grupo de 32 del task shader
+};
+
+/// Rango de meshlets de un nivel de detalle. Cada rango empieza y acaba en multiplo de
+/// MESHLET_GROUP_SIZE para que un workgroup del task shader nunca mezcle niveles.
+struct MeshletLodRange
+{
+    uint32_t FirstMeshlet = 0;
+    uint32_t MeshletCount = 0;      // Incluye el relleno
+    uint32_t TriangleCount = 0;
+    float Error = 0.0f;             // Error geometrico respecto a LOD0, en unidades del modelo
+};
+
+/// Limites con los que se construyen los meshlets; se guardan en la cache para reconstruirla si
+/// cambian. Se pueden ajustar por GPU destino, pero mesh.mesh lee siempre MESHLET_TRIANGLE_SLOTS
+/// primitivas y escribe 3 vertices por primitiva, asi que Clamped() los limita a eso.
+struct QEMeshletBuildSettings
+{
+    uint32_t MaxVertices = 96;
+    uint32_t MaxTriangles = 32;
+    float ConeWeight = 0.5f;
+    uint32_t MaxLods = 4;
+
+    QEMeshletBuildSettings Clamped() const;
+    bool operator==(const QEMeshletBuildSettings& other) const = default;
 };
 
 class AxisAlignedBoundingBox
@@ -54,18 +78,27 @@ private:
     const uint16_t meshlet_primitive_count = 32;
 
 private:
-    const size_t MAX_VERTICES = 96;
-    const size_t MAX_TRIANGLES = 32;
-    const float CONE_WEIGHT = 0.5f;
+    const size_t MIN_LOD_TRIANGLES = 256;
+    const float LOD_TARGET_ERROR = 0.02f;
 
 public:
+    static constexpr uint32_t MESHLET_GROUP_SIZE = 32;
+    static constexpr uint32_t MESHLET_TRIANGLE_SLOTS = 32;
+    static constexpr uint32_t MESHLET_MAX_LODS = 4;
+
     std::vector<MeshletDescriptor> gpuMeshlets;
     std::vector<uint32_t> meshletData;
     std::vector<Vertex> verticesData;
+    // Triangulos en orden de meshlet: MESHLET_TRIANGLE_SLOTS por meshlet (los que faltan, degenerados),
+    // que es como los lee mesh.mesh (primitiva = meshlet * 32 + invocacion)
     std::vector<uint32_t> indexData;
+    std::vector<MeshletLodRange> lods;
+
+private:
+    void AppendLod(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices, float error, const QEMeshletBuildSettings& settings);
 
 public:
-    void GenerateMeshlet(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices);
+    void GenerateMeshlet(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices, const QEMeshletBuildSettings& settings = QEMeshletBuildSettings());
     void GenerateCustomMeshlet(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices);
 };
 
@@ -76,6 +109,8 @@ namespace QE
     using ::BoundingSphere;
     using ::BoundingCone;
     using ::MeshletDescriptor;
+    using ::MeshletLodRange;
+    using ::QEMeshletBuildSettings;
     using ::AxisAlignedBoundingBox;
     using ::Meshlet;
 } // namespace QE
@@ -0,0 +1,246 @@
+#include "QEBVH.h"
+
+#include <algorithm>
+#include <array>
+#include <limits>
+
+namespace
+{
+    struct BuildBounds
+    {
+        glm::vec3 Min = glm::vec3(std::numeric_limits<float>::max());
+        glm::vec3 Max = glm::vec3(-std::numeric_limits<float>::max());
+
+        void Grow(const glm::vec3& pMin, const glm::vec3& pMax)
+        {
+            Min = glm::min(Min, pMin);
+            Max = glm::max(Max, pMax);
+        }
+
+        float HalfArea() const
+        {
+            const glm::vec3 e = Max - Min;
+            if (e.x < 0.0f)
+                return 0.0f;
+            return e.x * e.y + e.y * e.z + e.z * e.x;
+        }
+    };
+
+    struct BuildTask
+    {
+        uint32_t Node = 0;
+        uint32_t Depth = 0;
+    };
+}
+
+void QEBVH::Clear()
+{
+    nodes.clear();
+    primitiveOrder.clear();
+}
+
+void QEBVH::Build(const std::vector<glm::vec3>& primitiveMin, const std::vector<glm::vec3>& primitiveMax)
+{
+    this->Clear();
+
+    const uint32_t primitiveCount = static_cast<uint32_t>(std::min(primitiveMin.size(), primitiveMax.size()));
+    if (primitiveCount == 0)
+        return;
+
+    primitiveOrder.resize(primitiveCount);
+    std::vector<glm::vec3> centroids(primitiveCount);
+    for (uint32_t i = 0; i < primitiveCount; ++i)
+    {
+        primitiveOrder[i] = i;
+        centroids[i] = (primitiveMin[i] + primitiveMax[i]) * 0.5f;
+    }
+
+    nodes.reserve(2 * primitiveCount / MAX_LEAF_SIZE + 1);
+    nodes.push_back({});
+    nodes[0].LeftOrFirst = 0;
+    nodes[0].Count = primitiveCount;
+
+    std::vector<BuildTask> tasks;
+    tasks.push_back({ 0, 0 });
+
+    while (!tasks.empty())
+    {
+        const BuildTask task = tasks.back();
+        tasks.pop_back();
+
+        const uint32_t first = nodes[task.Node].LeftOrFirst;
+        const uint32_t count = nodes[task.Node].Count;
+
+        BuildBounds bounds;
+        BuildBounds centroidBounds;
+        for (uint32_t i = first; i < first + count; ++i)
+        {
+            const uint32_t prim = primitiveOrder[i];
+            bounds.Grow(primitiveMin[prim], primitiveMax[prim]);
+            centroidBounds.Grow(centroids[prim], centroids[prim]);
+        }
+
+        nodes[task.Node].Min = bounds.Min;
+        nodes[task.Node].Max = bounds.Max;
+
+        if (count <= MAX_LEAF_SIZE || task.Depth + 1 >= MAX_DEPTH)
+            continue;
+
+        // SAH por bins: para cada eje se reparten los centroides en SAH_BIN_COUNT bins
+        float bestCost = std::numeric_limits<float>::max();
+        int bestAxis = -1;
+        uint32_t bestSplit = 0;
+
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            const float axisMin = centroidBounds.Min[axis];
+            const float axisExtent = centroidBounds.Max[axis] - axisMin;
+            if (axisExtent <= 0.0f)
+                continue;
+
+            std::array<BuildBounds, SAH_BIN_COUNT> bins{};
+            std::array<uint32_t, SAH_BIN_COUNT> binCounts{};
+            const float binScale = SAH_BIN_COUNT / axisExtent;
+
+            for (uint32_t i = first; i < first + count; ++i)
+            {
+                const uint32_t prim = primitiveOrder[i];
+                const uint32_t bin = std::min(SAH_BIN_COUNT - 1, static_cast<uint32_t>((centroids[prim][axis] - axisMin) * binScale));
+                bins[bin].Grow(primitiveMin[prim], primitiveMax[prim]);
+                ++binCounts[bin];
+            }
+
+            // Barrido izquierda -> derecha y derecha -> izquierda para obtener el coste de cada plano
+            std::array<float, SAH_BIN_COUNT - 1> leftArea{};
+            std::array<uint32_t, SAH_BIN_COUNT - 1> leftCount{};
+            BuildBounds leftBounds;
+            uint32_t leftSum = 0;
+            for (uint32_t i = 0; i < SAH_BIN_COUNT - 1; ++i)
+            {
+                leftSum += binCounts[i];
+                if (binCounts[i] > 0)
+                    leftBounds.Grow(bins[i].Min, bins[i].Max);
+                leftCount[i] = leftSum;
+                leftArea[i] = leftBounds.HalfArea();
+            }
+
+            BuildBounds rightBounds;
+            uint32_t rightSum = 0;
+            for (uint32_t i = SAH_BIN_COUNT - 1; i > 0; --i)
+            {
+                rightSum += binCounts[i];
+                if (binCounts[i] > 0)
+                    rightBounds.Grow(bins[i].Min, bins[i].Max);
+
+                if (leftCount[i - 1] == 0 || rightSum == 0)
+                    continue;
+
+                const float cost = leftArea[i - 1] * leftCount[i - 1] + rightBounds.HalfArea() * rightSum;
+                if (cost < bestCost)
+                {
+                    bestCost = cost;
+                    bestAxis = axis;
+                    bestSplit = i;
+                }
+            }
+        }
+
+        // Sin plano valido (centroides coincidentes) o partir sale mas caro que la hoja
+        const float leafCost = bounds.HalfArea() * count;
+        if (bestAxis < 0 || (bestCost >= leafCost && count <= 4 * MAX_LEAF_SIZE))
+            continue;
+
+        const float axisMin = centroidBounds.Min[bestAxis];
+        const float binScale = SAH_BIN_COUNT / (centroidBounds.Max[bestAxis] - axisMin);
+
+        auto middleIt = std::partition(
+            primitiveOrder.begin() + first,
+            primitiveOrder.begin() + first + count,
+            [&](uint32_t prim)
+            {
+                const uint32_t bin = std::min(SAH_BIN_COUNT - 1, static_cast<uint32_t>((centroids[prim][bestAxis] - axisMin) * binScale));
+                return bin < bestSplit;
+            });
+
+        const uint32_t leftCountFinal = static_cast<uint32_t>(middleIt - (primitiveOrder.begin() + first));
+        if (leftCountFinal == 0 || leftCountFinal == count)
+            continue;
+
+        const uint32_t leftChild = static_cast<uint32_t>(nodes.size());
+        nodes.push_back({});
+        nodes.push_back({});
+
+        nodes[leftChild].LeftOrFirst = first;
+        nodes[leftChild].Count = leftCountFinal;
+        nodes[leftChild + 1].LeftOrFirst = first + leftCountFinal;
+        nodes[leftChild + 1].Count = count - leftCountFinal;
+
+        nodes[task.Node].LeftOrFirst = leftChild;
+        nodes[task.Node].Count = 0;
+
+        tasks.push_back({ leftChild, task.Depth + 1 });
+        tasks.push_back({ leftChild + 1, task.Depth + 1 });
+    }
+
+    nodes.shrink_to_fit();
+}
+
+glm::vec3 QEBVH::ComputeInverseDirection(const glm::vec3& direction)
+{
+    constexpr float minComponent = 1e-20f;
+    glm::vec3 result;
+    for (int axis = 0; axis < 3; ++axis)
+    {
+        const float d = direction[axis];
+        result[axis] = 1.0f / (std::fabs(d) > minComponent ? d : std::copysign(minComponent, d));
+    }
+    return result;
+}
+
+bool QEBVH::IntersectAABB(const QERay& ray, const glm::vec3& invDirection, const glm::vec3& aabbMin, const glm::vec3& aabbMax, float maxT, float& outTMin)
+{
+    const glm::vec3 t0 = (aabbMin - ray.Origin) * invDirection;
+    const glm::vec3 t1 = (aabbMax - ray.Origin) * invDirection;
+    const glm::vec3 tNear = glm::min(t0, t1);
+    const glm::vec3 tFar = glm::max(t0, t1);
+
+    const float tMin = std::max(std::max(tNear.x, tNear.y), std::max(tNear.z, 0.0f));
+    const float tMax = std::min(std::min(tFar.x, tFar.y), std::min(tFar.z, maxT));
+
+    if (tMax < tMin)
+        return false;
+
+    outTMin = tMin;
+    return true;
+}
+
+bool QEBVH::IntersectTriangle(const QERay& ray, const glm::vec3& v0, const glm::vec3& v1, const glm::vec3& v2, float& outT)
+{
+    const glm::vec3 edge1 = v1 - v0;
+    const glm::vec3 edge2 = v2 - v0;
+
+    const glm::vec3 pvec = glm::cross(ray.Direction, edge2);
+    const float det = glm::dot(edge1, pvec);
+
+    if (std::fabs(det) < 1e-12f)
+        return false;
+
+    const float invDet = 1.0f / det;
+    const glm::vec3 tvec = ray.Origin - v0;
+
+    const float u = glm::dot(tvec, pvec) * invDet;
+    if (u < 0.0f || u > 1.0f)
+        return false;
+
+    const glm::vec3 qvec = glm::cross(tvec, edge1);
+    const float v = glm::dot(ray.Direction, qvec) * invDet;
+    if (v < 0.0f || (u + v) > 1.0f)
+        return false;
+
+    const float t = glm::dot(edge2, qvec) * invDet;
+    if (t < 0.0f)
+        return false;
+
+    outT = t;
+    return true;
+}
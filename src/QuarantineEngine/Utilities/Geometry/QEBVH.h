@@ -0,0 +1,138 @@
+#pragma once
+
+#ifndef QE_BVH_H
+#define QE_BVH_H
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+
+struct QERay
+{
+    glm::vec3 Origin{ 0.0f };
+    glm::vec3 Direction{ 0.0f, 0.0f, -1.0f };
+};
+
+/// Nodo de 32 bytes. Count > 0: hoja con [LeftOrFirst, LeftOrFirst + Count) en GetPrimitiveOrder().
+/// Count == 0: nodo interno con hijos LeftOrFirst y LeftOrFirst + 1.
+struct QEBVHNode
+{
+    glm::vec3 Min{ 0.0f };
+    uint32_t LeftOrFirst = 0;
+    glm::vec3 Max{ 0.0f };
+    uint32_t Count = 0;
+};
+
+/// BVH binario sobre AABBs de primitivas, construido con SAH por bins.
+/// Lo usan tanto el BVH de triangulos de cada malla como el BVH de objetos de la escena.
+class QEBVH
+{
+public:
+    static constexpr uint32_t SAH_BIN_COUNT = 12;
+    static constexpr uint32_t MAX_LEAF_SIZE = 4;
+    static constexpr uint32_t MAX_DEPTH = 64;
+
+private:
+    std::vector<QEBVHNode> nodes;
+    std::vector<uint32_t> primitiveOrder;
+
+public:
+    void Build(const std::vector<glm::vec3>& primitiveMin, const std::vector<glm::vec3>& primitiveMax);
+    void Clear();
+
+    bool Empty() const { return nodes.empty(); }
+    const std::vector<QEBVHNode>& GetNodes() const { return nodes; }
+    const std::vector<uint32_t>& GetPrimitiveOrder() const { return primitiveOrder; }
+    size_t GetMemorySize() const { return nodes.size() * sizeof(QEBVHNode) + primitiveOrder.size() * sizeof(uint32_t); }
+
+    /// Recorre los nodos que corta el rayo en [0, maxT], el hijo mas cercano primero.
+    /// leafFn(primitiveIndex, maxT) puede reducir maxT para podar el resto del recorrido.
+    template<typename LeafFn>
+    void Traverse(const QERay& ray, float& maxT, LeafFn&& leafFn) const;
+
+    static glm::vec3 ComputeInverseDirection(const glm::vec3& direction);
+    static bool IntersectAABB(const QERay& ray, const glm::vec3& invDirection, const glm::vec3& aabbMin, const glm::vec3& aabbMax, float maxT, float& outTMin);
+    /// Moller-Trumbore. La direccion no tiene por que estar normalizada: t se mide en unidades de Direction.
+    static bool IntersectTriangle(const QERay& ray, const glm::vec3& v0, const glm::vec3& v1, const glm::vec3& v2, float& outT);
+};
+
+template<typename LeafFn>
+void QEBVH::Traverse(const QERay& ray, float& maxT, LeafFn&& leafFn) const
+{
+    if (nodes.empty())
+        return;
+
+    const glm::vec3 invDirection = ComputeInverseDirection(ray.Direction);
+
+    float rootT = 0.0f;
+    if (!IntersectAABB(ray, invDirection, nodes[0].Min, nodes[0].Max, maxT, rootT))
+        return;
+
+    // Build limita la profundidad a MAX_DEPTH: la pila nunca desborda
+    uint32_t stack[MAX_DEPTH];
+    float stackT[MAX_DEPTH];
+    uint32_t stackSize = 0;
+    uint32_t nodeIndex = 0;
+
+    while (true)
+    {
+        const QEBVHNode& node = nodes[nodeIndex];
+
+        if (node.Count > 0)
+        {
+            for (uint32_t i = 0; i < node.Count; ++i)
+            {
+                leafFn(primitiveOrder[node.LeftOrFirst + i], maxT);
+            }
+        }
+        else
+        {
+            const uint32_t left = node.LeftOrFirst;
+            const uint32_t right = node.LeftOrFirst + 1;
+
+            float leftT = 0.0f;
+            float rightT = 0.0f;
+            const bool hitLeft = IntersectAABB(ray, invDirection, nodes[left].Min, nodes[left].Max, maxT, leftT);
+            const bool hitRight = IntersectAABB(ray, invDirection, nodes[right].Min, nodes[right].Max, maxT, rightT);
+
+            if (hitLeft && hitRight)
+            {
+                const bool leftFirst = leftT <= rightT;
+                stack[stackSize] = leftFirst ? right : left;
+                stackT[stackSize] = leftFirst ? rightT : leftT;
+                ++stackSize;
+                nodeIndex = leftFirst ? left : right;
+                continue;
+            }
+
+            if (hitLeft || hitRight)
+            {
+                nodeIndex = hitLeft ? left : right;
+                continue;
+            }
+        }
+
+        // Los nodos apilados que quedan mas lejos que el mejor impacto se descartan
+        while (stackSize > 0 && stackT[stackSize - 1] > maxT)
+        {
+            --stackSize;
+        }
+
+        if (stackSize == 0)
+            break;
+
+        nodeIndex = stack[--stackSize];
+    }
+}
+
+
+
+namespace QE
+{
+    using ::QERay;
+    using ::QEBVHNode;
+    using ::QEBVH;
+} // namespace QE
+// QE namespace aliases
+#endif // !QE_BVH_H
@@ -16,6 +16,11 @@ QEMesh* QEGeometryComponent::GetMesh()
     return &geometryResource->Mesh;
 }
 
+const QEMeshBVH* QEGeometryComponent::GetTriangleBVH() const
+{
+    return geometryResource ? geometryResource->GetTriangleBVH() : nullptr;
+}
+
 size_t QEGeometryComponent::GetIndicesCount(uint32_t meshIndex) const
 {
     if (!geometryResource || meshIndex >= geometryResource->Mesh.MeshData.size())
@@ -270,21 +275,26 @@ void QEGeometryComponent::CreateGeometryBuffer(VkDeviceSize bufferSize, VkBuffer
 }
 
 std::string QEGeometryComponent::BuildResourceKey() const
+{
+    return BuildResourceKey(_name, _filepath);
+}
+
+std::string QEGeometryComponent::BuildResourceKey(const std::string& name, const std::string& filepath)
 {
     namespace fs = std::filesystem;
 
-    if (_filepath == "QECore")
+    if (filepath == "QECore")
     {
-        return "QECore::" + _name;
+        return "QECore::" + name;
     }
 
-    if (_filepath.empty())
+    if (filepath.empty())
     {
         return {};
     }
 
     std::error_code ec;
-    fs::path meshPath = fs::path(_filepath);
+    fs::path meshPath = fs::path(filepath);
     fs::path canonicalPath = fs::weakly_canonical(meshPath, ec);
     if (ec)
     {
@@ -58,10 +58,17 @@ public:
     void BuildMesh();
 
     QEMesh* GetMesh();
+    /// BVH de triangulos compartido por todas las instancias de la malla; nullptr si aun no esta listo.
+    const QEMeshBVH* GetTriangleBVH() const;
 
     size_t GetIndicesCount(uint32_t meshIndex) const;
 
+    const std::string& GetMeshName() const { return _name; }
+    const std::string& GetMeshFilePath() const { return _filepath; }
+
     static std::unique_ptr<IQEMeshGenerator> GetGenerator(std::string name, std::string filepath);
+    /// Clave de QEGeometryResourceCache: "QECore::<primitiva>" o la ruta canonica del archivo.
+    static std::string BuildResourceKey(const std::string& name, const std::string& filepath);
 
 private:
     void CreateMeshlets();
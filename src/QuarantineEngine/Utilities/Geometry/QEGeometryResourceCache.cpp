@@ -3,56 +3,231 @@
 #include <BufferManageModule.h>
 #include <DeviceModule.h>
 #include <Helpers/QEMemoryTrack.h>
+#include <QEMeshletCache.h>
+#include <SyncTool.h>
+#include <Logging/QELogMacros.h>
+#include <algorithm>
+#include <condition_variable>
 #include <cstring>
+#include <deque>
 #include <stdexcept>
+#include <thread>
 
 std::unordered_map<std::string, std::weak_ptr<QEGeometrySharedResource>> QEGeometryResourceCache::cache;
 std::mutex QEGeometryResourceCache::cacheMutex;
 
 namespace
 {
-    QEGeometryBufferAllocation CreateBufferAllocation(
-        VkDeviceSize bufferSize,
-        VkBufferUsageFlags usageFlags,
-        const void* dataArray,
-        DeviceModule& deviceModule)
+    // Por encima de este tamano AcquireBuilt sube lo acumulado antes de seguir
+    constexpr VkDeviceSize MAX_UPLOAD_BATCH_BYTES = 256ull * 1024ull * 1024ull;
+    constexpr VkDeviceSize UPLOAD_ALIGNMENT = 16;
+
+    /// Construccion de los BVH de triangulos en un numero fijo de hilos (hardware_concurrency - 1),
+    /// no un hilo por malla: una escena con cientos de mallas solo encola trabajos.
+    class TriangleBVHQueue
     {
-        QEGeometryBufferAllocation allocation{};
+    private:
+        using BVHPromise = std::promise<std::shared_ptr<QEMeshBVH>>;
 
-        if (bufferSize == 0 || dataArray == nullptr)
+        struct Job
         {
-            return allocation;
+            const QEGeometrySharedResource* Owner = nullptr;
+            const QEMesh* Mesh = nullptr;
+            BVHPromise Promise;
+        };
+
+        std::mutex mutex;
+        std::condition_variable ready;
+        std::deque<Job> jobs;
+        std::vector<std::thread> workers;
+        bool running = true;
+
+        void WorkerLoop()
+        {
+            while (true)
+            {
+                Job job;
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    ready.wait(lock, [this]() { return !running || !jobs.empty(); });
+                    if (!running)
+                        return;
+
+                    job = std::move(jobs.front());
+                    jobs.pop_front();
+                }
+
+                // Sin BVH los raycasts recorren todos los triangulos: un fallo no se propaga
+                std::shared_ptr<QEMeshBVH> bvh;
+                try
+                {
+                    bvh = QEMeshBVH::Build(*job.Mesh);
+                }
+                catch (const std::exception& e)
+                {
+                    QE_LOG_ERROR_CAT_F("QEGeometryResourceCache", "Triangle BVH build failed for {} ({})", job.Mesh->Name, e.what());
+                }
+                job.Promise.set_value(std::move(bvh));
+            }
         }
 
-        VkBuffer stagingBuffer = VK_NULL_HANDLE;
-        VkDeviceMemory stagingBufferMemory = VK_NULL_HANDLE;
-        BufferManageModule::createBuffer(
-            bufferSize,
-            VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-            stagingBuffer,
-            stagingBufferMemory,
-            deviceModule);
+    public:
+        ~TriangleBVHQueue()
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                running = false;
+            }
+            ready.notify_all();
 
-        void* data = nullptr;
-        vkMapMemory(deviceModule.device, stagingBufferMemory, 0, bufferSize, 0, &data);
-        std::memcpy(data, dataArray, static_cast<size_t>(bufferSize));
-        vkUnmapMemory(deviceModule.device, stagingBufferMemory);
+            for (auto& worker : workers)
+            {
+                worker.join();
+            }
+        }
 
-        BufferManageModule::createBuffer(
-            bufferSize,
-            usageFlags,
-            VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
-            allocation.Buffer,
-            allocation.Memory,
-            deviceModule);
-        BufferManageModule::copyBuffer(stagingBuffer, allocation.Buffer, bufferSize, deviceModule);
+        static TriangleBVHQueue& Get()
+        {
+            static TriangleBVHQueue queue;
+            return queue;
+        }
 
-        QE_DESTROY_BUFFER(deviceModule.device, stagingBuffer, "QEGeometryResourceCache::CreateBufferAllocation");
-        QE_FREE_MEMORY(deviceModule.device, stagingBufferMemory, "QEGeometryResourceCache::CreateBufferAllocation");
+        std::shared_future<std::shared_ptr<QEMeshBVH>> Enqueue(const QEGeometrySharedResource* owner, const QEMesh* mesh)
+        {
+            Job job;
+            job.Owner = owner;
+            job.Mesh = mesh;
+            auto future = job.Promise.get_future().share();
 
-        return allocation;
-    }
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (workers.empty())
+                {
+                    const uint32_t workerCount = std::max(2u, std::thread::hardware_concurrency()) - 1;
+                    workers.reserve(workerCount);
+                    for (uint32_t i = 0; i < workerCount; ++i)
+                    {
+                        workers.emplace_back(&TriangleBVHQueue::WorkerLoop, this);
+                    }
+                }
+                jobs.push_back(std::move(job));
+            }
+            ready.notify_one();
+
+            return future;
+        }
+
+        /// Quita el trabajo de owner si aun no ha empezado; si ya esta en marcha espera a que termine.
+        void Cancel(const QEGeometrySharedResource* owner, const std::shared_future<std::shared_ptr<QEMeshBVH>>& future)
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                auto it = std::find_if(jobs.begin(), jobs.end(), [owner](const Job& job) { return job.Owner == owner; });
+                if (it != jobs.end())
+                {
+                    jobs.erase(it);
+                    return;
+                }
+            }
+
+            if (future.valid())
+            {
+                future.wait();
+            }
+        }
+    };
+
+    /// Copias de varios buffers de geometria con un solo staging y un solo envio.
+    class GeometryUploadBatch
+    {
+    private:
+        struct Upload
+        {
+            VkDeviceSize Offset = 0;
+            VkDeviceSize Size = 0;
+            VkBufferUsageFlags Usage = 0;
+            const void* Data = nullptr;
+            QEGeometryBufferAllocation* Target = nullptr;
+        };
+
+        std::vector<Upload> uploads;
+        VkDeviceSize totalBytes = 0;
+
+    public:
+        /// 'data' y 'target' tienen que seguir vivos hasta Submit.
+        void Add(VkDeviceSize size, VkBufferUsageFlags usage, const void* data, QEGeometryBufferAllocation& target)
+        {
+            if (size == 0 || data == nullptr)
+            {
+                return;
+            }
+
+            Upload upload;
+            upload.Offset = (totalBytes + UPLOAD_ALIGNMENT - 1) & ~(UPLOAD_ALIGNMENT - 1);
+            upload.Size = size;
+            upload.Usage = usage;
+            upload.Data = data;
+            upload.Target = &target;
+            uploads.push_back(upload);
+
+            totalBytes = upload.Offset + size;
+        }
+
+        VkDeviceSize Bytes() const { return totalBytes; }
+
+        void Submit(DeviceModule& deviceModule)
+        {
+            if (uploads.empty())
+            {
+                return;
+            }
+
+            VkBuffer stagingBuffer = VK_NULL_HANDLE;
+            VkDeviceMemory stagingBufferMemory = VK_NULL_HANDLE;
+            BufferManageModule::createBuffer(
+                totalBytes,
+                VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                stagingBuffer,
+                stagingBufferMemory,
+                deviceModule);
+
+            void* data = nullptr;
+            vkMapMemory(deviceModule.device, stagingBufferMemory, 0, totalBytes, 0, &data);
+            for (const Upload& upload : uploads)
+            {
+                std::memcpy(static_cast<uint8_t*>(data) + upload.Offset, upload.Data, static_cast<size_t>(upload.Size));
+            }
+            vkUnmapMemory(deviceModule.device, stagingBufferMemory);
+
+            for (const Upload& upload : uploads)
+            {
+                BufferManageModule::createBuffer(
+                    upload.Size,
+                    upload.Usage,
+                    VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                    upload.Target->Buffer,
+                    upload.Target->Memory,
+                    deviceModule);
+            }
+
+            VkCommandBuffer commandBuffer = beginSingleTimeCommands(deviceModule.device, BufferManageModule::commandPool);
+            for (const Upload& upload : uploads)
+            {
+                VkBufferCopy copyRegion{};
+                copyRegion.srcOffset = upload.Offset;
+                copyRegion.size = upload.Size;
+                vkCmdCopyBuffer(commandBuffer, stagingBuffer, upload.Target->Buffer, 1, &copyRegion);
+            }
+            endSingleTimeCommands(deviceModule.device, BufferManageModule::graphicsQueue, BufferManageModule::commandPool, commandBuffer);
+
+            QE_DESTROY_BUFFER(deviceModule.device, stagingBuffer, "QEGeometryResourceCache::GeometryUploadBatch");
+            QE_FREE_MEMORY(deviceModule.device, stagingBufferMemory, "QEGeometryResourceCache::GeometryUploadBatch");
+
+            uploads.clear();
+            totalBytes = 0;
+        }
+    };
 
     void DestroyAllocations(std::vector<QEGeometryBufferAllocation>& allocations, VkDevice device, const char* scope)
     {
@@ -71,10 +246,85 @@ namespace
             }
         }
     }
+
+    void StageBuffers(QEGeometrySharedResource& resource, GeometryUploadBatch& batch)
+    {
+        const QEMesh& mesh = resource.Mesh;
+
+        const size_t subMeshCount = mesh.MeshData.size();
+        resource.VertexBuffers.resize(subMeshCount);
+        resource.IndexBuffers.resize(subMeshCount);
+        resource.AnimationBuffers.resize(subMeshCount);
+
+        for (size_t i = 0; i < subMeshCount; ++i)
+        {
+            const auto& subMesh = mesh.MeshData[i];
+
+            if (!subMesh.Vertices.empty())
+            {
+                const VkDeviceSize vertexBufferSize = sizeof(subMesh.Vertices[0]) * subMesh.Vertices.size();
+                batch.Add(
+                    vertexBufferSize,
+                    VK_BUFFER_USAGE_TRANSFER_DST_BIT |
+                    VK_BUFFER_USAGE_VERTEX_BUFFER_BIT |
+                    VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT |
+                    VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                    subMesh.Vertices.data(),
+                    resource.VertexBuffers[i]);
+            }
+
+            if (!subMesh.Indices.empty())
+            {
+                const VkDeviceSize indexBufferSize = sizeof(subMesh.Indices[0]) * subMesh.Indices.size();
+                batch.Add(
+                    indexBufferSize,
+                    VK_BUFFER_USAGE_TRANSFER_DST_BIT |
+                    VK_BUFFER_USAGE_INDEX_BUFFER_BIT |
+                    VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT,
+                    subMesh.Indices.data(),
+                    resource.IndexBuffers[i]);
+            }
+
+            if (!subMesh.AnimationVertexData.empty())
+            {
+                const VkDeviceSize animationBufferSize =
+                    sizeof(subMesh.AnimationVertexData[0]) * subMesh.AnimationVertexData.size();
+                batch.Add(
+                    animationBufferSize,
+                    VK_BUFFER_USAGE_TRANSFER_DST_BIT |
+                    VK_BUFFER_USAGE_VERTEX_BUFFER_BIT |
+                    VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT |
+                    VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                    subMesh.AnimationVertexData.data(),
+                    resource.AnimationBuffers[i]);
+            }
+        }
+    }
+
+    void FinishResources(const std::vector<std::shared_ptr<QEGeometrySharedResource>>& resources)
+    {
+        for (const auto& resource : resources)
+        {
+            // Normalmente vienen de la importacion; si no, se construyen en paralelo y se guardan
+            if (resource->Meshlets.empty())
+            {
+                resource->Meshlets = QEMeshletCache::LoadOrBuild(resource->Mesh);
+            }
+
+            // BVH de triangulos para picking/raycasts, en segundo plano para no alargar la carga
+            resource->TriangleBVH = TriangleBVHQueue::Get().Enqueue(resource.get(), &resource->Mesh);
+        }
+    }
 }
 
 QEGeometrySharedResource::~QEGeometrySharedResource()
 {
+    // Mesh se libera despues de este cuerpo: el BVH no puede seguir leyendola
+    if (TriangleBVH.valid())
+    {
+        TriangleBVHQueue::Get().Cancel(this, TriangleBVH);
+    }
+
     auto* deviceModule = DeviceModule::getInstance();
     if (deviceModule == nullptr || deviceModule->device == VK_NULL_HANDLE)
     {
@@ -86,6 +336,14 @@ QEGeometrySharedResource::~QEGeometrySharedResource()
     DestroyAllocations(AnimationBuffers, deviceModule->device, "QEGeometrySharedResource::~QEGeometrySharedResource");
 }
 
+const QEMeshBVH* QEGeometrySharedResource::GetTriangleBVH() const
+{
+    if (!TriangleBVH.valid() || TriangleBVH.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+        return nullptr;
+
+    return TriangleBVH.get().get();
+}
+
 std::shared_ptr<QEGeometrySharedResource> QEGeometryResourceCache::Acquire(
     const std::string& key,
     const std::function<QEMesh()>& buildMeshFn)
@@ -113,6 +371,74 @@ std::shared_ptr<QEGeometrySharedResource> QEGeometryResourceCache::Acquire(
     return resource;
 }
 
+std::vector<std::shared_ptr<QEGeometrySharedResource>> QEGeometryResourceCache::AcquireBuilt(std::vector<QEGeometryBuildData>& built)
+{
+    auto* deviceModule = DeviceModule::getInstance();
+    if (deviceModule == nullptr)
+    {
+        throw std::runtime_error("QEGeometryResourceCache requires a valid DeviceModule");
+    }
+
+    std::vector<std::shared_ptr<QEGeometrySharedResource>> resources(built.size());
+
+    std::lock_guard<std::mutex> lock(cacheMutex);
+
+    CollectGarbage();
+
+    GeometryUploadBatch batch;
+    std::vector<std::shared_ptr<QEGeometrySharedResource>> staged;
+
+    for (size_t i = 0; i < built.size(); ++i)
+    {
+        QEGeometryBuildData& data = built[i];
+
+        if (!data.Key.empty())
+        {
+            auto it = cache.find(data.Key);
+            if (it != cache.end())
+            {
+                if (auto existing = it->second.lock())
+                {
+                    resources[i] = std::move(existing);
+                    continue;
+                }
+            }
+        }
+
+        auto resource = std::make_shared<QEGeometrySharedResource>();
+        resource->Mesh = std::move(data.Mesh);
+        resource->Meshlets = std::move(data.Meshlets);
+        StageBuffers(*resource, batch);
+
+        if (!data.Key.empty())
+        {
+            cache[data.Key] = resource;
+        }
+
+        resources[i] = resource;
+        staged.push_back(std::move(resource));
+
+        if (batch.Bytes() >= MAX_UPLOAD_BATCH_BYTES)
+        {
+            batch.Submit(*deviceModule);
+            FinishResources(staged);
+            staged.clear();
+        }
+    }
+
+    batch.Submit(*deviceModule);
+    FinishResources(staged);
+    return resources;
+}
+
+std::shared_ptr<QEGeometrySharedResource> QEGeometryResourceCache::Find(const std::string& key)
+{
+    std::lock_guard<std::mutex> lock(cacheMutex);
+
+    auto it = cache.find(key);
+    return it != cache.end() ? it->second.lock() : nullptr;
+}
+
 void QEGeometryResourceCache::CollectGarbage()
 {
     for (auto it = cache.begin(); it != cache.end();)
@@ -128,7 +454,23 @@ void QEGeometryResourceCache::CollectGarbage()
     }
 }
 
-std::shared_ptr<QEGeometrySharedResource> QEGeometryResourceCache::CreateResource(const QEMesh& mesh)
+std::vector<std::shared_ptr<QEGeometrySharedResource>> QEGeometryResourceCache::GetLiveResources()
+{
+    std::lock_guard<std::mutex> lock(cacheMutex);
+
+    std::vector<std::shared_ptr<QEGeometrySharedResource>> resources;
+    resources.reserve(cache.size());
+    for (const auto& [key, weak] : cache)
+    {
+        if (auto resource = weak.lock())
+        {
+            resources.push_back(std::move(resource));
+        }
+    }
+    return resources;
+}
+
+std::shared_ptr<QEGeometrySharedResource> QEGeometryResourceCache::CreateResource(QEMesh mesh)
 {
     auto* deviceModule = DeviceModule::getInstance();
     if (deviceModule == nullptr)
@@ -137,60 +479,12 @@ std::shared_ptr<QEGeometrySharedResource> QEGeometryResourceCache::CreateResourc
     }
 
     auto resource = std::make_shared<QEGeometrySharedResource>();
-    resource->Mesh = mesh;
-
-    const size_t subMeshCount = mesh.MeshData.size();
-    resource->VertexBuffers.resize(subMeshCount);
-    resource->IndexBuffers.resize(subMeshCount);
-    resource->AnimationBuffers.resize(subMeshCount);
-    resource->Meshlets.resize(subMeshCount);
+    resource->Mesh = std::move(mesh);
 
-    for (size_t i = 0; i < subMeshCount; ++i)
-    {
-        const auto& subMesh = mesh.MeshData[i];
-
-        if (!subMesh.Vertices.empty())
-        {
-            const VkDeviceSize vertexBufferSize = sizeof(subMesh.Vertices[0]) * subMesh.Vertices.size();
-            resource->VertexBuffers[i] = CreateBufferAllocation(
-                vertexBufferSize,
-                VK_BUFFER_USAGE_TRANSFER_DST_BIT |
-                VK_BUFFER_USAGE_VERTEX_BUFFER_BIT |
-                VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT |
-                VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-                subMesh.Vertices.data(),
-                *deviceModule);
-        }
-
-        if (!subMesh.Indices.empty())
-        {
-            const VkDeviceSize indexBufferSize = sizeof(subMesh.Indices[0]) * subMesh.Indices.size();
-            resource->IndexBuffers[i] = CreateBufferAllocation(
-                indexBufferSize,
-                VK_BUFFER_USAGE_TRANSFER_DST_BIT |
-                VK_BUFFER_USAGE_INDEX_BUFFER_BIT |
-                VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT,
-                subMesh.Indices.data(),
-                *deviceModule);
-        }
-
-        if (!subMesh.AnimationVertexData.empty())
-        {
-            const VkDeviceSize animationBufferSize =
-                sizeof(subMesh.AnimationVertexData[0]) * subMesh.AnimationVertexData.size();
-            resource->AnimationBuffers[i] = CreateBufferAllocation(
-                animationBufferSize,
-                VK_BUFFER_USAGE_TRANSFER_DST_BIT |
-                VK_BUFFER_USAGE_VERTEX_BUFFER_BIT |
-                VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT |
-                VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-                subMesh.AnimationVertexData.data(),
-                *deviceModule);
-        }
-
-        resource->Meshlets[i] = std::make_shared<Meshlet>();
-        resource->Meshlets[i]->GenerateMeshlet(subMesh.Vertices, subMesh.Indices);
-    }
+    GeometryUploadBatch batch;
+    StageBuffers(*resource, batch);
+    batch.Submit(*deviceModule);
 
+    FinishResources({ resource });
     return resource;
 }
@@ -5,7 +5,9 @@
 
 #include <Meshlet.h>
 #include <QEMeshData.h>
+#include <QEMeshBVH.h>
 #include <functional>
+#include <future>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -26,10 +28,25 @@ struct QEGeometrySharedResource
     std::vector<QEGeometryBufferAllocation> IndexBuffers;
     std::vector<QEGeometryBufferAllocation> AnimationBuffers;
     std::vector<std::shared_ptr<Meshlet>> Meshlets;
+    // Lo construye una cola con hilos limitados; el destructor lo cancela o espera antes de liberar Mesh
+    std::shared_future<std::shared_ptr<QEMeshBVH>> TriangleBVH;
+
+    /// nullptr mientras el BVH se esta construyendo en segundo plano.
+    const QEMeshBVH* GetTriangleBVH() const;
 
     ~QEGeometrySharedResource();
 };
 
+/// Malla generada fuera del hilo principal (con sus meshlets), pendiente de subir a la GPU.
+struct QEGeometryBuildData
+{
+    std::string Key;
+    QEMesh Mesh;
+    std::vector<std::shared_ptr<Meshlet>> Meshlets;     // Vacio: se cargan o construyen al subir
+};
+
+/// Recursos de geometria compartidos por clave (ruta canonica de la malla o primitiva). Los buffers
+/// de un recurso se suben juntos: un staging y un envio por malla, o por tanda con AcquireBuilt.
 class QEGeometryResourceCache
 {
 public:
@@ -37,10 +54,21 @@ public:
         const std::string& key,
         const std::function<QEMesh()>& buildMeshFn);
 
+    /// Sube varias mallas ya construidas en pocas copias (se parte cada ~256 MB de staging).
+    /// Las claves que siguen vivas se reutilizan. Devuelve un recurso por entrada, en el mismo orden;
+    /// el llamador los mantiene vivos hasta que los componentes los adquieren con Acquire.
+    static std::vector<std::shared_ptr<QEGeometrySharedResource>> AcquireBuilt(std::vector<QEGeometryBuildData>& built);
+
+    /// Recurso vivo con esa clave; nullptr si no hay ninguno.
+    static std::shared_ptr<QEGeometrySharedResource> Find(const std::string& key);
+
     static void CollectGarbage();
 
+    /// Recursos con clave que siguen vivos (estadisticas y benchmark).
+    static std::vector<std::shared_ptr<QEGeometrySharedResource>> GetLiveResources();
+
 private:
-    static std::shared_ptr<QEGeometrySharedResource> CreateResource(const QEMesh& mesh);
+    static std::shared_ptr<QEGeometrySharedResource> CreateResource(QEMesh mesh);
 
 private:
     static std::unordered_map<std::string, std::weak_ptr<QEGeometrySharedResource>> cache;
@@ -53,6 +81,7 @@ namespace QE
 {
     using ::QEGeometryBufferAllocation;
     using ::QEGeometrySharedResource;
+    using ::QEGeometryBuildData;
     using ::QEGeometryResourceCache;
 } // namespace QE
 // QE namespace aliases
@@ -0,0 +1,191 @@
+#include "QEMeshBVH.h"
+
+namespace
+{
+    QEMeshRayHit MakeHit(uint32_t subMeshIndex, uint32_t triangleIndex, float t, const glm::vec3& v0, const glm::vec3& v1, const glm::vec3& v2)
+    {
+        QEMeshRayHit hit{};
+        hit.T = t;
+        hit.SubMeshIndex = subMeshIndex;
+        hit.TriangleIndex = triangleIndex;
+
+        const glm::vec3 normal = glm::cross(v1 - v0, v2 - v0);
+        const float length = glm::length(normal);
+        if (length > 0.0f)
+        {
+            hit.LocalNormal = normal / length;
+        }
+
+        return hit;
+    }
+}
+
+uint32_t QEMeshBVH::GetTriangleCount(const QEMeshData& subMesh)
+{
+    return static_cast<uint32_t>(subMesh.Indices.empty() ? subMesh.Vertices.size() / 3 : subMesh.Indices.size() / 3);
+}
+
+bool QEMeshBVH::FetchTriangle(const QEMeshData& subMesh, uint32_t triangleIndex, glm::vec3& v0, glm::vec3& v1, glm::vec3& v2)
+{
+    if (subMesh.Indices.empty())
+    {
+        v0 = subMesh.Vertices[triangleIndex * 3 + 0].Position;
+        v1 = subMesh.Vertices[triangleIndex * 3 + 1].Position;
+        v2 = subMesh.Vertices[triangleIndex * 3 + 2].Position;
+        return true;
+    }
+
+    const uint32_t i0 = subMesh.Indices[triangleIndex * 3 + 0];
+    const uint32_t i1 = subMesh.Indices[triangleIndex * 3 + 1];
+    const uint32_t i2 = subMesh.Indices[triangleIndex * 3 + 2];
+
+    if (i0 >= subMesh.Vertices.size() || i1 >= subMesh.Vertices.size() || i2 >= subMesh.Vertices.size())
+        return false;
+
+    v0 = subMesh.Vertices[i0].Position;
+    v1 = subMesh.Vertices[i1].Position;
+    v2 = subMesh.Vertices[i2].Position;
+    return true;
+}
+
+std::shared_ptr<QEMeshBVH> QEMeshBVH::Build(const QEMesh& mesh)
+{
+    auto result = std::make_shared<QEMeshBVH>();
+    result->subMeshBVHs.resize(mesh.MeshData.size());
+
+    std::vector<glm::vec3> triangleMin;
+    std::vector<glm::vec3> triangleMax;
+
+    for (size_t subMeshIndex = 0; subMeshIndex < mesh.MeshData.size(); ++subMeshIndex)
+    {
+        const QEMeshData& subMesh = mesh.MeshData[subMeshIndex];
+        const uint32_t triangleCount = GetTriangleCount(subMesh);
+
+        triangleMin.resize(triangleCount);
+        triangleMax.resize(triangleCount);
+
+        for (uint32_t tri = 0; tri < triangleCount; ++tri)
+        {
+            glm::vec3 v0, v1, v2;
+            if (!FetchTriangle(subMesh, tri, v0, v1, v2))
+            {
+                // Triangulo invalido: caja vacia en el origen, nunca se le acaba probando
+                triangleMin[tri] = triangleMax[tri] = glm::vec3(0.0f);
+                continue;
+            }
+
+            triangleMin[tri] = glm::min(glm::min(v0, v1), v2);
+            triangleMax[tri] = glm::max(glm::max(v0, v1), v2);
+        }
+
+        result->subMeshBVHs[subMeshIndex].Build(triangleMin, triangleMax);
+    }
+
+    return result;
+}
+
+bool QEMeshBVH::RaycastSubMesh(const QEMesh& mesh, uint32_t subMeshIndex, const QERay& localRay, float& maxT, QEMeshRayHit& outHit) const
+{
+    if (subMeshIndex >= subMeshBVHs.size() || subMeshIndex >= mesh.MeshData.size())
+        return false;
+
+    const QEMeshData& subMesh = mesh.MeshData[subMeshIndex];
+    bool hit = false;
+
+    subMeshBVHs[subMeshIndex].Traverse(localRay, maxT, [&](uint32_t tri, float& currentMaxT)
+        {
+            glm::vec3 v0, v1, v2;
+            if (!FetchTriangle(subMesh, tri, v0, v1, v2))
+                return;
+
+            float t = 0.0f;
+            if (QEBVH::IntersectTriangle(localRay, v0, v1, v2, t) && t <= currentMaxT)
+            {
+                currentMaxT = t;
+                outHit = MakeHit(subMeshIndex, tri, t, v0, v1, v2);
+                hit = true;
+            }
+        });
+
+    return hit;
+}
+
+void QEMeshBVH::RaycastSubMeshAll(const QEMesh& mesh, uint32_t subMeshIndex, const QERay& localRay, float maxT, std::vector<QEMeshRayHit>& outHits) const
+{
+    if (subMeshIndex >= subMeshBVHs.size() || subMeshIndex >= mesh.MeshData.size())
+        return;
+
+    const QEMeshData& subMesh = mesh.MeshData[subMeshIndex];
+
+    subMeshBVHs[subMeshIndex].Traverse(localRay, maxT, [&](uint32_t tri, float& currentMaxT)
+        {
+            glm::vec3 v0, v1, v2;
+            if (!FetchTriangle(subMesh, tri, v0, v1, v2))
+                return;
+
+            float t = 0.0f;
+            if (QEBVH::IntersectTriangle(localRay, v0, v1, v2, t) && t <= currentMaxT)
+            {
+                outHits.push_back(MakeHit(subMeshIndex, tri, t, v0, v1, v2));
+            }
+        });
+}
+
+bool QEMeshBVH::RaycastSubMeshBruteForce(const QEMesh& mesh, uint32_t subMeshIndex, const QERay& localRay, float& maxT, QEMeshRayHit& outHit)
+{
+    if (subMeshIndex >= mesh.MeshData.size())
+        return false;
+
+    const QEMeshData& subMesh = mesh.MeshData[subMeshIndex];
+    const uint32_t triangleCount = GetTriangleCount(subMesh);
+    bool hit = false;
+
+    for (uint32_t tri = 0; tri < triangleCount; ++tri)
+    {
+        glm::vec3 v0, v1, v2;
+        if (!FetchTriangle(subMesh, tri, v0, v1, v2))
+            continue;
+
+        float t = 0.0f;
+        if (QEBVH::IntersectTriangle(localRay, v0, v1, v2, t) && t <= maxT)
+        {
+            maxT = t;
+            outHit = MakeHit(subMeshIndex, tri, t, v0, v1, v2);
+            hit = true;
+        }
+    }
+
+    return hit;
+}
+
+void QEMeshBVH::RaycastSubMeshAllBruteForce(const QEMesh& mesh, uint32_t subMeshIndex, const QERay& localRay, float maxT, std::vector<QEMeshRayHit>& outHits)
+{
+    if (subMeshIndex >= mesh.MeshData.size())
+        return;
+
+    const QEMeshData& subMesh = mesh.MeshData[subMeshIndex];
+    const uint32_t triangleCount = GetTriangleCount(subMesh);
+
+    for (uint32_t tri = 0; tri < triangleCount; ++tri)
+    {
+        glm::vec3 v0, v1, v2;
+        if (!FetchTriangle(subMesh, tri, v0, v1, v2))
+            continue;
+
+        float t = 0.0f;
+        if (QEBVH::IntersectTriangle(localRay, v0, v1, v2, t) && t <= maxT)
+        {
+            outHits.push_back(MakeHit(subMeshIndex, tri, t, v0, v1, v2));
+        }
+    }
+}
+
+size_t QEMeshBVH::GetMemorySize() const
+{
+    size_t size = 0;
+    for (const auto& bvh : subMeshBVHs)
+    {
+        size += bvh.GetMemorySize();
+    }
+    return size;
+}
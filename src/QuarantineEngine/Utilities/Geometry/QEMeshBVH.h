@@ -0,0 +1,55 @@
+#pragma once
+
+#ifndef QE_MESH_BVH_H
+#define QE_MESH_BVH_H
+
+#include <memory>
+#include <vector>
+#include <QEBVH.h>
+#include <QEMeshData.h>
+
+/// Impacto en el espacio local de un submesh (el del vertex buffer, antes de ModelTransform).
+struct QEMeshRayHit
+{
+    float T = 0.0f;
+    uint32_t SubMeshIndex = 0;
+    uint32_t TriangleIndex = 0;
+    glm::vec3 LocalNormal = glm::vec3(0.0f, 1.0f, 0.0f);
+};
+
+/// BVH de triangulos por submesh (pose de bind). Se construye una vez por QEGeometrySharedResource
+/// en un hilo de trabajo y lo comparten todas las instancias de la malla.
+class QEMeshBVH
+{
+private:
+    std::vector<QEBVH> subMeshBVHs;
+
+private:
+    static bool FetchTriangle(const QEMeshData& subMesh, uint32_t triangleIndex, glm::vec3& v0, glm::vec3& v1, glm::vec3& v2);
+
+public:
+    static std::shared_ptr<QEMeshBVH> Build(const QEMesh& mesh);
+
+    static uint32_t GetTriangleCount(const QEMeshData& subMesh);
+
+    /// localRay en el espacio del submesh. maxT se reduce al impacto mas cercano.
+    bool RaycastSubMesh(const QEMesh& mesh, uint32_t subMeshIndex, const QERay& localRay, float& maxT, QEMeshRayHit& outHit) const;
+    /// Igual que RaycastSubMesh pero devuelve todos los impactos en [0, maxT].
+    void RaycastSubMeshAll(const QEMesh& mesh, uint32_t subMeshIndex, const QERay& localRay, float maxT, std::vector<QEMeshRayHit>& outHits) const;
+
+    /// Recorrido exhaustivo de triangulos: se usa mientras el BVH aun se esta construyendo.
+    static bool RaycastSubMeshBruteForce(const QEMesh& mesh, uint32_t subMeshIndex, const QERay& localRay, float& maxT, QEMeshRayHit& outHit);
+    static void RaycastSubMeshAllBruteForce(const QEMesh& mesh, uint32_t subMeshIndex, const QERay& localRay, float maxT, std::vector<QEMeshRayHit>& outHits);
+
+    size_t GetMemorySize() const;
+};
+
+
+
+namespace QE
+{
+    using ::QEMeshRayHit;
+    using ::QEMeshBVH;
+} // namespace QE
+// QE namespace aliases
+#endif // !QE_MESH_BVH_H
@@ -28,6 +28,7 @@ struct QEMeshData
     glm::mat4 ModelTransform = glm::mat4(1.0);
     bool HasAnimation = false;
     std::pair<glm::vec3, glm::vec3> BoundingBox;
+    float UVDensity = -1.0f;    // UV por unidad de objeto (raiz de area UV / area); < 0 sin calcular
 };
 
 struct QEMesh  
@@ -459,7 +459,7 @@ QEMesh CapsuleGenerator::GenerateQEMesh()
 
 QEMesh QEMeshGenerator::GenerateQEMesh()
 {
-    QEMesh mesh = MeshImporter::LoadMesh(dataPath);
+    QEMesh mesh = MeshImporter::LoadMesh(dataPath, true, createMaterials);
 
     if (mesh.MeshData.empty())
     {
@@ -172,10 +172,12 @@ class QEMeshGenerator : public IQEMeshGenerator
 {
 private:
     std::string dataPath;
+    bool createMaterials = true;
 public:
     QEMeshGenerator() = default;
-    QEMeshGenerator(std::string data)
-        : dataPath(data) {
+    /// Con createMaterials a false se puede generar fuera del hilo principal (ver MeshImporter::LoadMesh).
+    QEMeshGenerator(std::string data, bool createMaterials = true)
+        : dataPath(data), createMaterials(createMaterials) {
     }
     QEMesh GenerateQEMesh() override;
 };
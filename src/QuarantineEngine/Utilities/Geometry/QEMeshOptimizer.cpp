@@ -0,0 +1,292 @@
+#include "QEMeshOptimizer.h"
+#include <algorithm>
+#include <format>
+#include <numeric>
+#include <assimp/scene.h>
+#include <meshoptimizer.h>
+#include <Logging/QELogMacros.h>
+
+namespace
+{
+    // Permuta un stream de assimp con el remap de meshoptimizer (los vertices sin uso desaparecen)
+    template<typename T>
+    void RemapStream(T*& stream, size_t vertexCount, size_t uniqueCount, const std::vector<uint32_t>& remap)
+    {
+        if (!stream)
+            return;
+
+        T* result = new T[uniqueCount];
+        meshopt_remapVertexBuffer(result, stream, vertexCount, sizeof(T), remap.data());
+        delete[] stream;
+        stream = result;
+    }
+
+    template<typename TMesh>
+    void RemapMeshStreams(TMesh* mesh, size_t uniqueCount, const std::vector<uint32_t>& remap)
+    {
+        const size_t vertexCount = mesh->mNumVertices;
+
+        RemapStream(mesh->mVertices, vertexCount, uniqueCount, remap);
+        RemapStream(mesh->mNormals, vertexCount, uniqueCount, remap);
+        RemapStream(mesh->mTangents, vertexCount, uniqueCount, remap);
+        RemapStream(mesh->mBitangents, vertexCount, uniqueCount, remap);
+
+        for (unsigned int i = 0; i < AI_MAX_NUMBER_OF_COLOR_SETS; ++i)
+        {
+            RemapStream(mesh->mColors[i], vertexCount, uniqueCount, remap);
+        }
+
+        for (unsigned int i = 0; i < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++i)
+        {
+            RemapStream(mesh->mTextureCoords[i], vertexCount, uniqueCount, remap);
+        }
+
+        mesh->mNumVertices = static_cast<unsigned int>(uniqueCount);
+    }
+
+    void RemapBones(aiMesh* mesh, const std::vector<uint32_t>& remap)
+    {
+        for (unsigned int b = 0; b < mesh->mNumBones; ++b)
+        {
+            aiBone* bone = mesh->mBones[b];
+
+            std::vector<aiVertexWeight> weights;
+            weights.reserve(bone->mNumWeights);
+            for (unsigned int w = 0; w < bone->mNumWeights; ++w)
+            {
+                const aiVertexWeight& weight = bone->mWeights[w];
+                if (weight.mVertexId < remap.size() && remap[weight.mVertexId] != ~0u)
+                {
+                    weights.emplace_back(remap[weight.mVertexId], weight.mWeight);
+                }
+            }
+
+            delete[] bone->mWeights;
+            bone->mWeights = nullptr;
+            bone->mNumWeights = static_cast<unsigned int>(weights.size());
+
+            if (!weights.empty())
+            {
+                bone->mWeights = new aiVertexWeight[weights.size()];
+                std::copy(weights.begin(), weights.end(), bone->mWeights);
+            }
+        }
+    }
+}
+
+void QEMeshOptimizationStats::Accumulate(const QEMeshOptimizationStats& other)
+{
+    Meshes += other.Meshes;
+    Vertices += other.Vertices;
+    Triangles += other.Triangles;
+    VerticesTransformed += other.VerticesTransformed;
+    PixelsCovered += other.PixelsCovered;
+    PixelsShaded += other.PixelsShaded;
+    BytesFetched += other.BytesFetched;
+    VertexBytes += other.VertexBytes;
+}
+
+std::string QEMeshOptimizationStats::ToString() const
+{
+    return std::format("ACMR {:.3f}, ATVR {:.3f}, overdraw {:.3f}, overfetch {:.3f} ({} meshes, {} vertices, {} triangles)",
+        Acmr(), Atvr(), Overdraw(), Overfetch(), Meshes, Vertices, Triangles);
+}
+
+QEMeshOptimizationStats QEMeshOptimizer::Analyze(
+    const std::vector<uint32_t>& indices,
+    const float* positions,
+    size_t vertexCount,
+    size_t positionStride,
+    size_t vertexSize)
+{
+    QEMeshOptimizationStats stats;
+    if (indices.empty() || vertexCount == 0)
+        return stats;
+
+    const meshopt_VertexCacheStatistics cache = meshopt_analyzeVertexCache(
+        indices.data(), indices.size(), vertexCount, ANALYZE_CACHE_SIZE, 0, 0);
+    const meshopt_OverdrawStatistics overdraw = meshopt_analyzeOverdraw(
+        indices.data(), indices.size(), positions, vertexCount, positionStride);
+    const meshopt_VertexFetchStatistics fetch = meshopt_analyzeVertexFetch(
+        indices.data(), indices.size(), vertexCount, vertexSize);
+
+    stats.Meshes = 1;
+    stats.Vertices = vertexCount;
+    stats.Triangles = indices.size() / 3;
+    stats.VerticesTransformed = cache.vertices_transformed;
+    stats.PixelsCovered = overdraw.pixels_covered;
+    stats.PixelsShaded = overdraw.pixels_shaded;
+    stats.BytesFetched = fetch.bytes_fetched;
+    stats.VertexBytes = static_cast<uint64_t>(vertexCount) * vertexSize;
+    return stats;
+}
+
+QEMeshOptimizationStats QEMeshOptimizer::Analyze(const QEMeshData& data)
+{
+    std::vector<uint32_t> indices(data.Indices.begin(), data.Indices.end());
+    if (indices.empty())
+    {
+        indices.resize(data.Vertices.size());
+        std::iota(indices.begin(), indices.end(), 0u);
+    }
+
+    if (data.Vertices.empty())
+        return {};
+
+    return Analyze(indices, &data.Vertices[0].Position.x, data.Vertices.size(), sizeof(Vertex), sizeof(Vertex));
+}
+
+QEMeshOptimizationStats QEMeshOptimizer::Analyze(const QEMesh& mesh)
+{
+    QEMeshOptimizationStats stats;
+    for (const QEMeshData& data : mesh.MeshData)
+    {
+        stats.Accumulate(Analyze(data));
+    }
+    return stats;
+}
+
+size_t QEMeshOptimizer::OptimizeIndices(
+    std::vector<uint32_t>& indices,
+    const float* positions,
+    size_t vertexCount,
+    size_t positionStride,
+    const QEMeshOptimizationSettings& settings,
+    std::vector<uint32_t>& outRemap)
+{
+    outRemap.clear();
+
+    // El orden importa: overdraw parte del orden de cache y el fetch sigue el orden final de triangulos
+    if (settings.VertexCache)
+    {
+        meshopt_optimizeVertexCache(indices.data(), indices.data(), indices.size(), vertexCount);
+    }
+
+    if (settings.Overdraw)
+    {
+        meshopt_optimizeOverdraw(indices.data(), indices.data(), indices.size(), positions, vertexCount, positionStride, settings.OverdrawThreshold);
+    }
+
+    if (!settings.VertexFetch)
+        return vertexCount;
+
+    outRemap.resize(vertexCount);
+    const size_t uniqueCount = meshopt_optimizeVertexFetchRemap(outRemap.data(), indices.data(), indices.size(), vertexCount);
+    meshopt_remapIndexBuffer(indices.data(), indices.data(), indices.size(), outRemap.data());
+    return uniqueCount;
+}
+
+void QEMeshOptimizer::Optimize(QEMeshData& data, const QEMeshOptimizationSettings& settings)
+{
+    if (!settings.Enabled() || data.Indices.empty() || data.Vertices.empty())
+        return;
+
+    std::vector<uint32_t> indices(data.Indices.begin(), data.Indices.end());
+    std::vector<uint32_t> remap;
+    const size_t uniqueCount = OptimizeIndices(indices, &data.Vertices[0].Position.x, data.Vertices.size(), sizeof(Vertex), settings, remap);
+
+    data.Indices.assign(indices.begin(), indices.end());
+    if (remap.empty())
+        return;
+
+    std::vector<Vertex> vertices(uniqueCount);
+    meshopt_remapVertexBuffer(vertices.data(), data.Vertices.data(), data.Vertices.size(), sizeof(Vertex), remap.data());
+
+    if (data.AnimationVertexData.size() == data.Vertices.size())
+    {
+        std::vector<AnimationVertexData> animation(uniqueCount);
+        meshopt_remapVertexBuffer(animation.data(), data.AnimationVertexData.data(), data.AnimationVertexData.size(), sizeof(AnimationVertexData), remap.data());
+        data.AnimationVertexData = std::move(animation);
+    }
+
+    data.Vertices = std::move(vertices);
+    data.NumVertices = uniqueCount;
+}
+
+bool QEMeshOptimizer::OptimizeMesh(
+    aiMesh* mesh,
+    const QEMeshOptimizationSettings& settings,
+    QEMeshOptimizationStats& outBefore,
+    QEMeshOptimizationStats& outAfter)
+{
+    if (!mesh || !mesh->mVertices || mesh->mNumVertices == 0 || mesh->mNumFaces == 0)
+        return false;
+
+    // Solo triangulos: puntos y lineas se exportan tal cual
+    std::vector<uint32_t> indices;
+    indices.reserve(static_cast<size_t>(mesh->mNumFaces) * 3);
+    for (unsigned int f = 0; f < mesh->mNumFaces; ++f)
+    {
+        const aiFace& face = mesh->mFaces[f];
+        if (face.mNumIndices != 3)
+            return false;
+
+        indices.insert(indices.end(), face.mIndices, face.mIndices + 3);
+    }
+
+    const float* positions = &mesh->mVertices[0].x;
+    const size_t vertexCount = mesh->mNumVertices;
+
+    // Medido con el tamano del vertice de runtime, que es el que se lee en la GPU
+    outBefore = Analyze(indices, positions, vertexCount, sizeof(aiVector3D), sizeof(Vertex));
+
+    std::vector<uint32_t> remap;
+    const size_t uniqueCount = OptimizeIndices(indices, positions, vertexCount, sizeof(aiVector3D), settings, remap);
+
+    if (!remap.empty())
+    {
+        RemapBones(mesh, remap);
+
+        // Los morph targets comparten indices con la malla base
+        for (unsigned int a = 0; a < mesh->mNumAnimMeshes; ++a)
+        {
+            if (mesh->mAnimMeshes[a] && mesh->mAnimMeshes[a]->mNumVertices == vertexCount)
+            {
+                RemapMeshStreams(mesh->mAnimMeshes[a], uniqueCount, remap);
+            }
+        }
+
+        RemapMeshStreams(mesh, uniqueCount, remap);
+    }
+
+    for (unsigned int f = 0; f < mesh->mNumFaces; ++f)
+    {
+        std::copy(indices.begin() + f * 3, indices.begin() + f * 3 + 3, mesh->mFaces[f].mIndices);
+    }
+
+    outAfter = Analyze(indices, &mesh->mVertices[0].x, mesh->mNumVertices, sizeof(aiVector3D), sizeof(Vertex));
+    return true;
+}
+
+uint32_t QEMeshOptimizer::OptimizeScene(
+    aiScene* scene,
+    const QEMeshOptimizationSettings& settings,
+    QEMeshOptimizationStats& outBefore,
+    QEMeshOptimizationStats& outAfter)
+{
+    outBefore = {};
+    outAfter = {};
+
+    if (!scene || !settings.Enabled())
+        return 0;
+
+    uint32_t optimized = 0;
+    for (unsigned int m = 0; m < scene->mNumMeshes; ++m)
+    {
+        aiMesh* mesh = scene->mMeshes[m];
+
+        QEMeshOptimizationStats before;
+        QEMeshOptimizationStats after;
+        if (!OptimizeMesh(mesh, settings, before, after))
+            continue;
+
+        QE_LOG_DEBUG_CAT_F("QEMeshOptimizer", "{}: ACMR {:.3f} -> {:.3f}, ATVR {:.3f} -> {:.3f}, overdraw {:.3f} -> {:.3f}",
+            mesh->mName.C_Str(), before.Acmr(), after.Acmr(), before.Atvr(), after.Atvr(), before.Overdraw(), after.Overdraw());
+
+        outBefore.Accumulate(before);
+        outAfter.Accumulate(after);
+        ++optimized;
+    }
+
+    return optimized;
+}
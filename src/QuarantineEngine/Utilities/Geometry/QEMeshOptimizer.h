@@ -0,0 +1,105 @@
+#pragma once
+
+#ifndef QE_MESH_OPTIMIZER_H
+#define QE_MESH_OPTIMIZER_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <QEMeshData.h>
+
+struct aiMesh;
+struct aiScene;
+
+/// Pasos de optimizacion al importar una malla; se configura por asset en la importacion.
+struct QEMeshOptimizationSettings
+{
+    bool VertexCache = true;            // Reordena triangulos para la cache post-transform
+    bool Overdraw = true;               // Reordena clusters de triangulos de delante hacia atras
+    bool VertexFetch = true;            // Reordena vertices por orden de primer uso
+    float OverdrawThreshold = 1.05f;    // Cuanto puede empeorar el ACMR a cambio de menos overdraw
+
+    bool Enabled() const { return VertexCache || Overdraw || VertexFetch; }
+};
+
+/// Contadores acumulables de meshopt_analyze*; los ratios se calculan sobre la suma.
+struct QEMeshOptimizationStats
+{
+    uint32_t Meshes = 0;
+    uint64_t Vertices = 0;
+    uint64_t Triangles = 0;
+    uint64_t VerticesTransformed = 0;
+    uint64_t PixelsCovered = 0;
+    uint64_t PixelsShaded = 0;
+    uint64_t BytesFetched = 0;
+    uint64_t VertexBytes = 0;
+
+    /// Vertices transformados por triangulo (0.5 ideal, 3 sin reutilizacion).
+    float Acmr() const { return Triangles ? float(VerticesTransformed) / float(Triangles) : 0.0f; }
+    /// Vertices transformados por vertice unico (1 ideal).
+    float Atvr() const { return Vertices ? float(VerticesTransformed) / float(Vertices) : 0.0f; }
+    /// Pixeles sombreados por pixel cubierto (1 ideal).
+    float Overdraw() const { return PixelsCovered ? float(PixelsShaded) / float(PixelsCovered) : 0.0f; }
+    /// Bytes leidos del vertex buffer por byte util (1 ideal).
+    float Overfetch() const { return VertexBytes ? float(BytesFetched) / float(VertexBytes) : 0.0f; }
+
+    void Accumulate(const QEMeshOptimizationStats& other);
+    std::string ToString() const;
+};
+
+/// Optimizacion de index/vertex buffers con meshoptimizer: cache de vertices, overdraw y fetch.
+/// La importacion la aplica a la escena de assimp antes de exportar el glTF, asi el resultado se
+/// guarda en el asset y la carga no paga nada; las variantes sobre QEMeshData sirven para medir.
+class QEMeshOptimizer
+{
+public:
+    /// Tamano de cache FIFO simulado para ACMR/ATVR.
+    static constexpr uint32_t ANALYZE_CACHE_SIZE = 16;
+
+    static QEMeshOptimizationStats Analyze(const QEMeshData& data);
+    static QEMeshOptimizationStats Analyze(const QEMesh& mesh);
+
+    /// Optimiza en sitio (Vertices y AnimationVertexData se permutan juntos).
+    static void Optimize(QEMeshData& data, const QEMeshOptimizationSettings& settings);
+
+    /// Optimiza todas las mallas de triangulos de la escena; devuelve cuantas se han tocado.
+    static uint32_t OptimizeScene(
+        aiScene* scene,
+        const QEMeshOptimizationSettings& settings,
+        QEMeshOptimizationStats& outBefore,
+        QEMeshOptimizationStats& outAfter);
+
+private:
+    static QEMeshOptimizationStats Analyze(
+        const std::vector<uint32_t>& indices,
+        const float* positions,
+        size_t vertexCount,
+        size_t positionStride,
+        size_t vertexSize);
+
+    /// Reordena los indices y, con VertexFetch, rellena remap (antiguo -> nuevo, ~0u si no se usa).
+    static size_t OptimizeIndices(
+        std::vector<uint32_t>& indices,
+        const float* positions,
+        size_t vertexCount,
+        size_t positionStride,
+        const QEMeshOptimizationSettings& settings,
+        std::vector<uint32_t>& outRemap);
+
+    static bool OptimizeMesh(
+        aiMesh* mesh,
+        const QEMeshOptimizationSettings& settings,
+        QEMeshOptimizationStats& outBefore,
+        QEMeshOptimizationStats& outAfter);
+};
+
+
+
+namespace QE
+{
+    using ::QEMeshOptimizationSettings;
+    using ::QEMeshOptimizationStats;
+    using ::QEMeshOptimizer;
+} // namespace QE
+// QE namespace aliases
+#endif // !QE_MESH_OPTIMIZER_H
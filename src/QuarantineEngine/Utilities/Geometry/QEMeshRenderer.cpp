@@ -1,5 +1,7 @@
 #include "QEMeshRenderer.h"
 #include "QEGameObject.h"
+#include <QEMeshletCulling.h>
+#include <QEBindlessMaterials.h>
 
 QEMeshRenderer::QEMeshRenderer()
     : materialComponents(*(new std::vector<std::shared_ptr<QEMaterial>>()))
@@ -76,6 +78,10 @@ void QEMeshRenderer::SetDrawCommand(VkCommandBuffer& commandBuffer, uint32_t idx
     if (!qeMesh || subMeshIndex >= this->geometryComponent->indexBuffer.size())
         return;
 
+    // Solo los meshlets del submesh 0 estan enlazados al material de mesh shaders
+    if (this->IsMeshShaderPipeline && subMeshIndex != 0)
+        return;
+
     if (!this->IsMeshShaderPipeline)
     {
         VkDeviceSize offsets[] = { 0 };
@@ -120,19 +126,57 @@ void QEMeshRenderer::SetDrawCommand(VkCommandBuffer& commandBuffer, uint32_t idx
 
     material->BindDescriptors(commandBuffer, idx);
 
-    vkCmdPushConstants(commandBuffer, pipelineModule->pipelineLayout, VK_SHADER_STAGE_ALL, 0, sizeof(PushConstantStruct), &this->transformComponent->GetWorldMatrix());
-
     if (this->IsMeshShaderPipeline)
     {
-        this->vkCmdDrawMeshTasksEXT(commandBuffer, 32, 1, 1);
+        SetMeshletDrawCommand(commandBuffer, pipelineModule->pipelineLayout, material->materialData.DoubleSided);
     }
     else
     {
+        PushConstantStruct drawParameters = {};
+        drawParameters.model = this->transformComponent->GetWorldMatrix();
+        drawParameters.materialIndex = material->GetBindlessIndex();
+
+        vkCmdPushConstants(commandBuffer, pipelineModule->pipelineLayout, VK_SHADER_STAGE_ALL, 0, sizeof(PushConstantStruct), &drawParameters);
+
         auto indicesCount = this->geometryComponent->GetIndicesCount(subMeshIndex);
         vkCmdDrawIndexed(commandBuffer, indicesCount, 1, 0, 0, 0);
     }
 }
 
+void QEMeshRenderer::SetMeshletDrawCommand(VkCommandBuffer& commandBuffer, VkPipelineLayout pipelineLayout, bool doubleSided)
+{
+    auto qeMesh = this->geometryComponent->GetMesh();
+    if (!qeMesh || qeMesh->MeshData.empty() || this->geometryComponent->meshlets_ptr.empty() || !this->geometryComponent->meshlets_ptr[0])
+        return;
+
+    const Meshlet& meshlet = *this->geometryComponent->meshlets_ptr[0];
+    if (meshlet.lods.empty())
+        return;
+
+    auto meshletCulling = QEMeshletCulling::getInstance();
+    const glm::mat4& model = this->transformComponent->GetWorldMatrix();
+    const auto& bounds = qeMesh->MeshData[0].BoundingBox;
+    const glm::vec3 localCenter = (bounds.first + bounds.second) * 0.5f;
+    const float localRadius = glm::length(bounds.second - bounds.first) * 0.5f;
+
+    const uint32_t lod = meshletCulling->SelectLod(meshlet, model, localCenter, localRadius);
+    const uint32_t flags = meshletCulling->BuildFlags(doubleSided);
+    meshletCulling->RecordDispatch(meshlet, lod, model, flags);
+
+    const MeshletLodRange& range = meshlet.lods[lod];
+
+    PushConstantMeshletStruct meshletParameters = {};
+    meshletParameters.model = model;
+    meshletParameters.firstMeshlet = range.FirstMeshlet;
+    meshletParameters.meshletCount = range.MeshletCount;
+    meshletParameters.flags = flags;
+
+    vkCmdPushConstants(commandBuffer, pipelineLayout, VK_SHADER_STAGE_ALL, 0, sizeof(PushConstantMeshletStruct), &meshletParameters);
+
+    // Cada workgroup del task shader prueba MESHLET_GROUP_SIZE meshlets; los rangos ya vienen rellenos
+    this->vkCmdDrawMeshTasksEXT(commandBuffer, range.MeshletCount / Meshlet::MESHLET_GROUP_SIZE, 1, 1);
+}
+
 void QEMeshRenderer::SetDrawShadowCommand(VkCommandBuffer& commandBuffer, uint32_t idx, VkPipelineLayout pipelineLayout)
 {
     if (this->geometryComponent == nullptr)
@@ -148,7 +192,7 @@ void QEMeshRenderer::SetDrawShadowCommand(VkCommandBuffer& commandBuffer, uint32
     }
 }
 
-void QEMeshRenderer::SetDrawShadowCommand(VkCommandBuffer& commandBuffer, uint32_t idx, VkPipelineLayout pipelineLayout, uint32_t subMeshIndex)
+void QEMeshRenderer::SetDrawShadowCommand(VkCommandBuffer& commandBuffer, uint32_t idx, VkPipelineLayout pipelineLayout, uint32_t subMeshIndex, uint32_t instanceCount)
 {
     if (this->geometryComponent == nullptr)
         return;
@@ -188,7 +232,13 @@ void QEMeshRenderer::SetDrawShadowCommand(VkCommandBuffer& commandBuffer, uint32
                 commandBuffer,
                 disableShadowCulling ? VK_CULL_MODE_NONE : VK_CULL_MODE_BACK_BIT);
 
-            if (material->HasDescriptorBuffer() &&
+            // Sombras bindless: la tabla de materiales se enlaza una vez por pase
+            auto* bindlessMaterials = QEBindlessMaterials::getInstance();
+            if (bindlessMaterials->IsBindlessLayout(pipelineLayout))
+            {
+                bindlessMaterials->BindPass(commandBuffer, idx, pipelineLayout);
+            }
+            else if (material->HasDescriptorBuffer() &&
                 material->descriptor &&
                 idx < material->descriptor->descriptorSets.size())
             {
@@ -212,6 +262,6 @@ void QEMeshRenderer::SetDrawShadowCommand(VkCommandBuffer& commandBuffer, uint32
     else
     {
         auto indicesCount = geometryComponent->GetIndicesCount(subMeshIndex);
-        vkCmdDrawIndexed(commandBuffer, indicesCount, 1, 0, 0, 0);
+        vkCmdDrawIndexed(commandBuffer, indicesCount, instanceCount, 0, 0, 0);
     }
 }
@@ -19,6 +19,9 @@ private:
     std::vector<std::shared_ptr<QEMaterial>>& materialComponents;
     std::shared_ptr<QETransform> transformComponent = nullptr;
 
+private:
+    void SetMeshletDrawCommand(VkCommandBuffer& commandBuffer, VkPipelineLayout pipelineLayout, bool doubleSided);
+
 public:
     REFLECT_PROPERTY(bool, IsMeshShaderPipeline)
 
@@ -35,7 +38,7 @@ public:
     void SetDrawCommand(VkCommandBuffer& commandBuffer, uint32_t idx);
     void SetDrawCommand(VkCommandBuffer& commandBuffer, uint32_t idx, uint32_t subMeshIndex);
     void SetDrawShadowCommand(VkCommandBuffer& commandBuffer, uint32_t idx, VkPipelineLayout pipelineLayout);
-    void SetDrawShadowCommand(VkCommandBuffer& commandBuffer, uint32_t idx, VkPipelineLayout pipelineLayout, uint32_t subMeshIndex);
+    void SetDrawShadowCommand(VkCommandBuffer& commandBuffer, uint32_t idx, VkPipelineLayout pipelineLayout, uint32_t subMeshIndex, uint32_t instanceCount = 1);
 };
 
 
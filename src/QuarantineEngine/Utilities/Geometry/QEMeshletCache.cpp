@@ -0,0 +1,291 @@
+#include "QEMeshletCache.h"
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <future>
+#include <numeric>
+#include <thread>
+#include <Logging/QELogMacros.h>
+
+QEMeshletBuildSettings QEMeshletCache::Settings;
+
+namespace
+{
+    struct CacheHeader
+    {
+        uint32_t Magic = 0;
+        uint32_t Version = 0;
+        uint32_t MaxVertices = 0;
+        uint32_t MaxTriangles = 0;
+        float ConeWeight = 0.0f;
+        uint32_t MaxLods = 0;
+        uint32_t TriangleSlots = 0;
+        uint32_t DescriptorStride = 0;
+        uint32_t SubMeshCount = 0;
+    };
+
+    struct CacheSubMeshHeader
+    {
+        uint64_t GeometryHash = 0;
+        uint32_t VertexCount = 0;
+        uint32_t IndexCount = 0;
+        uint32_t LodCount = 0;
+        uint32_t MeshletCount = 0;
+        uint32_t IndexDataCount = 0;
+        uint32_t Padding = 0;
+    };
+
+    void HashBytes(uint64_t& hash, const void* data, size_t size)
+    {
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+        for (size_t i = 0; i < size; ++i)
+        {
+            hash ^= bytes[i];
+            hash *= 0x100000001B3ull;
+        }
+    }
+
+    // FNV-1a de posiciones e indices: lo unico de lo que dependen los meshlets
+    uint64_t ComputeGeometryHash(const QEMeshData& subMesh)
+    {
+        uint64_t hash = 0xCBF29CE484222325ull;
+        for (const Vertex& vertex : subMesh.Vertices)
+        {
+            HashBytes(hash, &vertex.Position, sizeof(vertex.Position));
+        }
+        if (!subMesh.Indices.empty())
+        {
+            HashBytes(hash, subMesh.Indices.data(), subMesh.Indices.size() * sizeof(subMesh.Indices[0]));
+        }
+        return hash;
+    }
+
+    template<typename T>
+    bool ReadArray(std::ifstream& file, std::vector<T>& out, uint32_t count)
+    {
+        out.resize(count);
+        if (count == 0)
+            return true;
+        file.read(reinterpret_cast<char*>(out.data()), static_cast<std::streamsize>(sizeof(T) * count));
+        return static_cast<bool>(file);
+    }
+
+    template<typename T>
+    void WriteArray(std::ofstream& file, const std::vector<T>& data)
+    {
+        if (!data.empty())
+        {
+            file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(sizeof(T) * data.size()));
+        }
+    }
+}
+
+fs::path QEMeshletCache::GetCachePath(const fs::path& meshPath)
+{
+    fs::path cachePath = meshPath;
+    cachePath.replace_extension(".qemeshlets");
+    return cachePath;
+}
+
+std::vector<std::shared_ptr<Meshlet>> QEMeshletCache::Build(const QEMesh& mesh, const QEMeshletBuildSettings& settings)
+{
+    const size_t subMeshCount = mesh.MeshData.size();
+    std::vector<std::shared_ptr<Meshlet>> meshlets(subMeshCount);
+    for (auto& meshlet : meshlets)
+    {
+        meshlet = std::make_shared<Meshlet>();
+    }
+
+    // Los submeshes grandes primero para que ningun hilo se quede con el ultimo trabajo largo
+    std::vector<size_t> order(subMeshCount);
+    std::iota(order.begin(), order.end(), size_t(0));
+    std::sort(order.begin(), order.end(), [&mesh](size_t a, size_t b)
+        {
+            return mesh.MeshData[a].Indices.size() > mesh.MeshData[b].Indices.size();
+        });
+
+    std::atomic<size_t> next{ 0 };
+    auto worker = [&]()
+        {
+            for (size_t slot = next.fetch_add(1); slot < order.size(); slot = next.fetch_add(1))
+            {
+                const QEMeshData& subMesh = mesh.MeshData[order[slot]];
+                meshlets[order[slot]]->GenerateMeshlet(subMesh.Vertices, subMesh.Indices, settings);
+            }
+        };
+
+    const uint32_t workerCount = std::min<uint32_t>(
+        static_cast<uint32_t>(subMeshCount),
+        std::max(1u, std::thread::hardware_concurrency()));
+
+    if (workerCount <= 1)
+    {
+        worker();
+        return meshlets;
+    }
+
+    std::vector<std::future<void>> workers;
+    workers.reserve(workerCount - 1);
+    for (uint32_t i = 1; i < workerCount; ++i)
+    {
+        workers.push_back(std::async(std::launch::async, worker));
+    }
+
+    worker();
+
+    for (auto& future : workers)
+    {
+        future.get();
+    }
+
+    return meshlets;
+}
+
+bool QEMeshletCache::Save(const fs::path& cachePath, const QEMesh& mesh, const std::vector<std::shared_ptr<Meshlet>>& meshlets, const QEMeshletBuildSettings& settings)
+{
+    if (meshlets.size() != mesh.MeshData.size())
+        return false;
+
+    // Se escribe a un temporal y se renombra: una importacion cortada no deja una cache a medias
+    fs::path tempPath = cachePath;
+    tempPath += ".tmp";
+
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (!file.is_open())
+        {
+            QE_LOG_WARN_CAT_F("QEMeshletCache", "Could not write meshlet cache {}", cachePath.string());
+            return false;
+        }
+
+        const QEMeshletBuildSettings clamped = settings.Clamped();
+
+        CacheHeader header;
+        header.Magic = CACHE_MAGIC;
+        header.Version = CACHE_VERSION;
+        header.MaxVertices = clamped.MaxVertices;
+        header.MaxTriangles = clamped.MaxTriangles;
+        header.ConeWeight = clamped.ConeWeight;
+        header.MaxLods = clamped.MaxLods;
+        header.TriangleSlots = Meshlet::MESHLET_TRIANGLE_SLOTS;
+        header.DescriptorStride = sizeof(MeshletDescriptor);
+        header.SubMeshCount = static_cast<uint32_t>(mesh.MeshData.size());
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+        for (size_t i = 0; i < mesh.MeshData.size(); ++i)
+        {
+            const QEMeshData& subMesh = mesh.MeshData[i];
+            const Meshlet& meshlet = *meshlets[i];
+
+            CacheSubMeshHeader subHeader;
+            subHeader.GeometryHash = ComputeGeometryHash(subMesh);
+            subHeader.VertexCount = static_cast<uint32_t>(subMesh.Vertices.size());
+            subHeader.IndexCount = static_cast<uint32_t>(subMesh.Indices.size());
+            subHeader.LodCount = static_cast<uint32_t>(meshlet.lods.size());
+            subHeader.MeshletCount = static_cast<uint32_t>(meshlet.gpuMeshlets.size());
+            subHeader.IndexDataCount = static_cast<uint32_t>(meshlet.indexData.size());
+            file.write(reinterpret_cast<const char*>(&subHeader), sizeof(subHeader));
+
+            WriteArray(file, meshlet.lods);
+            WriteArray(file, meshlet.gpuMeshlets);
+            WriteArray(file, meshlet.indexData);
+        }
+
+        if (!file)
+        {
+            QE_LOG_WARN_CAT_F("QEMeshletCache", "Could not write meshlet cache {}", cachePath.string());
+            return false;
+        }
+    }
+
+    std::error_code ec;
+    fs::rename(tempPath, cachePath, ec);
+    if (ec)
+    {
+        fs::remove(tempPath, ec);
+        QE_LOG_WARN_CAT_F("QEMeshletCache", "Could not replace meshlet cache {}", cachePath.string());
+        return false;
+    }
+
+    return true;
+}
+
+bool QEMeshletCache::Load(const fs::path& cachePath, const QEMesh& mesh, const QEMeshletBuildSettings& settings, std::vector<std::shared_ptr<Meshlet>>& outMeshlets)
+{
+    std::ifstream file(cachePath, std::ios::binary);
+    if (!file.is_open())
+        return false;
+
+    const QEMeshletBuildSettings clamped = settings.Clamped();
+
+    CacheHeader header;
+    file.read(reinterpret_cast<char*>(&header), sizeof(header));
+    if (!file ||
+        header.Magic != CACHE_MAGIC ||
+        header.Version != CACHE_VERSION ||
+        header.MaxVertices != clamped.MaxVertices ||
+        header.MaxTriangles != clamped.MaxTriangles ||
+        header.ConeWeight != clamped.ConeWeight ||
+        header.MaxLods != clamped.MaxLods ||
+        header.TriangleSlots != Meshlet::MESHLET_TRIANGLE_SLOTS ||
+        header.DescriptorStride != sizeof(MeshletDescriptor) ||
+        header.SubMeshCount != mesh.MeshData.size())
+    {
+        return false;
+    }
+
+    std::vector<std::shared_ptr<Meshlet>> meshlets(mesh.MeshData.size());
+    for (size_t i = 0; i < mesh.MeshData.size(); ++i)
+    {
+        const QEMeshData& subMesh = mesh.MeshData[i];
+
+        CacheSubMeshHeader subHeader;
+        file.read(reinterpret_cast<char*>(&subHeader), sizeof(subHeader));
+        if (!file ||
+            subHeader.VertexCount != subMesh.Vertices.size() ||
+            subHeader.IndexCount != subMesh.Indices.size() ||
+            subHeader.IndexDataCount != static_cast<uint64_t>(subHeader.MeshletCount) * Meshlet::MESHLET_TRIANGLE_SLOTS * 3 ||
+            subHeader.GeometryHash != ComputeGeometryHash(subMesh))
+        {
+            return false;
+        }
+
+        auto meshlet = std::make_shared<Meshlet>();
+        if (!ReadArray(file, meshlet->lods, subHeader.LodCount) ||
+            !ReadArray(file, meshlet->gpuMeshlets, subHeader.MeshletCount) ||
+            !ReadArray(file, meshlet->indexData, subHeader.IndexDataCount))
+        {
+            return false;
+        }
+
+        meshlet->verticesData = subMesh.Vertices;
+        meshlets[i] = meshlet;
+    }
+
+    outMeshlets = std::move(meshlets);
+    return true;
+}
+
+std::vector<std::shared_ptr<Meshlet>> QEMeshletCache::LoadOrBuild(const QEMesh& mesh)
+{
+    std::error_code ec;
+    const fs::path meshPath = mesh.FilePath;
+    const bool hasSourceFile = !mesh.FilePath.empty() && fs::is_regular_file(meshPath, ec);
+
+    if (hasSourceFile)
+    {
+        std::vector<std::shared_ptr<Meshlet>> cached;
+        if (Load(GetCachePath(meshPath), mesh, Settings, cached))
+            return cached;
+    }
+
+    auto meshlets = Build(mesh, Settings);
+
+    // Mallas importadas antes de la cache o con otros limites: se regenera para la proxima carga
+    if (hasSourceFile)
+    {
+        Save(GetCachePath(meshPath), mesh, meshlets, Settings);
+    }
+
+    return meshlets;
+}
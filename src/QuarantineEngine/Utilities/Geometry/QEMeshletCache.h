@@ -0,0 +1,48 @@
+#pragma once
+
+#ifndef QE_MESHLET_CACHE_H
+#define QE_MESHLET_CACHE_H
+
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+#include <Meshlet.h>
+#include <QEMeshData.h>
+
+namespace fs = std::filesystem;
+
+/// Meshlets de una malla guardados junto a ella (Meshes/x.gltf -> Meshes/x.qemeshlets).
+/// El fichero guarda los descriptores, los rangos de LOD y los indices ya en el layout que se sube
+/// a la GPU, asi cargar es leer y copiar. Cada submesh lleva un hash de sus posiciones e indices y
+/// la cabecera los limites de construccion: si algo no coincide se reconstruye.
+class QEMeshletCache
+{
+private:
+    static constexpr uint32_t CACHE_MAGIC = 0x4C4D4551;     // "QEML"
+    static constexpr uint32_t CACHE_VERSION = 1;
+
+public:
+    /// Limites activos para importar y reconstruir; se ajustan por GPU destino al arrancar.
+    static QEMeshletBuildSettings Settings;
+
+    static fs::path GetCachePath(const fs::path& meshPath);
+
+    /// Construye los meshlets de todos los submeshes en hilos de trabajo (el mayor primero).
+    static std::vector<std::shared_ptr<Meshlet>> Build(const QEMesh& mesh, const QEMeshletBuildSettings& settings);
+
+    static bool Save(const fs::path& cachePath, const QEMesh& mesh, const std::vector<std::shared_ptr<Meshlet>>& meshlets, const QEMeshletBuildSettings& settings);
+    static bool Load(const fs::path& cachePath, const QEMesh& mesh, const QEMeshletBuildSettings& settings, std::vector<std::shared_ptr<Meshlet>>& outMeshlets);
+
+    /// Carga la cache de la malla o, si falta o no es valida, construye y la vuelve a escribir.
+    static std::vector<std::shared_ptr<Meshlet>> LoadOrBuild(const QEMesh& mesh);
+};
+
+
+
+namespace QE
+{
+    using ::QEMeshletCache;
+} // namespace QE
+// QE namespace aliases
+#endif // !QE_MESHLET_CACHE_H
@@ -0,0 +1,284 @@
+#include "QEMeshletCulling.h"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <DeviceModule.h>
+#include <BufferManageModule.h>
+#include <SynchronizationModule.h>
+#include <QEOcclusionCulling.h>
+#include <UBO.h>
+#include <Logging/QELogMacros.h>
+
+namespace
+{
+    float MaxAxisScale(const glm::mat4& model)
+    {
+        return std::max({
+            glm::length(glm::vec3(model[0])),
+            glm::length(glm::vec3(model[1])),
+            glm::length(glm::vec3(model[2])) });
+    }
+
+    bool SameCounters(const QEMeshletCullCounters& a, const QEMeshletCullCounters& b)
+    {
+        return a.Tested == b.Tested &&
+            a.FrustumCulled == b.FrustumCulled &&
+            a.ConeCulled == b.ConeCulled &&
+            a.HiZCulled == b.HiZCulled;
+    }
+}
+
+void QEMeshletCulling::CreateBuffers()
+{
+    this->deviceModule = DeviceModule::getInstance();
+    this->bufferSize = HEADER_SIZE + sizeof(float) * MAX_HIZ_TEXELS;
+
+    this->buffers.assign(MAX_FRAMES_IN_FLIGHT, VK_NULL_HANDLE);
+    this->buffersMemory.assign(MAX_FRAMES_IN_FLIGHT, VK_NULL_HANDLE);
+    this->mappedData.assign(MAX_FRAMES_IN_FLIGHT, nullptr);
+    this->pendingCounters.assign(MAX_FRAMES_IN_FLIGHT, false);
+    this->validatedSlots.assign(MAX_FRAMES_IN_FLIGHT, false);
+    this->cpuCountersPerSlot.assign(MAX_FRAMES_IN_FLIGHT, QEMeshletCullCounters{});
+
+    for (uint32_t i = 0; i < MAX_FRAMES_IN_FLIGHT; ++i)
+    {
+        // Coherente y mapeado siempre: la CPU escribe la Hi-Z y lee los contadores sin flush
+        BufferManageModule::createBuffer(
+            this->bufferSize,
+            VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+            this->buffers[i],
+            this->buffersMemory[i],
+            *this->deviceModule);
+
+        void* data = nullptr;
+        if (vkMapMemory(this->deviceModule->device, this->buffersMemory[i], 0, this->bufferSize, 0, &data) != VK_SUCCESS)
+        {
+            throw std::runtime_error("failed to map meshlet culling buffer!");
+        }
+
+        this->mappedData[i] = static_cast<uint8_t*>(data);
+        std::memset(this->mappedData[i], 0, static_cast<size_t>(HEADER_SIZE));
+    }
+}
+
+VkBuffer QEMeshletCulling::GetBuffer(uint32_t frameSlot)
+{
+    if (this->buffers.empty())
+    {
+        CreateBuffers();
+    }
+
+    return frameSlot < this->buffers.size() ? this->buffers[frameSlot] : VK_NULL_HANDLE;
+}
+
+void QEMeshletCulling::BeginFrame(uint32_t frameSlot, UniformCamera* cameraData, float viewportHeight)
+{
+    this->camera = cameraData;
+    this->viewportHeight = std::max(1.0f, viewportHeight);
+
+    // Nadie ha enlazado el buffer todavia: no hay materiales de mesh shaders
+    if (this->buffers.empty() || frameSlot >= this->buffers.size())
+    {
+        this->hizUploaded = false;
+        this->_stats = {};
+        return;
+    }
+
+    // La referencia del frame anterior se guarda en su slot para compararla al leerlo
+    this->cpuCountersPerSlot[this->currentSlot] = this->_stats.Cpu;
+    this->currentSlot = frameSlot;
+
+    const QEMeshletCullCounters gpuCounters = this->_stats.Gpu;
+    const uint32_t mismatches = this->_stats.CpuGpuMismatches;
+    this->_stats = {};
+    this->_stats.Gpu = gpuCounters;
+    this->_stats.CpuGpuMismatches = mismatches;
+
+    uint8_t* data = this->mappedData[frameSlot];
+    glm::uvec4* header = reinterpret_cast<glm::uvec4*>(data);
+
+    // El slot ya se ha esperado: sus contadores son los del ultimo frame que lo uso
+    if (this->pendingCounters[frameSlot])
+    {
+        const glm::uvec4 counters = header[1];
+        this->_stats.Gpu = { counters.x, counters.y, counters.z, counters.w };
+
+        if (this->validatedSlots[frameSlot] && !SameCounters(this->_stats.Gpu, this->cpuCountersPerSlot[frameSlot]))
+        {
+            ++this->_stats.CpuGpuMismatches;
+            QE_LOG_WARN_CAT_F("MeshletCulling", "CPU/GPU meshlet counters differ: tested {}/{}, frustum {}/{}, cone {}/{}, hiz {}/{}",
+                this->cpuCountersPerSlot[frameSlot].Tested, this->_stats.Gpu.Tested,
+                this->cpuCountersPerSlot[frameSlot].FrustumCulled, this->_stats.Gpu.FrustumCulled,
+                this->cpuCountersPerSlot[frameSlot].ConeCulled, this->_stats.Gpu.ConeCulled,
+                this->cpuCountersPerSlot[frameSlot].HiZCulled, this->_stats.Gpu.HiZCulled);
+        }
+    }
+
+    header[1] = glm::uvec4(0u);
+    this->pendingCounters[frameSlot] = true;
+    this->validatedSlots[frameSlot] = this->CpuValidation;
+
+    // Hi-Z del occlusion culling de instancias de este mismo frame, si cabe
+    auto* occlusionCulling = QEOcclusionCulling::getInstance();
+    const QESoftwareOcclusionBuffer& hiz = occlusionCulling->GetOcclusionBuffer();
+    const uint32_t mipCount = hiz.GetMipCount();
+
+    size_t texelCount = 0;
+    for (uint32_t mip = 0; mip < mipCount; ++mip)
+    {
+        texelCount += hiz.GetMipData(mip).size();
+    }
+
+    this->hizUploaded = this->HiZCulling && occlusionCulling->Enabled &&
+        mipCount > 0 && mipCount <= MAX_HIZ_MIPS && texelCount <= MAX_HIZ_TEXELS;
+
+    header[0] = glm::uvec4(this->hizUploaded ? 1u : 0u, hiz.GetWidth(), hiz.GetHeight(), mipCount);
+    if (!this->hizUploaded)
+        return;
+
+    float* depth = reinterpret_cast<float*>(data + HEADER_SIZE);
+    uint32_t offset = 0;
+    for (uint32_t mip = 0; mip < mipCount; ++mip)
+    {
+        const std::vector<float>& level = hiz.GetMipData(mip);
+        const glm::uvec2 size = hiz.GetMipSize(mip);
+        header[2 + mip] = glm::uvec4(offset, size.x, size.y, 0u);
+        std::memcpy(depth + offset, level.data(), level.size() * sizeof(float));
+        offset += static_cast<uint32_t>(level.size());
+    }
+}
+
+void QEMeshletCulling::Cleanup()
+{
+    if (this->deviceModule != nullptr)
+    {
+        for (size_t i = 0; i < this->buffers.size(); ++i)
+        {
+            if (this->mappedData[i] != nullptr)
+            {
+                vkUnmapMemory(this->deviceModule->device, this->buffersMemory[i]);
+            }
+            vkDestroyBuffer(this->deviceModule->device, this->buffers[i], nullptr);
+            vkFreeMemory(this->deviceModule->device, this->buffersMemory[i], nullptr);
+        }
+    }
+
+    this->buffers.clear();
+    this->buffersMemory.clear();
+    this->mappedData.clear();
+    this->pendingCounters.clear();
+    this->validatedSlots.clear();
+    this->cpuCountersPerSlot.clear();
+    this->deviceModule = nullptr;
+    this->camera = nullptr;
+    this->hizUploaded = false;
+    this->currentSlot = 0;
+    this->_stats = {};
+}
+
+uint32_t QEMeshletCulling::BuildFlags(bool doubleSided) const
+{
+    uint32_t flags = 0;
+    if (this->FrustumCulling)
+        flags |= QE_MESHLET_CULL_FRUSTUM;
+    // Con doble cara no hay caras traseras que descartar
+    if (this->ConeCulling && !doubleSided)
+        flags |= QE_MESHLET_CULL_CONE;
+    if (this->HiZCulling)
+        flags |= QE_MESHLET_CULL_HIZ;
+    return flags;
+}
+
+uint32_t QEMeshletCulling::SelectLod(const Meshlet& meshlet, const glm::mat4& model, const glm::vec3& localCenter, float localRadius) const
+{
+    if (!this->LodSelection || this->camera == nullptr || meshlet.lods.size() < 2)
+        return 0;
+
+    const float scale = MaxAxisScale(model);
+    const glm::vec3 center = glm::vec3(model * glm::vec4(localCenter, 1.0f));
+    const float nearPlane = std::max(this->camera->Params.x, 1e-3f);
+    const float distance = std::max(glm::length(center - glm::vec3(this->camera->Position)) - localRadius * scale, nearPlane);
+
+    // Pixeles por unidad de mundo a distancia 1
+    const float pixelsPerUnit = 0.5f * this->viewportHeight * std::abs(this->camera->Projection[1][1]);
+
+    uint32_t selected = 0;
+    for (uint32_t lod = 1; lod < meshlet.lods.size(); ++lod)
+    {
+        const float projectedError = meshlet.lods[lod].Error * scale / distance * pixelsPerUnit;
+        if (projectedError > this->LodErrorPixels)
+            break;
+        selected = lod;
+    }
+
+    return selected;
+}
+
+QEMeshletCullResult QEMeshletCulling::IsMeshletVisible(const MeshletDescriptor& descriptor, const glm::mat4& model, uint32_t flags) const
+{
+    if (this->camera == nullptr)
+        return QEMeshletCullResult::Visible;
+
+    const glm::vec3 center = glm::vec3(model * glm::vec4(descriptor.sphere.center, 1.0f));
+    const float radius = descriptor.sphere.radius * MaxAxisScale(model);
+
+    if (flags & QE_MESHLET_CULL_FRUSTUM)
+    {
+        for (const glm::vec4& plane : this->camera->FrustumPlanes)
+        {
+            if (glm::dot(glm::vec3(plane), center) + plane.w < -radius)
+                return QEMeshletCullResult::Frustum;
+        }
+    }
+
+    if (flags & QE_MESHLET_CULL_CONE)
+    {
+        // Prueba de meshoptimizer sobre la esfera: no depende del apice del cono
+        const glm::vec3 axis = glm::normalize(glm::mat3(model) * descriptor.cone.normal);
+        const glm::vec3 toCenter = center - glm::vec3(this->camera->Position);
+        if (glm::dot(toCenter, axis) >= descriptor.cone.angle * glm::length(toCenter) + radius)
+            return QEMeshletCullResult::Cone;
+    }
+
+    if ((flags & QE_MESHLET_CULL_HIZ) && this->hizUploaded)
+    {
+        const QESoftwareOcclusionBuffer& hiz = QEOcclusionCulling::getInstance()->GetOcclusionBuffer();
+        if (hiz.IsAABBOccluded(center - glm::vec3(radius), center + glm::vec3(radius), this->camera->ViewProjection))
+            return QEMeshletCullResult::HiZ;
+    }
+
+    return QEMeshletCullResult::Visible;
+}
+
+void QEMeshletCulling::RecordDispatch(const Meshlet& meshlet, uint32_t lod, const glm::mat4& model, uint32_t flags)
+{
+    if (lod >= meshlet.lods.size())
+        return;
+
+    const MeshletLodRange& range = meshlet.lods[lod];
+    const uint32_t end = std::min<uint32_t>(range.FirstMeshlet + range.MeshletCount, static_cast<uint32_t>(meshlet.gpuMeshlets.size()));
+
+    ++this->_stats.Instances;
+    ++this->_stats.LodHistogram[std::min<uint32_t>(lod, Meshlet::MESHLET_MAX_LODS - 1)];
+
+    for (uint32_t i = range.FirstMeshlet; i < end; ++i)
+    {
+        const MeshletDescriptor& descriptor = meshlet.gpuMeshlets[i];
+        if (descriptor.primitive_count == 0)
+            continue;
+
+        ++this->_stats.SelectedMeshlets;
+        if (!this->CpuValidation)
+            continue;
+
+        ++this->_stats.Cpu.Tested;
+        switch (IsMeshletVisible(descriptor, model, flags))
+        {
+        case QEMeshletCullResult::Frustum: ++this->_stats.Cpu.FrustumCulled; break;
+        case QEMeshletCullResult::Cone:    ++this->_stats.Cpu.ConeCulled; break;
+        case QEMeshletCullResult::HiZ:     ++this->_stats.Cpu.HiZCulled; break;
+        default: break;
+        }
+    }
+}
@@ -0,0 +1,126 @@
+#pragma once
+
+#ifndef QE_MESHLET_CULLING_H
+#define QE_MESHLET_CULLING_H
+
+#include <cstdint>
+#include <vector>
+#include <vulkan/vulkan.h>
+#include <glm/glm.hpp>
+#include <QESingleton.h>
+#include <Meshlet.h>
+
+class DeviceModule;
+struct UniformCamera;
+
+/// Bits de PushConstantMeshletStruct::flags y de los parametros globales (mismos valores en mesh.task).
+enum QEMeshletCullFlags : uint32_t
+{
+    QE_MESHLET_CULL_FRUSTUM = 1u << 0,
+    QE_MESHLET_CULL_CONE = 1u << 1,
+    QE_MESHLET_CULL_HIZ = 1u << 2
+};
+
+enum class QEMeshletCullResult : uint32_t
+{
+    Visible = 0,
+    Frustum,
+    Cone,
+    HiZ
+};
+
+struct QEMeshletCullCounters
+{
+    uint32_t Tested = 0;
+    uint32_t FrustumCulled = 0;
+    uint32_t ConeCulled = 0;
+    uint32_t HiZCulled = 0;
+};
+
+struct QEMeshletFrameStats
+{
+    QEMeshletCullCounters Cpu;          // Referencia en CPU del frame actual (solo con CpuValidation)
+    QEMeshletCullCounters Gpu;          // Contadores del task shader de hace MAX_FRAMES_IN_FLIGHT frames
+    uint32_t Instances = 0;
+    uint32_t SelectedMeshlets = 0;      // Meshlets lanzados tras elegir LOD (sin relleno)
+    uint32_t LodHistogram[Meshlet::MESHLET_MAX_LODS] = {};
+    uint32_t CpuGpuMismatches = 0;      // Slots en los que la referencia y el task shader no coinciden
+};
+
+/// Culling por meshlet de la ruta de mesh shaders: frustum con la esfera, cono de normales para
+/// caras traseras y, opcionalmente, la piramide Hi-Z del occlusion culling de instancias.
+/// mesh.task hace las mismas pruebas que IsMeshletVisible; los parametros globales (Hi-Z incluida)
+/// y los contadores viven en un SSBO por frame en vuelo, enlazado como "MeshletCulling".
+class QEMeshletCulling : public QESingleton<QEMeshletCulling>
+{
+private:
+    friend class QESingleton<QEMeshletCulling>;
+
+    // Cabecera del SSBO: uvec4 params, uvec4 counters, uvec4 mips[MAX_HIZ_MIPS], float depth[]
+    static constexpr uint32_t MAX_HIZ_MIPS = 16;
+    static constexpr VkDeviceSize HEADER_SIZE = sizeof(glm::uvec4) * (2 + MAX_HIZ_MIPS);
+    static constexpr uint32_t MAX_HIZ_TEXELS = 256 * 128 * 4 / 3 + MAX_HIZ_MIPS;
+
+    DeviceModule* deviceModule = nullptr;
+    std::vector<VkBuffer> buffers;
+    std::vector<VkDeviceMemory> buffersMemory;
+    std::vector<uint8_t*> mappedData;
+    std::vector<bool> pendingCounters;
+    std::vector<bool> validatedSlots;
+    std::vector<QEMeshletCullCounters> cpuCountersPerSlot;
+    VkDeviceSize bufferSize = 0;
+    uint32_t currentSlot = 0;
+
+    UniformCamera* camera = nullptr;
+    float viewportHeight = 1.0f;
+    bool hizUploaded = false;
+    QEMeshletFrameStats _stats;
+
+private:
+    void CreateBuffers();
+
+public:
+    bool FrustumCulling = true;
+    bool ConeCulling = true;
+    bool HiZCulling = true;
+    bool LodSelection = true;
+    /// Error geometrico maximo admitido al elegir LOD, en pixeles de pantalla.
+    float LodErrorPixels = 1.0f;
+    /// Repite en CPU las pruebas de cada meshlet lanzado para validar los contadores de GPU.
+    bool CpuValidation = false;
+
+public:
+    QEMeshletCulling() = default;
+
+    /// Tras waitForFrameSlot y el occlusion culling de instancias: recoge los contadores del slot,
+    /// los pone a cero y sube los parametros y la Hi-Z de este frame.
+    void BeginFrame(uint32_t frameSlot, UniformCamera* cameraData, float viewportHeight);
+    void Cleanup();
+
+    uint32_t BuildFlags(bool doubleSided) const;
+    /// LOD mas grueso cuyo error proyectado no supera LodErrorPixels.
+    uint32_t SelectLod(const Meshlet& meshlet, const glm::mat4& model, const glm::vec3& localCenter, float localRadius) const;
+
+    /// Referencia en CPU de las pruebas de mesh.task.
+    QEMeshletCullResult IsMeshletVisible(const MeshletDescriptor& descriptor, const glm::mat4& model, uint32_t flags) const;
+    /// Lanza la referencia sobre un rango y acumula sus contadores; registra el meshlet seleccionado.
+    void RecordDispatch(const Meshlet& meshlet, uint32_t lod, const glm::mat4& model, uint32_t flags);
+
+    /// Crea los buffers la primera vez que un material los enlaza.
+    VkBuffer GetBuffer(uint32_t frameSlot);
+    VkDeviceSize GetBufferSize() const { return bufferSize; }
+    const QEMeshletFrameStats& GetFrameStats() const { return _stats; }
+};
+
+
+
+namespace QE
+{
+    using ::QEMeshletCullFlags;
+    using ::QEMeshletCullResult;
+    using ::QEMeshletCullCounters;
+    using ::QEMeshletFrameStats;
+    using ::QEMeshletCulling;
+} // namespace QE
+// QE namespace aliases
+#endif // !QE_MESHLET_CULLING_H
@@ -0,0 +1,371 @@
+#include "QERaycastSystem.h"
+
+#include <algorithm>
+#include <chrono>
+#include <random>
+
+#include <GameObjectManager.h>
+#include <QEGameObject.h>
+#include <QETransform.h>
+#include <QEGeometryComponent.h>
+#include <QEMeshBVH.h>
+#include <Timer.h>
+
+namespace
+{
+    QERay TransformRay(const QERay& ray, const glm::mat4& matrix)
+    {
+        // La direccion no se normaliza: asi t es el mismo en espacio local y en mundo
+        QERay result{};
+        result.Origin = glm::vec3(matrix * glm::vec4(ray.Origin, 1.0f));
+        result.Direction = glm::vec3(matrix * glm::vec4(ray.Direction, 0.0f));
+        return result;
+    }
+
+    void TransformAABB(const glm::vec3& localMin, const glm::vec3& localMax, const glm::mat4& matrix, glm::vec3& outMin, glm::vec3& outMax)
+    {
+        const glm::vec3 center = (localMin + localMax) * 0.5f;
+        const glm::vec3 extents = (localMax - localMin) * 0.5f;
+
+        const glm::vec3 worldCenter = glm::vec3(matrix * glm::vec4(center, 1.0f));
+        const glm::mat3 absBasis(glm::abs(glm::vec3(matrix[0])), glm::abs(glm::vec3(matrix[1])), glm::abs(glm::vec3(matrix[2])));
+        const glm::vec3 worldExtents = absBasis * extents;
+
+        outMin = worldCenter - worldExtents;
+        outMax = worldCenter + worldExtents;
+    }
+}
+
+void QERaycastSystem::CollectEntries(const std::shared_ptr<QEGameObject>& gameObject, std::vector<SceneEntry>& outEntries) const
+{
+    if (!gameObject)
+        return;
+
+    auto transform = gameObject->GetComponent<QETransform>();
+    auto geometry = gameObject->GetComponent<QEGeometryComponent>();
+
+    if (transform && geometry)
+    {
+        const bool active = gameObject->IsActiveInHierarchy();
+        const QEMesh* mesh = geometry->GetMesh();
+        const size_t subMeshCount = mesh ? mesh->MeshData.size() : 0;
+
+        for (size_t subMeshIndex = 0; subMeshIndex < subMeshCount; ++subMeshIndex)
+        {
+            SceneEntry entry{};
+            entry.GameObject = gameObject;
+            entry.Transform = transform;
+            entry.Geometry = geometry;
+            entry.SubMeshIndex = static_cast<uint32_t>(subMeshIndex);
+            entry.Active = active;
+            // WorldVersion 0 no coincide nunca con el de un transform: fuerza UpdateEntry
+            entry.WorldVersion = 0;
+            outEntries.push_back(std::move(entry));
+        }
+    }
+
+    for (const auto& child : gameObject->GetChildren())
+    {
+        CollectEntries(child, outEntries);
+    }
+}
+
+bool QERaycastSystem::UpdateEntry(SceneEntry& entry) const
+{
+    const QEMesh* mesh = entry.Geometry->GetMesh();
+    const uint32_t worldVersion = entry.Transform->GetWorldVersion();
+
+    if (mesh == entry.Mesh && worldVersion == entry.WorldVersion)
+        return false;
+
+    entry.Mesh = mesh;
+    entry.WorldVersion = worldVersion;
+
+    if (mesh && entry.SubMeshIndex < mesh->MeshData.size())
+    {
+        entry.LocalToWorld = entry.Transform->GetWorldMatrix() * mesh->MeshData[entry.SubMeshIndex].ModelTransform;
+        entry.WorldToLocal = glm::inverse(entry.LocalToWorld);
+        entry.NormalMatrix = glm::transpose(glm::mat3(entry.WorldToLocal));
+    }
+
+    return true;
+}
+
+void QERaycastSystem::RebuildSceneBVH()
+{
+    std::vector<glm::vec3> entryMin(_entries.size());
+    std::vector<glm::vec3> entryMax(_entries.size());
+
+    for (size_t i = 0; i < _entries.size(); ++i)
+    {
+        const SceneEntry& entry = _entries[i];
+        if (!entry.Mesh || entry.SubMeshIndex >= entry.Mesh->MeshData.size())
+        {
+            // Sin malla: caja invertida, el rayo nunca la corta
+            entryMin[i] = glm::vec3(std::numeric_limits<float>::max());
+            entryMax[i] = glm::vec3(-std::numeric_limits<float>::max());
+            continue;
+        }
+
+        const auto& bounds = entry.Mesh->MeshData[entry.SubMeshIndex].BoundingBox;
+        TransformAABB(bounds.first, bounds.second, entry.LocalToWorld, entryMin[i], entryMax[i]);
+    }
+
+    _sceneBVH.Build(entryMin, entryMax);
+}
+
+void QERaycastSystem::Refresh()
+{
+    // Una consulta por frame como maximo reconstruye; el resto de rayos del frame reutiliza el BVH
+    const unsigned long long frame = Timer::getInstance()->GetFrameCount();
+    const uint32_t structureVersion = QEGameObject::GetStructureVersion();
+
+    if (frame == _lastRefreshFrame && structureVersion == _structureVersion)
+        return;
+
+    _lastRefreshFrame = frame;
+    bool dirty = false;
+
+    if (structureVersion != _structureVersion)
+    {
+        _structureVersion = structureVersion;
+        _entries.clear();
+
+        for (const auto& root : GameObjectManager::getInstance()->GetRootGameObjects())
+        {
+            CollectEntries(root, _entries);
+        }
+
+        dirty = true;
+    }
+
+    for (auto& entry : _entries)
+    {
+        dirty |= UpdateEntry(entry);
+    }
+
+    if (dirty)
+    {
+        this->RebuildSceneBVH();
+    }
+}
+
+bool QERaycastSystem::RaycastEntry(const SceneEntry& entry, const QERay& ray, float& maxDistance, QERaycastHit& outHit, bool useMeshBVH) const
+{
+    const QEMesh* mesh = entry.Geometry->GetMesh();
+    if (!mesh || mesh != entry.Mesh)
+        return false;
+
+    const QERay localRay = TransformRay(ray, entry.WorldToLocal);
+    const QEMeshBVH* meshBVH = useMeshBVH ? entry.Geometry->GetTriangleBVH() : nullptr;
+
+    QEMeshRayHit localHit{};
+    bool hit = false;
+
+    if (meshBVH)
+    {
+        hit = meshBVH->RaycastSubMesh(*mesh, entry.SubMeshIndex, localRay, maxDistance, localHit);
+    }
+    else
+    {
+        const auto& bounds = mesh->MeshData[entry.SubMeshIndex].BoundingBox;
+        float boxT = 0.0f;
+        if (QEBVH::IntersectAABB(localRay, QEBVH::ComputeInverseDirection(localRay.Direction), bounds.first, bounds.second, maxDistance, boxT))
+        {
+            hit = QEMeshBVH::RaycastSubMeshBruteForce(*mesh, entry.SubMeshIndex, localRay, maxDistance, localHit);
+        }
+    }
+
+    if (!hit)
+        return false;
+
+    glm::vec3 normal = glm::normalize(entry.NormalMatrix * localHit.LocalNormal);
+    if (glm::dot(normal, ray.Direction) > 0.0f)
+        normal = -normal;
+
+    outHit.GameObject = entry.GameObject;
+    outHit.Distance = localHit.T;
+    outHit.Point = ray.Origin + ray.Direction * localHit.T;
+    outHit.Normal = normal;
+    outHit.SubMeshIndex = localHit.SubMeshIndex;
+    outHit.TriangleIndex = localHit.TriangleIndex;
+    return true;
+}
+
+void QERaycastSystem::RaycastEntryAll(const SceneEntry& entry, const QERay& ray, float maxDistance, std::vector<QERaycastHit>& outHits) const
+{
+    const QEMesh* mesh = entry.Geometry->GetMesh();
+    if (!mesh || mesh != entry.Mesh)
+        return;
+
+    const QERay localRay = TransformRay(ray, entry.WorldToLocal);
+    std::vector<QEMeshRayHit> localHits;
+
+    if (const QEMeshBVH* meshBVH = entry.Geometry->GetTriangleBVH())
+    {
+        meshBVH->RaycastSubMeshAll(*mesh, entry.SubMeshIndex, localRay, maxDistance, localHits);
+    }
+    else
+    {
+        QEMeshBVH::RaycastSubMeshAllBruteForce(*mesh, entry.SubMeshIndex, localRay, maxDistance, localHits);
+    }
+
+    for (const auto& localHit : localHits)
+    {
+        glm::vec3 normal = glm::normalize(entry.NormalMatrix * localHit.LocalNormal);
+        if (glm::dot(normal, ray.Direction) > 0.0f)
+            normal = -normal;
+
+        QERaycastHit hit{};
+        hit.GameObject = entry.GameObject;
+        hit.Distance = localHit.T;
+        hit.Point = ray.Origin + ray.Direction * localHit.T;
+        hit.Normal = normal;
+        hit.SubMeshIndex = localHit.SubMeshIndex;
+        hit.TriangleIndex = localHit.TriangleIndex;
+        outHits.push_back(std::move(hit));
+    }
+}
+
+bool QERaycastSystem::Raycast(const QERay& ray, QERaycastHit& outHit, float maxDistance, bool includeInactive)
+{
+    this->Refresh();
+
+    bool hit = false;
+    _sceneBVH.Traverse(ray, maxDistance, [&](uint32_t entryIndex, float& currentMax)
+        {
+            const SceneEntry& entry = _entries[entryIndex];
+            if (!includeInactive && !entry.Active)
+                return;
+
+            hit |= RaycastEntry(entry, ray, currentMax, outHit, true);
+        });
+
+    return hit;
+}
+
+bool QERaycastSystem::GetSceneBounds(glm::vec3& outMin, glm::vec3& outMax)
+{
+    this->Refresh();
+
+    if (_sceneBVH.Empty())
+        return false;
+
+    outMin = _sceneBVH.GetNodes()[0].Min;
+    outMax = _sceneBVH.GetNodes()[0].Max;
+    return true;
+}
+
+void QERaycastSystem::RaycastAll(const QERay& ray, std::vector<QERaycastHit>& outHits, float maxDistance, bool includeInactive)
+{
+    this->Refresh();
+
+    outHits.clear();
+    float traversalMax = maxDistance;
+    _sceneBVH.Traverse(ray, traversalMax, [&](uint32_t entryIndex, float& currentMax)
+        {
+            const SceneEntry& entry = _entries[entryIndex];
+            if (!includeInactive && !entry.Active)
+                return;
+
+            RaycastEntryAll(entry, ray, currentMax, outHits);
+        });
+
+    std::sort(outHits.begin(), outHits.end(), [](const QERaycastHit& a, const QERaycastHit& b)
+        {
+            return a.Distance < b.Distance;
+        });
+}
+
+bool QERaycastSystem::RaycastBruteForce(const QERay& ray, QERaycastHit& outHit, float maxDistance)
+{
+    bool hit = false;
+    for (const auto& entry : _entries)
+    {
+        if (entry.Active)
+        {
+            hit |= RaycastEntry(entry, ray, maxDistance, outHit, false);
+        }
+    }
+    return hit;
+}
+
+QERaycastBenchmarkResult QERaycastSystem::RunBenchmark(uint32_t rayCount, uint32_t bruteForceRays, uint32_t seed)
+{
+    this->Refresh();
+
+    QERaycastBenchmarkResult result{};
+    if (_sceneBVH.Empty() || rayCount == 0)
+        return result;
+
+    const QEBVHNode& root = _sceneBVH.GetNodes()[0];
+    const glm::vec3 center = (root.Min + root.Max) * 0.5f;
+    const float radius = std::max(glm::length(root.Max - root.Min) * 0.5f, 1.0f);
+
+    // Rayos desde una esfera que envuelve la escena hacia puntos aleatorios de su AABB
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    std::normal_distribution<float> gaussian(0.0f, 1.0f);
+
+    std::vector<QERay> rays(rayCount);
+    for (auto& ray : rays)
+    {
+        glm::vec3 onSphere(gaussian(rng), gaussian(rng), gaussian(rng));
+        if (glm::dot(onSphere, onSphere) < 1e-6f)
+            onSphere = glm::vec3(0.0f, 1.0f, 0.0f);
+
+        const glm::vec3 target = glm::mix(root.Min, root.Max, glm::vec3(unit(rng), unit(rng), unit(rng)));
+        ray.Origin = center + glm::normalize(onSphere) * radius * 1.5f;
+        ray.Direction = glm::normalize(target - ray.Origin);
+    }
+
+    std::vector<float> bvhDistances(rayCount, -1.0f);
+
+    const auto bvhStart = std::chrono::high_resolution_clock::now();
+    for (uint32_t i = 0; i < rayCount; ++i)
+    {
+        QERaycastHit hit{};
+        if (this->Raycast(rays[i], hit))
+        {
+            ++result.Hits;
+            bvhDistances[i] = hit.Distance;
+        }
+    }
+    const double bvhSeconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - bvhStart).count();
+
+    result.Rays = rayCount;
+    result.BVHRaysPerSecond = bvhSeconds > 0.0 ? rayCount / bvhSeconds : 0.0;
+
+    bruteForceRays = std::min(bruteForceRays, rayCount);
+    if (bruteForceRays == 0)
+        return result;
+
+    const auto bruteStart = std::chrono::high_resolution_clock::now();
+    for (uint32_t i = 0; i < bruteForceRays; ++i)
+    {
+        QERaycastHit hit{};
+        const bool hitBrute = this->RaycastBruteForce(rays[i], hit, std::numeric_limits<float>::max());
+        const bool hitBVH = bvhDistances[i] >= 0.0f;
+
+        if (hitBrute != hitBVH)
+        {
+            ++result.MismatchedHits;
+        }
+        else if (hitBrute && std::fabs(hit.Distance - bvhDistances[i]) > 1e-3f * std::max(1.0f, hit.Distance))
+        {
+            ++result.MismatchedHits;
+        }
+    }
+    const double bruteSeconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - bruteStart).count();
+
+    result.BruteForceRaysPerSecond = bruteSeconds > 0.0 ? bruteForceRays / bruteSeconds : 0.0;
+    return result;
+}
+
+void QERaycastSystem::ResetSceneState()
+{
+    _entries.clear();
+    _sceneBVH.Clear();
+    _structureVersion = UINT32_MAX;
+    _lastRefreshFrame = ULLONG_MAX;
+}
@@ -0,0 +1,106 @@
+#pragma once
+
+#ifndef QE_RAYCAST_SYSTEM_H
+#define QE_RAYCAST_SYSTEM_H
+
+#include <climits>
+#include <limits>
+#include <memory>
+#include <vector>
+#include <glm/glm.hpp>
+#include <QESingleton.h>
+#include <QEBVH.h>
+#include <QEMeshData.h>
+
+class QEGameObject;
+class QETransform;
+class QEGeometryComponent;
+
+struct QERaycastHit
+{
+    std::shared_ptr<QEGameObject> GameObject;
+    float Distance = 0.0f;
+    glm::vec3 Point = glm::vec3(0.0f);
+    glm::vec3 Normal = glm::vec3(0.0f, 1.0f, 0.0f);
+    uint32_t SubMeshIndex = 0;
+    uint32_t TriangleIndex = 0;
+};
+
+struct QERaycastBenchmarkResult
+{
+    uint32_t Rays = 0;
+    uint32_t Hits = 0;
+    double BVHRaysPerSecond = 0.0;
+    double BruteForceRaysPerSecond = 0.0;  // 0 si no se ha medido
+    uint32_t MismatchedHits = 0;           // Diferencias BVH vs fuerza bruta
+};
+
+/// Raycasts contra la geometria renderizada (no contra los colliders de Jolt).
+/// Nivel superior: BVH sobre los AABB en mundo de cada submesh de la escena, reconstruido
+/// solo cuando cambia algun transform o la estructura de la escena. Nivel inferior: el
+/// BVH de triangulos de cada malla (QEMeshBVH), compartido entre instancias.
+class QERaycastSystem : public QESingleton<QERaycastSystem>
+{
+private:
+    friend class QESingleton<QERaycastSystem>;
+
+    struct SceneEntry
+    {
+        std::shared_ptr<QEGameObject> GameObject;
+        std::shared_ptr<QETransform> Transform;
+        std::shared_ptr<QEGeometryComponent> Geometry;
+        const QEMesh* Mesh = nullptr;
+        uint32_t SubMeshIndex = 0;
+        uint32_t WorldVersion = 0;
+        bool Active = true;
+        glm::mat4 LocalToWorld = glm::mat4(1.0f);   // World * ModelTransform del submesh
+        glm::mat4 WorldToLocal = glm::mat4(1.0f);
+        glm::mat3 NormalMatrix = glm::mat3(1.0f);
+    };
+
+    std::vector<SceneEntry> _entries;
+    QEBVH _sceneBVH;
+    uint32_t _structureVersion = UINT32_MAX;
+    unsigned long long _lastRefreshFrame = ULLONG_MAX;
+
+private:
+    void Refresh();
+    void CollectEntries(const std::shared_ptr<QEGameObject>& gameObject, std::vector<SceneEntry>& outEntries) const;
+    bool UpdateEntry(SceneEntry& entry) const;
+    void RebuildSceneBVH();
+    bool RaycastEntry(const SceneEntry& entry, const QERay& ray, float& maxDistance, QERaycastHit& outHit, bool useMeshBVH) const;
+    void RaycastEntryAll(const SceneEntry& entry, const QERay& ray, float maxDistance, std::vector<QERaycastHit>& outHits) const;
+    bool RaycastBruteForce(const QERay& ray, QERaycastHit& outHit, float maxDistance);
+
+public:
+    QERaycastSystem() = default;
+
+    /// Impacto mas cercano. ray.Direction debe estar normalizada para que Distance este en unidades de mundo.
+    bool Raycast(const QERay& ray, QERaycastHit& outHit, float maxDistance = std::numeric_limits<float>::max(), bool includeInactive = false);
+    /// Todos los impactos ordenados por distancia.
+    void RaycastAll(const QERay& ray, std::vector<QERaycastHit>& outHits, float maxDistance = std::numeric_limits<float>::max(), bool includeInactive = false);
+
+    /// Lanza rayCount rayos aleatorios contra la escena y mide rayos por segundo.
+    /// Con bruteForceRays > 0 repite ese numero de rayos sin BVH y compara resultados.
+    QERaycastBenchmarkResult RunBenchmark(uint32_t rayCount, uint32_t bruteForceRays = 0, uint32_t seed = 1);
+
+    /// AABB en mundo de toda la geometria de la escena (raiz del BVH). false si la escena esta vacia.
+    bool GetSceneBounds(glm::vec3& outMin, glm::vec3& outMax);
+
+    uint32_t GetSceneEntryCount() const { return static_cast<uint32_t>(_entries.size()); }
+    size_t GetSceneBVHMemorySize() const { return _sceneBVH.GetMemorySize(); }
+
+    /// Fuerza la recogida de objetos en la siguiente consulta y suelta las referencias a la escena.
+    void ResetSceneState();
+};
+
+
+
+namespace QE
+{
+    using ::QERaycastHit;
+    using ::QERaycastBenchmarkResult;
+    using ::QERaycastSystem;
+} // namespace QE
+// QE namespace aliases
+#endif // !QE_RAYCAST_SYSTEM_H
@@ -9,6 +9,10 @@
 #include <QEGameObject.h>
 #include "QECamera.h"
 #include <Helpers/QEMemoryTrack.h>
+#include <ShadowCacheManager.h>
+#include <ShadowAtlasManager.h>
+#include <ShadowCasterCulling.h>
+#include <GameObjectManager.h>
 
 bool compareDistance(const LightMap& a, const LightMap& b)
 {
@@ -73,6 +77,12 @@ void LightManager::AddOmniShadowMapShader(std::shared_ptr<ShaderModule> omni_sha
     this->OmniShadowPipelineModule = this->OmniShadowShaderModule->ShadowPipelineModule;
 }
 
+void LightManager::AddOmniShadowLayeredShader(std::shared_ptr<ShaderModule> omni_shadow_layered_shader)
+{
+    this->OmniShadowLayeredShaderModule = omni_shadow_layered_shader;
+    this->OmniShadowLayeredPipelineModule = omni_shadow_layered_shader ? omni_shadow_layered_shader->ShadowPipelineModule : nullptr;
+}
+
 void LightManager::AddNewLight(std::shared_ptr<QELight> light_ptr, std::string& name)
 {
     if (light_ptr->ResourcesInitialized)
@@ -85,14 +95,12 @@ void LightManager::AddNewLight(std::shared_ptr<QELight> light_ptr, std::string&
         default:
         case LightType::POINT_LIGHT:
             this->PointLights.push_back(std::static_pointer_cast<QEPointLight>(light_ptr));
-            this->PointLights.back()->Setup(this->renderPassModule->OmniShadowMappingRenderPass);
+            this->PointLights.back()->Setup();
             this->PointLights.back()->idxShadowMap = (uint32_t)this->PointLights.size() - 1;
 
             this->AddLight(light_ptr, name);
-            this->PointShadowDescritors->AddPointLightResources(
-                this->PointLights.back()->shadowMappingResourcesPtr->shadowMapUBO,
-                this->PointLights.back()->shadowMappingResourcesPtr->CubemapImageView,
-                this->PointLights.back()->shadowMappingResourcesPtr->CubemapSampler);
+            this->PointShadowDescritors->AddPointLightResources(this->PointLights.back()->shadowMappingResourcesPtr->shadowMapUBO);
+            this->PointShadowDescritors->BindResources(this->PointLights.back()->shadowMappingResourcesPtr);
             break;
 
         case LightType::SUN_LIGHT:
@@ -122,14 +130,11 @@ void LightManager::AddNewLight(std::shared_ptr<QELight> light_ptr, std::string&
 
         case LightType::SPOT_LIGHT:
             this->SpotLights.push_back(std::dynamic_pointer_cast<QESpotLight>(light_ptr));
-            this->SpotLights.back()->Setup(this->renderPassModule->DirShadowMappingRenderPass);
+            this->SpotLights.back()->Setup();
             this->SpotLights.back()->idxShadowMap = (uint32_t)this->SpotLights.size() - 1;
             this->AddLight(light_ptr, name);
 
-            this->SpotShadowDescritors->AddSpotLightResources(
-                this->SpotLights.back()->shadowMappingResourcesPtr->OffscreenShadowMapUBO,
-                this->SpotLights.back()->shadowMappingResourcesPtr->ShadowImageView,
-                this->SpotLights.back()->shadowMappingResourcesPtr->ShadowSampler);
+            this->SpotShadowDescritors->AddSpotLightResources(this->SpotLights.back()->shadowMappingResourcesPtr->OffscreenShadowMapUBO);
             this->SpotShadowDescritors->BindResources(this->SpotLights.back()->shadowMappingResourcesPtr);
             break;
     }
@@ -257,6 +262,9 @@ void LightManager::DeleteLight(std::shared_ptr<QELight> light_ptr, std::string&
         _lights.erase(it);
     }
 
+    // Los indices de shadow map se han reordenado
+    ShadowCacheManager::getInstance()->InvalidateAll();
+
     lightBuffer.clear();
     lightBuffer.reserve(MAX_NUM_LIGHT);
 
@@ -478,6 +486,16 @@ const std::shared_ptr<ShadowPipelineModule>& LightManager::GetOmniShadowPipeline
     return OmniShadowPipelineModule;
 }
 
+const std::shared_ptr<ShadowPipelineModule>& LightManager::GetOmniShadowLayeredPipelineModule() const
+{
+    return OmniShadowLayeredPipelineModule;
+}
+
+bool LightManager::IsLayeredPointShadowActive() const
+{
+    return this->UseLayeredPointShadows && this->OmniShadowLayeredPipelineModule != nullptr;
+}
+
 const std::shared_ptr<ShaderModule>& LightManager::GetCSMShaderModule() const
 {
     return CSMShaderModule;
@@ -490,6 +508,9 @@ const std::shared_ptr<ShaderModule>& LightManager::GetOmniShadowShaderModule() c
 
 void LightManager::InitializeShadowMaps()
 {
+    // Los atlas deben existir antes de escribir los descriptor sets de render
+    ShadowAtlasManager::getInstance()->Initialize(this->renderPassModule->DirShadowMappingRenderPass);
+
     this->PointShadowDescritors->InitializeDescriptorSetLayouts(this->OmniShadowShaderModule);
     this->CSMDescritors->InitializeDescriptorSetLayouts(this->CSMShaderModule);
     this->SpotShadowDescritors->InitializeDescriptorSetLayouts(this->CSMShaderModule);
@@ -632,6 +653,10 @@ void LightManager::ResetSceneState()
 
 void LightManager::ResetShadowSceneState()
 {
+    ShadowCacheManager::getInstance()->ResetSceneState();
+    ShadowAtlasManager::getInstance()->ResetSceneState();
+    ShadowCasterCulling::getInstance()->ResetSceneState();
+
     for (auto& pLight : this->PointLights)
     {
         if (pLight)
@@ -694,8 +719,10 @@ void LightManager::CleanLastResources()
 
     CSMPipelineModule.reset();
     OmniShadowPipelineModule.reset();
+    OmniShadowLayeredPipelineModule.reset();
     CSMShaderModule.reset();
     OmniShadowShaderModule.reset();
+    OmniShadowLayeredShaderModule.reset();
 }
 
 void LightManager::CleanShadowMapResources()
@@ -732,6 +759,8 @@ void LightManager::CleanShadowMapResources()
     {
         this->SpotShadowDescritors->Clean();
     }
+
+    ShadowAtlasManager::getInstance()->Cleanup();
 }
 
 void LightManager::AddLight(std::shared_ptr<QELight> light_ptr, std::string& name)
@@ -1078,6 +1107,12 @@ void LightManager::Update(uint32_t currentFrame)
     this->UpdateCSMLights();
     this->UpdateUniform();
 
+    // Decide que vistas de sombra se regeneran este frame (puede restaurar matrices de cascadas diferidas)
+    GameObjectManager::getInstance()->RefreshShadowRenderItems();
+    ShadowAtlasManager::getInstance()->Update(this);
+    ShadowCacheManager::getInstance()->Update(this);
+    ShadowCasterCulling::getInstance()->Update(this);
+
     if (this->CSMDescritors)
     {
         this->CSMDescritors->UpdateResources(currentFrame);
@@ -1087,6 +1122,11 @@ void LightManager::Update(uint32_t currentFrame)
     {
         this->SpotShadowDescritors->UpdateResources(currentFrame);
     }
+
+    if (this->PointShadowDescritors)
+    {
+        this->PointShadowDescritors->UpdateResources(currentFrame);
+    }
 }
 
 void LightManager::ReindexShadowMaps()
@@ -89,18 +89,23 @@ private:
     std::shared_ptr<SpotShadowDescriptorsManager> SpotShadowDescritors;
     std::shared_ptr<ShadowPipelineModule> CSMPipelineModule;
     std::shared_ptr<ShadowPipelineModule> OmniShadowPipelineModule;
+    std::shared_ptr<ShadowPipelineModule> OmniShadowLayeredPipelineModule;
 
     std::shared_ptr<ShaderModule> CSMShaderModule;
     std::shared_ptr<ShaderModule> OmniShadowShaderModule;
+    std::shared_ptr<ShaderModule> OmniShadowLayeredShaderModule;
 
     void ReindexShadowMaps();
     void SyncDirectionalLightIndices();
 
 public:
+    bool UseLayeredPointShadows = true;
+
     LightManager();
 
     void AddDirShadowMapShader(std::shared_ptr<ShaderModule> shadow_mapping_shader);
     void AddOmniShadowMapShader(std::shared_ptr<ShaderModule> omni_shadow_mapping_shader);
+    void AddOmniShadowLayeredShader(std::shared_ptr<ShaderModule> omni_shadow_layered_shader);
 
     std::shared_ptr<QELight> CreateLight(LightType type, std::string name);
     void AddNewLight(std::shared_ptr<QELight> light_ptr, std::string& name);
@@ -132,6 +137,9 @@ public:
     const std::shared_ptr<SpotShadowDescriptorsManager>& GetSpotShadowDescriptors() const;
     const std::shared_ptr<ShadowPipelineModule>& GetCSMPipelineModule() const;
     const std::shared_ptr<ShadowPipelineModule>& GetOmniShadowPipelineModule() const;
+    const std::shared_ptr<ShadowPipelineModule>& GetOmniShadowLayeredPipelineModule() const;
+    /// Las seis caras de una point light en un solo pase (gl_Layer); si no, un pase por cara.
+    bool IsLayeredPointShadowActive() const;
     const std::shared_ptr<ShaderModule>& GetCSMShaderModule() const;
     const std::shared_ptr<ShaderModule>& GetOmniShadowShaderModule() const;
 
@@ -6,9 +6,9 @@ QEPointLight::QEPointLight() : QELight()
     this->lightType = LightType::POINT_LIGHT;
 }
 
-void QEPointLight::Setup(std::shared_ptr<VkRenderPass> renderPass)
+void QEPointLight::Setup()
 {
-    this->shadowMappingResourcesPtr = std::make_shared<OmniShadowResources>(renderPass);
+    this->shadowMappingResourcesPtr = std::make_shared<OmniShadowResources>();
 }
 
 void QEPointLight::UpdateUniform()
@@ -26,7 +26,8 @@ void QEPointLight::UpdateUniform()
     this->uniform->idxShadowMap = this->idxShadowMap;
 
     OmniShadowUniform omniParameters = {};
-    omniParameters.lightPos = glm::vec4(this->uniform->position, 1.0f);
+    // w = far plane: el shader de sombras guarda distancia / far como profundidad lineal
+    omniParameters.lightPos = glm::vec4(this->uniform->position, this->radius);
     omniParameters.projection = glm::perspective((float)(std::numbers::pi * 0.5), 1.0f, 0.01f, this->radius);
 
     this->shadowMappingResourcesPtr->UpdateUBOShadowMap(omniParameters);
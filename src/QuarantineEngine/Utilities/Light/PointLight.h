@@ -15,7 +15,7 @@ public:
 
 public:
     QEPointLight();
-    void Setup(std::shared_ptr<VkRenderPass> renderPass);
+    void Setup();
     void UpdateUniform() override;
     void CleanShadowMapResources();
 };
@@ -0,0 +1,266 @@
+#include "ShadowAtlasAllocator.h"
+#include <algorithm>
+
+ShadowAtlasAllocator::ShadowAtlasAllocator(uint32_t atlasSize, uint32_t minTileSize)
+{
+    this->atlasSize = RoundToPowerOfTwo(std::max(atlasSize, 1u));
+    this->minTileSize = std::min(RoundToPowerOfTwo(std::max(minTileSize, 1u)), this->atlasSize);
+
+    this->maxLevel = 0;
+    while ((this->atlasSize >> this->maxLevel) > this->minTileSize)
+    {
+        ++this->maxLevel;
+    }
+
+    this->Reset();
+}
+
+uint32_t ShadowAtlasAllocator::RoundToPowerOfTwo(uint32_t value)
+{
+    uint32_t result = 1;
+    while (result < value && result < (1u << 31))
+    {
+        result <<= 1;
+    }
+    return result;
+}
+
+uint32_t ShadowAtlasAllocator::LevelOffset(uint32_t level)
+{
+    // Nodos en los niveles [0, level): (4^level - 1) / 3
+    return static_cast<uint32_t>(((1ull << (2 * level)) - 1) / 3);
+}
+
+uint32_t ShadowAtlasAllocator::NodeIndex(uint32_t level, uint32_t x, uint32_t y) const
+{
+    return LevelOffset(level) + y * (1u << level) + x;
+}
+
+uint32_t ShadowAtlasAllocator::LevelForSize(uint32_t size) const
+{
+    uint32_t level = 0;
+    while (level < this->maxLevel && TileSizeAtLevel(level + 1) >= size)
+    {
+        ++level;
+    }
+    return level;
+}
+
+void ShadowAtlasAllocator::DecodeNode(uint32_t node, uint32_t& level, uint32_t& x, uint32_t& y) const
+{
+    level = 0;
+    while (level < this->maxLevel && LevelOffset(level + 1) <= node)
+    {
+        ++level;
+    }
+
+    const uint32_t local = node - LevelOffset(level);
+    const uint32_t dim = 1u << level;
+    x = local % dim;
+    y = local / dim;
+}
+
+void ShadowAtlasAllocator::Reset()
+{
+    this->nodes.assign(LevelOffset(this->maxLevel + 1), NodeState::Free);
+    this->usedArea = 0;
+    this->usedTiles = 0;
+}
+
+bool ShadowAtlasAllocator::FindExact(uint32_t level, uint32_t x, uint32_t y, uint32_t targetLevel, uint32_t& outNode) const
+{
+    const uint32_t node = NodeIndex(level, x, y);
+    const NodeState state = this->nodes[node];
+
+    if (level == targetLevel)
+    {
+        if (state != NodeState::Free)
+            return false;
+
+        outNode = node;
+        return true;
+    }
+
+    // Solo se baja por nodos ya subdivididos: asi se rellenan huecos antes de partir bloques grandes
+    if (state != NodeState::Split)
+        return false;
+
+    for (uint32_t child = 0; child < 4; ++child)
+    {
+        if (FindExact(level + 1, x * 2 + (child & 1), y * 2 + (child >> 1), targetLevel, outNode))
+            return true;
+    }
+
+    return false;
+}
+
+void ShadowAtlasAllocator::FindSmallestFree(uint32_t level, uint32_t x, uint32_t y, uint32_t targetLevel, uint32_t& bestNode, uint32_t& bestLevel) const
+{
+    if (level >= targetLevel)
+        return;
+
+    const uint32_t node = NodeIndex(level, x, y);
+    const NodeState state = this->nodes[node];
+
+    if (state == NodeState::Free)
+    {
+        if (bestNode == ShadowAtlasTile::InvalidNode || level > bestLevel)
+        {
+            bestNode = node;
+            bestLevel = level;
+        }
+        return;
+    }
+
+    if (state != NodeState::Split)
+        return;
+
+    for (uint32_t child = 0; child < 4; ++child)
+    {
+        FindSmallestFree(level + 1, x * 2 + (child & 1), y * 2 + (child >> 1), targetLevel, bestNode, bestLevel);
+    }
+}
+
+uint32_t ShadowAtlasAllocator::FindLargestFree(uint32_t level, uint32_t x, uint32_t y) const
+{
+    const NodeState state = this->nodes[NodeIndex(level, x, y)];
+
+    if (state == NodeState::Free)
+        return TileSizeAtLevel(level);
+
+    if (state == NodeState::Used || level == this->maxLevel)
+        return 0;
+
+    uint32_t result = 0;
+    for (uint32_t child = 0; child < 4; ++child)
+    {
+        result = std::max(result, FindLargestFree(level + 1, x * 2 + (child & 1), y * 2 + (child >> 1)));
+    }
+    return result;
+}
+
+uint32_t ShadowAtlasAllocator::GetLargestFreeTile() const
+{
+    if (this->nodes.empty())
+        return 0;
+
+    return FindLargestFree(0, 0, 0);
+}
+
+ShadowAtlasTile ShadowAtlasAllocator::Allocate(uint32_t size)
+{
+    ShadowAtlasTile tile{};
+    if (this->nodes.empty())
+        return tile;
+
+    const uint32_t tileSize = std::clamp(RoundToPowerOfTwo(size), this->minTileSize, this->atlasSize);
+    const uint32_t targetLevel = LevelForSize(tileSize);
+
+    uint32_t node = ShadowAtlasTile::InvalidNode;
+    if (!FindExact(0, 0, 0, targetLevel, node))
+    {
+        // No hay hueco exacto: se parte el bloque libre mas pequeno que lo contenga
+        uint32_t bestLevel = 0;
+        FindSmallestFree(0, 0, 0, targetLevel, node, bestLevel);
+
+        if (node == ShadowAtlasTile::InvalidNode)
+            return tile;
+
+        uint32_t level = 0, x = 0, y = 0;
+        DecodeNode(node, level, x, y);
+
+        while (level < targetLevel)
+        {
+            this->nodes[NodeIndex(level, x, y)] = NodeState::Split;
+
+            for (uint32_t child = 0; child < 4; ++child)
+            {
+                this->nodes[NodeIndex(level + 1, x * 2 + (child & 1), y * 2 + (child >> 1))] = NodeState::Free;
+            }
+
+            ++level;
+            x *= 2;
+            y *= 2;
+        }
+
+        node = NodeIndex(level, x, y);
+    }
+
+    uint32_t level = 0, x = 0, y = 0;
+    DecodeNode(node, level, x, y);
+
+    this->nodes[node] = NodeState::Used;
+    this->usedArea += static_cast<uint64_t>(tileSize) * tileSize;
+    this->usedTiles++;
+
+    tile.Node = node;
+    tile.Size = TileSizeAtLevel(level);
+    tile.X = x * tile.Size;
+    tile.Y = y * tile.Size;
+    return tile;
+}
+
+std::vector<uint32_t> ShadowAtlasAllocator::PlanRepackSizes(const std::vector<uint32_t>& desiredSizes) const
+{
+    const uint64_t atlasArea = static_cast<uint64_t>(this->atlasSize) * this->atlasSize;
+    const uint64_t minArea = static_cast<uint64_t>(this->minTileSize) * this->minTileSize;
+
+    // Primero un tile minimo por luz; solo se quedan sin sombra las que no caben ni asi
+    std::vector<uint32_t> sizes(desiredSizes.size(), 0);
+    uint64_t totalArea = 0;
+    for (size_t i = 0; i < desiredSizes.size() && totalArea + minArea <= atlasArea; ++i)
+    {
+        sizes[i] = this->minTileSize;
+        totalArea += minArea;
+    }
+
+    // Despues cada luz crece hacia su tamano deseado con el area restante, por importancia
+    for (size_t i = 0; i < desiredSizes.size() && sizes[i] > 0; ++i)
+    {
+        while (sizes[i] < desiredSizes[i] && sizes[i] < this->atlasSize)
+        {
+            const uint64_t growth = static_cast<uint64_t>(sizes[i]) * sizes[i] * 3;
+            if (totalArea + growth > atlasArea)
+                break;
+
+            totalArea += growth;
+            sizes[i] *= 2;
+        }
+    }
+
+    return sizes;
+}
+
+void ShadowAtlasAllocator::Free(const ShadowAtlasTile& tile)
+{
+    if (!tile.Valid() || tile.Node >= this->nodes.size() || this->nodes[tile.Node] != NodeState::Used)
+        return;
+
+    uint32_t level = 0, x = 0, y = 0;
+    DecodeNode(tile.Node, level, x, y);
+
+    this->nodes[tile.Node] = NodeState::Free;
+    this->usedArea -= static_cast<uint64_t>(TileSizeAtLevel(level)) * TileSizeAtLevel(level);
+    this->usedTiles--;
+
+    // Fusiona hacia arriba mientras los cuatro hermanos esten libres
+    while (level > 0)
+    {
+        const uint32_t parentX = x / 2;
+        const uint32_t parentY = y / 2;
+
+        bool siblingsFree = true;
+        for (uint32_t child = 0; child < 4 && siblingsFree; ++child)
+        {
+            siblingsFree = this->nodes[NodeIndex(level, parentX * 2 + (child & 1), parentY * 2 + (child >> 1))] == NodeState::Free;
+        }
+
+        if (!siblingsFree)
+            break;
+
+        --level;
+        x = parentX;
+        y = parentY;
+        this->nodes[NodeIndex(level, x, y)] = NodeState::Free;
+    }
+}
@@ -0,0 +1,86 @@
+#pragma once
+#ifndef SHADOW_ATLAS_ALLOCATOR_H
+#define SHADOW_ATLAS_ALLOCATOR_H
+
+#include <cstdint>
+#include <vector>
+
+/// Region cuadrada de un shadow atlas, en texels.
+struct ShadowAtlasTile
+{
+    static constexpr uint32_t InvalidNode = UINT32_MAX;
+
+    uint32_t X = 0;
+    uint32_t Y = 0;
+    uint32_t Size = 0;
+    uint32_t Node = InvalidNode;
+
+    bool Valid() const { return Node != InvalidNode; }
+};
+
+/// Reparto de un atlas cuadrado en tiles potencia de dos mediante un quadtree implicito.
+/// No depende de Vulkan: solo gestiona coordenadas, de modo que puede probarse en CPU.
+class ShadowAtlasAllocator
+{
+private:
+    enum class NodeState : uint8_t
+    {
+        Free,   // Libre y sin subdividir
+        Split,  // Subdividido: el estado real esta en los hijos
+        Used    // Asignado a una luz
+    };
+
+    uint32_t atlasSize = 0;
+    uint32_t minTileSize = 0;
+    uint32_t maxLevel = 0;
+    uint64_t usedArea = 0;
+    uint32_t usedTiles = 0;
+    std::vector<NodeState> nodes;
+
+private:
+    static uint32_t LevelOffset(uint32_t level);
+    uint32_t NodeIndex(uint32_t level, uint32_t x, uint32_t y) const;
+    uint32_t TileSizeAtLevel(uint32_t level) const { return this->atlasSize >> level; }
+    uint32_t LevelForSize(uint32_t size) const;
+    void DecodeNode(uint32_t node, uint32_t& level, uint32_t& x, uint32_t& y) const;
+
+    bool FindExact(uint32_t level, uint32_t x, uint32_t y, uint32_t targetLevel, uint32_t& outNode) const;
+    void FindSmallestFree(uint32_t level, uint32_t x, uint32_t y, uint32_t targetLevel, uint32_t& bestNode, uint32_t& bestLevel) const;
+    uint32_t FindLargestFree(uint32_t level, uint32_t x, uint32_t y) const;
+
+public:
+    ShadowAtlasAllocator() = default;
+    ShadowAtlasAllocator(uint32_t atlasSize, uint32_t minTileSize);
+
+    static uint32_t RoundToPowerOfTwo(uint32_t value);
+
+    /// Reserva un tile del tamano pedido (redondeado a potencia de dos dentro de [minTileSize, atlasSize]).
+    /// Devuelve un tile invalido si no cabe.
+    ShadowAtlasTile Allocate(uint32_t size);
+    void Free(const ShadowAtlasTile& tile);
+    void Reset();
+
+    /// Tamanos para reempaquetar el atlas entero. desiredSizes va por importancia descendente:
+    /// primero un tile minimo por luz mientras quepa (0 = sin sombra) y despues cada luz se dobla
+    /// hacia su tamano deseado con el area restante. Reservados de mayor a menor caben todos.
+    std::vector<uint32_t> PlanRepackSizes(const std::vector<uint32_t>& desiredSizes) const;
+
+    uint32_t GetAtlasSize() const { return this->atlasSize; }
+    uint32_t GetMinTileSize() const { return this->minTileSize; }
+    uint32_t GetMaxTileSize() const { return this->atlasSize; }
+    uint32_t GetUsedTiles() const { return this->usedTiles; }
+    uint64_t GetUsedArea() const { return this->usedArea; }
+    uint64_t GetFreeArea() const { return static_cast<uint64_t>(this->atlasSize) * this->atlasSize - this->usedArea; }
+    /// Lado del mayor tile que se podria reservar ahora mismo (0 si el atlas esta lleno).
+    uint32_t GetLargestFreeTile() const;
+};
+
+
+
+namespace QE
+{
+    using ::ShadowAtlasTile;
+    using ::ShadowAtlasAllocator;
+} // namespace QE
+// QE namespace aliases
+#endif // !SHADOW_ATLAS_ALLOCATOR_H
@@ -0,0 +1,331 @@
+#include "ShadowAtlasManager.h"
+#include <algorithm>
+#include <cmath>
+#include <LightManager.h>
+#include <QECameraContext.h>
+#include <QECamera.h>
+#include <FrustumComponent.h>
+#include <ShadowCacheManager.h>
+
+void ShadowAtlasManager::Initialize(std::shared_ptr<VkRenderPass> renderPass)
+{
+    if (!renderPass)
+        return;
+
+    if (!_spotAtlas.Resources)
+    {
+        _spotAtlas.Resources = std::make_shared<ShadowAtlasResources>(this->SpotAtlasSize, 1, renderPass);
+        _spotAtlas.Allocator = ShadowAtlasAllocator(this->SpotAtlasSize, this->MinTileSize);
+        _spotAtlas.MaxTileSize = std::min(this->SpotMaxTileSize, this->SpotAtlasSize);
+        _spotAtlas.Entries.clear();
+    }
+
+    if (!_pointAtlas.Resources)
+    {
+        _pointAtlas.Resources = std::make_shared<ShadowAtlasResources>(this->PointAtlasSize, 6, renderPass);
+        _pointAtlas.Allocator = ShadowAtlasAllocator(this->PointAtlasSize, this->MinTileSize);
+        _pointAtlas.MaxTileSize = std::min(this->PointMaxTileSize, this->PointAtlasSize);
+        _pointAtlas.Entries.clear();
+    }
+}
+
+float ShadowAtlasManager::ComputeScreenCoverage(const std::shared_ptr<QECamera>& camera, const glm::vec3& center, float radius) const
+{
+    if (!camera || !camera->CameraData)
+        return 1.0f;
+
+    const glm::vec3 cameraPosition = glm::vec3(camera->CameraData->Position);
+    const float distance = glm::length(center - cameraPosition);
+
+    // Camara dentro del volumen de la luz: ocupa toda la pantalla
+    if (distance <= radius)
+        return 1.0f;
+
+    if (camera->_frustumComponent && !camera->_frustumComponent->isSphereInside(center, radius))
+        return 0.0f;
+
+    // Radio proyectado de la esfera respecto a la mitad de la altura de pantalla
+    const float projScale = std::abs(camera->CameraData->Projection[1][1]);
+    const float projectedRadius = radius * projScale / std::sqrt(distance * distance - radius * radius);
+    return std::clamp(projectedRadius, 0.0f, 1.0f);
+}
+
+uint32_t ShadowAtlasManager::ComputeTileSize(float coverage, const AtlasState& atlas) const
+{
+    const uint32_t minSize = atlas.Allocator.GetMinTileSize();
+    const float pixels = coverage * static_cast<float>(atlas.MaxTileSize);
+
+    if (pixels <= static_cast<float>(minSize))
+        return minSize;
+
+    // Potencia de dos mas cercana en escala logaritmica
+    const uint32_t size = 1u << static_cast<uint32_t>(std::lround(std::log2(pixels)));
+    return std::clamp(size, minSize, atlas.MaxTileSize);
+}
+
+ShadowAtlasTile ShadowAtlasManager::AllocateWithFallback(AtlasState& atlas, uint32_t desiredSize)
+{
+    for (uint32_t size = desiredSize; size >= atlas.Allocator.GetMinTileSize(); size /= 2)
+    {
+        ShadowAtlasTile tile = atlas.Allocator.Allocate(size);
+        if (tile.Valid())
+            return tile;
+    }
+
+    return {};
+}
+
+void ShadowAtlasManager::Repack(AtlasState& atlas, std::vector<AtlasRequest>& requests)
+{
+    // requests ya viene ordenado por importancia descendente
+    std::vector<uint32_t> desiredSizes(requests.size());
+    for (size_t i = 0; i < requests.size(); ++i)
+        desiredSizes[i] = requests[i].DesiredSize;
+
+    const std::vector<uint32_t> sizes = atlas.Allocator.PlanRepackSizes(desiredSizes);
+
+    // En orden de tamano decreciente el quadtree empaqueta sin huecos
+    std::vector<size_t> order(requests.size());
+    for (size_t i = 0; i < order.size(); ++i) order[i] = i;
+    std::stable_sort(order.begin(), order.end(), [&sizes](size_t a, size_t b) { return sizes[a] > sizes[b]; });
+
+    atlas.Allocator.Reset();
+    for (size_t idx : order)
+    {
+        auto& entry = atlas.Entries[requests[idx].LightId];
+        entry.Tile = sizes[idx] > 0 ? atlas.Allocator.Allocate(sizes[idx]) : ShadowAtlasTile{};
+        entry.PendingSize = 0;
+        entry.PendingFrames = 0;
+    }
+
+    _stats.Repacks++;
+}
+
+void ShadowAtlasManager::UpdateAtlas(AtlasState& atlas, std::vector<AtlasRequest>& requests)
+{
+    if (!atlas.Resources)
+    {
+        for (auto& request : requests)
+        {
+            request.Assign(nullptr, {});
+        }
+        return;
+    }
+
+    std::unordered_map<std::string, ShadowAtlasTile> previousTiles;
+    previousTiles.reserve(requests.size());
+
+    for (auto& request : requests)
+    {
+        auto& entry = atlas.Entries[request.LightId];
+        if (entry.ResourcesKey != request.ResourcesKey)
+        {
+            // La luz ha recreado sus recursos: el tile anterior ya no le pertenece
+            atlas.Allocator.Free(entry.Tile);
+            entry = LightEntry{};
+            entry.ResourcesKey = request.ResourcesKey;
+            previousTiles[request.LightId] = ShadowAtlasTile{};
+        }
+        else
+        {
+            previousTiles[request.LightId] = entry.Tile;
+        }
+        entry.LastSeenFrame = _frameIndex;
+    }
+
+    for (auto it = atlas.Entries.begin(); it != atlas.Entries.end();)
+    {
+        if (it->second.LastSeenFrame != _frameIndex)
+        {
+            atlas.Allocator.Free(it->second.Tile);
+            it = atlas.Entries.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    std::stable_sort(requests.begin(), requests.end(),
+        [](const AtlasRequest& a, const AtlasRequest& b) { return a.Importance > b.Importance; });
+
+    bool missingTiles = false;
+    for (auto& request : requests)
+    {
+        auto& entry = atlas.Entries[request.LightId];
+
+        if (!entry.Tile.Valid())
+        {
+            entry.Tile = this->AllocateWithFallback(atlas, request.DesiredSize);
+            missingTiles |= !entry.Tile.Valid();
+            continue;
+        }
+
+        if (request.DesiredSize == entry.Tile.Size)
+        {
+            entry.PendingSize = 0;
+            entry.PendingFrames = 0;
+            continue;
+        }
+
+        // Histeresis: el nuevo tamano tiene que mantenerse varios frames
+        if (entry.PendingSize != request.DesiredSize)
+        {
+            entry.PendingSize = request.DesiredSize;
+            entry.PendingFrames = 0;
+        }
+
+        if (++entry.PendingFrames < this->ResizeDelayFrames)
+            continue;
+
+        entry.PendingSize = 0;
+        entry.PendingFrames = 0;
+
+        if (request.DesiredSize > entry.Tile.Size)
+        {
+            // Crecer sin soltar el tile actual: si no cabe, la luz se queda como esta
+            ShadowAtlasTile grown = atlas.Allocator.Allocate(request.DesiredSize);
+            if (grown.Valid())
+            {
+                atlas.Allocator.Free(entry.Tile);
+                entry.Tile = grown;
+            }
+        }
+        else
+        {
+            atlas.Allocator.Free(entry.Tile);
+            entry.Tile = this->AllocateWithFallback(atlas, request.DesiredSize);
+        }
+    }
+
+    // Reempaquetado completo solo si hay luces sin tile y no se ha hecho hace poco
+    if (missingTiles && _frameIndex - atlas.LastRepackFrame >= this->ResizeDelayFrames)
+    {
+        atlas.LastRepackFrame = _frameIndex;
+        this->Repack(atlas, requests);
+    }
+
+    auto* shadowCacheManager = ShadowCacheManager::getInstance();
+    for (auto& request : requests)
+    {
+        const auto& entry = atlas.Entries[request.LightId];
+        const auto& previous = previousTiles[request.LightId];
+
+        if (!entry.Tile.Valid())
+        {
+            _stats.UnshadowedLights++;
+        }
+
+        if (previous.Node == entry.Tile.Node && previous.Size == entry.Tile.Size)
+            continue;
+
+        request.Assign(entry.Tile.Valid() ? atlas.Resources : nullptr, entry.Tile);
+        shadowCacheManager->InvalidateLight(request.LightId);
+
+        if (previous.Valid())
+        {
+            _stats.Reallocations++;
+        }
+    }
+}
+
+void ShadowAtlasManager::Update(LightManager* lightManager)
+{
+    ++_frameIndex;
+    _stats = {};
+
+    if (!lightManager)
+        return;
+
+    auto camera = QECameraContext::getInstance()->ActiveCamera();
+
+    std::vector<AtlasRequest> spotRequests;
+    for (const auto& spotLight : lightManager->GetSpotLights())
+    {
+        if (!spotLight || !spotLight->shadowMappingResourcesPtr || !spotLight->transform)
+            continue;
+
+        auto resources = spotLight->shadowMappingResourcesPtr;
+        const float coverage = this->ComputeScreenCoverage(camera, spotLight->transform->GetWorldPosition(), spotLight->GetDistanceEffect());
+
+        AtlasRequest request{};
+        request.LightId = spotLight->id;
+        request.ResourcesKey = resources.get();
+        request.Importance = coverage;
+        request.DesiredSize = this->ComputeTileSize(coverage, _spotAtlas);
+        request.Assign = [resources](const std::shared_ptr<ShadowAtlasResources>& atlas, const ShadowAtlasTile& tile)
+        {
+            if (atlas) resources->SetAtlasTile(atlas, tile);
+            else resources->ClearAtlasTile();
+        };
+        spotRequests.push_back(std::move(request));
+    }
+
+    std::vector<AtlasRequest> pointRequests;
+    for (const auto& pointLight : lightManager->GetPointLights())
+    {
+        if (!pointLight || !pointLight->shadowMappingResourcesPtr || !pointLight->transform)
+            continue;
+
+        auto resources = pointLight->shadowMappingResourcesPtr;
+        const float coverage = this->ComputeScreenCoverage(camera, pointLight->transform->GetWorldPosition(), pointLight->GetDistanceEffect());
+
+        AtlasRequest request{};
+        request.LightId = pointLight->id;
+        request.ResourcesKey = resources.get();
+        request.Importance = coverage;
+        request.DesiredSize = this->ComputeTileSize(coverage, _pointAtlas);
+        request.Assign = [resources](const std::shared_ptr<ShadowAtlasResources>& atlas, const ShadowAtlasTile& tile)
+        {
+            if (atlas) resources->SetAtlasTile(atlas, tile);
+            else resources->ClearAtlasTile();
+        };
+        pointRequests.push_back(std::move(request));
+    }
+
+    this->UpdateAtlas(_spotAtlas, spotRequests);
+    this->UpdateAtlas(_pointAtlas, pointRequests);
+
+    const auto usage = [](const AtlasState& atlas)
+    {
+        const float area = static_cast<float>(atlas.Allocator.GetAtlasSize()) * static_cast<float>(atlas.Allocator.GetAtlasSize());
+        return area > 0.0f ? static_cast<float>(atlas.Allocator.GetUsedArea()) / area : 0.0f;
+    };
+
+    _stats.AtlasBytes =
+        (_spotAtlas.Resources ? _spotAtlas.Resources->GetAllocationSize() : 0) +
+        (_pointAtlas.Resources ? _pointAtlas.Resources->GetAllocationSize() : 0);
+    _stats.SpotTiles = _spotAtlas.Allocator.GetUsedTiles();
+    _stats.PointTiles = _pointAtlas.Allocator.GetUsedTiles();
+    _stats.SpotUsage = usage(_spotAtlas);
+    _stats.PointUsage = usage(_pointAtlas);
+}
+
+void ShadowAtlasManager::ResetSceneState()
+{
+    // Los atlas sobreviven al cambio de escena; solo se liberan los tiles
+    _spotAtlas.Entries.clear();
+    _spotAtlas.Allocator.Reset();
+    _spotAtlas.LastRepackFrame = 0;
+    _pointAtlas.Entries.clear();
+    _pointAtlas.Allocator.Reset();
+    _pointAtlas.LastRepackFrame = 0;
+    _stats = {};
+}
+
+void ShadowAtlasManager::Cleanup()
+{
+    this->ResetSceneState();
+
+    if (_spotAtlas.Resources)
+    {
+        _spotAtlas.Resources->Cleanup();
+        _spotAtlas.Resources = nullptr;
+    }
+
+    if (_pointAtlas.Resources)
+    {
+        _pointAtlas.Resources->Cleanup();
+        _pointAtlas.Resources = nullptr;
+    }
+}
@@ -0,0 +1,110 @@
+#pragma once
+#ifndef SHADOW_ATLAS_MANAGER_H
+#define SHADOW_ATLAS_MANAGER_H
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <glm/glm.hpp>
+#include <vulkan/vulkan.hpp>
+#include <QESingleton.h>
+#include <ShadowAtlasAllocator.h>
+#include <ShadowAtlasResources.h>
+
+class LightManager;
+class QECamera;
+
+struct ShadowAtlasFrameStats
+{
+    uint64_t AtlasBytes = 0;
+    uint32_t SpotTiles = 0;
+    uint32_t PointTiles = 0;
+    float SpotUsage = 0.0f;     // Fraccion del area del atlas asignada
+    float PointUsage = 0.0f;
+    uint32_t Reallocations = 0; // Tiles reasignados este frame
+    uint32_t Repacks = 0;
+    uint32_t UnshadowedLights = 0;
+};
+
+/// Reparte los shadow atlas de spot y point lights entre las luces de la escena.
+/// El tamano del tile de cada luz sale de la cobertura en pantalla de su esfera de influencia;
+/// los cambios de tamano se aplican con histeresis para no reasignar cada frame.
+class ShadowAtlasManager : public QESingleton<ShadowAtlasManager>
+{
+private:
+    friend class QESingleton<ShadowAtlasManager>;
+
+    struct LightEntry
+    {
+        const void* ResourcesKey = nullptr;
+        ShadowAtlasTile Tile{};
+        uint32_t PendingSize = 0;
+        uint32_t PendingFrames = 0;
+        uint64_t LastSeenFrame = 0;
+    };
+
+    struct AtlasRequest
+    {
+        std::string LightId;
+        const void* ResourcesKey = nullptr;
+        float Importance = 0.0f;
+        uint32_t DesiredSize = 0;
+        std::function<void(const std::shared_ptr<ShadowAtlasResources>&, const ShadowAtlasTile&)> Assign;
+    };
+
+    struct AtlasState
+    {
+        std::shared_ptr<ShadowAtlasResources> Resources = nullptr;
+        ShadowAtlasAllocator Allocator;
+        uint32_t MaxTileSize = 0;
+        uint64_t LastRepackFrame = 0;
+        std::unordered_map<std::string, LightEntry> Entries;
+    };
+
+    AtlasState _spotAtlas;
+    AtlasState _pointAtlas;
+    ShadowAtlasFrameStats _stats;
+    uint64_t _frameIndex = 0;
+
+public:
+    uint32_t SpotAtlasSize = 4096;
+    uint32_t SpotMaxTileSize = 2048;
+    uint32_t PointAtlasSize = 2048;   // Por capa; el atlas de point lights tiene una capa por cara
+    uint32_t PointMaxTileSize = 1024;
+    uint32_t MinTileSize = 128;
+    uint32_t ResizeDelayFrames = 15;
+
+private:
+    float ComputeScreenCoverage(const std::shared_ptr<QECamera>& camera, const glm::vec3& center, float radius) const;
+    uint32_t ComputeTileSize(float coverage, const AtlasState& atlas) const;
+    void UpdateAtlas(AtlasState& atlas, std::vector<AtlasRequest>& requests);
+    ShadowAtlasTile AllocateWithFallback(AtlasState& atlas, uint32_t desiredSize);
+    void Repack(AtlasState& atlas, std::vector<AtlasRequest>& requests);
+
+public:
+    ShadowAtlasManager() = default;
+
+    /// Crea los atlas si no existen. El render pass es el de profundidad de las sombras.
+    void Initialize(std::shared_ptr<VkRenderPass> renderPass);
+    void Update(LightManager* lightManager);
+
+    const std::shared_ptr<ShadowAtlasResources>& GetSpotAtlas() const { return _spotAtlas.Resources; }
+    const std::shared_ptr<ShadowAtlasResources>& GetPointAtlas() const { return _pointAtlas.Resources; }
+
+    void ResetSceneState();
+    void Cleanup();
+
+    const ShadowAtlasFrameStats& GetFrameStats() const { return _stats; }
+};
+
+
+
+namespace QE
+{
+    using ::ShadowAtlasFrameStats;
+    using ::ShadowAtlasManager;
+} // namespace QE
+// QE namespace aliases
+#endif // !SHADOW_ATLAS_MANAGER_H
@@ -0,0 +1,474 @@
+#include "ShadowCacheManager.h"
+#include <algorithm>
+#include <LightManager.h>
+#include <GameObjectManager.h>
+#include <FrustumComponent.h>
+#include <ShadowCasterCulling.h>
+#include <QEAnimationComponent.h>
+#include <QETransform.h>
+
+void ShadowCacheManager::Update(LightManager* lightManager)
+{
+    ++_frameIndex;
+
+    _stats = {};
+
+    if (!lightManager)
+        return;
+
+    const auto& dirLights = lightManager->GetDirectionalLights();
+    const auto& pointLights = lightManager->GetPointLights();
+    const auto& spotLights = lightManager->GetSpotLights();
+
+    if (!this->Enabled)
+    {
+        if (!_lights.empty() || !_casters.empty())
+        {
+            this->ResetSceneState();
+        }
+
+        _stats.TotalViews = static_cast<uint32_t>(
+            dirLights.size() * SHADOW_MAP_CASCADE_COUNT + pointLights.size() * 6 + spotLights.size());
+        _stats.RenderedViews = _stats.TotalViews;
+        return;
+    }
+
+    std::array<ShadowViewAction, SHADOW_MAP_CASCADE_COUNT> fullCascades;
+    fullCascades.fill(ShadowViewAction::RenderFull);
+    std::array<ShadowViewAction, 6> fullFaces;
+    fullFaces.fill(ShadowViewAction::RenderFull);
+
+    _dirActions.assign(dirLights.size(), fullCascades);
+    _pointActions.assign(pointLights.size(), fullFaces);
+    _spotActions.assign(spotLights.size(), ShadowViewAction::RenderFull);
+
+    this->UpdateCasters();
+    _softRequests.clear();
+
+    // Fase 1: evaluar cada vista y resolver las que no pueden esperar
+    for (const auto& dirLight : dirLights)
+    {
+        if (!dirLight || !dirLight->shadowMappingResourcesPtr || !dirLight->shadowMappingResourcesPtr->CascadeResourcesPtr)
+            continue;
+
+        auto& lightState = this->AcquireLightState(dirLight->id, dirLight->shadowMappingResourcesPtr.get(), glm::vec4(0.0f), SHADOW_MAP_CASCADE_COUNT);
+        const auto& cascades = *dirLight->shadowMappingResourcesPtr->CascadeResourcesPtr;
+
+        for (uint32_t cascadeIdx = 0; cascadeIdx < SHADOW_MAP_CASCADE_COUNT; ++cascadeIdx)
+        {
+            this->EvaluateView(lightState.Views[cascadeIdx], cascades[cascadeIdx].viewProjMatrix, cascadeIdx < this->AlwaysUpdatedCascades);
+        }
+    }
+
+    for (const auto& pointLight : pointLights)
+    {
+        if (!pointLight || !pointLight->shadowMappingResourcesPtr || !pointLight->transform)
+            continue;
+
+        const glm::vec3 lightPosition = pointLight->transform->GetWorldPosition();
+        const float lightRadius = pointLight->GetDistanceEffect();
+        auto& lightState = this->AcquireLightState(pointLight->id, pointLight->shadowMappingResourcesPtr.get(), glm::vec4(lightPosition, lightRadius), 6);
+
+        for (uint32_t faceIdx = 0; faceIdx < 6; ++faceIdx)
+        {
+            this->EvaluateView(lightState.Views[faceIdx], ShadowCasterCulling::ComputePointFaceViewProj(lightPosition, lightRadius, faceIdx), true);
+        }
+    }
+
+    for (const auto& spotLight : spotLights)
+    {
+        if (!spotLight || !spotLight->shadowMappingResourcesPtr)
+            continue;
+
+        auto& lightState = this->AcquireLightState(spotLight->id, spotLight->shadowMappingResourcesPtr.get(), glm::vec4(0.0f), 1);
+        this->EvaluateView(lightState.Views[0], spotLight->shadowMappingResourcesPtr->ViewProjMatrix, true);
+    }
+
+    // Fase 2: repartir las actualizaciones blandas segun presupuesto
+    this->ResolveSoftRequests();
+
+    // Fase 3: publicar acciones por indice de luz
+    for (uint32_t i = 0; i < dirLights.size(); ++i)
+    {
+        const auto& dirLight = dirLights[i];
+        if (!dirLight || !dirLight->shadowMappingResourcesPtr || !dirLight->shadowMappingResourcesPtr->CascadeResourcesPtr)
+            continue;
+
+        auto& lightState = _lights[dirLight->id];
+        auto& cascades = *dirLight->shadowMappingResourcesPtr->CascadeResourcesPtr;
+        bool restoredMatrix = false;
+
+        for (uint32_t cascadeIdx = 0; cascadeIdx < SHADOW_MAP_CASCADE_COUNT; ++cascadeIdx)
+        {
+            const auto& view = lightState.Views[cascadeIdx];
+            _dirActions[i][cascadeIdx] = view.Action;
+
+            // Una cascada diferida debe muestrearse con la matriz con la que se genero
+            if (view.Action == ShadowViewAction::Skip && cascades[cascadeIdx].viewProjMatrix != view.ViewProj)
+            {
+                cascades[cascadeIdx].viewProjMatrix = view.ViewProj;
+                restoredMatrix = true;
+            }
+        }
+
+        if (restoredMatrix)
+        {
+            dirLight->shadowMappingResourcesPtr->UpdateOffscreenUBOShadowMap();
+        }
+
+        _stats.StaticCacheBytes += dirLight->shadowMappingResourcesPtr->GetStaticLayerCacheSize();
+    }
+
+    for (uint32_t i = 0; i < pointLights.size(); ++i)
+    {
+        const auto& pointLight = pointLights[i];
+        if (!pointLight || !pointLight->shadowMappingResourcesPtr || !pointLight->transform)
+            continue;
+
+        const auto& lightState = _lights[pointLight->id];
+        for (uint32_t faceIdx = 0; faceIdx < 6; ++faceIdx)
+        {
+            _pointActions[i][faceIdx] = lightState.Views[faceIdx].Action;
+        }
+
+        _stats.StaticCacheBytes += pointLight->shadowMappingResourcesPtr->GetStaticLayerCacheSize();
+    }
+
+    for (uint32_t i = 0; i < spotLights.size(); ++i)
+    {
+        const auto& spotLight = spotLights[i];
+        if (!spotLight || !spotLight->shadowMappingResourcesPtr)
+            continue;
+
+        _spotActions[i] = _lights[spotLight->id].Views[0].Action;
+        _stats.StaticCacheBytes += spotLight->shadowMappingResourcesPtr->GetStaticLayerCacheSize();
+    }
+
+    // Luces que ya no existen
+    for (auto it = _lights.begin(); it != _lights.end();)
+    {
+        if (it->second.LastSeenFrame != _frameIndex)
+            it = _lights.erase(it);
+        else
+            ++it;
+    }
+}
+
+void ShadowCacheManager::UpdateCasters()
+{
+    _frameChanges.clear();
+
+    const auto& shadowItems = GameObjectManager::getInstance()->GetShadowRenderItems();
+
+    for (const auto& item : shadowItems)
+    {
+        const auto& go = item.GameObject;
+        if (!go)
+            continue;
+
+        const std::string gameObjectId = go->ID();
+        auto it = _casters.find(gameObjectId);
+        const bool isNew = (it == _casters.end());
+
+        // Un mismo GameObject aparece una vez por submesh
+        if (!isNew && it->second.LastSeenFrame == _frameIndex)
+            continue;
+
+        auto transform = go->GetComponent<QETransform>();
+        if (!transform)
+            continue;
+
+        glm::vec3 center;
+        float radius;
+        if (!ShadowCasterCulling::ComputeCasterSphere(go, center, radius))
+            continue;
+
+        const bool animated = go->GetComponent<QEAnimationComponent>() != nullptr;
+
+        const uint32_t worldVersion = transform->GetWorldVersion();
+
+        if (isNew)
+        {
+            CasterState state;
+            state.WorldVersion = worldVersion;
+            state.Dynamic = animated;
+            state.Animated = animated;
+            state.Center = center;
+            state.Radius = radius;
+            state.LastSeenFrame = _frameIndex;
+            _casters.emplace(gameObjectId, state);
+
+            _frameChanges.push_back({ center, radius, !animated });
+            continue;
+        }
+
+        CasterState& state = it->second;
+        const bool moved = animated || state.WorldVersion != worldVersion;
+
+        if (moved)
+        {
+            // La posicion anterior deja de contener al caster: si era estatico, la capa cacheada queda obsoleta
+            _frameChanges.push_back({ state.Center, state.Radius, !state.Dynamic });
+            _frameChanges.push_back({ center, radius, false });
+
+            state.Dynamic = true;
+            state.StillFrames = 0;
+        }
+        else
+        {
+            ++state.StillFrames;
+
+            if (state.Dynamic && !state.Animated && state.StillFrames >= this->StaticPromotionFrames)
+            {
+                state.Dynamic = false;
+                _frameChanges.push_back({ center, radius, true });
+            }
+        }
+
+        state.WorldVersion = worldVersion;
+        state.Animated = animated;
+        state.Center = center;
+        state.Radius = radius;
+        state.LastSeenFrame = _frameIndex;
+    }
+
+    for (auto it = _casters.begin(); it != _casters.end();)
+    {
+        if (it->second.LastSeenFrame != _frameIndex)
+        {
+            _frameChanges.push_back({ it->second.Center, it->second.Radius, !it->second.Dynamic });
+            it = _casters.erase(it);
+            continue;
+        }
+
+        if (it->second.Dynamic)
+            ++_stats.DynamicCasters;
+        else
+            ++_stats.StaticCasters;
+
+        ++it;
+    }
+}
+
+ShadowCacheManager::LightCacheState& ShadowCacheManager::AcquireLightState(const std::string& lightId, const void* resourcesKey, const glm::vec4& lightKey, uint32_t viewCount)
+{
+    auto& lightState = _lights[lightId];
+
+    // Recursos nuevos o cambio de posicion/radio: el contenido de todas las vistas es invalido
+    if (lightState.ResourcesKey != resourcesKey || lightState.LightKey != lightKey || lightState.Views.size() != viewCount)
+    {
+        lightState.ResourcesKey = resourcesKey;
+        lightState.LightKey = lightKey;
+        lightState.Views.assign(viewCount, ViewState{});
+    }
+
+    lightState.LastSeenFrame = _frameIndex;
+    return lightState;
+}
+
+void ShadowCacheManager::EvaluateView(ViewState& view, const glm::mat4& viewProj, bool matrixChangeIsHard)
+{
+    ++_stats.TotalViews;
+
+    FrustumComponent frustum;
+    frustum.RecreateFrustum(viewProj);
+
+    auto markDirty = [&]()
+        {
+            if (!view.Dirty)
+            {
+                view.Dirty = true;
+                view.DirtySinceFrame = _frameIndex;
+            }
+        };
+
+    bool hard = !view.ContentValid;
+
+    if (view.ContentValid && view.ViewProj != viewProj)
+    {
+        view.StaticValid = false;
+        if (matrixChangeIsHard)
+            hard = true;
+        else
+            markDirty();
+    }
+
+    for (const auto& change : _frameChanges)
+    {
+        if (!frustum.isSphereInside(change.Center, change.Radius))
+            continue;
+
+        markDirty();
+        if (change.AffectsStatic)
+        {
+            view.StaticValid = false;
+        }
+    }
+
+    view.HasDynamicCasters = false;
+    for (const auto& caster : _casters)
+    {
+        if (caster.second.Dynamic && frustum.isSphereInside(caster.second.Center, caster.second.Radius))
+        {
+            view.HasDynamicCasters = true;
+            break;
+        }
+    }
+
+    if (hard)
+    {
+        this->ResolveAction(view, viewProj);
+    }
+    else if (view.Dirty)
+    {
+        _softRequests.push_back({ &view, viewProj, false });
+    }
+    else
+    {
+        view.Action = ShadowViewAction::Skip;
+        ++_stats.SkippedViews;
+    }
+}
+
+void ShadowCacheManager::ResolveSoftRequests()
+{
+    // Round-robin: primero las vistas que llevan mas tiempo sin actualizarse
+    std::stable_sort(_softRequests.begin(), _softRequests.end(),
+        [](const ViewRequest& a, const ViewRequest& b)
+        {
+            return a.View->LastRenderedFrame < b.View->LastRenderedFrame;
+        });
+
+    uint32_t budget = this->MaxSoftViewUpdatesPerFrame;
+
+    for (auto& request : _softRequests)
+    {
+        const bool overdue = (_frameIndex - request.View->DirtySinceFrame) >= this->MaxDeferredFrames;
+
+        if (budget > 0 || overdue)
+        {
+            if (budget > 0)
+                --budget;
+
+            this->ResolveAction(*request.View, request.ViewProj);
+        }
+        else
+        {
+            request.View->Action = ShadowViewAction::Skip;
+            ++_stats.DeferredViews;
+        }
+    }
+
+    _softRequests.clear();
+}
+
+void ShadowCacheManager::ResolveAction(ViewState& view, const glm::mat4& viewProj)
+{
+    if (this->StaticLayerEnabled && view.StaticValid)
+    {
+        view.Action = ShadowViewAction::CompositeDynamic;
+    }
+    else if (this->StaticLayerEnabled && view.HasDynamicCasters)
+    {
+        view.Action = ShadowViewAction::RebuildStatic;
+        view.StaticValid = true;
+        ++_stats.StaticLayerRebuilds;
+    }
+    else
+    {
+        view.Action = ShadowViewAction::RenderFull;
+        view.StaticValid = false;
+    }
+
+    view.ViewProj = viewProj;
+    view.ContentValid = true;
+    view.Dirty = false;
+    view.LastRenderedFrame = _frameIndex;
+    ++_stats.RenderedViews;
+}
+
+ShadowViewAction ShadowCacheManager::GetDirectionalAction(uint32_t lightIdx, uint32_t cascadeIdx) const
+{
+    if (!this->Enabled || lightIdx >= _dirActions.size() || cascadeIdx >= SHADOW_MAP_CASCADE_COUNT)
+        return ShadowViewAction::RenderFull;
+
+    return _dirActions[lightIdx][cascadeIdx];
+}
+
+ShadowViewAction ShadowCacheManager::GetPointAction(uint32_t lightIdx, uint32_t faceIdx) const
+{
+    if (!this->Enabled || lightIdx >= _pointActions.size() || faceIdx >= 6)
+        return ShadowViewAction::RenderFull;
+
+    return _pointActions[lightIdx][faceIdx];
+}
+
+ShadowViewAction ShadowCacheManager::GetSpotAction(uint32_t lightIdx) const
+{
+    if (!this->Enabled || lightIdx >= _spotActions.size())
+        return ShadowViewAction::RenderFull;
+
+    return _spotActions[lightIdx];
+}
+
+bool ShadowCacheManager::IsDynamicCaster(const std::string& gameObjectId) const
+{
+    auto it = _casters.find(gameObjectId);
+    if (it == _casters.end())
+        return false;
+
+    return it->second.Dynamic;
+}
+
+bool ShadowCacheManager::ShouldDrawCaster(const std::string& gameObjectId, ShadowCasterLayer layer) const
+{
+    switch (layer)
+    {
+    case ShadowCasterLayer::Static:
+        return !this->IsDynamicCaster(gameObjectId);
+    case ShadowCasterLayer::Dynamic:
+        return this->IsDynamicCaster(gameObjectId);
+    default:
+    case ShadowCasterLayer::All:
+        return true;
+    }
+}
+
+void ShadowCacheManager::InvalidateAll()
+{
+    for (auto& lightState : _lights)
+    {
+        for (auto& view : lightState.second.Views)
+        {
+            view = ViewState{};
+        }
+    }
+
+    // Hasta el proximo Update las acciones publicadas pueden no corresponder a los indices actuales
+    for (auto& actions : _dirActions) actions.fill(ShadowViewAction::RenderFull);
+    for (auto& actions : _pointActions) actions.fill(ShadowViewAction::RenderFull);
+    std::fill(_spotActions.begin(), _spotActions.end(), ShadowViewAction::RenderFull);
+}
+
+void ShadowCacheManager::InvalidateLight(const std::string& lightId)
+{
+    auto it = _lights.find(lightId);
+    if (it == _lights.end())
+        return;
+
+    for (auto& view : it->second.Views)
+    {
+        view = ViewState{};
+    }
+}
+
+void ShadowCacheManager::ResetSceneState()
+{
+    _casters.clear();
+    _lights.clear();
+    _frameChanges.clear();
+    _softRequests.clear();
+    _dirActions.clear();
+    _pointActions.clear();
+    _spotActions.clear();
+}
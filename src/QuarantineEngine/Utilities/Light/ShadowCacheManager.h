@@ -0,0 +1,155 @@
+#pragma once
+#ifndef SHADOW_CACHE_MANAGER_H
+#define SHADOW_CACHE_MANAGER_H
+
+#include <array>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <glm/glm.hpp>
+#include <QESingleton.h>
+#include <CSMResources.h>
+
+class LightManager;
+
+/// Subconjunto de casters que se dibuja en un pase de sombras.
+enum class ShadowCasterLayer
+{
+    All,
+    Static,
+    Dynamic
+};
+
+/// Trabajo a realizar este frame sobre una vista de sombra (cascada, cara de cubemap o spot).
+enum class ShadowViewAction
+{
+    Skip,               // El contenido del frame anterior sigue siendo valido (o se difiere por presupuesto)
+    RenderFull,         // Clear + todos los casters
+    RebuildStatic,      // Clear + estaticos, copia a cache, LOAD + dinamicos
+    CompositeDynamic    // Restaurar cache estatica, LOAD + dinamicos
+};
+
+struct ShadowCacheFrameStats
+{
+    uint32_t TotalViews = 0;
+    uint32_t RenderedViews = 0;
+    uint32_t SkippedViews = 0;
+    uint32_t DeferredViews = 0;
+    uint32_t StaticLayerRebuilds = 0;
+    uint32_t StaticCasters = 0;
+    uint32_t DynamicCasters = 0;
+    uint64_t StaticCacheBytes = 0;
+};
+
+/// Decide, por vista de sombra, si hay que volver a renderizarla y como.
+/// Los casters que no se mueven se promocionan a una capa estatica cacheada en GPU;
+/// las vistas solo se actualizan cuando algo relevante cambia y las actualizaciones
+/// "blandas" se reparten entre frames con un presupuesto fijo.
+class ShadowCacheManager : public QESingleton<ShadowCacheManager>
+{
+private:
+    friend class QESingleton<ShadowCacheManager>;
+
+    struct CasterState
+    {
+        uint32_t WorldVersion = 0;
+        uint32_t StillFrames = 0;
+        bool Dynamic = false;
+        bool Animated = false;
+        glm::vec3 Center = glm::vec3(0.0f);
+        float Radius = 0.0f;
+        uint64_t LastSeenFrame = 0;
+    };
+
+    struct ChangeSphere
+    {
+        glm::vec3 Center = glm::vec3(0.0f);
+        float Radius = 0.0f;
+        bool AffectsStatic = false;
+    };
+
+    struct ViewState
+    {
+        glm::mat4 ViewProj = glm::mat4(1.0f);   // Matriz con la que se genero el contenido actual
+        bool ContentValid = false;
+        bool StaticValid = false;
+        bool Dirty = true;
+        bool HasDynamicCasters = false;
+        uint64_t DirtySinceFrame = 0;
+        uint64_t LastRenderedFrame = 0;
+        ShadowViewAction Action = ShadowViewAction::RenderFull;
+    };
+
+    struct LightCacheState
+    {
+        const void* ResourcesKey = nullptr;
+        glm::vec4 LightKey = glm::vec4(0.0f);
+        std::vector<ViewState> Views;
+        uint64_t LastSeenFrame = 0;
+    };
+
+    struct ViewRequest
+    {
+        ViewState* View = nullptr;
+        glm::mat4 ViewProj = glm::mat4(1.0f);
+        bool Hard = false;
+    };
+
+    std::unordered_map<std::string, CasterState> _casters;
+    std::unordered_map<std::string, LightCacheState> _lights;
+    std::vector<ChangeSphere> _frameChanges;
+    std::vector<ViewRequest> _softRequests;
+
+    std::vector<std::array<ShadowViewAction, SHADOW_MAP_CASCADE_COUNT>> _dirActions;
+    std::vector<std::array<ShadowViewAction, 6>> _pointActions;
+    std::vector<ShadowViewAction> _spotActions;
+
+    ShadowCacheFrameStats _stats;
+    uint64_t _frameIndex = 0;
+
+public:
+    bool Enabled = true;
+    bool StaticLayerEnabled = true;
+    uint32_t MaxSoftViewUpdatesPerFrame = 8;
+    uint32_t AlwaysUpdatedCascades = 2;
+    uint32_t StaticPromotionFrames = 30;
+    uint32_t MaxDeferredFrames = 8;
+
+private:
+    void UpdateCasters();
+    LightCacheState& AcquireLightState(const std::string& lightId, const void* resourcesKey, const glm::vec4& lightKey, uint32_t viewCount);
+    void EvaluateView(ViewState& view, const glm::mat4& viewProj, bool matrixChangeIsHard);
+    void ResolveSoftRequests();
+    void ResolveAction(ViewState& view, const glm::mat4& viewProj);
+
+public:
+    ShadowCacheManager() = default;
+
+    void Update(LightManager* lightManager);
+
+    ShadowViewAction GetDirectionalAction(uint32_t lightIdx, uint32_t cascadeIdx) const;
+    ShadowViewAction GetPointAction(uint32_t lightIdx, uint32_t faceIdx) const;
+    ShadowViewAction GetSpotAction(uint32_t lightIdx) const;
+
+    bool IsDynamicCaster(const std::string& gameObjectId) const;
+    bool ShouldDrawCaster(const std::string& gameObjectId, ShadowCasterLayer layer) const;
+
+    void InvalidateAll();
+    /// Fuerza un render completo de todas las vistas de una luz (p.ej. al moverla de tile en el atlas).
+    void InvalidateLight(const std::string& lightId);
+    void ResetSceneState();
+
+    const ShadowCacheFrameStats& GetFrameStats() const { return _stats; }
+};
+
+
+
+namespace QE
+{
+    using ::ShadowCasterLayer;
+    using ::ShadowViewAction;
+    using ::ShadowCacheFrameStats;
+    using ::ShadowCacheManager;
+} // namespace QE
+// QE namespace aliases
+#endif // !SHADOW_CACHE_MANAGER_H
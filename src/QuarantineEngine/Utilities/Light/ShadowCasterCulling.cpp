@@ -0,0 +1,346 @@
+#include "ShadowCasterCulling.h"
+#include <algorithm>
+#include <functional>
+#include <future>
+#include <numbers>
+#include <thread>
+#include <glm/gtc/matrix_transform.hpp>
+#include <LightManager.h>
+#include <GameObjectManager.h>
+#include <FrustumComponent.h>
+#include <OmniShadowResources.h>
+#include <QEGeometryComponent.h>
+#include <QEAnimationComponent.h>
+#include <QETransform.h>
+
+namespace
+{
+    // El AABB del bind pose no acota la pose animada; se agranda la esfera para no perder casters.
+    constexpr float ANIMATED_BOUNDS_SCALE = 1.5f;
+
+    void RunJobs(std::vector<std::function<void()>>& jobs, bool parallel)
+    {
+        const uint32_t workerCount = std::min<uint32_t>(
+            static_cast<uint32_t>(jobs.size()),
+            std::max(1u, std::thread::hardware_concurrency()));
+
+        if (!parallel || workerCount <= 1)
+        {
+            for (auto& job : jobs)
+            {
+                job();
+            }
+            return;
+        }
+
+        // Cada trabajo escribe solo en sus propias listas: no hace falta sincronizar nada mas
+        std::vector<std::future<void>> workers;
+        workers.reserve(workerCount);
+
+        for (uint32_t worker = 0; worker < workerCount; ++worker)
+        {
+            workers.push_back(std::async(std::launch::async, [&jobs, worker, workerCount]()
+                {
+                    for (size_t i = worker; i < jobs.size(); i += workerCount)
+                    {
+                        jobs[i]();
+                    }
+                }));
+        }
+
+        for (auto& worker : workers)
+        {
+            worker.get();
+        }
+    }
+}
+
+bool ShadowCasterCulling::ComputeCasterSphere(const std::shared_ptr<QEGameObject>& go, glm::vec3& center, float& radius)
+{
+    if (!go)
+        return false;
+
+    auto transform = go->GetComponent<QETransform>();
+    if (!transform)
+        return false;
+
+    const glm::mat4& world = transform->GetWorldMatrix();
+
+    glm::vec3 localMin(-0.5f);
+    glm::vec3 localMax(0.5f);
+    if (auto geometry = go->GetComponent<QEGeometryComponent>())
+    {
+        if (auto mesh = geometry->GetMesh())
+        {
+            localMin = mesh->BoundingBox.first;
+            localMax = mesh->BoundingBox.second;
+        }
+    }
+
+    const float scale = std::max({
+        glm::length(glm::vec3(world[0])),
+        glm::length(glm::vec3(world[1])),
+        glm::length(glm::vec3(world[2])) });
+
+    center = glm::vec3(world * glm::vec4((localMin + localMax) * 0.5f, 1.0f));
+    radius = glm::length((localMax - localMin) * 0.5f) * scale;
+
+    if (go->GetComponent<QEAnimationComponent>() != nullptr)
+    {
+        radius *= ANIMATED_BOUNDS_SCALE;
+    }
+
+    return true;
+}
+
+glm::mat4 ShadowCasterCulling::ComputePointFaceViewProj(const glm::vec3& lightPosition, float lightRadius, uint32_t faceIdx)
+{
+    const glm::mat4 projection = glm::perspective((float)(std::numbers::pi * 0.5), 1.0f, 0.01f, lightRadius);
+    return projection * OmniShadowResources::GetCubeFaceViewMatrix(faceIdx) * glm::translate(glm::mat4(1.0f), -lightPosition);
+}
+
+void ShadowCasterCulling::UpdateBounds()
+{
+    const auto& shadowItems = GameObjectManager::getInstance()->GetShadowRenderItems();
+
+    _bounds.assign(shadowItems.size(), CasterBounds{});
+    _allCasters.resize(shadowItems.size());
+    _allCasterMasks.resize(shadowItems.size());
+
+    for (uint32_t i = 0; i < shadowItems.size(); ++i)
+    {
+        _allCasters[i] = i;
+        _allCasterMasks[i] = { i, 0x3Fu };
+
+        // Un mismo GameObject aparece una vez por submesh: se reutiliza la esfera del anterior
+        const auto& go = shadowItems[i].GameObject;
+        if (i > 0 && go && shadowItems[i - 1].GameObject == go)
+        {
+            _bounds[i] = _bounds[i - 1];
+            continue;
+        }
+
+        CasterBounds& bounds = _bounds[i];
+        bounds.Valid = ComputeCasterSphere(go, bounds.Center, bounds.Radius);
+    }
+}
+
+void ShadowCasterCulling::CullSphere(const glm::vec3& center, float radius, std::vector<uint32_t>& output) const
+{
+    output.clear();
+
+    for (uint32_t i = 0; i < _bounds.size(); ++i)
+    {
+        const CasterBounds& bounds = _bounds[i];
+        if (!bounds.Valid)
+            continue;
+
+        const glm::vec3 delta = bounds.Center - center;
+        const float maxDistance = radius + bounds.Radius;
+        if (glm::dot(delta, delta) <= maxDistance * maxDistance)
+        {
+            output.push_back(i);
+        }
+    }
+}
+
+void ShadowCasterCulling::CullView(const glm::mat4& viewProj, const std::vector<uint32_t>& candidates, std::vector<uint32_t>& output) const
+{
+    FrustumComponent frustum;
+    frustum.RecreateFrustum(viewProj);
+
+    output.clear();
+
+    for (uint32_t casterIdx : candidates)
+    {
+        const CasterBounds& bounds = _bounds[casterIdx];
+        if (bounds.Valid && frustum.isSphereInside(bounds.Center, bounds.Radius))
+        {
+            output.push_back(casterIdx);
+        }
+    }
+}
+
+void ShadowCasterCulling::Update(LightManager* lightManager)
+{
+    _stats = {};
+
+    if (!lightManager)
+        return;
+
+    this->UpdateBounds();
+
+    const auto& dirLights = lightManager->GetDirectionalLights();
+    const auto& pointLights = lightManager->GetPointLights();
+    const auto& spotLights = lightManager->GetSpotLights();
+
+    _dirCasters.resize(dirLights.size());
+    _pointCasters.resize(pointLights.size());
+    _pointCasterMasks.resize(pointLights.size());
+    _spotCasters.resize(spotLights.size());
+
+    const uint32_t casterCount = static_cast<uint32_t>(_bounds.size());
+    const uint32_t viewCount = static_cast<uint32_t>(
+        dirLights.size() * SHADOW_MAP_CASCADE_COUNT + pointLights.size() * 6 + spotLights.size());
+
+    _stats.Views = viewCount;
+
+    if (!this->Enabled)
+    {
+        _stats.VisibleCasters = viewCount * casterCount;
+        return;
+    }
+
+    std::vector<std::function<void()>> jobs;
+    jobs.reserve(dirLights.size() + pointLights.size() + spotLights.size());
+
+    for (uint32_t i = 0; i < dirLights.size(); ++i)
+    {
+        for (auto& list : _dirCasters[i])
+        {
+            list = _allCasters;
+        }
+
+        const auto& dirLight = dirLights[i];
+        if (!dirLight || !dirLight->shadowMappingResourcesPtr || !dirLight->shadowMappingResourcesPtr->CascadeResourcesPtr)
+            continue;
+
+        jobs.push_back([this, i, cascades = dirLight->shadowMappingResourcesPtr->CascadeResourcesPtr]()
+            {
+                for (uint32_t cascadeIdx = 0; cascadeIdx < SHADOW_MAP_CASCADE_COUNT; ++cascadeIdx)
+                {
+                    this->CullView(cascades->at(cascadeIdx).viewProjMatrix, _allCasters, _dirCasters[i][cascadeIdx]);
+                }
+            });
+    }
+
+    for (uint32_t i = 0; i < pointLights.size(); ++i)
+    {
+        for (auto& list : _pointCasters[i])
+        {
+            list = _allCasters;
+        }
+        _pointCasterMasks[i] = _allCasterMasks;
+
+        const auto& pointLight = pointLights[i];
+        if (!pointLight || !pointLight->transform)
+            continue;
+
+        const glm::vec3 lightPosition = pointLight->transform->GetWorldPosition();
+        const float lightRadius = pointLight->GetDistanceEffect();
+
+        jobs.push_back([this, i, lightPosition, lightRadius]()
+            {
+                std::vector<uint32_t> candidates;
+                this->CullSphere(lightPosition, lightRadius, candidates);
+
+                for (uint32_t faceIdx = 0; faceIdx < 6; ++faceIdx)
+                {
+                    this->CullView(ComputePointFaceViewProj(lightPosition, lightRadius, faceIdx), candidates, _pointCasters[i][faceIdx]);
+                }
+
+                // Las listas por cara salen ordenadas por caster: se fusionan en una mascara por caster
+                auto& masks = _pointCasterMasks[i];
+                masks.clear();
+                std::array<size_t, 6> cursor{};
+                for (uint32_t casterIdx : candidates)
+                {
+                    uint32_t faceMask = 0;
+                    for (uint32_t faceIdx = 0; faceIdx < 6; ++faceIdx)
+                    {
+                        const auto& faceList = _pointCasters[i][faceIdx];
+                        if (cursor[faceIdx] < faceList.size() && faceList[cursor[faceIdx]] == casterIdx)
+                        {
+                            faceMask |= 1u << faceIdx;
+                            ++cursor[faceIdx];
+                        }
+                    }
+
+                    if (faceMask != 0)
+                    {
+                        masks.push_back({ casterIdx, faceMask });
+                    }
+                }
+            });
+    }
+
+    for (uint32_t i = 0; i < spotLights.size(); ++i)
+    {
+        _spotCasters[i] = _allCasters;
+
+        const auto& spotLight = spotLights[i];
+        if (!spotLight || !spotLight->shadowMappingResourcesPtr)
+            continue;
+
+        jobs.push_back([this, i, viewProj = spotLight->shadowMappingResourcesPtr->ViewProjMatrix]()
+            {
+                this->CullView(viewProj, _allCasters, _spotCasters[i]);
+            });
+    }
+
+    const uint64_t estimatedTests = static_cast<uint64_t>(viewCount) * casterCount;
+    RunJobs(jobs, estimatedTests >= this->MinParallelTests);
+
+    auto accumulate = [this, casterCount](const std::vector<uint32_t>& list)
+        {
+            _stats.VisibleCasters += static_cast<uint32_t>(list.size());
+            _stats.CulledCasters += casterCount - static_cast<uint32_t>(list.size());
+        };
+
+    for (const auto& lists : _dirCasters)
+        for (const auto& list : lists)
+            accumulate(list);
+
+    for (const auto& lists : _pointCasters)
+        for (const auto& list : lists)
+            accumulate(list);
+
+    for (const auto& list : _spotCasters)
+        accumulate(list);
+
+    _stats.CasterTests = static_cast<uint32_t>(estimatedTests);
+}
+
+const std::vector<uint32_t>& ShadowCasterCulling::GetDirectionalCasters(uint32_t lightIdx, uint32_t cascadeIdx) const
+{
+    if (!this->Enabled || lightIdx >= _dirCasters.size() || cascadeIdx >= SHADOW_MAP_CASCADE_COUNT)
+        return _allCasters;
+
+    return _dirCasters[lightIdx][cascadeIdx];
+}
+
+const std::vector<uint32_t>& ShadowCasterCulling::GetPointCasters(uint32_t lightIdx, uint32_t faceIdx) const
+{
+    if (!this->Enabled || lightIdx >= _pointCasters.size() || faceIdx >= 6)
+        return _allCasters;
+
+    return _pointCasters[lightIdx][faceIdx];
+}
+
+const std::vector<uint32_t>& ShadowCasterCulling::GetSpotCasters(uint32_t lightIdx) const
+{
+    if (!this->Enabled || lightIdx >= _spotCasters.size())
+        return _allCasters;
+
+    return _spotCasters[lightIdx];
+}
+
+const std::vector<ShadowCasterFaceMask>& ShadowCasterCulling::GetPointCasterMasks(uint32_t lightIdx) const
+{
+    if (!this->Enabled || lightIdx >= _pointCasterMasks.size())
+        return _allCasterMasks;
+
+    return _pointCasterMasks[lightIdx];
+}
+
+void ShadowCasterCulling::ResetSceneState()
+{
+    _bounds.clear();
+    _allCasters.clear();
+    _allCasterMasks.clear();
+    _pointCasterMasks.clear();
+    _dirCasters.clear();
+    _pointCasters.clear();
+    _spotCasters.clear();
+    _stats = {};
+}
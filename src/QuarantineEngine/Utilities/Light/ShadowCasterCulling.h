@@ -0,0 +1,96 @@
+#pragma once
+#ifndef SHADOW_CASTER_CULLING_H
+#define SHADOW_CASTER_CULLING_H
+
+#include <array>
+#include <memory>
+#include <vector>
+#include <glm/glm.hpp>
+#include <QESingleton.h>
+#include <CSMResources.h>
+
+class LightManager;
+class QEGameObject;
+
+struct ShadowCullingFrameStats
+{
+    uint32_t Views = 0;
+    uint32_t CasterTests = 0;
+    uint32_t VisibleCasters = 0;    // Suma sobre todas las vistas
+    uint32_t CulledCasters = 0;
+};
+
+/// Caster de una point light con las caras del cubo (bit = cara) en las que es visible.
+struct ShadowCasterFaceMask
+{
+    uint32_t Caster = 0;
+    uint32_t FaceMask = 0;
+};
+
+/// Listas de casters visibles por vista de sombra (cascada, cara de cubemap o spot).
+/// Los indices apuntan a GameObjectManager::GetShadowRenderItems() del frame actual.
+/// Point lights: primero esfera de la luz contra esfera del caster, despues el frustum de cada cara.
+class ShadowCasterCulling : public QESingleton<ShadowCasterCulling>
+{
+private:
+    friend class QESingleton<ShadowCasterCulling>;
+
+    struct CasterBounds
+    {
+        glm::vec3 Center = glm::vec3(0.0f);
+        float Radius = 0.0f;
+        bool Valid = false;
+    };
+
+    std::vector<CasterBounds> _bounds;
+    std::vector<uint32_t> _allCasters;
+
+    std::vector<std::array<std::vector<uint32_t>, SHADOW_MAP_CASCADE_COUNT>> _dirCasters;
+    std::vector<std::array<std::vector<uint32_t>, 6>> _pointCasters;
+    std::vector<std::vector<ShadowCasterFaceMask>> _pointCasterMasks;
+    std::vector<ShadowCasterFaceMask> _allCasterMasks;
+    std::vector<std::vector<uint32_t>> _spotCasters;
+
+    ShadowCullingFrameStats _stats;
+
+public:
+    bool Enabled = true;
+    /// Por debajo de este numero de tests (vistas x casters) se trabaja en un solo hilo.
+    uint32_t MinParallelTests = 4096;
+
+private:
+    void UpdateBounds();
+    void CullView(const glm::mat4& viewProj, const std::vector<uint32_t>& candidates, std::vector<uint32_t>& output) const;
+    void CullSphere(const glm::vec3& center, float radius, std::vector<uint32_t>& output) const;
+
+public:
+    ShadowCasterCulling() = default;
+
+    /// Calcula la esfera envolvente en mundo de un caster (agrandada si esta animado).
+    static bool ComputeCasterSphere(const std::shared_ptr<QEGameObject>& go, glm::vec3& center, float& radius);
+    static glm::mat4 ComputePointFaceViewProj(const glm::vec3& lightPosition, float lightRadius, uint32_t faceIdx);
+
+    /// Debe llamarse despues de ShadowCacheManager::Update: las cascadas diferidas restauran su matriz alli.
+    void Update(LightManager* lightManager);
+
+    const std::vector<uint32_t>& GetDirectionalCasters(uint32_t lightIdx, uint32_t cascadeIdx) const;
+    const std::vector<uint32_t>& GetPointCasters(uint32_t lightIdx, uint32_t faceIdx) const;
+    const std::vector<uint32_t>& GetSpotCasters(uint32_t lightIdx) const;
+    /// Misma informacion que GetPointCasters pero agrupada por caster, para el pase unico de 6 caras.
+    const std::vector<ShadowCasterFaceMask>& GetPointCasterMasks(uint32_t lightIdx) const;
+
+    void ResetSceneState();
+
+    const ShadowCullingFrameStats& GetFrameStats() const { return _stats; }
+};
+
+
+
+namespace QE
+{
+    using ::ShadowCullingFrameStats;
+    using ::ShadowCasterFaceMask;
+    using ::ShadowCasterCulling;
+} // namespace QE
+// QE namespace aliases
+#endif // !SHADOW_CASTER_CULLING_H
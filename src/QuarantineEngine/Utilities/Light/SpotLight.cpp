@@ -10,9 +10,9 @@ QESpotLight::QESpotLight() : QELight()
     this->outerCutoff = glm::cos(glm::radians(17.5f));
 }
 
-void QESpotLight::Setup(std::shared_ptr<VkRenderPass> renderPass)
+void QESpotLight::Setup()
 {
-    this->shadowMappingResourcesPtr = std::make_shared<SpotShadowResources>(renderPass);
+    this->shadowMappingResourcesPtr = std::make_shared<SpotShadowResources>();
 }
 
 void QESpotLight::UpdateUniform()
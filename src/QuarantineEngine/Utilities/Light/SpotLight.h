@@ -13,7 +13,7 @@ public:
 
 public:
     QESpotLight();
-    void Setup(std::shared_ptr<VkRenderPass> renderPass);
+    void Setup();
     void UpdateUniform() override;
     void CleanShadowMapResources();
 };
@@ -10,6 +10,7 @@
 #include <ktxvulkan.h>
 #include <filesystem>
 #include <Helpers/QEMemoryTrack.h>
+#include <QEKtxTranscodeCache.h>
 
 
 VkCommandPool CustomTexture::commandPool;
@@ -120,6 +121,46 @@ CustomTexture::CustomTexture(std::string path, TEXTURE_TYPE type, QEColorSpace c
     }
 }
 
+CustomTexture::CustomTexture(const std::string& path, const CustomTexture& placeholder)
+{
+    ptrCommandPool = &commandPool;
+    this->type = TEXTURE_TYPE::NULL_TYPE;
+    this->texturePaths.push_back(path);
+
+    this->texWidth = placeholder.texWidth;
+    this->texHeight = placeholder.texHeight;
+    this->texChannels = placeholder.texChannels;
+    this->mipLevels = placeholder.mipLevels;
+    this->image = placeholder.image;
+    this->imageView = placeholder.imageView;
+    this->textureSampler = placeholder.textureSampler;
+    this->currentLayout = placeholder.currentLayout;
+    this->resident = false;
+}
+
+void CustomTexture::CompleteStreaming(VkImage newImage, VkDeviceMemory newMemory, VkFormat format, uint32_t width, uint32_t height, uint32_t levels)
+{
+    // Cambio de residencia: la imagen anterior puede seguir en frames en vuelo, se destruye diferida
+    if (this->resident)
+    {
+        cleanup();
+    }
+
+    this->image = newImage;
+    this->deviceMemory = newMemory;
+    this->imageView = VK_NULL_HANDLE;
+    this->textureSampler = VK_NULL_HANDLE;
+    this->texWidth = static_cast<int>(width);
+    this->texHeight = static_cast<int>(height);
+    this->texChannels = 4;
+    this->mipLevels = levels;
+    this->currentLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+    this->resident = true;
+
+    createTextureImageView(format);
+    createTextureSampler();
+}
+
 void CustomTexture::createTextureImage(std::string path)
 {
     createTextureImage(path, QEColorSpace::SRGB);
@@ -231,12 +272,17 @@ void CustomTexture::createTextureImage(std::string path, QEColorSpace cs)
     this->createTextureSampler();
 }
 
-KtxTranscodeSelection CustomTexture::ChooseKtxTranscodeFormat(QEColorSpace cs)
+bool CustomTexture::SupportsBcTextures() const
 {
     VkPhysicalDeviceFeatures features{};
     vkGetPhysicalDeviceFeatures(deviceModule->physicalDevice, &features);
 
-    if (features.textureCompressionBC)
+    return features.textureCompressionBC == VK_TRUE;
+}
+
+KtxTranscodeSelection CustomTexture::SelectKtxTranscodeFormat(QEColorSpace cs, bool bcSupported)
+{
+    if (bcSupported)
     {
         if (cs == QEColorSpace::SRGB)
             return { KTX_TTF_BC7_RGBA, VK_FORMAT_BC7_SRGB_BLOCK };
@@ -254,66 +300,23 @@ void CustomTexture::createTextureFromKtx2(const std::string& path, QEColorSpace
 {
     ptrCommandPool = &commandPool;
 
-    ktxTexture2* kTexture = nullptr;
-    KTX_error_code ktxResult = ktxTexture2_CreateFromNamedFile(
-        path.c_str(),
-        KTX_TEXTURE_CREATE_LOAD_IMAGE_DATA_BIT,
-        &kTexture
-    );
-
-    if (ktxResult != KTX_SUCCESS || !kTexture)
-        throw std::runtime_error("Failed to load KTX2 texture: " + path);
-
-    VkFormat imageFormat = VK_FORMAT_UNDEFINED;
+    // Los Basis se leen de la cache de transcodificacion si ya se transcodificaron antes
+    QEKtxPayload payload;
+    QEKtxTranscodeCache::Load(path, cs, SupportsBcTextures(), payload);
 
-    if (ktxTexture2_NeedsTranscoding(kTexture))
-    {
-        KtxTranscodeSelection selection = ChooseKtxTranscodeFormat(cs);
+    const VkFormat imageFormat = payload.Format;
+    const VkDeviceSize dataSize = static_cast<VkDeviceSize>(payload.Size());
 
-        KTX_error_code transcodeResult = ktxTexture2_TranscodeBasis(
-            kTexture,
-            selection.ktxFormat,
-            0
-        );
-
-        if (transcodeResult != KTX_SUCCESS)
-        {
-            ktxTexture_Destroy(ktxTexture(kTexture));
-            throw std::runtime_error("Failed to transcode KTX2 texture: " + path);
-        }
-
-        imageFormat = selection.vkFormat;
-    }
-    else
-    {
-        imageFormat = static_cast<VkFormat>(kTexture->vkFormat);
-    }
-
-    if (imageFormat == VK_FORMAT_UNDEFINED)
-    {
-        ktxTexture_Destroy(ktxTexture(kTexture));
-        throw std::runtime_error("KTX2 texture has undefined VkFormat: " + path);
-    }
-
-    texWidth = static_cast<int>(kTexture->baseWidth);
-    texHeight = static_cast<int>(kTexture->baseHeight);
-    mipLevels = kTexture->numLevels;
+    texWidth = static_cast<int>(payload.Width);
+    texHeight = static_cast<int>(payload.Height);
+    mipLevels = static_cast<uint32_t>(payload.Levels.size());
     texChannels = 4;
 
-    ktx_size_t dataSize = ktxTexture_GetDataSize(ktxTexture(kTexture));
-    ktx_uint8_t* imageData = ktxTexture_GetData(ktxTexture(kTexture));
-
-    if (!imageData || dataSize == 0)
-    {
-        ktxTexture_Destroy(ktxTexture(kTexture));
-        throw std::runtime_error("KTX2 texture contains no image data: " + path);
-    }
-
     VkBuffer stagingBuffer = VK_NULL_HANDLE;
     VkDeviceMemory stagingBufferMemory = VK_NULL_HANDLE;
 
     BufferManageModule::createBuffer(
-        static_cast<VkDeviceSize>(dataSize),
+        dataSize,
         VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
         VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
         stagingBuffer,
@@ -322,8 +325,8 @@ void CustomTexture::createTextureFromKtx2(const std::string& path, QEColorSpace
     );
 
     void* mapped = nullptr;
-    vkMapMemory(deviceModule->device, stagingBufferMemory, 0, static_cast<VkDeviceSize>(dataSize), 0, &mapped);
-    memcpy(mapped, imageData, static_cast<size_t>(dataSize));
+    vkMapMemory(deviceModule->device, stagingBufferMemory, 0, dataSize, 0, &mapped);
+    memcpy(mapped, payload.Data(), static_cast<size_t>(dataSize));
     vkUnmapMemory(deviceModule->device, stagingBufferMemory);
 
     createImage(
@@ -360,19 +363,10 @@ void CustomTexture::createTextureFromKtx2(const std::string& path, QEColorSpace
 
     for (uint32_t level = 0; level < mipLevels; ++level)
     {
-        ktx_size_t offset = 0;
-        KTX_error_code offRes = ktxTexture_GetImageOffset(ktxTexture(kTexture), level, 0, 0, &offset);
-        if (offRes != KTX_SUCCESS)
-        {
-            endSingleTimeCommands(deviceModule->device, queueModule->graphicsQueue, *ptrCommandPool, cmd);
-            QE_DESTROY_BUFFER(deviceModule->device, stagingBuffer, "CustomTexture::createTextureFromKtx2");
-            QE_FREE_MEMORY(deviceModule->device, stagingBufferMemory, "CustomTexture::createTextureFromKtx2");
-            ktxTexture_Destroy(ktxTexture(kTexture));
-            throw std::runtime_error("Failed to get KTX2 mip offset: " + path);
-        }
+        const QEKtxLevel& ktxLevel = payload.Levels[level];
 
         VkBufferImageCopy region{};
-        region.bufferOffset = static_cast<VkDeviceSize>(offset);
+        region.bufferOffset = static_cast<VkDeviceSize>(ktxLevel.Offset);
         region.bufferRowLength = 0;
         region.bufferImageHeight = 0;
         region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
@@ -380,11 +374,7 @@ void CustomTexture::createTextureFromKtx2(const std::string& path, QEColorSpace
         region.imageSubresource.baseArrayLayer = 0;
         region.imageSubresource.layerCount = 1;
         region.imageOffset = { 0, 0, 0 };
-        region.imageExtent = {
-            std::max(1u, kTexture->baseWidth >> level),
-            std::max(1u, kTexture->baseHeight >> level),
-            1
-        };
+        region.imageExtent = { ktxLevel.Width, ktxLevel.Height, 1 };
 
         regions.push_back(region);
     }
@@ -411,8 +401,6 @@ void CustomTexture::createTextureFromKtx2(const std::string& path, QEColorSpace
     QE_DESTROY_BUFFER(deviceModule->device, stagingBuffer, "CustomTexture::createTextureFromKtx2");
     QE_FREE_MEMORY(deviceModule->device, stagingBufferMemory, "CustomTexture::createTextureFromKtx2");
 
-    ktxTexture_Destroy(ktxTexture(kTexture));
-
     createTextureImageView(imageFormat);
     createTextureSampler();
 }
@@ -789,22 +777,28 @@ void CustomTexture::createCubemapTextureSampler()
 
 void CustomTexture::cleanup()
 {
-    if (textureSampler != VK_NULL_HANDLE)
+    // Los handles del placeholder son de NULL_TEXTURE
+    if (!resident)
     {
-        vkDestroySampler(deviceModule->device, textureSampler, nullptr);
         textureSampler = VK_NULL_HANDLE;
+        imageView = VK_NULL_HANDLE;
+        image = VK_NULL_HANDLE;
+        return;
+    }
+
+    if (textureSampler != VK_NULL_HANDLE)
+    {
+        QE_DEFER_DESTROY(deviceModule->device, textureSampler, vkDestroySampler, "CustomTexture::cleanup");
     }
 
     if (imageView != VK_NULL_HANDLE)
     {
-        vkDestroyImageView(deviceModule->device, imageView, nullptr);
-        imageView = VK_NULL_HANDLE;
+        QE_DEFER_DESTROY(deviceModule->device, imageView, vkDestroyImageView, "CustomTexture::cleanup");
     }
 
     if (image != VK_NULL_HANDLE)
     {
-        vkDestroyImage(deviceModule->device, image, nullptr);
-        image = VK_NULL_HANDLE;
+        QE_DEFER_DESTROY(deviceModule->device, image, vkDestroyImage, "CustomTexture::cleanup");
     }
 
     if (deviceMemory != VK_NULL_HANDLE)
@@ -28,6 +28,8 @@ class CustomTexture : public TextureManagerModule
 {
 private:
     int                 texWidth, texHeight, texChannels;
+    // Mientras se carga en streaming apunta a la imagen del placeholder sin poseerla
+    bool                resident = true;
 
 public:
     std::vector<std::string>    texturePaths;
@@ -76,7 +78,7 @@ private:
 
     int GetChannelCount(VkFormat format);
 
-    KtxTranscodeSelection ChooseKtxTranscodeFormat(QEColorSpace cs);
+    bool SupportsBcTextures() const;
     void createTextureFromKtx2(const std::string& path, QEColorSpace cs);
 
 public:
@@ -86,11 +88,21 @@ public:
     CustomTexture(aiTexel* data, unsigned int width, unsigned int height, TEXTURE_TYPE type);
     CustomTexture(unsigned int width, unsigned int height, VkFormat format, VkImageTiling tiling, VkImageUsageFlags usage, TEXTURE_TYPE type);
     CustomTexture(std::string path, TEXTURE_TYPE type, QEColorSpace cs);
+    /// Textura en streaming: enlaza la imagen de placeholder hasta que QETextureStreamer la sube.
+    CustomTexture(const std::string& path, const CustomTexture& placeholder);
 
     int GetWidth() const { return texWidth; }
     int GetHeight() const { return texHeight; }
     int GetChannelCount() const { return texChannels; }
     uint32_t GetMipLevels() const { return mipLevels; }
+    bool IsResident() const { return resident; }
+
+    /// BC7 si el dispositivo soporta BC, RGBA8 si no. Sin estado: se usa tambien desde los hilos del streamer.
+    static KtxTranscodeSelection SelectKtxTranscodeFormat(QEColorSpace cs, bool bcSupported);
+
+    /// Adopta la imagen ya subida por el streamer (en SHADER_READ_ONLY_OPTIMAL) y crea vista y sampler;
+    /// si ya era residente (otra cadena de mips) la anterior se destruye diferida.
+    void CompleteStreaming(VkImage newImage, VkDeviceMemory newMemory, VkFormat format, uint32_t width, uint32_t height, uint32_t levels);
 
     void createTextureImage(std::string path = NULL);
     void createTextureImage(std::string path, QEColorSpace cs);
@@ -2,6 +2,8 @@
 #include <QEProjectManager.h>
 #include <QEMaterialYamlHelper.h>
 #include <Helpers/ScopedTimer.h>
+#include <QEBindlessMaterials.h>
+#include <QEShaderVariantCache.h>
 
 QEMaterial::QEMaterial(std::string name, std::string filepath)
 {
@@ -34,7 +36,7 @@ QEMaterial::QEMaterial(std::string name, std::shared_ptr<ShaderModule> shader_pt
 
     if (this->hasDescriptorBuffer)
     {
-        this->descriptor = std::make_shared<DescriptorBuffer>(this->shader);
+        this->CreateDescriptor(this->shader);
     }
 }
 
@@ -85,6 +87,54 @@ QEMaterial::QEMaterial(std::shared_ptr<ShaderModule> shader_ptr, const MaterialD
     this->materialData.ApplyDtoPacking(materialDto);
 }
 
+QEMaterial::~QEMaterial()
+{
+    if (auto* bindlessMaterials = QEBindlessMaterials::getInstance())
+        bindlessMaterials->UnregisterMaterial(this, this->bindlessIndex);
+}
+
+void QEMaterial::CreateDescriptor(const std::shared_ptr<ShaderModule>& shaderPtr)
+{
+    auto* bindlessMaterials = QEBindlessMaterials::getInstance();
+    this->sharedDescriptor = shaderPtr && shaderPtr->reflectShader.HasBindlessMaterials && bindlessMaterials && bindlessMaterials->IsAvailable();
+
+    this->descriptor = this->sharedDescriptor
+        ? bindlessMaterials->GetSharedDescriptor(shaderPtr)
+        : std::make_shared<DescriptorBuffer>(shaderPtr);
+}
+
+void QEMaterial::ReleaseDescriptor()
+{
+    if (this->descriptor && !this->sharedDescriptor)
+    {
+        this->descriptor->Cleanup();
+    }
+    this->descriptor.reset();
+    this->descriptor = nullptr;
+    this->sharedDescriptor = false;
+}
+
+void QEMaterial::UsePrivateDescriptor()
+{
+    if (!this->sharedDescriptor)
+        return;
+
+    this->descriptor = std::make_shared<DescriptorBuffer>(this->shader);
+    this->sharedDescriptor = false;
+    this->IsInitialized = false;
+}
+
+bool QEMaterial::UsesBindlessMaterials() const
+{
+    return this->shader && this->shader->reflectShader.HasBindlessMaterials && !this->isMeshShaderEnabled;
+}
+
+uint32_t QEMaterial::GetBindlessIndex() const
+{
+    auto* bindlessMaterials = QEBindlessMaterials::getInstance();
+    return bindlessMaterials ? bindlessMaterials->GetMaterialIndex(this, this->bindlessIndex) : 0;
+}
+
 std::shared_ptr<QEMaterial> QEMaterial::CreateMaterialInstance(
     const std::string& instanceName,
     const std::string& instanceFilePath)
@@ -105,7 +155,7 @@ std::shared_ptr<QEMaterial> QEMaterial::CreateMaterialInstance(
         dto.FilePath = QEProjectManager::ToProjectRelativePath(defaultPath);
     }
 
-    auto mat_instance = std::make_shared<QEMaterial>(this->shader, dto);
+    auto mat_instance = std::make_shared<QEMaterial>(this->GetBaseShader(), dto);
     mat_instance->renderQueue = this->renderQueue;
     mat_instance->shaderAssetPath = this->shaderAssetPath;
     return mat_instance;
@@ -115,15 +165,18 @@ void QEMaterial::CleanLastResources()
 {
     this->materialData.CleanLastResources();
 
-    if (this->hasDescriptorBuffer)
+    if (this->hasDescriptorBuffer && this->descriptor && !this->sharedDescriptor)
     {
         this->descriptor->CleanLastResources();
-        this->descriptor.reset();
-        this->descriptor = nullptr;
     }
+    this->descriptor.reset();
+    this->descriptor = nullptr;
+    this->sharedDescriptor = false;
     this->shader->CleanLastResources();
     this->shader.reset();
     this->shader = nullptr;
+    this->baseShader.reset();
+    this->variantKeywords = UINT32_MAX;
     this->hasDescriptorBuffer = false;
 }
 
@@ -131,10 +184,27 @@ void QEMaterial::InitializeMaterialData()
 {
     if (this->hasDescriptorBuffer && !this->descriptor)
     {
-        this->descriptor = std::make_shared<DescriptorBuffer>(this->shader);
+        this->CreateDescriptor(this->shader);
     }
 
-    if (this->hasDescriptorBuffer && !this->IsInitialized)
+    // Todos los materiales entran en la tabla: las sombras bindless los leen aunque su shader sea clasico
+    auto* bindlessMaterials = QEBindlessMaterials::getInstance();
+    if (bindlessMaterials && bindlessMaterials->GetMaterialIndex(this, this->bindlessIndex) != this->bindlessIndex)
+    {
+        this->bindlessIndex = bindlessMaterials->RegisterMaterial(this);
+    }
+
+    if (this->hasDescriptorBuffer && this->sharedDescriptor && !this->IsInitialized)
+    {
+        // Sin UBO ni texturas propias: el set 0 es comun y la tabla se escribe en QEBindlessMaterials::Update
+        if (this->descriptor->descriptorSets.empty())
+        {
+            this->descriptor->InitializeDescriptorSets(this->shader);
+        }
+
+        this->IsInitialized = true;
+    }
+    else if (this->hasDescriptorBuffer && !this->IsInitialized)
     {
         this->materialData.InitializeUBOMaterial(this->shader);
         this->descriptor->ubos["materialUBO"] = this->materialData.materialUBO;
@@ -149,7 +219,13 @@ void QEMaterial::InitializeMaterialData()
 
 void QEMaterial::cleanup()
 {
-    if (this->hasDescriptorBuffer)
+    if (auto* bindlessMaterials = QEBindlessMaterials::getInstance())
+    {
+        bindlessMaterials->UnregisterMaterial(this, this->bindlessIndex);
+    }
+    this->bindlessIndex = UINT32_MAX;
+
+    if (this->hasDescriptorBuffer && this->descriptor && !this->sharedDescriptor)
     {
         this->descriptor->Cleanup();
     }
@@ -167,7 +243,8 @@ void QEMaterial::UpdateUniformData()
 
 void QEMaterial::RefreshDescriptorBindings()
 {
-    if (!this->shader || !this->hasDescriptorBuffer || !this->descriptor)
+    // Los shaders bindless leen las texturas de la tabla global, que se reescribe sola
+    if (!this->shader || !this->hasDescriptorBuffer || !this->descriptor || this->sharedDescriptor)
         return;
 
     this->descriptor->textures = this->materialData.texture_vector;
@@ -181,9 +258,7 @@ void QEMaterial::SetMeshShaderPipeline(bool value)
         this->isMeshShaderEnabled = value;
         if (this->hasDescriptorBuffer)
         {
-            this->descriptor->Cleanup();
-            this->descriptor.reset();
-            this->descriptor = nullptr;
+            this->ReleaseDescriptor();
         }
 
         if (this->isMeshShaderEnabled)
@@ -198,7 +273,7 @@ void QEMaterial::SetMeshShaderPipeline(bool value)
         }
         else
         {
-            this->descriptor = std::make_shared<DescriptorBuffer>(this->shader);
+            this->CreateDescriptor(this->shader);
             this->materialData.InitializeUBOMaterial(this->shader);
         }
     }
@@ -206,6 +281,21 @@ void QEMaterial::SetMeshShaderPipeline(bool value)
 
 void QEMaterial::BindDescriptors(VkCommandBuffer& commandBuffer, uint32_t idx)
 {
+    auto* bindlessMaterials = QEBindlessMaterials::getInstance();
+    const VkPipelineLayout pipelineLayout = this->shader->PipelineModule->pipelineLayout;
+    const bool bindlessLayout = this->UsesBindlessMaterials() && bindlessMaterials->IsBindlessLayout(pipelineLayout);
+    const bool passSets = bindlessLayout && this->sharedDescriptor &&
+        !pointShadowDescriptorsOverride && !directionalShadowDescriptorsOverride && !spotShadowDescriptorsOverride;
+
+    // Mismo pipeline layout que el draw anterior: todos los sets del pase siguen enlazados
+    if (passSets && bindlessMaterials->BindPass(commandBuffer, idx, pipelineLayout))
+        return;
+
+    if (bindlessLayout && !passSets)
+    {
+        bindlessMaterials->BindPass(commandBuffer, idx, pipelineLayout);
+    }
+
     if (this->HasDescriptorBuffer() &&
         this->descriptor &&
         idx < this->descriptor->descriptorSets.size())
@@ -237,6 +327,12 @@ void QEMaterial::BindDescriptors(VkCommandBuffer& commandBuffer, uint32_t idx)
     {
         vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, this->shader->PipelineModule->pipelineLayout, 3, 1, &spotShadowDescriptors->renderDescriptorSets[idx], 0, nullptr);
     }
+
+    if (!passSets)
+    {
+        // Sets propios o de otro layout: el siguiente draw bindless vuelve a enlazar los del pase
+        bindlessMaterials->BeginPass();
+    }
 }
 
 void QEMaterial::RenameMaterial(std::string newName)
@@ -276,7 +372,7 @@ MaterialDto QEMaterial::ToDto() const
     dto.FilePath = QEProjectManager::ToProjectRelativePath(absMaterialPath);
     dto.ShaderPath = !this->shaderAssetPath.empty()
         ? this->shaderAssetPath
-        : (this->shader ? this->shader->shaderNameID : "default");
+        : (this->GetBaseShader() ? this->GetBaseShader()->shaderNameID : "default");
     dto.RenderQueue = static_cast<unsigned int>(this->renderQueue);
 
     dto.Opacity = this->materialData.Opacity;
@@ -323,26 +419,53 @@ bool QEMaterial::ApplyShader(const std::shared_ptr<ShaderModule>& shaderPtr, con
     if (!shaderPtr)
         return false;
 
-    if (this->descriptor)
-    {
-        this->descriptor->Cleanup();
-        this->descriptor.reset();
-        this->descriptor = nullptr;
-    }
+    this->baseShader.reset();
+    this->variantKeywords = UINT32_MAX;
+    this->shaderAssetPath = assetPath;
+    this->BindShader(shaderPtr);
+    return true;
+}
+
+void QEMaterial::BindShader(const std::shared_ptr<ShaderModule>& shaderPtr)
+{
+    this->ReleaseDescriptor();
 
     this->materialData.CleanMaterialUBO();
     this->IsInitialized = false;
     this->shader = shaderPtr;
-    this->shaderAssetPath = assetPath;
     this->hasDescriptorBuffer = shaderPtr->reflectShader.bindings.size() > 0;
 
     if (this->hasDescriptorBuffer)
     {
-        this->descriptor = std::make_shared<DescriptorBuffer>(this->shader);
+        this->CreateDescriptor(this->shader);
     }
 
     this->InitializeMaterialData();
-    return true;
+}
+
+void QEMaterial::UpdateShaderVariant()
+{
+    auto* variantCache = QEShaderVariantCache::getInstance();
+    if (!variantCache || !this->shader || this->isMeshShaderEnabled)
+        return;
+
+    const uint32_t keywords = QEShaderVariantCache::GetKeywords(this->materialData);
+    if (keywords == this->variantKeywords)
+        return;
+
+    this->variantKeywords = keywords;
+
+    const std::shared_ptr<ShaderModule> base = this->GetBaseShader();
+    if (!variantCache->HasVariants(base.get()))
+        return;
+
+    auto variant = variantCache->GetVariant(base, keywords);
+    this->baseShader = (variant != base) ? base : nullptr;
+
+    if (variant != this->shader)
+    {
+        this->BindShader(variant);
+    }
 }
 
 std::string QEMaterial::ToMaterialRelativePath(
@@ -21,6 +21,11 @@ private:
     bool IsInitialized = false;
     bool hasDescriptorBuffer = false;
     bool isMeshShaderEnabled = false;
+    bool sharedDescriptor = false;
+    uint32_t bindlessIndex = UINT32_MAX;
+    // Shader elegido por el usuario cuando 'shader' es una variante suya (QEShaderVariantCache)
+    std::shared_ptr<ShaderModule> baseShader;
+    uint32_t variantKeywords = UINT32_MAX;
     LightManager* lightManager;
     std::string materialFilePath;
     std::string shaderAssetPath;
@@ -32,6 +37,12 @@ private:
         const std::string& assetPath,
         const std::filesystem::path& materialFilePath);
 
+    // Los shaders bindless comparten un set 0 por shader (QEBindlessMaterials)
+    void CreateDescriptor(const std::shared_ptr<ShaderModule>& shaderPtr);
+    void ReleaseDescriptor();
+    bool UsesBindlessMaterials() const;
+    void BindShader(const std::shared_ptr<ShaderModule>& shaderPtr);
+
 public:
     std::string Name;
     MaterialData materialData;
@@ -43,6 +54,7 @@ public:
     QEMaterial(std::string name, std::string filepath = "");
     QEMaterial(std::string name, std::shared_ptr<ShaderModule> shader_ptr, std::string filepath = "");
     QEMaterial(std::shared_ptr<ShaderModule> shader_ptr, const MaterialDto& materialDto);
+    ~QEMaterial();
     void CleanLastResources();
 
     void cleanup();
@@ -55,10 +67,18 @@ public:
     bool HasDescriptorBuffer() { return this->hasDescriptorBuffer; }
     void SetMeshShaderPipeline(bool value);
     void BindDescriptors(VkCommandBuffer& commandBuffer, uint32_t idx);
+    /// Registro del material en QE_MaterialTable; 0 (material por defecto) si no esta registrado.
+    uint32_t GetBindlessIndex() const;
     void RenameMaterial(std::string newName);
     std::string SaveMaterialFile();
     MaterialDto ToDto() const;
     bool ApplyShader(const std::shared_ptr<ShaderModule>& shaderPtr, const std::string& assetPath = "");
+    /// Cambia a la variante precompilada del shader para las texturas y el modo alfa actuales.
+    void UpdateShaderVariant();
+    /// El shader asignado al material, aunque se este usando una variante suya.
+    const std::shared_ptr<ShaderModule>& GetBaseShader() const { return baseShader ? baseShader : shader; }
+    /// Set 0 propio aunque el shader sea bindless, para poder sustituir sus UBOs (p.ej. previsualizacion).
+    void UsePrivateDescriptor();
     void SetShadowDescriptorOverrides(
         const std::shared_ptr<PointShadowDescriptorsManager>& pointShadowDescriptors,
         const std::shared_ptr<CSMDescriptorsManager>& directionalShadowDescriptors,
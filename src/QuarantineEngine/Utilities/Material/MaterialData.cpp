@@ -89,7 +89,7 @@ std::unordered_map<std::string, WriteFn> MaterialData::BuildMaterialWriters()
     writeValue("idxAO", [this] { return idxAO; });
 
     //uints
-    writeValue("texMask", [this] { return TexMask; });
+    writeValue("texMask", [this] { return ResidentTexMask(); });
     writeValue("metallicChan", [this] { return MetallicChan; });
     writeValue("roughnessChan", [this] { return RoughnessChan; });
     writeValue("aoChan", [this] { return AOChan; });
@@ -355,7 +355,34 @@ void MaterialData::RecalculateTextureState()
     UpdateMaterialDataRaw("metallicChan", &MetallicChan, sizeof(MetallicChan));
     UpdateMaterialDataRaw("roughnessChan", &RoughnessChan, sizeof(RoughnessChan));
     UpdateMaterialDataRaw("aoChan", &AOChan, sizeof(AOChan));
-    UpdateMaterialDataRaw("texMask", &TexMask, sizeof(TexMask));
+    WriteTexMask();
+}
+
+uint32_t MaterialData::ResidentTexMask() const
+{
+    // Un slot con una textura aun en streaming se muestrea como si no tuviera textura
+    uint32_t mask = TexMask;
+    if (!texture_vector)
+        return mask;
+
+    for (uint32_t slot = 0; slot < static_cast<uint32_t>(TOTAL_NUM_TEXTURES); ++slot)
+    {
+        const auto& tex = texture_vector->at(slot);
+        if (tex && !tex->IsResident())
+            mask &= ~(1u << slot);
+    }
+    return mask;
+}
+
+void MaterialData::WriteTexMask()
+{
+    const uint32_t mask = ResidentTexMask();
+    UpdateMaterialDataRaw("texMask", &mask, sizeof(mask));
+}
+
+void MaterialData::RefreshTextureResidency()
+{
+    WriteTexMask();
 }
 
 void MaterialData::SetTexture(TEXTURE_TYPE semantic, const std::string& texturePath)
@@ -549,10 +576,18 @@ void MaterialData::SetTextureSlot(uint32_t slot, const std::shared_ptr<CustomTex
     if (isReal)
     {
         TexMask |= (1u << slot);
-        UpdateMaterialDataRaw("texMask", &TexMask, sizeof(TexMask));
+        WriteTexMask();
     }
 }
 
+bool MaterialData::HasPackedMetallicRoughness(const MaterialDto& dto)
+{
+    return dto.metallicTexturePath != "NULL_TEXTURE" &&
+        dto.roughnessTexturePath != "NULL_TEXTURE" &&
+        !dto.metallicTexturePath.empty() &&
+        dto.metallicTexturePath == dto.roughnessTexturePath;
+}
+
 void MaterialData::ApplyDtoPacking(const MaterialDto& dto)
 {
     MetallicChan = dto.metallicChan;
@@ -567,12 +602,9 @@ void MaterialData::ApplyDtoPacking(const MaterialDto& dto)
     UpdateMaterialDataRaw("AlphaMode", &AlphaMode, sizeof(AlphaMode));
 
     TexMask = dto.texMask;
-    UpdateMaterialDataRaw("texMask", &TexMask, sizeof(TexMask));
+    WriteTexMask();
 
-    if (dto.metallicTexturePath != "NULL_TEXTURE" &&
-        dto.roughnessTexturePath != "NULL_TEXTURE" &&
-        !dto.metallicTexturePath.empty() &&
-        dto.metallicTexturePath == dto.roughnessTexturePath)
+    if (HasPackedMetallicRoughness(dto))
     {
         idxMetallic = (int)MAT_TEX_SLOT::Metallic;
         idxRoughness = idxMetallic;
@@ -588,6 +620,6 @@ void MaterialData::ApplyDtoPacking(const MaterialDto& dto)
 
         TexMask |= (1u << (uint32_t)MAT_TEX_SLOT::Metallic);
         TexMask |= (1u << (uint32_t)MAT_TEX_SLOT::Roughness);
-        UpdateMaterialDataRaw("texMask", &TexMask, sizeof(TexMask));
+        WriteTexMask();
     }
 }
@@ -136,6 +136,7 @@ private:
     std::string GetTexture(const aiScene* scene, aiMaterial* mat, aiTextureType type, TEXTURE_TYPE textureType);
     void fillEmptyTextures();
     void RecalculateTextureState();
+    void WriteTexMask();
 
     static glm::vec4 ToVec4(const aiColor4D& c)
     {
@@ -161,6 +162,12 @@ public:
     void SetMaterialField(const std::string& nameField, int value);
     void SetTextureSlot(uint32_t slot, const std::shared_ptr<CustomTexture>& tex, bool isReal);
     void ApplyDtoPacking(const MaterialDto& dto);
+    /// Metallic y roughness en la misma textura (glTF): ApplyDtoPacking activa ambos slots.
+    static bool HasPackedMetallicRoughness(const MaterialDto& dto);
+    /// Reescribe texMask en el UBO tras completarse el streaming de alguna de sus texturas.
+    void RefreshTextureResidency();
+    /// TexMask sin los slots cuya textura aun no es residente (lo que ve el shader).
+    uint32_t ResidentTexMask() const;
 
     uint32_t GetTexMask() const { return TexMask; }
     uint32_t GetMetallicChan() const { return MetallicChan; }
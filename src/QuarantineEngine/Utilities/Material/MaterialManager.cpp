@@ -2,16 +2,20 @@
 #include "Material.h"
 
 #include <RenderPassModule.h>
+#include <DeviceModule.h>
 
 #include "ShaderManager.h"
 #include <GraphicsPipelineModule.h>
 #include <filesystem>
+#include <algorithm>
 #include <Vertex.h>
 #include <QEProjectManager.h>
 #include <QEMaterialYamlHelper.h>
 #include <QEShaderAssetLoader.h>
 #include <GameObjectManager.h>
 #include <Helpers/ScopedTimer.h>
+#include <QEBindlessMaterials.h>
+#include <QEShaderVariantCache.h>
 
 std::string MaterialManager::CheckName(std::string nameMaterial)
 {
@@ -46,11 +50,18 @@ MaterialManager::MaterialManager()
     const std::string absolute_csm_frag_shader_path = absPath + "/Shadow/csm_frag.spv";
     const std::string absolute_omni_shadow_vertex_shader_path = absPath + "/Shadow/omni_shadow_vert.spv";
     const std::string absolute_omni_shadow_frag_shader_path = absPath + "/Shadow/omni_shadow_frag.spv";
+    const std::string absolute_omni_shadow_layered_vertex_shader_path = absPath + "/Shadow/omni_shadow_layered_vert.spv";
+    const std::string absolute_default_bindless_frag_shader_path = absPath + "/Default/default_bindless_frag.spv";
+    const std::string absolute_csm_bindless_vertex_shader_path = absPath + "/Shadow/csm_bindless_vert.spv";
+    const std::string absolute_csm_bindless_frag_shader_path = absPath + "/Shadow/csm_bindless_frag.spv";
+    const std::string absolute_omni_shadow_bindless_vertex_shader_path = absPath + "/Shadow/omni_shadow_bindless_vert.spv";
+    const std::string absolute_omni_shadow_bindless_frag_shader_path = absPath + "/Shadow/omni_shadow_bindless_frag.spv";
+    const std::string absolute_omni_shadow_layered_bindless_vertex_shader_path = absPath + "/Shadow/omni_shadow_layered_bindless_vert.spv";
     const std::string absolute_particles_vert_shader_path = absPath + "/Particles/particles_vert.spv";
     const std::string absolute_particles_frag_shader_path = absPath + "/Particles/particles_frag.spv";
-    const std::string absolute_mesh_task_shader_path = absPath + "/mesh/mesh_task.spv";
-    const std::string absolute_mesh_mesh_shader_path = absPath + "/mesh/mesh_mesh.spv";
-    const std::string absolute_mesh_frag_shader_path = absPath + "/mesh/mesh_frag.spv";
+    const std::string absolute_mesh_task_shader_path = absPath + "/Mesh/mesh_task.spv";
+    const std::string absolute_mesh_mesh_shader_path = absPath + "/Mesh/mesh_mesh.spv";
+    const std::string absolute_mesh_frag_shader_path = absPath + "/Mesh/mesh_frag.spv";
     const std::string absolute_debugBB_vertex_shader_path = absPath + "/Debug/debugAABB_vert.spv";
     const std::string absolute_debugBB_frag_shader_path = absPath + "/Debug/debugAABB_frag.spv";
     const std::string absolute_debug_vertex_shader_path = absPath + "/Debug/debug_vert.spv";
@@ -58,17 +69,51 @@ MaterialManager::MaterialManager()
     const std::string absolute_grid_vertex_shader_path = absPath + "/Grid/grid_vert.spv";
     const std::string absolute_grid_frag_shader_path = absPath + "/Grid/grid_frag.spv";
 
+    // Variantes bindless (-DQE_BINDLESS_MATERIALS): todas o ninguna, las sombras leen los sets de los materiales
+    const bool useBindless = QEBindlessMaterials::getInstance()->IsAvailable() &&
+        std::filesystem::exists(absolute_default_bindless_frag_shader_path) &&
+        std::filesystem::exists(absolute_csm_bindless_vertex_shader_path) &&
+        std::filesystem::exists(absolute_csm_bindless_frag_shader_path) &&
+        std::filesystem::exists(absolute_omni_shadow_bindless_vertex_shader_path) &&
+        std::filesystem::exists(absolute_omni_shadow_bindless_frag_shader_path) &&
+        std::filesystem::exists(absolute_omni_shadow_layered_bindless_vertex_shader_path);
+
+    const std::string& default_frag_shader_path = useBindless ? absolute_default_bindless_frag_shader_path : absolute_default_frag_shader_path;
+    const std::string& csm_vertex_shader_path = useBindless ? absolute_csm_bindless_vertex_shader_path : absolute_csm_vertex_shader_path;
+    const std::string& csm_frag_shader_path = useBindless ? absolute_csm_bindless_frag_shader_path : absolute_csm_frag_shader_path;
+    const std::string& omni_shadow_vertex_shader_path = useBindless ? absolute_omni_shadow_bindless_vertex_shader_path : absolute_omni_shadow_vertex_shader_path;
+    const std::string& omni_shadow_frag_shader_path = useBindless ? absolute_omni_shadow_bindless_frag_shader_path : absolute_omni_shadow_frag_shader_path;
+    const std::string& omni_shadow_layered_vertex_shader_path = useBindless ? absolute_omni_shadow_layered_bindless_vertex_shader_path : absolute_omni_shadow_layered_vertex_shader_path;
+
+    if (useBindless)
+    {
+        QE_LOG_INFO_CAT("MaterialManager", "Using bindless material shaders");
+    }
+
     auto shaderManager = ShaderManager::getInstance();
     this->default_shader = std::make_shared<ShaderModule>(
-        ShaderModule("default", absolute_default_vertex_shader_path, absolute_default_frag_shader_path)
+        ShaderModule("default", absolute_default_vertex_shader_path, default_frag_shader_path)
     );
     shaderManager->AddShader(this->default_shader);
 
+    // Un .spv compilado antes de los atlas de sombras no declara QE_PointShadowAtlas/QE_SpotShadowAtlas
+    if (!this->default_shader->reflectShader.HasPointShadows || !this->default_shader->reflectShader.HasSpotShadows)
+    {
+        QE_LOG_ERROR_CAT_F("MaterialManager", "{} lacks the point/spot shadow atlas bindings: the SPIR-V is older than its GLSL, rebuild the shaders", default_frag_shader_path);
+    }
+
     this->default_primitive_shader = std::make_shared<ShaderModule>(
-        ShaderModule("default_primitive", absolute_default_vertex_shader_path, absolute_default_frag_shader_path)
+        ShaderModule("default_primitive", absolute_default_vertex_shader_path, default_frag_shader_path)
     );
     shaderManager->AddShader(this->default_primitive_shader);
 
+    // Variantes del fragment por defecto segun las texturas y el modo alfa de cada material
+    auto variantCache = QEShaderVariantCache::getInstance();
+    variantCache->Initialize(absPath);
+    const std::string variantProgram = useBindless ? "default_bindless" : "default";
+    variantCache->RegisterProgram(this->default_shader, variantProgram, absolute_default_vertex_shader_path);
+    variantCache->RegisterProgram(this->default_primitive_shader, variantProgram, absolute_default_vertex_shader_path);
+
     GraphicsPipelineData pipelineParticleShader = {};
     pipelineParticleShader.HasVertexData = false;
     this->default_particles_shader = std::make_shared<ShaderModule>(
@@ -88,14 +133,28 @@ MaterialManager::MaterialManager()
 
     pipelineShadowShader.shadowMode = ShadowMappingMode::DIRECTIONAL_SHADOW;
     pipelineShadowShader.renderPass = this->renderPassModule->DirShadowMappingRenderPass;
-    this->csm_shader = std::make_shared<ShaderModule>(ShaderModule("csm_shader", absolute_csm_vertex_shader_path, absolute_csm_frag_shader_path, pipelineShadowShader));
+    this->csm_shader = std::make_shared<ShaderModule>(ShaderModule("csm_shader", csm_vertex_shader_path, csm_frag_shader_path, pipelineShadowShader));
     shaderManager->AddShader(this->csm_shader);
 
     pipelineShadowShader.shadowMode = ShadowMappingMode::OMNI_SHADOW;
-    pipelineShadowShader.renderPass = this->renderPassModule->OmniShadowMappingRenderPass;
-    this->omni_shadow_mapping_shader = std::make_shared<ShaderModule>(ShaderModule("omni_shadow_mapping_shader", absolute_omni_shadow_vertex_shader_path, absolute_omni_shadow_frag_shader_path, pipelineShadowShader));
+    pipelineShadowShader.renderPass = this->renderPassModule->DirShadowMappingRenderPass;
+    this->omni_shadow_mapping_shader = std::make_shared<ShaderModule>(ShaderModule("omni_shadow_mapping_shader", omni_shadow_vertex_shader_path, omni_shadow_frag_shader_path, pipelineShadowShader));
     shaderManager->AddShader(this->omni_shadow_mapping_shader);
 
+    // Las seis caras en un pase: requiere gl_Layer en el vertex shader
+    if (DeviceModule::getInstance()->IsShaderOutputLayerSupported())
+    {
+        if (std::filesystem::exists(omni_shadow_layered_vertex_shader_path))
+        {
+            this->omni_shadow_layered_shader = std::make_shared<ShaderModule>(ShaderModule("omni_shadow_layered_shader", omni_shadow_layered_vertex_shader_path, omni_shadow_frag_shader_path, pipelineShadowShader));
+            shaderManager->AddShader(this->omni_shadow_layered_shader);
+        }
+        else
+        {
+            QE_LOG_WARN_CAT_F("MaterialManager", "{} not found: point shadows fall back to six passes per light (build the QEShaders target)", omni_shadow_layered_vertex_shader_path);
+        }
+    }
+
     GraphicsPipelineData gpData = {};
     gpData.HasVertexData = true;
     gpData.polygonMode = VK_POLYGON_MODE_LINE;
@@ -212,6 +271,7 @@ std::shared_ptr<QEMaterial> MaterialManager::LoadMaterialFromFile(const std::fil
     {
         material->SetShaderAssetPath(materialDto.ShaderPath);
     }
+    material->UpdateShaderVariant();
     AddMaterial(material);
     return GetMaterial(material->Name);
 }
@@ -371,6 +431,11 @@ std::shared_ptr<ShaderModule> MaterialManager::GetOmniShadowMappingShader() cons
     return omni_shadow_mapping_shader;
 }
 
+std::shared_ptr<ShaderModule> MaterialManager::GetOmniShadowLayeredShader() const
+{
+    return omni_shadow_layered_shader;
+}
+
 void MaterialManager::CleanPipelines()
 {
     for (auto& it : _materials)
@@ -396,6 +461,11 @@ void MaterialManager::CleanLastResources()
     this->_materials.clear();
     this->_persistentMaterialNames.clear();
 
+    if (auto* variantCache = QEShaderVariantCache::getInstance())
+    {
+        variantCache->Clear();
+    }
+
     this->default_shader.reset();
     this->default_primitive_shader.reset();
     this->default_particles_shader.reset();
@@ -405,6 +475,7 @@ void MaterialManager::CleanLastResources()
     this->shader_grid_ptr.reset();
     this->csm_shader.reset();
     this->omni_shadow_mapping_shader.reset();
+    this->omni_shadow_layered_shader.reset();
 
     this->default_shader = nullptr;
     this->default_primitive_shader = nullptr;
@@ -415,17 +486,45 @@ void MaterialManager::CleanLastResources()
     this->shader_grid_ptr = nullptr;
     this->csm_shader = nullptr;
     this->omni_shadow_mapping_shader = nullptr;
+    this->omni_shadow_layered_shader = nullptr;
 }
 
-void MaterialManager::UpdateUniforms()
+void MaterialManager::UpdateUniforms(uint32_t currentFrame)
 {
     for (auto& it : _materials)
     {
         if (it.second)
         {
+            it.second->UpdateShaderVariant();
             it.second->UpdateUniformData();
         }
     }
+
+    QEBindlessMaterials::getInstance()->Update(currentFrame);
+}
+
+void MaterialManager::RefreshTextureBindings(const std::unordered_set<const CustomTexture*>& textures)
+{
+    if (textures.empty())
+        return;
+
+    for (auto& it : _materials)
+    {
+        if (!it.second || !it.second->materialData.texture_vector)
+            continue;
+
+        const auto& slots = *it.second->materialData.texture_vector;
+        const bool usesTexture = std::any_of(slots.begin(), slots.end(), [&textures](const std::shared_ptr<CustomTexture>& tex)
+            {
+                return tex && textures.contains(tex.get());
+            });
+
+        if (!usesTexture)
+            continue;
+
+        it.second->materialData.RefreshTextureResidency();
+        it.second->RefreshDescriptorBindings();
+    }
 }
 
 std::vector<MaterialDto> MaterialManager::GetMaterialDtos(std::ifstream& file)
@@ -606,22 +705,11 @@ void MaterialManager::DeserializeMaterials(YAML::Node materials)
         {
             for (const auto& materialPath : materials)
             {
-                std::string matPath = materialPath.as<std::string>();
-                fs::path resolvedPath = QEProjectManager::ResolveProjectPath(matPath);
-
                 MaterialDto materialDto;
-
-                if (!QEMaterialYamlHelper::ReadMaterialFile(resolvedPath, materialDto))
+                if (ReadSceneMaterial(materialPath.as<std::string>(), materialDto))
                 {
-                    QE_LOG_ERROR_CAT_F("QEMaterial", "Error reading the material: {}", resolvedPath.string());
-                    continue;
+                    materialDtos.push_back(materialDto);
                 }
-
-                materialDto.UpdateTexturePaths(resolvedPath.parent_path());
-                materialDto.Name = resolvedPath.stem().string();
-                materialDto.FilePath = QEProjectManager::ToProjectRelativePath(resolvedPath);
-
-                materialDtos.push_back(materialDto);
             }
         }
     }
@@ -634,6 +722,22 @@ void MaterialManager::DeserializeMaterials(YAML::Node materials)
     this->LoadMaterialDtos(materialDtos);
 }
 
+bool MaterialManager::ReadSceneMaterial(const std::string& materialPath, MaterialDto& outDto)
+{
+    fs::path resolvedPath = QEProjectManager::ResolveProjectPath(materialPath);
+
+    if (!QEMaterialYamlHelper::ReadMaterialFile(resolvedPath, outDto))
+    {
+        QE_LOG_ERROR_CAT_F("QEMaterial", "Error reading the material: {}", resolvedPath.string());
+        return false;
+    }
+
+    outDto.UpdateTexturePaths(resolvedPath.parent_path());
+    outDto.Name = resolvedPath.stem().string();
+    outDto.FilePath = QEProjectManager::ToProjectRelativePath(resolvedPath);
+    return true;
+}
+
 void MaterialManager::MarkMaterialPersistent(const std::string& materialName)
 {
     if (!materialName.empty())
@@ -34,11 +34,11 @@ private:
 
     std::shared_ptr<ShaderModule> csm_shader;
     std::shared_ptr<ShaderModule> omni_shadow_mapping_shader;
+    std::shared_ptr<ShaderModule> omni_shadow_layered_shader;
 
     void CreateDefaultPrimitiveMaterial();
     static std::vector<MaterialDto> GetMaterialDtos(std::ifstream& file);
     static MaterialDto ReadQEMaterial(std::ifstream& file);
-    void LoadMaterialDtos(std::vector<MaterialDto>& materialDtos);
 
 public:
     MaterialManager();
@@ -57,6 +57,8 @@ public:
     bool Exists(std::string materialName);
     std::shared_ptr<ShaderModule> GetCSMShader() const;
     std::shared_ptr<ShaderModule> GetOmniShadowMappingShader() const;
+    // nullptr si el dispositivo no puede escribir gl_Layer desde el vertex shader
+    std::shared_ptr<ShaderModule> GetOmniShadowLayeredShader() const;
 
     void MarkMaterialPersistent(const std::string& materialName);
     bool IsPersistentMaterial(const std::string& materialName) const;
@@ -64,10 +66,18 @@ public:
 
     void CleanPipelines();
     void CleanLastResources();
-    void UpdateUniforms();
+    /// UBOs de los materiales clasicos y tabla bindless del slot 'currentFrame' (ya esperado).
+    void UpdateUniforms(uint32_t currentFrame);
+    /// Re-enlaza los descriptores y el texMask de los materiales que usan alguna de estas texturas.
+    void RefreshTextureBindings(const std::unordered_set<const CustomTexture*>& textures);
 
     YAML::Node SerializeMaterials();
     void DeserializeMaterials(YAML::Node materials);
+    /// Lee un .qemat de la lista de materiales de la escena y resuelve sus rutas. No toca el manager,
+    /// asi que QESceneLoader lo llama desde sus hilos de trabajo.
+    static bool ReadSceneMaterial(const std::string& materialPath, MaterialDto& outDto);
+    /// Crea los materiales (y pide sus texturas) de DTOs ya leidos; solo en el hilo principal.
+    void LoadMaterialDtos(std::vector<MaterialDto>& materialDtos);
 };
 
 
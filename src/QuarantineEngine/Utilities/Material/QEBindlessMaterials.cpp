@@ -0,0 +1,594 @@
+#include "QEBindlessMaterials.h"
+#include <algorithm>
+#include <cstring>
+#include <DeviceModule.h>
+#include <BufferManageModule.h>
+#include <TextureManager.h>
+#include <DescriptorBuffer.h>
+#include <Material.h>
+#include <Helpers/QEMemoryTrack.h>
+#include <Logging/QELogMacros.h>
+
+bool QEBindlessMaterials::Enabled = true;
+
+namespace
+{
+    // Samplers de los demas sets del fragment shader (sombras) que cuentan contra el mismo limite
+    constexpr uint32_t RESERVED_SAMPLERS = 16;
+    constexpr uint32_t MIN_MATERIAL_CAPACITY = 64;
+
+    QEGpuMaterial DefaultGpuMaterial()
+    {
+        QEGpuMaterial record{};
+        record.Diffuse = glm::vec4(1.0f);
+        record.Ambient = glm::vec4(0.1f);
+        record.Specular = glm::vec4(1.0f);
+        record.Emissive = glm::vec4(0.0f);
+        record.Transparent = glm::vec4(1.0f);
+        record.Reflective = glm::vec4(0.0f);
+        record.Opacity = 1.0f;
+        record.BumpScaling = 1.0f;
+        record.Shininess = 32.0f;
+        record.Roughness = 1.0f;
+        record.AO = 1.0f;
+        record.ClearcoatRoughness = 0.1f;
+        record.AlphaCutoff = 0.5f;
+        return record;
+    }
+}
+
+void QEBindlessMaterials::Initialize()
+{
+    if (initialized || !Enabled)
+        return;
+
+    deviceModule = DeviceModule::getInstance();
+
+    VkPhysicalDeviceDescriptorIndexingFeatures indexing{};
+    indexing.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES;
+    VkPhysicalDeviceFeatures2 features{};
+    features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+    features.pNext = &indexing;
+    vkGetPhysicalDeviceFeatures2(deviceModule->physicalDevice, &features);
+
+    if (!indexing.descriptorBindingPartiallyBound || !indexing.runtimeDescriptorArray ||
+        !indexing.shaderSampledImageArrayNonUniformIndexing)
+    {
+        QE_LOG_WARN_CAT("QEBindlessMaterials", "Descriptor indexing is not supported: materials keep one descriptor set each");
+        return;
+    }
+
+    updateAfterBind =
+        indexing.descriptorBindingSampledImageUpdateAfterBind &&
+        indexing.descriptorBindingStorageBufferUpdateAfterBind;
+
+    VkPhysicalDeviceDescriptorIndexingProperties indexingProperties{};
+    indexingProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_PROPERTIES;
+    VkPhysicalDeviceProperties2 properties{};
+    properties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+    properties.pNext = &indexingProperties;
+    vkGetPhysicalDeviceProperties2(deviceModule->physicalDevice, &properties);
+
+    // Sin update-after-bind cuentan los limites normales, que en algunos dispositivos son muy bajos
+    const VkPhysicalDeviceLimits& limits = properties.properties.limits;
+    uint32_t samplerLimit = updateAfterBind
+        ? std::min({ indexingProperties.maxPerStageDescriptorUpdateAfterBindSamplers,
+                     indexingProperties.maxPerStageDescriptorUpdateAfterBindSampledImages,
+                     indexingProperties.maxDescriptorSetUpdateAfterBindSamplers,
+                     indexingProperties.maxDescriptorSetUpdateAfterBindSampledImages })
+        : std::min({ limits.maxPerStageDescriptorSamplers,
+                     limits.maxPerStageDescriptorSampledImages,
+                     limits.maxDescriptorSetSamplers,
+                     limits.maxDescriptorSetSampledImages });
+
+    textureCapacity = std::min(MAX_TEXTURES, samplerLimit > RESERVED_SAMPLERS ? samplerLimit - RESERVED_SAMPLERS : 0u);
+    if (textureCapacity < static_cast<uint32_t>(MaterialData::TOTAL_NUM_TEXTURES))
+    {
+        QE_LOG_WARN_CAT_F("QEBindlessMaterials", "Only {} samplers per stage available: materials keep one descriptor set each", samplerLimit);
+        textureCapacity = 0;
+        return;
+    }
+
+    auto nullTexture = TextureManager::getInstance()->GetTexture("NULL_TEXTURE");
+    if (!nullTexture)
+        throw std::runtime_error("QEBindlessMaterials::Initialize: NULL_TEXTURE must exist before the bindless tables");
+
+    CreateSetLayout();
+    CreateDescriptorSets();
+
+    textures.clear();
+    textures.push_back({ nullTexture, 0 });
+    textureIndices[nullTexture.get()] = NULL_TEXTURE_INDEX;
+
+    materials.clear();
+    MaterialEntry defaultEntry;
+    defaultEntry.Record = DefaultGpuMaterial();
+    defaultEntry.Version = ++versionCounter;
+    materials.push_back(defaultEntry);
+
+    initialized = true;
+
+    QE_LOG_INFO_CAT_F("QEBindlessMaterials", "Bindless materials enabled: {} texture descriptors, update-after-bind {}",
+        textureCapacity, updateAfterBind ? "on" : "off");
+}
+
+void QEBindlessMaterials::CreateSetLayout()
+{
+    std::array<VkDescriptorSetLayoutBinding, 2> bindings{};
+    bindings[0].binding = 0;
+    bindings[0].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    bindings[0].descriptorCount = 1;
+    bindings[0].stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
+
+    bindings[1].binding = 1;
+    bindings[1].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    bindings[1].descriptorCount = textureCapacity;
+    bindings[1].stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
+
+    const VkDescriptorBindingFlags updateFlag = updateAfterBind ? VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT : 0;
+    std::array<VkDescriptorBindingFlags, 2> bindingFlags =
+    {
+        updateFlag,
+        updateFlag | VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT
+    };
+
+    VkDescriptorSetLayoutBindingFlagsCreateInfo flagsInfo{};
+    flagsInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO;
+    flagsInfo.bindingCount = static_cast<uint32_t>(bindingFlags.size());
+    flagsInfo.pBindingFlags = bindingFlags.data();
+
+    VkDescriptorSetLayoutCreateInfo layoutInfo{};
+    layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    layoutInfo.pNext = &flagsInfo;
+    layoutInfo.flags = updateAfterBind ? VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT : 0;
+    layoutInfo.bindingCount = static_cast<uint32_t>(bindings.size());
+    layoutInfo.pBindings = bindings.data();
+
+    if (vkCreateDescriptorSetLayout(deviceModule->device, &layoutInfo, nullptr, &setLayout) != VK_SUCCESS)
+    {
+        throw std::runtime_error("failed to create bindless material descriptor set layout!");
+    }
+}
+
+void QEBindlessMaterials::CreateDescriptorSets()
+{
+    std::array<VkDescriptorPoolSize, 2> poolSizes{};
+    poolSizes[0].type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    poolSizes[0].descriptorCount = MAX_FRAMES_IN_FLIGHT;
+    poolSizes[1].type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    poolSizes[1].descriptorCount = textureCapacity * MAX_FRAMES_IN_FLIGHT;
+
+    VkDescriptorPoolCreateInfo poolInfo{};
+    poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    poolInfo.flags = updateAfterBind ? VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT : 0;
+    poolInfo.maxSets = MAX_FRAMES_IN_FLIGHT;
+    poolInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
+    poolInfo.pPoolSizes = poolSizes.data();
+
+    if (vkCreateDescriptorPool(deviceModule->device, &poolInfo, nullptr, &descriptorPool) != VK_SUCCESS)
+    {
+        throw std::runtime_error("failed to create bindless material descriptor pool!");
+    }
+
+    std::array<VkDescriptorSetLayout, MAX_FRAMES_IN_FLIGHT> layouts;
+    layouts.fill(setLayout);
+
+    VkDescriptorSetAllocateInfo allocInfo{};
+    allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    allocInfo.descriptorPool = descriptorPool;
+    allocInfo.descriptorSetCount = MAX_FRAMES_IN_FLIGHT;
+    allocInfo.pSetLayouts = layouts.data();
+
+    std::array<VkDescriptorSet, MAX_FRAMES_IN_FLIGHT> sets{};
+    if (vkAllocateDescriptorSets(deviceModule->device, &allocInfo, sets.data()) != VK_SUCCESS)
+    {
+        throw std::runtime_error("failed to allocate bindless material descriptor sets!");
+    }
+
+    for (uint32_t i = 0; i < MAX_FRAMES_IN_FLIGHT; ++i)
+    {
+        frames[i] = FrameSlot{};
+        frames[i].DescriptorSet = sets[i];
+    }
+}
+
+void QEBindlessMaterials::Cleanup()
+{
+    if (!initialized)
+        return;
+
+    for (auto& [shader, descriptor] : sharedDescriptors)
+    {
+        if (descriptor.second)
+            descriptor.second->Cleanup();
+    }
+    sharedDescriptors.clear();
+
+    for (auto& frame : frames)
+    {
+        if (frame.Buffer != VK_NULL_HANDLE)
+        {
+            vkUnmapMemory(deviceModule->device, frame.Memory);
+            QE_DESTROY_BUFFER(deviceModule->device, frame.Buffer, "QEBindlessMaterials::Cleanup");
+            QE_FREE_MEMORY(deviceModule->device, frame.Memory, "QEBindlessMaterials::Cleanup");
+        }
+        frame = FrameSlot{};
+    }
+
+    QE_DEFER_DESTROY(deviceModule->device, descriptorPool, vkDestroyDescriptorPool, "QEBindlessMaterials::Cleanup");
+    QE_DEFER_DESTROY(deviceModule->device, setLayout, vkDestroyDescriptorSetLayout, "QEBindlessMaterials::Cleanup");
+    descriptorPool = VK_NULL_HANDLE;
+    setLayout = VK_NULL_HANDLE;
+
+    // Las texturas se liberan despues en TextureManager::Clean
+    textures.clear();
+    textureIndices.clear();
+    freeTextures.clear();
+    materials.clear();
+    freeMaterials.clear();
+    bindlessLayouts.clear();
+    BeginPass();
+
+    initialized = false;
+}
+
+uint32_t QEBindlessMaterials::GetMaterialCount() const
+{
+    if (materials.empty())
+        return 0;
+
+    return static_cast<uint32_t>(materials.size() - freeMaterials.size() - 1);
+}
+
+uint32_t QEBindlessMaterials::RegisterMaterial(QEMaterial* material)
+{
+    if (!initialized || material == nullptr)
+        return DEFAULT_MATERIAL_INDEX;
+
+    uint32_t index;
+    if (!freeMaterials.empty())
+    {
+        index = freeMaterials.back();
+        freeMaterials.pop_back();
+    }
+    else
+    {
+        index = static_cast<uint32_t>(materials.size());
+        materials.emplace_back();
+    }
+
+    // Los frames en vuelo siguen leyendo su propia copia; el registro se escribe en Update()
+    MaterialEntry& entry = materials[index];
+    entry = MaterialEntry{};
+    entry.Material = material;
+    PackMaterial(entry);
+    entry.Version = ++versionCounter;
+    return index;
+}
+
+void QEBindlessMaterials::UnregisterMaterial(const QEMaterial* material, uint32_t index)
+{
+    if (!initialized || index == DEFAULT_MATERIAL_INDEX || index >= materials.size())
+        return;
+
+    MaterialEntry& entry = materials[index];
+    if (entry.Material != material)
+        return;
+
+    entry.Material = nullptr;
+    entry.Textures.fill(nullptr);
+    freeMaterials.push_back(index);
+}
+
+uint32_t QEBindlessMaterials::GetMaterialIndex(const QEMaterial* material, uint32_t index) const
+{
+    if (index < materials.size() && materials[index].Material == material)
+        return index;
+
+    return DEFAULT_MATERIAL_INDEX;
+}
+
+std::shared_ptr<DescriptorBuffer> QEBindlessMaterials::GetSharedDescriptor(const std::shared_ptr<ShaderModule>& shader)
+{
+    auto it = sharedDescriptors.find(shader.get());
+    if (it != sharedDescriptors.end() && it->second.first.lock() == shader)
+        return it->second.second;
+
+    // Shader recargado en la misma direccion: el set anterior ya no vale
+    if (it != sharedDescriptors.end() && it->second.second)
+        it->second.second->Cleanup();
+
+    auto descriptor = std::make_shared<DescriptorBuffer>(shader);
+    sharedDescriptors[shader.get()] = { shader, descriptor };
+    return descriptor;
+}
+
+void QEBindlessMaterials::RegisterPipelineLayout(VkPipelineLayout pipelineLayout, const std::vector<VkDescriptorSetLayout>& setLayouts)
+{
+    if (pipelineLayout == VK_NULL_HANDLE)
+        return;
+
+    // Un handle reutilizado tras destruir un layout bindless no debe heredar su entrada
+    bindlessLayouts.erase(pipelineLayout);
+    if (!initialized)
+        return;
+
+    auto it = std::find(setLayouts.begin(), setLayouts.end(), setLayout);
+    if (it != setLayouts.end())
+        bindlessLayouts[pipelineLayout] = static_cast<uint32_t>(std::distance(setLayouts.begin(), it));
+}
+
+void QEBindlessMaterials::UnregisterPipelineLayout(VkPipelineLayout pipelineLayout)
+{
+    bindlessLayouts.erase(pipelineLayout);
+    if (passLayout == pipelineLayout)
+        BeginPass();
+}
+
+uint32_t QEBindlessMaterials::AcquireTexture(const std::shared_ptr<CustomTexture>& texture)
+{
+    if (!texture)
+        return NULL_TEXTURE_INDEX;
+
+    auto it = textureIndices.find(texture.get());
+    if (it != textureIndices.end())
+    {
+        textures[it->second].LastUsed = updateCount;
+        return it->second;
+    }
+
+    uint32_t index;
+    if (!freeTextures.empty())
+    {
+        index = freeTextures.back();
+        freeTextures.pop_back();
+    }
+    else if (textures.size() < textureCapacity)
+    {
+        index = static_cast<uint32_t>(textures.size());
+        textures.emplace_back();
+    }
+    else
+    {
+        QE_LOG_WARN_CAT_F("QEBindlessMaterials", "Bindless texture array full ({}): sampling NULL_TEXTURE instead", textureCapacity);
+        return NULL_TEXTURE_INDEX;
+    }
+
+    textures[index] = { texture, updateCount };
+    textureIndices[texture.get()] = index;
+    return index;
+}
+
+void QEBindlessMaterials::ReleaseUnusedTextures()
+{
+    // Ningun material la usa desde hace mas frames de los que hay en vuelo
+    for (uint32_t i = NULL_TEXTURE_INDEX + 1; i < textures.size(); ++i)
+    {
+        TextureEntry& entry = textures[i];
+        if (!entry.Texture || entry.LastUsed + MAX_FRAMES_IN_FLIGHT >= updateCount)
+            continue;
+
+        textureIndices.erase(entry.Texture.get());
+        entry.Texture.reset();
+        freeTextures.push_back(i);
+    }
+}
+
+void QEBindlessMaterials::PackMaterial(MaterialEntry& entry)
+{
+    const MaterialData& data = entry.Material->materialData;
+
+    for (uint32_t slot = 0; slot < SLOT_COUNT; ++slot)
+    {
+        const std::shared_ptr<CustomTexture> texture =
+            (data.texture_vector && slot < data.texture_vector->size()) ? data.texture_vector->at(slot) : nullptr;
+
+        const uint32_t cached = entry.TextureIndices[slot];
+        if (texture && entry.Textures[slot] == texture.get() &&
+            cached < textures.size() && textures[cached].Texture == texture)
+        {
+            textures[cached].LastUsed = updateCount;
+            continue;
+        }
+
+        entry.Textures[slot] = texture.get();
+        entry.TextureIndices[slot] = AcquireTexture(texture);
+    }
+
+    auto textureIndex = [&entry](int slot) -> int32_t
+        {
+            if (slot < 0 || slot >= static_cast<int>(SLOT_COUNT))
+                return static_cast<int32_t>(NULL_TEXTURE_INDEX);
+            return static_cast<int32_t>(entry.TextureIndices[slot]);
+        };
+
+    QEGpuMaterial record{};
+    record.Diffuse = data.Diffuse;
+    record.Ambient = data.Ambient;
+    record.Specular = data.Specular;
+    record.Emissive = data.Emissive;
+    record.Transparent = data.Transparent;
+    record.Reflective = data.Reflective;
+
+    record.idxDiffuse = textureIndex(data.idxDiffuse);
+    record.idxNormal = textureIndex(data.idxNormal);
+    record.idxSpecular = textureIndex(data.idxSpecular);
+    record.idxEmissive = textureIndex(data.idxEmissive);
+    record.idxHeight = textureIndex(data.idxHeight);
+    record.idxMetallic = textureIndex(data.idxMetallic);
+    record.idxRoughness = textureIndex(data.idxRoughness);
+    record.idxAO = textureIndex(data.idxAO);
+
+    record.texMask = data.ResidentTexMask();
+    record.metallicChan = data.MetallicChan;
+    record.roughnessChan = data.RoughnessChan;
+    record.aoChan = data.AOChan;
+    record.AlphaMode = data.AlphaMode;
+
+    record.Opacity = data.Opacity;
+    record.BumpScaling = data.BumpScaling;
+    record.Reflectivity = data.Reflectivity;
+    record.Refractivity = data.Refractivity;
+    record.Shininess = data.Shininess;
+    record.Shininess_Strength = data.Shininess_Strength;
+    record.Metallic = data.Metallic;
+    record.Roughness = data.Roughness;
+    record.AO = data.AO;
+    record.Clearcoat = data.Clearcoat;
+    record.ClearcoatRoughness = data.ClearcoatRoughness;
+    record.AlphaCutoff = data.AlphaCutoff;
+
+    if (std::memcmp(&record, &entry.Record, sizeof(QEGpuMaterial)) != 0)
+    {
+        entry.Record = record;
+        entry.Version = ++versionCounter;
+    }
+}
+
+void QEBindlessMaterials::EnsureCapacity(FrameSlot& frame)
+{
+    const uint32_t required = static_cast<uint32_t>(materials.size());
+    if (frame.Buffer != VK_NULL_HANDLE && frame.Capacity >= required)
+        return;
+
+    uint32_t capacity = std::max(frame.Capacity, MIN_MATERIAL_CAPACITY);
+    while (capacity < required)
+        capacity *= 2;
+
+    // El slot ya no esta en uso en la GPU, pero la liberacion diferida cubre cualquier otra referencia
+    if (frame.Buffer != VK_NULL_HANDLE)
+    {
+        vkUnmapMemory(deviceModule->device, frame.Memory);
+        QE_DESTROY_BUFFER(deviceModule->device, frame.Buffer, "QEBindlessMaterials::EnsureCapacity");
+        QE_FREE_MEMORY(deviceModule->device, frame.Memory, "QEBindlessMaterials::EnsureCapacity");
+    }
+
+    const VkDeviceSize size = static_cast<VkDeviceSize>(capacity) * sizeof(QEGpuMaterial);
+    BufferManageModule::createBuffer(
+        size,
+        VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+        frame.Buffer,
+        frame.Memory,
+        *deviceModule);
+
+    void* mapped = nullptr;
+    vkMapMemory(deviceModule->device, frame.Memory, 0, size, 0, &mapped);
+    frame.Mapped = static_cast<QEGpuMaterial*>(mapped);
+    frame.Capacity = capacity;
+    frame.WrittenVersions.assign(capacity, 0);
+
+    VkDescriptorBufferInfo bufferInfo{};
+    bufferInfo.buffer = frame.Buffer;
+    bufferInfo.offset = 0;
+    bufferInfo.range = VK_WHOLE_SIZE;
+
+    VkWriteDescriptorSet write{};
+    write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    write.dstSet = frame.DescriptorSet;
+    write.dstBinding = 0;
+    write.dstArrayElement = 0;
+    write.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    write.descriptorCount = 1;
+    write.pBufferInfo = &bufferInfo;
+    vkUpdateDescriptorSets(deviceModule->device, 1, &write, 0, nullptr);
+}
+
+void QEBindlessMaterials::WriteTextureDescriptors(FrameSlot& frame)
+{
+    if (frame.WrittenImages.size() < textures.size())
+        frame.WrittenImages.resize(textures.size());
+
+    const CustomTexture* nullTexture = textures[NULL_TEXTURE_INDEX].Texture.get();
+
+    std::vector<uint32_t> dirty;
+    std::vector<VkDescriptorImageInfo> imageInfos;
+
+    for (uint32_t i = 0; i < textures.size(); ++i)
+    {
+        const CustomTexture* texture = textures[i].Texture.get();
+        if (!texture)
+            continue;
+
+        // El streaming cambia la vista al adoptar otra cadena de mips: se reescribe solo
+        if (texture->imageView == VK_NULL_HANDLE || texture->textureSampler == VK_NULL_HANDLE)
+            texture = nullTexture;
+
+        WrittenImage& written = frame.WrittenImages[i];
+        if (written.View == texture->imageView && written.Sampler == texture->textureSampler)
+            continue;
+
+        written.View = texture->imageView;
+        written.Sampler = texture->textureSampler;
+
+        VkDescriptorImageInfo imageInfo{};
+        imageInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+        imageInfo.imageView = written.View;
+        imageInfo.sampler = written.Sampler;
+        imageInfos.push_back(imageInfo);
+        dirty.push_back(i);
+    }
+
+    if (dirty.empty())
+        return;
+
+    std::vector<VkWriteDescriptorSet> writes(dirty.size());
+    for (size_t i = 0; i < dirty.size(); ++i)
+    {
+        VkWriteDescriptorSet& write = writes[i];
+        write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        write.dstSet = frame.DescriptorSet;
+        write.dstBinding = 1;
+        write.dstArrayElement = dirty[i];
+        write.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        write.descriptorCount = 1;
+        write.pImageInfo = &imageInfos[i];
+    }
+
+    vkUpdateDescriptorSets(deviceModule->device, static_cast<uint32_t>(writes.size()), writes.data(), 0, nullptr);
+}
+
+void QEBindlessMaterials::Update(uint32_t frameIdx)
+{
+    if (!initialized || frameIdx >= MAX_FRAMES_IN_FLIGHT)
+        return;
+
+    ++updateCount;
+
+    for (auto& entry : materials)
+    {
+        if (entry.Material)
+            PackMaterial(entry);
+    }
+
+    ReleaseUnusedTextures();
+
+    FrameSlot& frame = frames[frameIdx];
+    EnsureCapacity(frame);
+
+    for (uint32_t i = 0; i < materials.size(); ++i)
+    {
+        if (frame.WrittenVersions[i] == materials[i].Version)
+            continue;
+
+        frame.Mapped[i] = materials[i].Record;
+        frame.WrittenVersions[i] = materials[i].Version;
+    }
+
+    WriteTextureDescriptors(frame);
+}
+
+bool QEBindlessMaterials::BindPass(VkCommandBuffer commandBuffer, uint32_t frameIdx, VkPipelineLayout pipelineLayout)
+{
+    auto it = bindlessLayouts.find(pipelineLayout);
+    if (it == bindlessLayouts.end() || frameIdx >= MAX_FRAMES_IN_FLIGHT)
+        return false;
+
+    if (passCommandBuffer == commandBuffer && passLayout == pipelineLayout)
+        return true;
+
+    vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, it->second, 1, &frames[frameIdx].DescriptorSet, 0, nullptr);
+    passCommandBuffer = commandBuffer;
+    passLayout = pipelineLayout;
+    return false;
+}
@@ -0,0 +1,199 @@
+#pragma once
+
+#ifndef QE_BINDLESS_MATERIALS_H
+#define QE_BINDLESS_MATERIALS_H
+
+#include <vulkan/vulkan.hpp>
+#include <glm/glm.hpp>
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <QESingleton.h>
+#include <SynchronizationModule.h>
+
+class DeviceModule;
+class CustomTexture;
+class DescriptorBuffer;
+class QEMaterial;
+class ShaderModule;
+
+/// Registro de la tabla de materiales; mismo layout std430 que QEPBRMaterialData en los shaders.
+struct QEGpuMaterial
+{
+    glm::vec4 Diffuse;
+    glm::vec4 Ambient;
+    glm::vec4 Specular;
+    glm::vec4 Emissive;
+    glm::vec4 Transparent;
+    glm::vec4 Reflective;
+
+    // Indices en QE_BindlessTextures (no slots del material)
+    int32_t idxDiffuse;
+    int32_t idxNormal;
+    int32_t idxSpecular;
+    int32_t idxEmissive;
+    int32_t idxHeight;
+    int32_t idxMetallic;
+    int32_t idxRoughness;
+    int32_t idxAO;
+
+    uint32_t texMask;
+    uint32_t metallicChan;
+    uint32_t roughnessChan;
+    uint32_t aoChan;
+    uint32_t AlphaMode;
+
+    float Opacity;
+    float BumpScaling;
+    float Reflectivity;
+    float Refractivity;
+    float Shininess;
+    float Shininess_Strength;
+    float Metallic;
+    float Roughness;
+    float AO;
+    float Clearcoat;
+    float ClearcoatRoughness;
+    float AlphaCutoff;
+
+    uint32_t padding[3];
+};
+
+static_assert(sizeof(QEGpuMaterial) == 208, "QEGpuMaterial must match the std430 stride of QEPBRMaterialData");
+
+/// Ruta bindless de materiales (VK_EXT_descriptor_indexing). Todos los materiales viven en un SSBO
+/// indexado por su id (QE_MaterialTable) y todas sus texturas en un unico array de samplers
+/// parcialmente enlazado (QE_BindlessTextures). Los shaders que declaran ese set usan el layout global
+/// de esta clase y un set 0 compartido por shader, asi que un pase enlaza sus sets una vez y cada draw
+/// solo cambia el indice de material en los push constants.
+/// Cada frame en vuelo tiene su propia copia de la tabla y del set: Update() solo escribe la del slot
+/// cuyo fence ya se ha esperado, y solo los registros y descriptores que han cambiado (incluidas las
+/// imagenes sustituidas por el streaming de texturas).
+class QEBindlessMaterials : public QESingleton<QEBindlessMaterials>
+{
+private:
+    friend class QESingleton<QEBindlessMaterials>;
+
+    static constexpr uint32_t NULL_TEXTURE_INDEX = 0;
+    static constexpr uint32_t DEFAULT_MATERIAL_INDEX = 0;
+    static constexpr uint32_t SLOT_COUNT = 8;
+
+    struct MaterialEntry
+    {
+        QEMaterial* Material = nullptr;
+        QEGpuMaterial Record{};
+        uint64_t Version = 0;
+        std::array<const CustomTexture*, SLOT_COUNT> Textures{};
+        std::array<uint32_t, SLOT_COUNT> TextureIndices{};
+    };
+
+    struct TextureEntry
+    {
+        std::shared_ptr<CustomTexture> Texture;
+        uint64_t LastUsed = 0;
+    };
+
+    struct WrittenImage
+    {
+        VkImageView View = VK_NULL_HANDLE;
+        VkSampler Sampler = VK_NULL_HANDLE;
+    };
+
+    struct FrameSlot
+    {
+        VkBuffer Buffer = VK_NULL_HANDLE;
+        VkDeviceMemory Memory = VK_NULL_HANDLE;
+        QEGpuMaterial* Mapped = nullptr;
+        uint32_t Capacity = 0;
+        std::vector<uint64_t> WrittenVersions;
+        std::vector<WrittenImage> WrittenImages;
+        VkDescriptorSet DescriptorSet = VK_NULL_HANDLE;
+    };
+
+    DeviceModule* deviceModule = nullptr;
+    bool initialized = false;
+    bool updateAfterBind = false;
+    uint32_t textureCapacity = 0;
+
+    VkDescriptorSetLayout setLayout = VK_NULL_HANDLE;
+    VkDescriptorPool descriptorPool = VK_NULL_HANDLE;
+    std::array<FrameSlot, MAX_FRAMES_IN_FLIGHT> frames;
+
+    std::vector<MaterialEntry> materials;
+    std::vector<uint32_t> freeMaterials;
+    uint64_t versionCounter = 0;
+
+    std::vector<TextureEntry> textures;
+    std::unordered_map<const CustomTexture*, uint32_t> textureIndices;
+    std::vector<uint32_t> freeTextures;
+    uint64_t updateCount = 0;
+
+    std::unordered_map<VkPipelineLayout, uint32_t> bindlessLayouts;
+    std::unordered_map<const ShaderModule*, std::pair<std::weak_ptr<ShaderModule>, std::shared_ptr<DescriptorBuffer>>> sharedDescriptors;
+
+    // Lo enlazado en el pase en curso
+    VkCommandBuffer passCommandBuffer = VK_NULL_HANDLE;
+    VkPipelineLayout passLayout = VK_NULL_HANDLE;
+
+private:
+    QEBindlessMaterials() = default;
+
+    void CreateSetLayout();
+    void CreateDescriptorSets();
+    void EnsureCapacity(FrameSlot& frame);
+    uint32_t AcquireTexture(const std::shared_ptr<CustomTexture>& texture);
+    void ReleaseUnusedTextures();
+    void PackMaterial(MaterialEntry& entry);
+    void WriteTextureDescriptors(FrameSlot& frame);
+
+public:
+    static constexpr uint32_t MAX_TEXTURES = 4096;
+
+    // Si es false, MaterialManager crea los shaders por defecto con la ruta de un set por material
+    static bool Enabled;
+
+    /// Tras crear el dispositivo y TextureManager, antes de crear los shaders.
+    void Initialize();
+    void Cleanup();
+
+    bool IsAvailable() const { return Enabled && initialized; }
+    VkDescriptorSetLayout GetSetLayout() const { return setLayout; }
+    uint32_t GetTextureCapacity() const { return textureCapacity; }
+    uint32_t GetMaterialCount() const;
+    uint32_t GetTextureCount() const { return static_cast<uint32_t>(textures.size() - freeTextures.size()); }
+
+    uint32_t RegisterMaterial(QEMaterial* material);
+    void UnregisterMaterial(const QEMaterial* material, uint32_t index);
+    /// DEFAULT_MATERIAL_INDEX si el material no esta registrado.
+    uint32_t GetMaterialIndex(const QEMaterial* material, uint32_t index) const;
+
+    /// Set 0 unico para todos los materiales de un shader bindless.
+    std::shared_ptr<DescriptorBuffer> GetSharedDescriptor(const std::shared_ptr<ShaderModule>& shader);
+
+    /// Pipeline layouts que usan el layout global; los registran los pipeline modules al crearlos.
+    void RegisterPipelineLayout(VkPipelineLayout pipelineLayout, const std::vector<VkDescriptorSetLayout>& setLayouts);
+    void UnregisterPipelineLayout(VkPipelineLayout pipelineLayout);
+    bool IsBindlessLayout(VkPipelineLayout pipelineLayout) const { return bindlessLayouts.contains(pipelineLayout); }
+
+    /// Hilo principal, tras esperar el fence del slot y antes de grabar sus comandos.
+    void Update(uint32_t frameIdx);
+
+    /// Olvida lo enlazado; al empezar cada pase o tras enlazar sets con otro layout.
+    void BeginPass() { passCommandBuffer = VK_NULL_HANDLE; passLayout = VK_NULL_HANDLE; }
+    /// Enlaza el set bindless si 'pipelineLayout' lo usa y no estaba ya enlazado en el pase.
+    /// Devuelve true si ya estaba enlazado (no hace falta enlazar el resto de sets).
+    bool BindPass(VkCommandBuffer commandBuffer, uint32_t frameIdx, VkPipelineLayout pipelineLayout);
+};
+
+
+
+namespace QE
+{
+    using ::QEGpuMaterial;
+    using ::QEBindlessMaterials;
+} // namespace QE
+// QE namespace aliases
+#endif // !QE_BINDLESS_MATERIALS_H
@@ -0,0 +1,323 @@
+#include "QEKtxTranscodeCache.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <format>
+#include <fstream>
+#include <mutex>
+#include <thread>
+#include <QEProjectManager.h>
+#include <Helpers/HashHelpers.h>
+#include <Logging/QELogMacros.h>
+
+bool QEKtxTranscodeCache::Enabled = true;
+
+namespace
+{
+    struct CacheHeader
+    {
+        uint32_t Magic = 0;
+        uint32_t Version = 0;
+        uint64_t SourceHash = 0;
+        uint64_t SourceSize = 0;
+        uint32_t KtxFormat = 0;
+        uint32_t VkFormat = 0;
+        uint32_t Caps = 0;
+        uint32_t Width = 0;
+        uint32_t Height = 0;
+        uint32_t LevelCount = 0;
+        uint64_t DataOffset = 0;
+        uint64_t DataSize = 0;
+    };
+
+    struct CacheLevel
+    {
+        uint64_t Offset = 0;
+        uint64_t Size = 0;
+    };
+
+    constexpr uint64_t DATA_ALIGNMENT = 16;
+    constexpr uint8_t KTX2_IDENTIFIER[12] = { 0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n' };
+    constexpr size_t KTX2_VKFORMAT_OFFSET = 12;
+
+    enum CacheCaps : uint32_t
+    {
+        CAPS_BC = 1u << 0
+    };
+
+    // La primera transcodificacion inicializa tablas globales de basisu: no es segura en paralelo
+    std::mutex basisInitMutex;
+    std::atomic<bool> basisReady{ false };
+
+    std::atomic<uint32_t> hits{ 0 };
+    std::atomic<uint32_t> misses{ 0 };
+    std::atomic<uint32_t> writes{ 0 };
+    std::atomic<uint64_t> bytesMapped{ 0 };
+    std::atomic<uint64_t> bytesWritten{ 0 };
+    std::atomic<uint64_t> transcodeMicroseconds{ 0 };
+
+    // Basis (ETC1S/UASTC) se guarda con vkFormat VK_FORMAT_UNDEFINED; se mira sin pasar por libktx
+    bool IsBasisKtx2(const QEMappedFile& source)
+    {
+        if (source.Size() < KTX2_VKFORMAT_OFFSET + sizeof(uint32_t))
+            return false;
+
+        if (memcmp(source.Data(), KTX2_IDENTIFIER, sizeof(KTX2_IDENTIFIER)) != 0)
+            return false;
+
+        uint32_t vkFormat = 0;
+        memcpy(&vkFormat, source.Data() + KTX2_VKFORMAT_OFFSET, sizeof(vkFormat));
+        return vkFormat == VK_FORMAT_UNDEFINED;
+    }
+
+    KTX_error_code TranscodeBasis(ktxTexture2* kTexture, ktx_transcode_fmt_e format)
+    {
+        if (basisReady.load())
+            return ktxTexture2_TranscodeBasis(kTexture, format, 0);
+
+        std::lock_guard<std::mutex> lock(basisInitMutex);
+        const KTX_error_code result = ktxTexture2_TranscodeBasis(kTexture, format, 0);
+        basisReady = true;
+        return result;
+    }
+}
+
+fs::path QEKtxTranscodeCache::GetCacheFolder()
+{
+    const fs::path cacheRoot = QEProjectManager::GetCacheFolderPath();
+    if (cacheRoot.empty())
+        return {};
+
+    return cacheRoot / "Textures";
+}
+
+void QEKtxTranscodeCache::Load(const std::string& path, QEColorSpace cs, bool bcSupported, QEKtxPayload& out)
+{
+    out = QEKtxPayload{};
+
+    QEMappedFile source;
+    if (!source.Open(path))
+        throw std::runtime_error("Failed to load KTX2 texture: " + path);
+
+    const KtxTranscodeSelection selection = CustomTexture::SelectKtxTranscodeFormat(cs, bcSupported);
+    const uint32_t caps = bcSupported ? CAPS_BC : 0u;
+
+    const bool basis = IsBasisKtx2(source);
+    const fs::path cacheFolder = (Enabled && basis) ? GetCacheFolder() : fs::path();
+    const uint64_t sourceSize = static_cast<uint64_t>(source.Size());
+    uint64_t sourceHash = 0;
+    fs::path cachePath;
+
+    if (!cacheFolder.empty())
+    {
+        sourceHash = QEHelper::HashBytes(source.Data(), source.Size());
+        cachePath = cacheFolder / std::format("{:016x}-{}-{}.qetc", sourceHash, static_cast<uint32_t>(selection.vkFormat), caps);
+
+        if (TryLoadCached(cachePath, sourceHash, sourceSize, selection, caps, out))
+        {
+            ++hits;
+            bytesMapped += out.DataSize;
+            QE_LOG_DEBUG_CAT_F("QEKtxTranscodeCache", "Hit {} -> {}", path, cachePath.filename().string());
+            return;
+        }
+
+        ++misses;
+    }
+
+    ktxTexture2* kTexture = nullptr;
+    KTX_error_code result = ktxTexture2_CreateFromMemory(source.Data(), source.Size(), KTX_TEXTURE_CREATE_LOAD_IMAGE_DATA_BIT, &kTexture);
+    if (result != KTX_SUCCESS || !kTexture)
+        throw std::runtime_error("Failed to load KTX2 texture: " + path);
+
+    VkFormat format = static_cast<VkFormat>(kTexture->vkFormat);
+    const bool transcoded = ktxTexture2_NeedsTranscoding(kTexture);
+    if (transcoded)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        result = TranscodeBasis(kTexture, selection.ktxFormat);
+        transcodeMicroseconds += static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
+
+        if (result != KTX_SUCCESS)
+        {
+            ktxTexture_Destroy(ktxTexture(kTexture));
+            throw std::runtime_error("Failed to transcode KTX2 texture: " + path);
+        }
+
+        format = selection.vkFormat;
+    }
+
+    const ktx_size_t dataSize = ktxTexture_GetDataSize(ktxTexture(kTexture));
+    const ktx_uint8_t* data = ktxTexture_GetData(ktxTexture(kTexture));
+    if (format == VK_FORMAT_UNDEFINED || !data || dataSize == 0)
+    {
+        ktxTexture_Destroy(ktxTexture(kTexture));
+        throw std::runtime_error("KTX2 texture has no usable data: " + path);
+    }
+
+    out.Format = format;
+    out.Width = kTexture->baseWidth;
+    out.Height = kTexture->baseHeight;
+    out.Levels.reserve(kTexture->numLevels);
+    for (uint32_t level = 0; level < kTexture->numLevels; ++level)
+    {
+        ktx_size_t offset = 0;
+        if (ktxTexture_GetImageOffset(ktxTexture(kTexture), level, 0, 0, &offset) != KTX_SUCCESS)
+        {
+            ktxTexture_Destroy(ktxTexture(kTexture));
+            throw std::runtime_error("Failed to get KTX2 mip offset: " + path);
+        }
+
+        QEKtxLevel ktxLevel;
+        ktxLevel.Offset = static_cast<uint64_t>(offset);
+        ktxLevel.Size = static_cast<uint64_t>(ktxTexture_GetImageSize(ktxTexture(kTexture), level));
+        ktxLevel.Width = std::max(1u, out.Width >> level);
+        ktxLevel.Height = std::max(1u, out.Height >> level);
+        out.Levels.push_back(ktxLevel);
+    }
+
+    out.Owned.assign(data, data + dataSize);
+    out.DataSize = static_cast<uint64_t>(dataSize);
+    ktxTexture_Destroy(ktxTexture(kTexture));
+
+    if (transcoded && !cachePath.empty())
+    {
+        Save(cachePath, sourceHash, sourceSize, selection, caps, out);
+    }
+}
+
+bool QEKtxTranscodeCache::TryLoadCached(const fs::path& cachePath, uint64_t sourceHash, uint64_t sourceSize, const KtxTranscodeSelection& selection, uint32_t caps, QEKtxPayload& out)
+{
+    QEMappedFile file;
+    if (!file.Open(cachePath) || file.Size() < sizeof(CacheHeader))
+        return false;
+
+    CacheHeader header;
+    memcpy(&header, file.Data(), sizeof(header));
+
+    const uint64_t levelsEnd = sizeof(CacheHeader) + static_cast<uint64_t>(header.LevelCount) * sizeof(CacheLevel);
+    if (header.Magic != CACHE_MAGIC ||
+        header.Version != CACHE_VERSION ||
+        header.SourceHash != sourceHash ||
+        header.SourceSize != sourceSize ||
+        header.KtxFormat != static_cast<uint32_t>(selection.ktxFormat) ||
+        header.VkFormat != static_cast<uint32_t>(selection.vkFormat) ||
+        header.Caps != caps ||
+        header.LevelCount == 0 ||
+        levelsEnd > file.Size() ||
+        header.DataOffset < levelsEnd ||
+        header.DataOffset + header.DataSize > file.Size())
+    {
+        return false;
+    }
+
+    std::vector<QEKtxLevel> levels(header.LevelCount);
+    for (uint32_t level = 0; level < header.LevelCount; ++level)
+    {
+        CacheLevel cached;
+        memcpy(&cached, file.Data() + sizeof(CacheHeader) + level * sizeof(CacheLevel), sizeof(cached));
+        if (cached.Offset + cached.Size > header.DataSize)
+            return false;
+
+        levels[level].Offset = cached.Offset;
+        levels[level].Size = cached.Size;
+        levels[level].Width = std::max(1u, header.Width >> level);
+        levels[level].Height = std::max(1u, header.Height >> level);
+    }
+
+    out.Format = selection.vkFormat;
+    out.Width = header.Width;
+    out.Height = header.Height;
+    out.Levels = std::move(levels);
+    out.FromCache = true;
+    out.MappedOffset = header.DataOffset;
+    out.DataSize = header.DataSize;
+    out.Mapped = std::move(file);
+    return true;
+}
+
+void QEKtxTranscodeCache::Save(const fs::path& cachePath, uint64_t sourceHash, uint64_t sourceSize, const KtxTranscodeSelection& selection, uint32_t caps, const QEKtxPayload& payload)
+{
+    std::error_code ec;
+    fs::create_directories(cachePath.parent_path(), ec);
+
+    // Temporal por hilo y renombrado: dos hilos con la misma textura no se pisan
+    fs::path tempPath = cachePath;
+    tempPath += std::format(".{}.tmp", std::hash<std::thread::id>{}(std::this_thread::get_id()));
+
+    CacheHeader header;
+    header.Magic = CACHE_MAGIC;
+    header.Version = CACHE_VERSION;
+    header.SourceHash = sourceHash;
+    header.SourceSize = sourceSize;
+    header.KtxFormat = static_cast<uint32_t>(selection.ktxFormat);
+    header.VkFormat = static_cast<uint32_t>(selection.vkFormat);
+    header.Caps = caps;
+    header.Width = payload.Width;
+    header.Height = payload.Height;
+    header.LevelCount = static_cast<uint32_t>(payload.Levels.size());
+
+    const uint64_t levelsEnd = sizeof(CacheHeader) + static_cast<uint64_t>(header.LevelCount) * sizeof(CacheLevel);
+    header.DataOffset = (levelsEnd + DATA_ALIGNMENT - 1) / DATA_ALIGNMENT * DATA_ALIGNMENT;
+    header.DataSize = payload.Size();
+
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (!file.is_open())
+        {
+            QE_LOG_WARN_CAT_F("QEKtxTranscodeCache", "Could not write texture cache {}", cachePath.string());
+            return;
+        }
+
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        for (const QEKtxLevel& level : payload.Levels)
+        {
+            const CacheLevel cached{ level.Offset, level.Size };
+            file.write(reinterpret_cast<const char*>(&cached), sizeof(cached));
+        }
+
+        const char padding[DATA_ALIGNMENT] = {};
+        file.write(padding, static_cast<std::streamsize>(header.DataOffset - levelsEnd));
+        file.write(reinterpret_cast<const char*>(payload.Data()), static_cast<std::streamsize>(payload.Size()));
+
+        if (!file)
+        {
+            file.close();
+            fs::remove(tempPath, ec);
+            QE_LOG_WARN_CAT_F("QEKtxTranscodeCache", "Could not write texture cache {}", cachePath.string());
+            return;
+        }
+    }
+
+    fs::rename(tempPath, cachePath, ec);
+    if (ec)
+    {
+        fs::remove(tempPath, ec);
+        return;
+    }
+
+    ++writes;
+    bytesWritten += header.DataOffset + header.DataSize;
+}
+
+QEKtxTranscodeCacheStats QEKtxTranscodeCache::GetStats()
+{
+    QEKtxTranscodeCacheStats stats;
+    stats.Hits = hits.load();
+    stats.Misses = misses.load();
+    stats.Writes = writes.load();
+    stats.BytesMapped = bytesMapped.load();
+    stats.BytesWritten = bytesWritten.load();
+    stats.TranscodeMs = static_cast<double>(transcodeMicroseconds.load()) / 1000.0;
+    return stats;
+}
+
+void QEKtxTranscodeCache::LogStats()
+{
+    const QEKtxTranscodeCacheStats stats = GetStats();
+    if (stats.Hits == 0 && stats.Misses == 0)
+        return;
+
+    QE_LOG_INFO_CAT_F("QEKtxTranscodeCache", "KTX2 transcode cache: {} hits, {} misses ({:.1f} ms transcoding), {} written ({} KB), {} KB mapped",
+        stats.Hits, stats.Misses, stats.TranscodeMs, stats.Writes, stats.BytesWritten / 1024, stats.BytesMapped / 1024);
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#ifndef QE_KTX_TRANSCODE_CACHE_H
+#define QE_KTX_TRANSCODE_CACHE_H
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+#include <vulkan/vulkan.hpp>
+#include <CustomTexture.h>
+#include <QEMappedFile.h>
+
+namespace fs = std::filesystem;
+
+struct QEKtxLevel
+{
+    uint64_t Offset = 0;
+    uint64_t Size = 0;
+    uint32_t Width = 0;
+    uint32_t Height = 0;
+};
+
+/// Mips de un KTX2 listos para copiar a la GPU, desde la cache mapeada o transcodificados en memoria.
+struct QEKtxPayload
+{
+    VkFormat Format = VK_FORMAT_UNDEFINED;
+    uint32_t Width = 0;
+    uint32_t Height = 0;
+    std::vector<QEKtxLevel> Levels;
+    bool FromCache = false;
+
+    QEMappedFile Mapped;
+    uint64_t MappedOffset = 0;
+    uint64_t DataSize = 0;
+    std::vector<uint8_t> Owned;
+
+    const uint8_t* Data() const { return Mapped.IsOpen() ? Mapped.Data() + MappedOffset : Owned.data(); }
+    uint64_t Size() const { return DataSize; }
+};
+
+struct QEKtxTranscodeCacheStats
+{
+    uint32_t Hits = 0;
+    uint32_t Misses = 0;
+    uint32_t Writes = 0;
+    uint64_t BytesMapped = 0;
+    uint64_t BytesWritten = 0;
+    double TranscodeMs = 0.0;       // Tiempo total transcodificando en los fallos
+};
+
+/// Cache en disco de KTX2 Basis (ETC1S/UASTC) ya transcodificados. La clave es el hash del archivo
+/// fuente, el formato destino y las capacidades del dispositivo que lo eligieron; se guarda en
+/// <proyecto>/QECache/Textures y un acierto mapea el archivo sin pasar por libktx. Los KTX2 que no
+/// necesitan transcodificar se cargan tal cual. Se puede usar desde varios hilos a la vez.
+class QEKtxTranscodeCache
+{
+public:
+    static constexpr uint32_t CACHE_MAGIC = 0x43544551;      // "QETC"
+    static constexpr uint32_t CACHE_VERSION = 1;
+
+    static bool Enabled;
+
+    /// Lanza std::runtime_error si el KTX2 no se puede leer o transcodificar.
+    static void Load(const std::string& path, QEColorSpace cs, bool bcSupported, QEKtxPayload& out);
+
+    static fs::path GetCacheFolder();
+    static QEKtxTranscodeCacheStats GetStats();
+    static void LogStats();
+
+private:
+    static bool TryLoadCached(const fs::path& cachePath, uint64_t sourceHash, uint64_t sourceSize, const KtxTranscodeSelection& selection, uint32_t caps, QEKtxPayload& out);
+    static void Save(const fs::path& cachePath, uint64_t sourceHash, uint64_t sourceSize, const KtxTranscodeSelection& selection, uint32_t caps, const QEKtxPayload& payload);
+};
+
+
+
+namespace QE
+{
+    using ::QEKtxLevel;
+    using ::QEKtxPayload;
+    using ::QEKtxTranscodeCacheStats;
+    using ::QEKtxTranscodeCache;
+} // namespace QE
+// QE namespace aliases
+#endif // !QE_KTX_TRANSCODE_CACHE_H
@@ -22,6 +22,20 @@ namespace
 
         return value;
     }
+
+    bool HasBinding(const ReflectShader& reflect, const std::string& name)
+    {
+        for (const auto& set : reflect.bindings)
+        {
+            for (const auto& binding : set.second)
+            {
+                if (binding.second.name == name)
+                    return true;
+            }
+        }
+
+        return false;
+    }
 }
 
 bool QEShaderAssetLoader::IsShaderAssetPath(const fs::path& path)
@@ -80,6 +94,12 @@ std::shared_ptr<ShaderModule> QEShaderAssetLoader::LoadShaderAsset(const fs::pat
 
             shaderModule = std::make_shared<ShaderModule>(
                 ShaderModule(shaderId, taskPath.string(), meshPath.string(), fragmentPath.string(), pipelineData));
+
+            // Un task shader compilado antes del culling de meshlets no declara el bloque MeshletCulling
+            if (!taskPath.empty() && !HasBinding(shaderModule->reflectShader, "MeshletCulling"))
+            {
+                QE_LOG_WARN_CAT_F("QEShaderAssetLoader", "{} has no MeshletCulling buffer: meshlets are drawn unculled (rebuild the SPIR-V if it comes from Mesh/mesh.task)", taskPath.string());
+            }
         }
         else if (!asset.Stages.Geometry.empty())
         {
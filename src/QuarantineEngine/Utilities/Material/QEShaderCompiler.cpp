@@ -0,0 +1,826 @@
+#include "QEShaderCompiler.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <Windows.h>
+#endif
+
+#ifdef QE_WITH_SHADERC
+#include <shaderc/shaderc.hpp>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <cstdlib>
+#include <format>
+#include <fstream>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+#include <yaml-cpp/yaml.h>
+
+#include <Helpers/HashHelpers.h>
+#include <Logging/QELogMacros.h>
+
+namespace
+{
+    // Cambiarlo invalida todos los .d (y recompila todo) si cambia la forma de compilar
+    constexpr uint32_t COMPILER_VERSION = 1;
+    constexpr const char* OPTIONS_TAG = "# QE_SHADER_OPTIONS ";
+
+    std::string ToLower(std::string value)
+    {
+        std::transform(
+            value.begin(),
+            value.end(),
+            value.begin(),
+            [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+
+        return value;
+    }
+
+    const char* TargetEnvName(QEShaderTargetEnv targetEnv)
+    {
+        switch (targetEnv)
+        {
+        case QEShaderTargetEnv::Vulkan1_1: return "vulkan1.1";
+        case QEShaderTargetEnv::Vulkan1_2: return "vulkan1.2";
+        case QEShaderTargetEnv::Vulkan1_3: return "vulkan1.3";
+        default:                           return "vulkan1.0";
+        }
+    }
+
+    QEShaderTargetEnv ParseTargetEnv(const std::string& name)
+    {
+        if (name == "vulkan1.0") return QEShaderTargetEnv::Vulkan1_0;
+        if (name == "vulkan1.1") return QEShaderTargetEnv::Vulkan1_1;
+        if (name == "vulkan1.2") return QEShaderTargetEnv::Vulkan1_2;
+        if (name == "vulkan1.3") return QEShaderTargetEnv::Vulkan1_3;
+
+        throw std::runtime_error("Unknown shader target environment '" + name + "'.");
+    }
+
+    fs::path DependencyPath(const fs::path& output)
+    {
+        fs::path path = output;
+        path += QEShaderCompiler::DEPENDENCY_EXTENSION;
+        return path;
+    }
+
+    uint64_t OptionsHash(const QEShaderCompileJob& job)
+    {
+        std::string key = std::format("{}|{}|{}", COMPILER_VERSION, job.Source.lexically_normal().generic_string(), TargetEnvName(job.TargetEnv));
+        for (const auto& define : job.Defines)
+        {
+            key += '|';
+            key += define;
+        }
+
+        return QEHelper::HashBytes(key.data(), key.size());
+    }
+
+    std::shared_ptr<const std::string> ReadTextFile(const fs::path& path)
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (!file.is_open())
+            return nullptr;
+
+        std::ostringstream content;
+        content << file.rdbuf();
+        return std::make_shared<const std::string>(content.str());
+    }
+
+    // ---- Cache de includes ----
+    // Cada include se lee una vez para todas las compilaciones; solo se vuelve a leer si cambia su fecha.
+
+    struct CachedInclude
+    {
+        fs::file_time_type WriteTime;
+        std::shared_ptr<const std::string> Content;
+    };
+
+    std::shared_mutex includeMutex;
+    std::unordered_map<std::string, CachedInclude> includeCache;
+
+    // ---- Archivo de dependencias (formato make, el mismo que glslc -MD) ----
+
+    std::string EscapeMakePath(const fs::path& path)
+    {
+        std::string escaped;
+        for (char c : path.generic_string())
+        {
+            if (c == ' ')
+                escaped += '\\';
+            escaped += c;
+        }
+        return escaped;
+    }
+
+    bool ReadDependencyFile(const fs::path& depPath, uint64_t* optionsHash, std::vector<fs::path>& dependencies)
+    {
+        std::ifstream file(depPath, std::ios::binary);
+        if (!file.is_open())
+            return false;
+
+        std::string rule;
+        std::string line;
+        bool hasHash = false;
+        while (std::getline(file, line))
+        {
+            if (!line.empty() && line.back() == '\r')
+                line.pop_back();
+
+            if (line.rfind(OPTIONS_TAG, 0) == 0)
+            {
+                if (optionsHash)
+                {
+                    try
+                    {
+                        *optionsHash = std::stoull(line.substr(std::char_traits<char>::length(OPTIONS_TAG)), nullptr, 16);
+                        hasHash = true;
+                    }
+                    catch (const std::exception&)
+                    {
+                        return false;
+                    }
+                }
+                continue;
+            }
+
+            if (!line.empty() && line.front() == '#')
+                continue;
+
+            rule += line;
+            rule += '\n';
+        }
+
+        if (optionsHash && !hasHash)
+            return false;
+
+        // Tokens separados por espacios; "\ " es un espacio dentro de una ruta y "\<salto>" continua la regla
+        bool targetSeen = false;
+        std::string token;
+        auto flush = [&]()
+            {
+                if (token.empty())
+                    return;
+
+                if (!targetSeen)
+                {
+                    if (token.back() == ':')
+                        targetSeen = true;
+                }
+                else if (token != ":")
+                {
+                    dependencies.emplace_back(token);
+                }
+                token.clear();
+            };
+
+        for (size_t i = 0; i < rule.size(); ++i)
+        {
+            const char c = rule[i];
+            if (c == '\\' && i + 1 < rule.size() && rule[i + 1] == ' ')
+            {
+                token += ' ';
+                ++i;
+            }
+            else if (c == '\\' && i + 1 < rule.size() && rule[i + 1] == '\n')
+            {
+                flush();
+                ++i;
+            }
+            else if (std::isspace(static_cast<unsigned char>(c)))
+            {
+                flush();
+            }
+            else
+            {
+                token += c;
+            }
+        }
+        flush();
+
+        return targetSeen && !dependencies.empty();
+    }
+
+#ifdef QE_WITH_SHADERC
+    shaderc_shader_kind ShaderKind(const std::string& stage)
+    {
+        if (stage == "vert") return shaderc_vertex_shader;
+        if (stage == "frag") return shaderc_fragment_shader;
+        if (stage == "geom") return shaderc_geometry_shader;
+        if (stage == "tesc") return shaderc_tess_control_shader;
+        if (stage == "tese") return shaderc_tess_evaluation_shader;
+        if (stage == "comp") return shaderc_compute_shader;
+        if (stage == "task") return shaderc_task_shader;
+        return shaderc_mesh_shader;
+    }
+
+    shaderc_env_version ShaderEnvVersion(QEShaderTargetEnv targetEnv)
+    {
+        switch (targetEnv)
+        {
+        case QEShaderTargetEnv::Vulkan1_1: return shaderc_env_version_vulkan_1_1;
+        case QEShaderTargetEnv::Vulkan1_2: return shaderc_env_version_vulkan_1_2;
+        case QEShaderTargetEnv::Vulkan1_3: return shaderc_env_version_vulkan_1_3;
+        default:                           return shaderc_env_version_vulkan_1_0;
+        }
+    }
+
+    /// Resuelve los #include desde la cache y apunta cada archivo como dependencia del job.
+    class QEShaderIncluder final : public shaderc::CompileOptions::IncluderInterface
+    {
+    private:
+        struct IncludeData
+        {
+            shaderc_include_result Result{};
+            std::string Name;
+            std::shared_ptr<const std::string> Content;
+            std::string Error;
+        };
+
+        fs::path sourceFolder;
+        std::vector<fs::path>& dependencies;
+
+    public:
+        QEShaderIncluder(const fs::path& sourceFolder, std::vector<fs::path>& dependencies)
+            : sourceFolder(sourceFolder), dependencies(dependencies)
+        {
+        }
+
+        shaderc_include_result* GetInclude(
+            const char* requestedSource,
+            shaderc_include_type type,
+            const char* requestingSource,
+            size_t) override
+        {
+            const fs::path baseFolder = type == shaderc_include_type_relative
+                ? fs::path(requestingSource).parent_path()
+                : sourceFolder;
+            const fs::path resolved = (baseFolder / requestedSource).lexically_normal();
+
+            auto* data = new IncludeData();
+            data->Content = QEShaderCompiler::LoadInclude(resolved);
+            if (data->Content)
+            {
+                data->Name = resolved.generic_string();
+                data->Result.content = data->Content->data();
+                data->Result.content_length = data->Content->size();
+                dependencies.push_back(resolved);
+            }
+            else
+            {
+                // source_name vacio indica error; content lleva el mensaje
+                data->Error = std::format("Cannot open include file '{}'", resolved.generic_string());
+                data->Result.content = data->Error.data();
+                data->Result.content_length = data->Error.size();
+            }
+
+            data->Result.source_name = data->Name.data();
+            data->Result.source_name_length = data->Name.size();
+            data->Result.user_data = data;
+            return &data->Result;
+        }
+
+        void ReleaseInclude(shaderc_include_result* result) override
+        {
+            delete static_cast<IncludeData*>(result->user_data);
+        }
+    };
+
+    bool CompileWithShaderc(const QEShaderCompileJob& job, const std::string& stage, std::vector<fs::path>& dependencies, std::string& log)
+    {
+        const auto source = ReadTextFile(job.Source);
+        if (!source)
+        {
+            log = "Could not read shader source " + job.Source.string();
+            return false;
+        }
+
+        shaderc::CompileOptions options;
+        options.SetTargetEnvironment(shaderc_target_env_vulkan, ShaderEnvVersion(job.TargetEnv));
+        options.SetIncluder(std::make_unique<QEShaderIncluder>(job.Source.parent_path(), dependencies));
+        for (const auto& define : job.Defines)
+        {
+            const size_t separator = define.find('=');
+            if (separator == std::string::npos)
+                options.AddMacroDefinition(define);
+            else
+                options.AddMacroDefinition(define.substr(0, separator), define.substr(separator + 1));
+        }
+
+        // Un compilador por llamada: cada hilo de CompileBatch usa el suyo
+        shaderc::Compiler compiler;
+        const std::string sourceName = job.Source.lexically_normal().generic_string();
+        const shaderc::SpvCompilationResult result = compiler.CompileGlslToSpv(
+            source->data(),
+            source->size(),
+            ShaderKind(stage),
+            sourceName.c_str(),
+            "main",
+            options);
+
+        log = result.GetErrorMessages();
+        if (result.GetCompilationStatus() != shaderc_compilation_status_success)
+            return false;
+
+        fs::path tempPath = job.Output;
+        tempPath += ".tmp";
+        {
+            std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+            if (!file.is_open())
+            {
+                log = "Could not write " + job.Output.string();
+                return false;
+            }
+
+            const size_t size = static_cast<size_t>(result.cend() - result.cbegin()) * sizeof(uint32_t);
+            file.write(reinterpret_cast<const char*>(result.cbegin()), static_cast<std::streamsize>(size));
+        }
+
+        std::error_code ec;
+        fs::rename(tempPath, job.Output, ec);
+        if (ec)
+        {
+            fs::remove(tempPath, ec);
+            log = "Could not replace " + job.Output.string();
+            return false;
+        }
+
+        return true;
+    }
+#endif
+
+#ifdef _WIN32
+    fs::path FindGlslcExecutable()
+    {
+        if (const char* vulkanSdk = std::getenv("VULKAN_SDK"))
+        {
+            fs::path candidate = fs::path(vulkanSdk) / "Bin" / "glslc.exe";
+            if (fs::exists(candidate))
+                return candidate;
+        }
+
+        const fs::path sdkRoot = "C:\\VulkanSDK";
+        if (!fs::exists(sdkRoot) || !fs::is_directory(sdkRoot))
+            return {};
+
+        std::vector<fs::path> versions;
+        for (const auto& entry : fs::directory_iterator(sdkRoot))
+        {
+            if (entry.is_directory())
+                versions.push_back(entry.path());
+        }
+
+        std::sort(versions.begin(), versions.end(), std::greater<fs::path>());
+
+        for (const auto& versionPath : versions)
+        {
+            const fs::path candidate = versionPath / "Bin" / "glslc.exe";
+            if (fs::exists(candidate))
+                return candidate;
+        }
+
+        return {};
+    }
+
+    const fs::path& GetGlslcExecutable()
+    {
+        static const fs::path glslcPath = FindGlslcExecutable();
+        return glslcPath;
+    }
+
+    std::wstring QuotePathWide(const fs::path& path)
+    {
+        return L"\"" + path.wstring() + L"\"";
+    }
+
+    std::string ExecuteProcessCaptureOutput(
+        const fs::path& executablePath,
+        const std::wstring& commandLine,
+        int& exitCode)
+    {
+        SECURITY_ATTRIBUTES sa{};
+        sa.nLength = sizeof(SECURITY_ATTRIBUTES);
+        sa.bInheritHandle = TRUE;
+        sa.lpSecurityDescriptor = nullptr;
+
+        HANDLE readPipe = nullptr;
+        HANDLE writePipe = nullptr;
+        if (!CreatePipe(&readPipe, &writePipe, &sa, 0))
+        {
+            exitCode = -1;
+            return "Failed to create output pipe for glslc.";
+        }
+
+        if (!SetHandleInformation(readPipe, HANDLE_FLAG_INHERIT, 0))
+        {
+            CloseHandle(readPipe);
+            CloseHandle(writePipe);
+            exitCode = -1;
+            return "Failed to configure output pipe for glslc.";
+        }
+
+        STARTUPINFOW startupInfo{};
+        startupInfo.cb = sizeof(STARTUPINFOW);
+        startupInfo.dwFlags = STARTF_USESTDHANDLES;
+        startupInfo.hStdInput = GetStdHandle(STD_INPUT_HANDLE);
+        startupInfo.hStdOutput = writePipe;
+        startupInfo.hStdError = writePipe;
+
+        PROCESS_INFORMATION processInfo{};
+        std::vector<wchar_t> commandBuffer(commandLine.begin(), commandLine.end());
+        commandBuffer.push_back(L'\0');
+
+        const BOOL created = CreateProcessW(
+            executablePath.wstring().c_str(),
+            commandBuffer.data(),
+            nullptr,
+            nullptr,
+            TRUE,
+            CREATE_NO_WINDOW,
+            nullptr,
+            nullptr,
+            &startupInfo,
+            &processInfo);
+
+        CloseHandle(writePipe);
+
+        if (!created)
+        {
+            const DWORD lastError = GetLastError();
+            CloseHandle(readPipe);
+            exitCode = static_cast<int>(lastError);
+            return "Failed to launch glslc process.";
+        }
+
+        std::string output;
+        char buffer[512];
+        DWORD bytesRead = 0;
+        while (ReadFile(readPipe, buffer, sizeof(buffer) - 1, &bytesRead, nullptr) && bytesRead > 0)
+        {
+            buffer[bytesRead] = '\0';
+            output.append(buffer, bytesRead);
+        }
+
+        WaitForSingleObject(processInfo.hProcess, INFINITE);
+
+        DWORD processExitCode = 0;
+        if (!GetExitCodeProcess(processInfo.hProcess, &processExitCode))
+            processExitCode = static_cast<DWORD>(-1);
+
+        CloseHandle(processInfo.hThread);
+        CloseHandle(processInfo.hProcess);
+        CloseHandle(readPipe);
+
+        exitCode = static_cast<int>(processExitCode);
+        return output;
+    }
+
+    bool CompileWithGlslc(const QEShaderCompileJob& job, std::vector<fs::path>& dependencies, std::string& log)
+    {
+        const fs::path& glslcPath = GetGlslcExecutable();
+        if (glslcPath.empty())
+        {
+            log = "Could not find glslc.exe. Configure VULKAN_SDK or install the Vulkan SDK.";
+            return false;
+        }
+
+        fs::path glslcDepPath = DependencyPath(job.Output);
+        glslcDepPath += ".glslc";
+
+        std::wostringstream commandLine;
+        commandLine << QuotePathWide(glslcPath)
+            << L" " << QuotePathWide(job.Source)
+            << L" -o " << QuotePathWide(job.Output)
+            << L" -MD -MF " << QuotePathWide(glslcDepPath)
+            << L" --target-env=" << TargetEnvName(job.TargetEnv);
+        for (const auto& define : job.Defines)
+        {
+            commandLine << L" -D" << fs::path(define).wstring();
+        }
+
+        int exitCode = 0;
+        log = ExecuteProcessCaptureOutput(glslcPath, commandLine.str(), exitCode);
+
+        // glslc escribe su propio .d; se reescribe con el hash de opciones
+        const bool hasDependencies = ReadDependencyFile(glslcDepPath, nullptr, dependencies);
+        std::error_code ec;
+        fs::remove(glslcDepPath, ec);
+
+        if (exitCode != 0)
+        {
+            if (log.empty())
+                log = std::format("glslc failed with exit code {}", exitCode);
+            return false;
+        }
+
+        if (!hasDependencies)
+            dependencies.push_back(job.Source);
+
+        return true;
+    }
+#endif
+}
+
+std::string QEShaderCompiler::GetStageSuffix(const fs::path& source)
+{
+    const std::string ext = ToLower(source.extension().string());
+
+    if (ext == ".vert" ||
+        ext == ".frag" ||
+        ext == ".geom" ||
+        ext == ".tesc" ||
+        ext == ".tese" ||
+        ext == ".comp" ||
+        ext == ".task" ||
+        ext == ".mesh")
+    {
+        return ext.substr(1);
+    }
+
+    return {};
+}
+
+bool QEShaderCompiler::HasLibraryBackend()
+{
+#ifdef QE_WITH_SHADERC
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool QEShaderCompiler::IsAvailable()
+{
+#if defined(QE_WITH_SHADERC)
+    return true;
+#elif defined(_WIN32)
+    return !GetGlslcExecutable().empty();
+#else
+    return false;
+#endif
+}
+
+bool QEShaderCompiler::IsUpToDate(const QEShaderCompileJob& job)
+{
+    std::error_code ec;
+    const fs::file_time_type outputTime = fs::last_write_time(job.Output, ec);
+    if (ec)
+        return false;
+
+    uint64_t optionsHash = 0;
+    std::vector<fs::path> dependencies;
+    if (!ReadDependencyFile(DependencyPath(job.Output), &optionsHash, dependencies) || optionsHash != OptionsHash(job))
+        return false;
+
+    dependencies.push_back(job.Source);
+    for (const auto& dependency : dependencies)
+    {
+        const fs::file_time_type dependencyTime = fs::last_write_time(dependency, ec);
+        if (ec || dependencyTime > outputTime)
+            return false;
+    }
+
+    return true;
+}
+
+QEShaderCompileResult QEShaderCompiler::Compile(const QEShaderCompileJob& job, bool force)
+{
+    const auto start = std::chrono::steady_clock::now();
+
+    QEShaderCompileResult result;
+    const std::string stage = GetStageSuffix(job.Source);
+    if (stage.empty())
+    {
+        result.Log = "Unsupported shader source extension: " + job.Source.string();
+        return result;
+    }
+
+    if (!force && IsUpToDate(job))
+    {
+        result.Status = QEShaderCompileStatus::UpToDate;
+        return result;
+    }
+
+    std::error_code ec;
+    fs::create_directories(job.Output.parent_path(), ec);
+
+    std::vector<fs::path> dependencies;
+#if defined(QE_WITH_SHADERC)
+    const bool compiled = CompileWithShaderc(job, stage, dependencies, result.Log);
+    dependencies.insert(dependencies.begin(), job.Source.lexically_normal());
+#elif defined(_WIN32)
+    const bool compiled = CompileWithGlslc(job, dependencies, result.Log);
+#else
+    result.Log = "No shader compiler available: build with QE_WITH_SHADERC to compile shaders on this platform.";
+    const bool compiled = false;
+#endif
+
+    if (compiled)
+    {
+        std::sort(dependencies.begin() + 1, dependencies.end());
+        dependencies.erase(std::unique(dependencies.begin() + 1, dependencies.end()), dependencies.end());
+
+        if (!WriteDependencyFile(job, dependencies))
+        {
+            QE_LOG_WARN_CAT_F("QEShaderCompiler", "Could not write dependency file for {}", job.Output.string());
+        }
+
+        result.Status = QEShaderCompileStatus::Compiled;
+    }
+    else
+    {
+        // Sin .d valido el siguiente build vuelve a intentarlo
+        fs::remove(DependencyPath(job.Output), ec);
+        QE_LOG_ERROR_CAT_F("QEShaderCompiler", "Shader compilation failed for {}:\n{}", job.Source.string(), result.Log);
+    }
+
+    result.Milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    return result;
+}
+
+std::vector<QEShaderCompileResult> QEShaderCompiler::CompileBatch(
+    const std::vector<QEShaderCompileJob>& jobs,
+    const QEImportProgressCallback& onProgress,
+    bool force,
+    uint32_t workerCount)
+{
+    std::vector<QEShaderCompileResult> results(jobs.size());
+
+    std::mutex progressMutex;
+    size_t finished = 0;
+
+    std::atomic<size_t> next{ 0 };
+    auto worker = [&]()
+        {
+            for (size_t slot = next.fetch_add(1); slot < jobs.size(); slot = next.fetch_add(1))
+            {
+                results[slot] = Compile(jobs[slot], force);
+
+                if (onProgress)
+                {
+                    std::lock_guard<std::mutex> lock(progressMutex);
+                    ++finished;
+                    onProgress(
+                        static_cast<float>(finished) / static_cast<float>(jobs.size()),
+                        "Compiling",
+                        jobs[slot].Output.filename().string());
+                }
+            }
+        };
+
+    if (workerCount == 0)
+        workerCount = std::max(1u, std::thread::hardware_concurrency());
+    workerCount = std::min<uint32_t>(workerCount, static_cast<uint32_t>(jobs.size()));
+
+    if (workerCount <= 1)
+    {
+        worker();
+    }
+    else
+    {
+        std::vector<std::future<void>> workers;
+        workers.reserve(workerCount - 1);
+        for (uint32_t i = 1; i < workerCount; ++i)
+        {
+            workers.push_back(std::async(std::launch::async, worker));
+        }
+
+        worker();
+
+        for (auto& future : workers)
+        {
+            future.get();
+        }
+    }
+
+    size_t compiled = 0;
+    size_t upToDate = 0;
+    size_t failed = 0;
+    for (const auto& result : results)
+    {
+        switch (result.Status)
+        {
+        case QEShaderCompileStatus::Compiled: ++compiled; break;
+        case QEShaderCompileStatus::UpToDate: ++upToDate; break;
+        default:                              ++failed; break;
+        }
+    }
+
+    QE_LOG_INFO_CAT_F("QEShaderCompiler", "Shader build: {} compiled, {} up to date, {} failed ({} workers)", compiled, upToDate, failed, workerCount);
+    return results;
+}
+
+std::vector<QEShaderCompileJob> QEShaderCompiler::LoadBuildManifest(const fs::path& shaderRoot)
+{
+    const fs::path manifestPath = shaderRoot / BUILD_MANIFEST;
+    if (!fs::exists(manifestPath))
+        throw std::runtime_error("Shader build manifest not found: " + manifestPath.string());
+
+    const YAML::Node root = YAML::LoadFile(manifestPath.string());
+    const YAML::Node shaders = root["Shaders"];
+    if (!shaders || !shaders.IsSequence())
+        throw std::runtime_error("Shader build manifest has no 'Shaders' list: " + manifestPath.string());
+
+    std::vector<QEShaderCompileJob> jobs;
+    jobs.reserve(shaders.size());
+    for (const auto& item : shaders)
+    {
+        if (!item["Source"])
+            continue;
+
+        QEShaderCompileJob job;
+        job.Source = (shaderRoot / item["Source"].as<std::string>()).lexically_normal();
+
+        if (item["Output"])
+        {
+            job.Output = (shaderRoot / item["Output"].as<std::string>()).lexically_normal();
+        }
+        else
+        {
+            // Por defecto <stem>_<stage>.spv junto al source, como los .bat
+            job.Output = job.Source.parent_path() / (job.Source.stem().string() + "_" + GetStageSuffix(job.Source) + ".spv");
+        }
+
+        if (item["Defines"])
+            job.Defines = item["Defines"].as<std::vector<std::string>>();
+
+        if (item["TargetEnv"])
+            job.TargetEnv = ParseTargetEnv(item["TargetEnv"].as<std::string>());
+
+        jobs.push_back(std::move(job));
+    }
+
+    return jobs;
+}
+
+bool QEShaderCompiler::WriteDependencyFile(const QEShaderCompileJob& job, const std::vector<fs::path>& dependencies)
+{
+    const fs::path depPath = DependencyPath(job.Output);
+    fs::path tempPath = depPath;
+    tempPath += ".tmp";
+
+    {
+        std::ofstream file(tempPath, std::ios::trunc);
+        if (!file.is_open())
+            return false;
+
+        file << OPTIONS_TAG << std::format("{:016x}", OptionsHash(job)) << '\n';
+        file << EscapeMakePath(job.Output) << ':';
+        for (const auto& dependency : dependencies)
+        {
+            file << " \\\n  " << EscapeMakePath(dependency);
+        }
+        file << '\n';
+    }
+
+    std::error_code ec;
+    fs::rename(tempPath, depPath, ec);
+    if (ec)
+    {
+        fs::remove(tempPath, ec);
+        return false;
+    }
+
+    return true;
+}
+
+std::shared_ptr<const std::string> QEShaderCompiler::LoadInclude(const fs::path& path)
+{
+    std::error_code ec;
+    const fs::file_time_type writeTime = fs::last_write_time(path, ec);
+    if (ec)
+        return nullptr;
+
+    const std::string key = path.generic_string();
+    {
+        std::shared_lock lock(includeMutex);
+        auto it = includeCache.find(key);
+        if (it != includeCache.end() && it->second.WriteTime == writeTime)
+            return it->second.Content;
+    }
+
+    auto content = ReadTextFile(path);
+    if (!content)
+        return nullptr;
+
+    std::unique_lock lock(includeMutex);
+    includeCache[key] = CachedInclude{ writeTime, content };
+    return content;
+}
+
+void QEShaderCompiler::ClearIncludeCache()
+{
+    std::unique_lock lock(includeMutex);
+    includeCache.clear();
+}
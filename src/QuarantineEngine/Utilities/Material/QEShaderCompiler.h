@@ -0,0 +1,96 @@
+#pragma once
+
+#ifndef QE_SHADER_COMPILER_H
+#define QE_SHADER_COMPILER_H
+
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+using QEImportProgressCallback = std::function<void(float, const std::string&, const std::string&)>;
+
+enum class QEShaderTargetEnv : uint8_t
+{
+    Vulkan1_0,
+    Vulkan1_1,
+    Vulkan1_2,
+    Vulkan1_3
+};
+
+struct QEShaderCompileJob
+{
+    fs::path Source;
+    fs::path Output;
+    std::vector<std::string> Defines;           // "NOMBRE" o "NOMBRE=VALOR"
+    QEShaderTargetEnv TargetEnv = QEShaderTargetEnv::Vulkan1_0;
+};
+
+enum class QEShaderCompileStatus : uint8_t
+{
+    Compiled,
+    UpToDate,
+    Failed
+};
+
+struct QEShaderCompileResult
+{
+    QEShaderCompileStatus Status = QEShaderCompileStatus::Failed;
+    std::string Log;                            // Errores/avisos del compilador
+    double Milliseconds = 0.0;
+};
+
+/// Compila GLSL a SPIR-V. Con QE_WITH_SHADERC lo hace en proceso con shaderc (Vulkan SDK), si no
+/// lanza glslc.exe (solo Windows). Junto a cada .spv escribe <salida>.d con el source, los includes
+/// que uso y un hash de las opciones: un job solo se recompila si alguno de ellos cambio.
+/// Los includes se leen una vez y se comparten entre compilaciones e hilos hasta que cambia su fecha.
+class QEShaderCompiler
+{
+public:
+    static constexpr const char* DEPENDENCY_EXTENSION = ".d";
+    static constexpr const char* BUILD_MANIFEST = "ShaderBuild.yaml";
+
+    /// "vert", "frag", ... segun la extension; vacio si no es un stage soportado.
+    static std::string GetStageSuffix(const fs::path& source);
+
+    static bool HasLibraryBackend();
+    static bool IsAvailable();
+    static bool IsUpToDate(const QEShaderCompileJob& job);
+
+    static QEShaderCompileResult Compile(const QEShaderCompileJob& job, bool force = false);
+
+    /// Reparte los jobs entre hilos (workerCount 0 = hardware_concurrency). onProgress puede llamarse
+    /// desde cualquiera de ellos, nunca a la vez.
+    static std::vector<QEShaderCompileResult> CompileBatch(
+        const std::vector<QEShaderCompileJob>& jobs,
+        const QEImportProgressCallback& onProgress = nullptr,
+        bool force = false,
+        uint32_t workerCount = 0);
+
+    /// Jobs de <shaderRoot>/ShaderBuild.yaml; las rutas del manifiesto son relativas a shaderRoot.
+    static std::vector<QEShaderCompileJob> LoadBuildManifest(const fs::path& shaderRoot);
+
+    /// Escribe <salida>.d con el hash de opciones del job; dependencies[0] es el source.
+    static bool WriteDependencyFile(const QEShaderCompileJob& job, const std::vector<fs::path>& dependencies);
+
+    /// Contenido de un include desde la cache; nullptr si no se puede leer.
+    static std::shared_ptr<const std::string> LoadInclude(const fs::path& path);
+    static void ClearIncludeCache();
+};
+
+
+
+namespace QE
+{
+    using ::QEShaderTargetEnv;
+    using ::QEShaderCompileJob;
+    using ::QEShaderCompileStatus;
+    using ::QEShaderCompileResult;
+    using ::QEShaderCompiler;
+} // namespace QE
+// QE namespace aliases
+#endif // !QE_SHADER_COMPILER_H
@@ -21,17 +21,7 @@ public:
         const QEImportProgressCallback& onProgress = nullptr);
 
 private:
-    static fs::path FindGlslcExecutable();
-    static std::string GetShaderStageSuffix(const fs::path& inputFile);
     static fs::path BuildOutputPath(const fs::path& inputFile, const fs::path& targetFolder);
-    static std::wstring BuildCommandLine(
-        const fs::path& executablePath,
-        const fs::path& inputFile,
-        const fs::path& outputFile);
-    static std::string ExecuteProcessCaptureOutput(
-        const fs::path& executablePath,
-        const std::wstring& commandLine,
-        int& exitCode);
 };
 
 
@@ -0,0 +1,319 @@
+#include "QEShaderVariantCache.h"
+
+#include <algorithm>
+#include <cctype>
+#include <format>
+#include <fstream>
+#include <stdexcept>
+#include <unordered_set>
+#include <yaml-cpp/yaml.h>
+
+#include <Logging/QELogMacros.h>
+#include <MaterialData.h>
+#include <MaterialDto.h>
+#include <QEMaterialYamlHelper.h>
+#include <ShaderManager.h>
+#include <ShaderModule.h>
+
+bool QEShaderVariantCache::Enabled = true;
+
+namespace
+{
+    constexpr int INDEX_VERSION = 1;
+    constexpr const char* VARIANT_FOLDER = "Variants";
+
+    // Las keywords de textura son los bits de TexMask
+    static_assert(QEShaderVariantKey::KEYWORD_BASECOLOR == 1u << (uint32_t)MAT_TEX_SLOT::BaseColor);
+    static_assert(QEShaderVariantKey::KEYWORD_NORMAL == 1u << (uint32_t)MAT_TEX_SLOT::Normal);
+    static_assert(QEShaderVariantKey::KEYWORD_METALLIC == 1u << (uint32_t)MAT_TEX_SLOT::Metallic);
+    static_assert(QEShaderVariantKey::KEYWORD_ROUGHNESS == 1u << (uint32_t)MAT_TEX_SLOT::Roughness);
+    static_assert(QEShaderVariantKey::KEYWORD_AO == 1u << (uint32_t)MAT_TEX_SLOT::AO);
+    static_assert(QEShaderVariantKey::KEYWORD_EMISSIVE == 1u << (uint32_t)MAT_TEX_SLOT::Emissive);
+
+    struct VariantProgram
+    {
+        const char* Name;
+        const char* Source;                     // Relativo a la carpeta de shaders
+        std::vector<std::string> Defines;
+    };
+
+    // Los programas que MaterialManager registra con RegisterProgram
+    const std::vector<VariantProgram>& GetVariantPrograms()
+    {
+        static const std::vector<VariantProgram> programs =
+        {
+            { "default", "Default/default.frag", {} },
+            { "default_bindless", "Default/default.frag", { "QE_BINDLESS_MATERIALS" } },
+        };
+        return programs;
+    }
+
+    bool IsDefaultShaderPath(const std::string& shaderPath)
+    {
+        std::string lower = shaderPath;
+        std::transform(lower.begin(), lower.end(), lower.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        return lower.empty() || lower == "default" || lower == "default_primitive";
+    }
+
+    void WriteIndex(const fs::path& indexPath, const YAML::Node& root)
+    {
+        const fs::path tempPath = fs::path(indexPath).concat(".tmp");
+        {
+            std::ofstream file(tempPath, std::ios::trunc);
+            if (!file.is_open())
+                throw std::runtime_error("Could not write the shader variant index: " + indexPath.string());
+
+            file << "# Generado por QuarantineBenchmark --compile-shaders --project. No editar.\n";
+            YAML::Emitter out;
+            out << root;
+            file << out.c_str() << '\n';
+        }
+
+        std::error_code ec;
+        fs::rename(tempPath, indexPath, ec);
+        if (ec)
+        {
+            fs::remove(tempPath, ec);
+            throw std::runtime_error("Could not replace the shader variant index: " + indexPath.string());
+        }
+    }
+}
+
+void QEShaderVariantCache::Initialize(const fs::path& shaderRootPath)
+{
+    this->Clear();
+    this->shaderRoot = shaderRootPath;
+    this->LoadIndex();
+}
+
+void QEShaderVariantCache::LoadIndex()
+{
+    this->index.clear();
+
+    const fs::path indexPath = this->shaderRoot / INDEX_FILE;
+    if (!fs::exists(indexPath))
+        return;
+
+    try
+    {
+        const YAML::Node root = YAML::LoadFile(indexPath.string());
+        if (!root["Version"] || root["Version"].as<int>() != INDEX_VERSION)
+        {
+            QE_LOG_WARN_CAT_F("QEShaderVariantCache", "Ignoring shader variant index with another version: {}", indexPath.string());
+            return;
+        }
+
+        for (const auto& item : root["Variants"])
+        {
+            if (!item["Hash"] || !item["Output"])
+                continue;
+
+            const uint64_t hash = std::stoull(item["Hash"].as<std::string>(), nullptr, 16);
+            this->index[hash] = (this->shaderRoot / item["Output"].as<std::string>()).lexically_normal();
+        }
+    }
+    catch (const std::exception& e)
+    {
+        this->index.clear();
+        QE_LOG_WARN_CAT_F("QEShaderVariantCache", "Invalid shader variant index {} ({})", indexPath.string(), e.what());
+        return;
+    }
+
+    QE_LOG_INFO_CAT_F("QEShaderVariantCache", "{} precompiled shader variants", this->index.size());
+}
+
+void QEShaderVariantCache::Clear()
+{
+    // Los modulos de las variantes son de ShaderManager, que los limpia con el resto
+    this->programs.clear();
+    this->variants.clear();
+    this->index.clear();
+}
+
+void QEShaderVariantCache::RegisterProgram(
+    const std::shared_ptr<ShaderModule>& baseShader,
+    const std::string& program,
+    const std::string& vertexPath,
+    const GraphicsPipelineData& pipelineData)
+{
+    if (!baseShader)
+        return;
+
+    this->programs[baseShader.get()] = Program{ program, vertexPath, pipelineData };
+}
+
+std::shared_ptr<ShaderModule> QEShaderVariantCache::GetVariant(const std::shared_ptr<ShaderModule>& baseShader, uint32_t keywords)
+{
+    if (!Enabled || !baseShader)
+        return baseShader;
+
+    auto programIt = this->programs.find(baseShader.get());
+    if (programIt == this->programs.end())
+        return baseShader;
+
+    const Program& program = programIt->second;
+    const uint64_t hash = GetVariantHash(program.Name, keywords);
+
+    auto variantIt = this->variants.find(hash);
+    if (variantIt != this->variants.end())
+        return variantIt->second ? variantIt->second : baseShader;
+
+    const std::string variantName = program.Name + "_" + std::format("{:016x}", hash);
+    std::shared_ptr<ShaderModule> variant;
+
+    auto indexIt = this->index.find(hash);
+    if (indexIt == this->index.end() || !fs::exists(indexIt->second))
+    {
+        QE_LOG_WARN_CAT_F("QEShaderVariantCache", "Shader variant {} is not precompiled, using the generic shader", variantName);
+    }
+    else
+    {
+        try
+        {
+            variant = std::make_shared<ShaderModule>(
+                ShaderModule(variantName, program.VertexPath, indexIt->second.generic_string(), program.PipelineData)
+            );
+            ShaderManager::getInstance()->AddShader(variant);
+        }
+        catch (const std::exception& e)
+        {
+            variant.reset();
+            QE_LOG_WARN_CAT_F("QEShaderVariantCache", "Could not load shader variant {} ({})", variantName, e.what());
+        }
+    }
+
+    this->variants[hash] = variant;
+    return variant ? variant : baseShader;
+}
+
+uint32_t QEShaderVariantCache::GetKeywords(const MaterialData& materialData)
+{
+    return QEShaderVariantKey::FromMaterial(materialData.GetTexMask(), materialData.AlphaMode);
+}
+
+uint32_t QEShaderVariantCache::GetKeywords(const MaterialDto& materialDto)
+{
+    // Mismo TexMask que deja MaterialData::ApplyDtoPacking
+    uint32_t texMask = materialDto.texMask;
+    if (MaterialData::HasPackedMetallicRoughness(materialDto))
+    {
+        texMask |= (1u << (uint32_t)MAT_TEX_SLOT::Metallic);
+        texMask |= (1u << (uint32_t)MAT_TEX_SLOT::Roughness);
+    }
+
+    return QEShaderVariantKey::FromMaterial(texMask, materialDto.AlphaMode);
+}
+
+std::vector<std::string> QEShaderVariantCache::GetDefines(uint32_t keywords)
+{
+    return QEShaderVariantKey::GetDefines(keywords);
+}
+
+uint64_t QEShaderVariantCache::GetVariantHash(const std::string& program, uint32_t keywords)
+{
+    return QEShaderVariantKey::GetHash(program, keywords);
+}
+
+std::set<uint32_t> QEShaderVariantCache::CollectProjectKeywords(const fs::path& projectPath)
+{
+    // defaultPrimitiveMat: sin texturas y opaco
+    std::set<uint32_t> keywordSets = { 0u };
+
+    std::error_code ec;
+    for (fs::recursive_directory_iterator it(projectPath, fs::directory_options::skip_permission_denied, ec), end; !ec && it != end; it.increment(ec))
+    {
+        if (!it->is_regular_file(ec))
+            continue;
+
+        std::string extension = it->path().extension().string();
+        std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        if (extension != ".qemat")
+            continue;
+
+        MaterialDto materialDto;
+        if (!QEMaterialYamlHelper::ReadMaterialFile(it->path(), materialDto) || !IsDefaultShaderPath(materialDto.ShaderPath))
+            continue;
+
+        keywordSets.insert(GetKeywords(materialDto));
+    }
+
+    return keywordSets;
+}
+
+std::vector<QEShaderCompileJob> QEShaderVariantCache::PrepareVariantBuild(const fs::path& shaderRootPath, const std::set<uint32_t>& keywordSets)
+{
+    std::vector<QEShaderCompileJob> jobs;
+    std::unordered_set<std::string> outputs;
+    std::set<fs::path> variantFolders;
+
+    YAML::Node root;
+    root["Version"] = INDEX_VERSION;
+    YAML::Node entries(YAML::NodeType::Sequence);
+
+    for (const auto& program : GetVariantPrograms())
+    {
+        const fs::path source = (shaderRootPath / program.Source).lexically_normal();
+        const fs::path variantFolder = source.parent_path() / VARIANT_FOLDER;
+        variantFolders.insert(variantFolder);
+
+        for (uint32_t keywords : keywordSets)
+        {
+            const uint64_t hash = GetVariantHash(program.Name, keywords);
+            const std::string hashString = std::format("{:016x}", hash);
+
+            QEShaderCompileJob job;
+            job.Source = source;
+            job.Output = variantFolder / (std::string(program.Name) + "_" + hashString + "_" + QEShaderCompiler::GetStageSuffix(source) + ".spv");
+            job.Defines = program.Defines;
+
+            const std::vector<std::string> keywordDefines = GetDefines(keywords);
+            job.Defines.insert(job.Defines.end(), keywordDefines.begin(), keywordDefines.end());
+
+            YAML::Node entry;
+            entry["Program"] = program.Name;
+            entry["Hash"] = hashString;
+            entry["Keywords"] = std::vector<std::string>(keywordDefines.begin() + 1, keywordDefines.end());
+            entry["Output"] = job.Output.lexically_relative(shaderRootPath).generic_string();
+            entries.push_back(entry);
+
+            outputs.insert(job.Output.generic_string());
+            jobs.push_back(std::move(job));
+        }
+    }
+
+    root["Variants"] = entries;
+
+    std::error_code ec;
+    for (const auto& folder : variantFolders)
+    {
+        fs::create_directories(folder, ec);
+
+        // Fuera las variantes que ya no usa ningun material
+        std::vector<fs::path> stale;
+        for (const auto& entry : fs::directory_iterator(folder, ec))
+        {
+            const std::string name = entry.path().filename().string();
+            const bool isSpirv = name.ends_with(".spv");
+            const bool isDependency = name.ends_with(std::string(".spv") + QEShaderCompiler::DEPENDENCY_EXTENSION);
+            if (!isSpirv && !isDependency)
+                continue;
+
+            std::string output = entry.path().generic_string();
+            if (isDependency)
+                output.resize(output.size() - std::char_traits<char>::length(QEShaderCompiler::DEPENDENCY_EXTENSION));
+
+            if (!outputs.contains(output))
+                stale.push_back(entry.path());
+        }
+
+        for (const auto& path : stale)
+            fs::remove(path, ec);
+
+        if (!stale.empty())
+            QE_LOG_INFO_CAT_F("QEShaderVariantCache", "Removed {} stale shader variant files", stale.size());
+    }
+
+    WriteIndex(shaderRootPath / INDEX_FILE, root);
+    QE_LOG_INFO_CAT_F("QEShaderVariantCache", "{} shader variants for {} keyword sets", jobs.size(), keywordSets.size());
+    return jobs;
+}
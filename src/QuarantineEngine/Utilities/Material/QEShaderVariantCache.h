@@ -0,0 +1,96 @@
+#pragma once
+
+#ifndef QE_SHADER_VARIANT_CACHE_H
+#define QE_SHADER_VARIANT_CACHE_H
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <QESingleton.h>
+#include <GraphicsPipelineData.h>
+#include <QEShaderCompiler.h>
+#include <QEShaderVariantKey.h>
+
+namespace fs = std::filesystem;
+
+class MaterialData;
+class ShaderModule;
+struct MaterialDto;
+
+/// Permutaciones del fragment shader por defecto especializadas por material. Las keywords fijan en
+/// compilacion que slots pueden tener textura (mismos bits que MaterialData::TexMask) y si el material
+/// recorta por alfa; el resto de ramas dejan de existir en la variante.
+/// Las variantes se precompilan con QuarantineBenchmark --compile-shaders (solo las que usan los
+/// materiales del proyecto) y se listan por hash en resources/shaders/ShaderVariants.yaml. Si falta
+/// la variante de un material se usa el shader generico, que resuelve las mismas ramas en runtime.
+class QEShaderVariantCache : public QESingleton<QEShaderVariantCache>
+{
+private:
+    friend class QESingleton<QEShaderVariantCache>;
+
+    struct Program
+    {
+        std::string Name;
+        std::string VertexPath;
+        GraphicsPipelineData PipelineData;
+    };
+
+    fs::path shaderRoot;
+    std::unordered_map<uint64_t, fs::path> index;
+    std::unordered_map<const ShaderModule*, Program> programs;
+    // nullptr: variante no precompilada, se usa el shader base
+    std::unordered_map<uint64_t, std::shared_ptr<ShaderModule>> variants;
+
+private:
+    QEShaderVariantCache() = default;
+
+    void LoadIndex();
+
+public:
+    static constexpr uint32_t KEYWORD_TEXTURES = QEShaderVariantKey::KEYWORD_TEXTURES;
+    static constexpr uint32_t KEYWORD_ALPHA_MASK = QEShaderVariantKey::KEYWORD_ALPHA_MASK;
+    static constexpr const char* INDEX_FILE = "ShaderVariants.yaml";
+
+    // Si es false los materiales usan siempre el shader generico
+    static bool Enabled;
+
+    void Initialize(const fs::path& shaderRootPath);
+    void Clear();
+
+    /// 'baseShader' pasa a tener variantes del programa 'program' (su fragment con keywords).
+    void RegisterProgram(
+        const std::shared_ptr<ShaderModule>& baseShader,
+        const std::string& program,
+        const std::string& vertexPath,
+        const GraphicsPipelineData& pipelineData = GraphicsPipelineData());
+    bool HasVariants(const ShaderModule* shader) const { return programs.contains(shader); }
+
+    /// Variante de 'baseShader' para las keywords; el propio baseShader si no esta precompilada.
+    std::shared_ptr<ShaderModule> GetVariant(const std::shared_ptr<ShaderModule>& baseShader, uint32_t keywords);
+
+    static uint32_t GetKeywords(const MaterialData& materialData);
+    static uint32_t GetKeywords(const MaterialDto& materialDto);
+    static std::vector<std::string> GetDefines(uint32_t keywords);
+    static uint64_t GetVariantHash(const std::string& program, uint32_t keywords);
+
+    /// Keywords de los .qemat del proyecto que usan el shader por defecto (mas las del material por defecto).
+    static std::set<uint32_t> CollectProjectKeywords(const fs::path& projectPath);
+
+    /// Jobs de las variantes de 'keywordSets' para todos los programas. Reescribe el indice y borra
+    /// las variantes compiladas que ya no estan en el.
+    static std::vector<QEShaderCompileJob> PrepareVariantBuild(const fs::path& shaderRootPath, const std::set<uint32_t>& keywordSets);
+};
+
+
+
+namespace QE
+{
+    using ::QEShaderVariantCache;
+} // namespace QE
+// QE namespace aliases
+#endif // !QE_SHADER_VARIANT_CACHE_H
@@ -0,0 +1,82 @@
+#pragma once
+
+#ifndef QE_SHADER_VARIANT_KEY_H
+#define QE_SHADER_VARIANT_KEY_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <Helpers/HashHelpers.h>
+
+/// Clave de una variante de material: keywords (bits de MaterialData::TexMask mas el recorte por
+/// alfa), sus defines y el hash con el que se listan en ShaderVariants.yaml. Sin dependencias del
+/// resto del motor; QEShaderVariantCache la usa para buscar y precompilar variantes.
+struct QEShaderVariantKey
+{
+    // Mismos bits que MAT_TEX_SLOT (comprobado en QEShaderVariantCache.cpp)
+    static constexpr uint32_t KEYWORD_BASECOLOR = 1u << 0;
+    static constexpr uint32_t KEYWORD_NORMAL = 1u << 1;
+    static constexpr uint32_t KEYWORD_METALLIC = 1u << 2;
+    static constexpr uint32_t KEYWORD_ROUGHNESS = 1u << 3;
+    static constexpr uint32_t KEYWORD_AO = 1u << 4;
+    static constexpr uint32_t KEYWORD_EMISSIVE = 1u << 5;
+    static constexpr uint32_t KEYWORD_TEXTURES = 0x3Fu;         // BaseColor..Emissive
+    static constexpr uint32_t KEYWORD_ALPHA_MASK = 1u << 8;
+    static constexpr uint32_t ALPHA_MODE_MASK = 1u;             // MaterialDto::AlphaMode que recorta
+
+    /// Keywords de un TexMask ya empaquetado y un modo de alfa; el resto de bits se ignora.
+    static uint32_t FromMaterial(uint32_t texMask, uint32_t alphaMode)
+    {
+        uint32_t keywords = texMask & KEYWORD_TEXTURES;
+        if (alphaMode == ALPHA_MODE_MASK)
+            keywords |= KEYWORD_ALPHA_MASK;
+
+        return keywords;
+    }
+
+    /// QE_MATERIAL_VARIANT mas un define por keyword activa, siempre en el mismo orden.
+    static std::vector<std::string> GetDefines(uint32_t keywords)
+    {
+        struct Keyword
+        {
+            uint32_t Bit;
+            const char* Define;
+        };
+
+        static constexpr Keyword KEYWORDS[] =
+        {
+            { KEYWORD_BASECOLOR, "QE_TEX_BASECOLOR" },
+            { KEYWORD_NORMAL,    "QE_TEX_NORMAL" },
+            { KEYWORD_METALLIC,  "QE_TEX_METALLIC" },
+            { KEYWORD_ROUGHNESS, "QE_TEX_ROUGHNESS" },
+            { KEYWORD_AO,        "QE_TEX_AO" },
+            { KEYWORD_EMISSIVE,  "QE_TEX_EMISSIVE" },
+            { KEYWORD_ALPHA_MASK, "QE_ALPHA_MASK" },
+        };
+
+        std::vector<std::string> defines = { "QE_MATERIAL_VARIANT" };
+        for (const auto& keyword : KEYWORDS)
+        {
+            if ((keywords & keyword.Bit) != 0u)
+                defines.push_back(keyword.Define);
+        }
+
+        return defines;
+    }
+
+    /// Hash del indice: cambiarlo deja sin uso las variantes ya precompiladas.
+    static uint64_t GetHash(const std::string& program, uint32_t keywords)
+    {
+        return QEHelper::HashBytes(program.data(), program.size(), keywords);
+    }
+};
+
+
+
+namespace QE
+{
+    using ::QEShaderVariantKey;
+} // namespace QE
+// QE namespace aliases
+#endif // !QE_SHADER_VARIANT_KEY_H
@@ -0,0 +1,176 @@
+#include "QETextureResidencyPolicy.h"
+#include <algorithm>
+#include <cmath>
+#include <queue>
+
+uint32_t QETextureResidencyPolicy::MipForSize(uint32_t width, uint32_t height, uint32_t mipLevels, uint32_t size)
+{
+    if (mipLevels == 0)
+        return 0;
+
+    for (uint32_t level = 0; level < mipLevels; ++level)
+    {
+        const uint32_t levelWidth = std::max(1u, width >> level);
+        const uint32_t levelHeight = std::max(1u, height >> level);
+        if (std::max(levelWidth, levelHeight) <= size)
+            return level;
+    }
+
+    return mipLevels - 1;
+}
+
+float QETextureResidencyPolicy::RequiredMip(float uvPerPixel, uint32_t fullSize)
+{
+    const float texelsPerPixel = uvPerPixel * static_cast<float>(fullSize);
+    if (!(texelsPerPixel > 1.0f))
+        return 0.0f;
+
+    return std::log2(texelsPerPixel);
+}
+
+uint64_t QETextureResidencyPolicy::BytesFromMip(const QETextureResidencyEntry& entry, uint32_t mip)
+{
+    uint64_t bytes = 0;
+    for (size_t level = mip; level < entry.LevelBytes.size(); ++level)
+    {
+        bytes += entry.LevelBytes[level];
+    }
+    return bytes;
+}
+
+std::vector<size_t> QETextureResidencyPolicy::Resolve(
+    std::vector<QETextureResidencyEntry>& entries,
+    const QETextureResidencySettings& settings,
+    QETextureResidencyStats& outStats)
+{
+    outStats = {};
+    outStats.Tracked = static_cast<uint32_t>(entries.size());
+    outStats.BudgetBytes = settings.BudgetBytes;
+
+    std::vector<uint32_t> floorMips(entries.size(), 0);
+    uint64_t desiredBytes = 0;
+
+    for (size_t i = 0; i < entries.size(); ++i)
+    {
+        QETextureResidencyEntry& entry = entries[i];
+        if (entry.MipLevels == 0 || entry.LevelBytes.size() < entry.MipLevels)
+        {
+            entry.TargetMip = entry.ResidentMip;
+            continue;
+        }
+
+        const uint32_t floorMip = MipForSize(entry.Width, entry.Height, entry.MipLevels, settings.MinResidentSize);
+        const uint32_t resident = std::min(entry.ResidentMip, entry.MipLevels - 1);
+        floorMips[i] = floorMip;
+        outStats.ResidentBytes += BytesFromMip(entry, resident);
+
+        uint32_t wanted = std::min(resident, floorMip);
+        if (entry.Pending)
+        {
+            wanted = resident;
+        }
+        else if (!entry.DemandDriven)
+        {
+            wanted = 0;
+        }
+        else if (entry.FramesSinceVisible >= settings.EvictAfterFrames)
+        {
+            wanted = floorMip;
+        }
+        else if (entry.RequiredMip >= 0.0f)
+        {
+            const float biased = std::max(0.0f, std::floor(entry.RequiredMip + settings.MipBias));
+            const uint32_t required = std::min(static_cast<uint32_t>(biased), floorMip);
+
+            // Mas detalle en cuanto se pide; menos solo pasado el margen, para no recargar en cada frame
+            if (required < resident || required > resident + settings.HysteresisLevels)
+            {
+                wanted = required;
+            }
+        }
+
+        entry.TargetMip = wanted;
+        desiredBytes += BytesFromMip(entry, wanted);
+    }
+
+    // Sobre presupuesto: se quita el mip superior que mas libera, ponderado por lo que lleva sin verse
+    if (settings.BudgetBytes > 0 && desiredBytes > settings.BudgetBytes)
+    {
+        using Candidate = std::pair<double, size_t>;
+        std::priority_queue<Candidate> candidates;
+        auto score = [&entries](size_t i)
+            {
+                const QETextureResidencyEntry& entry = entries[i];
+                return static_cast<double>(entry.LevelBytes[entry.TargetMip]) * (1.0 + entry.FramesSinceVisible);
+            };
+
+        for (size_t i = 0; i < entries.size(); ++i)
+        {
+            const QETextureResidencyEntry& entry = entries[i];
+            if (entry.MipLevels > 0 && !entry.Pending && entry.TargetMip < floorMips[i])
+            {
+                candidates.emplace(score(i), i);
+            }
+        }
+
+        std::vector<uint8_t> limited(entries.size(), 0);
+        while (desiredBytes > settings.BudgetBytes && !candidates.empty())
+        {
+            const size_t i = candidates.top().second;
+            candidates.pop();
+
+            QETextureResidencyEntry& entry = entries[i];
+            desiredBytes -= entry.LevelBytes[entry.TargetMip];
+            ++entry.TargetMip;
+            limited[i] = 1;
+
+            if (entry.TargetMip < floorMips[i])
+            {
+                candidates.emplace(score(i), i);
+            }
+        }
+
+        outStats.BudgetLimited = static_cast<uint32_t>(std::count(limited.begin(), limited.end(), uint8_t(1)));
+    }
+
+    outStats.DesiredBytes = desiredBytes;
+
+    std::vector<size_t> changes;
+    for (size_t i = 0; i < entries.size(); ++i)
+    {
+        const QETextureResidencyEntry& entry = entries[i];
+        if (entry.MipLevels == 0 || entry.Pending || entry.TargetMip == entry.ResidentMip)
+            continue;
+
+        changes.push_back(i);
+        if (entry.TargetMip > entry.ResidentMip)
+            ++outStats.Evictions;
+        else
+            ++outStats.StreamIns;
+    }
+
+    // Expulsiones primero (las que mas liberan); despues las subidas con mas niveles de diferencia
+    std::sort(changes.begin(), changes.end(), [&entries](size_t a, size_t b)
+        {
+            const QETextureResidencyEntry& ea = entries[a];
+            const QETextureResidencyEntry& eb = entries[b];
+            const bool evictA = ea.TargetMip > ea.ResidentMip;
+            const bool evictB = eb.TargetMip > eb.ResidentMip;
+            if (evictA != evictB)
+                return evictA;
+
+            const uint32_t deltaA = evictA ? ea.TargetMip - ea.ResidentMip : ea.ResidentMip - ea.TargetMip;
+            const uint32_t deltaB = evictB ? eb.TargetMip - eb.ResidentMip : eb.ResidentMip - eb.TargetMip;
+            if (deltaA != deltaB)
+                return deltaA > deltaB;
+
+            return a < b;
+        });
+
+    if (settings.MaxChangesPerFrame > 0 && changes.size() > settings.MaxChangesPerFrame)
+    {
+        changes.resize(settings.MaxChangesPerFrame);
+    }
+
+    return changes;
+}
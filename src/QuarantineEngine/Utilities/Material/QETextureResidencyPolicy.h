@@ -0,0 +1,83 @@
+#pragma once
+
+#ifndef QE_TEXTURE_RESIDENCY_POLICY_H
+#define QE_TEXTURE_RESIDENCY_POLICY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/// Ajustes de residencia por mip; se leen una vez por frame en QETextureStreamer::Update.
+struct QETextureResidencySettings
+{
+    bool Enabled = true;
+    uint64_t BudgetBytes = 1024ull * 1024ull * 1024ull;    // 0 = sin limite
+    uint32_t MinResidentSize = 64;          // El mip con este lado (o menor) no se expulsa nunca
+    uint32_t InitialResidentSize = 256;     // Primera carga: solo hasta este lado, el resto bajo demanda
+    uint32_t HysteresisLevels = 1;          // Niveles de margen antes de soltar detalle
+    uint32_t EvictAfterFrames = 300;        // Frames sin verse para bajar al mip minimo
+    uint32_t MaxChangesPerFrame = 8;        // Recargas que se piden por frame
+    float MipBias = 0.0f;                   // > 0 pide menos detalle del que se ve
+};
+
+/// Una textura para Resolve. ResidentMip incluye lo que ya esta en vuelo.
+struct QETextureResidencyEntry
+{
+    uint32_t Width = 0;
+    uint32_t Height = 0;
+    uint32_t MipLevels = 0;
+    std::vector<uint64_t> LevelBytes;       // Bytes de cada mip de la cadena completa
+    uint32_t ResidentMip = 0;               // Mip superior residente
+    float RequiredMip = -1.0f;              // Demanda del ultimo frame; < 0 si no se ha dibujado
+    uint32_t FramesSinceVisible = 0;
+    bool DemandDriven = true;               // false: nadie informa de su uso, se quiere la cadena completa
+    bool Pending = false;                   // Con una recarga en vuelo: no se mueve
+
+    // Salida
+    uint32_t TargetMip = 0;
+};
+
+struct QETextureResidencyStats
+{
+    uint32_t Tracked = 0;
+    uint64_t BudgetBytes = 0;
+    uint64_t ResidentBytes = 0;
+    uint64_t DesiredBytes = 0;              // Tras aplicar el presupuesto
+    uint32_t BudgetLimited = 0;             // Texturas con menos detalle del pedido por el presupuesto
+    uint32_t StreamIns = 0;                 // Cambios pendientes de este Resolve
+    uint32_t Evictions = 0;
+};
+
+/// Decide que mips deben estar residentes a partir de la demanda en pantalla. No toca Vulkan:
+/// el streamer le pasa el estado de cada textura y aplica los cambios que devuelve.
+class QETextureResidencyPolicy
+{
+public:
+    /// Primer mip cuyo lado mayor es <= size (el ultimo si ninguno lo es).
+    static uint32_t MipForSize(uint32_t width, uint32_t height, uint32_t mipLevels, uint32_t size);
+
+    /// Mip que muestrea un texel por pixel: log2(lado * UV por pixel).
+    static float RequiredMip(float uvPerPixel, uint32_t fullSize);
+
+    /// Bytes de la cadena desde 'mip' hasta el final.
+    static uint64_t BytesFromMip(const QETextureResidencyEntry& entry, uint32_t mip);
+
+    /// Rellena TargetMip de cada entrada y devuelve los indices a recargar, en orden de aplicacion
+    /// (primero lo que libera memoria) y como mucho MaxChangesPerFrame.
+    static std::vector<size_t> Resolve(
+        std::vector<QETextureResidencyEntry>& entries,
+        const QETextureResidencySettings& settings,
+        QETextureResidencyStats& outStats);
+};
+
+
+
+namespace QE
+{
+    using ::QETextureResidencySettings;
+    using ::QETextureResidencyEntry;
+    using ::QETextureResidencyStats;
+    using ::QETextureResidencyPolicy;
+} // namespace QE
+// QE namespace aliases
+#endif // !QE_TEXTURE_RESIDENCY_POLICY_H
@@ -0,0 +1,942 @@
+#include "QETextureStreamer.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <unordered_set>
+#include <stb_image.h>
+#include <QEKtxTranscodeCache.h>
+#include <DeviceModule.h>
+#include <QueueModule.h>
+#include <BufferManageModule.h>
+#include <ImageMemoryTools.h>
+#include <MaterialManager.h>
+#include <Helpers/QEMemoryTrack.h>
+#include <Logging/QELogMacros.h>
+
+namespace
+{
+    VkDeviceSize AlignUp(VkDeviceSize value, VkDeviceSize alignment)
+    {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+
+    const std::array<float, 256>& SrgbToLinearTable()
+    {
+        static const std::array<float, 256> table = []()
+            {
+                std::array<float, 256> values{};
+                for (size_t i = 0; i < values.size(); ++i)
+                {
+                    const float c = static_cast<float>(i) / 255.0f;
+                    values[i] = (c <= 0.04045f) ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+                }
+                return values;
+            }();
+        return table;
+    }
+
+    uint8_t LinearToSrgb8(float linear)
+    {
+        linear = std::clamp(linear, 0.0f, 1.0f);
+        const float c = (linear <= 0.0031308f) ? linear * 12.92f : 1.055f * std::pow(linear, 1.0f / 2.4f) - 0.055f;
+        return static_cast<uint8_t>(c * 255.0f + 0.5f);
+    }
+
+    // Box filter 2x2 (el ultimo texel se repite en dimensiones impares); en sRGB se promedia en lineal
+    void DownsampleRgba8(const uint8_t* src, uint32_t srcWidth, uint32_t srcHeight, uint8_t* dst, uint32_t dstWidth, uint32_t dstHeight, bool srgb)
+    {
+        const auto& toLinear = SrgbToLinearTable();
+
+        for (uint32_t y = 0; y < dstHeight; ++y)
+        {
+            const uint32_t y0 = std::min(y * 2, srcHeight - 1);
+            const uint32_t y1 = std::min(y * 2 + 1, srcHeight - 1);
+
+            for (uint32_t x = 0; x < dstWidth; ++x)
+            {
+                const uint32_t x0 = std::min(x * 2, srcWidth - 1);
+                const uint32_t x1 = std::min(x * 2 + 1, srcWidth - 1);
+
+                const uint8_t* taps[4] =
+                {
+                    src + (static_cast<size_t>(y0) * srcWidth + x0) * 4,
+                    src + (static_cast<size_t>(y0) * srcWidth + x1) * 4,
+                    src + (static_cast<size_t>(y1) * srcWidth + x0) * 4,
+                    src + (static_cast<size_t>(y1) * srcWidth + x1) * 4,
+                };
+
+                uint8_t* out = dst + (static_cast<size_t>(y) * dstWidth + x) * 4;
+                for (uint32_t c = 0; c < 4; ++c)
+                {
+                    if (srgb && c < 3)
+                    {
+                        const float sum = toLinear[taps[0][c]] + toLinear[taps[1][c]] + toLinear[taps[2][c]] + toLinear[taps[3][c]];
+                        out[c] = LinearToSrgb8(sum * 0.25f);
+                    }
+                    else
+                    {
+                        const uint32_t sum = uint32_t(taps[0][c]) + taps[1][c] + taps[2][c] + taps[3][c];
+                        out[c] = static_cast<uint8_t>((sum + 2) / 4);
+                    }
+                }
+            }
+        }
+    }
+}
+
+QETextureStreamer::~QETextureStreamer()
+{
+    running = false;
+    queueCv.notify_all();
+
+    for (auto& worker : workers)
+    {
+        if (worker.joinable())
+            worker.join();
+    }
+}
+
+void QETextureStreamer::Initialize()
+{
+    if (initialized || !Enabled)
+        return;
+
+    deviceModule = DeviceModule::getInstance();
+    queueModule = QueueModule::getInstance();
+
+    VkPhysicalDeviceFeatures features{};
+    vkGetPhysicalDeviceFeatures(deviceModule->physicalDevice, &features);
+    bcSupported = features.textureCompressionBC == VK_TRUE;
+
+    // 16 cubre el tamano de bloque de BC7 y el texel de RGBA8
+    VkPhysicalDeviceProperties properties{};
+    vkGetPhysicalDeviceProperties(deviceModule->physicalDevice, &properties);
+    copyAlignment = std::max<VkDeviceSize>(16, properties.limits.optimalBufferCopyOffsetAlignment);
+
+    VkCommandPoolCreateInfo poolInfo{};
+    poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+    poolInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+    poolInfo.queueFamilyIndex = queueModule->transferFamily;
+
+    if (vkCreateCommandPool(deviceModule->device, &poolInfo, nullptr, &commandPool) != VK_SUCCESS)
+    {
+        throw std::runtime_error("failed to create texture streaming command pool!");
+    }
+
+    VkSemaphoreTypeCreateInfo typeInfo{};
+    typeInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO;
+    typeInfo.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+    typeInfo.initialValue = 0;
+
+    VkSemaphoreCreateInfo semaphoreInfo{};
+    semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+    semaphoreInfo.pNext = &typeInfo;
+
+    if (vkCreateSemaphore(deviceModule->device, &semaphoreInfo, nullptr, &timeline) != VK_SUCCESS)
+    {
+        throw std::runtime_error("failed to create texture streaming timeline semaphore!");
+    }
+
+    ringSize = std::max(StagingRingSize, copyAlignment);
+    BufferManageModule::createBuffer(
+        ringSize,
+        VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+        ringBuffer,
+        ringMemory,
+        *deviceModule);
+
+    void* mapped = nullptr;
+    vkMapMemory(deviceModule->device, ringMemory, 0, ringSize, 0, &mapped);
+    ringMapped = static_cast<uint8_t*>(mapped);
+    ringHead = 0;
+    ringUsed = 0;
+    timelineValue = 0;
+    completedValue = 0;
+
+    const uint32_t hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+    const uint32_t workerCount = WorkerCount > 0 ? WorkerCount : std::clamp(hardwareThreads - 1, 1u, 4u);
+
+    running = true;
+    for (uint32_t i = 0; i < workerCount; ++i)
+    {
+        workers.emplace_back(&QETextureStreamer::WorkerLoop, this);
+    }
+
+    initialized = true;
+
+    QE_LOG_INFO_CAT_F("QETextureStreamer", "Texture streaming enabled: {} workers, {} MB staging ring, {} transfer queue",
+        workerCount, ringSize / (1024 * 1024), queueModule->dedicatedTransfer ? "dedicated" : "graphics");
+}
+
+void QETextureStreamer::Cleanup()
+{
+    if (!initialized)
+        return;
+
+    running = false;
+    queueCv.notify_all();
+    for (auto& worker : workers)
+    {
+        if (worker.joinable())
+            worker.join();
+    }
+    workers.clear();
+
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        requests.clear();
+        decoded.clear();
+    }
+
+    // Las subidas en vuelo terminan y sus texturas se liberan con el resto en TextureManager::Clean
+    RetireBatches(true);
+
+    vkUnmapMemory(deviceModule->device, ringMemory);
+    ringMapped = nullptr;
+    QE_DESTROY_BUFFER(deviceModule->device, ringBuffer, "QETextureStreamer::Cleanup");
+    QE_FREE_MEMORY(deviceModule->device, ringMemory, "QETextureStreamer::Cleanup");
+
+    vkDestroyCommandPool(deviceModule->device, commandPool, nullptr);
+    vkDestroySemaphore(deviceModule->device, timeline, nullptr);
+    commandPool = VK_NULL_HANDLE;
+    timeline = VK_NULL_HANDLE;
+
+    tracked.clear();
+    stats.Pending = 0;
+    stats.ResidencyPending = 0;
+    initialized = false;
+}
+
+void QETextureStreamer::Enqueue(const std::shared_ptr<CustomTexture>& texture, const std::string& path, QEColorSpace cs)
+{
+    if (!initialized || !texture)
+        return;
+
+    if (stats.Pending == 0)
+    {
+        firstRequestTime = std::chrono::steady_clock::now();
+    }
+
+    auto request = std::make_unique<Request>();
+    request->Texture = texture;
+    request->Path = path;
+    request->ColorSpace = cs;
+    request->Initial = true;
+    request->InitialSize = Residency.Enabled ? Residency.InitialResidentSize : 0;
+
+    Tracked& entry = tracked[texture.get()];
+    entry = Tracked{};
+    entry.Texture = texture;
+    entry.Path = path;
+    entry.ColorSpace = cs;
+    entry.LastVisibleFrame = frameIndex;
+
+    ++stats.Requested;
+    ++stats.Pending;
+
+    PushRequest(std::move(request));
+}
+
+void QETextureStreamer::PushRequest(std::unique_ptr<Request> request)
+{
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        requests.push_back(std::move(request));
+    }
+    queueCv.notify_one();
+}
+
+void QETextureStreamer::ReleasePending(bool initial)
+{
+    if (initial)
+        --stats.Pending;
+    else
+        --stats.ResidencyPending;
+}
+
+void QETextureStreamer::ReportUsage(const CustomTexture* texture, float uvPerPixel)
+{
+    if (!initialized || !texture)
+        return;
+
+    auto it = tracked.find(texture);
+    if (it == tracked.end())
+        return;
+
+    Tracked& entry = it->second;
+    entry.Observed = true;
+    entry.LastVisibleFrame = frameIndex;
+
+    if (entry.MipLevels == 0)
+        return;
+
+    const float required = QETextureResidencyPolicy::RequiredMip(uvPerPixel, std::max(entry.Width, entry.Height));
+    entry.RequiredMip = entry.RequiredMip < 0.0f ? required : std::min(entry.RequiredMip, required);
+}
+
+void QETextureStreamer::WorkerLoop()
+{
+    while (true)
+    {
+        std::unique_ptr<Request> request;
+        {
+            std::unique_lock<std::mutex> lock(queueMutex);
+            queueCv.wait(lock, [this]() { return !running || !requests.empty(); });
+
+            if (!running)
+                return;
+
+            request = std::move(requests.front());
+            requests.pop_front();
+        }
+
+        // Texturas liberadas mientras esperaban: no se decodifican
+        if (!request->Texture.expired())
+        {
+            try
+            {
+                Decode(*request, bcSupported);
+            }
+            catch (const std::exception& e)
+            {
+                request->Error = e.what();
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(queueMutex);
+        decoded.push_back(std::move(request));
+    }
+}
+
+void QETextureStreamer::Decode(Request& request, bool bcSupported)
+{
+    std::string ext = std::filesystem::path(request.Path).extension().string();
+    std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+
+    const bool decodedOk = (ext == ".ktx2") ? DecodeKtx2(request, bcSupported) : DecodeImage(request);
+    if (!decodedOk || request.Levels.empty())
+        return;
+
+    request.FullWidth = request.Levels.front().Width;
+    request.FullHeight = request.Levels.front().Height;
+    request.LevelBytes.clear();
+    for (const DecodedLevel& level : request.Levels)
+    {
+        request.LevelBytes.push_back(static_cast<uint64_t>(level.Size));
+    }
+
+    if (request.Initial)
+    {
+        const uint32_t levelCount = static_cast<uint32_t>(request.Levels.size());
+        request.TopMip = request.InitialSize > 0
+            ? QETextureResidencyPolicy::MipForSize(request.FullWidth, request.FullHeight, levelCount, request.InitialSize)
+            : 0;
+    }
+
+    SliceLevels(request);
+}
+
+void QETextureStreamer::SliceLevels(Request& request)
+{
+    const uint32_t levelCount = static_cast<uint32_t>(request.Levels.size());
+    if (levelCount == 0)
+        return;
+
+    request.TopMip = std::min(request.TopMip, levelCount - 1);
+    if (request.TopMip == 0)
+        return;
+
+    // Cada mip es un bloque independiente (en KTX2, el indice de niveles): se copian solo los pedidos
+    VkDeviceSize totalSize = 0;
+    for (uint32_t level = request.TopMip; level < levelCount; ++level)
+    {
+        totalSize += request.Levels[level].Size;
+    }
+
+    std::vector<uint8_t> data(static_cast<size_t>(totalSize));
+    std::vector<DecodedLevel> levels;
+    levels.reserve(levelCount - request.TopMip);
+
+    VkDeviceSize offset = 0;
+    for (uint32_t level = request.TopMip; level < levelCount; ++level)
+    {
+        DecodedLevel sliced = request.Levels[level];
+        memcpy(data.data() + offset, request.Data.data() + sliced.Offset, static_cast<size_t>(sliced.Size));
+        sliced.Offset = offset;
+        offset += sliced.Size;
+        levels.push_back(sliced);
+    }
+
+    request.Data = std::move(data);
+    request.Levels = std::move(levels);
+}
+
+bool QETextureStreamer::DecodeKtx2(Request& request, bool bcSupported)
+{
+    // Basis: la cache de transcodificacion evita repetir BC7 en cada ejecucion (y en cada recarga de mips)
+    QEKtxPayload payload;
+    QEKtxTranscodeCache::Load(request.Path, request.ColorSpace, bcSupported, payload);
+
+    request.Levels.clear();
+    request.Levels.reserve(payload.Levels.size());
+    for (const QEKtxLevel& level : payload.Levels)
+    {
+        DecodedLevel decodedLevel;
+        decodedLevel.Offset = static_cast<VkDeviceSize>(level.Offset);
+        decodedLevel.Size = static_cast<VkDeviceSize>(level.Size);
+        decodedLevel.Width = level.Width;
+        decodedLevel.Height = level.Height;
+        request.Levels.push_back(decodedLevel);
+    }
+
+    request.Data.assign(payload.Data(), payload.Data() + payload.Size());
+    request.Format = payload.Format;
+    return true;
+}
+
+bool QETextureStreamer::DecodeImage(Request& request)
+{
+    int width = 0;
+    int height = 0;
+    int channels = 0;
+    stbi_uc* pixels = stbi_load(request.Path.c_str(), &width, &height, &channels, STBI_rgb_alpha);
+    if (!pixels)
+    {
+        request.Error = "Failed to load texture image: " + request.Path;
+        return false;
+    }
+
+    const bool srgb = request.ColorSpace == QEColorSpace::SRGB;
+    const uint32_t mipLevels = static_cast<uint32_t>(std::floor(std::log2(std::max(width, height)))) + 1;
+
+    request.Levels.resize(mipLevels);
+    VkDeviceSize totalSize = 0;
+    for (uint32_t level = 0; level < mipLevels; ++level)
+    {
+        DecodedLevel& decodedLevel = request.Levels[level];
+        decodedLevel.Offset = totalSize;
+        decodedLevel.Width = std::max(1u, static_cast<uint32_t>(width) >> level);
+        decodedLevel.Height = std::max(1u, static_cast<uint32_t>(height) >> level);
+        decodedLevel.Size = static_cast<VkDeviceSize>(decodedLevel.Width) * decodedLevel.Height * 4;
+        totalSize += decodedLevel.Size;
+    }
+
+    request.Data.resize(static_cast<size_t>(totalSize));
+    memcpy(request.Data.data(), pixels, static_cast<size_t>(width) * height * 4);
+    stbi_image_free(pixels);
+
+    // Mips en CPU: en el hilo principal eran blits en la cola grafica
+    for (uint32_t level = 1; level < mipLevels; ++level)
+    {
+        const DecodedLevel& src = request.Levels[level - 1];
+        const DecodedLevel& dst = request.Levels[level];
+        DownsampleRgba8(request.Data.data() + src.Offset, src.Width, src.Height,
+            request.Data.data() + dst.Offset, dst.Width, dst.Height, srgb);
+    }
+
+    request.Format = srgb ? VK_FORMAT_R8G8B8A8_SRGB : VK_FORMAT_R8G8B8A8_UNORM;
+    return true;
+}
+
+bool QETextureStreamer::AllocateRing(VkDeviceSize size, VkDeviceSize& outOffset, VkDeviceSize& inOutBatchBytes)
+{
+    if (size > ringSize)
+        return false;
+
+    // Las tandas se retiran en orden: lo ocupado es el tramo [tail, head) y el hueco del final al
+    // volver a 0 cuenta como ocupado hasta que se retira la tanda que lo salto
+    const VkDeviceSize aligned = AlignUp(ringHead, copyAlignment);
+    VkDeviceSize consumed = 0;
+
+    if (aligned + size <= ringSize)
+    {
+        consumed = (aligned - ringHead) + size;
+        if (ringUsed + consumed > ringSize)
+            return false;
+
+        outOffset = aligned;
+    }
+    else
+    {
+        consumed = (ringSize - ringHead) + size;
+        if (ringUsed + consumed > ringSize)
+            return false;
+
+        outOffset = 0;
+    }
+
+    ringHead = outOffset + size;
+    ringUsed += consumed;
+    inOutBatchBytes += consumed;
+    return true;
+}
+
+bool QETextureStreamer::StageUpload(Request& request, UploadBatch& batch, StagedUpload& outUpload)
+{
+    const VkDeviceSize size = static_cast<VkDeviceSize>(request.Data.size());
+
+    VkDeviceSize offset = 0;
+    if (AllocateRing(size, offset, batch.RingBytes))
+    {
+        memcpy(ringMapped + offset, request.Data.data(), request.Data.size());
+        outUpload.Source = ringBuffer;
+        outUpload.SourceOffset = offset;
+    }
+    else if (size > ringSize)
+    {
+        // No cabe nunca en el ring: staging propio que se libera al retirar la tanda
+        VkBuffer buffer = VK_NULL_HANDLE;
+        VkDeviceMemory memory = VK_NULL_HANDLE;
+        BufferManageModule::createBuffer(
+            size,
+            VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+            buffer,
+            memory,
+            *deviceModule);
+
+        void* mapped = nullptr;
+        vkMapMemory(deviceModule->device, memory, 0, size, 0, &mapped);
+        memcpy(mapped, request.Data.data(), request.Data.size());
+        vkUnmapMemory(deviceModule->device, memory);
+
+        batch.DedicatedStaging.emplace_back(buffer, memory);
+        outUpload.Source = buffer;
+        outUpload.SourceOffset = 0;
+    }
+    else
+    {
+        // Ring lleno: se reintenta cuando se retire alguna tanda
+        return false;
+    }
+
+    const DecodedLevel& base = request.Levels.front();
+    PendingImage& pending = outUpload.Image;
+    pending.Texture = request.Texture;
+    pending.Format = request.Format;
+    pending.Width = base.Width;
+    pending.Height = base.Height;
+    pending.MipLevels = static_cast<uint32_t>(request.Levels.size());
+    pending.TopMip = request.TopMip;
+    pending.Initial = request.Initial;
+
+    const uint32_t families[2] = { queueModule->graphicsFamily, queueModule->transferFamily };
+
+    VkImageCreateInfo imageInfo{};
+    imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+    imageInfo.imageType = VK_IMAGE_TYPE_2D;
+    imageInfo.extent = { pending.Width, pending.Height, 1 };
+    imageInfo.mipLevels = pending.MipLevels;
+    imageInfo.arrayLayers = 1;
+    imageInfo.format = pending.Format;
+    imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+    imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    imageInfo.usage = VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+    imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+
+    // Compartida entre familias: sin transferencias de propiedad entre la cola de copia y la grafica
+    if (queueModule->transferFamily != queueModule->graphicsFamily)
+    {
+        imageInfo.sharingMode = VK_SHARING_MODE_CONCURRENT;
+        imageInfo.queueFamilyIndexCount = 2;
+        imageInfo.pQueueFamilyIndices = families;
+    }
+    else
+    {
+        imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    }
+
+    if (vkCreateImage(deviceModule->device, &imageInfo, nullptr, &pending.Image) != VK_SUCCESS)
+    {
+        throw std::runtime_error("failed to create streamed texture image!");
+    }
+
+    VkMemoryRequirements memRequirements;
+    vkGetImageMemoryRequirements(deviceModule->device, pending.Image, &memRequirements);
+
+    VkMemoryAllocateInfo allocInfo{};
+    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    allocInfo.allocationSize = memRequirements.size;
+    allocInfo.memoryTypeIndex = IMT::findMemoryType(memRequirements.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, deviceModule->physicalDevice);
+
+    if (vkAllocateMemory(deviceModule->device, &allocInfo, nullptr, &pending.Memory) != VK_SUCCESS)
+    {
+        throw std::runtime_error("failed to allocate streamed texture memory!");
+    }
+    QE_TRACK_MEMORY_ALLOCATION(pending.Memory, "QETextureStreamer::StageUpload");
+
+    vkBindImageMemory(deviceModule->device, pending.Image, pending.Memory, 0);
+
+    outUpload.Regions.clear();
+    outUpload.Regions.reserve(request.Levels.size());
+    for (uint32_t level = 0; level < request.Levels.size(); ++level)
+    {
+        const DecodedLevel& decodedLevel = request.Levels[level];
+
+        VkBufferImageCopy region{};
+        region.bufferOffset = outUpload.SourceOffset + decodedLevel.Offset;
+        region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        region.imageSubresource.mipLevel = level;
+        region.imageSubresource.baseArrayLayer = 0;
+        region.imageSubresource.layerCount = 1;
+        region.imageOffset = { 0, 0, 0 };
+        region.imageExtent = { decodedLevel.Width, decodedLevel.Height, 1 };
+        outUpload.Regions.push_back(region);
+    }
+
+    return true;
+}
+
+void QETextureStreamer::RecordUploads(VkCommandBuffer cmd, const std::vector<StagedUpload>& uploads)
+{
+    std::vector<VkImageMemoryBarrier> toTransfer;
+    std::vector<VkImageMemoryBarrier> toShader;
+    toTransfer.reserve(uploads.size());
+    toShader.reserve(uploads.size());
+
+    for (const StagedUpload& upload : uploads)
+    {
+        VkImageMemoryBarrier barrier{};
+        barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.image = upload.Image.Image;
+        barrier.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, upload.Image.MipLevels, 0, 1 };
+
+        barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+        barrier.srcAccessMask = 0;
+        barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        toTransfer.push_back(barrier);
+
+        // La cola de transferencia no tiene etapas de shader: la visibilidad la da el timeline
+        barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+        barrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.dstAccessMask = 0;
+        toShader.push_back(barrier);
+    }
+
+    vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0,
+        0, nullptr, 0, nullptr, static_cast<uint32_t>(toTransfer.size()), toTransfer.data());
+
+    for (const StagedUpload& upload : uploads)
+    {
+        vkCmdCopyBufferToImage(cmd, upload.Source, upload.Image.Image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+            static_cast<uint32_t>(upload.Regions.size()), upload.Regions.data());
+    }
+
+    vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0,
+        0, nullptr, 0, nullptr, static_cast<uint32_t>(toShader.size()), toShader.data());
+}
+
+std::unordered_set<const CustomTexture*> QETextureStreamer::RetireBatches(bool waitAll)
+{
+    std::unordered_set<const CustomTexture*> completed;
+
+    if (waitAll && timelineValue > completedValue)
+    {
+        VkSemaphoreWaitInfo waitInfo{};
+        waitInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+        waitInfo.semaphoreCount = 1;
+        waitInfo.pSemaphores = &timeline;
+        waitInfo.pValues = &timelineValue;
+        vkWaitSemaphores(deviceModule->device, &waitInfo, UINT64_MAX);
+    }
+
+    uint64_t gpuValue = 0;
+    vkGetSemaphoreCounterValue(deviceModule->device, timeline, &gpuValue);
+
+    while (!inFlight.empty() && inFlight.front().TimelineValue <= gpuValue)
+    {
+        UploadBatch& batch = inFlight.front();
+
+        for (PendingImage& pending : batch.Images)
+        {
+            if (auto texture = pending.Texture.lock())
+            {
+                texture->CompleteStreaming(pending.Image, pending.Memory, pending.Format, pending.Width, pending.Height, pending.MipLevels);
+                completed.insert(texture.get());
+
+                if (pending.Initial)
+                    ++stats.Resident;
+
+                auto it = tracked.find(texture.get());
+                if (it != tracked.end())
+                {
+                    Tracked& entry = it->second;
+                    if (!pending.Initial && pending.TopMip < entry.ResidentMip)
+                    {
+                        ++stats.StreamIns;
+                        stats.MipsStreamedIn += entry.ResidentMip - pending.TopMip;
+                    }
+                    else if (!pending.Initial && pending.TopMip > entry.ResidentMip)
+                    {
+                        ++stats.Evictions;
+                        stats.MipsEvicted += pending.TopMip - entry.ResidentMip;
+                        for (uint32_t level = entry.ResidentMip; level < pending.TopMip && level < entry.LevelBytes.size(); ++level)
+                        {
+                            stats.EvictedBytes += entry.LevelBytes[level];
+                        }
+                    }
+
+                    entry.ResidentMip = pending.TopMip;
+                    entry.PendingMip = pending.TopMip;
+                    entry.Pending = false;
+                }
+            }
+            else
+            {
+                QE_DEFER_DESTROY(deviceModule->device, pending.Image, vkDestroyImage, "QETextureStreamer::RetireBatches");
+                QE_FREE_MEMORY(deviceModule->device, pending.Memory, "QETextureStreamer::RetireBatches");
+            }
+
+            ReleasePending(pending.Initial);
+        }
+
+        ringUsed -= batch.RingBytes;
+        if (ringUsed == 0)
+        {
+            ringHead = 0;
+        }
+
+        completedValue = batch.TimelineValue;
+        DestroyBatchResources(batch);
+        inFlight.pop_front();
+    }
+
+    return completed;
+}
+
+void QETextureStreamer::DestroyBatchResources(UploadBatch& batch)
+{
+    for (auto& [buffer, memory] : batch.DedicatedStaging)
+    {
+        QE_DESTROY_BUFFER(deviceModule->device, buffer, "QETextureStreamer::DestroyBatchResources");
+        QE_FREE_MEMORY(deviceModule->device, memory, "QETextureStreamer::DestroyBatchResources");
+    }
+    batch.DedicatedStaging.clear();
+
+    if (batch.CommandBuffer != VK_NULL_HANDLE)
+    {
+        vkFreeCommandBuffers(deviceModule->device, commandPool, 1, &batch.CommandBuffer);
+        batch.CommandBuffer = VK_NULL_HANDLE;
+    }
+}
+
+void QETextureStreamer::UpdateResidency()
+{
+    if (!Residency.Enabled)
+        return;
+
+    std::vector<QETextureResidencyEntry> entries;
+    std::vector<Tracked*> owners;
+    entries.reserve(tracked.size());
+    owners.reserve(tracked.size());
+
+    for (auto it = tracked.begin(); it != tracked.end();)
+    {
+        if (it->second.Texture.expired())
+        {
+            it = tracked.erase(it);
+            continue;
+        }
+
+        Tracked& entry = it->second;
+        ++it;
+
+        const float requiredMip = entry.RequiredMip;
+        entry.RequiredMip = -1.0f;
+
+        if (entry.MipLevels == 0)
+            continue;
+
+        const uint64_t framesSinceVisible = frameIndex - entry.LastVisibleFrame;
+
+        QETextureResidencyEntry residency;
+        residency.Width = entry.Width;
+        residency.Height = entry.Height;
+        residency.MipLevels = entry.MipLevels;
+        residency.LevelBytes = entry.LevelBytes;
+        residency.ResidentMip = entry.Pending ? entry.PendingMip : entry.ResidentMip;
+        residency.RequiredMip = requiredMip;
+        residency.FramesSinceVisible = static_cast<uint32_t>(std::min<uint64_t>(framesSinceVisible, UINT32_MAX));
+        // Sin ReportUsage en todo ese tiempo (UI, particulas...): no la gestiona la demanda
+        residency.DemandDriven = entry.Observed || framesSinceVisible < Residency.EvictAfterFrames;
+        residency.Pending = entry.Pending;
+
+        entries.push_back(std::move(residency));
+        owners.push_back(&entry);
+    }
+
+    const std::vector<size_t> changes = QETextureResidencyPolicy::Resolve(entries, Residency, residencyStats);
+
+    // Cada cambio vuelve a leer el origen con otro mip superior; la imagen anterior sigue en uso hasta adoptarse
+    for (size_t index : changes)
+    {
+        Tracked& entry = *owners[index];
+
+        auto request = std::make_unique<Request>();
+        request->Texture = entry.Texture;
+        request->Path = entry.Path;
+        request->ColorSpace = entry.ColorSpace;
+        request->Initial = false;
+        request->TopMip = entries[index].TargetMip;
+
+        entry.Pending = true;
+        entry.PendingMip = request->TopMip;
+        ++stats.ResidencyPending;
+
+        PushRequest(std::move(request));
+    }
+}
+
+void QETextureStreamer::Update()
+{
+    if (!initialized)
+        return;
+
+    const auto start = std::chrono::steady_clock::now();
+    const bool hadPending = stats.Pending > 0;
+    ++frameIndex;
+    stats.UploadsLastFrame = 0;
+    stats.BytesLastFrame = 0;
+
+    const auto completed = RetireBatches(false);
+    if (!completed.empty())
+    {
+        MaterialManager::getInstance()->RefreshTextureBindings(completed);
+    }
+
+    UpdateResidency();
+
+    // Lo decodificado que entra en el presupuesto del frame (al menos una textura para no atascarse)
+    std::vector<std::unique_ptr<Request>> ready;
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        VkDeviceSize budget = 0;
+        while (!decoded.empty())
+        {
+            const VkDeviceSize size = static_cast<VkDeviceSize>(decoded.front()->Data.size());
+            if (!ready.empty() && budget + size > MaxUploadBytesPerFrame)
+                break;
+
+            budget += size;
+            ready.push_back(std::move(decoded.front()));
+            decoded.pop_front();
+        }
+    }
+
+    UploadBatch batch;
+    std::vector<StagedUpload> uploads;
+    uploads.reserve(ready.size());
+
+    for (size_t i = 0; i < ready.size(); ++i)
+    {
+        Request& request = *ready[i];
+
+        auto texture = request.Texture.lock();
+        if (!texture)
+        {
+            ReleasePending(request.Initial);
+            continue;
+        }
+
+        if (!request.Error.empty() || request.Levels.empty())
+        {
+            if (request.Error.empty())
+                request.Error = "Texture has no data: " + request.Path;
+
+            QE_LOG_ERROR_CAT_F("QETextureStreamer", "{}", request.Error);
+            if (request.Initial)
+                ++stats.Failed;
+
+            // Sin seguimiento: se queda con lo que tenga residente y no se reintenta cada frame
+            tracked.erase(texture.get());
+            ReleasePending(request.Initial);
+            continue;
+        }
+
+        StagedUpload upload;
+        if (!StageUpload(request, batch, upload))
+        {
+            // Vuelve al principio de la cola en el mismo orden
+            std::lock_guard<std::mutex> lock(queueMutex);
+            for (size_t j = ready.size(); j > i; --j)
+            {
+                decoded.push_front(std::move(ready[j - 1]));
+            }
+            break;
+        }
+
+        // La cadena completa se conoce al decodificar la primera vez
+        auto it = tracked.find(texture.get());
+        if (it != tracked.end() && it->second.MipLevels == 0)
+        {
+            Tracked& entry = it->second;
+            entry.Width = request.FullWidth;
+            entry.Height = request.FullHeight;
+            entry.MipLevels = static_cast<uint32_t>(request.LevelBytes.size());
+            entry.LevelBytes = request.LevelBytes;
+            entry.ResidentMip = request.TopMip;
+            entry.PendingMip = request.TopMip;
+        }
+
+        stats.BytesLastFrame += request.Data.size();
+        ++stats.UploadsLastFrame;
+        batch.Images.push_back(upload.Image);
+        uploads.push_back(std::move(upload));
+    }
+
+    if (!uploads.empty())
+    {
+        VkCommandBufferAllocateInfo allocInfo{};
+        allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+        allocInfo.commandPool = commandPool;
+        allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+        allocInfo.commandBufferCount = 1;
+        vkAllocateCommandBuffers(deviceModule->device, &allocInfo, &batch.CommandBuffer);
+
+        VkCommandBufferBeginInfo beginInfo{};
+        beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+        beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+        vkBeginCommandBuffer(batch.CommandBuffer, &beginInfo);
+        RecordUploads(batch.CommandBuffer, uploads);
+        vkEndCommandBuffer(batch.CommandBuffer);
+
+        batch.TimelineValue = ++timelineValue;
+
+        VkTimelineSemaphoreSubmitInfo timelineInfo{};
+        timelineInfo.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+        timelineInfo.signalSemaphoreValueCount = 1;
+        timelineInfo.pSignalSemaphoreValues = &batch.TimelineValue;
+
+        VkSubmitInfo submitInfo{};
+        submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+        submitInfo.pNext = &timelineInfo;
+        submitInfo.commandBufferCount = 1;
+        submitInfo.pCommandBuffers = &batch.CommandBuffer;
+        submitInfo.signalSemaphoreCount = 1;
+        submitInfo.pSignalSemaphores = &timeline;
+
+        if (vkQueueSubmit(queueModule->transferQueue, 1, &submitInfo, VK_NULL_HANDLE) != VK_SUCCESS)
+        {
+            throw std::runtime_error("failed to submit texture streaming batch!");
+        }
+
+        stats.BytesUploaded += stats.BytesLastFrame;
+        inFlight.push_back(std::move(batch));
+    }
+
+    if (hadPending && stats.Pending == 0)
+    {
+        stats.AllResidentMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - firstRequestTime).count();
+        QEKtxTranscodeCache::LogStats();
+    }
+
+    stats.UpdateMsLastFrame = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    stats.MaxUpdateMs = std::max(stats.MaxUpdateMs, stats.UpdateMsLastFrame);
+}
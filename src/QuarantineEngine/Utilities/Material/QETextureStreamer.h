@@ -0,0 +1,238 @@
+#pragma once
+
+#ifndef QE_TEXTURE_STREAMER_H
+#define QE_TEXTURE_STREAMER_H
+
+#include <vulkan/vulkan.hpp>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include <QESingleton.h>
+#include <CustomTexture.h>
+#include <QETextureResidencyPolicy.h>
+
+class DeviceModule;
+class QueueModule;
+
+/// Contadores del streaming; los "LastFrame" son del ultimo Update().
+struct QETextureStreamingStats
+{
+    uint32_t Requested = 0;
+    uint32_t Resident = 0;
+    uint32_t Failed = 0;
+    uint32_t Pending = 0;               // En cola, decodificando o en una subida sin terminar
+    uint32_t UploadsLastFrame = 0;
+    uint64_t BytesLastFrame = 0;
+    uint64_t BytesUploaded = 0;
+    double UpdateMsLastFrame = 0.0;     // Coste en el hilo principal
+    double MaxUpdateMs = 0.0;
+    double AllResidentMs = 0.0;         // De la ultima tanda: primera peticion -> sin pendientes
+
+    // Residencia por mip (acumulados desde el inicio)
+    uint32_t ResidencyPending = 0;      // Recargas de mips en vuelo
+    uint32_t StreamIns = 0;
+    uint32_t Evictions = 0;
+    uint64_t MipsStreamedIn = 0;
+    uint64_t MipsEvicted = 0;
+    uint64_t EvictedBytes = 0;
+};
+
+/// Carga asincrona de texturas 2D. Los hilos de trabajo leen y decodifican (KTX2 transcodificado,
+/// el resto con stb y mips en CPU); el hilo principal, una vez por frame, copia lo decodificado a un
+/// staging ring persistente y lo sube en un solo envio por la cola de transferencia, con un limite
+/// de bytes por frame para no provocar picos. Mientras tanto la textura enlaza NULL_TEXTURE y su bit
+/// de texMask esta apagado; al completarse el timeline de transferencia se adopta la imagen y se
+/// re-enlazan los materiales que la usan (RefreshDescriptorSets, sin esperar a la GPU).
+/// La primera carga solo sube los mips hasta Residency.InitialResidentSize; despues el render informa
+/// de la demanda en pantalla (ReportUsage) y QETextureResidencyPolicy decide que mips cargar o soltar
+/// dentro del presupuesto. Cada cambio vuelve a pasar por la cola con otra cadena de mips.
+class QETextureStreamer : public QESingleton<QETextureStreamer>
+{
+private:
+    friend class QESingleton<QETextureStreamer>;
+
+    struct DecodedLevel
+    {
+        VkDeviceSize Offset = 0;
+        VkDeviceSize Size = 0;
+        uint32_t Width = 0;
+        uint32_t Height = 0;
+    };
+
+    struct Request
+    {
+        std::weak_ptr<CustomTexture> Texture;
+        std::string Path;
+        QEColorSpace ColorSpace = QEColorSpace::SRGB;
+        bool Initial = true;                // Primera carga (cuenta en Pending/Resident)
+        uint32_t InitialSize = 0;           // Primera carga: lado maximo del mip superior, 0 = completa
+        uint32_t TopMip = 0;                // Recargas: mip superior pedido
+
+        // Salida del hilo de trabajo
+        std::vector<uint8_t> Data;
+        std::vector<DecodedLevel> Levels;   // Desde TopMip
+        uint32_t FullWidth = 0;
+        uint32_t FullHeight = 0;
+        std::vector<uint64_t> LevelBytes;   // Cadena completa
+        VkFormat Format = VK_FORMAT_UNDEFINED;
+        std::string Error;
+    };
+
+    struct PendingImage
+    {
+        std::weak_ptr<CustomTexture> Texture;
+        VkImage Image = VK_NULL_HANDLE;
+        VkDeviceMemory Memory = VK_NULL_HANDLE;
+        VkFormat Format = VK_FORMAT_UNDEFINED;
+        uint32_t Width = 0;
+        uint32_t Height = 0;
+        uint32_t MipLevels = 0;
+        uint32_t TopMip = 0;
+        bool Initial = true;
+    };
+
+    struct StagedUpload
+    {
+        PendingImage Image;
+        VkBuffer Source = VK_NULL_HANDLE;
+        VkDeviceSize SourceOffset = 0;
+        std::vector<VkBufferImageCopy> Regions;
+    };
+
+    struct UploadBatch
+    {
+        uint64_t TimelineValue = 0;
+        VkCommandBuffer CommandBuffer = VK_NULL_HANDLE;
+        VkDeviceSize RingBytes = 0;
+        std::vector<PendingImage> Images;
+        std::vector<std::pair<VkBuffer, VkDeviceMemory>> DedicatedStaging;
+    };
+
+    /// Estado de residencia de una textura cargada por el streamer.
+    struct Tracked
+    {
+        std::weak_ptr<CustomTexture> Texture;
+        std::string Path;
+        QEColorSpace ColorSpace = QEColorSpace::SRGB;
+        uint32_t Width = 0;                 // Cadena completa; 0 hasta la primera subida
+        uint32_t Height = 0;
+        uint32_t MipLevels = 0;
+        std::vector<uint64_t> LevelBytes;
+        uint32_t ResidentMip = 0;
+        uint32_t PendingMip = 0;
+        bool Pending = true;
+        bool Observed = false;              // Alguna vez informada por ReportUsage
+        float RequiredMip = -1.0f;          // Minimo pedido en el frame en curso
+        uint64_t LastVisibleFrame = 0;
+    };
+
+    DeviceModule* deviceModule = nullptr;
+    QueueModule* queueModule = nullptr;
+    bool initialized = false;
+    bool bcSupported = false;
+    VkDeviceSize copyAlignment = 16;
+
+    VkCommandPool commandPool = VK_NULL_HANDLE;
+    VkSemaphore timeline = VK_NULL_HANDLE;
+    uint64_t timelineValue = 0;
+    uint64_t completedValue = 0;
+
+    VkBuffer ringBuffer = VK_NULL_HANDLE;
+    VkDeviceMemory ringMemory = VK_NULL_HANDLE;
+    uint8_t* ringMapped = nullptr;
+    VkDeviceSize ringSize = 0;
+    VkDeviceSize ringHead = 0;
+    VkDeviceSize ringUsed = 0;
+
+    std::deque<UploadBatch> inFlight;
+
+    std::vector<std::thread> workers;
+    std::atomic<bool> running{ false };
+    std::mutex queueMutex;
+    std::condition_variable queueCv;
+    std::deque<std::unique_ptr<Request>> requests;
+    std::deque<std::unique_ptr<Request>> decoded;
+
+    std::unordered_map<const CustomTexture*, Tracked> tracked;
+    uint64_t frameIndex = 0;
+
+    QETextureStreamingStats stats;
+    QETextureResidencyStats residencyStats;
+    std::chrono::steady_clock::time_point firstRequestTime;
+
+private:
+    QETextureStreamer() = default;
+
+    void WorkerLoop();
+    static void Decode(Request& request, bool bcSupported);
+    static bool DecodeKtx2(Request& request, bool bcSupported);
+    static bool DecodeImage(Request& request);
+    /// Deja en Data solo los mips desde TopMip.
+    static void SliceLevels(Request& request);
+
+    void PushRequest(std::unique_ptr<Request> request);
+    void ReleasePending(bool initial);
+
+    bool AllocateRing(VkDeviceSize size, VkDeviceSize& outOffset, VkDeviceSize& inOutBatchBytes);
+    /// Copia al ring (o a un staging propio si no cabe nunca) y crea la imagen; false si el ring esta lleno.
+    bool StageUpload(Request& request, UploadBatch& batch, StagedUpload& outUpload);
+    void RecordUploads(VkCommandBuffer cmd, const std::vector<StagedUpload>& uploads);
+    /// Adopta las imagenes de las tandas terminadas; devuelve las texturas que pasan a ser residentes.
+    std::unordered_set<const CustomTexture*> RetireBatches(bool waitAll);
+    void DestroyBatchResources(UploadBatch& batch);
+    /// Pasa la demanda del frame anterior a la politica y encola los cambios de mips.
+    void UpdateResidency();
+
+public:
+    ~QETextureStreamer();
+
+    // Desactivado: GetOrLoadTextureByPath vuelve a la carga sincrona
+    bool Enabled = true;
+    uint32_t WorkerCount = 0;                                       // 0 = hardware_concurrency - 1 (max 4)
+    VkDeviceSize StagingRingSize = 64ull * 1024ull * 1024ull;
+    VkDeviceSize MaxUploadBytesPerFrame = 32ull * 1024ull * 1024ull;
+    QETextureResidencySettings Residency;
+
+    /// Crea el pool de la cola de transferencia, el timeline, el staging ring y los hilos.
+    void Initialize();
+    void Cleanup();
+
+    bool IsStreamingEnabled() const { return Enabled && initialized; }
+
+    /// Pide la textura; 'texture' debe estar construida con el placeholder.
+    void Enqueue(const std::shared_ptr<CustomTexture>& texture, const std::string& path, QEColorSpace cs);
+
+    /// Hilo principal, una vez por frame tras waitForFrameSlot: adopta las subidas terminadas,
+    /// resuelve la residencia y envia las nuevas dentro del presupuesto.
+    void Update();
+
+    /// Al grabar el frame: la textura se ve con 'uvPerPixel' unidades UV por pixel de pantalla.
+    /// Se queda con la mayor demanda del frame; texturas no cargadas por el streamer se ignoran.
+    void ReportUsage(const CustomTexture* texture, float uvPerPixel);
+
+    /// Timeline y valor que el envio grafico debe esperar (texturas ya adoptadas).
+    VkSemaphore GetTimeline() const { return timeline; }
+    uint64_t GetCompletedValue() const { return completedValue; }
+
+    bool HasPendingWork() const { return stats.Pending > 0; }
+    const QETextureStreamingStats& GetStats() const { return stats; }
+    const QETextureResidencyStats& GetResidencyStats() const { return residencyStats; }
+};
+
+
+
+namespace QE
+{
+    using ::QETextureStreamingStats;
+    using ::QETextureStreamer;
+} // namespace QE
+// QE namespace aliases
+#endif // !QE_TEXTURE_STREAMER_H
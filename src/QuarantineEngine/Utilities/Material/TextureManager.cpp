@@ -1,5 +1,6 @@
 #include <TextureManager.h>
 #include <CustomTexture.h>
+#include <QETextureStreamer.h>
 #include <algorithm>
 #include <cctype>
 #include <Logging/QELogMacros.h>
@@ -112,8 +113,19 @@ std::shared_ptr<CustomTexture> TextureManager::GetOrLoadTextureByPath(const std:
     if (it != _pathCache.end() && it->second)
         return it->second;
 
-    // Ojo: type aqu NO es semantic; usa NULL_TYPE (2D normal)
-    auto tex = std::make_shared<CustomTexture>(normalizedPath, TEXTURE_TYPE::NULL_TYPE, cs);
+    // Con streaming se devuelve ya una textura que muestrea NULL_TEXTURE hasta que se sube la real
+    auto streamer = QETextureStreamer::getInstance();
+    std::shared_ptr<CustomTexture> tex;
+    if (streamer->IsStreamingEnabled())
+    {
+        tex = std::make_shared<CustomTexture>(normalizedPath, *this->GetTexture("NULL_TEXTURE"));
+        streamer->Enqueue(tex, normalizedPath, cs);
+    }
+    else
+    {
+        // Ojo: type aqu NO es semantic; usa NULL_TYPE (2D normal)
+        tex = std::make_shared<CustomTexture>(normalizedPath, TEXTURE_TYPE::NULL_TYPE, cs);
+    }
 
     // Guardar bajo el key (no bajo la ruta) para que no colisione srgb/lin
     _textures[key] = tex;
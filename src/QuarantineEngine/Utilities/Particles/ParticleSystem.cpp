@@ -94,7 +94,7 @@ void ParticleSystem::SetDrawCommand(VkCommandBuffer& commandBuffer, uint32_t idx
     }
 
     auto transform = this->GetComponent<QETransform>();
-    vkCmdPushConstants(commandBuffer, pipelineModule->pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(PushConstantStruct), &transform->GetWorldMatrix());
+    vkCmdPushConstants(commandBuffer, pipelineModule->pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(glm::mat4), &transform->GetWorldMatrix());
 
     vkCmdDraw(commandBuffer, this->MaxNumParticles * 6, 1, 0, 0);
 }
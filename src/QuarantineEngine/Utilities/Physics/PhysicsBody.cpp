@@ -82,14 +82,6 @@ void PhysicsBody::UpdateInertia(const glm::vec3 &localInertia)
     this->Inertia = localInertia;
 }
 
-void PhysicsBody::UpdateTransform()
-{
-    if (this->Type == PhysicBodyType::RIGID_BODY)
-    {
-        this->copyTransformtoGLM();
-    }
-}
-
 JPH::ObjectLayer PhysicsBody::ResolveObjectLayer(const PhysicBodyType type, const CollisionFlag group)
 {
     const CollisionFlag effectiveGroup = SanitizeCollisionGroup(group);
@@ -166,6 +158,9 @@ void PhysicsBody::Initialize()
         static_cast<JPH::CollisionGroup::SubGroupID>(SanitizeCollisionMask(this->CollisionMask))
     );
 
+    // PhysicsModule recupera el componente desde los bodies activos sin buscarlo
+    s.mUserData = reinterpret_cast<JPH::uint64>(this);
+
     if (motion == EMotionType::Dynamic)
     {
         s.mOverrideMassProperties = EOverrideMassProperties::CalculateInertia;
@@ -179,30 +174,25 @@ void PhysicsBody::Initialize()
 
     this->body = PhysicsModule::getInstance()->AddRigidBody(s, JPH::EActivation::Activate);
 
-    currPos = pos; currRot = rot;
-    prevPos = pos; prevRot = rot;
-    hasCurr = true;
+    interpolation.CurrPos = pos; interpolation.CurrRot = rot;
+    interpolation.PrevPos = pos; interpolation.PrevRot = rot;
+    appliedPos = pos; appliedRot = rot;
+    interpolation.HasCurr = true;
+    hasApplied = true;
 
     CaptureStateSnapshot();
     lastTransformVersion = transform->GetWorldVersion();
     _QEInitialized = true;
 }
 
-void PhysicsBody::copyTransformtoGLM()
+void PhysicsBody::ApplyPhysicsTransform(const glm::vec3& newPos, const glm::quat& newRot, std::unordered_map<const QETransform*, glm::mat4>& parentInverseCache)
 {
-    if (this->body.IsInvalid() || !transform)
+    if (!transform)
         return;
 
-    RMat44 m = PhysicsModule::getInstance()->Bodies().GetCenterOfMassTransform(this->body);
-    RVec3 p = m.GetTranslation();
-    Quat  q = m.GetRotation().GetQuaternion();
-
-    glm::vec3 newPos = toGLM(p);
-    glm::quat newRot = toGLM(q);
-
-    bool changed = !hasCurr
-        || !closePos(currPos, newPos, posEps)
-        || !closeRot(currRot, newRot, angEps);
+    bool changed = !hasApplied
+        || !closePos(appliedPos, newPos, posEps)
+        || !closeRot(appliedRot, newRot, angEps);
 
     if (!changed)
         return;
@@ -215,17 +205,25 @@ void PhysicsBody::copyTransformtoGLM()
     glm::mat4 localM = worldM;
     if (auto parent = transform->GetParent())
     {
-        glm::mat4 parentWorld = parent->GetWorldMatrix();
-        localM = glm::inverse(parentWorld) * worldM;
+        // Hermanos bajo el mismo padre comparten la inversa
+        auto it = parentInverseCache.find(parent.get());
+        if (it == parentInverseCache.end())
+        {
+            it = parentInverseCache.emplace(parent.get(), glm::inverse(parent->GetWorldMatrix())).first;
+        }
+        localM = it->second * worldM;
     }
 
     applyingPhysicsTransform = true;
     transform->SetFromMatrix(localM);
     applyingPhysicsTransform = false;
 
-    currPos = newPos;
-    currRot = newRot;
-    hasCurr = true;
+    // Si este transform es padre de otro body del lote, su inversa cacheada ya no vale
+    parentInverseCache.erase(transform.get());
+
+    appliedPos = newPos;
+    appliedRot = newRot;
+    hasApplied = true;
     lastTransformVersion = transform->GetWorldVersion();
 }
 
@@ -358,8 +356,14 @@ void PhysicsBody::QEUpdate()
 {
     if (this->Owner == nullptr) return;
 
-    this->collider = this->Owner->GetComponentInChildren<QECollider>(true);
-    this->transform = this->Owner->GetComponent<QETransform>();
+    // Las busquedas de componentes solo se repiten si la estructura de la escena ha cambiado
+    const uint32_t structureVersion = QEGameObject::GetStructureVersion();
+    if (structureVersion != lastStructureVersion || !this->transform)
+    {
+        this->collider = this->Owner->GetComponentInChildren<QECollider>(true);
+        this->transform = this->Owner->GetComponent<QETransform>();
+        lastStructureVersion = structureVersion;
+    }
 
     if (!this->collider)
     {
@@ -375,10 +379,10 @@ void PhysicsBody::QEUpdate()
         QEGameComponent::QEInit();
     }
 
+    // La copia fisica -> transform la hace PhysicsModule (SyncActiveBodies + ApplyInterpolatedTransforms)
     if (this->QEInitialized())
     {
         RefreshEditorState();
-        UpdateTransform();
     }
 }
 
@@ -423,9 +427,11 @@ void PhysicsBody::PushTransformToPhysics(bool resetVelocities)
         bodies.SetLinearAndAngularVelocity(body, JPH::Vec3::sZero(), JPH::Vec3::sZero());
     }
 
-    currPos = worldPos;
-    currRot = worldRot;
-    hasCurr = true;
+    // Teletransporte: no se interpola desde la pose anterior
+    interpolation.CurrPos = interpolation.PrevPos = appliedPos = worldPos;
+    interpolation.CurrRot = interpolation.PrevRot = appliedRot = worldRot;
+    interpolation.HasCurr = true;
+    hasApplied = true;
 }
 
 void PhysicsBody::SyncShapeAndBodyToEditorState()
@@ -507,33 +513,43 @@ bool PhysicsBody::HasColliderDefinitionChanged() const
     if (!transform || !collider)
         return false;
 
+    // Mismo collider => mismo tipo: basta con static_pointer_cast segun lastColliderKind
     if (collider != previousCollider)
         return true;
 
-    if (DetectColliderKind(collider) != lastColliderKind)
-        return true;
-
     if (!closePos(transform->GetWorldScale(), lastWorldScale, 0.0001f))
         return true;
 
     if (fabsf(collider->CollisionMargin - lastColliderMargin) > 0.0001f)
         return true;
 
-    if (auto box = std::dynamic_pointer_cast<BoxCollider>(collider))
+    switch (lastColliderKind)
+    {
+    case 1:
+    {
+        auto box = std::static_pointer_cast<BoxCollider>(collider);
         return !closePos(box->GetSize(), lastColliderVecA, 0.0001f);
-
-    if (auto sphere = std::dynamic_pointer_cast<SphereCollider>(collider))
+    }
+    case 2:
+    {
+        auto sphere = std::static_pointer_cast<SphereCollider>(collider);
         return fabsf(sphere->GetRadius() - lastColliderFloatA) > 0.0001f;
-
-    if (auto capsule = std::dynamic_pointer_cast<CapsuleCollider>(collider))
+    }
+    case 3:
+    {
+        auto capsule = std::static_pointer_cast<CapsuleCollider>(collider);
         return fabsf(capsule->GetRadius() - lastColliderFloatA) > 0.0001f
             || fabsf(capsule->GetHeight() - lastColliderVecA.x) > 0.0001f;
-
-    if (auto plane = std::dynamic_pointer_cast<PlaneCollider>(collider))
+    }
+    case 4:
+    {
+        auto plane = std::static_pointer_cast<PlaneCollider>(collider);
         return fabsf(plane->GetSize() - lastColliderFloatA) > 0.0001f
             || !closePos(glm::vec3(plane->GetExtents().x, plane->GetExtents().y, 0.0f), lastColliderVecA, 0.0001f);
-
-    return false;
+    }
+    default:
+        return false;
+    }
 }
 
 bool PhysicsBody::HasBodyRecreationConfigurationChanged() const
@@ -581,7 +597,8 @@ void PhysicsBody::DestroyRuntimeBody()
     }
 
     _QEInitialized = false;
-    hasCurr = false;
+    interpolation.HasCurr = false;
+    hasApplied = false;
 }
 
 void PhysicsBody::RecreateBody()
@@ -5,7 +5,9 @@
 #include "QETransform.h"
 #include <Collider.h>
 #include <glm/matrix.hpp>
+#include <unordered_map>
 #include "PhysicsTypes.h"
+#include "QEPhysicsInterpolation.h"
 
 // Jolt
 #include <Jolt/Jolt.h>
@@ -19,17 +21,23 @@
 class PhysicsBody : public QEGameComponent
 {
     REFLECTABLE_DERIVED_COMPONENT(PhysicsBody, QEGameComponent)
+    friend class PhysicsModule;
 private:
     std::shared_ptr<QETransform> transform;
     std::shared_ptr<QECollider> collider;
     std::shared_ptr<QECollider> previousCollider;
 
-    // Estado previo/actual para interpolación
-    glm::vec3 prevPos{}, currPos{};
-    glm::quat prevRot{}, currRot{};
-    bool hasCurr{ false };
+    // Estado previo/actual para interpolación (poses de los dos ultimos pasos fijos)
+    QEPhysicsInterpolationState interpolation;
+    uint64_t lastSyncId{ 0 };
+
+    // Ultima pose escrita en el transform
+    glm::vec3 appliedPos{};
+    glm::quat appliedRot{};
+    bool hasApplied{ false };
     bool applyingPhysicsTransform{ false };
     uint32_t lastTransformVersion{ 0 };
+    uint32_t lastStructureVersion{ UINT32_MAX };
 
     glm::vec3 lastWorldScale{ 1.0f };
     glm::vec3 lastColliderVecA{ 0.0f };
@@ -74,9 +82,8 @@ public:
     void RefreshEditorState();
 private:
     void Initialize();
-    void copyTransformtoGLM();
+    void ApplyPhysicsTransform(const glm::vec3& newPos, const glm::quat& newRot, std::unordered_map<const QETransform*, glm::mat4>& parentInverseCache);
     void RebuildScaledShapeFromCollider();
-    void UpdateTransform();
     void PushTransformToPhysics(bool resetVelocities);
     void SyncShapeAndBodyToEditorState();
     void CaptureStateSnapshot();
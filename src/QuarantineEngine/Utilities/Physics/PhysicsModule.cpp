@@ -3,6 +3,9 @@
 #include <algorithm>
 #include <QECharacterController.h>
 #include <PhysicsBody.h>
+#include <QEPhysicsInterpolation.h>
+#include <Jolt/Physics/Body/Body.h>
+#include <Jolt/Physics/Body/BodyLockInterface.h>
 
 using namespace JPH;
 
@@ -197,6 +200,10 @@ void PhysicsModule::UnregisterBodyComponent(PhysicsBody* bodyComponent)
     auto it = std::find(m_bodyComponents.begin(), m_bodyComponents.end(), bodyComponent);
     if (it != m_bodyComponents.end())
         m_bodyComponents.erase(it);
+
+    auto interpolatedIt = std::find(m_interpolatedBodies.begin(), m_interpolatedBodies.end(), bodyComponent);
+    if (interpolatedIt != m_interpolatedBodies.end())
+        m_interpolatedBodies.erase(interpolatedIt);
 }
 
 void PhysicsModule::SyncEditorBodies()
@@ -213,6 +220,109 @@ void PhysicsModule::ComputePhysics(float fixedDt)
     m_system.Update(fixedDt, /*collisionSteps*/1, m_temp.get(), m_jobs.get());
 }
 
+void PhysicsModule::ComputeFixedSteps(int steps, float fixedDt)
+{
+    QERunFixedSteps(steps,
+        [this]() { this->CapturePreviousPoses(); },
+        [this, fixedDt]() { this->ComputePhysics(fixedDt); },
+        [this]() { this->SyncActiveBodies(); });
+}
+
+void PhysicsModule::CapturePreviousPoses()
+{
+    m_system.GetActiveBodies(EBodyType::RigidBody, m_activeBodies);
+
+    const BodyLockInterfaceNoLock& lockInterface = m_system.GetBodyLockInterfaceNoLock();
+    const uint64_t captureId = m_syncId + 1;
+
+    for (const BodyID& id : m_activeBodies)
+    {
+        const Body* body = lockInterface.TryGetBody(id);
+        if (body == nullptr || body->GetMotionType() != EMotionType::Dynamic)
+            continue;
+
+        auto* bodyComponent = reinterpret_cast<PhysicsBody*>(body->GetUserData());
+        if (bodyComponent == nullptr)
+            continue;
+
+        const RMat44 transform = body->GetCenterOfMassTransform();
+        const RVec3 position = transform.GetTranslation();
+        const Quat rotation = transform.GetRotation().GetQuaternion();
+
+        QECapturePhysicsPose(bodyComponent->interpolation,
+            glm::vec3(position.GetX(), position.GetY(), position.GetZ()),
+            glm::quat(rotation.GetW(), rotation.GetX(), rotation.GetY(), rotation.GetZ()),
+            captureId);
+    }
+}
+
+void PhysicsModule::SyncActiveBodies()
+{
+    ++m_syncId;
+    m_interpolatedScratch.clear();
+
+    // Los bodies dormidos no aparecen en la lista: su coste es nulo
+    m_system.GetActiveBodies(EBodyType::RigidBody, m_activeBodies);
+
+    // Fuera de Update nadie escribe en los bodies: se leen sin bloquear
+    const BodyLockInterfaceNoLock& lockInterface = m_system.GetBodyLockInterfaceNoLock();
+
+    for (const BodyID& id : m_activeBodies)
+    {
+        const Body* body = lockInterface.TryGetBody(id);
+        if (body == nullptr || body->GetMotionType() != EMotionType::Dynamic)
+            continue;
+
+        auto* bodyComponent = reinterpret_cast<PhysicsBody*>(body->GetUserData());
+        if (bodyComponent == nullptr)
+            continue;
+
+        const RMat44 transform = body->GetCenterOfMassTransform();
+        const RVec3 position = transform.GetTranslation();
+        const Quat rotation = transform.GetRotation().GetQuaternion();
+
+        QESyncPhysicsPose(bodyComponent->interpolation,
+            glm::vec3(position.GetX(), position.GetY(), position.GetZ()),
+            glm::quat(rotation.GetW(), rotation.GetX(), rotation.GetY(), rotation.GetZ()),
+            m_syncId);
+        bodyComponent->lastSyncId = m_syncId;
+        m_interpolatedScratch.push_back(bodyComponent);
+    }
+
+    m_lastSyncedBodies = m_interpolatedScratch.size();
+
+    // Los que se acaban de dormir reciben una ultima escritura con su pose final.
+    // lastSyncId no se actualiza: en el siguiente sync salen de la lista.
+    for (PhysicsBody* bodyComponent : m_interpolatedBodies)
+    {
+        if (bodyComponent->lastSyncId == m_syncId - 1)
+        {
+            bodyComponent->interpolation.PrevPos = bodyComponent->interpolation.CurrPos;
+            bodyComponent->interpolation.PrevRot = bodyComponent->interpolation.CurrRot;
+            m_interpolatedScratch.push_back(bodyComponent);
+        }
+    }
+
+    std::swap(m_interpolatedBodies, m_interpolatedScratch);
+}
+
+void PhysicsModule::ApplyInterpolatedTransforms(float alpha)
+{
+    if (m_interpolatedBodies.empty())
+        return;
+
+    // Escritura en bloque: la inversa del padre se calcula una vez por padre, no por body
+    m_parentInverseCache.clear();
+    for (PhysicsBody* bodyComponent : m_interpolatedBodies)
+    {
+        const QEPhysicsInterpolationState& state = bodyComponent->interpolation;
+        const QEPhysicsPose pose = QEInterpolatePhysicsPose(
+            state.PrevPos, state.PrevRot, state.CurrPos, state.CurrRot,
+            alpha, this->InterpolationEnabled);
+        bodyComponent->ApplyPhysicsTransform(pose.Position, pose.Rotation, m_parentInverseCache);
+    }
+}
+
 void PhysicsModule::SetGravity(float gravityY)
 {
     m_gravity = Vec3(0.0f, gravityY, 0.0f);
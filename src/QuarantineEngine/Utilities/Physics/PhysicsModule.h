@@ -15,6 +15,10 @@
 #include <Jolt/Physics/Body/BodyInterface.h>
 #include <Jolt/Physics/Collision/GroupFilter.h>
 
+#include <unordered_map>
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
 namespace Layers
 {
     enum : JPH::ObjectLayer
@@ -31,6 +35,7 @@ namespace Layers
 
 class QECharacterController;
 class PhysicsBody;
+class QETransform;
 
 class PhysicsModule : public QESingleton<PhysicsModule>
 {
@@ -49,7 +54,22 @@ private:
     std::unique_ptr<JPH::ObjectLayerPairFilter> m_pairFilter;
     JPH::Ref<JPH::GroupFilter> m_collisionFilter;
     std::vector<PhysicsBody*> m_bodyComponents;
+
+    JPH::BodyIDVector m_activeBodies;
+    std::vector<PhysicsBody*> m_interpolatedBodies;
+    std::vector<PhysicsBody*> m_interpolatedScratch;
+    std::unordered_map<const QETransform*, glm::mat4> m_parentInverseCache;
+    uint64_t m_syncId = 0;
+    size_t m_lastSyncedBodies = 0;
+
+private:
+    void CapturePreviousPoses();
+    void SyncActiveBodies();
+
 public:
+    /// Si es false el transform recibe directamente la pose del ultimo paso (sin interpolar).
+    bool InterpolationEnabled = true;
+
     JoltDebugRenderer* DebugDrawer = nullptr;
 
 public:
@@ -89,6 +109,12 @@ public:
     void UnregisterBodyComponent(PhysicsBody* bodyComponent);
     const JPH::GroupFilter* GetCollisionFilter() const { return m_collisionFilter.GetPtr(); }
     void SyncEditorBodies();
+    /// Ejecuta los pasos fijos del frame y guarda, para cada body despierto, la pose antes y despues del ultimo paso.
+    void ComputeFixedSteps(int steps, float fixedDt);
+    /// Escribe en bloque en los QETransform la pose interpolada entre los dos ultimos pasos (alpha = Timer::RenderAlpha).
+    void ApplyInterpolatedTransforms(float alpha);
+    size_t GetLastSyncedBodyCount() const { return m_lastSyncedBodies; }
+    size_t GetInterpolatedBodyCount() const { return m_interpolatedBodies.size(); }
 
     ~PhysicsModule();
 };
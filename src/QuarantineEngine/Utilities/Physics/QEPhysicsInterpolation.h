@@ -0,0 +1,116 @@
+#pragma once
+
+#ifndef QE_PHYSICS_INTERPOLATION_H
+#define QE_PHYSICS_INTERPOLATION_H
+
+#include <algorithm>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+/// Pose de render de un body fisico.
+struct QEPhysicsPose
+{
+    glm::vec3 Position = glm::vec3(0.0f);
+    glm::quat Rotation = glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
+};
+
+/// Acumula deltaTime y devuelve cuantos pasos fijos hay que ejecutar este frame.
+/// outAlpha es la fraccion de paso que queda en el acumulador (Timer::RenderAlpha).
+inline int QEAdvanceFixedSteps(float& accumulator, float deltaTime, float fixedDelta, float& outAlpha)
+{
+    accumulator += deltaTime;
+    int steps = 0;
+    while (accumulator >= fixedDelta)
+    {
+        steps++;
+        accumulator -= fixedDelta;
+    }
+    outAlpha = accumulator / fixedDelta;
+    return steps;
+}
+
+/// Orden de los pasos fijos de un frame (PhysicsModule::ComputeFixedSteps): la pose previa se
+/// captura justo antes del ultimo paso y la pose actual se lee una vez, tras el ultimo paso.
+template <typename CaptureFn, typename StepFn, typename SyncFn>
+inline void QERunFixedSteps(int steps, CaptureFn&& capturePrevious, StepFn&& step, SyncFn&& syncCurrent)
+{
+    for (int i = 0; i < steps; ++i)
+    {
+        // Solo interesa la pose previa al ultimo paso: RenderAlpha se mide desde ahi
+        if (i == steps - 1)
+            capturePrevious();
+
+        step();
+    }
+
+    if (steps > 0)
+        syncCurrent();
+}
+
+/// Estado de interpolacion de un body (los campos prev/curr de PhysicsBody).
+struct QEPhysicsInterpolationState
+{
+    glm::vec3 PrevPos = glm::vec3(0.0f);
+    glm::vec3 CurrPos = glm::vec3(0.0f);
+    glm::quat PrevRot = glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
+    glm::quat CurrRot = glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
+    bool HasCurr = false;
+    uint64_t PrevCaptureId = 0;
+};
+
+/// Guarda la pose previa al ultimo paso (CapturePreviousPoses). captureId es el id del sync que viene.
+inline void QECapturePhysicsPose(QEPhysicsInterpolationState& state,
+    const glm::vec3& position, const glm::quat& rotation, uint64_t captureId)
+{
+    state.PrevPos = position;
+    state.PrevRot = rotation;
+    state.PrevCaptureId = captureId;
+}
+
+/// Guarda la pose tras el ultimo paso (SyncActiveBodies). Un body sin captura en este sync se ha
+/// despertado durante el ultimo paso: estaba quieto en su pose anterior.
+inline void QESyncPhysicsPose(QEPhysicsInterpolationState& state,
+    const glm::vec3& position, const glm::quat& rotation, uint64_t syncId)
+{
+    if (state.PrevCaptureId != syncId)
+    {
+        state.PrevPos = state.HasCurr ? state.CurrPos : position;
+        state.PrevRot = state.HasCurr ? state.CurrRot : rotation;
+    }
+
+    state.CurrPos = position;
+    state.CurrRot = rotation;
+    state.HasCurr = true;
+}
+
+/// Pose entre el penultimo y el ultimo paso fijo. prev tiene que ser la pose de antes del ultimo
+/// paso del frame, no la del frame anterior: con varios pasos en un frame alpha se mide desde ahi.
+/// Sin interpolacion devuelve la pose del ultimo paso.
+inline QEPhysicsPose QEInterpolatePhysicsPose(
+    const glm::vec3& prevPos, const glm::quat& prevRot,
+    const glm::vec3& currPos, const glm::quat& currRot,
+    float alpha, bool interpolate = true)
+{
+    const float t = interpolate ? std::clamp(alpha, 0.0f, 1.0f) : 1.0f;
+
+    QEPhysicsPose pose;
+    pose.Position = glm::mix(prevPos, currPos, t);
+    pose.Rotation = glm::slerp(prevRot, currRot, t);
+    return pose;
+}
+
+
+
+namespace QE
+{
+    using ::QEPhysicsPose;
+    using ::QEAdvanceFixedSteps;
+    using ::QERunFixedSteps;
+    using ::QEPhysicsInterpolationState;
+    using ::QECapturePhysicsPose;
+    using ::QESyncPhysicsPose;
+    using ::QEInterpolatePhysicsPose;
+} // namespace QE
+// QE namespace aliases
+#endif // !QE_PHYSICS_INTERPOLATION_H
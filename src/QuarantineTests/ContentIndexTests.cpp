@@ -0,0 +1,165 @@
+// Pruebas en CPU de QEContentIndex: hash de las texturas fuente, registro y busqueda de assets
+// compartidos entre modelos, persistencia del indice y descarte de entradas cuyo archivo ya no existe.
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <QEContentIndex.h>
+#include "QETestHarness.h"
+
+namespace
+{
+    /// Proyecto temporal propio de cada caso; se borra al salir.
+    struct TempProject
+    {
+        fs::path Path;
+
+        explicit TempProject(const std::string& name)
+        {
+            Path = fs::temp_directory_path() / ("qe_content_index_tests_" + name);
+            fs::remove_all(Path);
+            fs::create_directories(Path);
+        }
+
+        ~TempProject()
+        {
+            std::error_code ec;
+            fs::remove_all(Path, ec);
+        }
+    };
+
+    fs::path WriteFile(const fs::path& path, const std::string& content)
+    {
+        fs::create_directories(path.parent_path());
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file << content;
+        return path;
+    }
+
+    uint64_t HashSource(const fs::path& path, uint32_t semantic, uint32_t colorSpace)
+    {
+        uint64_t hash = 0;
+        QE_CHECK_MSG(QEContentIndex::HashTextureSource(path, semantic, colorSpace, hash), "could not hash " + path.generic_string());
+        return hash;
+    }
+}
+
+QE_TEST(IdenticalSourcesShareTheTextureHash)
+{
+    TempProject project("hash");
+    const fs::path first = WriteFile(project.Path / "ModelA" / "albedo.png", "same pixels");
+    const fs::path copy = WriteFile(project.Path / "ModelB" / "other name.png", "same pixels");
+    const fs::path edited = WriteFile(project.Path / "ModelC" / "albedo.png", "same pixels!");
+
+    // El contenido manda, no la ruta ni el nombre
+    QE_CHECK_EQ(HashSource(first, 0, 1), HashSource(copy, 0, 1));
+    QE_CHECK(HashSource(first, 0, 1) != HashSource(edited, 0, 1));
+
+    // Misma imagen como otra semantica o en otro espacio de color genera otro KTX2
+    QE_CHECK(HashSource(first, 0, 1) != HashSource(first, 1, 1));
+    QE_CHECK(HashSource(first, 0, 1) != HashSource(first, 0, 0));
+
+    uint64_t hash = 0;
+    uint64_t size = 0;
+    QE_CHECK(QEContentIndex::HashFile(first, hash, size));
+    QE_CHECK_EQ(size, static_cast<uint64_t>(11));
+
+    QE_CHECK(!QEContentIndex::HashFile(project.Path / "missing.png", hash, size));
+    QE_CHECK(!QEContentIndex::HashTextureSource(WriteFile(project.Path / "empty.png", ""), 0, 0, hash));
+}
+
+QE_TEST(RegisteredAssetsAreFoundAfterReload)
+{
+    TempProject project("reload");
+    TempProject otherProject("reload_other");
+    const fs::path texture = WriteFile(project.Path / "QEAssets" / "QEModels" / "Crate" / "Textures" / "crate_diffuse.ktx2", "ktx2 data");
+    const fs::path material = WriteFile(project.Path / "QEAssets" / "QEModels" / "Crate" / "Materials" / "Wood.qemat", "material");
+
+    QEContentIndex::Register(project.Path, QEContentKind::Texture, 0x1111u, texture);
+    QEContentIndex::Register(project.Path, QEContentKind::Material, 0x2222u, material, "Wood");
+
+    QEContentEntry entry;
+    QE_CHECK(QEContentIndex::Find(project.Path, QEContentKind::Texture, 0x1111u, entry));
+    QE_CHECK_EQ(entry.Path, std::string("QEAssets/QEModels/Crate/Textures/crate_diffuse.ktx2"));
+    QE_CHECK_EQ(entry.Size, static_cast<uint64_t>(9));
+
+    // Texturas y materiales no comparten hashes
+    QE_CHECK(!QEContentIndex::Find(project.Path, QEContentKind::Material, 0x1111u, entry));
+
+    QE_CHECK(QEContentIndex::Save());
+    QE_CHECK(fs::exists(QEContentIndex::GetIndexPath(project.Path)));
+    QE_CHECK(QEContentIndex::GetIndexPath(project.Path) == project.Path / "QEAssets" / QEContentIndex::INDEX_FILE);
+
+    // Otro proyecto tiene su propio indice; al volver se lee el guardado
+    QE_CHECK(!QEContentIndex::Find(otherProject.Path, QEContentKind::Texture, 0x1111u, entry));
+    QE_CHECK(QEContentIndex::Find(project.Path, QEContentKind::Material, 0x2222u, entry));
+    QE_CHECK_EQ(entry.Name, std::string("Wood"));
+    QE_CHECK(QEContentIndex::FindMaterialByName(project.Path, "Wood") == material.lexically_normal());
+    QE_CHECK(QEContentIndex::FindMaterialByName(project.Path, "Metal").empty());
+}
+
+QE_TEST(MissingAssetsAreDroppedOnLookup)
+{
+    TempProject project("missing");
+    TempProject otherProject("missing_other");
+    const fs::path texture = WriteFile(project.Path / "QEAssets" / "QEModels" / "A" / "Textures" / "a.ktx2", "ktx2");
+    const fs::path material = WriteFile(project.Path / "QEAssets" / "QEModels" / "A" / "Materials" / "Stone.qemat", "material");
+
+    QEContentIndex::Register(project.Path, QEContentKind::Texture, 0x3333u, texture);
+    QEContentIndex::Register(project.Path, QEContentKind::Material, 0x4444u, material, "Stone");
+    QE_CHECK(QEContentIndex::Save());
+
+    // El modelo que importo los assets se borra: los demas ya no pueden reutilizarlos
+    fs::remove_all(project.Path / "QEAssets" / "QEModels" / "A");
+
+    QEContentEntry entry;
+    QE_CHECK(!QEContentIndex::Find(project.Path, QEContentKind::Texture, 0x3333u, entry));
+    QE_CHECK(QEContentIndex::FindMaterialByName(project.Path, "Stone").empty());
+    QE_CHECK(QEContentIndex::Save());
+
+    // La entrada descartada no vuelve al recargar, aunque el archivo reaparezca
+    WriteFile(texture, "ktx2");
+    QE_CHECK(!QEContentIndex::Find(otherProject.Path, QEContentKind::Texture, 0x3333u, entry));
+    QE_CHECK(!QEContentIndex::Find(project.Path, QEContentKind::Texture, 0x3333u, entry));
+}
+
+QE_TEST(DisabledOrBrokenIndexImportsStandalone)
+{
+    TempProject project("disabled");
+    const fs::path texture = WriteFile(project.Path / "QEAssets" / "t.ktx2", "ktx2");
+    QEContentEntry entry;
+
+    QEContentIndex::Enabled = false;
+    QEContentIndex::Register(project.Path, QEContentKind::Texture, 0x5555u, texture);
+    QE_CHECK(!QEContentIndex::Find(project.Path, QEContentKind::Texture, 0x5555u, entry));
+    QEContentIndex::Enabled = true;
+    QE_CHECK(!QEContentIndex::Find(project.Path, QEContentKind::Texture, 0x5555u, entry));
+
+    // Sin proyecto no hay indice
+    QEContentIndex::Register(fs::path(), QEContentKind::Texture, 0x5555u, texture);
+    QE_CHECK(!QEContentIndex::Find(fs::path(), QEContentKind::Texture, 0x5555u, entry));
+    QE_CHECK(!QEContentIndex::Find(project.Path / "not a project", QEContentKind::Texture, 0x5555u, entry));
+    QE_CHECK(QEContentIndex::GetIndexPath(fs::path()).empty());
+
+    // Un indice ilegible o de otra version se ignora: solo se pierde la deduplicacion
+    TempProject broken("broken");
+    WriteFile(QEContentIndex::GetIndexPath(broken.Path), "Version: [unclosed\n");
+    QE_CHECK(!QEContentIndex::Find(broken.Path, QEContentKind::Texture, 0x6666u, entry));
+
+    const std::string entries = "Textures:\n  - Hash: \"0000000000006666\"\n    Path: QEAssets/t.ktx2\n    Size: 4\n";
+    TempProject current("current_version");
+    WriteFile(current.Path / "QEAssets" / "t.ktx2", "ktx2");
+    WriteFile(QEContentIndex::GetIndexPath(current.Path), "Version: 1\n" + entries);
+    QE_CHECK(QEContentIndex::Find(current.Path, QEContentKind::Texture, 0x6666u, entry));
+
+    TempProject oldVersion("old_version");
+    WriteFile(oldVersion.Path / "QEAssets" / "t.ktx2", "ktx2");
+    WriteFile(QEContentIndex::GetIndexPath(oldVersion.Path), "Version: 0\n" + entries);
+    QE_CHECK(!QEContentIndex::Find(oldVersion.Path, QEContentKind::Texture, 0x6666u, entry));
+}
+
+int main()
+{
+    return QERunTests();
+}
@@ -0,0 +1,242 @@
+// Pruebas en CPU de la serializacion por metadatos (QEMetaCodec): ida y vuelta YAML y binaria de
+// los campos de un componente, hash del layout y lectura por nombre cuando el componente ha cambiado.
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <QEMetaCodec.h>
+#include "QETestHarness.h"
+
+namespace
+{
+    /// Offset de un miembro sin offsetof (los componentes no son standard layout).
+    template<typename T, typename F>
+    size_t FieldOffset(F T::* member)
+    {
+        static const T probe{};
+        return static_cast<size_t>(reinterpret_cast<const char*>(&(probe.*member)) - reinterpret_cast<const char*>(&probe));
+    }
+
+    QEMetaType MakeMeta(const std::string& typeName)
+    {
+        QEMetaType meta;
+        meta.typeName = typeName;
+        return meta;
+    }
+
+    /// Componente de prueba con los metadatos montados a mano, como los de REFLECT_PROPERTY.
+    struct PlayerComponent : SerializableComponent
+    {
+        std::string id = "player";
+        int health = 100;
+        uint32_t mask = 0x3u;
+        bool enabled = true;
+        float speed = 1.5f;
+        std::vector<std::string> tags;
+        double noCodec = 0.25;
+
+        static QEMetaType* staticMeta()
+        {
+            static QEMetaType meta = []()
+                {
+                    QEMetaType type = MakeMeta("PlayerComponent");
+                    type.addField("id", typeid(std::string), FieldOffset(&PlayerComponent::id));
+                    type.addField("health", typeid(int), FieldOffset(&PlayerComponent::health));
+                    type.addField("mask", typeid(uint32_t), FieldOffset(&PlayerComponent::mask));
+                    type.addField("enabled", typeid(bool), FieldOffset(&PlayerComponent::enabled));
+                    type.addField("speed", typeid(float), FieldOffset(&PlayerComponent::speed));
+                    type.addField("tags", typeid(std::vector<std::string>), FieldOffset(&PlayerComponent::tags));
+                    type.addField("noCodec", typeid(double), FieldOffset(&PlayerComponent::noCodec));
+                    return type;
+                }();
+            return &meta;
+        }
+
+        QEMetaType* meta() const override { return staticMeta(); }
+        const std::string& getTypeName() const override { return staticMeta()->typeName; }
+    };
+
+    /// Version posterior del componente: campos reordenados, 'health' pasa a float, 'mask' y
+    /// 'tags' desaparecen y hay un campo nuevo.
+    struct PlayerComponentV2 : SerializableComponent
+    {
+        float speed = 0.0f;
+        std::string id;
+        float health = -1.0f;
+        bool enabled = false;
+        int armor = 7;
+
+        static QEMetaType* staticMeta()
+        {
+            static QEMetaType meta = []()
+                {
+                    QEMetaType type = MakeMeta("PlayerComponent");
+                    type.addField("speed", typeid(float), FieldOffset(&PlayerComponentV2::speed));
+                    type.addField("id", typeid(std::string), FieldOffset(&PlayerComponentV2::id));
+                    type.addField("health", typeid(float), FieldOffset(&PlayerComponentV2::health));
+                    type.addField("enabled", typeid(bool), FieldOffset(&PlayerComponentV2::enabled));
+                    type.addField("armor", typeid(int), FieldOffset(&PlayerComponentV2::armor));
+                    return type;
+                }();
+            return &meta;
+        }
+
+        QEMetaType* meta() const override { return staticMeta(); }
+        const std::string& getTypeName() const override { return staticMeta()->typeName; }
+    };
+
+    PlayerComponent MakePlayer()
+    {
+        PlayerComponent player;
+        player.id = "hero";
+        player.health = -25;
+        player.mask = 0xF0F0u;
+        player.enabled = false;
+        player.speed = 3.25f;
+        player.tags = { "friendly", "", "spawn point" };
+        player.noCodec = 9.0;
+        return player;
+    }
+
+    void CheckSamePlayer(const PlayerComponent& a, const PlayerComponent& b)
+    {
+        QE_CHECK_EQ(a.id, b.id);
+        QE_CHECK_EQ(a.health, b.health);
+        QE_CHECK_EQ(a.mask, b.mask);
+        QE_CHECK_EQ(a.enabled, b.enabled);
+        QE_CHECK_EQ(a.speed, b.speed);
+        QE_CHECK(a.tags == b.tags);
+    }
+
+    QEBinaryReader ReaderOf(const QEBinaryWriter& writer)
+    {
+        return QEBinaryReader(writer.Data(), writer.Size());
+    }
+}
+
+QE_TEST(BinaryRoundTripRestoresEveryField)
+{
+    const PlayerComponent source = MakePlayer();
+
+    QEBinaryWriter writer;
+    serializeComponentBinary(&source, writer);
+    writer.Write(uint32_t(0xC0FFEEu));
+
+    PlayerComponent loaded;
+    QEBinaryReader reader = ReaderOf(writer);
+    QE_CHECK(deserializeComponentBinary(&loaded, reader));
+    CheckSamePlayer(loaded, source);
+
+    // El campo sin codec no se escribe ni se toca
+    QE_CHECK_EQ(loaded.noCodec, 0.25);
+
+    // El lector queda justo detras del componente
+    uint32_t marker = 0;
+    QE_CHECK(reader.Read(marker) && marker == 0xC0FFEEu);
+    QE_CHECK(reader.AtEnd());
+}
+
+QE_TEST(YamlRoundTripRestoresEveryField)
+{
+    const PlayerComponent source = MakePlayer();
+    const YAML::Node node = serializeComponent(&source);
+    QE_CHECK_EQ(node["type"].as<std::string>(), std::string("PlayerComponent"));
+    QE_CHECK_EQ(node["noCodec"].as<std::string>(), std::string("<unsupported type>"));
+
+    PlayerComponent loaded;
+    deserializeComponent(&loaded, YAML::Load(YAML::Dump(node)));
+    CheckSamePlayer(loaded, source);
+    QE_CHECK_EQ(loaded.noCodec, 0.25);
+}
+
+QE_TEST(LayoutHashFollowsNamesAndEncodings)
+{
+    const auto table = PlayerComponent::staticMeta()->codecFields();
+    QE_CHECK_EQ(table->fields.size(), static_cast<size_t>(7));
+    QE_CHECK(table->fields.back().codec == nullptr);
+    QE_CHECK(PlayerComponent::staticMeta()->codecFields() == table);
+    QE_CHECK(table->layoutHash != PlayerComponentV2::staticMeta()->layoutHash());
+
+    // Solo cuentan nombre y codificacion: otro tipo con los mismos campos tiene el mismo hash
+    QEMetaType same = MakeMeta("Other");
+    QEMetaType renamed = MakeMeta("Other");
+    QEMetaType unsupported = MakeMeta("Other");
+    for (const char* name : { "a", "b" })
+    {
+        same.addField(name, typeid(int), 0);
+        renamed.addField(name[0] == 'a' ? "a" : "c", typeid(int), 0);
+        unsupported.addField(name, typeid(int), 0);
+    }
+    unsupported.addField("ignored", typeid(double), 0);
+
+    QEMetaType reference = MakeMeta("Reference");
+    reference.addField("a", typeid(int), 8);
+    reference.addField("b", typeid(int), 16);
+    QE_CHECK_EQ(same.layoutHash(), reference.layoutHash());
+    QE_CHECK(renamed.layoutHash() != reference.layoutHash());
+    QE_CHECK_EQ(unsupported.layoutHash(), reference.layoutHash());
+
+    // Un campo nuevo rehace la tabla; quien tenia la anterior la conserva intacta
+    const auto before = reference.codecFields();
+    reference.addField("b2", typeid(uint32_t), 24);
+    const auto after = reference.codecFields();
+    QE_CHECK(after != before);
+    QE_CHECK_EQ(before->fields.size(), static_cast<size_t>(2));
+    QE_CHECK_EQ(after->fields.size(), static_cast<size_t>(3));
+    QE_CHECK(after->layoutHash != before->layoutHash);
+}
+
+QE_TEST(ChangedLayoutMatchesFieldsByName)
+{
+    const PlayerComponent source = MakePlayer();
+
+    QEBinaryWriter writer;
+    serializeComponentBinary(&source, writer);
+    writer.Write(uint32_t(0xC0FFEEu));
+
+    PlayerComponentV2 loaded;
+    QEBinaryReader reader = ReaderOf(writer);
+    QE_CHECK(deserializeComponentBinary(&loaded, reader));
+
+    // Mismo nombre y codificacion: se leen aunque cambie el orden
+    QE_CHECK_EQ(loaded.speed, source.speed);
+    QE_CHECK_EQ(loaded.id, source.id);
+    QE_CHECK_EQ(loaded.enabled, source.enabled);
+
+    // Cambio de tipo o campo nuevo: se quedan con su valor por defecto
+    QE_CHECK_EQ(loaded.health, -1.0f);
+    QE_CHECK_EQ(loaded.armor, 7);
+
+    // Los campos eliminados se saltan por tamano
+    uint32_t marker = 0;
+    QE_CHECK(reader.Read(marker) && marker == 0xC0FFEEu);
+    QE_CHECK(reader.AtEnd());
+}
+
+QE_TEST(TruncatedComponentFailsWithoutReadingPastTheEnd)
+{
+    const PlayerComponent source = MakePlayer();
+
+    QEBinaryWriter writer;
+    serializeComponentBinary(&source, writer);
+
+    for (size_t size = 0; size < writer.Size(); ++size)
+    {
+        PlayerComponent loaded;
+        QEBinaryReader reader(writer.Data(), size);
+        QE_CHECK_MSG(!deserializeComponentBinary(&loaded, reader), "truncated to " + std::to_string(size));
+    }
+
+    // Un numero de elementos imposible en una lista tampoco reserva memoria a ciegas
+    QEBinaryWriter list;
+    list.Write(uint32_t(0x7FFFFFFFu));
+    std::vector<std::string> values{ "kept" };
+    QEBinaryReader listReader = ReaderOf(list);
+    QE_CHECK(!QEFieldCodecs::StringListFromBinary(listReader, &values));
+    QE_CHECK(values == std::vector<std::string>({ "kept" }));
+}
+
+int main()
+{
+    return QERunTests();
+}
@@ -0,0 +1,224 @@
+// Pruebas en CPU de la interpolacion de transforms fisicos (QEPhysicsInterpolation.h).
+// Un body con velocidad lineal y angular constantes avanza por pasos fijos con el mismo orden que
+// PhysicsModule::ComputeFixedSteps (QERunFixedSteps + QECapturePhysicsPose + QESyncPhysicsPose);
+// la pose interpolada tiene que coincidir con el movimiento analitico un paso fijo por detras
+// del tiempo real, con cualquier RenderAlpha y cualquier numero de pasos por frame.
+
+#include <algorithm>
+#include <string>
+#include <vector>
+#include <QEPhysicsInterpolation.h>
+#include "QETestHarness.h"
+
+namespace
+{
+    constexpr float FIXED_DELTA = 1.0f / 60.0f;
+    constexpr float POSITION_TOLERANCE = 1e-3f;
+    constexpr float ANGLE_TOLERANCE = 1e-3f;
+
+    float AngleBetween(const glm::quat& a, const glm::quat& b)
+    {
+        const float d = std::min(1.0f, std::abs(glm::dot(glm::normalize(a), glm::normalize(b))));
+        return 2.0f * std::acos(d);
+    }
+
+    /// Movimiento analitico: traslacion y giro constantes desde el origen.
+    struct AnalyticMotion
+    {
+        glm::vec3 Start = glm::vec3(0.0f);
+        glm::vec3 LinearVelocity = glm::vec3(0.0f);
+        glm::vec3 Axis = glm::vec3(0.0f, 1.0f, 0.0f);
+        float AngularSpeed = 0.0f;      // rad/s
+
+        glm::vec3 Position(double time) const { return Start + LinearVelocity * static_cast<float>(time); }
+        glm::quat Rotation(double time) const { return glm::angleAxis(AngularSpeed * static_cast<float>(time), glm::normalize(Axis)); }
+    };
+
+    /// Mundo fisico de un solo body: el "solver" es el movimiento analitico.
+    struct SimulatedWorld
+    {
+        AnalyticMotion Motion;
+        QEPhysicsInterpolationState State;
+        uint64_t SimulatedSteps = 0;
+        uint64_t SyncId = 0;
+
+        double SimTime() const { return SimulatedSteps * static_cast<double>(FIXED_DELTA); }
+
+        /// Un frame con el orden de PhysicsModule::ComputeFixedSteps.
+        void RunFrame(int steps)
+        {
+            QERunFixedSteps(steps,
+                [this]() { QECapturePhysicsPose(State, Motion.Position(SimTime()), Motion.Rotation(SimTime()), SyncId + 1); },
+                [this]() { ++SimulatedSteps; },
+                [this]() { ++SyncId; QESyncPhysicsPose(State, Motion.Position(SimTime()), Motion.Rotation(SimTime()), SyncId); });
+        }
+    };
+
+    /// Ejecuta frames con los deltas dados y cuenta los frames cuya pose interpolada no coincide.
+    int CountMismatches(const AnalyticMotion& motion, const std::vector<float>& frameDeltas)
+    {
+        SimulatedWorld world;
+        world.Motion = motion;
+
+        float accumulator = 0.0f;
+        double realTime = 0.0;
+        int mismatches = 0;
+
+        for (float delta : frameDeltas)
+        {
+            float alpha = 0.0f;
+            const int steps = QEAdvanceFixedSteps(accumulator, delta, FIXED_DELTA, alpha);
+            realTime += delta;
+            world.RunFrame(steps);
+
+            if (world.SimulatedSteps == 0)
+                continue;
+
+            const QEPhysicsPose pose = QEInterpolatePhysicsPose(
+                world.State.PrevPos, world.State.PrevRot, world.State.CurrPos, world.State.CurrRot, alpha);
+
+            // El render va un paso fijo por detras del tiempo real
+            const double renderTime = world.SimTime() - FIXED_DELTA + alpha * static_cast<double>(FIXED_DELTA);
+            const float positionError = glm::length(pose.Position - motion.Position(renderTime));
+            const float angleError = AngleBetween(pose.Rotation, motion.Rotation(renderTime));
+            const bool timeConsistent = std::abs(realTime - renderTime - FIXED_DELTA) < 1e-4;
+
+            if (positionError > POSITION_TOLERANCE || angleError > ANGLE_TOLERANCE || !timeConsistent)
+                ++mismatches;
+        }
+
+        return mismatches;
+    }
+
+    std::vector<float> IrregularDeltas()
+    {
+        std::vector<float> deltas;
+        const float pattern[] = { 0.004f, 0.021f, 0.0501f, 0.0083f, 0.0333f, 0.0009f, 0.0717f, 0.0166f };
+        for (int i = 0; i < 40; ++i)
+            deltas.insert(deltas.end(), std::begin(pattern), std::end(pattern));
+        return deltas;
+    }
+
+    /// Pasos por frame: 1 exacto, 0 o 1 (144 Hz), 2, 3+ y deltas irregulares
+    void CheckMotion(const AnalyticMotion& motion)
+    {
+        QE_CHECK_EQ(CountMismatches(motion, std::vector<float>(240, FIXED_DELTA)), 0);
+        QE_CHECK_EQ(CountMismatches(motion, std::vector<float>(480, 1.0f / 144.0f)), 0);
+        QE_CHECK_EQ(CountMismatches(motion, std::vector<float>(300, 1.0f / 75.0f)), 0);
+        QE_CHECK_EQ(CountMismatches(motion, std::vector<float>(120, 1.0f / 30.0f)), 0);
+        QE_CHECK_EQ(CountMismatches(motion, std::vector<float>(100, 1.0f / 24.0f)), 0);
+        QE_CHECK_EQ(CountMismatches(motion, std::vector<float>(60, FIXED_DELTA * 3.4f)), 0);
+        QE_CHECK_EQ(CountMismatches(motion, IrregularDeltas()), 0);
+    }
+
+    AnalyticMotion LinearMotion()
+    {
+        AnalyticMotion motion;
+        motion.Start = glm::vec3(-2.0f, 1.0f, 0.5f);
+        motion.LinearVelocity = glm::vec3(3.0f, -1.5f, 0.75f);
+        return motion;
+    }
+}
+
+QE_TEST(PoseInterpolationMixesAndClamps)
+{
+    const glm::vec3 prevPos(1.0f, 2.0f, 3.0f);
+    const glm::vec3 currPos(3.0f, 2.0f, -1.0f);
+    const glm::quat prevRot = glm::angleAxis(0.0f, glm::vec3(0.0f, 0.0f, 1.0f));
+    const glm::quat currRot = glm::angleAxis(0.8f, glm::vec3(0.0f, 0.0f, 1.0f));
+
+    for (float alpha : { 0.0f, 0.25f, 0.5f, 0.75f, 1.0f })
+    {
+        const QEPhysicsPose pose = QEInterpolatePhysicsPose(prevPos, prevRot, currPos, currRot, alpha);
+        const glm::vec3 expectedPos = prevPos + (currPos - prevPos) * alpha;
+        const glm::quat expectedRot = glm::angleAxis(0.8f * alpha, glm::vec3(0.0f, 0.0f, 1.0f));
+
+        QE_CHECK_NEAR(glm::length(pose.Position - expectedPos), 0.0f, 1e-5f);
+        QE_CHECK_NEAR(AngleBetween(pose.Rotation, expectedRot), 0.0f, 1e-4f);
+    }
+
+    // Fuera de [0, 1] se recorta, no se extrapola
+    const QEPhysicsPose over = QEInterpolatePhysicsPose(prevPos, prevRot, currPos, currRot, 1.5f);
+    const QEPhysicsPose under = QEInterpolatePhysicsPose(prevPos, prevRot, currPos, currRot, -0.5f);
+    QE_CHECK_NEAR(glm::length(over.Position - currPos), 0.0f, 1e-5f);
+    QE_CHECK_NEAR(glm::length(under.Position - prevPos), 0.0f, 1e-5f);
+
+    // InterpolationEnabled = false
+    const QEPhysicsPose raw = QEInterpolatePhysicsPose(prevPos, prevRot, currPos, currRot, 0.3f, false);
+    QE_CHECK_NEAR(glm::length(raw.Position - currPos), 0.0f, 1e-5f);
+    QE_CHECK_NEAR(AngleBetween(raw.Rotation, currRot), 0.0f, 1e-4f);
+}
+
+QE_TEST(AdvanceFixedStepsKeepsRemainderAsAlpha)
+{
+    float accumulator = 0.0f;
+    float alpha = 0.0f;
+
+    QE_CHECK_EQ(QEAdvanceFixedSteps(accumulator, FIXED_DELTA * 0.5f, FIXED_DELTA, alpha), 0);
+    QE_CHECK_NEAR(alpha, 0.5f, 1e-4f);
+
+    QE_CHECK_EQ(QEAdvanceFixedSteps(accumulator, FIXED_DELTA * 2.75f, FIXED_DELTA, alpha), 3);
+    QE_CHECK_NEAR(alpha, 0.25f, 1e-4f);
+}
+
+QE_TEST(RunFixedStepsCapturesBeforeTheLastStep)
+{
+    for (int steps = 0; steps <= 4; ++steps)
+    {
+        std::string calls;
+        QERunFixedSteps(steps,
+            [&calls]() { calls += 'c'; },
+            [&calls]() { calls += 's'; },
+            [&calls]() { calls += 'y'; });
+
+        std::string expected;
+        if (steps > 0)
+            expected = std::string(steps - 1, 's') + "csy";
+
+        QE_CHECK_MSG(calls == expected, std::to_string(steps) + " steps ran '" + calls + "', expected '" + expected + "'");
+    }
+}
+
+QE_TEST(SyncWithoutCaptureStartsFromLastPose)
+{
+    // Body dormido que se despierta durante el ultimo paso: no tiene captura de este sync
+    QEPhysicsInterpolationState state;
+    QESyncPhysicsPose(state, glm::vec3(1.0f, 0.0f, 0.0f), glm::quat(1.0f, 0.0f, 0.0f, 0.0f), 1);
+    QE_CHECK(state.HasCurr);
+    QE_CHECK_NEAR(glm::length(state.PrevPos - glm::vec3(1.0f, 0.0f, 0.0f)), 0.0f, 1e-6f);
+
+    QESyncPhysicsPose(state, glm::vec3(2.0f, 0.0f, 0.0f), glm::quat(1.0f, 0.0f, 0.0f, 0.0f), 5);
+    QE_CHECK_NEAR(glm::length(state.PrevPos - glm::vec3(1.0f, 0.0f, 0.0f)), 0.0f, 1e-6f);
+    QE_CHECK_NEAR(glm::length(state.CurrPos - glm::vec3(2.0f, 0.0f, 0.0f)), 0.0f, 1e-6f);
+
+    // Con captura del mismo sync se conserva la pose capturada
+    QECapturePhysicsPose(state, glm::vec3(2.5f, 0.0f, 0.0f), glm::quat(1.0f, 0.0f, 0.0f, 0.0f), 6);
+    QESyncPhysicsPose(state, glm::vec3(3.0f, 0.0f, 0.0f), glm::quat(1.0f, 0.0f, 0.0f, 0.0f), 6);
+    QE_CHECK_NEAR(glm::length(state.PrevPos - glm::vec3(2.5f, 0.0f, 0.0f)), 0.0f, 1e-6f);
+}
+
+QE_TEST(LinearMotionMatchesAnalytic)
+{
+    CheckMotion(LinearMotion());
+}
+
+QE_TEST(AngularMotionMatchesAnalytic)
+{
+    AnalyticMotion angular;
+    angular.Axis = glm::vec3(0.3f, 1.0f, -0.2f);
+    angular.AngularSpeed = 2.5f;
+    CheckMotion(angular);
+}
+
+QE_TEST(CombinedMotionMatchesAnalytic)
+{
+    AnalyticMotion combined = LinearMotion();
+    combined.Axis = glm::vec3(1.0f, 0.0f, 0.0f);
+    combined.AngularSpeed = -4.0f;
+    CheckMotion(combined);
+}
+
+int main()
+{
+    return QERunTests();
+}
@@ -0,0 +1,107 @@
+#pragma once
+
+#ifndef QE_TEST_HARNESS_H
+#define QE_TEST_HARNESS_H
+
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+/// Harness minimo de las pruebas en CPU (src/QuarantineTests). Cada ejecutable registra sus casos
+/// con QE_TEST y llama a QERunTests() desde main; ctest solo mira el codigo de salida.
+struct QETestCase
+{
+    const char* Name;
+    void (*Function)();
+};
+
+struct QETestContext
+{
+    static std::vector<QETestCase>& Cases()
+    {
+        static std::vector<QETestCase> cases;
+        return cases;
+    }
+
+    static int& CaseFailures()
+    {
+        static int failures = 0;
+        return failures;
+    }
+
+    static void Fail(const char* file, int line, const std::string& message)
+    {
+        ++CaseFailures();
+        std::printf("  %s:%d: %s\n", file, line, message.c_str());
+    }
+};
+
+struct QETestRegistrar
+{
+    QETestRegistrar(const char* name, void (*function)())
+    {
+        QETestContext::Cases().push_back({ name, function });
+    }
+};
+
+/// Ejecuta todos los casos registrados. Devuelve 0 si no ha fallado ninguno.
+inline int QERunTests()
+{
+    int failedCases = 0;
+    for (const QETestCase& testCase : QETestContext::Cases())
+    {
+        std::printf("[ RUN      ] %s\n", testCase.Name);
+        QETestContext::CaseFailures() = 0;
+        testCase.Function();
+
+        if (QETestContext::CaseFailures() == 0)
+        {
+            std::printf("[       OK ] %s\n", testCase.Name);
+        }
+        else
+        {
+            std::printf("[  FAILED  ] %s\n", testCase.Name);
+            ++failedCases;
+        }
+    }
+
+    const int total = static_cast<int>(QETestContext::Cases().size());
+    std::printf("%d/%d test cases passed\n", total - failedCases, total);
+    return failedCases == 0 ? 0 : 1;
+}
+
+#define QE_TEST_CONCAT_INNER(a, b) a##b
+#define QE_TEST_CONCAT(a, b) QE_TEST_CONCAT_INNER(a, b)
+
+/// Declara y registra un caso de prueba.
+#define QE_TEST(name) \
+    static void name(); \
+    static QETestRegistrar QE_TEST_CONCAT(name, _registrar)(#name, &name); \
+    static void name()
+
+/// Comprobaciones: un fallo se informa y el caso sigue ejecutandose.
+#define QE_CHECK(condition) \
+    do { if (!(condition)) QETestContext::Fail(__FILE__, __LINE__, "CHECK(" #condition ") failed"); } while (0)
+
+#define QE_CHECK_MSG(condition, message) \
+    do { if (!(condition)) QETestContext::Fail(__FILE__, __LINE__, std::string(message)); } while (0)
+
+#define QE_CHECK_EQ(actual, expected) \
+    do { \
+        const auto& qeActual = (actual); \
+        const auto& qeExpected = (expected); \
+        if (!(qeActual == qeExpected)) \
+            QETestContext::Fail(__FILE__, __LINE__, "CHECK_EQ(" #actual ", " #expected ") failed"); \
+    } while (0)
+
+#define QE_CHECK_NEAR(actual, expected, tolerance) \
+    do { \
+        const double qeActual = static_cast<double>(actual); \
+        const double qeExpected = static_cast<double>(expected); \
+        if (!(std::abs(qeActual - qeExpected) <= static_cast<double>(tolerance))) \
+            QETestContext::Fail(__FILE__, __LINE__, "CHECK_NEAR(" #actual ", " #expected ") failed: " \
+                + std::to_string(qeActual) + " vs " + std::to_string(qeExpected)); \
+    } while (0)
+
+#endif // !QE_TEST_HARNESS_H
@@ -0,0 +1,276 @@
+// Pruebas en CPU de QEReflectionCache: ida y vuelta del archivo .reflect, rechazo de caches de otro
+// modulo o corruptas y reutilizacion en memoria. No ejecuta SPIRV-Reflect: los stages se montan a mano.
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <QEReflectionCache.h>
+#include "QETestHarness.h"
+
+namespace
+{
+    /// Carpeta temporal propia de cada caso; se borra al salir.
+    struct TempFolder
+    {
+        fs::path Path;
+
+        explicit TempFolder(const std::string& name)
+        {
+            Path = fs::temp_directory_path() / ("qe_reflection_cache_tests_" + name);
+            fs::remove_all(Path);
+            fs::create_directories(Path);
+        }
+
+        ~TempFolder()
+        {
+            std::error_code ec;
+            fs::remove_all(Path, ec);
+        }
+    };
+
+    DescriptorBindingReflect MakeBinding(uint32_t set, uint32_t binding, VkDescriptorType type, const std::string& name, uint32_t arraySize = 1)
+    {
+        DescriptorBindingReflect reflect{};
+        reflect.stage = VK_SHADER_STAGE_FRAGMENT_BIT;
+        reflect.set = set;
+        reflect.binding = binding;
+        reflect.type = type;
+        reflect.name = name;
+        reflect.arraySize = arraySize;
+        return reflect;
+    }
+
+    /// Stage de fragmento parecido a default.frag: material por UBO, atlas de sombras y set bindless.
+    ReflectShader MakeFragmentStage()
+    {
+        ReflectShader stage;
+
+        DescriptorSetReflect setReflect{};
+        setReflect.stage = VK_SHADER_STAGE_FRAGMENT_BIT;
+        setReflect.set = 0;
+        setReflect.bindings = {
+            MakeBinding(0, 0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, "UniformMaterial"),
+            MakeBinding(0, 4, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, "QE_PointShadowAtlas"),
+            MakeBinding(0, 5, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, "QE_SpotShadowAtlas"),
+        };
+        setReflect.bindingCount = static_cast<uint32_t>(setReflect.bindings.size());
+        stage.descriptorSetReflect.push_back(setReflect);
+
+        for (const auto& binding : setReflect.bindings)
+            stage.bindings[binding.set].emplace(binding.binding, binding);
+        stage.bindings[1].emplace(0, MakeBinding(1, 0, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, "QE_MaterialTextures", 4096));
+
+        stage.materialUBOMembers = { { "Diffuse", 0, 16 }, { "Metallic", 16, 4 }, { "TexMask", 20, 4 } };
+        stage.animationUBOComponents = { "finalBonesMatrices" };
+        stage.inputVariables = {
+            InputVars(0, "inPosition", "vec3", VK_FORMAT_R32G32B32_SFLOAT, 12),
+            InputVars(1, "inBoneIds", "ivec4", VK_FORMAT_R32G32B32A32_SINT, 16),
+        };
+
+        stage.isUBOMaterial = true;
+        stage.HasPointShadows = true;
+        stage.HasSpotShadows = true;
+        stage.HasBindlessMaterials = true;
+        stage.BindlessMaterialSet = 1;
+        stage.materialBufferSize = 24;
+        stage.animationBufferSize = 64 * 200;
+        stage.inputStrideSize = 28;
+        return stage;
+    }
+
+    bool SameBinding(const DescriptorBindingReflect& a, const DescriptorBindingReflect& b)
+    {
+        return a.stage == b.stage && a.set == b.set && a.binding == b.binding &&
+            a.type == b.type && a.name == b.name && a.arraySize == b.arraySize;
+    }
+
+    void CheckSameStage(const ReflectShader& loaded, const ReflectShader& expected)
+    {
+        QE_CHECK(loaded.isShaderReflected);
+        QE_CHECK_EQ(loaded.descriptorSetReflect.size(), static_cast<size_t>(1));
+        if (loaded.descriptorSetReflect.size() == 1)
+        {
+            const DescriptorSetReflect& a = loaded.descriptorSetReflect.front();
+            const DescriptorSetReflect& b = expected.descriptorSetReflect.front();
+            QE_CHECK(a.stage == b.stage && a.set == b.set && a.bindingCount == b.bindingCount);
+            QE_CHECK_EQ(a.bindings.size(), b.bindings.size());
+            for (size_t i = 0; i < a.bindings.size() && i < b.bindings.size(); ++i)
+                QE_CHECK_MSG(SameBinding(a.bindings[i], b.bindings[i]), "set binding " + b.bindings[i].name);
+        }
+
+        QE_CHECK_EQ(loaded.bindings.size(), expected.bindings.size());
+        for (const auto& [set, setBindings] : expected.bindings)
+        {
+            for (const auto& [binding, reflect] : setBindings)
+            {
+                auto setIt = loaded.bindings.find(set);
+                const bool found = setIt != loaded.bindings.end() && setIt->second.count(binding) != 0;
+                QE_CHECK_MSG(found && SameBinding(setIt->second.at(binding), reflect), "binding " + reflect.name);
+            }
+        }
+
+        QE_CHECK_EQ(loaded.materialUBOMembers.size(), expected.materialUBOMembers.size());
+        for (size_t i = 0; i < loaded.materialUBOMembers.size() && i < expected.materialUBOMembers.size(); ++i)
+        {
+            const ReflectedMember& a = loaded.materialUBOMembers[i];
+            const ReflectedMember& b = expected.materialUBOMembers[i];
+            QE_CHECK_MSG(a.name == b.name && a.offset == b.offset && a.size == b.size, "member " + b.name);
+        }
+
+        QE_CHECK(loaded.animationUBOComponents == expected.animationUBOComponents);
+
+        QE_CHECK_EQ(loaded.inputVariables.size(), expected.inputVariables.size());
+        for (size_t i = 0; i < loaded.inputVariables.size() && i < expected.inputVariables.size(); ++i)
+        {
+            const InputVars& a = loaded.inputVariables[i];
+            const InputVars& b = expected.inputVariables[i];
+            QE_CHECK_MSG(a.location == b.location && a.size == b.size && a.name == b.name && a.format == b.format && a.type == b.type,
+                "input " + b.name);
+        }
+
+        QE_CHECK(loaded.isAnimationShader == expected.isAnimationShader);
+        QE_CHECK(loaded.isUBOMaterial == expected.isUBOMaterial);
+        QE_CHECK(loaded.isUboAnimation == expected.isUboAnimation);
+        QE_CHECK(loaded.HasPointShadows == expected.HasPointShadows);
+        QE_CHECK(loaded.HasDirectionalShadows == expected.HasDirectionalShadows);
+        QE_CHECK(loaded.HasSpotShadows == expected.HasSpotShadows);
+        QE_CHECK(loaded.HasBindlessMaterials == expected.HasBindlessMaterials);
+        QE_CHECK_EQ(loaded.BindlessMaterialSet, expected.BindlessMaterialSet);
+        QE_CHECK_EQ(loaded.materialBufferSize, expected.materialBufferSize);
+        QE_CHECK_EQ(loaded.animationBufferSize, expected.animationBufferSize);
+        QE_CHECK_EQ(loaded.inputStrideSize, expected.inputStrideSize);
+    }
+
+    VkShaderModuleCreateInfo MakeCreateInfo(const std::vector<uint32_t>& code)
+    {
+        VkShaderModuleCreateInfo createInfo{};
+        createInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+        createInfo.codeSize = code.size() * sizeof(uint32_t);
+        createInfo.pCode = code.data();
+        return createInfo;
+    }
+}
+
+QE_TEST(CachePathSitsNextToTheModule)
+{
+    QE_CHECK(QEReflectionCache::GetCachePath("Default/default_frag.spv") == fs::path("Default/default_frag.spv.reflect"));
+
+    const std::vector<uint32_t> code = { 0x07230203u, 0x00010000u, 1u, 2u };
+    std::vector<uint32_t> changed = code;
+    changed.back() = 3u;
+    QE_CHECK_EQ(QEReflectionCache::HashCode(MakeCreateInfo(code)), QEReflectionCache::HashCode(MakeCreateInfo(code)));
+    QE_CHECK(QEReflectionCache::HashCode(MakeCreateInfo(code)) != QEReflectionCache::HashCode(MakeCreateInfo(changed)));
+}
+
+QE_TEST(SaveAndLoadRoundTripEveryField)
+{
+    TempFolder folder("roundtrip");
+    const fs::path cachePath = folder.Path / "default_frag.spv.reflect";
+    const ReflectShader stage = MakeFragmentStage();
+
+    QE_CHECK(QEReflectionCache::Save(cachePath, 0x1234u, stage));
+    QE_CHECK(!fs::exists(fs::path(cachePath).concat(".tmp")));
+
+    ReflectShader loaded;
+    QE_CHECK(QEReflectionCache::Load(cachePath, 0x1234u, loaded));
+    CheckSameStage(loaded, stage);
+
+    // Stage de vertice con animacion y sin bindings
+    ReflectShader vertex;
+    DescriptorSetReflect emptySet{};
+    emptySet.stage = VK_SHADER_STAGE_VERTEX_BIT;
+    emptySet.set = 0;
+    emptySet.bindingCount = 0;
+    vertex.descriptorSetReflect.push_back(emptySet);
+    vertex.isAnimationShader = true;
+    vertex.isUboAnimation = true;
+    vertex.HasDirectionalShadows = true;
+
+    QE_CHECK(QEReflectionCache::Save(cachePath, 0x5678u, vertex));
+    ReflectShader loadedVertex;
+    QE_CHECK(QEReflectionCache::Load(cachePath, 0x5678u, loadedVertex));
+    CheckSameStage(loadedVertex, vertex);
+}
+
+QE_TEST(SaveRefusesAnythingButOneStage)
+{
+    TempFolder folder("stages");
+    const fs::path cachePath = folder.Path / "merged.spv.reflect";
+
+    ReflectShader none;
+    QE_CHECK(!QEReflectionCache::Save(cachePath, 1u, none));
+
+    // Un shader ya fusionado (vertex + fragment) no es la reflexion de un modulo
+    ReflectShader merged = MakeFragmentStage();
+    merged.descriptorSetReflect.push_back(merged.descriptorSetReflect.front());
+    QE_CHECK(!QEReflectionCache::Save(cachePath, 1u, merged));
+    QE_CHECK(!fs::exists(cachePath));
+}
+
+QE_TEST(LoadRejectsOtherModulesAndBrokenFiles)
+{
+    TempFolder folder("broken");
+    const fs::path cachePath = folder.Path / "default_frag.spv.reflect";
+    const ReflectShader stage = MakeFragmentStage();
+    QE_CHECK(QEReflectionCache::Save(cachePath, 42u, stage));
+
+    ReflectShader loaded;
+    QE_CHECK(!QEReflectionCache::Load(folder.Path / "missing.spv.reflect", 42u, loaded));
+
+    // El .spv se recompilo: otro hash
+    QE_CHECK(!QEReflectionCache::Load(cachePath, 43u, loaded));
+    QE_CHECK(!loaded.isShaderReflected);
+
+    std::ifstream in(cachePath, std::ios::binary);
+    const std::string content((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    in.close();
+
+    // Cualquier corte del archivo se rechaza, nunca se devuelve un stage a medias
+    for (size_t size : { size_t(0), size_t(4), size_t(16), content.size() / 2, content.size() - 1 })
+    {
+        std::ofstream out(cachePath, std::ios::binary | std::ios::trunc);
+        out.write(content.data(), static_cast<std::streamsize>(size));
+        out.close();
+        QE_CHECK_MSG(!QEReflectionCache::Load(cachePath, 42u, loaded), "truncated to " + std::to_string(size));
+    }
+
+    // Magia o version de otro formato
+    for (size_t offset : { size_t(0), size_t(4) })
+    {
+        std::string patched = content;
+        patched[offset] ^= 0x5A;
+        std::ofstream out(cachePath, std::ios::binary | std::ios::trunc);
+        out.write(patched.data(), static_cast<std::streamsize>(patched.size()));
+        out.close();
+        QE_CHECK_MSG(!QEReflectionCache::Load(cachePath, 42u, loaded), "patched header byte " + std::to_string(offset));
+    }
+    QE_CHECK(!loaded.isShaderReflected);
+}
+
+QE_TEST(LoadOrReflectReusesTheCacheFileAndMemory)
+{
+    TempFolder folder("reuse");
+    const fs::path spvPath = folder.Path / "default_frag.spv";
+    const std::vector<uint32_t> code = { 0x07230203u, 0x00010000u, 0xCAFEu, 7u };
+    const VkShaderModuleCreateInfo createInfo = MakeCreateInfo(code);
+    const ReflectShader stage = MakeFragmentStage();
+
+    QEReflectionCache::Clear();
+    QE_CHECK(QEReflectionCache::Save(QEReflectionCache::GetCachePath(spvPath), QEReflectionCache::HashCode(createInfo), stage));
+
+    // Con la cache del .spv al dia no se refleja el modulo (el codigo ni siquiera es SPIR-V valido)
+    CheckSameStage(QEReflectionCache::LoadOrReflect(createInfo, spvPath), stage);
+
+    // Otro ShaderModule con el mismo .spv sale de memoria aunque el archivo ya no este
+    fs::remove(QEReflectionCache::GetCachePath(spvPath));
+    CheckSameStage(QEReflectionCache::LoadOrReflect(createInfo, folder.Path / "copy_frag.spv"), stage);
+
+    QEReflectionCache::Clear();
+}
+
+int main()
+{
+    return QERunTests();
+}
@@ -0,0 +1,368 @@
+// Pruebas en CPU de QERenderGraph: orden de los pases compilados, descarte de pases sin
+// consumidores, barreras deducidas y plan de aliasing de los transitorios. Compile() no llama a
+// Vulkan, asi que no hace falta dispositivo.
+
+#include <random>
+#include <vector>
+#include <QERenderGraph.h>
+#include "QETestHarness.h"
+
+namespace
+{
+    QERGImageDesc ColorDesc(uint32_t width = 1280, uint32_t height = 720)
+    {
+        QERGImageDesc desc{};
+        desc.Format = VK_FORMAT_R16G16B16A16_SFLOAT;
+        desc.Extent = { width, height };
+        desc.Usage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+        return desc;
+    }
+
+    QERGAccess WriteColor(QERGResourceId resource)
+    {
+        return QERGAccess::Overwrite(resource, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+            VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT);
+    }
+
+    QERGAccess SampleInFragment(QERGResourceId resource)
+    {
+        return QERGAccess::Read(resource, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+            VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT);
+    }
+
+    QERGResourceId ImportSwapchain(QERenderGraph& graph)
+    {
+        QERGImageState initial{};
+        initial.Layout = VK_IMAGE_LAYOUT_UNDEFINED;
+        return graph.ImportImage("Swapchain", VK_NULL_HANDLE, ColorDesc(), initial, true, VK_IMAGE_LAYOUT_PRESENT_SRC_KHR);
+    }
+
+    std::vector<uint32_t> CompiledOrder(const QERenderGraph& graph)
+    {
+        std::vector<uint32_t> order;
+        for (const QERGCompiledPass& pass : graph.GetCompiledPasses())
+            order.push_back(pass.PassIndex);
+        return order;
+    }
+
+    const QERGImageBarrier* FindBarrier(const QERGCompiledPass& pass, QERGResourceId resource)
+    {
+        for (const QERGImageBarrier& barrier : pass.Barriers)
+        {
+            if (barrier.Resource == resource)
+                return &barrier;
+        }
+        return nullptr;
+    }
+}
+
+QE_TEST(CompiledPassesRunProducersBeforeConsumers)
+{
+    QERenderGraph graph;
+    const QERGResourceId gbuffer = graph.CreateTransientImage("GBuffer", ColorDesc());
+    const QERGResourceId hdr = graph.CreateTransientImage("HDR", ColorDesc());
+    const QERGResourceId swapchain = ImportSwapchain(graph);
+
+    const uint32_t geometry = graph.AddPass("Geometry", nullptr);
+    const uint32_t lighting = graph.AddPass("Lighting", nullptr);
+    const uint32_t tonemap = graph.AddPass("Tonemap", nullptr);
+
+    graph.Use(geometry, WriteColor(gbuffer));
+    graph.Use(lighting, SampleInFragment(gbuffer));
+    graph.Use(lighting, WriteColor(hdr));
+    graph.Use(tonemap, SampleInFragment(hdr));
+    graph.Use(tonemap, WriteColor(swapchain));
+    graph.Compile();
+
+    QE_CHECK(CompiledOrder(graph) == std::vector<uint32_t>({ geometry, lighting, tonemap }));
+    QE_CHECK_EQ(graph.GetCulledPassCount(), 0u);
+
+    // Cada lectura llega despues de la ultima escritura de ese recurso
+    std::vector<int> lastWriter(graph.GetResources().size(), -1);
+    const auto& compiled = graph.GetCompiledPasses();
+    for (size_t i = 0; i < compiled.size(); ++i)
+    {
+        for (const QERGAccess& access : graph.GetPasses()[compiled[i].PassIndex].Accesses)
+        {
+            if (!access.Write)
+                QE_CHECK(lastWriter[access.Resource] >= 0 && lastWriter[access.Resource] < static_cast<int>(i));
+            else
+                lastWriter[access.Resource] = static_cast<int>(i);
+        }
+    }
+}
+
+QE_TEST(PassesWithoutConsumersAreCulled)
+{
+    QERenderGraph graph;
+    const QERGResourceId debug = graph.CreateTransientImage("Debug", ColorDesc());
+    const QERGResourceId scratch = graph.CreateTransientImage("Scratch", ColorDesc());
+    const QERGResourceId readback = graph.CreateTransientImage("Readback", ColorDesc());
+    const QERGResourceId swapchain = ImportSwapchain(graph);
+
+    const uint32_t unusedDebug = graph.AddPass("UnusedDebug", nullptr);
+    const uint32_t overwritten = graph.AddPass("Overwritten", nullptr);
+    const uint32_t producer = graph.AddPass("Producer", nullptr);
+    const uint32_t present = graph.AddPass("Present", nullptr);
+    const uint32_t capture = graph.AddPass("Capture", nullptr, true);
+
+    graph.Use(unusedDebug, WriteColor(debug));
+    graph.Use(overwritten, WriteColor(scratch));
+    // Producer descarta el contenido de Scratch: lo que escribio Overwritten no llega a nadie
+    graph.Use(producer, WriteColor(scratch));
+    graph.Use(present, SampleInFragment(scratch));
+    graph.Use(present, WriteColor(swapchain));
+    graph.Use(capture, WriteColor(readback));
+    graph.Compile();
+
+    QE_CHECK(CompiledOrder(graph) == std::vector<uint32_t>({ producer, present, capture }));
+    QE_CHECK_EQ(graph.GetCulledPassCount(), 2u);
+    QE_CHECK(!graph.GetLifetimes()[debug].Used());
+
+    // Sin descartar (ReadWrite) el escritor anterior sigue siendo necesario
+    QERenderGraph chained;
+    const QERGResourceId accum = chained.CreateTransientImage("Accum", ColorDesc());
+    const QERGResourceId out = ImportSwapchain(chained);
+    const uint32_t first = chained.AddPass("First", nullptr);
+    const uint32_t second = chained.AddPass("Second", nullptr);
+    const uint32_t resolve = chained.AddPass("Resolve", nullptr);
+    chained.Use(first, WriteColor(accum));
+    chained.Use(second, QERGAccess::ReadWrite(accum, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+        VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT));
+    chained.Use(resolve, SampleInFragment(accum));
+    chained.Use(resolve, WriteColor(out));
+    chained.Compile();
+
+    QE_CHECK(CompiledOrder(chained) == std::vector<uint32_t>({ first, second, resolve }));
+}
+
+QE_TEST(BarriersCoverLayoutChangesAndHazardsOnly)
+{
+    QERenderGraph graph;
+    const QERGResourceId color = graph.CreateTransientImage("Color", ColorDesc());
+    const QERGResourceId swapchain = ImportSwapchain(graph);
+
+    const uint32_t draw = graph.AddPass("Draw", nullptr);
+    const uint32_t blurA = graph.AddPass("BlurA", nullptr);
+    const uint32_t blurB = graph.AddPass("BlurB", nullptr);
+    const uint32_t redraw = graph.AddPass("Redraw", nullptr);
+    const uint32_t present = graph.AddPass("Present", nullptr);
+
+    graph.Use(draw, WriteColor(color));
+    graph.Use(blurA, SampleInFragment(color));
+    graph.Use(blurA, WriteColor(swapchain));
+    graph.Use(blurB, SampleInFragment(color));
+    graph.Use(blurB, QERGAccess::ReadWrite(swapchain, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+        VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT));
+    graph.Use(redraw, WriteColor(color));
+    graph.Use(present, SampleInFragment(color));
+    graph.Use(present, QERGAccess::ReadWrite(swapchain, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+        VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT));
+    graph.Compile();
+
+    const auto& compiled = graph.GetCompiledPasses();
+    QE_CHECK_EQ(compiled.size(), static_cast<size_t>(5));
+
+    // Draw: transicion inicial descartando el contenido
+    const QERGImageBarrier* initial = FindBarrier(compiled[0], color);
+    QE_CHECK(initial != nullptr);
+    if (initial)
+    {
+        QE_CHECK_EQ(initial->OldLayout, VK_IMAGE_LAYOUT_UNDEFINED);
+        QE_CHECK_EQ(initial->NewLayout, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL);
+    }
+
+    // BlurA: RAW con cambio de layout
+    const QERGImageBarrier* raw = FindBarrier(compiled[1], color);
+    QE_CHECK(raw != nullptr);
+    if (raw)
+    {
+        QE_CHECK_EQ(raw->OldLayout, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL);
+        QE_CHECK_EQ(raw->NewLayout, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+        QE_CHECK_EQ(raw->SrcStages, static_cast<VkPipelineStageFlags>(VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT));
+        QE_CHECK_EQ(raw->SrcAccess, static_cast<VkAccessFlags>(VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT));
+        QE_CHECK_EQ(raw->DstStages, static_cast<VkPipelineStageFlags>(VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT));
+        QE_CHECK_EQ(raw->DstAccess, static_cast<VkAccessFlags>(VK_ACCESS_SHADER_READ_BIT));
+    }
+
+    // BlurB: segunda lectura en el mismo layout, la escritura ya es visible
+    QE_CHECK(FindBarrier(compiled[2], color) == nullptr);
+
+    // Redraw: WAR, espera a las lecturas de BlurA/BlurB antes de sobrescribir
+    const QERGImageBarrier* war = FindBarrier(compiled[3], color);
+    QE_CHECK(war != nullptr);
+    if (war)
+    {
+        QE_CHECK((war->SrcStages & VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT) != 0);
+        QE_CHECK_EQ(war->DstAccess, static_cast<VkAccessFlags>(VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT));
+        QE_CHECK_EQ(war->OldLayout, VK_IMAGE_LAYOUT_UNDEFINED);
+        QE_CHECK_EQ(war->NewLayout, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL);
+    }
+
+    // Importado con layout final: una barrera al acabar el grafo
+    const auto& finals = graph.GetFinalBarriers();
+    QE_CHECK_EQ(finals.size(), static_cast<size_t>(1));
+    if (!finals.empty())
+    {
+        QE_CHECK_EQ(finals[0].Resource, swapchain);
+        QE_CHECK_EQ(finals[0].OldLayout, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL);
+        QE_CHECK_EQ(finals[0].NewLayout, VK_IMAGE_LAYOUT_PRESENT_SRC_KHR);
+    }
+}
+
+QE_TEST(RenderPassAcquireSkipsRedundantBarriers)
+{
+    QERenderGraph graph;
+    const QERGResourceId depth = graph.CreateTransientImage("Depth", ColorDesc());
+    const QERGResourceId out = ImportSwapchain(graph);
+
+    const uint32_t prepass = graph.AddPass("Prepass", nullptr);
+    const uint32_t forward = graph.AddPass("Forward", nullptr);
+
+    const VkPipelineStageFlags depthStages = VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+    graph.Use(prepass, QERGAccess::Overwrite(depth, VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL, depthStages, VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT));
+
+    // El render pass de Forward ya declara la dependencia EXTERNAL con la escritura de profundidad
+    QERGAccess load = QERGAccess::Read(depth, VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL, depthStages, VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT);
+    load.AcquireStages = depthStages;
+    load.AcquireAccess = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+    graph.Use(forward, load);
+    graph.Use(forward, WriteColor(out));
+    graph.Compile();
+
+    QE_CHECK(FindBarrier(graph.GetCompiledPasses()[1], depth) == nullptr);
+}
+
+QE_TEST(AliasedTransientsNeverShareMemoryWhileAlive)
+{
+    QERenderGraph graph;
+    const QERGResourceId a = graph.CreateTransientImage("A", ColorDesc());
+    const QERGResourceId b = graph.CreateTransientImage("B", ColorDesc());
+    const QERGResourceId c = graph.CreateTransientImage("C", ColorDesc());
+    const QERGResourceId out = ImportSwapchain(graph);
+
+    const uint32_t p0 = graph.AddPass("P0", nullptr);
+    const uint32_t p1 = graph.AddPass("P1", nullptr);
+    const uint32_t p2 = graph.AddPass("P2", nullptr);
+    const uint32_t p3 = graph.AddPass("P3", nullptr);
+
+    // A vive en [0, 1], B en [1, 2], C en [2, 3]: A y C pueden compartir memoria, B no con ninguna
+    graph.Use(p0, WriteColor(a));
+    graph.Use(p1, SampleInFragment(a));
+    graph.Use(p1, WriteColor(b));
+    graph.Use(p2, SampleInFragment(b));
+    graph.Use(p2, WriteColor(c));
+    graph.Use(p3, SampleInFragment(c));
+    graph.Use(p3, WriteColor(out));
+    graph.Compile();
+
+    const auto& resources = graph.GetAliasedResources();
+    const auto& requests = graph.GetAliasRequests();
+    const QERGAliasingPlan& plan = graph.GetAliasingPlan();
+    QE_CHECK_EQ(resources.size(), static_cast<size_t>(3));
+
+    for (uint32_t i = 0; i < requests.size(); ++i)
+    {
+        for (uint32_t j = i + 1; j < requests.size(); ++j)
+        {
+            const bool livesOverlap = !(requests[i].LastPass < requests[j].FirstPass || requests[j].LastPass < requests[i].FirstPass);
+            if (livesOverlap)
+                QE_CHECK(!plan.Overlaps(i, j, requests));
+        }
+    }
+
+    // A y C reutilizan la misma memoria: dos bloques en lugar de tres
+    QE_CHECK_EQ(plan.Blocks.size(), static_cast<size_t>(2));
+    QE_CHECK(plan.AllocatedBytes < plan.RequestedBytes);
+
+    // C reutiliza la memoria de A: su primer uso espera al ultimo uso de A
+    uint32_t indexA = 0, indexC = 0;
+    for (uint32_t i = 0; i < resources.size(); ++i)
+    {
+        if (resources[i] == a) indexA = i;
+        if (resources[i] == c) indexC = i;
+    }
+    QE_CHECK(plan.Overlaps(indexA, indexC, requests));
+
+    const QERGImageBarrier* reuse = FindBarrier(graph.GetCompiledPasses()[2], c);
+    QE_CHECK(reuse != nullptr);
+    if (reuse)
+        QE_CHECK((reuse->SrcStages & VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT) != 0);
+}
+
+QE_TEST(PlanAliasingRandomRequestsStayDisjoint)
+{
+    std::mt19937 rng(7);
+    for (int round = 0; round < 300; ++round)
+    {
+        std::vector<QERGAliasRequest> requests(1 + rng() % 24);
+        for (QERGAliasRequest& request : requests)
+        {
+            request.Requirements.Size = (1 + rng() % 64) * 4096;
+            request.Requirements.Alignment = 1ull << (rng() % 17);
+            request.Requirements.MemoryTypeBits = (rng() % 4 == 0) ? 0x2u : 0x3u;
+            request.FirstPass = rng() % 12;
+            request.LastPass = request.FirstPass + rng() % 6;
+        }
+
+        const QERGAliasingPlan plan = QERenderGraph::PlanAliasing(requests);
+        QE_CHECK_EQ(plan.Placements.size(), requests.size());
+        QE_CHECK(plan.AllocatedBytes <= plan.RequestedBytes);
+
+        for (uint32_t i = 0; i < requests.size(); ++i)
+        {
+            const auto& placement = plan.Placements[i];
+            QE_CHECK(placement.Block < plan.Blocks.size());
+            if (placement.Block >= plan.Blocks.size())
+                continue;
+
+            QE_CHECK_EQ(placement.Offset % requests[i].Requirements.Alignment, 0u);
+            QE_CHECK(placement.Offset + requests[i].Requirements.Size <= plan.Blocks[placement.Block].Size);
+            QE_CHECK((plan.Blocks[placement.Block].MemoryTypeBits & requests[i].Requirements.MemoryTypeBits) != 0);
+
+            for (uint32_t j = i + 1; j < requests.size(); ++j)
+            {
+                const bool livesOverlap = !(requests[i].LastPass < requests[j].FirstPass || requests[j].LastPass < requests[i].FirstPass);
+                if (livesOverlap)
+                    QE_CHECK_MSG(!plan.Overlaps(i, j, requests), "round " + std::to_string(round) + ": live requests share memory");
+            }
+        }
+    }
+}
+
+QE_TEST(CompileReusesThePlanWhileTheGraphIsUnchanged)
+{
+    QERenderGraph graph;
+    auto build = [&graph](bool extraPass)
+        {
+            graph.Reset();
+            const QERGResourceId color = graph.CreateTransientImage("Color", ColorDesc());
+            const QERGResourceId out = ImportSwapchain(graph);
+            const uint32_t draw = graph.AddPass("Draw", nullptr);
+            graph.Use(draw, WriteColor(color));
+            if (extraPass)
+            {
+                const uint32_t debug = graph.AddPass("Debug", nullptr, true);
+                graph.Use(debug, SampleInFragment(color));
+            }
+            const uint32_t present = graph.AddPass("Present", nullptr);
+            graph.Use(present, SampleInFragment(color));
+            graph.Use(present, WriteColor(out));
+            graph.Compile();
+        };
+
+    build(false);
+    const uint64_t signature = graph.GetSignature();
+    build(false);
+    QE_CHECK_EQ(graph.GetSignature(), signature);
+    QE_CHECK_EQ(graph.GetCompiledPasses().size(), static_cast<size_t>(2));
+
+    build(true);
+    QE_CHECK(graph.GetSignature() != signature);
+    QE_CHECK_EQ(graph.GetCompiledPasses().size(), static_cast<size_t>(3));
+}
+
+int main()
+{
+    return QERunTests();
+}
@@ -0,0 +1,239 @@
+// Pruebas en CPU de la cache incremental de QEShaderCompiler: archivo de dependencias (.d) con el
+// hash de opciones, invalidacion por includes y opciones, cache de includes y manifiesto de build.
+// No compila shaders: solo la parte que decide si hay que hacerlo.
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <QEShaderCompiler.h>
+#include "QETestHarness.h"
+
+namespace
+{
+    /// Carpeta temporal propia de cada caso; se borra al salir.
+    struct TempFolder
+    {
+        fs::path Path;
+
+        explicit TempFolder(const std::string& name)
+        {
+            Path = fs::temp_directory_path() / ("qe_shader_compiler_tests_" + name);
+            fs::remove_all(Path);
+            fs::create_directories(Path);
+        }
+
+        ~TempFolder()
+        {
+            std::error_code ec;
+            fs::remove_all(Path, ec);
+        }
+    };
+
+    void WriteFile(const fs::path& path, const std::string& content)
+    {
+        fs::create_directories(path.parent_path());
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file << content;
+    }
+
+    /// Fecha explicita: no depende de la resolucion del reloj del sistema de archivos.
+    void SetWriteTime(const fs::path& path, fs::file_time_type base, int seconds)
+    {
+        fs::last_write_time(path, base + std::chrono::seconds(seconds));
+    }
+
+    /// Source, include (con espacio en la ruta) y salida ya compilada con su .d.
+    QEShaderCompileJob MakeCompiledJob(const TempFolder& folder, fs::path& outInclude)
+    {
+        QEShaderCompileJob job;
+        job.Source = folder.Path / "default.frag";
+        job.Output = folder.Path / "default_frag.spv";
+        outInclude = folder.Path / "Includes Dir" / "common.glsl";
+
+        WriteFile(job.Source, "#version 450\n#include \"Includes Dir/common.glsl\"\nvoid main() {}\n");
+        WriteFile(outInclude, "float QE_Common() { return 1.0; }\n");
+        WriteFile(job.Output, "spirv");
+
+        const fs::file_time_type base = fs::last_write_time(job.Output);
+        SetWriteTime(job.Source, base, -20);
+        SetWriteTime(outInclude, base, -10);
+
+        QE_CHECK(QEShaderCompiler::WriteDependencyFile(job, { job.Source, outInclude }));
+        return job;
+    }
+}
+
+QE_TEST(StageSuffixFollowsTheExtension)
+{
+    QE_CHECK_EQ(QEShaderCompiler::GetStageSuffix("a/b/default.frag"), std::string("frag"));
+    QE_CHECK_EQ(QEShaderCompiler::GetStageSuffix("mesh.MESH"), std::string("mesh"));
+    QE_CHECK_EQ(QEShaderCompiler::GetStageSuffix("culling.comp"), std::string("comp"));
+    QE_CHECK_EQ(QEShaderCompiler::GetStageSuffix("QEShadows.glsl"), std::string());
+}
+
+QE_TEST(DependencyFileMakesTheJobUpToDate)
+{
+    TempFolder folder("uptodate");
+    fs::path include;
+    const QEShaderCompileJob job = MakeCompiledJob(folder, include);
+
+    QE_CHECK(QEShaderCompiler::IsUpToDate(job));
+
+    // Formato make: la ruta con espacio va escapada
+    std::ifstream depFile(fs::path(job.Output).concat(QEShaderCompiler::DEPENDENCY_EXTENSION));
+    const std::string content((std::istreambuf_iterator<char>(depFile)), std::istreambuf_iterator<char>());
+    QE_CHECK(content.find("Includes\\ Dir/common.glsl") != std::string::npos);
+}
+
+QE_TEST(NewerSourceOrIncludeMakesTheJobStale)
+{
+    TempFolder folder("stale");
+    fs::path include;
+    const QEShaderCompileJob job = MakeCompiledJob(folder, include);
+    const fs::file_time_type outputTime = fs::last_write_time(job.Output);
+
+    SetWriteTime(include, outputTime, 5);
+    QE_CHECK(!QEShaderCompiler::IsUpToDate(job));
+
+    SetWriteTime(include, outputTime, -10);
+    QE_CHECK(QEShaderCompiler::IsUpToDate(job));
+
+    SetWriteTime(job.Source, outputTime, 5);
+    QE_CHECK(!QEShaderCompiler::IsUpToDate(job));
+
+    // Un include que ya no existe tambien obliga a recompilar
+    SetWriteTime(job.Source, outputTime, -20);
+    fs::remove(include);
+    QE_CHECK(!QEShaderCompiler::IsUpToDate(job));
+}
+
+QE_TEST(ChangedOptionsMakeTheJobStale)
+{
+    TempFolder folder("options");
+    fs::path include;
+    const QEShaderCompileJob job = MakeCompiledJob(folder, include);
+
+    QEShaderCompileJob withDefine = job;
+    withDefine.Defines = { "QE_KEYWORD_ALPHA_MASK" };
+    QE_CHECK(!QEShaderCompiler::IsUpToDate(withDefine));
+
+    QEShaderCompileJob otherEnv = job;
+    otherEnv.TargetEnv = QEShaderTargetEnv::Vulkan1_2;
+    QE_CHECK(!QEShaderCompiler::IsUpToDate(otherEnv));
+
+    // Tras reescribir el .d con las nuevas opciones vale la nueva combinacion y no la anterior
+    QE_CHECK(QEShaderCompiler::WriteDependencyFile(withDefine, { withDefine.Source, include }));
+    QE_CHECK(QEShaderCompiler::IsUpToDate(withDefine));
+    QE_CHECK(!QEShaderCompiler::IsUpToDate(job));
+}
+
+QE_TEST(MissingOrBrokenDependencyFileMakesTheJobStale)
+{
+    TempFolder folder("broken");
+    fs::path include;
+    const QEShaderCompileJob job = MakeCompiledJob(folder, include);
+    const fs::path depPath = fs::path(job.Output).concat(QEShaderCompiler::DEPENDENCY_EXTENSION);
+
+    // .d de glslc sin hash de opciones
+    WriteFile(depPath, job.Output.generic_string() + ": " + job.Source.generic_string() + "\n");
+    QE_CHECK(!QEShaderCompiler::IsUpToDate(job));
+
+    WriteFile(depPath, "# QE_SHADER_OPTIONS not-a-hash\n");
+    QE_CHECK(!QEShaderCompiler::IsUpToDate(job));
+
+    fs::remove(depPath);
+    QE_CHECK(!QEShaderCompiler::IsUpToDate(job));
+
+    QE_CHECK(QEShaderCompiler::WriteDependencyFile(job, { job.Source, include }));
+    fs::remove(job.Output);
+    QE_CHECK(!QEShaderCompiler::IsUpToDate(job));
+}
+
+QE_TEST(IncludeCacheSharesContentUntilTheFileChanges)
+{
+    TempFolder folder("includes");
+    const fs::path include = folder.Path / "QEShadows.glsl";
+    WriteFile(include, "// v1\n");
+    const fs::file_time_type base = fs::last_write_time(include);
+
+    QEShaderCompiler::ClearIncludeCache();
+    const auto first = QEShaderCompiler::LoadInclude(include);
+    const auto second = QEShaderCompiler::LoadInclude(include);
+    QE_CHECK(first != nullptr);
+    QE_CHECK(first == second);
+    if (first)
+        QE_CHECK_EQ(*first, std::string("// v1\n"));
+
+    WriteFile(include, "// v2\n");
+    SetWriteTime(include, base, 5);
+    const auto changed = QEShaderCompiler::LoadInclude(include);
+    QE_CHECK(changed != nullptr && changed != first);
+    if (changed)
+        QE_CHECK_EQ(*changed, std::string("// v2\n"));
+
+    // Quien ya tenia el contenido anterior lo conserva
+    if (first)
+        QE_CHECK_EQ(*first, std::string("// v1\n"));
+
+    QEShaderCompiler::ClearIncludeCache();
+    QE_CHECK(QEShaderCompiler::LoadInclude(include) != changed);
+    QE_CHECK(QEShaderCompiler::LoadInclude(folder.Path / "missing.glsl") == nullptr);
+}
+
+QE_TEST(BuildManifestResolvesPathsAndOptions)
+{
+    TempFolder folder("manifest");
+    WriteFile(folder.Path / QEShaderCompiler::BUILD_MANIFEST,
+        "Shaders:\n"
+        "  - Source: Default/default.frag\n"
+        "  - Source: Mesh/mesh.mesh\n"
+        "    Output: Mesh/custom_mesh.spv\n"
+        "    Defines: [QE_MESH_SHADING, QE_MAX_LODS=32]\n"
+        "    TargetEnv: vulkan1.2\n"
+        "  - Output: ignored.spv\n");
+
+    const auto jobs = QEShaderCompiler::LoadBuildManifest(folder.Path);
+    QE_CHECK_EQ(jobs.size(), static_cast<size_t>(2));
+    if (jobs.size() == 2)
+    {
+        QE_CHECK(jobs[0].Output == (folder.Path / "Default" / "default_frag.spv").lexically_normal());
+        QE_CHECK(jobs[0].Defines.empty());
+        QE_CHECK(jobs[0].TargetEnv == QEShaderTargetEnv::Vulkan1_0);
+
+        QE_CHECK(jobs[1].Output == (folder.Path / "Mesh" / "custom_mesh.spv").lexically_normal());
+        QE_CHECK(jobs[1].Defines == std::vector<std::string>({ "QE_MESH_SHADING", "QE_MAX_LODS=32" }));
+        QE_CHECK(jobs[1].TargetEnv == QEShaderTargetEnv::Vulkan1_2);
+    }
+
+    WriteFile(folder.Path / QEShaderCompiler::BUILD_MANIFEST, "Shaders:\n  - Source: a.frag\n    TargetEnv: vulkan9\n");
+    bool threw = false;
+    try
+    {
+        QEShaderCompiler::LoadBuildManifest(folder.Path);
+    }
+    catch (const std::runtime_error&)
+    {
+        threw = true;
+    }
+    QE_CHECK(threw);
+}
+
+QE_TEST(EngineManifestListsExistingSources)
+{
+    const fs::path shaderRoot = fs::path(QE_SOURCE_DIR) / "resources" / "shaders";
+    const auto jobs = QEShaderCompiler::LoadBuildManifest(shaderRoot);
+    QE_CHECK(!jobs.empty());
+
+    for (const auto& job : jobs)
+    {
+        QE_CHECK_MSG(fs::exists(job.Source), "missing source " + job.Source.generic_string());
+        QE_CHECK_MSG(!QEShaderCompiler::GetStageSuffix(job.Source).empty(), "no stage for " + job.Source.generic_string());
+    }
+}
+
+int main()
+{
+    return QERunTests();
+}
@@ -0,0 +1,89 @@
+// Pruebas en CPU de las claves de variantes de material (QEShaderVariantKey): keywords a partir del
+// material, defines y hash del indice ShaderVariants.yaml.
+
+#include <cstdint>
+#include <set>
+#include <string>
+#include <vector>
+#include <QEShaderVariantKey.h>
+#include "QETestHarness.h"
+
+namespace
+{
+    const char* const PROGRAMS[] = { "default", "default_bindless" };
+
+    /// Todas las combinaciones posibles de keywords (texturas y recorte por alfa).
+    std::vector<uint32_t> AllKeywordSets()
+    {
+        std::vector<uint32_t> sets;
+        for (uint32_t textures = 0; textures <= QEShaderVariantKey::KEYWORD_TEXTURES; ++textures)
+        {
+            sets.push_back(textures);
+            sets.push_back(textures | QEShaderVariantKey::KEYWORD_ALPHA_MASK);
+        }
+        return sets;
+    }
+}
+
+QE_TEST(KeywordsComeFromTexMaskAndAlphaMode)
+{
+    // Height y el slot reservado no generan variantes
+    QE_CHECK_EQ(QEShaderVariantKey::FromMaterial(0xFFu, 0u), QEShaderVariantKey::KEYWORD_TEXTURES);
+    QE_CHECK_EQ(QEShaderVariantKey::FromMaterial(0u, 0u), 0u);
+
+    const uint32_t baseNormal = QEShaderVariantKey::KEYWORD_BASECOLOR | QEShaderVariantKey::KEYWORD_NORMAL;
+    QE_CHECK_EQ(QEShaderVariantKey::FromMaterial(baseNormal, 1u), baseNormal | QEShaderVariantKey::KEYWORD_ALPHA_MASK);
+
+    // Solo el modo mask recorta; blend (2) usa la misma variante que opaco
+    QE_CHECK_EQ(QEShaderVariantKey::FromMaterial(baseNormal, 2u), baseNormal);
+}
+
+QE_TEST(DefinesFollowTheKeywordsInAFixedOrder)
+{
+    QE_CHECK(QEShaderVariantKey::GetDefines(0u) == std::vector<std::string>({ "QE_MATERIAL_VARIANT" }));
+
+    const uint32_t keywords = QEShaderVariantKey::KEYWORD_ALPHA_MASK | QEShaderVariantKey::KEYWORD_EMISSIVE | QEShaderVariantKey::KEYWORD_BASECOLOR;
+    QE_CHECK(QEShaderVariantKey::GetDefines(keywords) ==
+        std::vector<std::string>({ "QE_MATERIAL_VARIANT", "QE_TEX_BASECOLOR", "QE_TEX_EMISSIVE", "QE_ALPHA_MASK" }));
+
+    // Una keyword por bit: mismo numero de defines que de bits activos
+    for (uint32_t keywords : AllKeywordSets())
+    {
+        uint32_t bits = 0;
+        for (uint32_t value = keywords; value != 0; value &= value - 1)
+            ++bits;
+
+        QE_CHECK_EQ(QEShaderVariantKey::GetDefines(keywords).size(), static_cast<size_t>(bits + 1));
+    }
+}
+
+QE_TEST(HashIsStableAcrossRuns)
+{
+    // Valores fijos: el indice guarda estos hashes y los nombres de los .spv precompilados
+    QE_CHECK_EQ(QEShaderVariantKey::GetHash("default", 0u), 0x68b40641a82098efull);
+    QE_CHECK_EQ(QEShaderVariantKey::GetHash("default_bindless", 0x13Fu), 0x1b7598a8117f90e2ull);
+
+    const std::string program = "default";
+    QE_CHECK_EQ(QEShaderVariantKey::GetHash(program, 0x21u), QEShaderVariantKey::GetHash(std::string("default"), 0x21u));
+}
+
+QE_TEST(HashesNeverCollideAcrossProgramsAndKeywords)
+{
+    std::set<uint64_t> hashes;
+    size_t keys = 0;
+    for (const char* program : PROGRAMS)
+    {
+        for (uint32_t keywords : AllKeywordSets())
+        {
+            hashes.insert(QEShaderVariantKey::GetHash(program, keywords));
+            ++keys;
+        }
+    }
+
+    QE_CHECK_EQ(hashes.size(), keys);
+}
+
+int main()
+{
+    return QERunTests();
+}
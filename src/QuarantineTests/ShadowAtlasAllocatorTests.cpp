@@ -0,0 +1,218 @@
+// Pruebas en CPU del quadtree de los shadow atlas (ShadowAtlasAllocator): reserva, liberacion con
+// fusion de hermanos, ausencia de solapes, atlas lleno y los tamanos del reempaquetado completo.
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+#include <ShadowAtlasAllocator.h>
+#include "QETestHarness.h"
+
+namespace
+{
+    bool Overlap(const ShadowAtlasTile& a, const ShadowAtlasTile& b)
+    {
+        return a.X < b.X + b.Size && b.X < a.X + a.Size && a.Y < b.Y + b.Size && b.Y < a.Y + a.Size;
+    }
+
+    /// Tiles dentro del atlas, alineados a su tamano, sin solapes y con el area usada coherente.
+    void CheckLayout(const ShadowAtlasAllocator& allocator, const std::vector<ShadowAtlasTile>& tiles)
+    {
+        uint64_t area = 0;
+        for (size_t i = 0; i < tiles.size(); ++i)
+        {
+            const ShadowAtlasTile& tile = tiles[i];
+            QE_CHECK(tile.Valid());
+            QE_CHECK(tile.X + tile.Size <= allocator.GetAtlasSize());
+            QE_CHECK(tile.Y + tile.Size <= allocator.GetAtlasSize());
+            QE_CHECK_EQ(tile.X % tile.Size, 0u);
+            QE_CHECK_EQ(tile.Y % tile.Size, 0u);
+            area += static_cast<uint64_t>(tile.Size) * tile.Size;
+
+            for (size_t j = i + 1; j < tiles.size(); ++j)
+                QE_CHECK_MSG(!Overlap(tile, tiles[j]), "tiles " + std::to_string(i) + " and " + std::to_string(j) + " overlap");
+        }
+
+        QE_CHECK_EQ(allocator.GetUsedArea(), area);
+        QE_CHECK_EQ(allocator.GetUsedTiles(), static_cast<uint32_t>(tiles.size()));
+    }
+}
+
+QE_TEST(AllocateRoundsAndClampsToPowerOfTwo)
+{
+    ShadowAtlasAllocator allocator(4096, 256);
+    QE_CHECK_EQ(allocator.GetAtlasSize(), 4096u);
+    QE_CHECK_EQ(allocator.GetMinTileSize(), 256u);
+
+    QE_CHECK_EQ(allocator.Allocate(700).Size, 1024u);
+    QE_CHECK_EQ(allocator.Allocate(10).Size, 256u);
+    QE_CHECK_EQ(allocator.Allocate(1024).Size, 1024u);
+
+    ShadowAtlasAllocator small(1000, 300);
+    QE_CHECK_EQ(small.GetAtlasSize(), 1024u);
+    QE_CHECK_EQ(small.GetMinTileSize(), 512u);
+    QE_CHECK_EQ(small.Allocate(8192).Size, 1024u);
+}
+
+QE_TEST(FullAtlasFailsUntilSomethingIsFreed)
+{
+    ShadowAtlasAllocator allocator(1024, 256);
+
+    std::vector<ShadowAtlasTile> tiles;
+    for (int i = 0; i < 16; ++i)
+        tiles.push_back(allocator.Allocate(256));
+
+    CheckLayout(allocator, tiles);
+    QE_CHECK_EQ(allocator.GetFreeArea(), 0u);
+    QE_CHECK_EQ(allocator.GetLargestFreeTile(), 0u);
+    QE_CHECK(!allocator.Allocate(256).Valid());
+    QE_CHECK(!allocator.Allocate(1024).Valid());
+
+    allocator.Free(tiles[5]);
+    const ShadowAtlasTile reused = allocator.Allocate(256);
+    QE_CHECK(reused.Valid());
+    QE_CHECK_EQ(reused.Node, tiles[5].Node);
+    QE_CHECK(!allocator.Allocate(512).Valid());
+}
+
+QE_TEST(FreeMergesSiblingsBackIntoLargerTiles)
+{
+    ShadowAtlasAllocator allocator(2048, 256);
+
+    std::vector<ShadowAtlasTile> quarter;
+    for (int i = 0; i < 4; ++i)
+        quarter.push_back(allocator.Allocate(256));
+
+    // Los cuatro caben en el mismo bloque de 512: el resto del atlas sigue entero
+    QE_CHECK_EQ(allocator.GetLargestFreeTile(), 1024u);
+    QE_CHECK(!allocator.Allocate(2048).Valid());
+
+    for (const ShadowAtlasTile& tile : quarter)
+        allocator.Free(tile);
+
+    QE_CHECK_EQ(allocator.GetUsedArea(), 0u);
+    QE_CHECK_EQ(allocator.GetLargestFreeTile(), 2048u);
+    QE_CHECK_EQ(allocator.Allocate(2048).Size, 2048u);
+}
+
+QE_TEST(FreeIgnoresInvalidAndRepeatedTiles)
+{
+    ShadowAtlasAllocator allocator(1024, 256);
+    const ShadowAtlasTile tile = allocator.Allocate(512);
+
+    allocator.Free(ShadowAtlasTile{});
+    allocator.Free(tile);
+    allocator.Free(tile);
+
+    QE_CHECK_EQ(allocator.GetUsedArea(), 0u);
+    QE_CHECK_EQ(allocator.GetUsedTiles(), 0u);
+    QE_CHECK_EQ(allocator.GetLargestFreeTile(), 1024u);
+}
+
+QE_TEST(RandomAllocateAndFreeNeverOverlaps)
+{
+    ShadowAtlasAllocator allocator(8192, 128);
+    std::mt19937 rng(1234);
+    std::vector<ShadowAtlasTile> live;
+
+    for (int iteration = 0; iteration < 4000; ++iteration)
+    {
+        if (!live.empty() && rng() % 3 == 0)
+        {
+            const size_t index = rng() % live.size();
+            allocator.Free(live[index]);
+            live.erase(live.begin() + static_cast<std::ptrdiff_t>(index));
+        }
+        else
+        {
+            const uint32_t size = 128u << (rng() % 5);
+            const ShadowAtlasTile tile = allocator.Allocate(size);
+            if (tile.Valid())
+                live.push_back(tile);
+            else
+                QE_CHECK(allocator.GetLargestFreeTile() < size);
+        }
+
+        if (iteration % 250 == 0)
+            CheckLayout(allocator, live);
+    }
+
+    CheckLayout(allocator, live);
+
+    for (const ShadowAtlasTile& tile : live)
+        allocator.Free(tile);
+
+    QE_CHECK_EQ(allocator.GetLargestFreeTile(), 8192u);
+}
+
+QE_TEST(RepackReservesMinimumTilesInImportanceOrder)
+{
+    // 1024 / 256: caben 16 tiles minimos
+    ShadowAtlasAllocator allocator(1024, 256);
+    const std::vector<uint32_t> desired(20, 1024);
+
+    const std::vector<uint32_t> sizes = allocator.PlanRepackSizes(desired);
+    QE_CHECK_EQ(sizes.size(), desired.size());
+
+    // Las 16 mas importantes tienen su tile minimo y ninguna crece a costa de las demas
+    for (size_t i = 0; i < 16; ++i)
+        QE_CHECK_EQ(sizes[i], 256u);
+    for (size_t i = 16; i < sizes.size(); ++i)
+        QE_CHECK_EQ(sizes[i], 0u);
+}
+
+QE_TEST(RepackGrowsLightsByImportanceWithTheRemainingArea)
+{
+    ShadowAtlasAllocator allocator(2048, 256);
+    const std::vector<uint32_t> sizes = allocator.PlanRepackSizes({ 2048, 1024, 512, 256, 256 });
+
+    // 5 minimos (5 * 256^2); la primera crece hasta 1024 y no cabe en 2048 sin dejar fuera a otras
+    QE_CHECK_EQ(sizes[0], 1024u);
+    QE_CHECK_EQ(sizes[1], 1024u);
+    QE_CHECK_EQ(sizes[2], 512u);
+    QE_CHECK_EQ(sizes[3], 256u);
+    QE_CHECK_EQ(sizes[4], 256u);
+
+    // Nunca se supera el tamano deseado
+    const std::vector<uint32_t> modest = allocator.PlanRepackSizes({ 512, 256 });
+    QE_CHECK_EQ(modest[0], 512u);
+    QE_CHECK_EQ(modest[1], 256u);
+}
+
+QE_TEST(RepackSizesPackInDescendingOrder)
+{
+    std::mt19937 rng(99);
+    for (int round = 0; round < 200; ++round)
+    {
+        ShadowAtlasAllocator allocator(4096, 128);
+
+        std::vector<uint32_t> desired(1 + rng() % 64);
+        for (uint32_t& size : desired)
+            size = 128u << (rng() % 6);
+
+        std::vector<uint32_t> sizes = allocator.PlanRepackSizes(desired);
+        for (size_t i = 0; i < sizes.size(); ++i)
+            QE_CHECK(sizes[i] <= std::max(desired[i], allocator.GetMinTileSize()));
+
+        std::sort(sizes.begin(), sizes.end(), [](uint32_t a, uint32_t b) { return a > b; });
+
+        std::vector<ShadowAtlasTile> tiles;
+        for (uint32_t size : sizes)
+        {
+            if (size == 0)
+                continue;
+
+            const ShadowAtlasTile tile = allocator.Allocate(size);
+            QE_CHECK_MSG(tile.Valid(), "round " + std::to_string(round) + ": planned tile of " + std::to_string(size) + " does not fit");
+            if (tile.Valid())
+                tiles.push_back(tile);
+        }
+
+        CheckLayout(allocator, tiles);
+    }
+}
+
+int main()
+{
+    return QERunTests();
+}
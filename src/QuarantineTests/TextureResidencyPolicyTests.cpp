@@ -0,0 +1,210 @@
+// Pruebas en CPU de QETextureResidencyPolicy: seleccion de mip con bias e histeresis, orden de
+// expulsion por presupuesto y orden de aplicacion de los cambios.
+
+#include <cstdint>
+#include <vector>
+#include <QETextureResidencyPolicy.h>
+#include "QETestHarness.h"
+
+namespace
+{
+    /// Textura RGBA8 cuadrada con la cadena completa de mips.
+    QETextureResidencyEntry MakeEntry(uint32_t size, uint32_t residentMip = 0)
+    {
+        QETextureResidencyEntry entry{};
+        entry.Width = size;
+        entry.Height = size;
+        for (uint32_t side = size; side > 0; side >>= 1)
+        {
+            entry.LevelBytes.push_back(static_cast<uint64_t>(side) * side * 4);
+        }
+        entry.MipLevels = static_cast<uint32_t>(entry.LevelBytes.size());
+        entry.ResidentMip = residentMip;
+        entry.TargetMip = residentMip;
+        return entry;
+    }
+
+    uint32_t ResolveOne(QETextureResidencyEntry entry, const QETextureResidencySettings& settings)
+    {
+        std::vector<QETextureResidencyEntry> entries{ entry };
+        QETextureResidencyStats stats{};
+        QETextureResidencyPolicy::Resolve(entries, settings, stats);
+        return entries[0].TargetMip;
+    }
+}
+
+QE_TEST(MipForSizeAndRequiredMip)
+{
+    QE_CHECK_EQ(QETextureResidencyPolicy::MipForSize(1024, 512, 11, 64), 4u);
+    QE_CHECK_EQ(QETextureResidencyPolicy::MipForSize(1024, 1024, 11, 4096), 0u);
+    QE_CHECK_EQ(QETextureResidencyPolicy::MipForSize(1024, 1024, 3, 1), 2u);
+
+    QE_CHECK_NEAR(QETextureResidencyPolicy::RequiredMip(1.0f / 1024.0f, 1024), 0.0f, 1e-5f);
+    QE_CHECK_NEAR(QETextureResidencyPolicy::RequiredMip(4.0f / 1024.0f, 1024), 2.0f, 1e-5f);
+    QE_CHECK_NEAR(QETextureResidencyPolicy::RequiredMip(0.0001f, 1024), 0.0f, 1e-5f);
+
+    const QETextureResidencyEntry entry = MakeEntry(256);
+    QE_CHECK_EQ(QETextureResidencyPolicy::BytesFromMip(entry, 0), 256ull * 256 * 4 + 128 * 128 * 4 + 64 * 64 * 4 + 32 * 32 * 4 + 16 * 16 * 4 + 8 * 8 * 4 + 4 * 4 * 4 + 2 * 2 * 4 + 4);
+    QE_CHECK_EQ(QETextureResidencyPolicy::BytesFromMip(entry, entry.MipLevels), 0ull);
+}
+
+QE_TEST(MipBiasShiftsAndClampsTheRequestedMip)
+{
+    QETextureResidencySettings settings{};
+    settings.HysteresisLevels = 0;
+
+    QETextureResidencyEntry entry = MakeEntry(1024);
+    entry.RequiredMip = 1.3f;
+
+    QE_CHECK_EQ(ResolveOne(entry, settings), 1u);
+
+    settings.MipBias = 1.0f;
+    QE_CHECK_EQ(ResolveOne(entry, settings), 2u);
+
+    // Bias negativo: mas detalle, nunca por debajo del mip 0
+    settings.MipBias = -1.0f;
+    QE_CHECK_EQ(ResolveOne(entry, settings), 0u);
+    settings.MipBias = -8.0f;
+    QE_CHECK_EQ(ResolveOne(entry, settings), 0u);
+
+    // Bias grande: se queda en el mip minimo residente (lado 64 => mip 4)
+    settings.MipBias = 20.0f;
+    QE_CHECK_EQ(ResolveOne(entry, settings), 4u);
+}
+
+QE_TEST(HysteresisDelaysLosingDetailOnly)
+{
+    QETextureResidencySettings settings{};
+    settings.HysteresisLevels = 1;
+
+    // Residente en 0 y pide 1: dentro del margen, no se mueve
+    QETextureResidencyEntry entry = MakeEntry(1024, 0);
+    entry.RequiredMip = 1.5f;
+    QE_CHECK_EQ(ResolveOne(entry, settings), 0u);
+
+    // Pide 2: fuera del margen, baja
+    entry.RequiredMip = 2.2f;
+    QE_CHECK_EQ(ResolveOne(entry, settings), 2u);
+
+    // Residente en 3 y pide 2: mas detalle en el momento
+    entry = MakeEntry(1024, 3);
+    entry.RequiredMip = 2.0f;
+    QE_CHECK_EQ(ResolveOne(entry, settings), 2u);
+
+    // Sin verse durante EvictAfterFrames baja al minimo; sin demanda se quiere la cadena completa
+    entry.FramesSinceVisible = settings.EvictAfterFrames;
+    QE_CHECK_EQ(ResolveOne(entry, settings), 4u);
+    entry.DemandDriven = false;
+    QE_CHECK_EQ(ResolveOne(entry, settings), 0u);
+}
+
+QE_TEST(BudgetEvictsTheLongestUnseenTextureFirst)
+{
+    QETextureResidencySettings settings{};
+    std::vector<QETextureResidencyEntry> entries;
+    const uint32_t framesSinceVisible[] = { 0, 100, 10 };
+    for (uint32_t frames : framesSinceVisible)
+    {
+        QETextureResidencyEntry entry = MakeEntry(1024);
+        entry.RequiredMip = 0.0f;
+        entry.FramesSinceVisible = frames;
+        entries.push_back(entry);
+    }
+
+    const uint64_t fullBytes = QETextureResidencyPolicy::BytesFromMip(entries[0], 0);
+    settings.BudgetBytes = fullBytes * 3 - entries[0].LevelBytes[0];
+
+    QETextureResidencyStats stats{};
+    QETextureResidencyPolicy::Resolve(entries, settings, stats);
+
+    QE_CHECK_EQ(entries[0].TargetMip, 0u);
+    QE_CHECK_EQ(entries[1].TargetMip, 1u);
+    QE_CHECK_EQ(entries[2].TargetMip, 0u);
+    QE_CHECK_EQ(stats.BudgetLimited, 1u);
+    QE_CHECK(stats.DesiredBytes <= settings.BudgetBytes);
+    QE_CHECK_EQ(stats.ResidentBytes, fullBytes * 3);
+}
+
+QE_TEST(BudgetEvictsTheLargestMipFirstWhenEquallyVisible)
+{
+    QETextureResidencySettings settings{};
+    std::vector<QETextureResidencyEntry> entries{ MakeEntry(1024), MakeEntry(2048), MakeEntry(512) };
+    for (QETextureResidencyEntry& entry : entries)
+        entry.RequiredMip = 0.0f;
+
+    uint64_t total = 0;
+    for (const QETextureResidencyEntry& entry : entries)
+        total += QETextureResidencyPolicy::BytesFromMip(entry, 0);
+    settings.BudgetBytes = total - 1;
+
+    QETextureResidencyStats stats{};
+    QETextureResidencyPolicy::Resolve(entries, settings, stats);
+
+    QE_CHECK_EQ(entries[0].TargetMip, 0u);
+    QE_CHECK_EQ(entries[1].TargetMip, 1u);
+    QE_CHECK_EQ(entries[2].TargetMip, 0u);
+}
+
+QE_TEST(BudgetNeverDropsBelowTheMinimumResidentMip)
+{
+    QETextureResidencySettings settings{};
+    settings.BudgetBytes = 1;
+
+    std::vector<QETextureResidencyEntry> entries{ MakeEntry(1024), MakeEntry(256) };
+    for (QETextureResidencyEntry& entry : entries)
+        entry.RequiredMip = 0.0f;
+
+    // Con una recarga en vuelo la entrada no se toca
+    entries.push_back(MakeEntry(2048, 0));
+    entries.back().Pending = true;
+
+    QETextureResidencyStats stats{};
+    const std::vector<size_t> changes = QETextureResidencyPolicy::Resolve(entries, settings, stats);
+
+    QE_CHECK_EQ(entries[0].TargetMip, QETextureResidencyPolicy::MipForSize(1024, 1024, entries[0].MipLevels, settings.MinResidentSize));
+    QE_CHECK_EQ(entries[1].TargetMip, QETextureResidencyPolicy::MipForSize(256, 256, entries[1].MipLevels, settings.MinResidentSize));
+    QE_CHECK_EQ(entries[2].TargetMip, 0u);
+    QE_CHECK(stats.DesiredBytes > settings.BudgetBytes);
+    QE_CHECK_EQ(stats.BudgetLimited, 2u);
+    QE_CHECK_EQ(changes.size(), static_cast<size_t>(2));
+}
+
+QE_TEST(ChangesApplyEvictionsFirstThenLargestStreamIns)
+{
+    QETextureResidencySettings settings{};
+    settings.MaxChangesPerFrame = 0;
+
+    std::vector<QETextureResidencyEntry> entries;
+
+    QETextureResidencyEntry smallStep = MakeEntry(1024, 3);     // 3 -> 2
+    smallStep.RequiredMip = 2.0f;
+    entries.push_back(smallStep);
+
+    QETextureResidencyEntry unseen = MakeEntry(1024, 0);        // 0 -> 4
+    unseen.FramesSinceVisible = settings.EvictAfterFrames;
+    entries.push_back(unseen);
+
+    QETextureResidencyEntry bigStep = MakeEntry(1024, 4);       // 4 -> 0
+    bigStep.RequiredMip = 0.0f;
+    entries.push_back(bigStep);
+
+    QETextureResidencyEntry steady = MakeEntry(1024, 1);        // Sin cambios
+    steady.RequiredMip = 1.0f;
+    entries.push_back(steady);
+
+    QETextureResidencyStats stats{};
+    std::vector<size_t> changes = QETextureResidencyPolicy::Resolve(entries, settings, stats);
+
+    QE_CHECK(changes == std::vector<size_t>({ 1, 2, 0 }));
+    QE_CHECK_EQ(stats.Evictions, 1u);
+    QE_CHECK_EQ(stats.StreamIns, 2u);
+
+    settings.MaxChangesPerFrame = 2;
+    changes = QETextureResidencyPolicy::Resolve(entries, settings, stats);
+    QE_CHECK(changes == std::vector<size_t>({ 1, 2 }));
+}
+
+int main()
+{
+    return QERunTests();
+}